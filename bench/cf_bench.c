@@ -0,0 +1,933 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host end-to-end throughput benchmark of the CF engine
+ *
+ * For every combination of the CFDP classes, transaction counts, file sizes,
+ * PDU sizes and loss rates given, a sender and a receiver CF instance are
+ * forked and woken up at a fixed rate until every file crossed the loopback
+ * link, or the timeout expired.  The results are written as JSON, one object
+ * per combination, so that runs can be compared for regressions:
+ *
+ *     cf_bench --file-size 64k,1M --pdu-size 240,480 --loss 0,0.01 --txns 1,4 \
+ *              --class 2 --rate 100 --output results.json
+ */
+
+#include "cf_bench.h"
+#include "cf_app.h"
+#include "cf_dispatch.h"
+#include "cf_msgids.h"
+#include "cf_version.h"
+
+#include <errno.h>
+#include <ftw.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CF_BENCH_SENDER   0
+#define CF_BENCH_RECEIVER 1
+
+#define CF_BENCH_SENDER_EID   25
+#define CF_BENCH_RECEIVER_EID 23
+
+#define CF_BENCH_MAX_LIST        16
+#define CF_BENCH_PIPE_DEPTH      1000
+#define CF_BENCH_SOCK_BUF_BYTES  (4 * 1024 * 1024)
+#define CF_BENCH_FILE_BUF_BYTES  65536
+
+/**
+ * @brief The default configuration table, see fsw/tables/cf_def_config.c
+ */
+extern CF_ConfigTable_t CF_config_table;
+
+/**
+ * @brief Values of one option of the matrix
+ */
+typedef struct CF_Bench_List
+{
+    uint32 n;
+    uint32 v[CF_BENCH_MAX_LIST];
+} CF_Bench_List_t;
+
+/**
+ * @brief Command line options
+ */
+typedef struct CF_Bench_Options
+{
+    CF_Bench_List_t cfdp_class;
+    CF_Bench_List_t txns;
+    CF_Bench_List_t file_size;
+    CF_Bench_List_t pdu_size;
+    CF_Bench_List_t loss_ppm;
+
+    uint32      rate_hz;
+    uint32      delay_ms;
+    uint32      pdus_per_wakeup;
+    uint32      timeout_s;
+    uint32      seed;
+    const char *dir;
+    const char *output;
+    const char *stats_shm;
+    const char *capture;
+    bool        keep;
+} CF_Bench_Options_t;
+
+/**
+ * @brief One combination of the matrix
+ */
+typedef struct CF_Bench_Case
+{
+    uint32 cfdp_class;
+    uint32 txns;
+    uint32 file_size;
+    uint32 pdu_size;
+    uint32 loss_ppm;
+    char   dir[CF_FILENAME_MAX_PATH];
+} CF_Bench_Case_t;
+
+/**
+ * @brief Memory shared by the harness and the two instances of a run
+ */
+typedef struct CF_Bench_Shared
+{
+    uint64           t0_ns; /**< \brief monotonic time the sender was commanded */
+    CF_Bench_Stats_t side[2];
+} CF_Bench_Shared_t;
+
+/**
+ * @brief Results of one combination
+ */
+typedef struct CF_Bench_Result
+{
+    const char      *status;
+    uint32           completed;
+    uint32           failed;
+    uint32           verified;
+    double           time_s;
+    double           cpu_s;
+    CF_Bench_Stats_t side[2];
+} CF_Bench_Result_t;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Parses a comma separated list of sizes, with an optional k, M or G suffix.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_ParseSizes(CF_Bench_List_t *list, const char *arg)
+{
+    char              *end;
+    unsigned long long val;
+
+    list->n = 0;
+    do
+    {
+        val = strtoull(arg, &end, 0);
+        switch (*end)
+        {
+            case 'k':
+                val <<= 10;
+                ++end;
+                break;
+            case 'M':
+                val <<= 20;
+                ++end;
+                break;
+            case 'G':
+                val <<= 30;
+                ++end;
+                break;
+            default:
+                break;
+        }
+
+        if (end == arg || (*end != ',' && *end != 0) || val > UINT32_MAX || list->n >= CF_BENCH_MAX_LIST)
+        {
+            return -1;
+        }
+
+        list->v[list->n++] = (uint32)val;
+        arg                = end + 1;
+    } while (*end == ',');
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Parses a comma separated list of loss rates, as fractions, into parts per million.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_ParseLoss(CF_Bench_List_t *list, const char *arg)
+{
+    char  *end;
+    double val;
+
+    list->n = 0;
+    do
+    {
+        val = strtod(arg, &end);
+        if (end == arg || (*end != ',' && *end != 0) || !(val >= 0.0 && val <= 1.0) || list->n >= CF_BENCH_MAX_LIST)
+        {
+            return -1;
+        }
+
+        list->v[list->n++] = (uint32)lround(val * 1000000.0);
+        arg                = end + 1;
+    } while (*end == ',');
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Makes the name of a file of a run, returns -1 if it does not fit.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_FileName(char *buf, size_t size, const CF_Bench_Case_t *bc, const char *sub, uint32 i)
+{
+    int len = snprintf(buf, size, "%s/%s/%lu", bc->dir, sub, (unsigned long)i);
+
+    return (len < 0 || (size_t)len >= size) ? -1 : 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Creates the directories of a run and the files to send.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_MakeFiles(const CF_Bench_Options_t *opt, const CF_Bench_Case_t *bc)
+{
+    static const char *const SUBDIRS[] = { "src", "dst", "tx", "rx", "fail" };
+
+    char   path[CF_FILENAME_MAX_LEN];
+    uint32 buf[CF_BENCH_FILE_BUF_BYTES / sizeof(uint32)];
+    uint32 rng;
+    uint32 left;
+    uint32 len;
+    uint32 i;
+    uint32 j;
+    FILE  *fp;
+
+    if (mkdir(bc->dir, 0755) != 0 && errno != EEXIST)
+    {
+        return -1;
+    }
+    for (i = 0; i < sizeof(SUBDIRS) / sizeof(SUBDIRS[0]); ++i)
+    {
+        snprintf(path, sizeof(path), "%s/%s", bc->dir, SUBDIRS[i]);
+        if (mkdir(path, 0755) != 0 && errno != EEXIST)
+        {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < bc->txns; ++i)
+    {
+        if (CF_Bench_FileName(path, sizeof(path), bc, "src", i) != 0 || (fp = fopen(path, "wb")) == NULL)
+        {
+            return -1;
+        }
+
+        /* content that does not compress, different in every file */
+        rng = (opt->seed * 2654435761u) ^ (i + 1);
+        for (left = bc->file_size; left > 0; left -= len)
+        {
+            len = (left < sizeof(buf)) ? left : sizeof(buf);
+            for (j = 0; j < (len + sizeof(uint32) - 1) / sizeof(uint32); ++j)
+            {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                buf[j] = rng;
+            }
+            if (fwrite(buf, 1, len, fp) != len)
+            {
+                fclose(fp);
+                return -1;
+            }
+        }
+
+        fclose(fp);
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Counts the received files identical to the files sent.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Bench_Verify(const CF_Bench_Case_t *bc)
+{
+    static uint8 src_buf[CF_BENCH_FILE_BUF_BYTES];
+    static uint8 dst_buf[CF_BENCH_FILE_BUF_BYTES];
+
+    char   path[CF_FILENAME_MAX_LEN];
+    FILE  *src;
+    FILE  *dst;
+    size_t src_len;
+    size_t dst_len;
+    bool   same;
+    uint32 verified = 0;
+    uint32 i;
+
+    for (i = 0; i < bc->txns; ++i)
+    {
+        CF_Bench_FileName(path, sizeof(path), bc, "src", i);
+        src = fopen(path, "rb");
+        CF_Bench_FileName(path, sizeof(path), bc, "dst", i);
+        dst = fopen(path, "rb");
+
+        same = (src != NULL && dst != NULL);
+        while (same)
+        {
+            src_len = fread(src_buf, 1, sizeof(src_buf), src);
+            dst_len = fread(dst_buf, 1, sizeof(dst_buf), dst);
+            same    = (src_len == dst_len && memcmp(src_buf, dst_buf, src_len) == 0);
+            if (src_len == 0)
+            {
+                break;
+            }
+        }
+
+        if (same)
+        {
+            ++verified;
+        }
+        if (src != NULL)
+        {
+            fclose(src);
+        }
+        if (dst != NULL)
+        {
+            fclose(dst);
+        }
+    }
+
+    return verified;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Removes an entry of the directory of a run, for nftw().
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_RemoveEntry(const char *path, const struct stat *st, int type, struct FTW *ftw)
+{
+    remove(path);
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Sets up the configuration table of an instance from the default table.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_SetupTable(const CF_Bench_Options_t *opt, const CF_Bench_Case_t *bc, int side)
+{
+    CF_ConfigTable_t   *tbl = &CF_Bench_Config;
+    CF_ChannelConfig_t *cc;
+    int                 i;
+    int                 j;
+
+    *tbl = CF_config_table;
+
+    tbl->ticks_per_second         = opt->rate_hz;
+    tbl->local_eid                = (side == CF_BENCH_SENDER) ? CF_BENCH_SENDER_EID : CF_BENCH_RECEIVER_EID;
+    tbl->outgoing_file_chunk_size = bc->pdu_size;
+    snprintf(tbl->tmp_dir, sizeof(tbl->tmp_dir), "%s/%s", bc->dir, (side == CF_BENCH_SENDER) ? "tx" : "rx");
+    snprintf(tbl->fail_dir, sizeof(tbl->fail_dir), "%s/fail", bc->dir);
+
+    /* nothing is kept across runs */
+    tbl->checkpoint_interval_s = 0;
+    tbl->journal_file[0]       = 0;
+    tbl->spill_idle_s          = 0;
+    tbl->poll_index_file[0]    = 0;
+
+    /* statistics of each instance in its own shared memory object, for monitors */
+    tbl->stats_shm_name[0] = 0;
+    if (opt->stats_shm != NULL)
+    {
+        snprintf(tbl->stats_shm_name,
+                 sizeof(tbl->stats_shm_name),
+                 "%s-%s",
+                 opt->stats_shm,
+                 (side == CF_BENCH_SENDER) ? "tx" : "rx");
+    }
+
+    /* PDUs of each instance in its own capture file, for cf_replay */
+    tbl->capture_file[0] = 0;
+    if (opt->capture != NULL)
+    {
+        snprintf(tbl->capture_file,
+                 sizeof(tbl->capture_file),
+                 "%s-%s.cap",
+                 opt->capture,
+                 (side == CF_BENCH_SENDER) ? "tx" : "rx");
+    }
+
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        cc = &tbl->chan[i];
+
+        cc->max_outgoing_messages_per_wakeup = opt->pdus_per_wakeup;
+        cc->rx_max_messages_per_wakeup       = 2 * opt->pdus_per_wakeup;
+        cc->pipe_depth_input                 = CF_BENCH_PIPE_DEPTH;
+        cc->sem_name[0]                      = 0;
+        cc->move_dir[0]                      = 0;
+
+        for (j = 0; j < CF_MAX_POLLING_DIR_PER_CHAN; ++j)
+        {
+            cc->polldir[j].enabled = 0;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Commands the sender to send every file of the run.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_SendFiles(const CF_Bench_Case_t *bc)
+{
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        CF_TxFileCmd_t  Cmd;
+    } cmd;
+    uint32 i;
+
+    for (i = 0; i < bc->txns; ++i)
+    {
+        CFE_MSG_Init(&cmd.Buf.Msg, CFE_SB_ValueToMsgId(CF_CMD_MID), sizeof(cmd.Cmd));
+        CFE_MSG_SetFcnCode(&cmd.Buf.Msg, CF_TX_FILE_CC);
+
+        cmd.Cmd.Payload.cfdp_class = (bc->cfdp_class == 1) ? CF_CFDP_CLASS_1 : CF_CFDP_CLASS_2;
+        cmd.Cmd.Payload.keep       = 1;
+        cmd.Cmd.Payload.chan_num   = 0;
+        cmd.Cmd.Payload.priority   = 0;
+        cmd.Cmd.Payload.dest_id    = CF_BENCH_RECEIVER_EID;
+        cmd.Cmd.Payload.compress   = CF_Compress_NONE;
+        CF_Bench_FileName(cmd.Cmd.Payload.src_filename, sizeof(cmd.Cmd.Payload.src_filename), bc, "src", i);
+        CF_Bench_FileName(cmd.Cmd.Payload.dst_filename, sizeof(cmd.Cmd.Payload.dst_filename), bc, "dst", i);
+
+        CF_AppPipe(&cmd.Buf);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Runs one CF instance of a run, in its own process.  Does not return.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_RunInstance(const CF_Bench_Options_t *opt, const CF_Bench_Case_t *bc, int side, int sock,
+                                 CF_Bench_Shared_t *sh)
+{
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        CF_WakeupCmd_t  Cmd;
+    } wakeup;
+    CF_Bench_Stats_t *peer      = &sh->side[1 - side];
+    uint64            period_ns = 1000000000 / opt->rate_hz;
+    uint64            deadline;
+    uint64            next;
+    uint64            now;
+    struct timespec   ts;
+    uint32            peer_ready;
+
+    CF_Bench_Name          = (side == CF_BENCH_SENDER) ? "sender" : "receiver";
+    CF_Bench_Stats         = &sh->side[side];
+    CF_Bench_Link.sock     = sock;
+    CF_Bench_Link.loss_ppm = bc->loss_ppm;
+    CF_Bench_Link.delay_ms = opt->delay_ms;
+    CF_Bench_Link.rng      = (opt->seed * 2) + side + 1;
+    if (CF_Bench_Link.rng == 0)
+    {
+        CF_Bench_Link.rng = 1;
+    }
+
+    CF_Bench_SetupTable(opt, bc, side);
+
+    if (CF_AppInit() != CFE_SUCCESS)
+    {
+        __atomic_store_n(&CF_Bench_Stats->ready, 2, __ATOMIC_RELEASE);
+        _exit(EXIT_FAILURE);
+    }
+    __atomic_store_n(&CF_Bench_Stats->ready, 1, __ATOMIC_RELEASE);
+
+    /* both instances must be listening before the first PDU is sent */
+    deadline = CF_Bench_NowNs() + ((uint64)opt->timeout_s * 1000000000);
+    while ((peer_ready = __atomic_load_n(&peer->ready, __ATOMIC_ACQUIRE)) != 1)
+    {
+        if (peer_ready == 2 || CF_Bench_NowNs() > deadline)
+        {
+            _exit(EXIT_FAILURE);
+        }
+        OS_TaskDelay(1);
+    }
+
+    now = CF_Bench_NowNs();
+    if (side == CF_BENCH_SENDER)
+    {
+        sh->t0_ns = now;
+        CF_Bench_SendFiles(bc);
+    }
+
+    CFE_MSG_Init(&wakeup.Buf.Msg, CFE_SB_ValueToMsgId(CF_WAKE_UP_MID), sizeof(wakeup.Cmd));
+
+    /* keep waking up until both instances finished every transaction, the peer may still need answers */
+    next = now;
+    while (now < deadline && (__atomic_load_n(&CF_Bench_Stats->eot, __ATOMIC_ACQUIRE) < bc->txns ||
+                              __atomic_load_n(&peer->eot, __ATOMIC_ACQUIRE) < bc->txns))
+    {
+        CF_Bench_LinkPoll();
+        CF_AppPipe(&wakeup.Buf);
+
+        /* a late wakeup does not make the following ones early */
+        next += period_ns;
+        now = CF_Bench_NowNs();
+        if (next < now)
+        {
+            next = now;
+        }
+        ts.tv_sec  = next / 1000000000;
+        ts.tv_nsec = next % 1000000000;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        now = CF_Bench_NowNs();
+    }
+
+    CF_Bench_Stats->nak_segments = CF_AppData.hk.Payload.channel_hk[0].counters.sent.nak_segment_requests;
+    CF_Bench_Stats->fd_bytes     = CF_AppData.hk.Payload.channel_hk[0].counters.sent.file_data_bytes;
+
+    /* as CF_AppMain() does on exit */
+    CF_Capture_Flush();
+
+    _exit(EXIT_SUCCESS);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Runs one combination of the matrix.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_RunCase(const CF_Bench_Options_t *opt, const CF_Bench_Case_t *bc, CF_Bench_Result_t *res)
+{
+    CF_Bench_Shared_t *sh;
+    int                sv[2];
+    pid_t              pid[2];
+    int                buf_bytes = CF_BENCH_SOCK_BUF_BYTES;
+    int                wstatus;
+    struct rusage      ru;
+    bool               exited = true;
+    uint64             end_ns;
+    int                i;
+
+    memset(res, 0, sizeof(*res));
+    res->status = "error";
+
+    if (CF_Bench_MakeFiles(opt, bc) != 0)
+    {
+        fprintf(stderr, "cf_bench: cannot create the files of the run in %s\n", bc->dir);
+        return;
+    }
+
+    sh = mmap(NULL, sizeof(*sh), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED)
+    {
+        return;
+    }
+    memset(sh, 0, sizeof(*sh));
+
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) != 0)
+    {
+        munmap(sh, sizeof(*sh));
+        return;
+    }
+
+    /* do not hand buffered output to the children */
+    fflush(NULL);
+
+    for (i = 0; i < 2; ++i)
+    {
+        setsockopt(sv[i], SOL_SOCKET, SO_SNDBUF, &buf_bytes, sizeof(buf_bytes));
+        setsockopt(sv[i], SOL_SOCKET, SO_RCVBUF, &buf_bytes, sizeof(buf_bytes));
+
+        pid[i] = fork();
+        if (pid[i] == 0)
+        {
+            close(sv[1 - i]);
+            CF_Bench_RunInstance(opt, bc, i, sv[i], sh);
+        }
+    }
+    close(sv[0]);
+    close(sv[1]);
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (pid[i] < 0 || wait4(pid[i], &wstatus, 0, &ru) < 0 || !WIFEXITED(wstatus) ||
+            WEXITSTATUS(wstatus) != EXIT_SUCCESS)
+        {
+            exited = false;
+        }
+        if (pid[i] > 0)
+        {
+            res->cpu_s += ru.ru_utime.tv_sec + (ru.ru_utime.tv_usec / 1e6);
+            res->cpu_s += ru.ru_stime.tv_sec + (ru.ru_stime.tv_usec / 1e6);
+        }
+        res->side[i] = sh->side[i];
+    }
+
+    res->completed = (res->side[0].eot < res->side[1].eot) ? res->side[0].eot : res->side[1].eot;
+    res->failed    = (res->side[0].eot_failed > res->side[1].eot_failed) ? res->side[0].eot_failed
+                                                                          : res->side[1].eot_failed;
+    res->verified  = CF_Bench_Verify(bc);
+
+    end_ns = (res->side[0].last_eot_ns > res->side[1].last_eot_ns) ? res->side[0].last_eot_ns
+                                                                    : res->side[1].last_eot_ns;
+    if (sh->t0_ns != 0 && end_ns > sh->t0_ns)
+    {
+        res->time_s = (end_ns - sh->t0_ns) / 1e9;
+    }
+
+    if (exited)
+    {
+        res->status = (res->completed < bc->txns) ? "timeout" : "ok";
+    }
+
+    munmap(sh, sizeof(*sh));
+
+    if (!opt->keep)
+    {
+        nftw(bc->dir, CF_Bench_RemoveEntry, 8, FTW_DEPTH | FTW_PHYS);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Divides, giving 0 rather than infinity so that the JSON stays valid.
+ *
+ *-----------------------------------------------------------------*/
+static double CF_Bench_Ratio(double num, double den)
+{
+    return (den > 0.0) ? (num / den) : 0.0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the results of one combination as a JSON object.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_WriteResult(FILE *out, const CF_Bench_Case_t *bc, const CF_Bench_Result_t *res, bool first)
+{
+    double mb   = ((double)bc->file_size * res->verified) / 1e6;
+    uint64 pdus = res->side[0].pdus_sent + res->side[1].pdus_sent;
+
+    fprintf(out, "%s    {\n", first ? "" : ",\n");
+    fprintf(out, "      \"class\": %lu,\n", (unsigned long)bc->cfdp_class);
+    fprintf(out, "      \"txns\": %lu,\n", (unsigned long)bc->txns);
+    fprintf(out, "      \"file_size\": %lu,\n", (unsigned long)bc->file_size);
+    fprintf(out, "      \"pdu_size\": %lu,\n", (unsigned long)bc->pdu_size);
+    fprintf(out, "      \"loss\": %.6f,\n", bc->loss_ppm / 1e6);
+    fprintf(out, "      \"status\": \"%s\",\n", res->status);
+    fprintf(out, "      \"completed\": %lu,\n", (unsigned long)res->completed);
+    fprintf(out, "      \"failed\": %lu,\n", (unsigned long)res->failed);
+    fprintf(out, "      \"verified\": %lu,\n", (unsigned long)res->verified);
+    fprintf(out, "      \"time_s\": %.6f,\n", res->time_s);
+    fprintf(out, "      \"mb_per_s\": %.6f,\n", CF_Bench_Ratio(mb, res->time_s));
+    fprintf(out, "      \"pdus_per_s\": %.3f,\n", CF_Bench_Ratio(pdus, res->time_s));
+    fprintf(out, "      \"cpu_s\": %.6f,\n", res->cpu_s);
+    fprintf(out, "      \"cpu_s_per_mb\": %.6f,\n", CF_Bench_Ratio(res->cpu_s, mb));
+    fprintf(out, "      \"pdus_sent\": %llu,\n", (unsigned long long)pdus);
+    fprintf(out,
+            "      \"pdus_dropped\": %llu,\n",
+            (unsigned long long)(res->side[0].pdus_dropped + res->side[1].pdus_dropped));
+    fprintf(out,
+            "      \"pdus_overflow\": %llu,\n",
+            (unsigned long long)(res->side[0].pdus_overflow + res->side[1].pdus_overflow));
+    fprintf(out, "      \"fd_bytes_sent\": %llu,\n", (unsigned long long)res->side[CF_BENCH_SENDER].fd_bytes);
+    fprintf(out, "      \"nak_rounds\": %llu,\n", (unsigned long long)res->side[CF_BENCH_RECEIVER].nak_pdus);
+    fprintf(out,
+            "      \"nak_segments\": %llu,\n",
+            (unsigned long long)res->side[CF_BENCH_RECEIVER].nak_segments);
+    fprintf(out,
+            "      \"error_events\": %lu\n",
+            (unsigned long)(res->side[0].events_error + res->side[1].events_error));
+    fprintf(out, "    }");
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints the usage of the command.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_Usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --class LIST            CFDP classes, 1 or 2 (2)\n"
+            "  --txns LIST             transactions started at once (1)\n"
+            "  --file-size LIST        bytes per file, k/M/G suffixes allowed (1M)\n"
+            "  --pdu-size LIST         file data bytes per PDU (480)\n"
+            "  --loss LIST             fraction of the PDUs dropped each way (0)\n"
+            "  --rate HZ               wakeups per second of each instance (100)\n"
+            "  --delay-ms MS           one-way delay of the link (0)\n"
+            "  --pdus-per-wakeup N     PDUs sent per wakeup and channel (32)\n"
+            "  --timeout S             seconds before a run is abandoned (60)\n"
+            "  --seed N                seed of the file contents and of the losses (1)\n"
+            "  --dir PATH              work directory, short enough for the CF paths (/tmp/cf_bench)\n"
+            "  --output FILE           JSON results, instead of the standard output\n"
+            "  --keep                  keep the files of every run\n"
+            "  --stats-shm NAME        publish the statistics in shared memory NAME-tx and NAME-rx\n"
+            "  --capture PREFIX        capture the PDUs of the last run in PREFIX-tx.cap and PREFIX-rx.cap\n"
+            "  --verbose               print the events of the instances\n"
+            "LIST is a comma separated list, every combination of the lists is run.\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option LONG_OPTS[] = {
+        { "class", required_argument, NULL, 'c' },
+        { "txns", required_argument, NULL, 'n' },
+        { "file-size", required_argument, NULL, 'f' },
+        { "pdu-size", required_argument, NULL, 'p' },
+        { "loss", required_argument, NULL, 'l' },
+        { "rate", required_argument, NULL, 'r' },
+        { "delay-ms", required_argument, NULL, 'd' },
+        { "pdus-per-wakeup", required_argument, NULL, 'w' },
+        { "timeout", required_argument, NULL, 't' },
+        { "seed", required_argument, NULL, 's' },
+        { "dir", required_argument, NULL, 'D' },
+        { "output", required_argument, NULL, 'o' },
+        { "keep", no_argument, NULL, 'k' },
+        { "stats-shm", required_argument, NULL, 'S' },
+        { "capture", required_argument, NULL, 'C' },
+        { "verbose", no_argument, NULL, 'v' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    CF_Bench_Options_t opt;
+    CF_Bench_Case_t    bc;
+    CF_Bench_Result_t  res;
+    FILE              *out;
+    uint32             ic, in, iff, ip, il;
+    uint32             num_cases = 0;
+    int                c;
+    int                err = 0;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.cfdp_class.n      = 1;
+    opt.cfdp_class.v[0]   = 2;
+    opt.txns.n            = 1;
+    opt.txns.v[0]         = 1;
+    opt.file_size.n       = 1;
+    opt.file_size.v[0]    = 1 << 20;
+    opt.pdu_size.n        = 1;
+    opt.pdu_size.v[0]     = 480;
+    opt.loss_ppm.n        = 1;
+    opt.loss_ppm.v[0]     = 0;
+    opt.rate_hz           = 100;
+    opt.pdus_per_wakeup   = 32;
+    opt.timeout_s         = 60;
+    opt.seed              = 1;
+    opt.dir               = "/tmp/cf_bench";
+
+    while ((c = getopt_long(argc, argv, "h", LONG_OPTS, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'c':
+                err |= CF_Bench_ParseSizes(&opt.cfdp_class, optarg);
+                break;
+            case 'n':
+                err |= CF_Bench_ParseSizes(&opt.txns, optarg);
+                break;
+            case 'f':
+                err |= CF_Bench_ParseSizes(&opt.file_size, optarg);
+                break;
+            case 'p':
+                err |= CF_Bench_ParseSizes(&opt.pdu_size, optarg);
+                break;
+            case 'l':
+                err |= CF_Bench_ParseLoss(&opt.loss_ppm, optarg);
+                break;
+            case 'r':
+                opt.rate_hz = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                opt.delay_ms = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                opt.pdus_per_wakeup = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                opt.timeout_s = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                opt.seed = strtoul(optarg, NULL, 0);
+                break;
+            case 'D':
+                opt.dir = optarg;
+                break;
+            case 'o':
+                opt.output = optarg;
+                break;
+            case 'k':
+                opt.keep = true;
+                break;
+            case 'S':
+                opt.stats_shm = optarg;
+                break;
+            case 'C':
+                opt.capture = optarg;
+                break;
+            case 'v':
+                CF_Bench_Verbose = true;
+                break;
+            default:
+                err = -1;
+                break;
+        }
+    }
+
+    if (err != 0 || optind != argc || opt.rate_hz == 0 || opt.rate_hz > 1000000 || opt.pdus_per_wakeup == 0)
+    {
+        CF_Bench_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (ic = 0; ic < opt.cfdp_class.n; ++ic)
+    {
+        if (opt.cfdp_class.v[ic] != 1 && opt.cfdp_class.v[ic] != 2)
+        {
+            CF_Bench_Usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (mkdir(opt.dir, 0755) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "cf_bench: cannot create %s: %s\n", opt.dir, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    out = (opt.output != NULL) ? fopen(opt.output, "w") : stdout;
+    if (out == NULL)
+    {
+        fprintf(stderr, "cf_bench: cannot write %s: %s\n", opt.output, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"cf\",\n");
+    fprintf(out, "  \"version\": \"%d.%d.%d\",\n", CF_MAJOR_VERSION, CF_MINOR_VERSION, CF_REVISION);
+    fprintf(out, "  \"rate_hz\": %lu,\n", (unsigned long)opt.rate_hz);
+    fprintf(out, "  \"delay_ms\": %lu,\n", (unsigned long)opt.delay_ms);
+    fprintf(out, "  \"pdus_per_wakeup\": %lu,\n", (unsigned long)opt.pdus_per_wakeup);
+    fprintf(out, "  \"seed\": %lu,\n", (unsigned long)opt.seed);
+    fprintf(out, "  \"cases\": [\n");
+
+    for (ic = 0; ic < opt.cfdp_class.n; ++ic)
+    {
+        for (in = 0; in < opt.txns.n; ++in)
+        {
+            for (iff = 0; iff < opt.file_size.n; ++iff)
+            {
+                for (ip = 0; ip < opt.pdu_size.n; ++ip)
+                {
+                    for (il = 0; il < opt.loss_ppm.n; ++il)
+                    {
+                        memset(&bc, 0, sizeof(bc));
+                        bc.cfdp_class = opt.cfdp_class.v[ic];
+                        bc.txns       = opt.txns.v[in];
+                        bc.file_size  = opt.file_size.v[iff];
+                        bc.pdu_size   = opt.pdu_size.v[ip];
+                        bc.loss_ppm   = opt.loss_ppm.v[il];
+                        snprintf(bc.dir, sizeof(bc.dir), "%s/%lu", opt.dir, (unsigned long)num_cases);
+
+                        CF_Bench_RunCase(&opt, &bc, &res);
+                        CF_Bench_WriteResult(out, &bc, &res, num_cases == 0);
+                        ++num_cases;
+
+                        fprintf(stderr,
+                                "cf_bench: class %lu, %lu x %lu bytes, pdu %lu, loss %.4f: %s, %.3f s, %.3f MB/s\n",
+                                (unsigned long)bc.cfdp_class,
+                                (unsigned long)bc.txns,
+                                (unsigned long)bc.file_size,
+                                (unsigned long)bc.pdu_size,
+                                bc.loss_ppm / 1e6,
+                                res.status,
+                                res.time_s,
+                                CF_Bench_Ratio(((double)bc.file_size * res.verified) / 1e6, res.time_s));
+                    }
+                }
+            }
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    return EXIT_SUCCESS;
+}
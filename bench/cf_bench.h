@@ -0,0 +1,141 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host benchmark of the CF engine
+ *
+ * The benchmark runs the real CF sources against minimal stand-ins of the
+ * cFE and OSAL services they use.  Each run forks two CF instances, a sender
+ * and a receiver, whose PDUs cross a loopback link that can drop and delay
+ * them.  The replay of a PDU capture runs a single instance on the same
+ * stand-ins, see cf_replay.c.  This header is shared by the harnesses and
+ * the stand-ins.
+ */
+
+#ifndef CF_BENCH_H
+#define CF_BENCH_H
+
+#include "cfe.h"
+#include "cf_tbldefs.h"
+#include "cf_msg.h"
+
+/**
+ * @brief Loopback link to the other CF instance of a run
+ */
+typedef struct CF_Bench_Link
+{
+    int    sock;     /**< \brief datagram socket connected to the other instance */
+    uint32 loss_ppm; /**< \brief PDUs dropped per million sent */
+    uint32 delay_ms; /**< \brief one-way delay added to every PDU */
+    uint32 rng;      /**< \brief state of the loss generator, never 0 */
+} CF_Bench_Link_t;
+
+/**
+ * @brief Counters of one CF instance, in memory shared with the harness
+ */
+typedef struct CF_Bench_Stats
+{
+    uint32 ready;         /**< \brief set once CF_AppInit() returned: 1 on success, 2 on failure */
+    uint32 eot;           /**< \brief transactions finished */
+    uint32 eot_failed;    /**< \brief transactions finished with an error status */
+    uint32 events_error;  /**< \brief error events sent */
+    uint64 last_eot_ns;   /**< \brief monotonic time the last transaction finished */
+    uint64 pdus_sent;     /**< \brief PDUs given to the link */
+    uint64 pdus_dropped;  /**< \brief PDUs dropped by the loss of the link */
+    uint64 pdus_overflow; /**< \brief PDUs dropped because a pipe or the link queue was full */
+    uint64 nak_pdus;      /**< \brief NAK PDUs given to the link */
+    uint64 nak_segments;  /**< \brief segments requested by the NAKs sent */
+    uint64 fd_bytes;      /**< \brief file data bytes sent */
+} CF_Bench_Stats_t;
+
+/**
+ * @brief Configuration table the TBL stand-in loads
+ */
+extern CF_ConfigTable_t CF_Bench_Config;
+
+/**
+ * @brief Link of this instance, set up by the harness before CF_AppInit()
+ */
+extern CF_Bench_Link_t CF_Bench_Link;
+
+/**
+ * @brief Counters of this instance
+ */
+extern CF_Bench_Stats_t *CF_Bench_Stats;
+
+/**
+ * @brief Name of this instance, prefixed to the events printed
+ */
+extern const char *CF_Bench_Name;
+
+/**
+ * @brief Whether events and system log messages are printed
+ */
+extern bool CF_Bench_Verbose;
+
+/**
+ * @brief Time of day seen by CF in nanoseconds, 0 uses the host clock
+ */
+extern uint64 CF_Bench_VirtualTimeNs;
+
+/**
+ * @brief Host directory the paths used by CF are taken under, NULL uses them as they are
+ */
+extern const char *CF_Bench_Root;
+
+/************************************************************************/
+/** @brief Gets the monotonic time in nanoseconds.
+ *
+ * @returns Nanoseconds since an arbitrary point, the same in every process
+ */
+uint64 CF_Bench_NowNs(void);
+
+/************************************************************************/
+/** @brief Puts a message on the pipe subscribed to its message ID.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The pipe takes the buffer only on success, otherwise the caller
+ *       still owns it.
+ *
+ * @param BufPtr  Message buffer from CFE_SB_AllocateMessageBuffer()
+ *
+ * @retval #CFE_SUCCESS on success
+ * @retval CFE_SB_PIPE_WR_ERR if no pipe is subscribed, or it is full
+ */
+CFE_Status_t CF_Bench_Deliver(CFE_SB_Buffer_t *BufPtr);
+
+/************************************************************************/
+/** @brief Sends the PDU of an outgoing CF message to the other instance.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The message is not kept, the caller still owns it.
+ *
+ * @param chan    Channel the PDU was sent on
+ * @param BufPtr  Message holding the PDU
+ */
+void CF_Bench_LinkSend(uint8 chan, const CFE_SB_Buffer_t *BufPtr);
+
+/************************************************************************/
+/** @brief Moves the PDUs whose delay expired to the other instance, and delivers the PDUs received.
+ */
+void CF_Bench_LinkPoll(void);
+
+#endif /* !CF_BENCH_H */
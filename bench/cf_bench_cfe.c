@@ -0,0 +1,642 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Minimal in-process stand-in of the cFE services used by CF, for the host benchmark
+ *
+ * Only what one CF instance needs is provided: pipes with their subscriptions,
+ * messages with a CCSDS primary header, a table loaded from CF_Bench_Config,
+ * and events printed on request.  Outgoing PDUs go to the loopback link, and
+ * end of transaction packets are counted instead of being sent.
+ */
+
+#include "cf_bench.h"
+#include "cf_app.h"
+#include "cf_msgids.h"
+#include "cf_utils.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CF_BENCH_MAX_PIPES  8
+#define CF_BENCH_MAX_ROUTES 16
+#define CF_BENCH_PIPE_DEPTH 1024
+
+/* the CCSDS length field holds the size of the packet minus 7 */
+#define CF_BENCH_LENGTH_BIAS 7
+
+/* type bit of the CCSDS stream ID, set on commands */
+#define CF_BENCH_TYPE_CMD 0x10
+
+/**
+ * @brief A pipe, a queue of messages read by CFE_SB_ReceiveBuffer()
+ */
+typedef struct CF_Bench_Pipe
+{
+    bool             used;
+    uint16           depth;
+    uint16           head;
+    uint16           count;
+    CFE_SB_Buffer_t *q[CF_BENCH_PIPE_DEPTH];
+    CFE_SB_Buffer_t *last; /**< \brief last message received, valid until the next receive */
+} CF_Bench_Pipe_t;
+
+/**
+ * @brief A subscription of a pipe to a message ID
+ */
+typedef struct CF_Bench_Route
+{
+    CFE_SB_MsgId_Atom_t mid;
+    uint32              pipe;
+} CF_Bench_Route_t;
+
+CF_ConfigTable_t  CF_Bench_Config;
+CF_Bench_Stats_t *CF_Bench_Stats;
+const char       *CF_Bench_Name = "cf";
+bool              CF_Bench_Verbose;
+uint64            CF_Bench_VirtualTimeNs;
+
+static CF_Bench_Pipe_t  CF_Bench_Pipes[CF_BENCH_MAX_PIPES];
+static CF_Bench_Route_t CF_Bench_Routes[CF_BENCH_MAX_ROUTES];
+static uint32           CF_Bench_NumRoutes;
+
+static CF_ConfigTable_t          CF_Bench_Table;
+static CFE_TBL_CallbackFuncPtr_t CF_Bench_TableValidate;
+static bool                      CF_Bench_TableUpdated;
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bench.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 CF_Bench_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the pipe of a pipe ID, or NULL if it is not one.
+ *
+ *-----------------------------------------------------------------*/
+static CF_Bench_Pipe_t *CF_Bench_GetPipe(CFE_SB_PipeId_t PipeId)
+{
+    unsigned long idx = CFE_RESOURCEID_TO_ULONG(PipeId);
+
+    if (idx == 0 || idx > CF_BENCH_MAX_PIPES || !CF_Bench_Pipes[idx - 1].used)
+    {
+        return NULL;
+    }
+
+    return &CF_Bench_Pipes[idx - 1];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Counts an end of transaction packet.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_CountEot(const CFE_SB_Buffer_t *BufPtr)
+{
+    const CF_EotPacket_t *EotPktPtr = (const CF_EotPacket_t *)BufPtr;
+
+    if (CF_TxnStatus_IsError(EotPktPtr->Payload.txn_stat))
+    {
+        ++CF_Bench_Stats->eot_failed;
+    }
+
+    /* the harness reads these from the other instance too */
+    __atomic_store_n(&CF_Bench_Stats->last_eot_ns, CF_Bench_NowNs(), __ATOMIC_RELAXED);
+    __atomic_add_fetch(&CF_Bench_Stats->eot, 1, __ATOMIC_RELEASE);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Routes a message sent by CF, which takes the buffer.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_Route(CFE_SB_Buffer_t *BufPtr)
+{
+    CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+    int            i;
+
+    CFE_MSG_GetMsgId(&BufPtr->Msg, &MsgId);
+
+    if (CFE_SB_MsgIdToValue(MsgId) == CF_EOT_TLM_MID)
+    {
+        CF_Bench_CountEot(BufPtr);
+        CFE_SB_ReleaseMessageBuffer(BufPtr);
+        return;
+    }
+
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        if (CF_AppData.config_table != NULL &&
+            CFE_SB_MsgIdToValue(MsgId) == CF_AppData.config_table->chan[i].mid_output)
+        {
+            CF_Bench_LinkSend(i, BufPtr);
+            CFE_SB_ReleaseMessageBuffer(BufPtr);
+            return;
+        }
+    }
+
+    /* everything else, such as housekeeping, goes to the local subscribers if any */
+    if (CF_Bench_Deliver(BufPtr) != CFE_SUCCESS)
+    {
+        CFE_SB_ReleaseMessageBuffer(BufPtr);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bench.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bench_Deliver(CFE_SB_Buffer_t *BufPtr)
+{
+    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
+    CF_Bench_Pipe_t *pipe  = NULL;
+    uint32           i;
+
+    CFE_MSG_GetMsgId(&BufPtr->Msg, &MsgId);
+
+    for (i = 0; i < CF_Bench_NumRoutes; ++i)
+    {
+        if (CF_Bench_Routes[i].mid == CFE_SB_MsgIdToValue(MsgId))
+        {
+            pipe = &CF_Bench_Pipes[CF_Bench_Routes[i].pipe];
+            break;
+        }
+    }
+
+    if (pipe == NULL)
+    {
+        return CFE_SB_PIPE_WR_ERR;
+    }
+
+    if (pipe->count >= pipe->depth)
+    {
+        ++CF_Bench_Stats->pdus_overflow;
+        return CFE_SB_PIPE_WR_ERR;
+    }
+
+    pipe->q[(pipe->head + pipe->count) % CF_BENCH_PIPE_DEPTH] = BufPtr;
+    ++pipe->count;
+
+    return CFE_SUCCESS;
+}
+
+/*
+ * ES
+ */
+
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+    return (RunStatus == NULL || *RunStatus == CFE_ES_RunStatus_APP_RUN);
+}
+
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+    exit((ExitStatus == CFE_ES_RunStatus_APP_EXIT) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
+{
+    /* not measured here, the harness times whole runs */
+}
+
+CFE_Status_t CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+    va_list ap;
+
+    if (CF_Bench_Verbose)
+    {
+        fprintf(stderr, "%s: ", CF_Bench_Name);
+        va_start(ap, SpecStringPtr);
+        vfprintf(stderr, SpecStringPtr, ap);
+        va_end(ap);
+        fputc('\n', stderr);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+ * EVS
+ */
+
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    va_list ap;
+
+    if (EventType == CFE_EVS_EventType_ERROR || EventType == CFE_EVS_EventType_CRITICAL)
+    {
+        ++CF_Bench_Stats->events_error;
+    }
+
+    if (CF_Bench_Verbose)
+    {
+        fprintf(stderr, "%s: event %u: ", CF_Bench_Name, (unsigned int)EventID);
+        va_start(ap, Spec);
+        vfprintf(stderr, Spec, ap);
+        va_end(ap);
+        fputc('\n', stderr);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+ * TIME
+ */
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+    CFE_TIME_SysTime_t now;
+    struct timespec    ts;
+
+    if (CF_Bench_VirtualTimeNs != 0)
+    {
+        ts.tv_sec  = CF_Bench_VirtualTimeNs / 1000000000;
+        ts.tv_nsec = CF_Bench_VirtualTimeNs % 1000000000;
+    }
+    else
+    {
+        clock_gettime(CLOCK_REALTIME, &ts);
+    }
+
+    now.Seconds    = (uint32)ts.tv_sec;
+    now.Subseconds = (uint32)(((uint64)ts.tv_nsec << 32) / 1000000000);
+
+    return now;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+    CFE_TIME_SysTime_t diff;
+
+    diff.Subseconds = Time1.Subseconds - Time2.Subseconds;
+    diff.Seconds    = Time1.Seconds - Time2.Seconds - (diff.Subseconds > Time1.Subseconds);
+
+    return diff;
+}
+
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds)
+{
+    return (uint32)(((uint64)SubSeconds * 1000000) >> 32);
+}
+
+/*
+ * MSG, a CCSDS primary header followed by the secondary header of the
+ * type: the function code for commands, the time for telemetry
+ */
+
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+    uint8 *hdr = (uint8 *)MsgPtr;
+
+    memset(MsgPtr, 0, Size);
+
+    hdr[0] = (uint8)(CFE_SB_MsgIdToValue(MsgId) >> 8);
+    hdr[1] = (uint8)CFE_SB_MsgIdToValue(MsgId);
+    hdr[2] = 0xC0; /* unsegmented */
+
+    return CFE_MSG_SetSize(MsgPtr, Size);
+}
+
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+    const uint8 *hdr = (const uint8 *)MsgPtr;
+
+    *MsgId = CFE_SB_ValueToMsgId(((CFE_SB_MsgId_Atom_t)hdr[0] << 8) | hdr[1]);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetType(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Type_t *Type)
+{
+    const uint8 *hdr = (const uint8 *)MsgPtr;
+
+    *Type = (hdr[0] & CF_BENCH_TYPE_CMD) ? CFE_MSG_Type_Cmd : CFE_MSG_Type_Tlm;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+    const uint8 *hdr = (const uint8 *)MsgPtr;
+
+    *Size = (((CFE_MSG_Size_t)hdr[4] << 8) | hdr[5]) + CF_BENCH_LENGTH_BIAS;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+    uint8 *hdr = (uint8 *)MsgPtr;
+
+    if (Size < CF_BENCH_LENGTH_BIAS || Size > (0xFFFF + CF_BENCH_LENGTH_BIAS))
+    {
+        return CFE_MSG_BAD_ARGUMENT;
+    }
+
+    hdr[4] = (uint8)((Size - CF_BENCH_LENGTH_BIAS) >> 8);
+    hdr[5] = (uint8)(Size - CF_BENCH_LENGTH_BIAS);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+    const uint8 *hdr = (const uint8 *)MsgPtr;
+
+    *FcnCode = hdr[6] & 0x7F;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+    uint8 *hdr = (uint8 *)MsgPtr;
+
+    hdr[6] = (hdr[6] & 0x80) | (FcnCode & 0x7F);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetMsgTime(CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t NewTime)
+{
+    uint8 *hdr = (uint8 *)MsgPtr;
+
+    if (hdr[0] & CF_BENCH_TYPE_CMD)
+    {
+        return CFE_MSG_WRONG_MSG_TYPE;
+    }
+
+    hdr[6]  = (uint8)(NewTime.Seconds >> 24);
+    hdr[7]  = (uint8)(NewTime.Seconds >> 16);
+    hdr[8]  = (uint8)(NewTime.Seconds >> 8);
+    hdr[9]  = (uint8)NewTime.Seconds;
+    hdr[10] = (uint8)(NewTime.Subseconds >> 24);
+    hdr[11] = (uint8)(NewTime.Subseconds >> 16);
+
+    return CFE_SUCCESS;
+}
+
+/*
+ * SB
+ */
+
+bool CFE_SB_IsValidMsgId(CFE_SB_MsgId_t MsgId)
+{
+    return (CFE_SB_MsgIdToValue(MsgId) != 0);
+}
+
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    int i;
+
+    for (i = 0; i < CF_BENCH_MAX_PIPES; ++i)
+    {
+        if (!CF_Bench_Pipes[i].used)
+        {
+            memset(&CF_Bench_Pipes[i], 0, sizeof(CF_Bench_Pipes[i]));
+            CF_Bench_Pipes[i].used  = true;
+            CF_Bench_Pipes[i].depth = (Depth > 0 && Depth < CF_BENCH_PIPE_DEPTH) ? Depth : CF_BENCH_PIPE_DEPTH;
+
+            *PipeIdPtr = CFE_SB_PIPEID_C(i + 1);
+            return CFE_SUCCESS;
+        }
+    }
+
+    return CFE_SB_MAX_PIPES_MET;
+}
+
+CFE_Status_t CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId)
+{
+    CF_Bench_Pipe_t *pipe = CF_Bench_GetPipe(PipeId);
+    uint32           i;
+
+    if (pipe == NULL)
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    for (; pipe->count > 0; --pipe->count)
+    {
+        free(pipe->q[pipe->head]);
+        pipe->head = (pipe->head + 1) % CF_BENCH_PIPE_DEPTH;
+    }
+    free(pipe->last);
+    pipe->used = false;
+
+    /* drop the subscriptions of the pipe */
+    for (i = 0; i < CF_Bench_NumRoutes;)
+    {
+        if (&CF_Bench_Pipes[CF_Bench_Routes[i].pipe] == pipe)
+        {
+            CF_Bench_Routes[i] = CF_Bench_Routes[--CF_Bench_NumRoutes];
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_SubscribeLocal(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, uint16 MsgLim)
+{
+    CF_Bench_Pipe_t *pipe = CF_Bench_GetPipe(PipeId);
+
+    if (pipe == NULL || !CFE_SB_IsValidMsgId(MsgId))
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    if (CF_Bench_NumRoutes >= CF_BENCH_MAX_ROUTES)
+    {
+        return CFE_SB_MAX_MSGS_MET;
+    }
+
+    CF_Bench_Routes[CF_Bench_NumRoutes].mid  = CFE_SB_MsgIdToValue(MsgId);
+    CF_Bench_Routes[CF_Bench_NumRoutes].pipe = pipe - CF_Bench_Pipes;
+    ++CF_Bench_NumRoutes;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+    return CFE_SB_SubscribeLocal(MsgId, PipeId, CF_BENCH_PIPE_DEPTH);
+}
+
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    CF_Bench_Pipe_t *pipe = CF_Bench_GetPipe(PipeId);
+
+    if (pipe == NULL || BufPtr == NULL)
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    /* as on the SB, a message received stays valid until the next receive from its pipe */
+    free(pipe->last);
+    pipe->last = NULL;
+
+    if (pipe->count == 0)
+    {
+        /* nothing else can put a message on the pipe while waiting */
+        return (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT;
+    }
+
+    pipe->last = pipe->q[pipe->head];
+    pipe->head = (pipe->head + 1) % CF_BENCH_PIPE_DEPTH;
+    --pipe->count;
+
+    *BufPtr = pipe->last;
+
+    return CFE_SUCCESS;
+}
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+    return malloc(MsgSize);
+}
+
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+    free(BufPtr);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+    if (BufPtr == NULL)
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    CF_Bench_Route(BufPtr);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+    CFE_SB_Buffer_t *BufPtr;
+    CFE_MSG_Size_t   Size = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &Size);
+
+    BufPtr = CFE_SB_AllocateMessageBuffer(Size);
+    if (BufPtr == NULL)
+    {
+        return CFE_SB_BUF_ALOC_ERR;
+    }
+
+    memcpy(BufPtr, MsgPtr, Size);
+    CF_Bench_Route(BufPtr);
+
+    return CFE_SUCCESS;
+}
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+    CFE_MSG_SetMsgTime(MsgPtr, CFE_TIME_GetTime());
+}
+
+/*
+ * TBL, a single table loaded from CF_Bench_Config
+ */
+
+CFE_Status_t CFE_TBL_Register(CFE_TBL_Handle_t *TblHandlePtr, const char *Name, size_t Size, uint16 TblOptionFlags,
+                              CFE_TBL_CallbackFuncPtr_t TblValidationFuncPtr)
+{
+    if (Size != sizeof(CF_Bench_Table))
+    {
+        return CFE_TBL_ERR_INVALID_SIZE;
+    }
+
+    CF_Bench_TableValidate = TblValidationFuncPtr;
+    *TblHandlePtr          = 0;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_Load(CFE_TBL_Handle_t TblHandle, CFE_TBL_SrcEnum_t SrcType, const void *SrcDataPtr)
+{
+    CF_Bench_Table = CF_Bench_Config;
+
+    if (CF_Bench_TableValidate != NULL && CF_Bench_TableValidate(&CF_Bench_Table) != CFE_SUCCESS)
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    CF_Bench_TableUpdated = true;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle)
+{
+    *TblPtr = &CF_Bench_Table;
+
+    if (CF_Bench_TableUpdated)
+    {
+        CF_Bench_TableUpdated = false;
+        return CFE_TBL_INFO_UPDATED;
+    }
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
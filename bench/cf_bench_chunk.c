@@ -0,0 +1,1012 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host stress benchmark of the chunk lists (gap tracking)
+ *
+ * A file of fixed size segments is pushed through a simulated channel with
+ * Gilbert-Elliott burst losses, reordering and duplicates into a receiver
+ * chunk list, the way CF_CFDP_R_ProcessFd() does.  The gaps of the receiver
+ * are then NAKed into a sender chunk list, which is drained in PDU sized
+ * pieces with CF_ChunkList_RemoveFromFirst() as CF_CFDP_S_CheckAndRespondNak()
+ * does, and the pieces are sent again, round after round, until the file is
+ * complete.
+ *
+ * After every batch of additions both lists are checked against a bitmap of
+ * the segments received: ordered, not overlapping, not touching, no bigger
+ * than max_chunks and holding only data received.  As long as the bitmap has
+ * no more runs than max_chunks, so that nothing was evicted, the receiver list
+ * must match the bitmap exactly.  The gaps computed must be the complement of
+ * the list.
+ *
+ * The same random sequence is run at every max_chunks, so the timings of the
+ * additions, gap computations and removals can be compared across sizes and
+ * across implementations of cf_chunk.c:
+ *
+ *     cf_bench_chunk --max-chunks 16,64,256,1024 --loss 0.01,0.05 --burst 4 \
+ *                    --file-size 16M --output chunk.json
+ */
+
+#include "cf_chunk.h"
+#include "cf_interface_cfg.h"
+#include "cf_version.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CF_BENCH_CHUNK_MAX_LIST 16
+
+/**
+ * @brief Values of one option of the matrix
+ */
+typedef struct CF_BenchChunk_List
+{
+    uint32 n;
+    uint32 v[CF_BENCH_CHUNK_MAX_LIST];
+} CF_BenchChunk_List_t;
+
+/**
+ * @brief Command line options
+ */
+typedef struct CF_BenchChunk_Options
+{
+    CF_BenchChunk_List_t max_chunks;
+    CF_BenchChunk_List_t loss_ppm;
+
+    uint32      file_size;
+    uint32      segment;
+    uint32      burst;
+    uint32      reorder_ppm;
+    uint32      reorder_window;
+    uint32      dup_ppm;
+    uint32      iterations;
+    uint32      check_every;
+    uint32      max_rounds;
+    uint32      seed;
+    const char *output;
+} CF_BenchChunk_Options_t;
+
+/**
+ * @brief Simulated channel, a Gilbert-Elliott loss model with reordering and duplicates
+ *
+ * The good state loses nothing and the bad state loses everything, so the
+ * mean burst is 1 / r segments and the mean loss p / (p + r).
+ */
+typedef struct CF_BenchChunk_Channel
+{
+    uint32 rng;     /**< \brief state of the generator, never 0 */
+    bool   bad;     /**< \brief whether the channel is in the bad state */
+    double p;       /**< \brief probability of going from the good to the bad state */
+    double r;       /**< \brief probability of going from the bad to the good state */
+    double reorder; /**< \brief probability that a segment is swapped with a later one */
+    double dup;     /**< \brief probability that a segment is delivered twice */
+    uint32 window;  /**< \brief how far a segment may be moved by reordering */
+} CF_BenchChunk_Channel_t;
+
+/**
+ * @brief Cost of one chunk list operation
+ */
+typedef struct CF_BenchChunk_Op
+{
+    uint64 ops;
+    uint64 ns;
+} CF_BenchChunk_Op_t;
+
+/**
+ * @brief State of one combination of the matrix
+ */
+typedef struct CF_BenchChunk_Case
+{
+    uint32 max_chunks;
+    uint32 loss_ppm;
+    uint32 nseg;
+
+    CF_ChunkSlab_t slab;
+    CF_Chunk_t    *block_mem;
+    CF_Chunk_t   **free_blocks;
+    CF_Chunk_t   **rx_blocks;
+    CF_Chunk_t   **tx_blocks;
+    CF_ChunkList_t rx; /**< \brief chunks received, as kept by the receiver */
+    CF_ChunkList_t tx; /**< \brief chunks NAKed, as kept by the sender */
+
+    uint8      *have;    /**< \brief reference model, 1 per segment received */
+    uint32      runs;    /**< \brief runs of received segments in the model */
+    bool        evicted; /**< \brief whether the model ever had more runs than max_chunks */
+    uint32     *deliver; /**< \brief segments in the order the channel delivers them */
+    uint32     *send;    /**< \brief segments in the order the sender sends them */
+    CF_Chunk_t *gaps;    /**< \brief gaps of the receiver list */
+
+    const char        *status;
+    uint32             rounds;
+    uint32             iterations_evicted;
+    uint32             peak_runs;
+    uint32             peak_count;
+    uint64             delivered;
+    CF_BenchChunk_Op_t add;
+    CF_BenchChunk_Op_t gap;
+    CF_BenchChunk_Op_t remove;
+} CF_BenchChunk_Case_t;
+
+/**
+ * @brief Gaps collected by CF_BenchChunk_CollectGap()
+ */
+typedef struct CF_BenchChunk_Gaps
+{
+    CF_Chunk_t *v;
+    uint32      n;
+    uint32      max;
+} CF_BenchChunk_Gaps_t;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the monotonic time in nanoseconds.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 CF_BenchChunk_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Draws a number in [0, 1) from the generator of a channel.
+ *
+ *-----------------------------------------------------------------*/
+static double CF_BenchChunk_Random(CF_BenchChunk_Channel_t *ch)
+{
+    ch->rng ^= ch->rng << 13;
+    ch->rng ^= ch->rng >> 17;
+    ch->rng ^= ch->rng << 5;
+
+    return (ch->rng >> 8) / 16777216.0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Parses a comma separated list of sizes, with an optional k or M suffix.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_BenchChunk_ParseSizes(CF_BenchChunk_List_t *list, const char *arg)
+{
+    char              *end;
+    unsigned long long val;
+
+    list->n = 0;
+    do
+    {
+        val = strtoull(arg, &end, 0);
+        switch (*end)
+        {
+            case 'k':
+                val <<= 10;
+                ++end;
+                break;
+            case 'M':
+                val <<= 20;
+                ++end;
+                break;
+            default:
+                break;
+        }
+
+        if (end == arg || (*end != ',' && *end != 0) || val > UINT32_MAX || list->n >= CF_BENCH_CHUNK_MAX_LIST)
+        {
+            return -1;
+        }
+
+        list->v[list->n++] = (uint32)val;
+        arg                = end + 1;
+    } while (*end == ',');
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Parses a comma separated list of fractions into parts per million.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_BenchChunk_ParseFractions(CF_BenchChunk_List_t *list, const char *arg)
+{
+    char  *end;
+    double val;
+
+    list->n = 0;
+    do
+    {
+        val = strtod(arg, &end);
+        if (end == arg || (*end != ',' && *end != 0) || !(val >= 0.0 && val <= 1.0) ||
+            list->n >= CF_BENCH_CHUNK_MAX_LIST)
+        {
+            return -1;
+        }
+
+        list->v[list->n++] = (uint32)lround(val * 1000000.0);
+        arg                = end + 1;
+    } while (*end == ',');
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Parses a single fraction into parts per million.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_BenchChunk_ParseFraction(uint32 *ppm, const char *arg)
+{
+    CF_BenchChunk_List_t list;
+
+    if (CF_BenchChunk_ParseFractions(&list, arg) != 0 || list.n != 1)
+    {
+        return -1;
+    }
+    *ppm = list.v[0];
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Passes the segments given through the channel, returns the number delivered.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_BenchChunk_Transmit(CF_BenchChunk_Channel_t *ch, const uint32 *in, uint32 n, uint32 *out)
+{
+    uint32 num = 0;
+    uint32 i;
+    uint32 j;
+    uint32 span;
+    uint32 tmp;
+
+    for (i = 0; i < n; ++i)
+    {
+        ch->bad = ch->bad ? (CF_BenchChunk_Random(ch) >= ch->r) : (CF_BenchChunk_Random(ch) < ch->p);
+        if (!ch->bad)
+        {
+            out[num++] = in[i];
+            if (num > 1 && CF_BenchChunk_Random(ch) < ch->dup)
+            {
+                /* a copy of one of the last segments delivered */
+                span       = (ch->window > 0 && ch->window < num) ? ch->window : num;
+                j          = num - 1 - (ch->rng % span);
+                out[num++] = out[j];
+            }
+        }
+    }
+
+    for (i = 0; ch->window > 0 && i < num; ++i)
+    {
+        if (CF_BenchChunk_Random(ch) < ch->reorder)
+        {
+            j = i + 1 + (ch->rng % ch->window);
+            if (j < num)
+            {
+                tmp    = out[i];
+                out[i] = out[j];
+                out[j] = tmp;
+            }
+        }
+    }
+
+    return num;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Collects a gap, for CF_ChunkList_ComputeGaps().
+ *
+ *-----------------------------------------------------------------*/
+static void CF_BenchChunk_CollectGap(const CF_ChunkList_t *cs, const CF_Chunk_t *chunk, void *opaque)
+{
+    CF_BenchChunk_Gaps_t *gaps = opaque;
+
+    if (gaps->n < gaps->max)
+    {
+        gaps->v[gaps->n] = *chunk;
+    }
+    ++gaps->n;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Checks the structure of a list: ordered, not overlapping, not touching,
+ * within the file and on segment boundaries.  Returns the bytes it holds,
+ * or -1 on failure.
+ *
+ *-----------------------------------------------------------------*/
+static int64 CF_BenchChunk_CheckList(const CF_BenchChunk_Options_t *opt, const CF_ChunkList_t *cl, const char *name)
+{
+    const CF_Chunk_t *c;
+    CF_ChunkOffset_t  prev_end = 0;
+    int64             bytes    = 0;
+    CF_ChunkIdx_t     i;
+
+    if (cl->count > cl->max_chunks || cl->count > CF_Chunks_Capacity(cl))
+    {
+        fprintf(stderr, "cf_bench_chunk: %s list holds %lu chunks\n", name, (unsigned long)cl->count);
+        return -1;
+    }
+
+    for (i = 0; i < cl->count; ++i)
+    {
+        c = CF_ChunkList_At(cl, i);
+        if (c->size == 0 || c->offset + c->size > opt->file_size || (i > 0 && c->offset <= prev_end) ||
+            (c->offset % opt->segment) != 0 || ((c->offset + c->size) % opt->segment != 0 &&
+                                                c->offset + c->size != opt->file_size))
+        {
+            fprintf(stderr,
+                    "cf_bench_chunk: %s chunk %lu is %lu+%lu, after %lu\n",
+                    name,
+                    (unsigned long)i,
+                    (unsigned long)c->offset,
+                    (unsigned long)c->size,
+                    (unsigned long)prev_end);
+            return -1;
+        }
+        prev_end = c->offset + c->size;
+        bytes += c->size;
+    }
+
+    return bytes;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Checks the receiver list and its gaps against the model, returns -1 on failure.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_BenchChunk_CheckRx(const CF_BenchChunk_Options_t *opt, CF_BenchChunk_Case_t *bcc)
+{
+    const CF_ChunkList_t *rx = &bcc->rx;
+    const CF_Chunk_t     *c;
+    CF_BenchChunk_Gaps_t  gaps;
+    CF_ChunkOffset_t      off;
+    CF_ChunkOffset_t      end;
+    CF_ChunkIdx_t         i;
+    uint32                s;
+    uint32                e;
+    uint32                run = 0;
+    uint32                limited;
+
+    if (CF_BenchChunk_CheckList(opt, rx, "receiver") < 0)
+    {
+        return -1;
+    }
+
+    /* every byte held was received */
+    for (i = 0; i < rx->count; ++i)
+    {
+        c = CF_ChunkList_At(rx, i);
+        for (s = c->offset / opt->segment; s < (c->offset + c->size + opt->segment - 1) / opt->segment; ++s)
+        {
+            if (!bcc->have[s])
+            {
+                fprintf(stderr, "cf_bench_chunk: receiver holds segment %lu never received\n", (unsigned long)s);
+                return -1;
+            }
+        }
+    }
+
+    /* without eviction, every run of the model is a chunk */
+    if (!bcc->evicted)
+    {
+        for (s = 0; s < bcc->nseg; s = e)
+        {
+            for (e = s; e < bcc->nseg && bcc->have[e] == bcc->have[s]; ++e)
+            {
+            }
+            if (bcc->have[s])
+            {
+                end = (e == bcc->nseg) ? opt->file_size : (e * opt->segment);
+                c   = (run < rx->count) ? CF_ChunkList_At(rx, run) : NULL;
+                if (c == NULL || c->offset != s * opt->segment || c->offset + c->size != end)
+                {
+                    fprintf(stderr, "cf_bench_chunk: receiver run %lu is not a chunk\n", (unsigned long)run);
+                    return -1;
+                }
+                ++run;
+            }
+        }
+        if (run != rx->count || run != bcc->runs)
+        {
+            fprintf(stderr,
+                    "cf_bench_chunk: receiver holds %lu chunks for %lu runs\n",
+                    (unsigned long)rx->count,
+                    (unsigned long)run);
+            return -1;
+        }
+    }
+
+    /* the gaps are the complement of the list, and a limited call gives the first of them */
+    gaps.v   = bcc->gaps;
+    gaps.n   = 0;
+    gaps.max = rx->count + 1;
+    CF_ChunkList_ComputeGaps(rx, rx->count + 1, opt->file_size, 0, CF_BenchChunk_CollectGap, &gaps);
+    limited = CF_ChunkList_ComputeGaps(rx, CF_NAK_MAX_SEGMENTS, opt->file_size, 0, NULL, NULL);
+
+    off = 0;
+    run = 0;
+    for (i = 0; i <= rx->count; ++i)
+    {
+        end = (i < rx->count) ? CF_ChunkList_At(rx, i)->offset : opt->file_size;
+        if (end > off)
+        {
+            if (run >= gaps.n || bcc->gaps[run].offset != off || bcc->gaps[run].size != end - off)
+            {
+                fprintf(stderr, "cf_bench_chunk: gap %lu is not at %lu\n", (unsigned long)run, (unsigned long)off);
+                return -1;
+            }
+            ++run;
+        }
+        if (i < rx->count)
+        {
+            off = end + CF_ChunkList_At(rx, i)->size;
+        }
+    }
+    if (run != gaps.n || limited != ((run < CF_NAK_MAX_SEGMENTS) ? run : CF_NAK_MAX_SEGMENTS))
+    {
+        fprintf(stderr,
+                "cf_bench_chunk: %lu gaps computed, %lu limited, for %lu\n",
+                (unsigned long)gaps.n,
+                (unsigned long)limited,
+                (unsigned long)run);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Adds the segments delivered to the receiver in timed batches, checking
+ * after every batch.  Returns -1 on failure.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_BenchChunk_Receive(const CF_BenchChunk_Options_t *opt, CF_BenchChunk_Case_t *bcc, uint32 num)
+{
+    uint32 i;
+    uint32 j;
+    uint32 s;
+    uint32 batch;
+    uint64 t0;
+
+    for (i = 0; i < num; i += batch)
+    {
+        batch = ((num - i) < opt->check_every) ? (num - i) : opt->check_every;
+
+        t0 = CF_BenchChunk_NowNs();
+        for (j = i; j < i + batch; ++j)
+        {
+            s = bcc->deliver[j];
+            CF_ChunkListAdd(&bcc->rx,
+                            s * opt->segment,
+                            ((s + 1) == bcc->nseg) ? (opt->file_size - (s * opt->segment)) : opt->segment);
+        }
+        bcc->add.ns += CF_BenchChunk_NowNs() - t0;
+        bcc->add.ops += batch;
+
+        for (j = i; j < i + batch; ++j)
+        {
+            s = bcc->deliver[j];
+            if (!bcc->have[s])
+            {
+                bcc->have[s] = 1;
+                bcc->runs += 1;
+                bcc->runs -= (s > 0 && bcc->have[s - 1]);
+                bcc->runs -= ((s + 1) < bcc->nseg && bcc->have[s + 1]);
+            }
+            if (bcc->runs > bcc->peak_runs)
+            {
+                bcc->peak_runs = bcc->runs;
+            }
+            if (bcc->runs > bcc->max_chunks)
+            {
+                bcc->evicted = true;
+            }
+        }
+        if (bcc->rx.count > bcc->peak_count)
+        {
+            bcc->peak_count = bcc->rx.count;
+        }
+
+        if (CF_BenchChunk_CheckRx(opt, bcc) != 0)
+        {
+            return -1;
+        }
+    }
+
+    bcc->delivered += num;
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * NAKs the gaps of the receiver to the sender, and drains the sender list
+ * into the segments to send again.  Returns the number of segments to send,
+ * or -1 on failure.
+ *
+ *-----------------------------------------------------------------*/
+static int32 CF_BenchChunk_Nak(const CF_BenchChunk_Options_t *opt, CF_BenchChunk_Case_t *bcc)
+{
+    const CF_Chunk_t    *first;
+    CF_BenchChunk_Gaps_t gaps;
+    int64                bytes;
+    uint32               num  = 0;
+    uint32               sent = 0;
+    uint32               ret;
+    uint32               i;
+    uint64               t0;
+
+    gaps.v   = bcc->gaps;
+    gaps.n   = 0;
+    gaps.max = CF_NAK_MAX_SEGMENTS;
+
+    t0  = CF_BenchChunk_NowNs();
+    ret = CF_ChunkList_ComputeGaps(&bcc->rx, CF_NAK_MAX_SEGMENTS, opt->file_size, 0, CF_BenchChunk_CollectGap, &gaps);
+    bcc->gap.ns += CF_BenchChunk_NowNs() - t0;
+    ++bcc->gap.ops;
+
+    if (ret != gaps.n)
+    {
+        fprintf(stderr, "cf_bench_chunk: %lu gaps returned, %lu reported\n", (unsigned long)ret, (unsigned long)gaps.n);
+        return -1;
+    }
+
+    t0 = CF_BenchChunk_NowNs();
+    for (i = 0; i < gaps.n; ++i)
+    {
+        CF_ChunkListAdd(&bcc->tx, bcc->gaps[i].offset, bcc->gaps[i].size);
+    }
+    bcc->add.ns += CF_BenchChunk_NowNs() - t0;
+    bcc->add.ops += gaps.n;
+
+    bytes = CF_BenchChunk_CheckList(opt, &bcc->tx, "sender");
+    if (bytes < 0)
+    {
+        return -1;
+    }
+
+    t0 = CF_BenchChunk_NowNs();
+    while ((first = CF_ChunkList_GetFirstChunk(&bcc->tx)) != NULL)
+    {
+        bcc->send[num++] = first->offset / opt->segment;
+        sent += (first->size < opt->segment) ? first->size : opt->segment;
+        CF_ChunkList_RemoveFromFirst(&bcc->tx, opt->segment);
+    }
+    bcc->remove.ns += CF_BenchChunk_NowNs() - t0;
+    bcc->remove.ops += num;
+
+    /* every byte NAKed is sent once, in order */
+    for (i = 1; i < num; ++i)
+    {
+        if (bcc->send[i] <= bcc->send[i - 1])
+        {
+            fprintf(stderr,
+                    "cf_bench_chunk: sender sent segment %lu after %lu\n",
+                    (unsigned long)bcc->send[i],
+                    (unsigned long)bcc->send[i - 1]);
+            return -1;
+        }
+    }
+    if (sent != bytes)
+    {
+        fprintf(stderr, "cf_bench_chunk: sender sent %lu of %lld bytes\n", (unsigned long)sent, (long long)bytes);
+        return -1;
+    }
+
+    return num;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Sends the whole file, then its gaps round after round until it is complete.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_BenchChunk_RunIteration(const CF_BenchChunk_Options_t *opt, CF_BenchChunk_Case_t *bcc, uint32 iter)
+{
+    CF_BenchChunk_Channel_t ch;
+    double                  loss = bcc->loss_ppm / 1e6;
+    uint32                  num;
+    uint32                  rounds;
+    int32                   tosend;
+    uint32                  i;
+
+    /* the same sequence at every max_chunks */
+    memset(&ch, 0, sizeof(ch));
+    ch.rng     = ((opt->seed * 2654435761u) ^ (bcc->loss_ppm * 40503u) ^ (iter + 1)) | 1;
+    ch.r       = 1.0 / opt->burst;
+    ch.p       = (loss < 1.0) ? (loss * ch.r / (1.0 - loss)) : 1.0;
+    ch.reorder = opt->reorder_ppm / 1e6;
+    ch.dup     = opt->dup_ppm / 1e6;
+    ch.window  = opt->reorder_window;
+
+    CF_ChunkListReset(&bcc->rx);
+    CF_ChunkListReset(&bcc->tx);
+    memset(bcc->have, 0, bcc->nseg);
+    bcc->runs    = 0;
+    bcc->evicted = false;
+
+    for (i = 0; i < bcc->nseg; ++i)
+    {
+        bcc->send[i] = i;
+    }
+    tosend = bcc->nseg;
+
+    for (rounds = 0; tosend > 0; ++rounds)
+    {
+        if (rounds > opt->max_rounds)
+        {
+            bcc->status = "incomplete";
+            return;
+        }
+
+        num = CF_BenchChunk_Transmit(&ch, bcc->send, tosend, bcc->deliver);
+        if (CF_BenchChunk_Receive(opt, bcc, num) != 0)
+        {
+            bcc->status = "invariant";
+            return;
+        }
+
+        tosend = CF_BenchChunk_Nak(opt, bcc);
+        if (tosend < 0)
+        {
+            bcc->status = "invariant";
+            return;
+        }
+    }
+
+    /* no gaps left, so the list must be the whole file */
+    if (opt->file_size > 0 && (bcc->rx.count != 1 || CF_ChunkList_At(&bcc->rx, 0)->size != opt->file_size))
+    {
+        fprintf(stderr, "cf_bench_chunk: file complete with %lu chunks\n", (unsigned long)bcc->rx.count);
+        bcc->status = "invariant";
+        return;
+    }
+
+    bcc->rounds += rounds;
+    bcc->iterations_evicted += bcc->evicted;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Runs the iterations of one combination.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_BenchChunk_RunCase(const CF_BenchChunk_Options_t *opt, CF_BenchChunk_Case_t *bcc)
+{
+    CF_ChunkIdx_t num_blocks = CF_CHUNK_BLOCKS_FOR(bcc->max_chunks);
+    uint32        i;
+
+    bcc->status      = "error";
+    bcc->nseg        = (opt->file_size + opt->segment - 1) / opt->segment;
+    bcc->block_mem   = calloc(2 * num_blocks * CF_CHUNK_BLOCK_SIZE, sizeof(CF_Chunk_t));
+    bcc->free_blocks = calloc(2 * num_blocks, sizeof(CF_Chunk_t *));
+    bcc->rx_blocks   = calloc(num_blocks, sizeof(CF_Chunk_t *));
+    bcc->tx_blocks   = calloc(num_blocks, sizeof(CF_Chunk_t *));
+    bcc->have        = calloc(bcc->nseg + 1, 1);
+    bcc->deliver     = calloc(2 * bcc->nseg + 1, sizeof(uint32));
+    bcc->send        = calloc(bcc->nseg + 1, sizeof(uint32));
+    bcc->gaps        = calloc(bcc->max_chunks + CF_NAK_MAX_SEGMENTS + 1, sizeof(CF_Chunk_t));
+
+    if (bcc->block_mem != NULL && bcc->free_blocks != NULL && bcc->rx_blocks != NULL && bcc->tx_blocks != NULL &&
+        bcc->have != NULL && bcc->deliver != NULL && bcc->send != NULL && bcc->gaps != NULL)
+    {
+        /* enough blocks that both lists can grow to max_chunks */
+        CF_ChunkSlab_Init(&bcc->slab, 2 * num_blocks, 2, bcc->block_mem, bcc->free_blocks);
+        CF_ChunkListInit(&bcc->rx, bcc->max_chunks, bcc->rx_blocks, &bcc->slab);
+        CF_ChunkListInit(&bcc->tx, bcc->max_chunks, bcc->tx_blocks, &bcc->slab);
+
+        bcc->status = "ok";
+        for (i = 0; i < opt->iterations && strcmp(bcc->status, "ok") == 0; ++i)
+        {
+            CF_BenchChunk_RunIteration(opt, bcc, i);
+        }
+    }
+
+    free(bcc->block_mem);
+    free(bcc->free_blocks);
+    free(bcc->rx_blocks);
+    free(bcc->tx_blocks);
+    free(bcc->have);
+    free(bcc->deliver);
+    free(bcc->send);
+    free(bcc->gaps);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gives the mean cost of an operation, 0 rather than infinity so that the JSON stays valid.
+ *
+ *-----------------------------------------------------------------*/
+static double CF_BenchChunk_NsPerOp(const CF_BenchChunk_Op_t *op)
+{
+    return (op->ops > 0) ? ((double)op->ns / op->ops) : 0.0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the results of one combination as a JSON object.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_BenchChunk_WriteResult(FILE *out, const CF_BenchChunk_Options_t *opt, const CF_BenchChunk_Case_t *bcc,
+                                      bool first)
+{
+    fprintf(out, "%s    {\n", first ? "" : ",\n");
+    fprintf(out, "      \"max_chunks\": %lu,\n", (unsigned long)bcc->max_chunks);
+    fprintf(out, "      \"loss\": %.6f,\n", bcc->loss_ppm / 1e6);
+    fprintf(out, "      \"status\": \"%s\",\n", bcc->status);
+    fprintf(out, "      \"segments_delivered\": %llu,\n", (unsigned long long)bcc->delivered);
+    fprintf(out, "      \"rounds_per_file\": %.3f,\n", (double)bcc->rounds / opt->iterations);
+    fprintf(out, "      \"files_evicting\": %lu,\n", (unsigned long)bcc->iterations_evicted);
+    fprintf(out, "      \"peak_runs\": %lu,\n", (unsigned long)bcc->peak_runs);
+    fprintf(out, "      \"peak_chunks\": %lu,\n", (unsigned long)bcc->peak_count);
+    fprintf(out, "      \"add_ops\": %llu,\n", (unsigned long long)bcc->add.ops);
+    fprintf(out, "      \"add_ns_per_op\": %.2f,\n", CF_BenchChunk_NsPerOp(&bcc->add));
+    fprintf(out, "      \"compute_gaps_ops\": %llu,\n", (unsigned long long)bcc->gap.ops);
+    fprintf(out, "      \"compute_gaps_ns_per_op\": %.2f,\n", CF_BenchChunk_NsPerOp(&bcc->gap));
+    fprintf(out, "      \"remove_ops\": %llu,\n", (unsigned long long)bcc->remove.ops);
+    fprintf(out, "      \"remove_ns_per_op\": %.2f\n", CF_BenchChunk_NsPerOp(&bcc->remove));
+    fprintf(out, "    }");
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints the usage of the command.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_BenchChunk_Usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --max-chunks LIST       chunks a list may hold (16,64,256,1024)\n"
+            "  --loss LIST             mean fraction of the segments lost (0.01,0.05)\n"
+            "  --burst N               mean length of a loss burst, in segments (4)\n"
+            "  --reorder F             fraction of the segments moved later (0.02)\n"
+            "  --reorder-window N      how far a segment may be moved (16)\n"
+            "  --dup F                 fraction of the segments delivered twice (0.01)\n"
+            "  --file-size N           bytes per file, k/M suffixes allowed (16M)\n"
+            "  --segment N             bytes per segment (480)\n"
+            "  --iterations N          files sent per combination (8)\n"
+            "  --check-every N         additions between checks against the model (256)\n"
+            "  --max-rounds N          NAK rounds before a file is abandoned (10000)\n"
+            "  --seed N                seed of the channel (1)\n"
+            "  --output FILE           JSON results, instead of the standard output\n"
+            "LIST is a comma separated list, every combination of the lists is run.\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option LONG_OPTS[] = {
+        { "max-chunks", required_argument, NULL, 'm' },
+        { "loss", required_argument, NULL, 'l' },
+        { "burst", required_argument, NULL, 'b' },
+        { "reorder", required_argument, NULL, 'r' },
+        { "reorder-window", required_argument, NULL, 'w' },
+        { "dup", required_argument, NULL, 'd' },
+        { "file-size", required_argument, NULL, 'f' },
+        { "segment", required_argument, NULL, 'p' },
+        { "iterations", required_argument, NULL, 'i' },
+        { "check-every", required_argument, NULL, 'c' },
+        { "max-rounds", required_argument, NULL, 'R' },
+        { "seed", required_argument, NULL, 's' },
+        { "output", required_argument, NULL, 'o' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    CF_BenchChunk_Options_t opt;
+    CF_BenchChunk_Case_t    bcc;
+    CF_BenchChunk_List_t    size;
+    FILE                   *out;
+    uint32                  im, il;
+    uint32                  num_cases = 0;
+    int                     c;
+    int                     err    = 0;
+    int                     status = EXIT_SUCCESS;
+
+    memset(&opt, 0, sizeof(opt));
+    CF_BenchChunk_ParseSizes(&opt.max_chunks, "16,64,256,1024");
+    CF_BenchChunk_ParseFractions(&opt.loss_ppm, "0.01,0.05");
+    opt.file_size      = 16 << 20;
+    opt.segment        = 480;
+    opt.burst          = 4;
+    opt.reorder_ppm    = 20000;
+    opt.reorder_window = 16;
+    opt.dup_ppm        = 10000;
+    opt.iterations     = 8;
+    opt.check_every    = 256;
+    opt.max_rounds     = 10000;
+    opt.seed           = 1;
+
+    while ((c = getopt_long(argc, argv, "h", LONG_OPTS, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'm':
+                err |= CF_BenchChunk_ParseSizes(&opt.max_chunks, optarg);
+                break;
+            case 'l':
+                err |= CF_BenchChunk_ParseFractions(&opt.loss_ppm, optarg);
+                break;
+            case 'b':
+                opt.burst = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                err |= CF_BenchChunk_ParseFraction(&opt.reorder_ppm, optarg);
+                break;
+            case 'w':
+                opt.reorder_window = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                err |= CF_BenchChunk_ParseFraction(&opt.dup_ppm, optarg);
+                break;
+            case 'f':
+                err |= CF_BenchChunk_ParseSizes(&size, optarg);
+                err |= (size.n == 1) ? 0 : -1;
+                opt.file_size = size.v[0];
+                break;
+            case 'p':
+                opt.segment = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                opt.iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                opt.check_every = strtoul(optarg, NULL, 0);
+                break;
+            case 'R':
+                opt.max_rounds = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                opt.seed = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                opt.output = optarg;
+                break;
+            default:
+                err = -1;
+                break;
+        }
+    }
+
+    if (err != 0 || optind != argc || opt.segment == 0 || opt.burst == 0 || opt.iterations == 0 ||
+        opt.check_every == 0)
+    {
+        CF_BenchChunk_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (im = 0; im < opt.max_chunks.n; ++im)
+    {
+        if (opt.max_chunks.v[im] == 0)
+        {
+            CF_BenchChunk_Usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    for (il = 0; il < opt.loss_ppm.n; ++il)
+    {
+        if (opt.loss_ppm.v[il] >= 1000000)
+        {
+            CF_BenchChunk_Usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    out = (opt.output != NULL) ? fopen(opt.output, "w") : stdout;
+    if (out == NULL)
+    {
+        perror(opt.output);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"cf_chunk\",\n");
+    fprintf(out, "  \"version\": \"%d.%d.%d\",\n", CF_MAJOR_VERSION, CF_MINOR_VERSION, CF_REVISION);
+    fprintf(out, "  \"file_size\": %lu,\n", (unsigned long)opt.file_size);
+    fprintf(out, "  \"segment\": %lu,\n", (unsigned long)opt.segment);
+    fprintf(out, "  \"burst\": %lu,\n", (unsigned long)opt.burst);
+    fprintf(out, "  \"reorder\": %.6f,\n", opt.reorder_ppm / 1e6);
+    fprintf(out, "  \"reorder_window\": %lu,\n", (unsigned long)opt.reorder_window);
+    fprintf(out, "  \"dup\": %.6f,\n", opt.dup_ppm / 1e6);
+    fprintf(out, "  \"iterations\": %lu,\n", (unsigned long)opt.iterations);
+    fprintf(out, "  \"nak_max_segments\": %lu,\n", (unsigned long)CF_NAK_MAX_SEGMENTS);
+    fprintf(out, "  \"seed\": %lu,\n", (unsigned long)opt.seed);
+    fprintf(out, "  \"cases\": [\n");
+
+    for (im = 0; im < opt.max_chunks.n; ++im)
+    {
+        for (il = 0; il < opt.loss_ppm.n; ++il)
+        {
+            memset(&bcc, 0, sizeof(bcc));
+            bcc.max_chunks = opt.max_chunks.v[im];
+            bcc.loss_ppm   = opt.loss_ppm.v[il];
+
+            CF_BenchChunk_RunCase(&opt, &bcc);
+            CF_BenchChunk_WriteResult(out, &opt, &bcc, num_cases == 0);
+            ++num_cases;
+
+            fprintf(stderr,
+                    "cf_bench_chunk: max_chunks %lu, loss %.4f: %s, add %.1f ns, gaps %.1f ns, remove %.1f ns\n",
+                    (unsigned long)bcc.max_chunks,
+                    bcc.loss_ppm / 1e6,
+                    bcc.status,
+                    CF_BenchChunk_NsPerOp(&bcc.add),
+                    CF_BenchChunk_NsPerOp(&bcc.gap),
+                    CF_BenchChunk_NsPerOp(&bcc.remove));
+
+            if (strcmp(bcc.status, "ok") != 0)
+            {
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    return status;
+}
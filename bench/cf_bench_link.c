@@ -0,0 +1,265 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Loopback link between the two CF instances of a benchmark run
+ *
+ * Each datagram is the channel number followed by a PDU without its SB
+ * headers.  The sender drops PDUs at the configured rate and holds the
+ * others for the configured delay, and the receiver wraps them in a
+ * message to the input message ID of the channel.
+ */
+
+#include "cf_bench.h"
+#include "cf_app.h"
+#include "cf_cfdp_pdu.h"
+#include "cf_cfdp_sbintf.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+
+/* PDUs held for their delay at once, beyond this they are dropped */
+#define CF_BENCH_LINK_QUEUE_SIZE 8192
+
+#define CF_BENCH_LINK_MAX_PDU (CF_MAX_PDU_SIZE + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES)
+
+/* room for the larger of the two headers a PDU may be wrapped in */
+#define CF_BENCH_LINK_MAX_ENCAP (offsetof(CF_PduTlmMsg_t, ph) + offsetof(CF_PduCmdMsg_t, ph))
+
+/**
+ * @brief A PDU held for its delay
+ */
+typedef struct CF_Bench_LinkEntry
+{
+    uint64 due_ns;
+    uint16 len; /**< \brief length of data, the channel number and the PDU */
+    uint8  data[1 + CF_BENCH_LINK_MAX_PDU];
+} CF_Bench_LinkEntry_t;
+
+CF_Bench_Link_t CF_Bench_Link;
+
+static CF_Bench_LinkEntry_t *CF_Bench_LinkQueue;
+static uint32                CF_Bench_LinkHead;
+static uint32                CF_Bench_LinkCount;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Draws the next number of the loss generator (xorshift32).
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Bench_LinkRandom(void)
+{
+    uint32 x = CF_Bench_Link.rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    CF_Bench_Link.rng = x;
+
+    return x;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Checks if an encoded PDU is a NAK, from the fixed part of its header.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Bench_LinkIsNak(const uint8 *pdu, size_t len)
+{
+    size_t hdr_len;
+
+    /* the PDU type bit is set on file data */
+    if (len < 4 || (pdu[0] & 0x10) != 0)
+    {
+        return false;
+    }
+
+    /* fixed header, then the source and destination entity IDs and the sequence number */
+    hdr_len = 4 + (2 * (((pdu[3] >> 4) & 0x7) + 1)) + ((pdu[3] & 0x7) + 1);
+
+    return (len > hdr_len && pdu[hdr_len] == CF_CFDP_FileDirective_NAK);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes a datagram to the other instance.
+ *
+ * Returns false if the socket is full, to try again later.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Bench_LinkWrite(const uint8 *data, size_t len)
+{
+    if (send(CF_Bench_Link.sock, data, len, MSG_DONTWAIT) < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        {
+            return false;
+        }
+
+        /* the other instance is gone, so is the PDU */
+        ++CF_Bench_Stats->pdus_dropped;
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the held PDUs whose delay expired, in order.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bench_LinkFlush(void)
+{
+    CF_Bench_LinkEntry_t *entry;
+    uint64                now = CF_Bench_NowNs();
+
+    while (CF_Bench_LinkCount > 0)
+    {
+        entry = &CF_Bench_LinkQueue[CF_Bench_LinkHead];
+        if (entry->due_ns > now || !CF_Bench_LinkWrite(entry->data, entry->len))
+        {
+            break;
+        }
+
+        CF_Bench_LinkHead = (CF_Bench_LinkHead + 1) % CF_BENCH_LINK_QUEUE_SIZE;
+        --CF_Bench_LinkCount;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bench.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bench_LinkSend(uint8 chan, const CFE_SB_Buffer_t *BufPtr)
+{
+    CF_Bench_LinkEntry_t *entry;
+    CFE_MSG_Size_t        size = 0;
+    CFE_MSG_Type_t        type = CFE_MSG_Type_Invalid;
+    size_t                hdr_len;
+    size_t                len;
+    const uint8          *pdu;
+
+    CFE_MSG_GetSize(&BufPtr->Msg, &size);
+    CFE_MSG_GetType(&BufPtr->Msg, &type);
+    hdr_len = (type == CFE_MSG_Type_Cmd) ? offsetof(CF_PduCmdMsg_t, ph) : offsetof(CF_PduTlmMsg_t, ph);
+    if (size <= hdr_len || (size - hdr_len) > CF_BENCH_LINK_MAX_PDU)
+    {
+        return;
+    }
+
+    pdu = (const uint8 *)BufPtr + hdr_len;
+    len = size - hdr_len;
+
+    ++CF_Bench_Stats->pdus_sent;
+    if (CF_Bench_LinkIsNak(pdu, len))
+    {
+        ++CF_Bench_Stats->nak_pdus;
+    }
+
+    if (CF_Bench_Link.loss_ppm != 0 && (CF_Bench_LinkRandom() % 1000000) < CF_Bench_Link.loss_ppm)
+    {
+        ++CF_Bench_Stats->pdus_dropped;
+        return;
+    }
+
+    if (CF_Bench_LinkQueue == NULL)
+    {
+        CF_Bench_LinkQueue = malloc(CF_BENCH_LINK_QUEUE_SIZE * sizeof(*CF_Bench_LinkQueue));
+    }
+    if (CF_Bench_LinkQueue == NULL || CF_Bench_LinkCount >= CF_BENCH_LINK_QUEUE_SIZE)
+    {
+        ++CF_Bench_Stats->pdus_overflow;
+        return;
+    }
+
+    /* always queued, so that PDUs held back by a full socket stay in order */
+    entry         = &CF_Bench_LinkQueue[(CF_Bench_LinkHead + CF_Bench_LinkCount) % CF_BENCH_LINK_QUEUE_SIZE];
+    entry->due_ns = CF_Bench_NowNs() + ((uint64)CF_Bench_Link.delay_ms * 1000000);
+    entry->len    = 1 + len;
+    entry->data[0] = chan;
+    memcpy(&entry->data[1], pdu, len);
+    ++CF_Bench_LinkCount;
+
+    if (CF_Bench_Link.delay_ms == 0)
+    {
+        CF_Bench_LinkFlush();
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bench.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bench_LinkPoll(void)
+{
+    uint8            data[1 + CF_BENCH_LINK_MAX_PDU];
+    ssize_t          len;
+    CFE_SB_Buffer_t *BufPtr;
+    CFE_MSG_Type_t   type;
+    size_t           hdr_len;
+
+    CF_Bench_LinkFlush();
+
+    while ((len = recv(CF_Bench_Link.sock, data, sizeof(data), MSG_DONTWAIT)) > 1)
+    {
+        if (data[0] >= CF_NUM_CHANNELS || CF_AppData.config_table == NULL)
+        {
+            continue;
+        }
+
+        BufPtr = CFE_SB_AllocateMessageBuffer(CF_BENCH_LINK_MAX_ENCAP + len);
+        if (BufPtr == NULL)
+        {
+            ++CF_Bench_Stats->pdus_overflow;
+            continue;
+        }
+
+        /* the header depends on the type of the input message ID */
+        CFE_MSG_Init(&BufPtr->Msg,
+                     CFE_SB_ValueToMsgId(CF_AppData.config_table->chan[data[0]].mid_input),
+                     sizeof(CFE_MSG_CommandHeader_t));
+        CFE_MSG_GetType(&BufPtr->Msg, &type);
+        hdr_len = (type == CFE_MSG_Type_Cmd) ? offsetof(CF_PduCmdMsg_t, ph) : offsetof(CF_PduTlmMsg_t, ph);
+
+        memcpy((uint8 *)BufPtr + hdr_len, &data[1], len - 1);
+        CFE_MSG_SetSize(&BufPtr->Msg, hdr_len + len - 1);
+
+        if (CF_Bench_Deliver(BufPtr) != CFE_SUCCESS)
+        {
+            CFE_SB_ReleaseMessageBuffer(BufPtr);
+        }
+    }
+}
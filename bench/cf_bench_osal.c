@@ -0,0 +1,453 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Minimal stand-in of the OSAL services used by CF, for the host benchmark
+ *
+ * Paths are host paths, used as they are or under CF_Bench_Root, where the
+ * missing parent directories of the files created are made.  File and
+ * directory IDs are made from the host descriptors, and the throttling
+ * semaphores never exist.
+ */
+
+#include "cf_bench.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CF_BENCH_MAX_FILES 1024
+#define CF_BENCH_MAX_DIRS  16
+
+/* IDs are offset from the host descriptors so that none is undefined */
+#define CF_BENCH_FILE_ID_BASE 0x10000
+#define CF_BENCH_DIR_ID_BASE  0x20000
+
+/* room for CF_Bench_Root and a path of CF */
+#define CF_BENCH_HOST_PATH_LEN (2 * OS_MAX_PATH_LEN)
+
+const char *CF_Bench_Root;
+
+/* open files, kept for OS_FileOpenCheck() */
+static char CF_Bench_FilePath[CF_BENCH_MAX_FILES][OS_MAX_PATH_LEN];
+static DIR *CF_Bench_Dirs[CF_BENCH_MAX_DIRS];
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the host path of a path of CF, and makes its parent directories if asked to.
+ *
+ *-----------------------------------------------------------------*/
+static const char *CF_Bench_HostPath(char *buf, const char *path, bool make_parent)
+{
+    char *slash;
+
+    if (CF_Bench_Root == NULL)
+    {
+        return path;
+    }
+
+    snprintf(buf, CF_BENCH_HOST_PATH_LEN, "%s/%s", CF_Bench_Root, (path[0] == '/') ? &path[1] : path);
+
+    if (make_parent)
+    {
+        for (slash = strchr(&buf[strlen(CF_Bench_Root) + 1], '/'); slash != NULL; slash = strchr(slash + 1, '/'))
+        {
+            *slash = 0;
+            mkdir(buf, 0755);
+            *slash = '/';
+        }
+    }
+
+    return buf;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the host descriptor of a file ID, or -1.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Bench_FileDesc(osal_id_t filedes)
+{
+    unsigned long idx = OS_ObjectIdToInteger(filedes) - CF_BENCH_FILE_ID_BASE;
+
+    if (idx >= CF_BENCH_MAX_FILES || CF_Bench_FilePath[idx][0] == 0)
+    {
+        return -1;
+    }
+
+    return (int)idx;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the directory stream of a directory ID, or NULL.
+ *
+ *-----------------------------------------------------------------*/
+static DIR *CF_Bench_Dir(osal_id_t dir_id)
+{
+    unsigned long idx = OS_ObjectIdToInteger(dir_id) - CF_BENCH_DIR_ID_BASE;
+
+    return (idx < CF_BENCH_MAX_DIRS) ? CF_Bench_Dirs[idx] : NULL;
+}
+
+/*
+ * Files
+ */
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode)
+{
+    char host[CF_BENCH_HOST_PATH_LEN];
+    int  oflag;
+    int  fd;
+
+    *filedes = OS_OBJECT_ID_UNDEFINED;
+
+    switch (access_mode)
+    {
+        case OS_READ_ONLY:
+            oflag = O_RDONLY;
+            break;
+        case OS_WRITE_ONLY:
+            oflag = O_WRONLY;
+            break;
+        case OS_READ_WRITE:
+            oflag = O_RDWR;
+            break;
+        default:
+            return OS_ERROR;
+    }
+
+    if (flags & OS_FILE_FLAG_CREATE)
+    {
+        oflag |= O_CREAT;
+    }
+    if (flags & OS_FILE_FLAG_TRUNCATE)
+    {
+        oflag |= O_TRUNC;
+    }
+
+    fd = open(CF_Bench_HostPath(host, path, (flags & OS_FILE_FLAG_CREATE) != 0), oflag, 0644);
+    if (fd < 0)
+    {
+        return OS_ERROR;
+    }
+    if (fd >= CF_BENCH_MAX_FILES)
+    {
+        close(fd);
+        return OS_ERR_NO_FREE_IDS;
+    }
+
+    snprintf(CF_Bench_FilePath[fd], sizeof(CF_Bench_FilePath[fd]), "%s", path);
+    *filedes = OS_ObjectIdFromInteger(CF_BENCH_FILE_ID_BASE + fd);
+
+    return OS_SUCCESS;
+}
+
+int32 OS_close(osal_id_t filedes)
+{
+    int fd = CF_Bench_FileDesc(filedes);
+
+    if (fd < 0)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    CF_Bench_FilePath[fd][0] = 0;
+
+    return (close(fd) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes)
+{
+    int     fd = CF_Bench_FileDesc(filedes);
+    ssize_t ret;
+
+    if (fd < 0)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    ret = read(fd, buffer, nbytes);
+
+    return (ret < 0) ? OS_ERROR : (int32)ret;
+}
+
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes)
+{
+    int     fd = CF_Bench_FileDesc(filedes);
+    ssize_t ret;
+
+    if (fd < 0)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    ret = write(fd, buffer, nbytes);
+
+    return (ret < 0) ? OS_ERROR : (int32)ret;
+}
+
+int32 OS_lseek(osal_id_t filedes, int32 offset, uint32 whence)
+{
+    int   fd = CF_Bench_FileDesc(filedes);
+    int   where;
+    off_t ret;
+
+    if (fd < 0)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    switch (whence)
+    {
+        case OS_SEEK_SET:
+            where = SEEK_SET;
+            break;
+        case OS_SEEK_CUR:
+            where = SEEK_CUR;
+            break;
+        case OS_SEEK_END:
+            where = SEEK_END;
+            break;
+        default:
+            return OS_ERROR;
+    }
+
+    ret = lseek(fd, offset, where);
+
+    return (ret < 0) ? OS_ERROR : (int32)ret;
+}
+
+int32 OS_FileOpenCheck(const char *Filename)
+{
+    int i;
+
+    for (i = 0; i < CF_BENCH_MAX_FILES; ++i)
+    {
+        if (CF_Bench_FilePath[i][0] != 0 && strcmp(CF_Bench_FilePath[i], Filename) == 0)
+        {
+            return OS_SUCCESS;
+        }
+    }
+
+    return OS_ERROR;
+}
+
+int32 OS_stat(const char *path, os_fstat_t *filestats)
+{
+    char        host[CF_BENCH_HOST_PATH_LEN];
+    struct stat st;
+
+    if (stat(CF_Bench_HostPath(host, path, false), &st) != 0)
+    {
+        return OS_ERROR;
+    }
+
+    memset(filestats, 0, sizeof(*filestats));
+    filestats->FileSize = st.st_size;
+    filestats->FileTime = OS_TimeAssembleFromNanoseconds(st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+    if (S_ISDIR(st.st_mode))
+    {
+        filestats->FileModeBits |= OS_FILESTAT_MODE_DIR;
+    }
+    if (st.st_mode & S_IRUSR)
+    {
+        filestats->FileModeBits |= OS_FILESTAT_MODE_READ;
+    }
+    if (st.st_mode & S_IWUSR)
+    {
+        filestats->FileModeBits |= OS_FILESTAT_MODE_WRITE;
+    }
+    if (st.st_mode & S_IXUSR)
+    {
+        filestats->FileModeBits |= OS_FILESTAT_MODE_EXEC;
+    }
+
+    return OS_SUCCESS;
+}
+
+int32 OS_remove(const char *path)
+{
+    char host[CF_BENCH_HOST_PATH_LEN];
+
+    return (unlink(CF_Bench_HostPath(host, path, false)) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_rename(const char *old_filename, const char *new_filename)
+{
+    char        host_old[CF_BENCH_HOST_PATH_LEN];
+    char        host_new[CF_BENCH_HOST_PATH_LEN];
+    const char *src  = CF_Bench_HostPath(host_old, old_filename, false);
+    const char *dest = CF_Bench_HostPath(host_new, new_filename, true);
+
+    return (rename(src, dest) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_mv(const char *src, const char *dest)
+{
+    /* the run directories of the benchmark are all on one file system */
+    return OS_rename(src, dest);
+}
+
+/*
+ * Directories
+ */
+
+int32 OS_mkdir(const char *path, uint32 access)
+{
+    char host[CF_BENCH_HOST_PATH_LEN];
+
+    return (mkdir(CF_Bench_HostPath(host, path, true), 0755) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_DirectoryOpen(osal_id_t *dir_id, const char *path)
+{
+    char host[CF_BENCH_HOST_PATH_LEN];
+    int  i;
+
+    *dir_id = OS_OBJECT_ID_UNDEFINED;
+
+    for (i = 0; i < CF_BENCH_MAX_DIRS; ++i)
+    {
+        if (CF_Bench_Dirs[i] == NULL)
+        {
+            CF_Bench_Dirs[i] = opendir(CF_Bench_HostPath(host, path, false));
+            if (CF_Bench_Dirs[i] == NULL)
+            {
+                return OS_ERROR;
+            }
+
+            *dir_id = OS_ObjectIdFromInteger(CF_BENCH_DIR_ID_BASE + i);
+            return OS_SUCCESS;
+        }
+    }
+
+    return OS_ERR_NO_FREE_IDS;
+}
+
+int32 OS_DirectoryRead(osal_id_t dir_id, os_dirent_t *dirent)
+{
+    DIR           *dir = CF_Bench_Dir(dir_id);
+    struct dirent *de;
+
+    if (dir == NULL)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    de = readdir(dir);
+    if (de == NULL)
+    {
+        return OS_ERROR;
+    }
+
+    snprintf(dirent->FileName, sizeof(dirent->FileName), "%s", de->d_name);
+
+    return OS_SUCCESS;
+}
+
+int32 OS_DirectoryClose(osal_id_t dir_id)
+{
+    DIR *dir = CF_Bench_Dir(dir_id);
+
+    if (dir == NULL)
+    {
+        return OS_ERR_INVALID_ID;
+    }
+
+    closedir(dir);
+    CF_Bench_Dirs[OS_ObjectIdToInteger(dir_id) - CF_BENCH_DIR_ID_BASE] = NULL;
+
+    return OS_SUCCESS;
+}
+
+/*
+ * Semaphores, tasks, time and console
+ */
+
+int32 OS_CountSemGetIdByName(osal_id_t *sem_id, const char *sem_name)
+{
+    /* no throttling semaphore is ever created here */
+    *sem_id = OS_OBJECT_ID_UNDEFINED;
+
+    return OS_ERR_NAME_NOT_FOUND;
+}
+
+int32 OS_CountSemTimedWait(osal_id_t sem_id, uint32 msecs)
+{
+    return OS_SUCCESS;
+}
+
+int32 OS_TaskDelay(uint32 millisecond)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = millisecond / 1000;
+    ts.tv_nsec = (millisecond % 1000) * 1000000L;
+
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+
+    return OS_SUCCESS;
+}
+
+int32 OS_GetLocalTime(OS_time_t *time_struct)
+{
+    struct timespec ts;
+
+    if (CF_Bench_VirtualTimeNs != 0)
+    {
+        ts.tv_sec  = CF_Bench_VirtualTimeNs / 1000000000;
+        ts.tv_nsec = CF_Bench_VirtualTimeNs % 1000000000;
+    }
+    else
+    {
+        clock_gettime(CLOCK_REALTIME, &ts);
+    }
+    *time_struct = OS_TimeAssembleFromNanoseconds(ts.tv_sec, ts.tv_nsec);
+
+    return OS_SUCCESS;
+}
+
+void OS_printf(const char *string, ...)
+{
+    va_list ap;
+
+    if (CF_Bench_Verbose)
+    {
+        va_start(ap, string);
+        vfprintf(stderr, string, ap);
+        va_end(ap);
+    }
+}
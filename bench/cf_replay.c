@@ -0,0 +1,612 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Replay of a PDU capture into a CF instance on a host
+ *
+ * The blocks of a capture file written by CF, see cf_capture.h, are put back
+ * in order, and a CF instance on the stand-ins of the benchmark is woken up
+ * once for each wakeup of the capture, from the first PDU to the last.  The
+ * PDUs received in a wakeup of the capture are put on the input pipes before
+ * that wakeup, and the clock seen by CF starts at the time of the first PDU
+ * and moves by one wakeup period each wakeup, so that a replay gives the same
+ * run each time, whatever the speed and the load of the host.  The PDUs the
+ * instance sends are compared, in order, with those sent in the capture.
+ *
+ *     cf_replay --dir /tmp/cf_replay --speed 4 pass.cap
+ *
+ * The instance uses the default configuration table, with the entity ID and
+ * wakeup rate of the capture, and the paths of CF are taken under the work
+ * directory.  Transactions started by commands are not part of a capture,
+ * so only the receive side and the answers to the peer are replayed.
+ */
+
+#include "cf_bench.h"
+#include "cf_app.h"
+#include "cf_capture.h"
+#include "cf_dispatch.h"
+#include "cf_msgids.h"
+#include "cf_version.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CF_REPLAY_PIPE_DEPTH     1000
+#define CF_REPLAY_SOCK_BUF_BYTES (4 * 1024 * 1024)
+
+/**
+ * @brief The default configuration table, see fsw/tables/cf_def_config.c
+ */
+extern CF_ConfigTable_t CF_config_table;
+
+/**
+ * @brief A block of the capture file
+ */
+typedef struct CF_Replay_Block
+{
+    uint32       seq;
+    uint32       used;
+    const uint8 *records;
+} CF_Replay_Block_t;
+
+/**
+ * @brief A PDU of the capture
+ */
+typedef struct CF_Replay_Pdu
+{
+    uint32       tick;
+    uint64       time_ns;
+    uint8        chan;
+    uint8        dir;
+    uint16       len;
+    const uint8 *data;
+} CF_Replay_Pdu_t;
+
+/**
+ * @brief A capture read into memory
+ */
+typedef struct CF_Replay_Capture
+{
+    uint8           *file;
+    CF_Replay_Pdu_t *pdus;
+    uint32           num_pdus;
+    uint32           ticks_per_second;
+    CF_EntityId_t    local_eid;
+} CF_Replay_Capture_t;
+
+/**
+ * @brief Command line options
+ */
+typedef struct CF_Replay_Options
+{
+    double      speed;
+    uint32      tail_s;
+    const char *dir;
+    const char *capture;
+} CF_Replay_Options_t;
+
+/**
+ * @brief Results of a replay
+ */
+typedef struct CF_Replay_Result
+{
+    uint32 wakeups;
+    uint64 pdus_rx;
+    uint64 pdus_tx_captured;
+    uint64 pdus_tx_replayed;
+    uint64 pdus_tx_matched;
+    int64  first_mismatch_tick; /**< \brief wakeup of the capture the sent PDUs first differ in, -1 if none */
+    double time_s;
+    double cpu_s;
+} CF_Replay_Result_t;
+
+/**
+ * @brief Counters of the instance, see cf_bench_cfe.c
+ */
+static CF_Bench_Stats_t CF_Replay_Stats;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Loads a big endian number of size octets.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 CF_Replay_Load(const uint8 *octets, size_t size)
+{
+    uint64 val = 0;
+    size_t i;
+
+    for (i = 0; i < size; ++i)
+    {
+        val = (val << 8) | octets[i];
+    }
+
+    return val;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Orders the blocks by their number.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Replay_CompareBlocks(const void *a, const void *b)
+{
+    const CF_Replay_Block_t *ba = a;
+    const CF_Replay_Block_t *bb = b;
+
+    return (ba->seq > bb->seq) - (ba->seq < bb->seq);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads a capture file, and lists its PDUs in the order they were seen.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Replay_ReadCapture(const char *path, CF_Replay_Capture_t *cap)
+{
+    const CF_CaptureBlockHeader_t *hdr;
+    const CF_CaptureRecord_t      *rec;
+    CF_Replay_Block_t             *blocks;
+    CF_Replay_Pdu_t               *pdu;
+    FILE                          *fp;
+    struct stat                    st;
+    size_t                         num_blocks = 0;
+    size_t                         max_pdus;
+    size_t                         off;
+    size_t                         pos;
+    size_t                         i;
+
+    memset(cap, 0, sizeof(*cap));
+
+    fp = fopen(path, "rb");
+    if (fp == NULL || fstat(fileno(fp), &st) != 0)
+    {
+        fprintf(stderr, "cf_replay: cannot read %s: %s\n", path, strerror(errno));
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        return -1;
+    }
+
+    cap->file = malloc(st.st_size + 1);
+    blocks    = calloc((st.st_size / CF_CAPTURE_BLOCK_SIZE) + 1, sizeof(*blocks));
+    if (cap->file == NULL || blocks == NULL || fread(cap->file, 1, st.st_size, fp) != (size_t)st.st_size)
+    {
+        fprintf(stderr, "cf_replay: cannot read %s\n", path);
+        fclose(fp);
+        free(blocks);
+        return -1;
+    }
+    fclose(fp);
+
+    /* the last block of the file may be shorter, only its used part was written */
+    for (off = 0; off + sizeof(*hdr) <= (size_t)st.st_size; off += CF_CAPTURE_BLOCK_SIZE)
+    {
+        hdr = (const CF_CaptureBlockHeader_t *)&cap->file[off];
+        if (CF_Replay_Load(hdr->magic.octets, sizeof(hdr->magic)) != CF_CAPTURE_MAGIC ||
+            CF_Replay_Load(hdr->version.octets, sizeof(hdr->version)) != CF_CAPTURE_VERSION ||
+            CF_Replay_Load(hdr->header_size.octets, sizeof(hdr->header_size)) != sizeof(*hdr) ||
+            CF_Replay_Load(hdr->block_size.octets, sizeof(hdr->block_size)) != CF_CAPTURE_BLOCK_SIZE)
+        {
+            fprintf(stderr, "cf_replay: %s: no valid capture block at offset %lu\n", path, (unsigned long)off);
+            free(blocks);
+            return -1;
+        }
+
+        blocks[num_blocks].seq     = CF_Replay_Load(hdr->seq.octets, sizeof(hdr->seq));
+        blocks[num_blocks].used    = CF_Replay_Load(hdr->used.octets, sizeof(hdr->used));
+        blocks[num_blocks].records = &cap->file[off + sizeof(*hdr)];
+        if (blocks[num_blocks].used > CF_CAPTURE_BLOCK_SIZE - sizeof(*hdr) ||
+            off + sizeof(*hdr) + blocks[num_blocks].used > (size_t)st.st_size)
+        {
+            fprintf(stderr, "cf_replay: %s: truncated capture block at offset %lu\n", path, (unsigned long)off);
+            free(blocks);
+            return -1;
+        }
+
+        cap->ticks_per_second = CF_Replay_Load(hdr->ticks_per_second.octets, sizeof(hdr->ticks_per_second));
+        cap->local_eid        = CF_Replay_Load(hdr->local_eid.octets, sizeof(hdr->local_eid));
+        ++num_blocks;
+    }
+
+    if (num_blocks == 0 || cap->ticks_per_second == 0)
+    {
+        fprintf(stderr, "cf_replay: %s is not a capture\n", path);
+        free(blocks);
+        return -1;
+    }
+
+    qsort(blocks, num_blocks, sizeof(*blocks), CF_Replay_CompareBlocks);
+
+    /* every record is at least its header */
+    max_pdus  = (st.st_size / sizeof(*rec)) + 1;
+    cap->pdus = calloc(max_pdus, sizeof(*cap->pdus));
+    if (cap->pdus == NULL)
+    {
+        free(blocks);
+        return -1;
+    }
+
+    for (i = 0; i < num_blocks; ++i)
+    {
+        for (pos = 0; pos + sizeof(*rec) <= blocks[i].used; pos += sizeof(*rec) + pdu->len)
+        {
+            rec = (const CF_CaptureRecord_t *)&blocks[i].records[pos];
+            pdu = &cap->pdus[cap->num_pdus];
+
+            pdu->tick    = CF_Replay_Load(rec->tick.octets, sizeof(rec->tick));
+            pdu->time_ns = (CF_Replay_Load(rec->time_secs.octets, sizeof(rec->time_secs)) * 1000000000) +
+                           ((CF_Replay_Load(rec->time_subsecs.octets, sizeof(rec->time_subsecs)) * 1000000000) >> 32);
+            pdu->len     = CF_Replay_Load(rec->len.octets, sizeof(rec->len));
+            pdu->chan    = rec->chan.octets[0];
+            pdu->dir     = rec->dir.octets[0];
+            pdu->data    = (const uint8 *)(rec + 1);
+
+            if (pos + sizeof(*rec) + pdu->len > blocks[i].used || pdu->chan >= CF_NUM_CHANNELS)
+            {
+                fprintf(stderr, "cf_replay: %s: bad record in block %lu\n", path, (unsigned long)blocks[i].seq);
+                free(blocks);
+                return -1;
+            }
+
+            ++cap->num_pdus;
+        }
+    }
+
+    free(blocks);
+
+    if (cap->num_pdus == 0)
+    {
+        fprintf(stderr, "cf_replay: %s holds no PDU\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Sets up the configuration table of the instance from the default table.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Replay_SetupTable(const CF_Replay_Capture_t *cap)
+{
+    CF_ConfigTable_t   *tbl = &CF_Bench_Config;
+    CF_ChannelConfig_t *cc;
+    int                 i;
+    int                 j;
+
+    *tbl = CF_config_table;
+
+    tbl->ticks_per_second = cap->ticks_per_second;
+    tbl->local_eid        = cap->local_eid;
+
+    /* nothing is kept across replays, and the replay itself is not captured */
+    tbl->checkpoint_interval_s = 0;
+    tbl->journal_file[0]       = 0;
+    tbl->spill_idle_s          = 0;
+    tbl->poll_index_file[0]    = 0;
+    tbl->stats_shm_name[0]     = 0;
+    tbl->capture_file[0]       = 0;
+
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        cc = &tbl->chan[i];
+
+        /* every PDU of a wakeup of the capture is read in that wakeup */
+        cc->rx_max_messages_per_wakeup = CF_REPLAY_PIPE_DEPTH;
+        cc->pipe_depth_input           = CF_REPLAY_PIPE_DEPTH;
+        cc->sem_name[0]                = 0;
+        cc->move_dir[0]                = 0;
+
+        for (j = 0; j < CF_MAX_POLLING_DIR_PER_CHAN; ++j)
+        {
+            cc->polldir[j].enabled = 0;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Compares the PDUs the instance sent with those sent in the capture.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Replay_CheckSent(int sock, const CF_Replay_Capture_t *cap, uint32 *next_tx, uint32 tick,
+                                CF_Replay_Result_t *res)
+{
+    uint8                  data[1 + CF_MAX_PDU_SIZE + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES];
+    const CF_Replay_Pdu_t *expected;
+    ssize_t                len;
+
+    while ((len = recv(sock, data, sizeof(data), MSG_DONTWAIT)) > 0)
+    {
+        ++res->pdus_tx_replayed;
+
+        while (*next_tx < cap->num_pdus && cap->pdus[*next_tx].dir != CF_CAPTURE_DIR_TX)
+        {
+            ++*next_tx;
+        }
+        expected = (*next_tx < cap->num_pdus) ? &cap->pdus[*next_tx] : NULL;
+        ++*next_tx;
+
+        if (res->first_mismatch_tick < 0)
+        {
+            if (expected != NULL && expected->chan == data[0] && expected->len == (size_t)(len - 1) &&
+                memcmp(expected->data, &data[1], expected->len) == 0)
+            {
+                ++res->pdus_tx_matched;
+            }
+            else
+            {
+                res->first_mismatch_tick = tick;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Runs the instance through the wakeups of the capture.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_Replay_Run(const CF_Replay_Options_t *opt, const CF_Replay_Capture_t *cap, CF_Replay_Result_t *res)
+{
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        CF_WakeupCmd_t  Cmd;
+    } wakeup;
+    uint8            data[1 + CF_MAX_PDU_SIZE];
+    int              sv[2];
+    int              buf_bytes  = CF_REPLAY_SOCK_BUF_BYTES;
+    uint32           first_tick = cap->pdus[0].tick;
+    uint32           last_tick  = cap->pdus[cap->num_pdus - 1].tick + (opt->tail_s * cap->ticks_per_second);
+    uint64           period_ns  = 1000000000 / cap->ticks_per_second;
+    uint64           start_ns;
+    uint64           due_ns;
+    uint32           next_rx = 0;
+    uint32           next_tx = 0;
+    uint32           tick;
+    uint32           i;
+    struct timespec  ts;
+    struct rusage    ru;
+
+    memset(res, 0, sizeof(*res));
+    res->first_mismatch_tick = -1;
+
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) != 0)
+    {
+        return -1;
+    }
+    for (i = 0; i < 2; ++i)
+    {
+        setsockopt(sv[i], SOL_SOCKET, SO_SNDBUF, &buf_bytes, sizeof(buf_bytes));
+        setsockopt(sv[i], SOL_SOCKET, SO_RCVBUF, &buf_bytes, sizeof(buf_bytes));
+    }
+
+    CF_Bench_Name      = "replay";
+    CF_Bench_Stats     = &CF_Replay_Stats;
+    CF_Bench_Root      = opt->dir;
+    CF_Bench_Link.sock = sv[0];
+    CF_Bench_Link.rng  = 1;
+
+    /* never 0, which is the host clock */
+    CF_Bench_VirtualTimeNs = cap->pdus[0].time_ns | 1;
+
+    CF_Replay_SetupTable(cap);
+    if (CF_AppInit() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "cf_replay: CF failed to start\n");
+        return -1;
+    }
+
+    for (i = 0; i < cap->num_pdus; ++i)
+    {
+        res->pdus_tx_captured += (cap->pdus[i].dir == CF_CAPTURE_DIR_TX);
+    }
+
+    CFE_MSG_Init(&wakeup.Buf.Msg, CFE_SB_ValueToMsgId(CF_WAKE_UP_MID), sizeof(wakeup.Cmd));
+
+    start_ns = CF_Bench_NowNs();
+    for (tick = first_tick; tick <= last_tick; ++tick)
+    {
+        CF_Bench_VirtualTimeNs = (cap->pdus[0].time_ns | 1) + ((uint64)(tick - first_tick) * period_ns);
+
+        /* the PDUs of the wakeup cross the link as if sent by the peer */
+        while (next_rx < cap->num_pdus && cap->pdus[next_rx].tick == tick)
+        {
+            if (cap->pdus[next_rx].dir == CF_CAPTURE_DIR_RX)
+            {
+                data[0] = cap->pdus[next_rx].chan;
+                memcpy(&data[1], cap->pdus[next_rx].data, cap->pdus[next_rx].len);
+                send(sv[1], data, 1 + cap->pdus[next_rx].len, 0);
+                ++res->pdus_rx;
+            }
+            ++next_rx;
+        }
+
+        CF_Bench_LinkPoll();
+        CF_AppPipe(&wakeup.Buf);
+        CF_Replay_CheckSent(sv[1], cap, &next_tx, tick, res);
+        ++res->wakeups;
+
+        if (opt->speed > 0)
+        {
+            due_ns     = start_ns + (uint64)(((tick - first_tick + 1) * period_ns) / opt->speed);
+            ts.tv_sec  = due_ns / 1000000000;
+            ts.tv_nsec = due_ns % 1000000000;
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+    }
+
+    res->time_s = (CF_Bench_NowNs() - start_ns) / 1e9;
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+        res->cpu_s = ru.ru_utime.tv_sec + (ru.ru_utime.tv_usec / 1e6) + ru.ru_stime.tv_sec +
+                     (ru.ru_stime.tv_usec / 1e6);
+    }
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the results of the replay as a JSON object.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Replay_WriteResult(FILE *out, const CF_Replay_Options_t *opt, const CF_Replay_Capture_t *cap,
+                                  const CF_Replay_Result_t *res)
+{
+    fprintf(out, "{\n");
+    fprintf(out, "  \"replay\": \"cf\",\n");
+    fprintf(out, "  \"version\": \"%d.%d.%d\",\n", CF_MAJOR_VERSION, CF_MINOR_VERSION, CF_REVISION);
+    fprintf(out, "  \"local_eid\": %llu,\n", (unsigned long long)cap->local_eid);
+    fprintf(out, "  \"ticks_per_second\": %lu,\n", (unsigned long)cap->ticks_per_second);
+    fprintf(out, "  \"speed\": %.3f,\n", opt->speed);
+    fprintf(out, "  \"wakeups\": %lu,\n", (unsigned long)res->wakeups);
+    fprintf(out, "  \"pdus_received\": %llu,\n", (unsigned long long)res->pdus_rx);
+    fprintf(out, "  \"pdus_sent_captured\": %llu,\n", (unsigned long long)res->pdus_tx_captured);
+    fprintf(out, "  \"pdus_sent_replayed\": %llu,\n", (unsigned long long)res->pdus_tx_replayed);
+    fprintf(out, "  \"pdus_sent_matched\": %llu,\n", (unsigned long long)res->pdus_tx_matched);
+    fprintf(out, "  \"first_mismatch_wakeup\": %lld,\n", (long long)res->first_mismatch_tick);
+    fprintf(out, "  \"transactions\": %lu,\n", (unsigned long)CF_Bench_Stats->eot);
+    fprintf(out, "  \"transactions_failed\": %lu,\n", (unsigned long)CF_Bench_Stats->eot_failed);
+    fprintf(out, "  \"error_events\": %lu,\n", (unsigned long)CF_Bench_Stats->events_error);
+    fprintf(out, "  \"time_s\": %.6f,\n", res->time_s);
+    fprintf(out, "  \"cpu_s\": %.6f\n", res->cpu_s);
+    fprintf(out, "}\n");
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints the usage of the command.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Replay_Usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options] CAPTURE\n"
+            "  --speed F               multiple of the original speed, 0 runs as fast as possible (0)\n"
+            "  --tail S                seconds of wakeups run after the last PDU (0)\n"
+            "  --dir PATH              work directory the paths of CF are taken under (/tmp/cf_replay)\n"
+            "  --verbose               print the events of the instance\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option LONG_OPTS[] = {
+        { "speed", required_argument, NULL, 's' },
+        { "tail", required_argument, NULL, 't' },
+        { "dir", required_argument, NULL, 'D' },
+        { "verbose", no_argument, NULL, 'v' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    CF_Replay_Options_t opt;
+    CF_Replay_Capture_t cap;
+    CF_Replay_Result_t  res;
+    int                 c;
+    int                 err = 0;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.dir = "/tmp/cf_replay";
+
+    while ((c = getopt_long(argc, argv, "h", LONG_OPTS, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 's':
+                opt.speed = strtod(optarg, NULL);
+                break;
+            case 't':
+                opt.tail_s = strtoul(optarg, NULL, 0);
+                break;
+            case 'D':
+                opt.dir = optarg;
+                break;
+            case 'v':
+                CF_Bench_Verbose = true;
+                break;
+            default:
+                err = -1;
+                break;
+        }
+    }
+
+    if (err != 0 || optind != argc - 1 || opt.speed < 0)
+    {
+        CF_Replay_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    opt.capture = argv[optind];
+
+    if (mkdir(opt.dir, 0755) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "cf_replay: cannot create %s: %s\n", opt.dir, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    if (CF_Replay_ReadCapture(opt.capture, &cap) != 0 || CF_Replay_Run(&opt, &cap, &res) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    CF_Replay_WriteResult(stdout, &opt, &cap, &res);
+
+    fprintf(stderr,
+            "cf_replay: %lu wakeups, %llu PDUs received, %llu of %llu PDUs sent as captured, %.3f s\n",
+            (unsigned long)res.wakeups,
+            (unsigned long long)res.pdus_rx,
+            (unsigned long long)res.pdus_tx_matched,
+            (unsigned long long)res.pdus_tx_captured,
+            res.time_s);
+
+    return EXIT_SUCCESS;
+}
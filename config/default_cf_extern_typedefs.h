@@ -44,6 +44,70 @@ typedef enum
     CF_CFDP_CLASS_2 = 1, /**< \brief CFDP class 2 - Reliable transfer */
 } CF_CFDP_Class_t;
 
+/**
+ * @brief Selects when a class 2 receiver sends NAKs for missing file data
+ */
+typedef enum
+{
+    CF_NakMode_DEFERRED  = 0, /**< \brief NAK only once the EOF has been received */
+    CF_NakMode_IMMEDIATE = 1, /**< \brief NAK a new gap once the reorder delay passes without it filling in */
+    CF_NakMode_ASYNC     = 2, /**< \brief NAK any open gaps every nak_timer_s while data is still arriving */
+    CF_NakMode_NUM       = 3
+} CF_NakMode_t;
+
+/**
+ * @brief Selects the order in which directory playbacks start the files they read ahead
+ */
+typedef enum
+{
+    CF_PlaybackOrder_DIR      = 0, /**< \brief in the order they are read from the directory */
+    CF_PlaybackOrder_OLDEST   = 1, /**< \brief least recently modified file first */
+    CF_PlaybackOrder_SMALLEST = 2, /**< \brief smallest file first */
+    CF_PlaybackOrder_NUM      = 3
+} CF_PlaybackOrder_t;
+
+/**
+ * @brief Selects the compression applied to a file before it is sent, see cf_compress.h
+ */
+typedef enum
+{
+    CF_Compress_NONE = 0, /**< \brief the file is sent as it is */
+    CF_Compress_LZ4  = 1, /**< \brief LZ4 block compression */
+    CF_Compress_NUM  = 2
+} CF_Compress_t;
+
+/**
+ * @brief Phases of the wakeup of a channel timed in the diagnostics packet, see cf_diag.h
+ */
+typedef enum
+{
+    CF_DiagPhase_RECEIVE  = 0, /**< \brief receipt of the PDUs on the input pipe */
+    CF_DiagPhase_RX_TICK  = 1, /**< \brief ticks of the receive transactions, in memory and spilled */
+    CF_DiagPhase_TX_TICK  = 2, /**< \brief ticks of the send transactions, and start of the pending ones */
+    CF_DiagPhase_NAK      = 3, /**< \brief file data sent again to answer NAKs */
+    CF_DiagPhase_NEW_DATA = 4, /**< \brief new file data sent */
+    CF_DiagPhase_PLAYBACK = 5, /**< \brief playback directories */
+    CF_DiagPhase_POLLING  = 6, /**< \brief polling directories */
+    CF_DiagPhase_NUM      = 7
+} CF_DiagPhase_t;
+
+/**
+ * @brief Counters kept for each peer in the peer statistics packet, see cf_peer.h
+ */
+typedef enum
+{
+    CF_PeerCounter_PDU_SENT      = 0, /**< \brief PDUs sent to the peer */
+    CF_PeerCounter_PDU_RECV      = 1, /**< \brief PDUs received from the peer */
+    CF_PeerCounter_BYTES_SENT    = 2, /**< \brief file data bytes sent, retransmits included */
+    CF_PeerCounter_BYTES_RECV    = 3, /**< \brief file data bytes received, retransmits included */
+    CF_PeerCounter_NAK_SEGS_SENT = 4, /**< \brief segments requested from the peer in NAKs */
+    CF_PeerCounter_NAK_SEGS_RECV = 5, /**< \brief segments the peer requested in NAKs */
+    CF_PeerCounter_INACTIVITY    = 6, /**< \brief transactions that timed out for inactivity */
+    CF_PeerCounter_ACK_LIMIT     = 7, /**< \brief ACK and NAK retry limits reached */
+    CF_PeerCounter_CRC_MISMATCH  = 8, /**< \brief received files that failed their checksum */
+    CF_PeerCounter_NUM           = 9
+} CF_PeerCounter_t;
+
 /**
  * @brief CF queue identifiers
  */
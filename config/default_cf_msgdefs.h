@@ -50,6 +50,9 @@ typedef struct CF_HkSent
     uint64 file_data_bytes;      /**< \brief Sent File data bytes */
     uint32 pdu;                  /**< \brief Sent PDUs counter */
     uint32 nak_segment_requests; /**< \brief Sent NAK segment requests counter */
+    uint32 pdu_rate;             /**< \brief PDUs sent during the last second (ticks_per_second wakeups) */
+    uint16 out_buf_hwm;          /**< \brief Most SB output buffers held by the channel at once */
+    uint16 spare;                /**< \brief Alignment spare to avoid implicit padding */
 } CF_HkSent_t;
 
 /**
@@ -84,7 +87,7 @@ typedef struct CF_HkFault
     uint16 nak_limit;          /**< \brief NAK limit exceeded fault counter */
     uint16 ack_limit;          /**< \brief ACK limit exceeded fault counter */
     uint16 inactivity_timer;   /**< \brief Inactivity timer exceeded counter */
-    uint16 spare;              /**< \brief Alignment spare to avoid implicit padding */
+    uint16 chunk_slab_empty;   /**< \brief Chunk lists that could not grow from the channel slab */
 } CF_HkFault_t;
 
 /**
@@ -110,6 +113,17 @@ typedef struct CF_HkChannel_Data
     uint8           spare;                   /**< \brief Alignment spare (uint64 values in the counters) */
 } CF_HkChannel_Data_t;
 
+/**
+ * \brief Housekeeping round trip time of a peer
+ */
+typedef struct CF_HkPeerRtt
+{
+    CF_EntityId_t eid;       /**< \brief Peer entity ID */
+    uint32        srtt_ms;   /**< \brief Smoothed round trip time in milliseconds */
+    uint32        rttvar_ms; /**< \brief Round trip time variation in milliseconds */
+    uint32        samples;   /**< \brief Number of round trip times measured, 0 if the entry is unused */
+} CF_HkPeerRtt_t;
+
 /**
  * \brief Housekeeping packet
  */
@@ -119,8 +133,80 @@ typedef struct CF_HkPacket_Payload
     uint8              Padding[4];
 
     CF_HkChannel_Data_t channel_hk[CF_NUM_CHANNELS]; /**< \brief Per channel housekeeping data */
+    CF_HkPeerRtt_t      peer_rtt[CF_MAX_RTT_PEERS];  /**< \brief Round trip times of the peers, see CF_Rtt_Update() */
 } CF_HkPacket_Payload_t;
 
+/**
+ * \brief Diagnostics histogram of the time taken by a phase of the wakeup, or by the whole wakeup
+ */
+typedef struct CF_DiagHistogram
+{
+    uint32 count;                         /**< \brief Number of times measured */
+    uint32 min_us;                        /**< \brief Shortest time in microseconds */
+    uint32 avg_us;                        /**< \brief Average time in microseconds */
+    uint32 p99_us;                        /**< \brief 99th percentile in microseconds, top of its bucket */
+    uint32 max_us;                        /**< \brief Longest time in microseconds */
+    uint32 buckets[CF_DIAG_HIST_BUCKETS]; /**< \brief Times of 2^(i-1) to 2^i - 1 microseconds in bucket i */
+} CF_DiagHistogram_t;
+
+/**
+ * \brief Diagnostics channel data
+ */
+typedef struct CF_DiagChannel
+{
+    CF_DiagHistogram_t phase[CF_DiagPhase_NUM]; /**< \brief Time of each phase per wakeup, see CF_DiagPhase_t */
+} CF_DiagChannel_t;
+
+/**
+ * \brief Diagnostics packet
+ */
+typedef struct CF_DiagPacket_Payload
+{
+    uint32             slot_us;                  /**< \brief Wakeup period, one second over ticks_per_second */
+    uint32             overruns;                 /**< \brief Wakeups that took longer than slot_us */
+    uint32             yields;                   /**< \brief Wakeups that left work over for wakeup_budget_us */
+    CF_DiagHistogram_t cycle;                    /**< \brief Time of the whole wakeup */
+    CF_DiagChannel_t   channel[CF_NUM_CHANNELS]; /**< \brief Per channel phase times */
+} CF_DiagPacket_Payload_t;
+
+/**
+ * \brief Statistics of a peer
+ */
+typedef struct CF_PeerStats
+{
+    CF_EntityId_t eid;                          /**< \brief Peer entity ID */
+    uint32        srtt_ms;                      /**< \brief Smoothed round trip time, 0 if not measured */
+    uint32        counters[CF_PeerCounter_NUM]; /**< \brief Counters of the peer, see CF_PeerCounter_t */
+} CF_PeerStats_t;
+
+/**
+ * \brief Peer statistics packet
+ */
+typedef struct CF_PeerPacket_Payload
+{
+    uint32         num_peers;               /**< \brief Entries of peer in use */
+    uint32         evictions;               /**< \brief Entries given to a new peer in place of the least recent one */
+    CF_PeerStats_t peer[CF_MAX_PEER_STATS]; /**< \brief Statistics of each peer */
+} CF_PeerPacket_Payload_t;
+
+/**
+ * \brief Per transaction throughput and latency metrics
+ *
+ * Times are milliseconds after start_secs/start_subsecs, 0 if the transaction never got there
+ */
+typedef struct CF_TxnMetrics
+{
+    uint32 start_secs;    /**< \brief Seconds part of the CFE time the transaction started */
+    uint32 start_subsecs; /**< \brief Subseconds part of the CFE time the transaction started */
+    uint32 first_pdu_ms;  /**< \brief Time the metadata was sent or the first PDU was received */
+    uint32 eof_ms;        /**< \brief Time the EOF was first sent or received */
+    uint32 end_ms;        /**< \brief Time the transaction finished */
+    uint32 fd_bytes;      /**< \brief File data bytes sent or received, retransmits included */
+    uint32 nak_rounds;    /**< \brief NAK PDUs sent or received */
+    uint32 nak_segments;  /**< \brief Segments requested over all NAK rounds */
+    uint32 peak_chunks;   /**< \brief Most chunks held in the chunk list at one time */
+} CF_TxnMetrics_t;
+
 /**
  * \brief End of transaction packet
  */
@@ -136,6 +222,7 @@ typedef struct CF_EotPacket_Payload
     uint32              fsize;      /**< \brief File size */
     uint32              crc_result; /**< \brief CRC result */
     CF_TxnFilenames_t   fnames;     /**< \brief file names associated with this transaction */
+    CF_TxnMetrics_t     metrics;    /**< \brief throughput and latency of this transaction */
 } CF_EotPacket_Payload_t;
 
 /**\}*/
@@ -164,7 +251,9 @@ typedef enum
     CF_Reset_command = 1, /**< \brief Reset command */
     CF_Reset_fault   = 2, /**< \brief Reset fault */
     CF_Reset_up      = 3, /**< \brief Reset up */
-    CF_Reset_down    = 4  /**< \brief Reset down */
+    CF_Reset_down    = 4, /**< \brief Reset down */
+    CF_Reset_diag    = 5, /**< \brief Reset diagnostics histograms */
+    CF_Reset_peer    = 6  /**< \brief Reset peer statistics */
 } CF_Reset_t;
 
 /**
@@ -188,6 +277,15 @@ typedef enum
     CF_Queue_all     = 3  /**< \brief Queue all */
 } CF_Queue_t;
 
+/**
+ * \brief File formats for use for Write Queue cmd
+ */
+typedef enum
+{
+    CF_Format_text   = 0, /**< \brief Text lines, written at once */
+    CF_Format_binary = 1  /**< \brief Fixed size records, written over several wakeups */
+} CF_Format_t;
+
 /**
  * \brief Parameter IDs for use with Get/Set parameter messages
  *
@@ -247,6 +345,7 @@ typedef struct CF_TxFile_Payload
     CF_EntityId_t dest_id;                           /**< \brief Destination entity id */
     char          src_filename[CF_FILENAME_MAX_LEN]; /**< \brief Source file/directory name */
     char          dst_filename[CF_FILENAME_MAX_LEN]; /**< \brief Destination file/directory name */
+    uint8         compress;                          /**< \brief Compression of the files sent, see CF_Compress_t */
 } CF_TxFile_Payload_t;
 
 /**
@@ -256,10 +355,10 @@ typedef struct CF_TxFile_Payload
  */
 typedef struct CF_WriteQueue_Payload
 {
-    uint8 type;  /**< \brief Transaction direction: all=0, up=1, down=2 */
-    uint8 chan;  /**< \brief Channel number */
-    uint8 queue; /**< \brief Queue type: 0=pending, 1=active, 2=history, 3=all */
-    uint8 spare; /**< \brief Alignment spare, puts filename on 32-bit boundary */
+    uint8 type;   /**< \brief Transaction direction: all=0, up=1, down=2 */
+    uint8 chan;   /**< \brief Channel number */
+    uint8 queue;  /**< \brief Queue type: 0=pending, 1=active, 2=history, 3=all */
+    uint8 format; /**< \brief File format: text=0, binary=1 */
 
     char filename[CF_FILENAME_MAX_LEN]; /**< \brief Filename written to */
 } CF_WriteQueue_Payload_t;
@@ -51,6 +51,12 @@
 /** \brief Message ID for housekeeping telemetry */
 #define CF_HK_TLM_MID CFE_PLATFORM_CF_TLM_MIDVAL(HK_TLM)
 
+/** \brief Message ID for wakeup timing diagnostics telemetry */
+#define CF_DIAG_TLM_MID CFE_PLATFORM_CF_TLM_MIDVAL(DIAG_TLM)
+
+/** \brief Message ID for peer statistics telemetry */
+#define CF_PEER_TLM_MID CFE_PLATFORM_CF_TLM_MIDVAL(PEER_TLM)
+
 /** \brief Message ID for end of transaction telemetry */
 #define CF_EOT_TLM_MID CFE_PLATFORM_CF_TLM_MIDVAL(EOT_TLM)
 
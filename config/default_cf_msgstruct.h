@@ -50,6 +50,24 @@ typedef struct CF_HkPacket
     CF_HkPacket_Payload_t     Payload;
 } CF_HkPacket_t;
 
+/**
+ * \brief Diagnostics packet
+ */
+typedef struct CF_DiagPacket
+{
+    CFE_MSG_TelemetryHeader_t TelemetryHeader; /**< \brief Telemetry header */
+    CF_DiagPacket_Payload_t   Payload;
+} CF_DiagPacket_t;
+
+/**
+ * \brief Peer statistics packet
+ */
+typedef struct CF_PeerPacket
+{
+    CFE_MSG_TelemetryHeader_t TelemetryHeader; /**< \brief Telemetry header */
+    CF_PeerPacket_Payload_t   Payload;
+} CF_PeerPacket_t;
+
 /**
  * \brief End of transaction packet
  */
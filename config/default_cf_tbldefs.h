@@ -49,8 +49,27 @@ typedef struct CF_PollDir
     char dst_dir[CF_FILENAME_MAX_PATH]; /**< \brief path to destination dir */
 
     uint8 enabled; /**< \brief Enabled flag */
+
+    uint32 bundle_file_max;  /**< \brief send files up to this size in multi-file bundles (0 - no bundles) */
+    uint32 bundle_max_bytes; /**< \brief send a bundle once it holds this many bytes of file data (0 - no limit) */
+    uint16 bundle_max_files; /**< \brief send a bundle once it holds this many files (0 - no limit) */
+    uint32 bundle_max_age_s; /**< \brief send a partial bundle once its oldest file is this many seconds old */
+
+    uint8 compress; /**< \brief compression of the files sent, see CF_Compress_t */
 } CF_PollDir_t;
 
+/**
+ * \brief Configuration entry for the playback priority map
+ *
+ * A file read by a directory playback whose name matches the pattern is sent
+ * with this priority instead of the priority of the playback.
+ */
+typedef struct CF_PlaybackPrio
+{
+    char  pattern[CF_FILENAME_MAX_NAME]; /**< \brief file name pattern, '*' and '?' are wildcards (empty - unused) */
+    uint8 priority;                      /**< \brief priority to use for matching files */
+} CF_PlaybackPrio_t;
+
 /**
  * \brief Configuration entry for CFDP channel
  */
@@ -76,6 +95,34 @@ typedef struct CF_ChannelConfig
     char  sem_name[OS_MAX_API_NAME]; /**< \brief name of throttling semaphore in TO */
     uint8 dequeue_enabled;           /**< \brief if 1, then the channel will make pending transactions active */
     char  move_dir[OS_MAX_PATH_LEN]; /**< \brief Move directory if not empty */
+
+    uint32 num_transactions;          /**< \brief number of transaction objects allocated to this channel */
+    uint32 num_histories;             /**< \brief number of history entries allocated to this channel */
+    uint32 rx_chunks_per_transaction; /**< \brief max number of chunks each rx transaction may use for gap tracking */
+    uint32 tx_chunks_per_transaction; /**< \brief max number of chunks each tx transaction may use for NAK requests */
+
+    /**
+     * \brief number of chunk blocks in the slab shared by this channel
+     *
+     * One block is reserved for each transaction, so that each can always record
+     * the data it receives, and this must be at least num_transactions.  The other
+     * blocks let that many more blocks of chunks be held by the transactions that
+     * need more than one at the same time.
+     */
+    uint32 num_chunk_blocks;
+
+    uint32 nak_reorder_ticks; /**< \brief ticks a new gap may stay open before it is NAKed (immediate mode) */
+    uint8  nak_mode;          /**< \brief class 2 receive NAK mode, see CF_NakMode_t */
+
+    uint32 prompt_keep_alive_bytes; /**< \brief class 2 send Prompt(Keep Alive) every this many bytes (0 - never) */
+    uint32 prompt_nak_bytes;        /**< \brief class 2 send Prompt(NAK) every this many bytes (0 - never) */
+
+    uint8 playback_order; /**< \brief order of the files started by directory playbacks, see CF_PlaybackOrder_t */
+
+    uint32 delta_block_size; /**< \brief class 2 send only the changed blocks of this size of re-sent files (0 - off) */
+
+    uint32 rtt_timer_min_s; /**< \brief shortest ACK/NAK timer set from the measured round trip time */
+    uint32 rtt_timer_max_s; /**< \brief longest ACK/NAK timer set from the measured round trip time (0 - off) */
 } CF_ChannelConfig_t;
 
 /*
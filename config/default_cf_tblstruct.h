@@ -52,6 +52,44 @@ typedef struct CF_ConfigTable
                                             *   Limited by CF_MAX_PDU_SIZE minus the PDU header(s) */
     char   tmp_dir[CF_FILENAME_MAX_PATH];  /**< \brief directory to put temp files */
     char   fail_dir[CF_FILENAME_MAX_PATH]; /**< \brief fail directory */
+
+    uint32 checkpoint_interval_s;             /**< \brief seconds between transaction journal checkpoints,
+                                               *   0 disables checkpointing and resume.  A checkpoint
+                                               *   is skipped if nothing in it changed since the last */
+    char   journal_file[CF_FILENAME_MAX_LEN]; /**< \brief transaction checkpoint journal file */
+
+    uint32 spill_idle_s; /**< \brief seconds without traffic before a class 2 receive transaction is
+                          *   spilled to disk, 0 disables spilling.  Set it well above the ACK and
+                          *   NAK timers, or transactions between two NAKs get spilled and reloaded */
+    uint32 spill_max_s;  /**< \brief seconds a transaction may stay spilled before it is abandoned.
+                          *   This replaces the inactivity timeout of the channel while spilled */
+
+    uint32 poll_settle_s;                        /**< \brief seconds a polled file must go unmodified before it
+                                                  *   is sent, 0 sends files as soon as they are found.  Only
+                                                  *   needed if producers write in the polling directories */
+    char   poll_index_file[CF_FILENAME_MAX_LEN]; /**< \brief polling directory snapshot index file, empty string
+                                                  *   keeps the snapshots in memory only */
+
+    CF_PlaybackPrio_t playback_prio[CF_MAX_PLAYBACK_PRIO_RULES]; /**< \brief file name to priority map for directory
+                                                                  *   playbacks, the first matching pattern applies */
+
+    uint32 wakeup_budget_us; /**< \brief microseconds of work per wakeup, the rest carries over to the next
+                              *   wakeup, 0 disables the budget.  About half of the wakeup period is
+                              *   intended, e.g. 50000 at 10 ticks per second */
+
+    char stats_shm_name[OS_MAX_API_NAME]; /**< \brief name of the statistics shared memory, read at startup,
+                                           *   empty string does not publish the statistics */
+
+    uint32 event_burst;     /**< \brief events of the same ID sent at once before they are rate limited,
+                             *   0 disables the rate limits */
+    uint32 event_rate;      /**< \brief events of the same ID sent per second once rate limited */
+    uint32 event_summary_s; /**< \brief seconds between the reports of the events suppressed, 0 disables
+                             *   the reports */
+
+    char   capture_file[CF_FILENAME_MAX_LEN]; /**< \brief file the PDUs received and sent are captured to, read at
+                                               *   startup, empty string does not capture them */
+    uint32 capture_max_kb;                    /**< \brief size of the capture file in KiB, the oldest PDUs are
+                                               *   overwritten beyond it, 0 for the largest size */
 } CF_ConfigTable_t;
 
 #endif
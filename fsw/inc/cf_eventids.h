@@ -223,6 +223,103 @@
  */
 #define CF_CR_PIPE_ERR_EID 36
 
+/**
+ * \brief CF Channel Pool Sizes Config Table Validation Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table channel has fewer histories than transactions, more
+ *  transactions or histories than a queue can count, or a zero chunk cap
+ */
+#define CF_INIT_POOL_SIZE_ERR_EID 37
+
+/**
+ * \brief CF Engine Arena Too Small Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  The pools described by the configuration table do not fit in the engine
+ *  arena, either during table validation or during engine initialization
+ */
+#define CF_INIT_ARENA_SIZE_ERR_EID 38
+
+/**
+ * \brief CF Channel NAK Mode Config Table Validation Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table channel has a NAK mode that is not a CF_NakMode_t value
+ */
+#define CF_INIT_NAK_MODE_ERR_EID 39
+
+/**
+ * \brief CF Playback Config Table Validation Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table channel has a playback order that is not a CF_PlaybackOrder_t value,
+ *  a polling directory has a compression that is not a CF_Compress_t value,
+ *  or a playback priority pattern is not terminated
+ */
+#define CF_INIT_PLAYBACK_ERR_EID 176
+
+/**
+ * \brief CF Delta Block Size Config Table Validation Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table channel has a delta block size larger than CF_DELTA_MAX_BLOCK_SIZE
+ */
+#define CF_INIT_DELTA_ERR_EID 182
+
+/**
+ * \brief CF Round Trip Timer Bounds Config Table Validation Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table channel has adaptive ACK/NAK timers enabled with a
+ *  shortest timer longer than its longest timer
+ */
+#define CF_INIT_RTT_ERR_EID 186
+
+/**
+ * \brief CF Statistics Shared Memory Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table statistics shared memory name is not terminated, or
+ *  the shared memory could not be set up at startup, in which case the
+ *  statistics are not published
+ */
+#define CF_INIT_SHM_ERR_EID 187
+
+/**
+ * \brief CF PDU Capture File Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Configuration table PDU capture file name is not terminated, or the
+ *  capture file could not be created at startup, in which case the PDUs are
+ *  not captured
+ */
+#define CF_INIT_CAPTURE_ERR_EID 191
+
 /**************************************************************************
  * CF_PDU event IDs - Protocol data unit
  */
@@ -337,6 +434,28 @@
  */
 #define CF_PDU_NAK_SHORT_ERR_EID 50
 
+/**
+ * \brief CF Prompt PDU Too Short Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure processing prompt PDU
+ */
+#define CF_PDU_PROMPT_SHORT_ERR_EID 51
+
+/**
+ * \brief CF Keep Alive PDU Too Short Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure processing keep alive PDU
+ */
+#define CF_PDU_KEEP_ALIVE_SHORT_ERR_EID 52
+
 /**
  * \brief CF File Data PDU Unsupported Option Event ID
  *
@@ -503,6 +622,19 @@
  */
 #define CF_CFDP_NO_CHUNKLIST_AVAIL_EID 69
 
+/**
+ * \brief CF Chunk Slab Exhausted Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A chunk list of a transaction on the channel could not take another
+ *  block from the channel slab during a wakeup, so gaps were merged or
+ *  dropped.  The fault.chunk_slab_empty counter holds the number of times.
+ */
+#define CF_CFDP_CHUNK_SLAB_ERR_EID 193
+
 /**************************************************************************
  * CF_CFDP_R event IDs - Engine receive
  */
@@ -1577,6 +1709,295 @@
  */
 #define CF_EID_INF_CFDP_BUF_EXCEED 166
 
+/**************************************************************************
+ * CF_JOURNAL event IDs - Transaction checkpoint journal
+ */
+
+/**
+ * \brief CF Checkpoint Journal Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure creating, writing or renaming the transaction checkpoint journal.  The
+ *  previous journal (if any) is left in place.
+ */
+#define CF_JOURNAL_WRITE_ERR_EID 167
+
+/**
+ * \brief CF Checkpoint Journal Invalid Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  The transaction checkpoint journal found at engine initialization is truncated,
+ *  fails its checksum, or does not match the configuration table.  No transactions
+ *  are resumed from it.
+ */
+#define CF_JOURNAL_READ_ERR_EID 168
+
+/**
+ * \brief CF Checkpoint Journal Transaction Resume Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A transaction in the checkpoint journal or a spill file could not be resumed,
+ *  because no transaction or chunk list was available or its temp file could not
+ *  be opened
+ */
+#define CF_JOURNAL_RESUME_ERR_EID 169
+
+/**
+ * \brief CF Checkpoint Journal Restored Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  Transactions were resumed from the checkpoint journal at engine initialization
+ */
+#define CF_JOURNAL_RESTORE_INF_EID 170
+
+/**************************************************************************
+ * CF_SPILL event IDs - Transactions spilled to disk
+ */
+
+/**
+ * \brief CF Spill File Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure creating or writing the spill file of an idle or suspended transaction.
+ *  The transaction stays in memory.
+ */
+#define CF_SPILL_WRITE_ERR_EID 171
+
+/**
+ * \brief CF Spill File Reload Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  The spill file of a transaction could not be opened or does not match the
+ *  transaction, or no transaction was available to reload it into.
+ */
+#define CF_SPILL_RELOAD_ERR_EID 172
+
+/**
+ * \brief CF Spilled Transaction Expired Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A transaction stayed spilled to disk for longer than the spill_max_s of the
+ *  configuration table without any PDU or command for it, and was abandoned.
+ */
+#define CF_SPILL_EXPIRED_ERR_EID 173
+
+/**************************************************************************
+ * CF_POLLIDX event IDs - Polling directory snapshot index
+ */
+
+/**
+ * \brief CF Poll Index Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure creating, writing or renaming the polling directory snapshot index.  The
+ *  previous index (if any) is left in place.
+ */
+#define CF_POLLIDX_WRITE_ERR_EID 174
+
+/**
+ * \brief CF Poll Index Invalid Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  The polling directory snapshot index found at engine initialization is truncated
+ *  or was written by a different version of CF.  All polling directories are scanned.
+ */
+#define CF_POLLIDX_READ_ERR_EID 175
+
+/**************************************************************************
+ * CF_BUNDLE event IDs - Multi-file bundles
+ */
+
+/**
+ * \brief CF Bundle Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure creating or writing a bundle of a polling directory.  The bundle is discarded
+ *  and its files are left for the next poll.
+ */
+#define CF_BUNDLE_WRITE_ERR_EID 177
+
+/**
+ * \brief CF Bundle Invalid Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A bundle could not be read back, is truncated, or was written by a different version
+ *  of CF.  On the receiver nothing is stored, on the sender the files of the bundle are
+ *  left in place.
+ */
+#define CF_BUNDLE_READ_ERR_EID 178
+
+/**
+ * \brief CF Bundle Unpack Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure storing a file of a received bundle under its own name.
+ */
+#define CF_BUNDLE_UNPACK_ERR_EID 179
+
+/**************************************************************************
+ * CF_COMPRESS event IDs - File compression
+ */
+
+/**
+ * \brief CF Compress Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure reading a file to send or writing its compressed copy in the temp directory.
+ *  The transaction fails with a filestore rejection.
+ */
+#define CF_COMPRESS_ERR_EID 180
+
+/**
+ * \brief CF Decompress Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A received compressed file is not valid, or its decompressed copy could not be
+ *  written.  The file is not stored.
+ */
+#define CF_DECOMPRESS_ERR_EID 181
+
+/**************************************************************************
+ * CF_DELTA event IDs - Delta transfer
+ */
+
+/**
+ * \brief CF Delta Transfer Started Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  A class 2 send found the signatures of a previous send of the same destination
+ *  file, and only sends the blocks that changed since.
+ */
+#define CF_DELTA_SEND_INF_EID 183
+
+/**
+ * \brief CF Delta Transfer Copy Mismatch Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  The checksum of a received delta transfer did not match, the local copy of the
+ *  destination file differed from the file the sender had.  The whole file is NAKed.
+ */
+#define CF_DELTA_RETRY_INF_EID 184
+
+/**
+ * \brief CF Delta Transfer File Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure writing the signature file of a file being sent, or copying the
+ *  destination file of a received delta transfer.  The transfer carries on
+ *  without it.
+ */
+#define CF_DELTA_ERR_EID 185
+
+/**************************************************************************
+ * CF_DUMP event IDs - Binary queue dump
+ */
+
+/**
+ * \brief CF Write Queue Command Dump Busy Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Write queue command with the binary format received while the previous
+ *  binary dump is still being written
+ */
+#define CF_DUMP_BUSY_ERR_EID 188
+
+/**
+ * \brief CF Write Queue Command Dump Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure writing a binary dump of the queues, which is abandoned
+ */
+#define CF_DUMP_WRITE_ERR_EID 189
+
+/**************************************************************************
+ * CF_EVLIM event IDs - Event rate limits
+ */
+
+/**
+ * \brief CF Events Suppressed Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  Events of one ID were suppressed by the rate limits of the configuration
+ *  table since the previous report.  Sent every event_summary_s seconds for
+ *  each event ID that had events suppressed.
+ */
+#define CF_EVLIM_SUPPRESSED_INF_EID 190
+
+/**************************************************************************
+ * CF_CAPTURE event IDs - PDU capture
+ */
+
+/**
+ * \brief CF PDU Capture Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure writing a block of the PDU capture file, which ends the capture
+ */
+#define CF_CAPTURE_WRITE_ERR_EID 192
+
 /**\}*/
 
 #endif /* !CF_EVENTIDS_H */
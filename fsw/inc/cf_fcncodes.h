@@ -80,6 +80,8 @@
  *       - 2 = fault counters
  *       - 3 = up counters
  *       - 4 = down counters
+ *       - 5 = wakeup time histograms of the diagnostics packet
+ *       - 6 = peer statistics packet
  *
  *  \par Command Verification
  *       Successful execution of this command may be verified with
@@ -439,7 +441,9 @@
  * \brief Write queue
  *
  *  \par Description
- *       Writes requested queue(s) to a file
+ *       Writes requested queue(s) to a file.  The text format is written at once.
+ *       The binary format, fixed size records described in cf_dump.h, is written
+ *       over the following wakeups, and the command completes when the file does.
  *
  *  \par Command Structure
  *       #CF_WriteQueueCmd_t
@@ -460,6 +464,8 @@
  *       - Write RX history data failed, #CF_CMD_WQ_WRITEHIST_RX_ERR_EID
  *       - Write TX data failed, #CF_CMD_WQ_WRITEQ_TX_ERR_EID
  *       - Write TX history data failed, #CF_CMD_WQ_WRITEHIST_TX_ERR_EID
+ *       - Binary dump still being written, #CF_DUMP_BUSY_ERR_EID
+ *       - Write binary dump failed, #CF_DUMP_WRITE_ERR_EID
  *
  *  \par Evidence of failure may be found in the following telemetry:
  *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.err will increment
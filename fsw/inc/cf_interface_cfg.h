@@ -77,6 +77,62 @@
 #define CF_MAX_POLLING_DIR_PER_CHAN         CF_INTERFACE_CFGVAL(MAX_POLLING_DIR_PER_CHAN)
 #define DEFAULT_CF_MAX_POLLING_DIR_PER_CHAN 5
 
+/**
+ *  @brief Max number of file name patterns in the playback priority map.
+ *
+ *  @par Description:
+ *       This affects the configuration table. There must be an entry (can
+ *       be empty) for each of these patterns.
+ *
+ *  @par Limits:
+ *
+ */
+#define CF_MAX_PLAYBACK_PRIO_RULES         CF_INTERFACE_CFGVAL(MAX_PLAYBACK_PRIO_RULES)
+#define DEFAULT_CF_MAX_PLAYBACK_PRIO_RULES 4
+
+/**
+ *  @brief Max number of peers whose round trip time is measured.
+ *
+ *  @par Description:
+ *       This affects the housekeeping packet, which reports the round trip
+ *       time of each of these peers.  Peers beyond this number use the
+ *       static ACK and NAK timers of the channel.
+ *
+ *  @par Limits:
+ *
+ */
+#define CF_MAX_RTT_PEERS         CF_INTERFACE_CFGVAL(MAX_RTT_PEERS)
+#define DEFAULT_CF_MAX_RTT_PEERS 8
+
+/**
+ *  @brief Number of buckets of the wakeup time histograms
+ *
+ *  @par Description:
+ *       Bucket i of a histogram of the diagnostics packet counts the
+ *       times of 2^(i-1) to 2^i - 1 microseconds, and the last bucket
+ *       also counts all longer times.  The default reaches 2^18
+ *       microseconds, about a quarter of a second.
+ *
+ *  @par Limits:
+ *       Must be at least 2, and at most 32.
+ */
+#define CF_DIAG_HIST_BUCKETS         CF_INTERFACE_CFGVAL(DIAG_HIST_BUCKETS)
+#define DEFAULT_CF_DIAG_HIST_BUCKETS 20
+
+/**
+ *  @brief Max number of peers in the peer statistics packet
+ *
+ *  @par Description:
+ *       Each peer that PDUs are sent to or received from takes an entry of
+ *       the peer statistics packet.  Once all are taken, the entry of the
+ *       peer least recently seen is given to the new one.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_MAX_PEER_STATS         CF_INTERFACE_CFGVAL(MAX_PEER_STATS)
+#define DEFAULT_CF_MAX_PEER_STATS 16
+
 /**
  *  @brief Max PDU size.
  *
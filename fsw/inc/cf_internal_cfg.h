@@ -74,6 +74,20 @@
 #define CF_MAX_SIMULTANEOUS_RX         CF_INTERNAL_CFGVAL(MAX_SIMULTANEOUS_RX)
 #define DEFAULT_CF_MAX_SIMULTANEOUS_RX 5
 
+/**
+ *  @brief Max number of transactions spilled to disk per channel.
+ *
+ *  @par Description:
+ *       Idle and suspended class 2 receive transactions may be moved out of memory
+ *       into a spill file, to free their transaction and history slots.  Each channel
+ *       keeps an index of this many spilled transactions.
+ *
+ *  @par Limits:
+ *       Each entry costs a few bytes of memory and one file in the temp directory.
+ */
+#define CF_MAX_SPILLED_PER_CHAN         CF_INTERNAL_CFGVAL(MAX_SPILLED_PER_CHAN)
+#define DEFAULT_CF_MAX_SPILLED_PER_CHAN 32
+
 /* definitions that affect execution */
 
 /**
@@ -92,10 +106,11 @@
  *  @brief Number of histories per channel
  *
  *  @par Description:
- *       Each channel can support this number of file receive transactions at a time.
+ *       Default number of history entries for each channel in the config table.
+ *       The actual count is the num_histories value of each channel's configuration.
  *
  *  @par Limits:
- *       65536 is the current max.
+ *       65535 is the current max.
  */
 #define CF_NUM_HISTORIES_PER_CHANNEL         CF_INTERNAL_CFGVAL(NUM_HISTORIES_PER_CHANNEL)
 #define DEFAULT_CF_NUM_HISTORIES_PER_CHANNEL 256
@@ -113,6 +128,69 @@
 #define CF_NUM_TRANSACTIONS_PER_PLAYBACK         CF_INTERNAL_CFGVAL(NUM_TRANSACTIONS_PER_PLAYBACK)
 #define DEFAULT_CF_NUM_TRANSACTIONS_PER_PLAYBACK 5
 
+/**
+ *  @brief Number of directory entries each playback reads ahead.
+ *
+ *  @par Description:
+ *       Each playback/polling directory operation reads this many directory
+ *       entries ahead of the transactions it starts, and starts them in the
+ *       order selected by the playback_order of the channel.  A value of 1
+ *       starts files in the order they are read from the directory.
+ *
+ *  @par Limits:
+ *       Must be between 1 and 255.  Each entry holds a file name.
+ */
+#define CF_PLAYBACK_WINDOW_SIZE         CF_INTERNAL_CFGVAL(PLAYBACK_WINDOW_SIZE)
+#define DEFAULT_CF_PLAYBACK_WINDOW_SIZE 8
+
+/**
+ *  @brief Size of the engine memory arena in bytes
+ *
+ *  @par Description:
+ *       The transaction, history and chunk pools of every channel are carved from
+ *       a single arena of this size when the engine is initialized. How it is
+ *       divided between the channels is set by the num_transactions, num_histories,
+ *       rx_chunks_per_transaction, tx_chunks_per_transaction and num_chunk_blocks
+ *       values of each channel's configuration, so capacities can change with a
+ *       table load.
+ *
+ *  @par Limits:
+ *       Must be large enough for the pools described by the config table, otherwise
+ *       the table fails validation.  The default fits the default config table.
+ */
+#define CF_ENGINE_ARENA_SIZE         CF_INTERNAL_CFGVAL(ENGINE_ARENA_SIZE)
+#define DEFAULT_CF_ENGINE_ARENA_SIZE (256 * 1024)
+
+/**
+ *  @brief Number of chunks in each chunk slab block
+ *
+ *  @par Description:
+ *       Transaction chunk lists draw their storage from a per-channel slab
+ *       in blocks of this many chunks, up to the per-transaction cap from the
+ *       config table.  Smaller blocks waste less memory on lightly used lists,
+ *       larger blocks need fewer block pointers per transaction.
+ *
+ *  @par Limits:
+ *       Must be greater than 0.
+ */
+#define CF_CHUNK_BLOCK_SIZE         CF_INTERNAL_CFGVAL(CHUNK_BLOCK_SIZE)
+#define DEFAULT_CF_CHUNK_BLOCK_SIZE 16
+
+/**
+ *  @brief Depth of the per-channel output buffer ring
+ *
+ *  @par Description:
+ *       Outgoing PDUs are built in SB buffers held by a per-channel ring and
+ *       transmitted together at the end of each wakeup, with a single timestamp
+ *       per batch.  If the ring fills during a wakeup it is flushed early.
+ *       Buffers that were obtained but not used are kept for the next wakeup.
+ *
+ *  @par Limits:
+ *       Must be greater than 0 and no more than 65535.
+ */
+#define CF_OUTPUT_RING_SIZE         CF_INTERNAL_CFGVAL(OUTPUT_RING_SIZE)
+#define DEFAULT_CF_OUTPUT_RING_SIZE 16
+
 /**
  *  @brief Name of the CF Configuration Table
  *
@@ -154,6 +232,51 @@
 #define CF_R2_CRC_CHUNK_SIZE         CF_INTERNAL_CFGVAL(R2_CRC_CHUNK_SIZE)
 #define DEFAULT_CF_R2_CRC_CHUNK_SIZE 1024
 
+/**
+ *  @brief Number of compression blocks per transaction per wakeup
+ *
+ *  @par Description
+ *       Files are compressed before they are sent, and decompressed once they
+ *       are received, in blocks of CF_COMPRESS_BLOCK_SIZE bytes.  This is the
+ *       most blocks one transaction handles in a wakeup, fewer once the
+ *       wakeup budget is spent.
+ *
+ *  @par Limits:
+ *       Must be greater than 0.
+ */
+#define CF_COMPRESS_BLOCKS_PER_WAKEUP         CF_INTERNAL_CFGVAL(COMPRESS_BLOCKS_PER_WAKEUP)
+#define DEFAULT_CF_COMPRESS_BLOCKS_PER_WAKEUP 16
+
+/**
+ *  @brief Number of delta transfer blocks per transaction per wakeup
+ *
+ *  @par Description
+ *       A re-sent file is hashed before its MD is sent, and a receiver copies
+ *       its existing file into the temp file before it looks for gaps, in
+ *       blocks of up to CF_DELTA_MAX_BLOCK_SIZE bytes.  This is the most
+ *       blocks one transaction handles in a wakeup, fewer once the wakeup
+ *       budget is spent.
+ *
+ *  @par Limits:
+ *       Must be greater than 0.
+ */
+#define CF_DELTA_BLOCKS_PER_WAKEUP         CF_INTERNAL_CFGVAL(DELTA_BLOCKS_PER_WAKEUP)
+#define DEFAULT_CF_DELTA_BLOCKS_PER_WAKEUP 16
+
+/**
+ *  @brief Number of checkpoint journal records per wakeup
+ *
+ *  @par Description
+ *       A checkpoint of the receive transactions is written to the journal
+ *       file over several wakeups.  This is the most records (transactions)
+ *       written in a wakeup, fewer once the wakeup budget is spent.
+ *
+ *  @par Limits:
+ *       Must be greater than 0.
+ */
+#define CF_JOURNAL_RECORDS_PER_WAKEUP         CF_INTERNAL_CFGVAL(JOURNAL_RECORDS_PER_WAKEUP)
+#define DEFAULT_CF_JOURNAL_RECORDS_PER_WAKEUP 8
+
 /**
  *  @brief Number of milliseconds to wait for a SB message
  */
@@ -43,6 +43,12 @@
 #define CFE_MISSION_CF_HK_TLM_TOPICID         CFE_MISSION_CF_TIDVAL(HK_TLM)
 #define DEFAULT_CFE_MISSION_CF_HK_TLM_TOPICID 0xB0 /**< \brief Message ID for housekeeping telemetry */
 
+#define CFE_MISSION_CF_DIAG_TLM_TOPICID         CFE_MISSION_CF_TIDVAL(DIAG_TLM)
+#define DEFAULT_CFE_MISSION_CF_DIAG_TLM_TOPICID 0xB1 /**< \brief Message ID for wakeup timing diagnostics telemetry */
+
+#define CFE_MISSION_CF_PEER_TLM_TOPICID         CFE_MISSION_CF_TIDVAL(PEER_TLM)
+#define DEFAULT_CFE_MISSION_CF_PEER_TLM_TOPICID 0xB2 /**< \brief Message ID for peer statistics telemetry */
+
 #define CFE_MISSION_CF_EOT_TLM_TOPICID         CFE_MISSION_CF_TIDVAL(EOT_TLM)
 #define DEFAULT_CFE_MISSION_CF_EOT_TLM_TOPICID 0xB3 /**< \brief Message ID for end of transaction telemetry */
 
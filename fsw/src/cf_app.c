@@ -34,6 +34,7 @@
 #include "cf_version.h"
 #include "cf_dispatch.h"
 #include "cf_tbl.h"
+#include "cf_delta.h"
 
 #include <string.h>
 
@@ -106,8 +107,12 @@ void CF_CheckTables(void)
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_ValidateConfigTable(void *tbl_ptr)
 {
-    CF_ConfigTable_t *tbl = (CF_ConfigTable_t *)tbl_ptr;
-    CFE_Status_t      ret = CFE_STATUS_VALIDATION_FAILURE;
+    CF_ConfigTable_t   *tbl = (CF_ConfigTable_t *)tbl_ptr;
+    CF_ChannelConfig_t *cc;
+    CFE_Status_t        ret = CFE_STATUS_VALIDATION_FAILURE;
+    uint64              arena_size;
+    int                 i;
+    int                 j;
 
     if (!tbl->ticks_per_second)
     {
@@ -127,7 +132,157 @@ CFE_Status_t CF_ValidateConfigTable(void *tbl_ptr)
     }
     else
     {
-        ret = CFE_SUCCESS;
+        ret        = CFE_SUCCESS;
+        arena_size = 0;
+
+        for (i = 0; i < CF_NUM_CHANNELS; ++i)
+        {
+            cc = &tbl->chan[i];
+
+            /* every transaction holds a history, and queue sizes are counted in 16 bits */
+            if (cc->num_histories < cc->num_transactions || cc->num_histories > 65535)
+            {
+                CFE_EVS_SendEvent(CF_INIT_POOL_SIZE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has invalid pool sizes: %lu transactions, %lu histories",
+                                  i,
+                                  (unsigned long)cc->num_transactions,
+                                  (unsigned long)cc->num_histories);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            /* every transaction needs room for at least one chunk in each direction */
+            if (cc->num_transactions > 0 && (cc->rx_chunks_per_transaction == 0 || cc->tx_chunks_per_transaction == 0))
+            {
+                CFE_EVS_SendEvent(CF_INIT_POOL_SIZE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has invalid chunk caps: rx %lu, tx %lu",
+                                  i,
+                                  (unsigned long)cc->rx_chunks_per_transaction,
+                                  (unsigned long)cc->tx_chunks_per_transaction);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            /* one block of the chunk slab is reserved for each transaction */
+            if (cc->num_chunk_blocks < cc->num_transactions)
+            {
+                CFE_EVS_SendEvent(CF_INIT_POOL_SIZE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has %lu chunk blocks, fewer than its %lu transactions",
+                                  i,
+                                  (unsigned long)cc->num_chunk_blocks,
+                                  (unsigned long)cc->num_transactions);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            if (cc->nak_mode >= CF_NakMode_NUM)
+            {
+                CFE_EVS_SendEvent(CF_INIT_NAK_MODE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has invalid NAK mode %u",
+                                  i,
+                                  (unsigned int)cc->nak_mode);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            if (cc->playback_order >= CF_PlaybackOrder_NUM)
+            {
+                CFE_EVS_SendEvent(CF_INIT_PLAYBACK_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has invalid playback order %u",
+                                  i,
+                                  (unsigned int)cc->playback_order);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            if (cc->delta_block_size > CF_DELTA_MAX_BLOCK_SIZE)
+            {
+                CFE_EVS_SendEvent(CF_INIT_DELTA_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has delta block size %lu, max is %lu",
+                                  i,
+                                  (unsigned long)cc->delta_block_size,
+                                  (unsigned long)CF_DELTA_MAX_BLOCK_SIZE);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            if (cc->rtt_timer_max_s != 0 && cc->rtt_timer_min_s > cc->rtt_timer_max_s)
+            {
+                CFE_EVS_SendEvent(CF_INIT_RTT_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table channel %d has RTT timer bounds %lu..%lu s",
+                                  i,
+                                  (unsigned long)cc->rtt_timer_min_s,
+                                  (unsigned long)cc->rtt_timer_max_s);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+                break;
+            }
+
+            for (j = 0; j < CF_MAX_POLLING_DIR_PER_CHAN && ret == CFE_SUCCESS; ++j)
+            {
+                if (cc->polldir[j].compress >= CF_Compress_NUM)
+                {
+                    CFE_EVS_SendEvent(CF_INIT_PLAYBACK_ERR_EID,
+                                      CFE_EVS_EventType_ERROR,
+                                      "CF: config table channel %d polling dir %d has invalid compression %u",
+                                      i,
+                                      j,
+                                      (unsigned int)cc->polldir[j].compress);
+                    ret = CFE_STATUS_VALIDATION_FAILURE;
+                }
+            }
+            if (ret != CFE_SUCCESS)
+            {
+                break;
+            }
+
+            arena_size += CF_CFDP_ChannelArenaSize(cc);
+        }
+
+        /* the patterns are matched as strings */
+        for (i = 0; i < CF_MAX_PLAYBACK_PRIO_RULES && ret == CFE_SUCCESS; ++i)
+        {
+            if (memchr(tbl->playback_prio[i].pattern, 0, sizeof(tbl->playback_prio[i].pattern)) == NULL)
+            {
+                CFE_EVS_SendEvent(CF_INIT_PLAYBACK_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: config table playback priority pattern %d is not terminated",
+                                  i);
+                ret = CFE_STATUS_VALIDATION_FAILURE;
+            }
+        }
+
+        if (ret == CFE_SUCCESS && memchr(tbl->stats_shm_name, 0, sizeof(tbl->stats_shm_name)) == NULL)
+        {
+            CFE_EVS_SendEvent(CF_INIT_SHM_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: config table statistics shared memory name is not terminated");
+            ret = CFE_STATUS_VALIDATION_FAILURE;
+        }
+
+        if (ret == CFE_SUCCESS && memchr(tbl->capture_file, 0, sizeof(tbl->capture_file)) == NULL)
+        {
+            CFE_EVS_SendEvent(CF_INIT_CAPTURE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: config table PDU capture file name is not terminated");
+            ret = CFE_STATUS_VALIDATION_FAILURE;
+        }
+
+        if (ret == CFE_SUCCESS && arena_size > sizeof(CF_AppData.engine.arena_mem))
+        {
+            CFE_EVS_SendEvent(CF_INIT_ARENA_SIZE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: config table needs %lu bytes of engine arena, only %lu available",
+                              (unsigned long)arena_size,
+                              (unsigned long)sizeof(CF_AppData.engine.arena_mem));
+            ret = CFE_STATUS_VALIDATION_FAILURE;
+        }
     }
 
     return ret;
@@ -217,6 +372,9 @@ CFE_Status_t CF_AppInit(void)
     CF_AppData.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
     CFE_MSG_Init(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader), CFE_SB_ValueToMsgId(CF_HK_TLM_MID), sizeof(CF_AppData.hk));
+    CF_Diag_Init();
+    CF_Peer_Init();
+    CF_EvLim_Init();
 
     status = CFE_EVS_Register(NULL, 0, CFE_EVS_EventFilter_BINARY);
     if (status != CFE_SUCCESS)
@@ -263,6 +421,9 @@ CFE_Status_t CF_AppInit(void)
 
     if (status == CFE_SUCCESS)
     {
+        CF_Shm_Init();
+        CF_Capture_Init();
+
         CFE_EVS_SendEvent(CF_INIT_INF_EID,
                           CFE_EVS_EventType_INFORMATION,
                           "CF Initialized. Version %d.%d.%d.%d",
@@ -319,6 +480,9 @@ void CF_AppMain(void)
         }
     }
 
+    /* the PDUs of the last wakeups are not lost */
+    CF_Capture_Flush();
+
     CFE_ES_PerfLogExit(CF_PERF_ID_APPMAIN);
     CFE_ES_ExitApp(CF_AppData.RunStatus);
 }
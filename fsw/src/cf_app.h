@@ -36,6 +36,12 @@
 #include "cf_platform_cfg.h"
 #include "cf_cfdp.h"
 #include "cf_clist.h"
+#include "cf_capture.h"
+#include "cf_diag.h"
+#include "cf_dump.h"
+#include "cf_evlim.h"
+#include "cf_peer.h"
+#include "cf_shm.h"
 
 /**************************************************************************
  **
@@ -94,6 +100,18 @@ typedef struct
     CF_ConfigTable_t *config_table;
 
     CF_Engine_t engine;
+
+    CF_Diag_t diag;
+
+    CF_Peer_t peer;
+
+    CF_Shm_t shm;
+
+    CF_Dump_t dump;
+
+    CF_EvLim_t evlim;
+
+    CF_Capture_t capture;
 } CF_AppData_t;
 
 /**************************************************************************
@@ -0,0 +1,632 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application multi-file bundles
+ *
+ * Small files of a polling directory are packed into a single transaction,
+ * and unpacked again by the receiver.  See cf_bundle.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_utils.h"
+#include "cf_cfdp_s.h"
+#include "cf_bundle.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bundle_Store32(CF_CFDP_uint32_t *pdst, uint32 val)
+{
+    pdst->octets[0] = (val >> 24) & 0xFF;
+    pdst->octets[1] = (val >> 16) & 0xFF;
+    pdst->octets[2] = (val >> 8) & 0xFF;
+    pdst->octets[3] = val & 0xFF;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Bundle_Load32(const CF_CFDP_uint32_t *psrc)
+{
+    return ((uint32)psrc->octets[0] << 24) | ((uint32)psrc->octets[1] << 16) | ((uint32)psrc->octets[2] << 8) |
+           (uint32)psrc->octets[3];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static const CF_PollDir_t *CF_Bundle_GetPollDir(const CF_Playback_t *pb)
+{
+    return &CF_AppData.config_table->chan[pb->bundle.chan_num].polldir[pb->bundle.poll_num];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Bundle_Now(void)
+{
+    OS_time_t now;
+
+    OS_GetLocalTime(&now);
+
+    return (uint32)OS_TimeGetTotalSeconds(now);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Copies size bytes from the current position of src to dst.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Bundle_Copy(osal_id_t dst, osal_id_t src, uint32 size)
+{
+    uint8  buf[CF_BUNDLE_COPY_SIZE];
+    uint32 chunk;
+
+    while (size > 0)
+    {
+        chunk = (size < sizeof(buf)) ? size : sizeof(buf);
+
+        if (CF_WrappedRead(src, buf, chunk) != chunk || CF_WrappedWrite(dst, buf, chunk) != chunk)
+        {
+            return CF_ERROR;
+        }
+
+        size -= chunk;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads the header of a bundle, returns the number of files or -1 if it is not valid.
+ *
+ *-----------------------------------------------------------------*/
+static int32 CF_Bundle_ReadHeader(osal_id_t fd)
+{
+    CF_BundleHeader_t hdr;
+    int32             num_files = -1;
+
+    if (CF_WrappedRead(fd, &hdr, sizeof(hdr)) == sizeof(hdr) && CF_Bundle_Load32(&hdr.magic) == CF_BUNDLE_MAGIC &&
+        hdr.version.octets[0] == CF_BUNDLE_VERSION)
+    {
+        num_files = ((int32)hdr.num_files.octets[0] << 8) | hdr.num_files.octets[1];
+    }
+
+    return num_files;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads the entry at *offs, and moves *offs past its file contents.  The
+ * file position is left at the start of the contents.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Bundle_ReadEntry(osal_id_t fd, CF_BundleEntry_t *entry, uint32 *size, off_t *offs)
+{
+    if (CF_WrappedLseek(fd, *offs, OS_SEEK_SET) != *offs ||
+        CF_WrappedRead(fd, entry, sizeof(*entry)) != sizeof(*entry))
+    {
+        return CF_ERROR;
+    }
+
+    /* a name is never empty, and never leaves its directory */
+    entry->name[sizeof(entry->name) - 1] = 0;
+    if (entry->name[0] == 0 || strchr(entry->name, '/') != NULL || strcmp(entry->name, "..") == 0)
+    {
+        return CF_ERROR;
+    }
+
+    *size = CF_Bundle_Load32(&entry->size);
+    *offs += sizeof(*entry) + *size;
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Records the outcome of one file of a bundle in the history of the channel.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bundle_AddHistory(CF_Transaction_t *txn, const char *src, const char *dst, CF_TxnStatus_t txn_stat)
+{
+    CF_Channel_t *chan = &CF_AppData.engine.channels[txn->chan_num];
+    CF_History_t *history;
+    int           q_index;
+
+    if (chan->qs[CF_QueueIdx_HIST_FREE])
+    {
+        q_index = CF_QueueIdx_HIST_FREE;
+    }
+    else if (chan->qs[CF_QueueIdx_HIST])
+    {
+        /* no free history, so take the oldest one from the channel's history queue */
+        q_index = CF_QueueIdx_HIST;
+    }
+    else
+    {
+        /* every history is held by a transaction */
+        return;
+    }
+
+    history = container_of(chan->qs[q_index], CF_History_t, cl_node);
+    CF_CList_Remove_Ex(chan, q_index, &history->cl_node);
+
+    history->dir      = txn->history->dir;
+    history->src_eid  = txn->history->src_eid;
+    history->peer_eid = txn->history->peer_eid;
+    history->seq_num  = txn->history->seq_num;
+    history->txn_stat = txn_stat;
+    history->metrics  = txn->history->metrics;
+    snprintf(history->fnames.src_filename, sizeof(history->fnames.src_filename), "%s", src);
+    snprintf(history->fnames.dst_filename, sizeof(history->fnames.dst_filename), "%s", dst);
+
+    CF_CList_InsertBack_Ex(chan, CF_QueueIdx_HIST, &history->cl_node);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the final header and closes the bundle, so it can be sent.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Bundle_Close(CF_Playback_t *pb)
+{
+    CF_BundleHeader_t hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    CF_Bundle_Store32(&hdr.magic, CF_BUNDLE_MAGIC);
+    hdr.version.octets[0]   = CF_BUNDLE_VERSION;
+    hdr.num_files.octets[0] = (pb->bundle.num_files >> 8) & 0xFF;
+    hdr.num_files.octets[1] = pb->bundle.num_files & 0xFF;
+
+    if (CF_WrappedLseek(pb->bundle.fd, 0, OS_SEEK_SET) != 0 ||
+        CF_WrappedWrite(pb->bundle.fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to write bundle header of %s",
+                          pb->fnames.src_filename);
+        CF_Bundle_Discard(pb);
+    }
+    else
+    {
+        CF_WrappedClose(pb->bundle.fd);
+        pb->bundle.fd    = OS_OBJECT_ID_UNDEFINED;
+        pb->bundle.ready = true;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Bundle_Open(CF_Playback_t *pb, uint32 mtime)
+{
+    CF_BundleHeader_t hdr;
+    char              path[CF_FILENAME_MAX_LEN];
+    CFE_Status_t      ret;
+
+    CF_Bundle_GetPath(pb, CF_AppData.config_table->tmp_dir, path, sizeof(path));
+
+    ret = CF_WrappedOpenCreate(&pb->bundle.fd, path, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+    if (ret < 0)
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to create bundle %s, error=%ld",
+                          path,
+                          (long)ret);
+        pb->bundle.fd = OS_OBJECT_ID_UNDEFINED;
+        return CF_ERROR;
+    }
+
+    /* the header is rewritten when the bundle is closed, once the count is known */
+    memset(&hdr, 0, sizeof(hdr));
+    if (CF_WrappedWrite(pb->bundle.fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR, "CF: failed to write bundle %s", path);
+        CF_Bundle_Discard(pb);
+        return CF_ERROR;
+    }
+
+    pb->bundle.bytes  = 0;
+    pb->bundle.oldest = mtime;
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_FileSize_t CF_Bundle_FileMax(const CF_Playback_t *pb)
+{
+    CF_FileSize_t file_max = 0;
+
+    if (pb->polled)
+    {
+        file_max = CF_Bundle_GetPollDir(pb)->bundle_file_max;
+    }
+
+    return file_max;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bundle_Add(CF_Playback_t *pb, const char *path, const char *name, CF_FileSize_t size, uint32 mtime)
+{
+    const CF_PollDir_t *pd = CF_Bundle_GetPollDir(pb);
+    CF_BundleEntry_t    entry;
+    osal_id_t           fd;
+    CFE_Status_t        ret;
+
+    ret = CF_WrappedOpenCreate(&fd, path, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (ret < 0)
+    {
+        /* sent on its own, the transfer reports the actual error */
+        return CF_ERROR;
+    }
+
+    if (pb->bundle.num_files == 0)
+    {
+        ret = CF_Bundle_Open(pb, mtime);
+    }
+
+    if (ret >= 0)
+    {
+        memset(&entry, 0, sizeof(entry));
+        CF_Bundle_Store32(&entry.size, size);
+        strncpy(entry.name, name, sizeof(entry.name) - 1);
+
+        if (CF_WrappedWrite(pb->bundle.fd, &entry, sizeof(entry)) != sizeof(entry) ||
+            CF_Bundle_Copy(pb->bundle.fd, fd, size) != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_BUNDLE_WRITE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: failed to add %s to bundle",
+                              path);
+            CF_Bundle_Discard(pb);
+            ret = CF_ERROR;
+        }
+        else
+        {
+            ++pb->bundle.num_files;
+            pb->bundle.bytes += size;
+            if (mtime < pb->bundle.oldest)
+            {
+                pb->bundle.oldest = mtime;
+            }
+            ret = CFE_SUCCESS;
+        }
+    }
+
+    CF_WrappedClose(fd);
+
+    if (ret == CFE_SUCCESS &&
+        ((pd->bundle_max_files != 0 && pb->bundle.num_files >= pd->bundle_max_files) ||
+         (pd->bundle_max_bytes != 0 && pb->bundle.bytes >= pd->bundle_max_bytes) || pb->bundle.num_files == 0xFFFF))
+    {
+        CF_Bundle_Close(pb);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_EndScan(CF_Playback_t *pb)
+{
+    if (pb->bundle.num_files != 0 && !pb->bundle.ready)
+    {
+        if ((CF_Bundle_Now() - pb->bundle.oldest) >= CF_Bundle_GetPollDir(pb)->bundle_max_age_s)
+        {
+            CF_Bundle_Close(pb);
+        }
+        else
+        {
+            /* wait for more files, the next poll builds the bundle again */
+            CF_Bundle_Discard(pb);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_GetPath(const CF_Playback_t *pb, const char *dir, char *buf, size_t buf_size)
+{
+    snprintf(buf,
+             buf_size,
+             "%.*s/cf_c%up%u_%u%s",
+             CF_FILENAME_MAX_PATH - 1,
+             dir,
+             (unsigned int)pb->bundle.chan_num,
+             (unsigned int)pb->bundle.poll_num,
+             (unsigned int)pb->bundle.seq,
+             CF_BUNDLE_SUFFIX);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_Discard(CF_Playback_t *pb)
+{
+    char path[CF_FILENAME_MAX_LEN];
+
+    if (OS_ObjectIdDefined(pb->bundle.fd))
+    {
+        CF_WrappedClose(pb->bundle.fd);
+        pb->bundle.fd = OS_OBJECT_ID_UNDEFINED;
+    }
+
+    CF_Bundle_GetPath(pb, CF_AppData.config_table->tmp_dir, path, sizeof(path));
+    OS_remove(path);
+
+    pb->bundle.num_files = 0;
+    pb->bundle.bytes     = 0;
+    pb->bundle.ready     = false;
+    pb->rescan           = true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_Started(CF_Playback_t *pb)
+{
+    pb->bundle.ready     = false;
+    pb->bundle.num_files = 0;
+    pb->bundle.bytes     = 0;
+    ++pb->bundle.seq;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_Retain(CF_Transaction_t *txn)
+{
+    CF_BundleEntry_t entry;
+    osal_id_t        fd;
+    char             src[CF_FILENAME_MAX_LEN];
+    char             dst[CF_FILENAME_MAX_LEN];
+    const char      *bundle_file = txn->history->fnames.src_filename;
+    int32            num_files;
+    int32            i;
+    uint32           size;
+    off_t            offs;
+
+    if (CF_WrappedOpenCreate(&fd, bundle_file, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_READ_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot open bundle %s", bundle_file);
+        return;
+    }
+
+    num_files = CF_Bundle_ReadHeader(fd);
+    offs      = sizeof(CF_BundleHeader_t);
+
+    for (i = 0; i < num_files; ++i)
+    {
+        if (CF_Bundle_ReadEntry(fd, &entry, &size, &offs) != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        snprintf(src,
+                 sizeof(src),
+                 "%.*s/%.*s",
+                 CF_FILENAME_MAX_PATH - 1,
+                 txn->pb->fnames.src_filename,
+                 CF_FILENAME_MAX_NAME - 1,
+                 entry.name);
+        snprintf(dst,
+                 sizeof(dst),
+                 "%.*s/%.*s",
+                 CF_FILENAME_MAX_PATH - 1,
+                 txn->pb->fnames.dst_filename,
+                 CF_FILENAME_MAX_NAME - 1,
+                 entry.name);
+
+        CF_CFDP_S_RetainFile(txn, src);
+        CF_Bundle_AddHistory(txn, src, dst, txn->history->txn_stat);
+    }
+
+    CF_WrappedClose(fd);
+
+    if (i < num_files || num_files < 0)
+    {
+        /* the files not handled are still in the directory, and are sent again */
+        CFE_EVS_SendEvent(CF_BUNDLE_READ_ERR_EID, CFE_EVS_EventType_ERROR, "CF: invalid bundle %s", bundle_file);
+    }
+
+    OS_remove(bundle_file);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Bundle_IsBundle(const char *filename)
+{
+    size_t len        = strlen(filename);
+    size_t suffix_len = sizeof(CF_BUNDLE_SUFFIX) - 1;
+
+    return (len > suffix_len && strcmp(&filename[len - suffix_len], CF_BUNDLE_SUFFIX) == 0);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bundle_Unpack(CF_Transaction_t *txn, const char *bundle_file, const char *dst_filename)
+{
+    CF_BundleEntry_t entry;
+    osal_id_t        fd;
+    osal_id_t        part_fd;
+    char             part[CF_FILENAME_MAX_LEN + sizeof(CF_BUNDLE_PART_SUFFIX)];
+    char             dst[CF_FILENAME_MAX_LEN];
+    const char      *slash;
+    int              dir_len;
+    int32            num_files;
+    int32            num_parts;
+    int32            i;
+    uint32           size;
+    off_t            offs;
+    CFE_Status_t     ret   = CFE_SUCCESS;
+    bool             moved = true;
+
+    /* the files go next to the name the bundle was sent to */
+    slash   = strrchr(dst_filename, '/');
+    dir_len = (slash != NULL) ? (slash - dst_filename) : 1;
+    if (slash == NULL)
+    {
+        dst_filename = ".";
+    }
+
+    if (CF_WrappedOpenCreate(&fd, bundle_file, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_READ_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot open bundle %s", bundle_file);
+        return CF_ERROR;
+    }
+
+    num_files = CF_Bundle_ReadHeader(fd);
+    if (num_files < 0)
+    {
+        CFE_EVS_SendEvent(CF_BUNDLE_READ_ERR_EID, CFE_EVS_EventType_ERROR, "CF: invalid bundle %s", bundle_file);
+        CF_WrappedClose(fd);
+        return CF_ERROR;
+    }
+
+    /* first write every file under a temporary name */
+    offs = sizeof(CF_BundleHeader_t);
+    for (num_parts = 0; num_parts < num_files && ret == CFE_SUCCESS; ++num_parts)
+    {
+        if (CF_Bundle_ReadEntry(fd, &entry, &size, &offs) != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_BUNDLE_READ_ERR_EID, CFE_EVS_EventType_ERROR, "CF: invalid bundle %s", bundle_file);
+            ret = CF_ERROR;
+            break;
+        }
+
+        snprintf(part, sizeof(part), "%.*s/%s%s", dir_len, dst_filename, entry.name, CF_BUNDLE_PART_SUFFIX);
+        if (CF_WrappedOpenCreate(&part_fd, part, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) < 0)
+        {
+            ret = CF_ERROR;
+        }
+        else
+        {
+            ret = CF_Bundle_Copy(part_fd, fd, size);
+            CF_WrappedClose(part_fd);
+        }
+
+        if (ret != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_BUNDLE_UNPACK_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot store %s", part);
+        }
+    }
+
+    /* then give them their own names, or remove them all if one could not be written */
+    offs = sizeof(CF_BundleHeader_t);
+    for (i = 0; i < num_parts; ++i)
+    {
+        if (CF_Bundle_ReadEntry(fd, &entry, &size, &offs) != CFE_SUCCESS)
+        {
+            /* was read fine in the first pass */
+            ret = CF_ERROR;
+            break;
+        }
+
+        snprintf(part, sizeof(part), "%.*s/%s%s", dir_len, dst_filename, entry.name, CF_BUNDLE_PART_SUFFIX);
+        if (ret != CFE_SUCCESS)
+        {
+            OS_remove(part);
+            continue;
+        }
+
+        snprintf(dst, sizeof(dst), "%.*s/%s", dir_len, dst_filename, entry.name);
+        if (OS_mv(part, dst) != OS_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_BUNDLE_UNPACK_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot move file to %s", dst);
+            OS_remove(part);
+            CF_Bundle_AddHistory(txn, entry.name, dst, CF_TxnStatus_FILESTORE_REJECTION);
+            moved = false;
+        }
+        else
+        {
+            CF_Bundle_AddHistory(txn, entry.name, dst, CF_TxnStatus_NO_ERROR);
+        }
+    }
+
+    CF_WrappedClose(fd);
+
+    return (ret == CFE_SUCCESS && moved) ? CFE_SUCCESS : CF_ERROR;
+}
@@ -0,0 +1,230 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Multi-file bundles for polling directories
+ *
+ * Every file sent by a polling directory normally costs a whole transaction:
+ * a full MD/FD/EOF/FIN/ACK exchange, a history entry, an EOT packet and a
+ * file move.  For directories that produce many tiny files, the protocol
+ * overhead dominates the transfer.
+ *
+ * When a polling directory has bundle_file_max set, files no larger than that
+ * are not sent one by one.  Their contents are appended to a bundle file in
+ * the temp directory instead, which is sent as a single transaction once it
+ * reaches bundle_max_files files or bundle_max_bytes bytes of data.  A partial
+ * bundle is sent at the end of a scan once its oldest file is at least
+ * bundle_max_age_s old; otherwise it is discarded and its files are left for
+ * the next poll.
+ *
+ * The bundle is sent with a destination name ending in CF_BUNDLE_SUFFIX.  A
+ * receiver that finds this suffix unpacks the bundle into the destination
+ * directory instead of storing it: every file is first written under a
+ * temporary name, and only once all of them were written are they renamed
+ * to their own names.  Each file of a bundle gets its own history entry,
+ * on both sides.
+ *
+ * The container is made of a CF_BundleHeader_t, then for every file a
+ * CF_BundleEntry_t followed by the file contents.  All integers are big
+ * endian, like the PDUs, as the two ends may not share a byte order.
+ */
+
+#ifndef CF_BUNDLE_H
+#define CF_BUNDLE_H
+
+#include "cf_cfdp_types.h"
+#include "cf_cfdp_pdu.h"
+#include "cf_tbldefs.h"
+
+/**
+ * @brief Value of the magic field of a bundle header ("CFBN")
+ */
+#define CF_BUNDLE_MAGIC 0x4346424E
+
+/**
+ * @brief Version of the bundle format, increment on any change to the structures below
+ */
+#define CF_BUNDLE_VERSION 1
+
+/**
+ * @brief Suffix of the destination name of a bundle, which tells the receiver to unpack it
+ */
+#define CF_BUNDLE_SUFFIX ".cfb"
+
+/**
+ * @brief Suffix appended to the files of a bundle while it is being unpacked
+ */
+#define CF_BUNDLE_PART_SUFFIX ".part"
+
+/**
+ * @brief Size of the buffer used to copy file contents into and out of bundles
+ */
+#define CF_BUNDLE_COPY_SIZE 512
+
+/**
+ * @brief Bundle file header
+ */
+typedef struct CF_BundleHeader
+{
+    CF_CFDP_uint32_t magic;     /**< \brief always CF_BUNDLE_MAGIC */
+    CF_CFDP_uint8_t  version;   /**< \brief always CF_BUNDLE_VERSION */
+    CF_CFDP_uint8_t  spare;     /**< \brief always 0 */
+    CF_CFDP_uint16_t num_files; /**< \brief number of files following */
+} CF_BundleHeader_t;
+
+/**
+ * @brief Bundle entry, followed by size bytes of file contents
+ */
+typedef struct CF_BundleEntry
+{
+    CF_CFDP_uint32_t size;                       /**< \brief size of the file */
+    char             name[CF_FILENAME_MAX_NAME]; /**< \brief name of the file, without directory */
+} CF_BundleEntry_t;
+
+/************************************************************************/
+/** @brief Gets the size up to which files found by a playback go into bundles.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb must not be NULL.  Only playbacks of polling directories that have
+ *       bundle_file_max set use bundles.
+ *
+ * @param pb  The playback state
+ *
+ * @returns The largest file size to add with CF_Bundle_Add(), or 0 if the playback does not bundle
+ */
+CF_FileSize_t CF_Bundle_FileMax(const CF_Playback_t *pb);
+
+/************************************************************************/
+/** @brief Appends a file found by a polling scan to the bundle of the playback.
+ *
+ * The bundle is created with the first file, and closed once it is full.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb, path and name must not be NULL.  size must not exceed
+ *       CF_Bundle_FileMax().  If the bundle cannot be written it is
+ *       discarded, and the playback is marked for a rescan.
+ *
+ * @param pb     The playback state
+ * @param path   Full path of the file
+ * @param name   Name of the file, without directory
+ * @param size   Size of the file
+ * @param mtime  Modification time of the file, in seconds
+ *
+ * @retval CFE_SUCCESS if the file was added
+ * @retval CF_ERROR if it was not, and must be sent on its own
+ */
+CFE_Status_t CF_Bundle_Add(CF_Playback_t *pb, const char *path, const char *name, CF_FileSize_t size, uint32 mtime);
+
+/************************************************************************/
+/** @brief Handles the bundle of the playback at the end of a polling scan.
+ *
+ * A partial bundle is closed for sending if its oldest file is at least
+ * bundle_max_age_s old.  Otherwise it is discarded, and the playback is
+ * marked for a rescan so its files are found again by the next poll.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb must not be NULL.
+ *
+ * @param pb  The playback state
+ */
+void CF_Bundle_EndScan(CF_Playback_t *pb);
+
+/************************************************************************/
+/** @brief Gets the path of the bundle of a playback in a directory.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb, dir and buf must not be NULL.  The name ends in CF_BUNDLE_SUFFIX.
+ *
+ * @param pb        The playback state
+ * @param dir       Directory of the path
+ * @param buf       Output buffer for the full path of the bundle
+ * @param buf_size  Size of buf
+ */
+void CF_Bundle_GetPath(const CF_Playback_t *pb, const char *dir, char *buf, size_t buf_size);
+
+/************************************************************************/
+/** @brief Drops the bundle of a playback without sending it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb must not be NULL.  The playback is marked for a rescan, the files of
+ *       the bundle are still in the polling directory.
+ *
+ * @param pb  The playback state
+ */
+void CF_Bundle_Discard(CF_Playback_t *pb);
+
+/************************************************************************/
+/** @brief Marks the closed bundle of a playback as sent.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb must not be NULL.  The bundle file now belongs to the transaction
+ *       sending it, and is removed by CF_Bundle_Retain().
+ *
+ * @param pb  The playback state
+ */
+void CF_Bundle_Started(CF_Playback_t *pb);
+
+/************************************************************************/
+/** @brief Applies the sender file retention policy to every file of a sent bundle.
+ *
+ * Every file of the bundle is handled as if it had been sent on its own by
+ * the transaction, and gets its own history entry.  The bundle file is then
+ * removed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be the transaction that sent the bundle
+ *       for its playback.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Bundle_Retain(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Checks whether a received file is a bundle, by its destination name.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       filename must not be NULL.
+ *
+ * @param filename  Destination file name of the transaction
+ *
+ * @retval true if the file must be unpacked with CF_Bundle_Unpack()
+ * @retval false if it is an ordinary file
+ */
+bool CF_Bundle_IsBundle(const char *filename);
+
+/************************************************************************/
+/** @brief Unpacks a received bundle into the directory of its destination name.
+ *
+ * Either all files of the bundle are stored, or none of them is.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn, bundle_file and dst_filename must not be NULL.
+ *
+ * @param txn           Pointer to the transaction object
+ * @param bundle_file   Received bundle (the temp file)
+ * @param dst_filename  Destination file name of the transaction
+ *
+ * @retval CFE_SUCCESS if every file of the bundle was stored
+ * @retval CF_ERROR if the bundle is invalid or could not be stored
+ */
+CFE_Status_t CF_Bundle_Unpack(CF_Transaction_t *txn, const char *bundle_file, const char *dst_filename);
+
+#endif /* !CF_BUNDLE_H */
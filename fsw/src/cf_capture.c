@@ -0,0 +1,223 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application PDU capture
+ *
+ * Copies of the PDUs received and sent, in a ring file of large blocks.
+ * See cf_capture.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_utils.h"
+#include "cf_capture.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Stores a big endian number of size octets.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Capture_Store(uint8 *octets, uint64 val, size_t size)
+{
+    while (size > 0)
+    {
+        --size;
+        octets[size] = val & 0xFF;
+        val >>= 8;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the block being filled at its place in the ring, and ends the capture on failure.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Capture_WriteBlock(CF_Capture_t *cap)
+{
+    CF_CaptureBlockHeader_t *hdr  = (CF_CaptureBlockHeader_t *)cap->block;
+    size_t                   size = sizeof(*hdr) + cap->used;
+    off_t                    offset;
+
+    CF_Capture_Store(hdr->magic.octets, CF_CAPTURE_MAGIC, sizeof(hdr->magic));
+    CF_Capture_Store(hdr->version.octets, CF_CAPTURE_VERSION, sizeof(hdr->version));
+    CF_Capture_Store(hdr->header_size.octets, sizeof(*hdr), sizeof(hdr->header_size));
+    CF_Capture_Store(hdr->block_size.octets, CF_CAPTURE_BLOCK_SIZE, sizeof(hdr->block_size));
+    CF_Capture_Store(hdr->seq.octets, cap->seq, sizeof(hdr->seq));
+    CF_Capture_Store(hdr->used.octets, cap->used, sizeof(hdr->used));
+    CF_Capture_Store(hdr->ticks_per_second.octets,
+                     CF_AppData.config_table->ticks_per_second,
+                     sizeof(hdr->ticks_per_second));
+    CF_Capture_Store(hdr->local_eid.octets, CF_AppData.config_table->local_eid, sizeof(hdr->local_eid));
+
+    /* only the used part is written, the rest of an older block left there is ignored by readers */
+    offset = (off_t)(cap->seq % cap->num_blocks) * CF_CAPTURE_BLOCK_SIZE;
+    if (CF_WrappedLseek(cap->fd, offset, OS_SEEK_SET) != offset || CF_WrappedWrite(cap->fd, cap->block, size) != size)
+    {
+        CFE_EVS_SendEvent(CF_CAPTURE_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to write PDU capture block %lu, capture stopped",
+                          (unsigned long)cap->seq);
+        CF_WrappedClose(cap->fd);
+        cap->fd      = OS_OBJECT_ID_UNDEFINED;
+        cap->enabled = false;
+    }
+
+    cap->dirty      = false;
+    cap->write_tick = cap->tick;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_capture.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Capture_Init(void)
+{
+    CF_Capture_t           *cap = &CF_AppData.capture;
+    const CF_ConfigTable_t *tbl = CF_AppData.config_table;
+    int32                   ret;
+
+    cap->enabled = false;
+
+    if (tbl->capture_file[0] != 0)
+    {
+        ret = CF_WrappedOpenCreate(&cap->fd, tbl->capture_file, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE,
+                                   OS_WRITE_ONLY);
+        if (ret < 0)
+        {
+            CFE_EVS_SendEvent(CF_INIT_CAPTURE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: failed to create PDU capture file %s, returned 0x%08lx",
+                              tbl->capture_file,
+                              (unsigned long)ret);
+        }
+        else
+        {
+            cap->num_blocks = tbl->capture_max_kb / (CF_CAPTURE_BLOCK_SIZE / 1024);
+            if (tbl->capture_max_kb == 0 || cap->num_blocks > CF_CAPTURE_MAX_BLOCKS)
+            {
+                cap->num_blocks = CF_CAPTURE_MAX_BLOCKS;
+            }
+            else if (cap->num_blocks == 0)
+            {
+                cap->num_blocks = 1;
+            }
+
+            cap->seq        = 0;
+            cap->used       = 0;
+            cap->tick       = 0;
+            cap->write_tick = 0;
+            cap->dirty      = false;
+            cap->enabled    = true;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_capture.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Capture_Pdu(uint8 chan, uint8 dir, const void *pdu, size_t len)
+{
+    CF_Capture_t       *cap = &CF_AppData.capture;
+    CF_CaptureRecord_t *rec;
+    CFE_TIME_SysTime_t  now;
+
+    if (len > CF_MAX_PDU_SIZE)
+    {
+        len = CF_MAX_PDU_SIZE;
+    }
+
+    if (sizeof(CF_CaptureBlockHeader_t) + cap->used + sizeof(*rec) + len > CF_CAPTURE_BLOCK_SIZE)
+    {
+        CF_Capture_WriteBlock(cap);
+        ++cap->seq;
+        cap->used = 0;
+    }
+
+    /* the write may have failed */
+    if (cap->enabled)
+    {
+        now = CFE_TIME_GetTime();
+        rec = (CF_CaptureRecord_t *)&cap->block[sizeof(CF_CaptureBlockHeader_t) + cap->used];
+
+        CF_Capture_Store(rec->tick.octets, cap->tick, sizeof(rec->tick));
+        CF_Capture_Store(rec->time_secs.octets, now.Seconds, sizeof(rec->time_secs));
+        CF_Capture_Store(rec->time_subsecs.octets, now.Subseconds, sizeof(rec->time_subsecs));
+        CF_Capture_Store(rec->len.octets, len, sizeof(rec->len));
+        rec->chan.octets[0] = chan;
+        rec->dir.octets[0]  = dir;
+        memcpy(rec + 1, pdu, len);
+
+        cap->used += sizeof(*rec) + len;
+        cap->dirty = true;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_capture.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Capture_Tick(void)
+{
+    CF_Capture_t *cap = &CF_AppData.capture;
+
+    if (cap->enabled)
+    {
+        ++cap->tick;
+
+        /* a block filling slowly still reaches the file, it is written again in place as it fills */
+        if (cap->dirty && (cap->tick - cap->write_tick) >= CF_AppData.config_table->ticks_per_second)
+        {
+            CF_Capture_WriteBlock(cap);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_capture.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Capture_Flush(void)
+{
+    CF_Capture_t *cap = &CF_AppData.capture;
+
+    if (cap->enabled && cap->dirty)
+    {
+        CF_Capture_WriteBlock(cap);
+    }
+}
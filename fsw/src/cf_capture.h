@@ -0,0 +1,160 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Capture of the PDUs received and sent, for replay on a host
+ *
+ * When capture_file of the configuration table is not empty, every PDU read
+ * from an input pipe and every PDU sent is copied, with the wakeup and the
+ * time it was seen at, into a buffer of CF_CAPTURE_BLOCK_SIZE bytes.  The
+ * buffer is written to the file at once when it is full, and once a second
+ * while it fills, so that a capture costs one large write for many PDUs.
+ *
+ * The file is a ring of up to capture_max_kb KiB: the blocks are written in
+ * turn, and once the ring is full the oldest block is overwritten.  Each
+ * block is a CF_CaptureBlockHeader_t, numbered since the capture started,
+ * followed by its records: a CF_CaptureRecord_t and the PDU, without its SB
+ * headers.  All numbers are big endian.  A reader orders the blocks by their
+ * number, and ignores the bytes of a block past its used size.
+ *
+ * bench/cf_replay.c feeds the PDUs received back into CF on a host, at the
+ * wakeups they were received in.
+ */
+
+#ifndef CF_CAPTURE_H
+#define CF_CAPTURE_H
+
+#include "cfe.h"
+#include "cf_cfdp_pdu.h"
+
+/**
+ * @brief Value of the magic field of a capture block, "CFPC"
+ */
+#define CF_CAPTURE_MAGIC 0x43465043
+
+/**
+ * @brief Version of the capture format, changed with any change of the block or record layout
+ */
+#define CF_CAPTURE_VERSION 1
+
+/**
+ * @brief Size of a block of the capture file, and of each write
+ */
+#define CF_CAPTURE_BLOCK_SIZE 32768
+
+/**
+ * @brief Most blocks of the ring, so that every block is within the reach of a 32 bit seek
+ */
+#define CF_CAPTURE_MAX_BLOCKS 65535
+
+/**
+ * @brief Directions of a captured PDU
+ */
+#define CF_CAPTURE_DIR_RX 0 /**< \brief read from the input pipe of the channel */
+#define CF_CAPTURE_DIR_TX 1 /**< \brief sent on the output message ID of the channel */
+
+/**
+ * @brief Header at the start of each block of a capture file
+ */
+typedef struct CF_CaptureBlockHeader
+{
+    CF_CFDP_uint32_t magic;            /**< \brief always CF_CAPTURE_MAGIC */
+    CF_CFDP_uint16_t version;          /**< \brief CF_CAPTURE_VERSION */
+    CF_CFDP_uint16_t header_size;      /**< \brief size of this header in bytes */
+    CF_CFDP_uint32_t block_size;       /**< \brief CF_CAPTURE_BLOCK_SIZE */
+    CF_CFDP_uint32_t seq;              /**< \brief number of the block since the capture started */
+    CF_CFDP_uint32_t used;             /**< \brief bytes of records after this header */
+    CF_CFDP_uint32_t ticks_per_second; /**< \brief wakeups per second of the configuration table */
+    CF_CFDP_uint64_t local_eid;        /**< \brief entity ID of the capturing CF */
+} CF_CaptureBlockHeader_t;
+
+/**
+ * @brief Header of each captured PDU, followed by the len bytes of the PDU
+ */
+typedef struct CF_CaptureRecord
+{
+    CF_CFDP_uint32_t tick;         /**< \brief wakeup the PDU was seen in, counted since the capture started */
+    CF_CFDP_uint32_t time_secs;    /**< \brief seconds part of the CFE time the PDU was seen at */
+    CF_CFDP_uint32_t time_subsecs; /**< \brief subseconds part of the CFE time the PDU was seen at */
+    CF_CFDP_uint16_t len;          /**< \brief bytes of the PDU */
+    CF_CFDP_uint8_t  chan;         /**< \brief channel of the PDU */
+    CF_CFDP_uint8_t  dir;          /**< \brief CF_CAPTURE_DIR_RX or CF_CAPTURE_DIR_TX */
+} CF_CaptureRecord_t;
+
+/**
+ * @brief PDU capture state of the application
+ */
+typedef struct CF_Capture
+{
+    bool      enabled;    /**< \brief the capture file is open */
+    bool      dirty;      /**< \brief records were added since the block was last written */
+    osal_id_t fd;         /**< \brief capture file */
+    uint32    num_blocks; /**< \brief blocks of the ring */
+    uint32    seq;        /**< \brief number of the block being filled */
+    uint32    used;       /**< \brief bytes of records in the block being filled */
+    uint32    tick;       /**< \brief wakeups since the capture started */
+    uint32    write_tick; /**< \brief wakeup the block was last written */
+
+    uint8 block[CF_CAPTURE_BLOCK_SIZE]; /**< \brief block being filled, its header is set when written */
+} CF_Capture_t;
+
+/************************************************************************/
+/** @brief Opens the capture file named in the configuration table.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The configuration table must be loaded.  A file that cannot be
+ *       created is reported with an event, and nothing is captured.
+ */
+void CF_Capture_Init(void);
+
+/************************************************************************/
+/** @brief Adds a PDU to the capture.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Only called when enabled is set, so that the disabled capture costs
+ *       a test.  pdu must not be NULL.  PDUs longer than CF_MAX_PDU_SIZE are
+ *       cut to that size.  A write error is reported with an event, and ends
+ *       the capture.
+ *
+ * @param chan  Channel of the PDU
+ * @param dir   CF_CAPTURE_DIR_RX or CF_CAPTURE_DIR_TX
+ * @param pdu   PDU, without its SB headers
+ * @param len   Bytes of the PDU
+ */
+void CF_Capture_Pdu(uint8 chan, uint8 dir, const void *pdu, size_t len);
+
+/************************************************************************/
+/** @brief Counts a wakeup, and writes the block being filled once a second.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once each wakeup.
+ */
+void CF_Capture_Tick(void);
+
+/************************************************************************/
+/** @brief Writes the block being filled, if any records were added to it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called when the application exits, so that the capture is complete.
+ */
+void CF_Capture_Flush(void);
+
+#endif /* !CF_CAPTURE_H */
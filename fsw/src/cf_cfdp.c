@@ -42,6 +42,14 @@
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_dispatch.h"
 #include "cf_cfdp_sbintf.h"
+#include "cf_journal.h"
+#include "cf_spill.h"
+#include "cf_pollidx.h"
+#include "cf_bundle.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_rtt.h"
+#include "cf_diag.h"
 
 #include <string.h>
 #include "cf_assert.h"
@@ -128,7 +136,8 @@ void CF_CFDP_DecodeStart(CF_DecoderState_t      *pdec,
  *-----------------------------------------------------------------*/
 void CF_CFDP_ArmAckTimer(CF_Transaction_t *txn)
 {
-    CF_Timer_InitRelSec(&txn->ack_timer, CF_AppData.config_table->chan[txn->chan_num].ack_timer_s);
+    CF_Timer_InitRelTicks(&txn->ack_timer,
+                          CF_Rtt_GetTimeout(txn, CF_AppData.config_table->chan[txn->chan_num].ack_timer_s));
     txn->flags.com.ack_timer_armed = true;
 }
 
@@ -209,6 +218,7 @@ bool CF_CFDP_CheckAckNakCount(CF_Transaction_t *txn, uint8 *counter)
     {
         /* Reached limit */
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.ack_limit;
+        CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_ACK_LIMIT, 1);
 
         if (txn->history->dir == CF_Direction_TX)
         {
@@ -349,6 +359,8 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
         hdr->destination_eid = dst_eid;
         hdr->sequence_num    = tsn;
 
+        CF_Peer_Count(towards_sender ? src_eid : dst_eid, CF_PeerCounter_PDU_SENT, 1);
+
         /*
          * encode the known parts so far.  total_size field cannot be
          * included yet because its value is not known, but the basic
@@ -412,6 +424,9 @@ CFE_Status_t CF_CFDP_SendMd(CF_Transaction_t *txn)
             OS_strnlen(txn->history->fnames.dst_filename, sizeof(txn->history->fnames.dst_filename));
         md->dest_filename.data_ptr = txn->history->fnames.dst_filename;
 
+        CF_Compress_SetMd(md, txn->compress);
+        CF_Delta_SetMd(txn, md);
+
         CF_CFDP_EncodeMd(ph->penc, md);
         CF_CFDP_SetPduLength(ph);
         CF_CFDP_Send(txn->chan_num, ph);
@@ -682,6 +697,82 @@ void CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     CF_TRACE("%s(): Sent NAK, segments=%d\n", __func__, (int)nak->segment_list.num_segments);
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response)
+{
+    CF_Logical_PduBuffer_t *ph = CF_CFDP_ConstructPduHeader(txn,
+                                                            CF_CFDP_FileDirective_PROMPT,
+                                                            CF_AppData.config_table->local_eid,
+                                                            txn->history->peer_eid,
+                                                            0,
+                                                            txn->history->seq_num,
+                                                            0);
+    CF_Logical_PduPrompt_t *prompt;
+    CFE_Status_t            ret = CFE_SUCCESS;
+
+    if (!ph)
+    {
+        ret = CF_SEND_PDU_NO_BUF_AVAIL_ERROR;
+    }
+    else
+    {
+        prompt = &ph->int_header.prompt;
+
+        prompt->response_required = response;
+
+        CF_CFDP_EncodePrompt(ph->penc, prompt);
+        CF_CFDP_SetPduLength(ph);
+        CF_CFDP_Send(txn->chan_num, ph);
+
+        CF_TRACE("%s(): Sent PROMPT, response=%d\n", __func__, (int)prompt->response_required);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress)
+{
+    CF_Logical_PduBuffer_t    *ph = CF_CFDP_ConstructPduHeader(txn,
+                                                               CF_CFDP_FileDirective_KEEP_ALIVE,
+                                                               txn->history->peer_eid,
+                                                               CF_AppData.config_table->local_eid,
+                                                               1,
+                                                               txn->history->seq_num,
+                                                               0);
+    CF_Logical_PduKeepAlive_t *ka;
+    CFE_Status_t               ret = CFE_SUCCESS;
+
+    if (!ph)
+    {
+        ret = CF_SEND_PDU_NO_BUF_AVAIL_ERROR;
+    }
+    else
+    {
+        ka = &ph->int_header.keep_alive;
+
+        ka->progress = progress;
+
+        CF_CFDP_EncodeKeepAlive(ph->penc, ka);
+        CF_CFDP_SetPduLength(ph);
+        CF_CFDP_Send(txn->chan_num, ph);
+
+        CF_TRACE("%s(): Sent KEEP ALIVE, progress=%lu\n", __func__, (unsigned long)ka->progress);
+    }
+
+    return ret;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -700,9 +791,12 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
      */
     if (CF_CFDP_DecodeHeader(ph->pdec, &ph->pdu_header) != CFE_SUCCESS)
     {
-        CFE_EVS_SendEvent(CF_PDU_TRUNCATION_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: PDU rejected due to EID/seq number field truncation");
+        if (CF_EvLim_Allow(CF_PDU_TRUNCATION_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_TRUNCATION_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: PDU rejected due to EID/seq number field truncation");
+        }
         ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
@@ -714,9 +808,12 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
      */
     else if (CF_CODEC_IS_OK(ph->pdec) && ph->pdu_header.large_flag)
     {
-        CFE_EVS_SendEvent(CF_PDU_LARGE_FILE_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: PDU with large file bit received (unsupported)");
+        if (CF_EvLim_Allow(CF_PDU_LARGE_FILE_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_LARGE_FILE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: PDU with large file bit received (unsupported)");
+        }
         ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
@@ -729,10 +826,13 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
 
         if (!CF_CODEC_IS_OK(ph->pdec))
         {
-            CFE_EVS_SendEvent(CF_PDU_SHORT_HEADER_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF: PDU too short (%lu received)",
-                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+            if (CF_EvLim_Allow(CF_PDU_SHORT_HEADER_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_PDU_SHORT_HEADER_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: PDU too short (%lu received)",
+                                  (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+            }
             ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
             ret = CF_SHORT_PDU_ERROR;
         }
@@ -740,6 +840,11 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
         {
             /* PDU is ok, so continue processing */
             ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.pdu;
+
+            /* the peer is the receiver of a PDU sent toward the sender, and the source otherwise */
+            CF_Peer_Count(ph->pdu_header.direction ? ph->pdu_header.destination_eid : ph->pdu_header.source_eid,
+                          CF_PeerCounter_PDU_RECV,
+                          1);
         }
     }
 
@@ -761,10 +866,13 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     CF_CFDP_DecodeMd(ph->pdec, &ph->int_header.md);
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_MD_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: metadata packet too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_MD_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_MD_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: metadata packet too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
         ret = CF_PDU_METADATA_ERROR;
     }
@@ -776,6 +884,9 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         /* store the expected file size in transaction */
         txn->fsize = md->size;
 
+        /* the file is decompressed when it is retained */
+        txn->compress = CF_Compress_GetMd(md);
+
         /*
          * store the filenames in transaction.
          *
@@ -788,13 +899,16 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                                           &md->source_filename);
         if (lv_ret < 0)
         {
-            CFE_EVS_SendEvent(CF_PDU_INVALID_SRC_LEN_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): md rejected, invalid length source filename: 0x%02x",
-                              CF_CFDP_GetPrintClass(txn),
-                              (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num,
-                              md->source_filename.length);
+            if (CF_EvLim_Allow(CF_PDU_INVALID_SRC_LEN_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_PDU_INVALID_SRC_LEN_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): md rejected, invalid length source filename: 0x%02x",
+                                  CF_CFDP_GetPrintClass(txn),
+                                  (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num,
+                                  md->source_filename.length);
+            }
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
             ret = CF_PDU_METADATA_ERROR;
         }
@@ -805,13 +919,16 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                                               &md->dest_filename);
             if (lv_ret < 0)
             {
-                CFE_EVS_SendEvent(CF_PDU_INVALID_DST_LEN_ERR_EID,
-                                  CFE_EVS_EventType_ERROR,
-                                  "CF R%d(%lu:%lu): md rejected, invalid length dest filename: 0x%02x",
-                                  CF_CFDP_GetPrintClass(txn),
-                                  (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num,
-                                  md->dest_filename.length);
+                if (CF_EvLim_Allow(CF_PDU_INVALID_DST_LEN_ERR_EID))
+                {
+                    CFE_EVS_SendEvent(CF_PDU_INVALID_DST_LEN_ERR_EID,
+                                      CFE_EVS_EventType_ERROR,
+                                      "CF R%d(%lu:%lu): md rejected, invalid length dest filename: 0x%02x",
+                                      CF_CFDP_GetPrintClass(txn),
+                                      (unsigned long)txn->history->src_eid,
+                                      (unsigned long)txn->history->seq_num,
+                                      md->dest_filename.length);
+                }
                 ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
                 ret = CF_PDU_METADATA_ERROR;
             }
@@ -859,19 +976,25 @@ CFE_Status_t CF_CFDP_RecvFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_FD_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: filedata PDU too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_FD_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_FD_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: filedata PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
         ret = CF_SHORT_PDU_ERROR;
     }
     else if (ph->pdu_header.segment_meta_flag)
     {
         /* If recv PDU has the "segment_meta_flag" set, this is not currently handled in CF. */
-        CFE_EVS_SendEvent(CF_PDU_FD_UNSUPPORTED_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: filedata PDU with segment metadata received");
+        if (CF_EvLim_Allow(CF_PDU_FD_UNSUPPORTED_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_FD_UNSUPPORTED_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: filedata PDU with segment metadata received");
+        }
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
@@ -893,10 +1016,13 @@ CFE_Status_t CF_CFDP_RecvEof(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_EOF_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: EOF PDU too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_EOF_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_EOF_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: EOF PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ret = CF_SHORT_PDU_ERROR;
     }
 
@@ -917,10 +1043,13 @@ CFE_Status_t CF_CFDP_RecvAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_ACK_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: ACK PDU too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_ACK_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_ACK_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: ACK PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ret = CF_SHORT_PDU_ERROR;
     }
 
@@ -942,10 +1071,13 @@ CFE_Status_t CF_CFDP_RecvFin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_FIN_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: FIN PDU too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_FIN_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_FIN_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: FIN PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ret = CF_SHORT_PDU_ERROR;
     }
 
@@ -968,10 +1100,67 @@ CFE_Status_t CF_CFDP_RecvNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     if (!CF_CODEC_IS_OK(ph->pdec))
     {
-        CFE_EVS_SendEvent(CF_PDU_NAK_SHORT_ERR_EID,
-                          CFE_EVS_EventType_ERROR,
-                          "CF: NAK PDU too short: %lu bytes received",
-                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        if (CF_EvLim_Allow(CF_PDU_NAK_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_NAK_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: NAK PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
+        ret = CF_SHORT_PDU_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    CF_CFDP_DecodePrompt(ph->pdec, &ph->int_header.prompt);
+
+    if (!CF_CODEC_IS_OK(ph->pdec))
+    {
+        if (CF_EvLim_Allow(CF_PDU_PROMPT_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_PROMPT_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: PROMPT PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
+        ret = CF_SHORT_PDU_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    CF_CFDP_DecodeKeepAlive(ph->pdec, &ph->int_header.keep_alive);
+
+    if (!CF_CODEC_IS_OK(ph->pdec))
+    {
+        if (CF_EvLim_Allow(CF_PDU_KEEP_ALIVE_SHORT_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_PDU_KEEP_ALIVE_SHORT_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: KEEP ALIVE PDU too short: %lu bytes received",
+                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        }
         ret = CF_SHORT_PDU_ERROR;
     }
 
@@ -1119,6 +1308,8 @@ void CF_CFDP_SetupRxTransaction(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *p
     txn->history->peer_eid = ph->pdu_header.source_eid;
     txn->history->src_eid  = ph->pdu_header.source_eid;
 
+    CF_TxnMetrics_Mark(&txn->history->metrics, &txn->history->metrics.first_pdu_ms);
+
     /* all RX transactions will need a chunk list to track file segments */
     if (txn->chunks == NULL)
     {
@@ -1155,6 +1346,7 @@ void CF_CFDP_SetupRxTransaction(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *p
 void CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph)
 {
     CF_Transaction_t *txn;
+    CF_SpillEntry_t  *spilled;
     uint8             chan_num = (chan - CF_AppData.engine.channels);
 
     /* This decodes the header in the PDU.  If it fails it sends the relevent event
@@ -1169,20 +1361,34 @@ void CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph)
     txn = CF_FindTransactionBySequenceNumber(chan, ph->pdu_header.sequence_num, ph->pdu_header.source_eid);
     if (txn == NULL)
     {
+        spilled = CF_Spill_Find(chan, ph->pdu_header.source_eid, ph->pdu_header.sequence_num);
+        if (spilled != NULL)
+        {
+            /* bring it back from disk, this sends an event if that fails */
+            txn = CF_Spill_Reload(chan, spilled);
+        }
         /* if no match found, then check if we are the destination entity id.
          * If so then this would be the first PDU of an RX transaction */
-        if (ph->pdu_header.destination_eid == CF_AppData.config_table->local_eid)
+        else if (ph->pdu_header.destination_eid == CF_AppData.config_table->local_eid)
         {
             /* we didn't find a match, so assign it to a transaction */
             txn = CF_CFDP_StartRxTransaction(chan_num);
+            if (txn == NULL && CF_Spill_MakeRoom(chan))
+            {
+                txn = CF_CFDP_StartRxTransaction(chan_num);
+            }
+
             if (txn == NULL)
             {
-                CFE_EVS_SendEvent(
-                    CF_CFDP_RX_DROPPED_ERR_EID,
-                    CFE_EVS_EventType_ERROR,
-                    "CF: dropping packet from %lu transaction number 0x%08lx due max RX transactions reached",
-                    (unsigned long)ph->pdu_header.source_eid,
-                    (unsigned long)ph->pdu_header.sequence_num);
+                if (CF_EvLim_Allow(CF_CFDP_RX_DROPPED_ERR_EID))
+                {
+                    CFE_EVS_SendEvent(
+                        CF_CFDP_RX_DROPPED_ERR_EID,
+                        CFE_EVS_EventType_ERROR,
+                        "CF: dropping packet from %lu transaction number 0x%08lx due max RX transactions reached",
+                        (unsigned long)ph->pdu_header.source_eid,
+                        (unsigned long)ph->pdu_header.sequence_num);
+                }
             }
             else
             {
@@ -1193,10 +1399,13 @@ void CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph)
         }
         else
         {
-            CFE_EVS_SendEvent(CF_CFDP_INVALID_DST_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF: dropping packet for invalid destination eid 0x%lx",
-                              (unsigned long)ph->pdu_header.destination_eid);
+            if (CF_EvLim_Allow(CF_CFDP_INVALID_DST_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_INVALID_DST_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: dropping packet for invalid destination eid 0x%lx",
+                                  (unsigned long)ph->pdu_header.destination_eid);
+            }
         }
     }
 
@@ -1208,6 +1417,120 @@ void CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 CF_CFDP_ChannelArenaSize(const CF_ChannelConfig_t *cc)
+{
+    uint64 size;
+    uint64 num_txn   = cc->num_transactions;
+    uint64 rx_blocks = CF_CHUNK_BLOCKS_FOR((uint64)cc->rx_chunks_per_transaction);
+    uint64 tx_blocks = CF_CHUNK_BLOCKS_FOR((uint64)cc->tx_chunks_per_transaction);
+
+    /* must match the allocations made by CF_CFDP_InitChannelPools() */
+    size = CF_ARENA_ROUNDUP(num_txn * sizeof(CF_Transaction_t));
+    size += CF_ARENA_ROUNDUP((uint64)cc->num_histories * sizeof(CF_History_t));
+    size += CF_ARENA_ROUNDUP(num_txn * CF_Direction_NUM * sizeof(CF_ChunkWrapper_t));
+    size += CF_Direction_NUM * CF_ARENA_ROUNDUP(num_txn * sizeof(CF_Transaction_t *));
+    size += CF_ARENA_ROUNDUP(num_txn * rx_blocks * sizeof(CF_Chunk_t *));
+    size += CF_ARENA_ROUNDUP(num_txn * tx_blocks * sizeof(CF_Chunk_t *));
+    size += CF_ARENA_ROUNDUP((uint64)cc->num_chunk_blocks * CF_CHUNK_BLOCK_SIZE * sizeof(CF_Chunk_t));
+    size += CF_ARENA_ROUNDUP((uint64)cc->num_chunk_blocks * sizeof(CF_Chunk_t *));
+
+    return size;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Carves the transaction, history and chunk pools of one channel from the
+ * engine arena and puts everything on the channel free lists.  Chunk lists
+ * only get the block pointer array here; their chunk storage is drawn from
+ * the channel slab as they grow.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_CFDP_InitChannelPools(uint8 chan_num)
+{
+    const CF_ChannelConfig_t *cc    = &CF_AppData.config_table->chan[chan_num];
+    CF_Channel_t             *chan  = &CF_AppData.engine.channels[chan_num];
+    CF_Arena_t               *arena = &CF_AppData.engine.arena;
+    CF_Transaction_t         *txn;
+    CF_History_t             *history;
+    CF_ChunkWrapper_t        *cw;
+    CF_Chunk_t              **blocks[CF_Direction_NUM];
+    CF_Chunk_t               *block_mem;
+    CF_Chunk_t              **free_blocks;
+    uint32                    num_chunks[CF_Direction_NUM];
+    uint32                    num_blocks[CF_Direction_NUM];
+    CF_CListNode_t          **list_head;
+    uint64                    needed;
+    uint32                    j;
+    int                       k;
+
+    needed = CF_CFDP_ChannelArenaSize(cc);
+    if (needed > (arena->size - arena->used))
+    {
+        CFE_EVS_SendEvent(CF_INIT_ARENA_SIZE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: channel %d needs %lu bytes of engine arena, only %lu left",
+                          chan_num,
+                          (unsigned long)needed,
+                          (unsigned long)(arena->size - arena->used));
+        return CF_ERROR;
+    }
+
+    /* the space was checked above, so none of these can fail */
+    num_chunks[CF_Direction_RX] = cc->rx_chunks_per_transaction;
+    num_chunks[CF_Direction_TX] = cc->tx_chunks_per_transaction;
+    num_blocks[CF_Direction_RX] = CF_CHUNK_BLOCKS_FOR(num_chunks[CF_Direction_RX]);
+    num_blocks[CF_Direction_TX] = CF_CHUNK_BLOCKS_FOR(num_chunks[CF_Direction_TX]);
+
+    txn     = CF_Arena_Alloc(arena, cc->num_transactions * sizeof(*txn));
+    history = CF_Arena_Alloc(arena, cc->num_histories * sizeof(*history));
+    cw      = CF_Arena_Alloc(arena, cc->num_transactions * CF_Direction_NUM * sizeof(*cw));
+    for (k = 0; k < CF_Direction_NUM; ++k)
+    {
+        chan->active[k].txn      = CF_Arena_Alloc(arena, cc->num_transactions * sizeof(CF_Transaction_t *));
+        chan->active[k].capacity = cc->num_transactions;
+    }
+    for (k = 0; k < CF_Direction_NUM; ++k)
+    {
+        blocks[k] = CF_Arena_Alloc(arena, cc->num_transactions * num_blocks[k] * sizeof(CF_Chunk_t *));
+    }
+    block_mem   = CF_Arena_Alloc(arena, cc->num_chunk_blocks * CF_CHUNK_BLOCK_SIZE * sizeof(CF_Chunk_t));
+    free_blocks = CF_Arena_Alloc(arena, cc->num_chunk_blocks * sizeof(CF_Chunk_t *));
+
+    /* one block of the slab is kept for each transaction, so each can always record its first chunk */
+    CF_ChunkSlab_Init(&chan->chunk_slab, cc->num_chunk_blocks, cc->num_transactions, block_mem, free_blocks);
+
+    for (j = 0; j < cc->num_transactions; ++j, ++txn)
+    {
+        /* Initially put this on the free list for this channel */
+        CF_FreeTransaction(txn, chan_num);
+
+        for (k = 0; k < CF_Direction_NUM; ++k, ++cw)
+        {
+            list_head = CF_GetChunkListHead(chan, k);
+
+            CF_ChunkListInit(&cw->chunks, num_chunks[k], &blocks[k][j * num_blocks[k]], &chan->chunk_slab);
+            CF_CList_InitNode(&cw->cl_node);
+            CF_CList_InsertBack(list_head, &cw->cl_node);
+        }
+    }
+
+    for (j = 0; j < cc->num_histories; ++j, ++history)
+    {
+        CF_CList_InitNode(&history->cl_node);
+        CF_CList_InsertBack_Ex(chan, CF_QueueIdx_HIST_FREE, &history->cl_node);
+    }
+
+    return CFE_SUCCESS;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -1216,24 +1539,13 @@ void CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph)
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_CFDP_InitEngine(void)
 {
-    /* initialize all transaction nodes */
-    CF_History_t      *history;
-    CF_Transaction_t  *txn = CF_AppData.engine.transactions;
-    CF_ChunkWrapper_t *cw  = CF_AppData.engine.chunks;
-    CF_CListNode_t   **list_head;
-    CFE_Status_t       ret              = CFE_SUCCESS;
-    int                chunk_mem_offset = 0;
-    int                i;
-    int                j;
-    int                k;
-    char               nbuf[64];
-
-    static const int CF_DIR_MAX_CHUNKS[CF_Direction_NUM][CF_NUM_CHANNELS] = {
-        CF_CHANNEL_NUM_RX_CHUNKS_PER_TRANSACTION,
-        CF_CHANNEL_NUM_TX_CHUNKS_PER_TRANSACTION
-    };
+    CFE_Status_t ret = CFE_SUCCESS;
+    int          i;
+    int          j;
+    char         nbuf[64];
 
     memset(&CF_AppData.engine, 0, sizeof(CF_AppData.engine));
+    CF_Arena_Init(&CF_AppData.engine.arena, CF_AppData.engine.arena_mem.bytes, sizeof(CF_AppData.engine.arena_mem));
 
     /* Ensure that the temp directory exists (ignore error if it already exists) */
     OS_mkdir(CF_AppData.config_table->tmp_dir, 0);
@@ -1301,33 +1613,21 @@ CFE_Status_t CF_CFDP_InitEngine(void)
             }
         }
 
-        for (j = 0; j < CF_NUM_TRANSACTIONS_PER_CHANNEL; ++j, ++txn)
-        {
-            /* Initially put this on the free list for this channel */
-            CF_FreeTransaction(txn, i);
-
-            for (k = 0; k < CF_Direction_NUM; ++k, ++cw)
-            {
-                list_head = CF_GetChunkListHead(&CF_AppData.engine.channels[i], k);
-
-                CF_Assert((chunk_mem_offset + CF_DIR_MAX_CHUNKS[k][i]) <= CF_NUM_CHUNKS_ALL_CHANNELS);
-                CF_ChunkListInit(&cw->chunks, CF_DIR_MAX_CHUNKS[k][i], &CF_AppData.engine.chunk_mem[chunk_mem_offset]);
-                chunk_mem_offset += CF_DIR_MAX_CHUNKS[k][i];
-                CF_CList_InitNode(&cw->cl_node);
-                CF_CList_InsertBack(list_head, &cw->cl_node);
-            }
-        }
-
-        for (j = 0; j < CF_NUM_HISTORIES_PER_CHANNEL; ++j)
+        ret = CF_CFDP_InitChannelPools(i);
+        if (ret != CFE_SUCCESS)
         {
-            history = &CF_AppData.engine.histories[(i * CF_NUM_HISTORIES_PER_CHANNEL) + j];
-            CF_CList_InitNode(&history->cl_node);
-            CF_CList_InsertBack_Ex(&CF_AppData.engine.channels[i], CF_QueueIdx_HIST_FREE, &history->cl_node);
+            break;
         }
     }
 
     if (ret == CFE_SUCCESS)
     {
+        /* pick up any receive transactions that were in progress before a restart */
+        CF_Journal_Restore();
+
+        /* and the polling directories that had nothing left to send */
+        CF_PollIdx_Load();
+
         CF_AppData.engine.enabled = true;
     }
 
@@ -1399,6 +1699,7 @@ bool CF_CFDP_StartFirstPending(CF_Channel_t *chan)
         return false;
     }
 
+    /* the PEND queue is kept in priority order, so the head is the one to start */
     txn = container_of(chan->qs[CF_QueueIdx_PEND], CF_Transaction_t, cl_node);
 
     CF_CFDP_SetupTxTransaction(txn);
@@ -1413,31 +1714,102 @@ bool CF_CFDP_StartFirstPending(CF_Channel_t *chan)
  * See description in cf_cfdp.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-CF_CListTraverse_Status_t CF_CFDP_DoTick(CF_CListNode_t *node, void *context)
+void CF_CFDP_TickActiveSet(CF_Channel_t *chan, CF_TickState_t tick_state, uint32 start_idx)
 {
-    CF_CListTraverse_Status_t ret  = CF_CLIST_CONT; /* CF_CLIST_CONT means don't tick one, keep looking for cur */
-    CF_CFDP_Tick_args_t      *args = (CF_CFDP_Tick_args_t *)context;
-    CF_Transaction_t         *txn  = container_of(node, CF_Transaction_t, cl_node);
+    CF_ActiveSet_t   *set;
+    CF_Transaction_t *txn;
+    uint32            idx;
+
+    if (tick_state == CF_TickState_RX_STATE)
+    {
+        set = &chan->active[CF_Direction_RX];
+    }
+    else
+    {
+        set = &chan->active[CF_Direction_TX];
+    }
 
-    if (args->resume_point == NULL || args->resume_point == txn)
+    /* NOTE: if channel is frozen, then tick processing won't have been entered.
+     *     so there is no need to check it here */
+    idx = start_idx;
+    while (idx < set->count && !chan->tx_blocked && !CF_CFDP_BudgetSpent())
     {
-        /* found where we left off, so clear that and move on */
-        args->resume_point = NULL;
+        txn = set->txn[idx];
+
         if (!txn->flags.com.suspended)
         {
-            args->fn(txn);
+            switch (tick_state)
+            {
+                case CF_TickState_RX_STATE:
+                    CF_CFDP_R_Tick(txn);
+                    break;
+
+                case CF_TickState_TX_STATE:
+                    CF_CFDP_S_Tick(txn);
+                    break;
+
+                default:
+                    CF_CFDP_S_Tick_Nak(txn);
+                    break;
+            }
         }
 
-        /* if args->chan->cur was set to not-NULL above, then exit early */
-        /* NOTE: if channel is frozen, then tick processing won't have been entered.
-         *     so there is no need to check it here */
-        if (args->chan->tx_blocked)
+        /* If the txn left the queue during its tick, the last entry was moved into
+         * this slot, so it must be visited next rather than skipped over */
+        if (idx < set->count && set->txn[idx] == txn)
         {
-            ret = CF_CLIST_EXIT;
+            ++idx;
         }
     }
 
-    return ret; /* don't tick one, keep looking for cur */
+    /* out of time, state ticks carry on from here on the next wakeup (NAKs are best effort) */
+    if (idx < set->count && CF_AppData.engine.budget_spent && tick_state != CF_TickState_TX_NAK &&
+        chan->tick_resume_state == CF_TickState_INIT)
+    {
+        chan->tick_resume_state = tick_state;
+        chan->tick_resume_idx   = idx;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_TickNewData(CF_Channel_t *chan)
+{
+    CF_CListNode_t   *start = chan->qs[CF_QueueIdx_TX];
+    CF_CListNode_t   *node  = start;
+    CF_CListNode_t   *node_next;
+    CF_Transaction_t *txn;
+    bool              last = false;
+
+    /*
+     * New file data goes out in priority order, so this walks the (sorted) TX
+     * queue itself rather than the active set.  The walk is robust against the
+     * current txn leaving the queue, the same way CF_CList_Traverse() is.
+     */
+    while (node != NULL && !last && !chan->tx_blocked && !CF_CFDP_BudgetSpent())
+    {
+        node_next = node->next;
+        if (node_next == start)
+        {
+            last = true;
+        }
+
+        txn = container_of(node, CF_Transaction_t, cl_node);
+        if (!txn->flags.com.suspended)
+        {
+            CF_CFDP_S_Tick_NewData(txn);
+        }
+
+        if ((start == node) && (node->next != node_next))
+        {
+            start = node_next;
+        }
+        node = node_next;
+    }
 }
 
 /*----------------------------------------------------------------
@@ -1452,9 +1824,17 @@ void CF_CFDP_CompleteTick(CF_Transaction_t *txn)
 
     /* check if the TX is now blocked and if so, record this txn as the resume point */
     chan = CF_GetChannelFromTxn(txn);
-    if (chan != NULL && chan->tx_blocked && chan->tick_resume == NULL)
+    if (chan != NULL && chan->tx_blocked && chan->tick_resume_state == CF_TickState_INIT)
     {
-        chan->tick_resume = txn;
+        if (txn->flags.com.q_index == CF_QueueIdx_RX)
+        {
+            chan->tick_resume_state = CF_TickState_RX_STATE;
+        }
+        else
+        {
+            chan->tick_resume_state = CF_TickState_TX_STATE;
+        }
+        chan->tick_resume_idx = txn->active_idx;
     }
 }
 
@@ -1466,18 +1846,41 @@ void CF_CFDP_CompleteTick(CF_Transaction_t *txn)
  *-----------------------------------------------------------------*/
 void CF_CFDP_TickTransactions(CF_Channel_t *chan)
 {
-    CF_CFDP_Tick_args_t targs;
-    int                 q_id;
-    uint32              last_counter;
-    uint8               curr_state;
+    static const CF_DiagPhase_t tick_phase[CF_TickState_COMPLETE] = {
+        [CF_TickState_INIT]        = CF_DiagPhase_RX_TICK,
+        [CF_TickState_RX_STATE]    = CF_DiagPhase_RX_TICK,
+        [CF_TickState_TX_STATE]    = CF_DiagPhase_TX_TICK,
+        [CF_TickState_TX_NAK]      = CF_DiagPhase_NAK,
+        [CF_TickState_TX_FILEDATA] = CF_DiagPhase_NEW_DATA,
+        [CF_TickState_TX_PEND]     = CF_DiagPhase_TX_TICK,
+    };
 
-    memset(&targs, 0, sizeof(targs));
+    uint8     chan_num = (uint8)(chan - CF_AppData.engine.channels);
+    uint32    last_counter;
+    uint32    start_idx;
+    uint8     curr_state;
+    uint8     ticked_state;
+    OS_time_t mark;
 
-    targs.chan         = chan;
-    targs.resume_point = chan->tick_resume;
-    chan->tick_resume  = NULL;
+    /*
+     * If the previous wakeup got blocked, skip directly to the state and position
+     * where it left off.  The saved index is only a hint - if entries were added or
+     * removed in the meantime this may land on a neighbor, which is fine since all
+     * entries are visited in turn anyway.
+     */
+    if (chan->tick_resume_state != CF_TickState_INIT)
+    {
+        curr_state = chan->tick_resume_state;
+        start_idx  = chan->tick_resume_idx;
+    }
+    else
+    {
+        curr_state = CF_TickState_INIT;
+        start_idx  = 0;
+    }
 
-    curr_state = CF_TickState_INIT;
+    chan->tick_resume_state = CF_TickState_INIT;
+    chan->tick_resume_idx   = 0;
 
     /*
      * tx_blocked means we ran out of available outgoing messages this wakeup.
@@ -1495,48 +1898,48 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan)
      * NAK response (best effort, could be many)
      * New file data on TX (best effort, could be many)
      */
+    CF_Diag_Mark(&mark);
     while (curr_state < CF_TickState_COMPLETE)
     {
+        /* out of time for this wakeup, state ticks not done yet come first on the next one */
+        if (CF_CFDP_BudgetSpent())
+        {
+            if (chan->tick_resume_state == CF_TickState_INIT && curr_state <= CF_TickState_TX_STATE)
+            {
+                chan->tick_resume_state = curr_state;
+                chan->tick_resume_idx   = start_idx;
+            }
+            break;
+        }
+
         last_counter = chan->outgoing_counter;
+        ticked_state = curr_state;
 
         switch (curr_state)
         {
             case CF_TickState_RX_STATE:
-                q_id     = CF_QueueIdx_RX;
-                targs.fn = CF_CFDP_R_Tick;
-                break;
-
             case CF_TickState_TX_STATE:
-                q_id     = CF_QueueIdx_TX;
-                targs.fn = CF_CFDP_S_Tick;
-                break;
-
             case CF_TickState_TX_NAK:
-                q_id     = CF_QueueIdx_TX;
-                targs.fn = CF_CFDP_S_Tick_Nak;
+                CF_CFDP_TickActiveSet(chan, curr_state, start_idx);
                 break;
 
             case CF_TickState_TX_FILEDATA:
                 /* When we get here we will send new file data. */
-                q_id     = CF_QueueIdx_TX;
-                targs.fn = CF_CFDP_S_Tick_NewData;
+                CF_CFDP_TickNewData(chan);
                 break;
 
             default:
                 /* Do nothing */
-                targs.fn = NULL;
-                q_id     = 0;
                 break;
         }
 
-        if (targs.fn != NULL)
-        {
-            CF_CList_Traverse(chan->qs[q_id], CF_CFDP_DoTick, &targs);
-        }
+        /* only the first pass after a resume starts partway through a set */
+        start_idx = 0;
 
         /* If blocked, stop */
         if (chan->tx_blocked)
         {
+            CF_Diag_Lap(chan_num, tick_phase[ticked_state], &mark);
             break;
         }
 
@@ -1566,7 +1969,12 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan)
                 ++curr_state;
                 break;
         }
+
+        CF_Diag_Lap(chan_num, tick_phase[ticked_state], &mark);
     }
+
+    /* everything produced this wakeup goes out together */
+    CF_CFDP_FlushOutput(chan);
 }
 
 /*----------------------------------------------------------------
@@ -1632,7 +2040,8 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
                             uint8           keep,
                             uint8           chan_num,
                             uint8           priority,
-                            CF_EntityId_t   dest_id)
+                            CF_EntityId_t   dest_id,
+                            uint8           compress)
 {
     CF_Transaction_t *txn;
     CF_Channel_t     *chan = &CF_AppData.engine.channels[chan_num];
@@ -1666,6 +2075,7 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
         strncpy(txn->history->fnames.dst_filename, dst_filename, sizeof(txn->history->fnames.dst_filename) - 1);
         txn->history->fnames.dst_filename[sizeof(txn->history->fnames.dst_filename) - 1] = 0;
         CF_CFDP_TxFile_Initiate(txn, cfdp_class, keep, chan_num, priority, dest_id);
+        txn->compress = compress;
 
         ++chan->num_cmd_tx;
         txn->flags.tx.cmd_tx = true;
@@ -1701,6 +2111,7 @@ CF_Transaction_t *CF_CFDP_StartRxTransaction(uint8 chan_num)
         /* At this point all we know is that this is an RX transaction */
         txn->flags.com.q_index = CF_QueueIdx_RX;
         CF_CList_InsertBack_Ex(chan, txn->flags.com.q_index, &txn->cl_node);
+        CF_ActiveSet_Insert(txn);
     }
 
     return txn;
@@ -1718,7 +2129,8 @@ static CFE_Status_t CF_CFDP_PlaybackDir_Initiate(CF_Playback_t  *pb,
                                                  uint8           keep,
                                                  uint8           chan,
                                                  uint8           priority,
-                                                 CF_EntityId_t   dest_id)
+                                                 CF_EntityId_t   dest_id,
+                                                 uint8           compress)
 {
     CFE_Status_t ret;
 
@@ -1741,6 +2153,7 @@ static CFE_Status_t CF_CFDP_PlaybackDir_Initiate(CF_Playback_t  *pb,
         pb->priority   = priority;
         pb->dest_id    = dest_id;
         pb->cfdp_class = cfdp_class;
+        pb->compress   = compress;
 
         /* NOTE: the caller of this function ensures the provided src and dst filenames are NULL terminated */
         strncpy(pb->fnames.src_filename, src_filename, sizeof(pb->fnames.src_filename) - 1);
@@ -1765,7 +2178,8 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
                                  uint8           keep,
                                  uint8           chan,
                                  uint8           priority,
-                                 uint16          dest_id)
+                                 uint16          dest_id,
+                                 uint8           compress)
 {
     int            i;
     CF_Playback_t *pb;
@@ -1785,7 +2199,50 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
         return CF_ERROR;
     }
 
-    return CF_CFDP_PlaybackDir_Initiate(pb, src_filename, dst_filename, cfdp_class, keep, chan, priority, dest_id);
+    return CF_CFDP_PlaybackDir_Initiate(pb, src_filename, dst_filename, cfdp_class, keep, chan, priority, dest_id,
+                                        compress);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_MatchPattern(const char *pattern, const char *name)
+{
+    const char *star      = NULL; /* pattern position after the last '*' seen */
+    const char *star_name = NULL; /* name position that the last '*' matched up to */
+
+    while (*name != 0)
+    {
+        if (*pattern == '*')
+        {
+            star      = ++pattern;
+            star_name = name;
+        }
+        else if (*pattern == '?' || *pattern == *name)
+        {
+            ++pattern;
+            ++name;
+        }
+        else if (star != NULL)
+        {
+            /* let the last '*' take one more character of the name, and try again */
+            pattern = star;
+            name    = ++star_name;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (*pattern == '*')
+    {
+        ++pattern;
+    }
+
+    return (*pattern == 0);
 }
 
 /*----------------------------------------------------------------
@@ -1794,81 +2251,242 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
  * See description in cf_cfdp.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+uint8 CF_CFDP_GetPlaybackPriority(const CF_Playback_t *pb, const char *name)
 {
-    CF_Transaction_t *txn;
-    os_dirent_t       dirent;
-    int32             status;
+    const CF_PlaybackPrio_t *rule;
+    uint8                    priority = pb->priority;
+    int                      i;
 
-    /* either there's no transaction (first one) or the last one was finished, so check for a new one */
+    for (i = 0; i < CF_MAX_PLAYBACK_PRIO_RULES; ++i)
+    {
+        rule = &CF_AppData.config_table->playback_prio[i];
+        if (rule->pattern[0] != 0 && CF_CFDP_MatchPattern(rule->pattern, name))
+        {
+            priority = rule->priority;
+            break;
+        }
+    }
+
+    return priority;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Adds a small file of a polling directory to the bundle of the playback.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_BundlePlaybackFile(CF_Playback_t *pb, const char *path, const char *name)
+{
+    os_fstat_t    st;
+    CF_FileSize_t file_max = CF_Bundle_FileMax(pb);
+    bool          bundled  = false;
+
+    if (file_max != 0 && OS_stat(path, &st) == OS_SUCCESS && st.FileSize <= file_max)
+    {
+        bundled = (CF_Bundle_Add(pb, path, name, st.FileSize, (uint32)OS_TimeGetTotalSeconds(st.FileTime)) ==
+                   CFE_SUCCESS);
+    }
+
+    return bundled;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads the next directory entry into the playback window.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_ReadPlaybackDir(CF_Playback_t *pb, uint8 order)
+{
+    CF_PlaybackFile_t *file;
+    os_dirent_t        dirent;
+    os_fstat_t         st;
+    int32              status;
+    char               path[CF_FILENAME_MAX_LEN];
 
     memset(&dirent, 0, sizeof(dirent));
 
-    while (pb->diropen && (pb->num_ts < CF_NUM_TRANSACTIONS_PER_PLAYBACK))
+    CFE_ES_PerfLogEntry(CF_PERF_ID_DIRREAD);
+    status = OS_DirectoryRead(pb->dir_id, &dirent);
+    CFE_ES_PerfLogExit(CF_PERF_ID_DIRREAD);
+
+    if (status != OS_SUCCESS)
     {
-        if (pb->pending_file[0] == 0)
+        /* PFTO: can we figure out the difference between "end of dir" and an error? */
+        OS_DirectoryClose(pb->dir_id);
+        pb->diropen = false;
+
+        if (pb->polled)
         {
-            CFE_ES_PerfLogEntry(CF_PERF_ID_DIRREAD);
-            status = OS_DirectoryRead(pb->dir_id, &dirent);
-            CFE_ES_PerfLogExit(CF_PERF_ID_DIRREAD);
+            CF_Bundle_EndScan(pb);
+        }
+    }
+    else if (strcmp(dirent.FileName, ".") != 0 && strcmp(dirent.FileName, "..") != 0)
+    {
+        snprintf(path,
+                 sizeof(path),
+                 "%.*s/%.*s",
+                 CF_FILENAME_MAX_PATH - 1,
+                 pb->fnames.src_filename,
+                 CF_FILENAME_MAX_NAME - 1,
+                 OS_DIRENTRY_NAME(dirent));
 
-            if (status != OS_SUCCESS)
-            {
-                /* PFTO: can we figure out the difference between "end of dir" and an error? */
-                OS_DirectoryClose(pb->dir_id);
-                pb->diropen = false;
-                break;
-            }
+        if (pb->polled && !CF_PollIdx_FileSettled(path))
+        {
+            /* the producer may still be writing it, pick it up on a later poll */
+            pb->rescan = true;
+        }
+        else if (!CF_CFDP_BundlePlaybackFile(pb, path, OS_DIRENTRY_NAME(dirent)))
+        {
+            file = &pb->window[pb->num_window];
+            memset(file, 0, sizeof(*file));
+            strncpy(file->name, OS_DIRENTRY_NAME(dirent), sizeof(file->name) - 1);
+            file->priority = CF_CFDP_GetPlaybackPriority(pb, file->name);
 
-            if (!strcmp(dirent.FileName, ".") || !strcmp(dirent.FileName, ".."))
+            /* a file that cannot be examined sorts first, the transfer reports the actual error */
+            if (order != CF_PlaybackOrder_DIR && OS_stat(path, &st) == OS_SUCCESS)
             {
-                continue;
+                file->mtime = (uint32)OS_TimeGetTotalSeconds(st.FileTime);
+                file->size  = st.FileSize;
             }
 
-            strncpy(pb->pending_file, OS_DIRENTRY_NAME(dirent), sizeof(pb->pending_file) - 1);
-            pb->pending_file[sizeof(pb->pending_file) - 1] = 0;
+            ++pb->num_window;
         }
-        else
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Picks the window entry to send next.  Ties keep directory order.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 CF_CFDP_PickPlaybackFile(const CF_Playback_t *pb, uint8 order)
+{
+    const CF_PlaybackFile_t *best = &pb->window[0];
+    const CF_PlaybackFile_t *file;
+    uint8                    best_idx = 0;
+    uint8                    i;
+
+    for (i = 1; i < pb->num_window; ++i)
+    {
+        file = &pb->window[i];
+        if (file->priority < best->priority ||
+            (file->priority == best->priority &&
+             ((order == CF_PlaybackOrder_OLDEST && file->mtime < best->mtime) ||
+              (order == CF_PlaybackOrder_SMALLEST && file->size < best->size))))
         {
+            best     = file;
+            best_idx = i;
+        }
+    }
+
+    return best_idx;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+{
+    CF_Transaction_t  *txn;
+    CF_PlaybackFile_t *file;
+    uint8              chan_num = (chan - CF_AppData.engine.channels);
+    uint8              order    = CF_AppData.config_table->chan[chan_num].playback_order;
+    uint8              idx;
+
+    /* either there's no transaction (first one) or the last one was finished, so check for a new one */
+
+    while (pb->num_ts < CF_NUM_TRANSACTIONS_PER_PLAYBACK && !CF_CFDP_BudgetSpent())
+    {
+        if (pb->bundle.ready)
+        {
+            /* a full bundle goes first, nothing more can be bundled until it is sent */
             txn = CF_FindUnusedTransaction(chan, CF_Direction_TX);
             if (txn == NULL)
             {
-                /* while not expected this can certainly happen, because
-                 * rx transactions consume in these as well. */
-                /* should not need to do anything special, will come back next tick */
                 break;
             }
 
-            snprintf(txn->history->fnames.src_filename,
-                     sizeof(txn->history->fnames.src_filename),
-                     "%.*s/%.*s",
-                     CF_FILENAME_MAX_PATH - 1,
-                     pb->fnames.src_filename,
-                     CF_FILENAME_MAX_NAME - 1,
-                     pb->pending_file);
-            snprintf(txn->history->fnames.dst_filename,
-                     sizeof(txn->history->fnames.dst_filename),
-                     "%.*s/%.*s",
-                     CF_FILENAME_MAX_PATH - 1,
-                     pb->fnames.dst_filename,
-                     CF_FILENAME_MAX_NAME - 1,
-                     pb->pending_file);
-
-            CF_CFDP_TxFile_Initiate(txn,
-                                    pb->cfdp_class,
-                                    pb->keep,
-                                    (chan - CF_AppData.engine.channels),
-                                    pb->priority,
-                                    pb->dest_id);
-
-            txn->pb = pb;
+            CF_Bundle_GetPath(pb,
+                              CF_AppData.config_table->tmp_dir,
+                              txn->history->fnames.src_filename,
+                              sizeof(txn->history->fnames.src_filename));
+            CF_Bundle_GetPath(pb,
+                              pb->fnames.dst_filename,
+                              txn->history->fnames.dst_filename,
+                              sizeof(txn->history->fnames.dst_filename));
+
+            CF_CFDP_TxFile_Initiate(txn, pb->cfdp_class, pb->keep, chan_num, pb->priority, pb->dest_id);
+
+            txn->flags.tx.bundle = true;
+            txn->pb              = pb;
+            txn->compress        = pb->compress;
             ++pb->num_ts;
 
-            pb->pending_file[0] = 0; /* continue reading dir */
+            CF_Bundle_Started(pb);
+            continue;
         }
+
+        if (pb->diropen && pb->num_window < CF_PLAYBACK_WINDOW_SIZE)
+        {
+            /* keep the window full, so there is a choice of which file goes next */
+            CF_CFDP_ReadPlaybackDir(pb, order);
+            continue;
+        }
+
+        if (pb->num_window == 0)
+        {
+            break;
+        }
+
+        txn = CF_FindUnusedTransaction(chan, CF_Direction_TX);
+        if (txn == NULL)
+        {
+            /* while not expected this can certainly happen, because
+             * rx transactions consume in these as well. */
+            /* should not need to do anything special, will come back next tick */
+            break;
+        }
+
+        idx  = CF_CFDP_PickPlaybackFile(pb, order);
+        file = &pb->window[idx];
+
+        snprintf(txn->history->fnames.src_filename,
+                 sizeof(txn->history->fnames.src_filename),
+                 "%.*s/%.*s",
+                 CF_FILENAME_MAX_PATH - 1,
+                 pb->fnames.src_filename,
+                 CF_FILENAME_MAX_NAME - 1,
+                 file->name);
+        snprintf(txn->history->fnames.dst_filename,
+                 sizeof(txn->history->fnames.dst_filename),
+                 "%.*s/%.*s",
+                 CF_FILENAME_MAX_PATH - 1,
+                 pb->fnames.dst_filename,
+                 CF_FILENAME_MAX_NAME - 1,
+                 file->name);
+
+        /* the file priority orders the transaction in the pending queue */
+        CF_CFDP_TxFile_Initiate(txn, pb->cfdp_class, pb->keep, chan_num, file->priority, pb->dest_id);
+
+        txn->pb       = pb;
+        txn->compress = pb->compress;
+        ++pb->num_ts;
+
+        /* close the gap, so the rest of the window stays in directory order */
+        --pb->num_window;
+        memmove(file, file + 1, (pb->num_window - idx) * sizeof(*file));
     }
 
-    if (!pb->diropen && !pb->num_ts)
+    if (!pb->diropen && !pb->num_ts && !pb->num_window && !pb->bundle.ready)
     {
         /* the directory has been exhausted, and there are no more active transactions
          * for this playback -- so mark it as not busy */
@@ -1907,11 +2525,21 @@ static void CF_CFDP_UpdatePollPbCounted(CF_Playback_t *pb, int up, uint8 *counte
  *-----------------------------------------------------------------*/
 static void CF_CFDP_ProcessPlaybackDirectories(CF_Channel_t *chan)
 {
+    int       n;
     int       i;
     const int chan_index = (chan - CF_AppData.engine.channels);
 
-    for (i = 0; i < CF_MAX_COMMANDED_PLAYBACK_DIRECTORIES_PER_CHAN; ++i)
+    for (n = 0; n < CF_MAX_COMMANDED_PLAYBACK_DIRECTORIES_PER_CHAN; ++n)
     {
+        i = (chan->playback_resume + n) % CF_MAX_COMMANDED_PLAYBACK_DIRECTORIES_PER_CHAN;
+
+        /* out of time, the directories not reached go first on the next wakeup */
+        if (CF_CFDP_BudgetSpent())
+        {
+            chan->playback_resume = i;
+            break;
+        }
+
         CF_CFDP_ProcessPlaybackDirectory(chan, &chan->playback[i]);
         CF_CFDP_UpdatePollPbCounted(&chan->playback[i],
                                     chan->playback[i].busy,
@@ -1930,13 +2558,23 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
     CF_Poll_t          *poll;
     CF_ChannelConfig_t *cc;
     CF_PollDir_t       *pd;
+    int                 n;
     int                 i;
     int                 chan_index;
     int                 count_check;
     int                 ret;
 
-    for (i = 0; i < CF_MAX_POLLING_DIR_PER_CHAN; ++i)
+    for (n = 0; n < CF_MAX_POLLING_DIR_PER_CHAN; ++n)
     {
+        i = (chan->poll_resume + n) % CF_MAX_POLLING_DIR_PER_CHAN;
+
+        /* out of time, the directories not reached go first on the next wakeup */
+        if (CF_CFDP_BudgetSpent())
+        {
+            chan->poll_resume = i;
+            break;
+        }
+
         poll        = &chan->poll[i];
         chan_index  = (chan - CF_AppData.engine.channels);
         cc          = &CF_AppData.config_table->chan[chan_index];
@@ -1953,6 +2591,11 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
                     CF_Timer_InitRelSec(&poll->interval_timer, pd->interval_sec);
                     poll->timer_set = true;
                 }
+                else if (CF_Timer_Expired(&poll->interval_timer) && CF_PollIdx_Unchanged(poll, pd))
+                {
+                    /* nothing was added since every file in the directory was sent, skip the scan */
+                    CF_Timer_InitRelSec(&poll->interval_timer, pd->interval_sec);
+                }
                 else if (CF_Timer_Expired(&poll->interval_timer))
                 {
                     /* the timer has expired */
@@ -1963,10 +2606,14 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
                                                        0,
                                                        chan_index,
                                                        pd->priority,
-                                                       pd->dest_eid);
+                                                       pd->dest_eid,
+                                                       pd->compress);
                     if (!ret)
                     {
-                        poll->timer_set = false;
+                        poll->timer_set          = false;
+                        poll->pb.bundle.chan_num = chan_index;
+                        poll->pb.bundle.poll_num = i;
+                        CF_PollIdx_BeginScan(poll);
                     }
                     else
                     {
@@ -1985,15 +2632,76 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
             {
                 /* playback is active, so step it */
                 CF_CFDP_ProcessPlaybackDirectory(chan, &poll->pb);
+                if (!poll->pb.busy)
+                {
+                    CF_PollIdx_EndScan(poll, pd);
+                }
             }
 
             count_check = 1;
         }
+        else if (poll->settled)
+        {
+            /* the directory may be different once polling is enabled again */
+            CF_PollIdx_Invalidate(poll);
+        }
 
         CF_CFDP_UpdatePollPbCounted(&poll->pb, count_check, &CF_AppData.hk.Payload.channel_hk[chan_index].poll_counter);
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_BudgetSpent(void)
+{
+    OS_time_t now;
+    uint32    budget_us = CF_AppData.config_table->wakeup_budget_us;
+
+    if (!CF_AppData.engine.budget_spent && budget_us != 0)
+    {
+        OS_GetLocalTime(&now);
+        if (OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, CF_AppData.engine.wakeup_start)) >= budget_us)
+        {
+            CF_AppData.engine.budget_spent = true;
+        }
+    }
+
+    return CF_AppData.engine.budget_spent;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reports the chunk lists of a channel that could not grow from its slab
+ * during the wakeup, in the fault counters and an event.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_CheckChunkSlab(uint8 chan_num)
+{
+    CF_ChunkSlab_t *slab = &CF_AppData.engine.channels[chan_num].chunk_slab;
+
+    if (slab->grow_fails != 0)
+    {
+        CF_AppData.hk.Payload.channel_hk[chan_num].counters.fault.chunk_slab_empty += slab->grow_fails;
+
+        if (CF_EvLim_Allow(CF_CFDP_CHUNK_SLAB_ERR_EID))
+        {
+            CFE_EVS_SendEvent(CF_CFDP_CHUNK_SLAB_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: channel %d chunk slab exhausted, %lu gaps merged or dropped",
+                              chan_num,
+                              (unsigned long)slab->grow_fails);
+        }
+
+        slab->grow_fails = 0;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -2003,29 +2711,92 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
 void CF_CFDP_CycleEngine(void)
 {
     CF_Channel_t *chan;
+    OS_time_t     cycle_start;
+    OS_time_t     mark;
+    int           next_first = -1;
+    int           n;
     int           i;
 
     if (CF_AppData.engine.enabled)
     {
-        for (i = 0; i < CF_NUM_CHANNELS; ++i)
+        CF_Diag_Mark(&cycle_start);
+        ++CF_AppData.engine.tick_count;
+
+        CF_AppData.engine.wakeup_start = cycle_start;
+        CF_AppData.engine.budget_spent = false;
+
+        /*
+         * When a wakeup runs out of time, the next one starts with the first
+         * channel that did not get its turn, so that the channels take turns
+         * rather than the last ones always being cut short.
+         */
+        for (n = 0; n < CF_NUM_CHANNELS; ++n)
         {
+            i    = (CF_AppData.engine.first_chan + n) % CF_NUM_CHANNELS;
             chan = &CF_AppData.engine.channels[i];
 
             chan->outgoing_counter = 0;
             chan->tx_blocked       = false;
 
             /* consume all received messages, even if channel is frozen */
+            CF_Diag_Mark(&mark);
             CF_CFDP_ReceiveMessage(chan);
+            CF_Diag_Lap(i, CF_DiagPhase_RECEIVE, &mark);
+
+            if (next_first < 0 && CF_CFDP_BudgetSpent())
+            {
+                /* none of the work of this channel was done */
+                next_first = i;
+            }
 
             if (!CF_AppData.hk.Payload.channel_hk[i].frozen)
             {
-                /* cycle all transactions (tick) */
+                /* cycle all transactions (tick), this times its own phases.
+                 * It is called even when out of time, to flush the output. */
                 CF_CFDP_TickTransactions(chan);
 
+                CF_Diag_Mark(&mark);
+                if (!CF_CFDP_BudgetSpent())
+                {
+                    CF_Spill_Tick(chan);
+                }
+                CF_Diag_Lap(i, CF_DiagPhase_RX_TICK, &mark);
+
                 CF_CFDP_ProcessPlaybackDirectories(chan);
+                CF_Diag_Lap(i, CF_DiagPhase_PLAYBACK, &mark);
                 CF_CFDP_ProcessPollingDirectories(chan);
+                CF_Diag_Lap(i, CF_DiagPhase_POLLING, &mark);
+            }
+
+            if (next_first < 0 && CF_AppData.engine.budget_spent)
+            {
+                /* this channel was cut short, it goes last on the next wakeup */
+                next_first = (i + 1) % CF_NUM_CHANNELS;
+            }
+
+            CF_CFDP_CheckChunkSlab(i);
+            CF_Diag_EndChannel(i);
+
+            /* a window of ticks_per_second wakeups is one second of output */
+            ++chan->out_ring.rate_ticks;
+            if (chan->out_ring.rate_ticks >= CF_AppData.config_table->ticks_per_second)
+            {
+                CF_AppData.hk.Payload.channel_hk[i].counters.sent.pdu_rate = chan->out_ring.rate_pdus;
+
+                chan->out_ring.rate_pdus  = 0;
+                chan->out_ring.rate_ticks = 0;
             }
         }
+
+        if (next_first >= 0)
+        {
+            CF_AppData.engine.first_chan = next_first;
+            ++CF_AppData.diag.pkt.Payload.yields;
+        }
+
+        CF_Journal_Tick();
+
+        CF_Diag_EndCycle(&cycle_start);
     }
 }
 
@@ -2062,6 +2833,7 @@ void CF_CFDP_FinishTransaction(CF_Transaction_t *txn, bool keep_history)
 
     if (txn->history != NULL)
     {
+        CF_TxnMetrics_Mark(&txn->history->metrics, &txn->history->metrics.end_ms);
         CF_CFDP_SendEotPkt(txn);
 
         /* extra bookkeeping for tx direction only */
@@ -2080,6 +2852,12 @@ void CF_CFDP_FinishTransaction(CF_Transaction_t *txn, bool keep_history)
         /* a playback's transaction is now done, decrement the playback counter */
         CF_Assert(txn->pb->num_ts);
         --txn->pb->num_ts;
+
+        /* a polled file that was not sent is still in the directory */
+        if (txn->history != NULL && CF_TxnStatus_IsError(txn->history->txn_stat))
+        {
+            txn->pb->rescan = true;
+        }
     }
 
     /* Put this transaction into the holdover state, inactivity timer will recycle it */
@@ -2123,6 +2901,8 @@ void CF_CFDP_RecycleTransaction(CF_Transaction_t *txn)
             chunklist_head = CF_GetChunkListHead(chan, txn->history->dir);
             if (chunklist_head != NULL)
             {
+                /* give the chunk blocks back to the channel slab before the list is reused */
+                CF_ChunkListReset(&txn->chunks->chunks);
                 CF_CList_InsertBack(chunklist_head, &txn->chunks->cl_node);
                 txn->chunks = NULL;
             }
@@ -2220,6 +3000,7 @@ void CF_CFDP_SendEotPkt(CF_Transaction_t *txn)
         EotPktPtr->Payload.seq_num    = txn->history->seq_num;
         EotPktPtr->Payload.fsize      = txn->fsize;
         EotPktPtr->Payload.crc_result = txn->crc.result;
+        EotPktPtr->Payload.metrics    = txn->history->metrics;
 
         /*
         ** Timestamp and send eod of transaction telemetry
@@ -2320,14 +3101,25 @@ void CF_CFDP_DisableEngine(void)
             if (chan->poll[j].pb.busy)
             {
                 OS_DirectoryClose(chan->poll[j].pb.dir_id);
+                CF_Bundle_Discard(&chan->poll[j].pb);
             }
         }
 
+        /* give back any output buffers still held */
+        CF_CFDP_ReleaseOutput(chan);
+
         /* finally all queue counters must be reset */
         memset(&CF_AppData.hk.Payload.channel_hk[i].q_size, 0, sizeof(CF_AppData.hk.Payload.channel_hk[i].q_size));
 
         CFE_SB_DeletePipe(chan->pipe);
     }
+
+    /* a checkpoint left half written is dropped, the previous journal stays in place */
+    if (CF_AppData.engine.checkpoint.busy)
+    {
+        CF_WrappedClose(CF_AppData.engine.checkpoint.fd);
+        CF_AppData.engine.checkpoint.busy = false;
+    }
 }
 
 /*----------------------------------------------------------------
@@ -27,16 +27,7 @@
 #define CF_CFDP_H
 
 #include "cf_cfdp_types.h"
-
-/**
- * @brief Structure for use with the CF_CFDP_DoTick() functions
- */
-typedef struct CF_CFDP_Tick_args
-{
-    CF_Channel_t           *chan;         /**< \brief channel structure */
-    const CF_Transaction_t *resume_point; /**< \brief skip to this txn (if not null) */
-    void (*fn)(CF_Transaction_t *);       /**< \brief function pointer */
-} CF_CFDP_Tick_args_t;
+#include "cf_tbldefs.h"
 
 /********************************************************************************/
 /**
@@ -216,14 +207,35 @@ bool CF_CFDP_CheckAckNakCount(CF_Transaction_t *txn, uint8 *counter);
  */
 void CF_CFDP_CompleteTick(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Computes the engine arena space needed by one channel.
+ *
+ * @par Description
+ *       Adds up the transaction, history, chunk and active set pools described
+ *       by the channel configuration, including alignment padding, exactly as
+ *       CF_CFDP_InitEngine() carves them.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       cc must not be NULL.  The result is 64 bits wide so that it cannot
+ *       overflow for any table values, which allows it to be used for validation.
+ *
+ * @param cc  Pointer to the channel configuration
+ *
+ * @returns Number of bytes of engine arena needed
+ */
+uint64 CF_CFDP_ChannelArenaSize(const CF_ChannelConfig_t *cc);
+
 /************************************************************************/
 /** @brief Initialization function for the CFDP engine
  *
  * @par Description
- *       Performs all initialization of the CFDP engine
+ *       Performs all initialization of the CFDP engine.  The transaction,
+ *       history and chunk pools of each channel are carved from the engine
+ *       arena, sized by that channel's configuration table entry.
  *
  * @par Assumptions, External Events, and Notes:
- *       Only called once.
+ *       Called at startup, and again whenever the engine is re-enabled, so
+ *       pool sizes follow the currently loaded configuration table.
  *
  * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
  * @returns anything else on error.
@@ -266,6 +278,7 @@ void CF_CFDP_DisableEngine(void);
  * @param chan          CF channel number to use
  * @param priority      CF priority level
  * @param dest_id       Entity ID of remote receiver
+ * @param compress      CF_Compress_t to apply to the file before it is sent
  *
  * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
  * @returns CFE_SUCCESS on success. CF_ERROR on error.
@@ -276,7 +289,8 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
                             uint8           keep,
                             uint8           chan,
                             uint8           priority,
-                            CF_EntityId_t   dest_id);
+                            CF_EntityId_t   dest_id,
+                            uint8           compress);
 
 /************************************************************************/
 /** @brief Begin transmit of a directory.
@@ -295,6 +309,7 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
  * @param chan          CF channel number to use
  * @param priority      CF priority level
  * @param dest_id       Entity ID of remote receiver
+ * @param compress      CF_Compress_t to apply to the file before it is sent
  *
  * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
  * @returns CFE_SUCCESS on success. CF_ERROR on error.
@@ -305,7 +320,8 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
                                  uint8           keep,
                                  uint8           chan,
                                  uint8           priority,
-                                 uint16          dest_id);
+                                 uint16          dest_id,
+                                 uint8           compress);
 
 /************************************************************************/
 /** @brief Build the PDU header in the output buffer to prepare to send a packet.
@@ -428,6 +444,36 @@ CFE_Status_t CF_CFDP_SendFin(CF_Transaction_t *txn);
  */
 void CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Build a Prompt PDU for transmit.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param response  Response the receiver is asked to send (NAK or Keep Alive)
+ *
+ * @returns CFE_Status_t status code
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_SEND_PDU_NO_BUF_AVAIL_ERROR if message buffer cannot be obtained.
+ */
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response);
+
+/************************************************************************/
+/** @brief Build a Keep Alive PDU for transmit.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param progress  Offset through which all file data has been received
+ *
+ * @returns CFE_Status_t status code
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_SEND_PDU_NO_BUF_AVAIL_ERROR if message buffer cannot be obtained.
+ */
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress);
+
 /************************************************************************/
 /** @brief Appends a single TLV value to the logical PDU data
  *
@@ -572,6 +618,42 @@ CFE_Status_t CF_CFDP_RecvFin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 CFE_Status_t CF_CFDP_RecvNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Unpack a Prompt PDU from a received message.
+ *
+ * This should only be invoked for buffers that have been identified
+ * as a prompt PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn    Pointer to the transaction state
+ * @param ph   The logical PDU buffer being received
+ *
+ * @returns integer status code
+ * @retval CFE_SUCCESS on success
+ * @retval CF_SHORT_PDU_ERROR on error
+ */
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
+/************************************************************************/
+/** @brief Unpack a Keep Alive PDU from a received message.
+ *
+ * This should only be invoked for buffers that have been identified
+ * as a keep alive PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn    Pointer to the transaction state
+ * @param ph   The logical PDU buffer being received
+ *
+ * @returns integer status code
+ * @retval CFE_SUCCESS on success
+ * @retval CF_SHORT_PDU_ERROR on error
+ */
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief Dispatch received packet to its handler.
  *
@@ -741,8 +823,7 @@ CF_CListTraverse_Status_t CF_CFDP_CloseFiles(CF_CListNode_t *node, void *context
 /************************************************************************/
 /** @brief Tick processor to send new file data
  *
- * This helper is used in conjunction with CF_CList_Traverse() as part
- * of Tick Processing.
+ * This helper is used by CF_CFDP_TickNewData() as part of Tick Processing.
  *
  * @par Description
  *
@@ -765,9 +846,10 @@ void CF_CFDP_S_Tick_NewData(CF_Transaction_t *txn);
 /** @brief Call R and then S tick functions for all active transactions.
  *
  * @par Description
- *       Traverses all transactions in the RX and TXW queues, and calls
- *       their tick functions. Note that the TXW queue is used twice:
+ *       Visits all transactions in the RX and TX active sets, and calls
+ *       their tick functions. Note that the TX set is used twice:
  *       once for regular tick processing, and one for NAK response.
+ *       New file data is then sent in TX queue priority order.
  *
  * @par Assumptions, External Events, and Notes:
  *       chan must not be NULL.
@@ -791,6 +873,25 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan);
  */
 void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb);
 
+/************************************************************************/
+/** @brief Gets the priority of a file found by a directory playback.
+ *
+ * @par Description
+ *       The first non-empty pattern of the playback priority map in the
+ *       configuration table that matches the file name gives the priority.
+ *       Patterns may use '*' for any run of characters and '?' for any
+ *       single character.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       pb must not be NULL, name must not be NULL.
+ *
+ * @param pb    The playback state
+ * @param name  Name of the file, without the directory
+ *
+ * @returns The priority of the matching rule, or the priority of the playback if none matches
+ */
+uint8 CF_CFDP_GetPlaybackPriority(const CF_Playback_t *pb, const char *name);
+
 /************************************************************************/
 /** @brief Kick the dir playback if timer elapsed.
  *
@@ -806,21 +907,54 @@ void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb);
 void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan);
 
 /************************************************************************/
-/** @brief List traversal function that calls a r or s tick function.
+/** @brief Run one tick pass over the active set of a channel.
  *
- * This helper is used in conjunction with CF_CList_Traverse().
+ * @par Description
+ *       Calls the R state tick (CF_TickState_RX_STATE), S state tick
+ *       (CF_TickState_TX_STATE) or S NAK tick (CF_TickState_TX_NAK) for
+ *       each non-suspended transaction in the matching active set, starting
+ *       at start_idx.  Stops early if the channel becomes TX blocked, or if
+ *       the wakeup runs out of time.
  *
  * @par Assumptions, External Events, and Notes:
- *       node must not be NULL, context must not be NULL.
+ *       chan must not be NULL.
  *
- * @param node    Pointer to list node
- * @param context Pointer to CF_CFDP_Tick_args_t object (passed through)
+ * @param chan        Channel to tick
+ * @param tick_state  Which tick pass to run
+ * @param start_idx   Active set position to start from (0 for a full pass)
+ */
+void CF_CFDP_TickActiveSet(CF_Channel_t *chan, CF_TickState_t tick_state, uint32 start_idx);
+
+/************************************************************************/
+/** @brief Run the new file data tick pass on a channel.
  *
- * @returns integer traversal code
- * @retval CF_CLIST_EXIT when it's found, which terminates list traversal
- * @retval CF_CLIST_CONT when it's isn't found, which causes list traversal to continue
+ * @par Description
+ *       Calls CF_CFDP_S_Tick_NewData() for each non-suspended transaction
+ *       on the TX queue in priority order, until the channel becomes TX blocked
+ *       or the wakeup runs out of time.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan  Channel to tick
+ */
+void CF_CFDP_TickNewData(CF_Channel_t *chan);
+
+/************************************************************************/
+/** @brief Checks if the current wakeup used up its time budget.
+ *
+ * @par Description
+ *       Compares the time since the start of the wakeup with the
+ *       wakeup_budget_us of the configuration table.  Once the budget is
+ *       used up this keeps returning true until the next wakeup, so that
+ *       work stopped in one phase is not started again in a later one.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       A budget of 0 is never used up.
+ *
+ * @returns true if no more work should be started in this wakeup
  */
-CF_CListTraverse_Status_t CF_CFDP_DoTick(CF_CListNode_t *node, void *context);
+bool CF_CFDP_BudgetSpent(void);
 
 /************************************************************************/
 /** @brief Get move target
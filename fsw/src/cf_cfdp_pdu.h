@@ -322,6 +322,37 @@ typedef struct CF_CFDP_PduAck
     CF_CFDP_uint8_t cc_and_transaction_status;
 } CF_CFDP_PduAck_t;
 
+/**
+ * @brief Values for the response required field in a Prompt PDU
+ *
+ * Defined per section 5.2.7 / table 5-12 of CCSDS 727.0-B-5
+ */
+typedef enum
+{
+    CF_CFDP_PromptResponse_NAK        = 0,
+    CF_CFDP_PromptResponse_KEEP_ALIVE = 1,
+} CF_CFDP_PromptResponse_t;
+
+/**
+ * @brief Structure representing CFDP Prompt PDU
+ *
+ * Defined per section 5.2.7 / table 5-12 of CCSDS 727.0-B-5
+ */
+typedef struct CF_CFDP_PduPrompt
+{
+    CF_CFDP_uint8_t flags;
+} CF_CFDP_PduPrompt_t;
+
+/**
+ * @brief Structure representing CFDP Keep Alive PDU
+ *
+ * Defined per section 5.2.8 / table 5-13 of CCSDS 727.0-B-5
+ */
+typedef struct CF_CFDP_PduKeepAlive
+{
+    CF_CFDP_uint32_t progress;
+} CF_CFDP_PduKeepAlive_t;
+
 /**
  * @brief Structure representing CFDP Segment Request
  *
@@ -33,6 +33,10 @@
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_dispatch.h"
+#include "cf_bundle.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_rtt.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -59,6 +63,7 @@ CFE_Status_t CF_CFDP_R_CheckCrc(CF_Transaction_t *txn)
                           (unsigned long)txn->crc.result,
                           (unsigned long)txn->state_data.eof_crc);
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.crc_mismatch;
+        CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_CRC_MISMATCH, 1);
         ret = CF_ERROR;
     }
     else
@@ -127,14 +132,17 @@ CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *
         fret = CF_WrappedLseek(txn->fd, fd->offset, OS_SEEK_SET);
         if (fret != fd->offset)
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_SEEK_FD_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): failed to seek offset %ld, got %ld",
-                              CF_CFDP_GetPrintClass(txn),
-                              (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num,
-                              (long)fd->offset,
-                              (long)fret);
+            if (CF_EvLim_Allow(CF_CFDP_R_SEEK_FD_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_SEEK_FD_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): failed to seek offset %ld, got %ld",
+                                  CF_CFDP_GetPrintClass(txn),
+                                  (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num,
+                                  (long)fd->offset,
+                                  (long)fret);
+            }
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
             ret = CF_ERROR; /* connection will reset in caller */
@@ -150,14 +158,17 @@ CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *
         fret = CF_WrappedWrite(txn->fd, fd->data_ptr, fd->data_len);
         if (fret != fd->data_len)
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_WRITE_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): OS_write expected %ld, got %ld",
-                              CF_CFDP_GetPrintClass(txn),
-                              (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num,
-                              (long)fd->data_len,
-                              (long)fret);
+            if (CF_EvLim_Allow(CF_CFDP_R_WRITE_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_WRITE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): OS_write expected %ld, got %ld",
+                                  CF_CFDP_GetPrintClass(txn),
+                                  (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num,
+                                  (long)fd->data_len,
+                                  (long)fret);
+            }
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
             ret = CF_ERROR; /* connection will reset in caller */
@@ -166,15 +177,59 @@ CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *
         {
             txn->state_data.cached_pos                                                     = fd->data_len + fd->offset;
             CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes += fd->data_len;
+            txn->history->metrics.fd_bytes += fd->data_len;
+            CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_BYTES_RECV, fd->data_len);
 
             /* insert gap data in chunks */
             CF_ChunkListAdd(&txn->chunks->chunks, fd->offset, fd->data_len);
+            if (txn->chunks != NULL && txn->chunks->chunks.count > txn->history->metrics.peak_chunks)
+            {
+                txn->history->metrics.peak_chunks = txn->chunks->chunks.count;
+            }
+
+            if (txn->reliable_mode)
+            {
+                CF_CFDP_R2_UpdateNakTimer(txn, fd);
+            }
         }
     }
 
     return ret;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_UpdateNakTimer(CF_Transaction_t *txn, const CF_Logical_PduFileDataHeader_t *fd)
+{
+    const CF_ChannelConfig_t *cc = &CF_AppData.config_table->chan[txn->chan_num];
+
+    /* after EOF the gap check in the DATA_EOF state owns NAK generation */
+    if (txn->state_data.sub_state == CF_RxSubState_DATA_NORMAL && !txn->flags.rx.nak_timer_armed)
+    {
+        if (cc->nak_mode == CF_NakMode_ASYNC)
+        {
+            CF_Timer_InitRelTicks(&txn->nak_timer, CF_Rtt_GetTimeout(txn, cc->nak_timer_s));
+            txn->flags.rx.nak_timer_armed = true;
+        }
+        else if (cc->nak_mode == CF_NakMode_IMMEDIATE && fd->offset > txn->state_data.rx_progress)
+        {
+            /* data skipped ahead, so a new gap opened in front of it.  Give reordered
+             * PDUs the reorder delay to fill it before asking for a retransmit. */
+            CF_Timer_InitRelTicks(&txn->nak_timer, cc->nak_reorder_ticks);
+            txn->flags.rx.nak_timer_armed = true;
+        }
+    }
+
+    if ((fd->offset + fd->data_len) > txn->state_data.rx_progress)
+    {
+        txn->state_data.rx_progress = fd->offset + fd->data_len;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -202,6 +257,7 @@ void CF_CFDP_R_SubstateRecvEof(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph
             txn->state_data.peer_cc = eof->cc;
 
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_From_ConditionCode(eof->cc));
+            CF_TxnMetrics_Mark(&txn->history->metrics, &txn->history->metrics.eof_ms);
         }
 
         if (!CF_CFDP_CheckAckNakCount(txn, &txn->flags.rx.eof_count))
@@ -249,10 +305,11 @@ void CF_CFDP_R_SubstateRecvFileData(CF_Transaction_t *txn, CF_Logical_PduBuffer_
         /* All new file data will reset the NAK counter.  if we are post-EOF
          * then all additional PDUs are presumed to be the result of a NAK.
          * If we are pre-EOF then it is irrelevant, this is benign because
-         * nothing is ack/nak'd until after EOF anyway. Note it would be more
+         * pre-EOF NAKs do not count against the NAK limit. Note it would be more
          * correct/sophisticated to check if the ChunkListAdd above actually
          * filled a hole in the file.  But this is good enough. */
         txn->state_data.acknak_count = 0;
+        CF_Rtt_Stop(txn);
     }
 }
 
@@ -304,6 +361,7 @@ CFE_Status_t CF_CFDP_R_SendNak(CF_Transaction_t *txn)
                                                             txn->history->seq_num,
                                                             1);
     CF_Logical_PduNak_t    *nak;
+    CF_FileSize_t           total;
     uint32                  cret;
     CFE_Status_t            ret;
 
@@ -325,12 +383,15 @@ CFE_Status_t CF_CFDP_R_SendNak(CF_Transaction_t *txn)
             /* we have metadata, so send valid NAK */
             CF_GapComputeArgs_t args = { txn, nak };
 
+            /* before EOF only the data up to the furthest offset received can be known missing */
+            total = (txn->state_data.sub_state == CF_RxSubState_DATA_NORMAL) ? txn->state_data.rx_progress : txn->fsize;
+
             cret = CF_ChunkList_ComputeGaps(&txn->chunks->chunks,
                                             (txn->chunks->chunks.count < txn->chunks->chunks.max_chunks)
                                                 ? txn->chunks->chunks.max_chunks
                                                 : (txn->chunks->chunks.max_chunks - 1),
 
-                                            txn->fsize,
+                                            total,
                                             0,
                                             CF_CFDP_R2_GapCompute,
                                             &args);
@@ -350,7 +411,16 @@ CFE_Status_t CF_CFDP_R_SendNak(CF_Transaction_t *txn)
             {
                 CF_CFDP_SendNak(txn, ph);
 
+                /* after EOF all file data is retransmitted, so the first of it answers this NAK */
+                if (txn->state_data.sub_state != CF_RxSubState_DATA_NORMAL)
+                {
+                    CF_Rtt_Start(txn, txn->state_data.acknak_count != 0);
+                }
+
                 CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.nak_segment_requests += cret;
+                ++txn->history->metrics.nak_rounds;
+                txn->history->metrics.nak_segments += cret;
+                CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_NAK_SEGS_SENT, cret);
             }
         }
         else
@@ -372,6 +442,9 @@ CFE_Status_t CF_CFDP_R_SendNak(CF_Transaction_t *txn)
             nak->segment_list.num_segments             = 1;
 
             CF_CFDP_SendNak(txn, ph);
+            ++txn->history->metrics.nak_rounds;
+            ++txn->history->metrics.nak_segments;
+            CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_NAK_SEGS_SENT, 1);
         }
     }
 
@@ -387,7 +460,7 @@ CFE_Status_t CF_CFDP_R_SendNak(CF_Transaction_t *txn)
 void CF_CFDP_R_Init(CF_Transaction_t *txn)
 {
     int32 ret;
-    char  TempName[CFE_MISSION_MAX_FILE_LEN];
+    char  TempName[CFE_MISSION_MAX_PATH_LEN];
 
     /* set default FIN status */
     txn->state_data.fin_dc = CF_CFDP_FinDeliveryCode_INVALID;
@@ -456,13 +529,16 @@ void CF_CFDP_R_CalcCrcStart(CF_Transaction_t *txn)
         OsStatus = CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET);
         if (OsStatus != 0)
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_SEEK_CRC_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): failed to seek offset 0, got %ld",
-                              CF_CFDP_GetPrintClass(txn),
-                              (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num,
-                              (long)OsStatus);
+            if (CF_EvLim_Allow(CF_CFDP_R_SEEK_CRC_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_SEEK_CRC_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): failed to seek offset 0, got %ld",
+                                  CF_CFDP_GetPrintClass(txn),
+                                  (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num,
+                                  (long)OsStatus);
+            }
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
 
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
@@ -512,14 +588,17 @@ void CF_CFDP_R_CalcCrcChunk(CF_Transaction_t *txn)
         fret = CF_WrappedRead(txn->fd, buf, read_size);
         if (fret != read_size)
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_READ_ERR_EID,
-                              CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): failed to read file expected %lu, got %ld",
-                              CF_CFDP_GetPrintClass(txn),
-                              (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num,
-                              (unsigned long)read_size,
-                              (long)fret);
+            if (CF_EvLim_Allow(CF_CFDP_R_READ_ERR_EID))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_READ_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): failed to read file expected %lu, got %ld",
+                                  CF_CFDP_GetPrintClass(txn),
+                                  (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num,
+                                  (unsigned long)read_size,
+                                  (long)fret);
+            }
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
             success = false;
@@ -548,6 +627,33 @@ void CF_CFDP_R_CalcCrcChunk(CF_Transaction_t *txn)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_SubstateRecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    if (CF_CFDP_RecvPrompt(txn, ph) == CFE_SUCCESS)
+    {
+        CF_TRACE("%s(): Recv PROMPT, response=%d\n", __func__, (int)ph->int_header.prompt.response_required);
+
+        if (ph->int_header.prompt.response_required == CF_CFDP_PromptResponse_KEEP_ALIVE)
+        {
+            txn->flags.rx.send_keep_alive = true;
+        }
+        else
+        {
+            txn->flags.rx.send_nak = true;
+        }
+    }
+    else
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -611,6 +717,12 @@ void CF_CFDP_R_SubstateRecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         if (status == CFE_SUCCESS)
         {
             txn->flags.rx.md_recv = true;
+
+            /* the sender only sends the blocks that changed from the file this already has */
+            if (txn->reliable_mode && CF_Delta_GetMd(&ph->int_header.md))
+            {
+                CF_Delta_PrefillStart(txn);
+            }
         }
     }
 }
@@ -644,7 +756,8 @@ void CF_CFDP_R2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
     static const CF_CFDP_FileDirectiveDispatchTable_t r2_fdir_handlers_normal = {
         .fdirective = { [CF_CFDP_FileDirective_EOF]      = CF_CFDP_R_SubstateRecvEof,
-                       [CF_CFDP_FileDirective_METADATA] = CF_CFDP_R_SubstateRecvMd }
+                       [CF_CFDP_FileDirective_METADATA] = CF_CFDP_R_SubstateRecvMd,
+                       [CF_CFDP_FileDirective_PROMPT]   = CF_CFDP_R2_SubstateRecvPrompt }
     };
     static const CF_CFDP_FileDirectiveDispatchTable_t r2_fdir_handlers_done = {
         .fdirective = {
@@ -660,6 +773,7 @@ void CF_CFDP_R2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         .state = { [CF_RxSubState_DATA_NORMAL] = &r2_fdir_handlers_normal,
                   [CF_RxSubState_DATA_EOF]    = &r2_fdir_handlers_normal,
                   [CF_RxSubState_VALIDATE]    = &r2_fdir_handlers_done,
+                  [CF_RxSubState_EXPAND]      = &r2_fdir_handlers_done,
                   [CF_RxSubState_FILESTORE]   = &r2_fdir_handlers_done,
                   [CF_RxSubState_FINACK]      = &r2_fdir_handlers_finack,
                   [CF_RxSubState_COMPLETE]    = &r2_fdir_handlers_finack }
@@ -693,6 +807,7 @@ void CF_CFDP_R_HandleFileRetention(CF_Transaction_t *txn)
      *   - If the file transfer is unsuccessful then the temp file is deleted.
      */
     char        TempName[CFE_MISSION_MAX_PATH_LEN];
+    char        RawName[CFE_MISSION_MAX_PATH_LEN];
     const char *SubjectFile;
     const char *MoveDest;
     int32       OsStatus;
@@ -747,10 +862,38 @@ void CF_CFDP_R_HandleFileRetention(CF_Transaction_t *txn)
         {
             /* mark it with checksum failure (this will not overwrite an existing error status) */
             CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_CHECKSUM_FAILURE);
+
+            if (txn->compress != CF_Compress_NONE)
+            {
+                /* a decompression that failed or was canceled leaves part of the original behind */
+                CF_Compress_GetTempName(txn->history, CF_COMPRESS_RX_SUFFIX, RawName, sizeof(RawName));
+                OS_remove(RawName);
+            }
         }
         else
         {
-            OsStatus = OS_mv(SubjectFile, MoveDest);
+            if (txn->compress != CF_Compress_NONE)
+            {
+                /* the sender compressed the file, the original written by the EXPAND sub-state is stored */
+                OS_remove(SubjectFile);
+                CF_Compress_GetTempName(txn->history, CF_COMPRESS_RX_SUFFIX, RawName, sizeof(RawName));
+                SubjectFile = RawName;
+            }
+
+            if (CF_Bundle_IsBundle(MoveDest))
+            {
+                /* the files of a bundle are stored on their own, the bundle itself is not kept */
+                OsStatus = CF_Bundle_Unpack(txn, SubjectFile, MoveDest);
+                if (OsStatus == CFE_SUCCESS)
+                {
+                    OS_remove(SubjectFile);
+                }
+            }
+            else
+            {
+                OsStatus = OS_mv(SubjectFile, MoveDest);
+            }
+
             if (OsStatus == OS_SUCCESS)
             {
                 /* we also put the good file into the correct spot */
@@ -842,6 +985,53 @@ void CF_CFDP_R_AckTimerTick(CF_Transaction_t *txn)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R_NakTimerTick(CF_Transaction_t *txn)
+{
+    const CF_ChannelConfig_t *cc;
+
+    /* note: the NAK timer is only ever armed on class 2 */
+    if (!txn->reliable_mode || !txn->flags.rx.nak_timer_armed)
+    {
+        /* nothing to do */
+        return;
+    }
+
+    if (txn->state_data.sub_state != CF_RxSubState_DATA_NORMAL)
+    {
+        /* EOF arrived, the DATA_EOF gap check takes over from here */
+        txn->flags.rx.nak_timer_armed = false;
+    }
+    else if (!CF_Timer_Expired(&txn->nak_timer))
+    {
+        CF_Timer_Tick(&txn->nak_timer);
+    }
+    else
+    {
+        cc = &CF_AppData.config_table->chan[txn->chan_num];
+
+        /* only NAK if something below the receive progress is still missing */
+        if (CF_ChunkList_ComputeGaps(&txn->chunks->chunks, 1, txn->state_data.rx_progress, 0, NULL, NULL) != 0)
+        {
+            txn->flags.rx.send_nak = true;
+        }
+
+        if (cc->nak_mode == CF_NakMode_ASYNC)
+        {
+            CF_Timer_InitRelTicks(&txn->nak_timer, CF_Rtt_GetTimeout(txn, cc->nak_timer_s));
+        }
+        else
+        {
+            txn->flags.rx.nak_timer_armed = false;
+        }
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Local Helper function for R state machine
@@ -851,9 +1041,15 @@ CF_RxSubState_t CF_CFDP_R_CheckState_DATA_NORMAL(CF_Transaction_t *txn)
 {
     CF_RxSubState_t next_state = txn->state_data.sub_state;
 
+    /* a delta transfer copies the existing file a few blocks per wakeup, its blocks are not missing */
+    if (txn->flags.rx.prefill && CF_CFDP_TxnIsOK(txn))
+    {
+        CF_Delta_PrefillStep(txn);
+    }
+
     /* The "normal" data state just waits for PDUs to come in and collects them, nothing
      * really happens until we get the EOF from the remote */
-    if (txn->flags.rx.eof_count != 0)
+    if (txn->flags.rx.eof_count != 0 && !txn->flags.rx.prefill)
     {
         /* we got EOF, do gap check tasks */
         next_state = CF_RxSubState_DATA_EOF;
@@ -919,10 +1115,28 @@ CF_RxSubState_t CF_CFDP_R_CheckState_VALIDATE(CF_Transaction_t *txn)
     CF_RxSubState_t next_state = txn->state_data.sub_state;
 
     /* locally computing the CRC */
-    if (!CF_CFDP_TxnIsOK(txn) || txn->state_data.cached_pos == txn->fsize)
+    if (!CF_CFDP_TxnIsOK(txn))
     {
         next_state = CF_RxSubState_FILESTORE;
     }
+    else if (txn->state_data.cached_pos == txn->fsize)
+    {
+        if (txn->flags.rx.delta && txn->crc.result != txn->state_data.eof_crc)
+        {
+            /* the copied blocks were not what the sender had, get the whole file instead */
+            CF_Delta_Restart(txn);
+            next_state = CF_RxSubState_DATA_EOF;
+        }
+        else if (txn->compress != CF_Compress_NONE && txn->crc.result == txn->state_data.eof_crc)
+        {
+            /* a good compressed file, the original is written before it is stored */
+            next_state = CF_RxSubState_EXPAND;
+        }
+        else
+        {
+            next_state = CF_RxSubState_FILESTORE;
+        }
+    }
     else
     {
         CF_CFDP_R_CalcCrcChunk(txn);
@@ -931,6 +1145,24 @@ CF_RxSubState_t CF_CFDP_R_CheckState_VALIDATE(CF_Transaction_t *txn)
     return next_state;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Local Helper function for R state machine
+ *
+ *-----------------------------------------------------------------*/
+CF_RxSubState_t CF_CFDP_R_CheckState_EXPAND(CF_Transaction_t *txn)
+{
+    CF_RxSubState_t next_state = txn->state_data.sub_state;
+
+    /* decompressing the file a few blocks at a time, any failure is sorted out when it is retained */
+    if (!CF_CFDP_TxnIsOK(txn) || CF_Compress_ExpandStep(txn))
+    {
+        next_state = CF_RxSubState_FILESTORE;
+    }
+
+    return next_state;
+}
+
 /*----------------------------------------------------------------
  *
  * Local Helper function for R state machine
@@ -1024,6 +1256,10 @@ void CF_CFDP_R_CheckState(CF_Transaction_t *txn)
             next_state = CF_CFDP_R_CheckState_VALIDATE(txn);
             break;
 
+        case CF_RxSubState_EXPAND: /* decompressing the file */
+            next_state = CF_CFDP_R_CheckState_EXPAND(txn);
+            break;
+
         case CF_RxSubState_FILESTORE:
             next_state = CF_CFDP_R_CheckState_FILESTORE(txn);
             break;
@@ -1059,6 +1295,10 @@ void CF_CFDP_R_CheckState(CF_Transaction_t *txn)
             case CF_RxSubState_VALIDATE:
                 CF_CFDP_R_CalcCrcStart(txn);
                 break;
+            case CF_RxSubState_EXPAND:
+                /* on failure the status is set, the next tick goes on to FILESTORE */
+                CF_Compress_ExpandStart(txn);
+                break;
             case CF_RxSubState_FINACK:
                 txn->state_data.acknak_count = 0;
                 /* Send an initial FIN (note R1 may request a FIN, this is the only time R1 has a reply) */
@@ -1082,9 +1322,11 @@ void CF_CFDP_R_CheckState(CF_Transaction_t *txn)
  *-----------------------------------------------------------------*/
 void CF_CFDP_R_Tick_Maintenance(CF_Transaction_t *txn)
 {
-    CFE_Status_t sret;
+    const CF_Chunk_t *chunk;
+    CF_FileSize_t     progress;
+    CFE_Status_t      sret;
 
-    /* rx maintenance: possibly process send_eof_ack, send_nak or send_fin */
+    /* rx maintenance: possibly process send_eof_ack, send_nak, send_keep_alive or send_fin */
     if (txn->reliable_mode && txn->flags.rx.eof_ack_count != txn->flags.rx.eof_count)
     {
         sret = CF_CFDP_SendAck(txn, CF_CFDP_FileDirective_EOF);
@@ -1095,14 +1337,27 @@ void CF_CFDP_R_Tick_Maintenance(CF_Transaction_t *txn)
             txn->flags.rx.eof_ack_count = txn->flags.rx.eof_count;
         }
     }
-    else if (txn->flags.rx.send_nak)
+    else if (txn->flags.rx.send_nak && !txn->flags.rx.prefill)
     {
+        /* held while the existing file is copied, the gaps are worked out when it goes */
         sret = CF_CFDP_R_SendNak(txn);
         if (sret == CFE_SUCCESS)
         {
             txn->flags.rx.send_nak = false;
         }
     }
+    else if (txn->flags.rx.send_keep_alive)
+    {
+        /* progress is the end of the data held contiguously from the start of the file */
+        chunk    = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+        progress = (chunk != NULL && chunk->offset == 0) ? chunk->size : 0;
+
+        sret = CF_CFDP_SendKeepAlive(txn, progress);
+        if (sret == CFE_SUCCESS)
+        {
+            txn->flags.rx.send_keep_alive = false;
+        }
+    }
     else if (txn->flags.rx.send_fin)
     {
         sret = CF_CFDP_SendFin(txn);
@@ -1153,6 +1408,7 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn)
                                   (unsigned long)txn->history->src_eid,
                                   (unsigned long)txn->history->seq_num);
                 ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.inactivity_timer;
+                CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_INACTIVITY, 1);
 
                 CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_INACTIVITY_DETECTED);
             }
@@ -1163,6 +1419,7 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn)
     if (CurrStatus == CF_CFDP_AckTxnStatus_ACTIVE)
     {
         CF_CFDP_R_AckTimerTick(txn);
+        CF_CFDP_R_NakTimerTick(txn);
         CF_CFDP_R_CheckState(txn);
     }
 
@@ -79,6 +79,23 @@ void CF_CFDP_R2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 void CF_CFDP_R_AckTimerTick(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Perform pre-EOF NAK timer tick processing for R transactions.
+ *
+ * @par Description
+ *       When the NAK timer expires before EOF and any gap remains below the
+ *       receive progress, a NAK is scheduled for those gaps.  In async NAK
+ *       mode the timer is then re-armed for another NAK period.  Once EOF has
+ *       been received the timer is dropped and the normal NAK handling applies.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ */
+void CF_CFDP_R_NakTimerTick(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Perform tick (time-based) processing for R transactions.
  *
@@ -155,6 +172,24 @@ bool CF_CFDP_R_CheckComplete(CF_Transaction_t *txn);
  */
 CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Track receive progress and arm the pre-EOF NAK timer for R2.
+ *
+ * @par Description
+ *       Called for every file data PDU written to the file.  In immediate NAK
+ *       mode, data landing past the furthest offset seen so far opens a new gap,
+ *       which arms the NAK timer for the channel reorder delay.  In async NAK
+ *       mode, the first data received arms the timer for the NAK period.
+ *       The receive progress is advanced in every mode.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. fd must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param fd   Pointer to the file data header that was just written
+ */
+void CF_CFDP_R2_UpdateNakTimer(CF_Transaction_t *txn, const CF_Logical_PduFileDataHeader_t *fd);
+
 /************************************************************************/
 /** @brief Processing receive EOF common functionality for R1/R2.
  *
@@ -264,6 +299,21 @@ void CF_CFDP_R_CalcCrcStart(CF_Transaction_t *txn);
  */
 void CF_CFDP_R2_SubstateRecvFinAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Process receive Prompt PDU.
+ *
+ * @par Description
+ *       Schedules the response the sender asked for: a Keep Alive
+ *       reporting receive progress, or a NAK for the gaps found so far.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. ph must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param ph Pointer to the PDU information
+ */
+void CF_CFDP_R2_SubstateRecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief Substate function to receive an MD
  *
@@ -35,6 +35,10 @@
 
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_dispatch.h"
+#include "cf_bundle.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_rtt.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -110,14 +114,17 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
             status = CF_WrappedLseek(txn->fd, foffs, OS_SEEK_SET);
             if (status != foffs)
             {
-                CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID,
-                                  CFE_EVS_EventType_ERROR,
-                                  "CF S%d(%lu:%lu): error seeking to offset %ld, got %ld",
-                                  CF_CFDP_GetPrintClass(txn),
-                                  (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num,
-                                  (long)foffs,
-                                  (long)status);
+                if (CF_EvLim_Allow(CF_CFDP_S_SEEK_FD_ERR_EID))
+                {
+                    CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID,
+                                      CFE_EVS_EventType_ERROR,
+                                      "CF S%d(%lu:%lu): error seeking to offset %ld, got %ld",
+                                      CF_CFDP_GetPrintClass(txn),
+                                      (unsigned long)txn->history->src_eid,
+                                      (unsigned long)txn->history->seq_num,
+                                      (long)foffs,
+                                      (long)status);
+                }
                 ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
                 ret = CF_ERROR;
             }
@@ -132,14 +139,17 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
             status = CF_WrappedRead(txn->fd, data_ptr, actual_bytes);
             if (status != actual_bytes)
             {
-                CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID,
-                                  CFE_EVS_EventType_ERROR,
-                                  "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
-                                  CF_CFDP_GetPrintClass(txn),
-                                  (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num,
-                                  (long)actual_bytes,
-                                  (long)status);
+                if (CF_EvLim_Allow(CF_CFDP_S_READ_ERR_EID))
+                {
+                    CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID,
+                                      CFE_EVS_EventType_ERROR,
+                                      "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                                      CF_CFDP_GetPrintClass(txn),
+                                      (unsigned long)txn->history->src_eid,
+                                      (unsigned long)txn->history->seq_num,
+                                      (long)actual_bytes,
+                                      (long)status);
+                }
                 ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
                 ret = CF_ERROR;
             }
@@ -154,6 +164,8 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
             CF_CFDP_SendFd(txn, ph); /* CF_CFDP_SendFd only returns CFE_SUCCESS */
 
             CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes += actual_bytes;
+            txn->history->metrics.fd_bytes += actual_bytes;
+            CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_BYTES_SENT, actual_bytes);
             if (calc_crc)
             {
                 CF_CRC_Digest(&txn->crc, fd->data_ptr, fd->data_len);
@@ -316,6 +328,13 @@ void CF_CFDP_S2_SubstateNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
         CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests +=
             nak->segment_list.num_segments;
+        ++txn->history->metrics.nak_rounds;
+        txn->history->metrics.nak_segments += nak->segment_list.num_segments;
+        CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_NAK_SEGS_RECV, nak->segment_list.num_segments);
+        if (txn->chunks != NULL && txn->chunks->chunks.count > txn->history->metrics.peak_chunks)
+        {
+            txn->history->metrics.peak_chunks = txn->chunks->chunks.count;
+        }
         if (bad_sr)
         {
             CFE_EVS_SendEvent(CF_CFDP_S_INVALID_SR_ERR_EID,
@@ -339,6 +358,47 @@ void CF_CFDP_S2_SubstateNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_SubstateKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    const CF_Logical_PduKeepAlive_t *ka;
+    const CF_Chunk_t                *chunk;
+    CF_ChunkSize_t                   trim;
+
+    /* this function is only invoked for KEEP ALIVE PDU types */
+    if (CF_CFDP_RecvKeepAlive(txn, ph) == CFE_SUCCESS && ph->int_header.keep_alive.progress <= txn->fsize)
+    {
+        ka = &ph->int_header.keep_alive;
+        CF_TRACE("%s(): Recv KEEP ALIVE, progress=%lu\n", __func__, (unsigned long)ka->progress);
+
+        txn->flags.tx.keep_alive_pending = false;
+
+        if (ka->progress > txn->state_data.peer_progress)
+        {
+            txn->state_data.peer_progress = ka->progress;
+
+            /* a NAK that crossed with the receiver catching up may still be queued for
+             * data it now has, so drop anything below the progress point */
+            chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+            while (chunk != NULL && chunk->offset < ka->progress)
+            {
+                trim = ka->progress - chunk->offset;
+                CF_ChunkList_RemoveFromFirst(&txn->chunks->chunks, trim);
+                chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+            }
+        }
+    }
+    else
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -358,6 +418,7 @@ void CF_CFDP_S2_SubstateEofAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph
         if (ack->ack_directive_code == CF_CFDP_FileDirective_EOF)
         {
             txn->flags.tx.eof_ack_recv = true;
+            CF_Rtt_Stop(txn);
         }
 
         CF_TRACE("%s(): Recv ACK, dir_code=%d, cc=%d, st=%d\n",
@@ -410,13 +471,15 @@ void CF_CFDP_S1_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 void CF_CFDP_S2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_normal = {
-        .fdirective = { [CF_CFDP_FileDirective_FIN] = CF_CFDP_S_SubstateEarlyFin,
-                       [CF_CFDP_FileDirective_NAK] = CF_CFDP_S2_SubstateNak }
+        .fdirective = { [CF_CFDP_FileDirective_FIN]        = CF_CFDP_S_SubstateEarlyFin,
+                       [CF_CFDP_FileDirective_NAK]        = CF_CFDP_S2_SubstateNak,
+                       [CF_CFDP_FileDirective_KEEP_ALIVE] = CF_CFDP_S2_SubstateKeepAlive }
     };
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_eof = {
-        .fdirective = { [CF_CFDP_FileDirective_FIN] = CF_CFDP_S_SubstateRecvFin,
-                       [CF_CFDP_FileDirective_ACK] = CF_CFDP_S2_SubstateEofAck,
-                       [CF_CFDP_FileDirective_NAK] = CF_CFDP_S2_SubstateNak }
+        .fdirective = { [CF_CFDP_FileDirective_FIN]        = CF_CFDP_S_SubstateRecvFin,
+                       [CF_CFDP_FileDirective_ACK]        = CF_CFDP_S2_SubstateEofAck,
+                       [CF_CFDP_FileDirective_NAK]        = CF_CFDP_S2_SubstateNak,
+                       [CF_CFDP_FileDirective_KEEP_ALIVE] = CF_CFDP_S2_SubstateKeepAlive }
     };
 
     /* In S2, we must continue allowing all directives until full completion,
@@ -439,10 +502,7 @@ void CF_CFDP_S2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
  *-----------------------------------------------------------------*/
 void CF_CFDP_S_Init(CF_Transaction_t *txn)
 {
-    int32     OsStatus;
-    osal_id_t PendingFd;
-
-    PendingFd = OS_OBJECT_ID_UNDEFINED;
+    int32 OsStatus;
 
     /* This is a race condition (toctou), but only intended to catch operational mistakes
      * because CFDP does not work well with files that are potentially changing. */
@@ -463,9 +523,37 @@ void CF_CFDP_S_Init(CF_Transaction_t *txn)
         }
     }
 
+    if (txn->compress == CF_Compress_NONE)
+    {
+        CF_CFDP_S_OpenFile(txn, txn->history->fnames.src_filename);
+    }
+    else if (CF_CFDP_TxnIsOK(txn))
+    {
+        /* the compressed copy is what is sent, so offsets and checksum refer to a file that does not change.
+         * It is written a few blocks per wakeup, the file is opened and the MD sent once it is done. */
+        if (CF_Compress_FileStart(txn) == CFE_SUCCESS)
+        {
+            txn->state_data.sub_state = CF_TxSubState_PREPARE;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_OpenFile(CF_Transaction_t *txn, const char *SendFile)
+{
+    int32     OsStatus;
+    osal_id_t PendingFd;
+
+    PendingFd = OS_OBJECT_ID_UNDEFINED;
+
     if (CF_CFDP_TxnIsOK(txn))
     {
-        OsStatus = CF_WrappedOpenCreate(&PendingFd, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+        OsStatus = CF_WrappedOpenCreate(&PendingFd, SendFile, OS_FILE_FLAG_NONE, OS_READ_ONLY);
         if (OsStatus < 0)
         {
             CFE_EVS_SendEvent(CF_CFDP_S_OPEN_ERR_EID,
@@ -474,7 +562,7 @@ void CF_CFDP_S_Init(CF_Transaction_t *txn)
                               CF_CFDP_GetPrintClass(txn),
                               (unsigned long)txn->history->src_eid,
                               (unsigned long)txn->history->seq_num,
-                              txn->history->fnames.src_filename,
+                              SendFile,
                               (long)OsStatus);
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
             PendingFd = OS_OBJECT_ID_UNDEFINED; /* just in case */
@@ -529,8 +617,16 @@ void CF_CFDP_S_Init(CF_Transaction_t *txn)
 
         CF_CRC_Start(&txn->crc);
 
-        /* initial MD needs to be sent */
-        txn->flags.tx.send_md = true;
+        /* a re-sent file may only need the blocks that changed, the MD is sent once it is hashed */
+        if (CF_Delta_ScanStart(txn))
+        {
+            txn->state_data.sub_state = CF_TxSubState_PREPARE;
+        }
+        else
+        {
+            /* initial MD needs to be sent */
+            txn->flags.tx.send_md = true;
+        }
     }
     else if (OS_ObjectIdDefined(PendingFd))
     {
@@ -546,6 +642,41 @@ void CF_CFDP_S_Init(CF_Transaction_t *txn)
  *
  *-----------------------------------------------------------------*/
 void CF_CFDP_S_HandleFileRetention(CF_Transaction_t *txn)
+{
+    char ZipName[CFE_MISSION_MAX_PATH_LEN];
+
+    CF_Delta_Finish(txn);
+
+    if (txn->compress != CF_Compress_NONE)
+    {
+        /* the compressed copy is only needed while it is being sent */
+        if (OS_ObjectIdDefined(txn->fd))
+        {
+            CF_WrappedClose(txn->fd);
+            txn->fd = OS_OBJECT_ID_UNDEFINED;
+        }
+        CF_Compress_GetTempName(txn->history, CF_COMPRESS_TX_SUFFIX, ZipName, sizeof(ZipName));
+        OS_remove(ZipName);
+    }
+
+    if (txn->flags.tx.bundle)
+    {
+        /* the files packed in the bundle are handled one by one */
+        CF_Bundle_Retain(txn);
+    }
+    else
+    {
+        CF_CFDP_S_RetainFile(txn, txn->history->fnames.src_filename);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_RetainFile(CF_Transaction_t *txn, const char *SubjectFile)
 {
     /*
      * For a sender:
@@ -554,14 +685,12 @@ void CF_CFDP_S_HandleFileRetention(CF_Transaction_t *txn)
      *   - If the transfer is not successful or the "keep" flag is true, then do nothing
      */
     char                      TempName[CFE_MISSION_MAX_PATH_LEN];
-    const char               *SubjectFile;
     const char               *MoveDest;
     const CF_ChannelConfig_t *config;
     int32                     OsStatus;
     bool                      AllowLocalRemove;
 
     config           = &CF_AppData.config_table->chan[txn->chan_num];
-    SubjectFile      = txn->history->fnames.src_filename;
     MoveDest         = NULL;
     AllowLocalRemove = false;
 
@@ -655,6 +784,45 @@ void CF_CFDP_S_AckTimerTick(CF_Transaction_t *txn)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Local Helper function for S state machine
+ *
+ *-----------------------------------------------------------------*/
+CF_TxSubState_t CF_CFDP_S_CheckState_PREPARE(CF_Transaction_t *txn)
+{
+    CF_TxSubState_t next_state = txn->state_data.sub_state;
+    char            ZipName[CFE_MISSION_MAX_PATH_LEN];
+
+    if (!CF_CFDP_TxnIsOK(txn))
+    {
+        /* canceled while compressing or hashing, nothing was sent yet */
+        next_state = CF_TxSubState_FILESTORE;
+    }
+    else if (txn->compress == CF_Compress_NONE)
+    {
+        /* a delta transfer, see cf_delta.h */
+        if (CF_Delta_ScanStep(txn))
+        {
+            txn->flags.tx.send_md = true;
+            next_state            = CF_TxSubState_DATA_NORMAL;
+        }
+    }
+    else if (CF_Compress_FileStep(txn))
+    {
+        /* a compressed file is never a delta transfer, so this does not go back to PREPARE */
+        if (CF_CFDP_TxnIsOK(txn))
+        {
+            CF_Compress_GetTempName(txn->history, CF_COMPRESS_TX_SUFFIX, ZipName, sizeof(ZipName));
+            CF_CFDP_S_OpenFile(txn, ZipName);
+        }
+
+        next_state = CF_CFDP_TxnIsOK(txn) ? CF_TxSubState_DATA_NORMAL : CF_TxSubState_FILESTORE;
+    }
+
+    return next_state;
+}
+
 /*----------------------------------------------------------------
  *
  * Local Helper function for S state machine
@@ -666,9 +834,10 @@ CF_TxSubState_t CF_CFDP_S_CheckState_DATA_NORMAL(CF_Transaction_t *txn)
 
     /* The "normal" data state just pumps out PDUs, which is done by a separate sub-tick
      * after all control messages are done.  At this stage we just check if its done sending PDUs. */
-    if (txn->foffs >= txn->fsize)
+    if (txn->foffs >= txn->fsize && !(txn->flags.tx.delta && txn->flags.tx.fd_nak_pending))
     {
         /* we reached EOF, do maintenance tasks */
+        /* a delta transfer first sends the changed blocks, the receiver checks the file at EOF */
         next_state = CF_TxSubState_DATA_EOF;
     }
     else if (!CF_CFDP_TxnIsOK(txn) || txn->flags.tx.fin_count != 0)
@@ -828,6 +997,11 @@ void CF_CFDP_S_CheckState(CF_Transaction_t *txn)
     /* State transitions are done here */
     switch (txn->state_data.sub_state)
     {
+        /* The file is compressed a few blocks per wakeup before anything is sent */
+        case CF_TxSubState_PREPARE:
+            next_state = CF_CFDP_S_CheckState_PREPARE(txn);
+            break;
+
         /* The "normal" data state just pumps out PDUs, which is done by a separate sub-tick
          * after all control messages are done.  At this stage we just check if its done sending PDUs. */
         case CF_TxSubState_DATA_NORMAL:
@@ -877,6 +1051,37 @@ void CF_CFDP_S_CheckState(CF_Transaction_t *txn)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_CheckPrompt(CF_Transaction_t *txn)
+{
+    const CF_ChannelConfig_t *cc;
+
+    /* after EOF the EOF/FIN exchange already tracks the receiver */
+    if (txn->reliable_mode && txn->state_data.sub_state == CF_TxSubState_DATA_NORMAL)
+    {
+        cc = &CF_AppData.config_table->chan[txn->chan_num];
+
+        if (cc->prompt_keep_alive_bytes != 0 &&
+            (txn->foffs / cc->prompt_keep_alive_bytes) > (txn->state_data.prompt_pos / cc->prompt_keep_alive_bytes))
+        {
+            txn->flags.tx.send_prompt_ka = true;
+        }
+
+        if (cc->prompt_nak_bytes != 0 &&
+            (txn->foffs / cc->prompt_nak_bytes) > (txn->state_data.prompt_pos / cc->prompt_nak_bytes))
+        {
+            txn->flags.tx.send_prompt_nak = true;
+        }
+
+        txn->state_data.prompt_pos = txn->foffs;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -891,8 +1096,12 @@ void CF_CFDP_S_Tick(CF_Transaction_t *txn)
 
     /* at each tick, various timers used by S are checked */
     /* first, check inactivity timer */
-    /* Note that the CFDP protocol does not expect any response from the peer until after EOF */
-    if (!txn->flags.com.inactivity_fired && txn->state_data.sub_state != CF_TxSubState_DATA_NORMAL)
+    /* Note that the CFDP protocol does not expect any response from the peer until after EOF,
+     * unless a Prompt(Keep Alive) has gone out and is still waiting for its answer */
+    if (!txn->flags.com.inactivity_fired &&
+        ((txn->state_data.sub_state != CF_TxSubState_DATA_NORMAL &&
+          txn->state_data.sub_state != CF_TxSubState_PREPARE) ||
+         txn->flags.tx.keep_alive_pending))
     {
         if (!CF_Timer_Expired(&txn->inactivity_timer))
         {
@@ -912,6 +1121,7 @@ void CF_CFDP_S_Tick(CF_Transaction_t *txn)
                                   (unsigned long)txn->history->src_eid,
                                   (unsigned long)txn->history->seq_num);
                 ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.inactivity_timer;
+                CF_Peer_Count(txn->history->peer_eid, CF_PeerCounter_INACTIVITY, 1);
 
                 CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_INACTIVITY_DETECTED);
             }
@@ -922,6 +1132,7 @@ void CF_CFDP_S_Tick(CF_Transaction_t *txn)
     {
         CF_CFDP_S_AckTimerTick(txn);
         CF_CFDP_S_CheckState(txn);
+        CF_CFDP_S2_CheckPrompt(txn);
     }
 
     CF_CFDP_S_Tick_Maintenance(txn);
@@ -967,6 +1178,7 @@ void CF_CFDP_S_Tick_Maintenance(CF_Transaction_t *txn)
              * no timer set here.  If lost, it is only NAK'ed after we
              * send data, otherwise we assume it got there. */
             txn->flags.tx.send_md = false;
+            CF_TxnMetrics_Mark(&txn->history->metrics, &txn->history->metrics.first_pdu_ms);
         }
     }
     else if (txn->flags.tx.send_eof)
@@ -976,10 +1188,12 @@ void CF_CFDP_S_Tick_Maintenance(CF_Transaction_t *txn)
         if (sret == CFE_SUCCESS)
         {
             txn->flags.tx.send_eof = false;
+            CF_TxnMetrics_Mark(&txn->history->metrics, &txn->history->metrics.eof_ms);
 
             /* In S2, the EOF needs an EOF-ACK response, so arm the timer. */
             if (txn->reliable_mode)
             {
+                CF_Rtt_Start(txn, txn->state_data.acknak_count != 0);
                 CF_CFDP_ArmAckTimer(txn);
             }
         }
@@ -993,6 +1207,29 @@ void CF_CFDP_S_Tick_Maintenance(CF_Transaction_t *txn)
             txn->flags.tx.fin_ack_count = txn->flags.tx.fin_count;
         }
     }
+    else if (txn->flags.tx.send_prompt_ka)
+    {
+        sret = CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_KEEP_ALIVE);
+        if (sret == CFE_SUCCESS)
+        {
+            txn->flags.tx.send_prompt_ka = false;
+
+            /* the receiver owes us an answer now, so start timing its liveness */
+            if (!txn->flags.tx.keep_alive_pending)
+            {
+                txn->flags.tx.keep_alive_pending = true;
+                CF_CFDP_ArmInactTimer(txn);
+            }
+        }
+    }
+    else if (txn->flags.tx.send_prompt_nak)
+    {
+        sret = CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_NAK);
+        if (sret == CFE_SUCCESS)
+        {
+            txn->flags.tx.send_prompt_nak = false;
+        }
+    }
 }
 
 /*----------------------------------------------------------------
@@ -68,6 +68,23 @@ void CF_CFDP_S2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 void CF_CFDP_S_AckTimerTick(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Schedule Prompt PDUs as S2 file data goes out.
+ *
+ * @par Description
+ *       Each time the file offset crosses a multiple of the channel
+ *       prompt_keep_alive_bytes or prompt_nak_bytes setting, the matching
+ *       Prompt PDU is scheduled for the next maintenance pass.  Only
+ *       applies to class 2 before EOF.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ */
+void CF_CFDP_S2_CheckPrompt(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Perform tick (time-based) processing for S transactions.
  *
@@ -126,6 +143,24 @@ void CF_CFDP_S_Tick_Nak(CF_Transaction_t *txn);
  */
 void CF_CFDP_S_Init(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Opens the file sent by a transaction and gets it ready for the MD PDU.
+ *
+ * @par Description
+ *       Gets the file size, starts the checksum, and flags the MD PDU to be
+ *       sent.  A delta transfer goes to the PREPARE sub-state instead, the MD
+ *       PDU is sent once the file is hashed.  A compressed file is opened once
+ *       it is done, from the PREPARE sub-state.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn and SendFile must not be NULL.  On failure the transaction status
+ *       is set and nothing is left open.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param SendFile  File whose contents are carried by the PDUs
+ */
+void CF_CFDP_S_OpenFile(CF_Transaction_t *txn, const char *SendFile);
+
 /***********************************************************************
  *
  * Handler routines for send-file transactions
@@ -209,6 +244,23 @@ void CF_CFDP_S_SubstateRecvFin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph
  */
 void CF_CFDP_S2_SubstateNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief S2 Keep Alive PDU received handling.
+ *
+ * @par Description
+ *       Records the progress reported by the receiver and clears any
+ *       outstanding keep alive prompt.  Everything below the progress
+ *       point is held by the receiver, so pending retransmits for that
+ *       range are dropped from the chunks structure.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. ph must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param ph Pointer to the PDU information
+ */
+void CF_CFDP_S2_SubstateKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief S2 received ACK PDU.
  *
@@ -246,6 +298,8 @@ void CF_CFDP_S_CheckState(CF_Transaction_t *txn);
  *     the local file deletion policy (either delete directly or move to recycle dir)
  *   - If the transfer is not successful or the "keep" flag is true, then do nothing
  *
+ * A bundle is not kept, the policy applies to each of the files packed in it.
+ *
  * @par Assumptions, External Events, and Notes:
  *
  * @param txn Transaction object pointer
@@ -253,4 +307,18 @@ void CF_CFDP_S_CheckState(CF_Transaction_t *txn);
  */
 void CF_CFDP_S_HandleFileRetention(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Remove/Move one local file after transaction
+ *
+ * Applies the policy of CF_CFDP_S_HandleFileRetention() to a single file.
+ * For a bundle, this is called for every file packed in it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. SubjectFile must not be NULL.
+ *
+ * @param txn          Transaction object pointer
+ * @param SubjectFile  Path of the local file
+ */
+void CF_CFDP_S_RetainFile(CF_Transaction_t *txn, const char *SubjectFile);
+
 #endif /* !CF_CFDP_S_H */
@@ -23,7 +23,8 @@
  * This is the interface to the CFE Software Bus for CF transmit/recv.
  * Specifically this implements 3 functions used by the CFDP engine:
  *  - CF_CFDP_MsgOutGet() - gets a buffer prior to transmitting
- *  - CF_CFDP_Send() - sends the buffer from CF_CFDP_MsgOutGet
+ *  - CF_CFDP_Send() - queues the buffer from CF_CFDP_MsgOutGet for transmit
+ *  - CF_CFDP_FlushOutput() - transmits all queued buffers of a channel
  *  - CF_CFDP_ReceiveMessage() - gets a received message
  *
  * These functions were originally part of the CFDP engine itself
@@ -62,19 +63,17 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
 {
     /* if channel is frozen, do not take message */
     CF_Channel_t           *chan    = CF_AppData.engine.channels + txn->chan_num;
+    CF_OutputRing_t        *ring    = &chan->out_ring;
     bool                    success = true;
     CF_Logical_PduBuffer_t *ret;
     int32                   os_status;
 
     /* this function should not be called more than once before the message
-     * is sent, so if there's already an outgoing message allocated
-     * then drop and get a new one (not likely) */
-    ret = NULL;
-    if (CF_AppData.engine.out.msg)
-    {
-        CFE_SB_ReleaseMessageBuffer(CF_AppData.engine.out.msg);
-        CF_AppData.engine.out.msg = NULL;
-    }
+     * is sent, so if there's already an outgoing message then drop it and get
+     * a new one (not likely).  The buffer is still held as a spare in its ring,
+     * so it is simply reused rather than released. */
+    ret                       = NULL;
+    CF_AppData.engine.out.msg = NULL;
 
     if (CF_AppData.config_table->chan[txn->chan_num].max_outgoing_messages_per_wakeup
         && (chan->outgoing_counter >= CF_AppData.config_table->chan[txn->chan_num].max_outgoing_messages_per_wakeup))
@@ -95,16 +94,35 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
             os_status = OS_SUCCESS;
         }
 
-        /* Allocate message buffer on success */
+        /* Take the next ring entry on success, allocating a buffer only if it has no spare */
         if (os_status == OS_SUCCESS)
         {
-            CF_AppData.engine.out.msg = CFE_SB_AllocateMessageBuffer(offsetof(CF_PduTlmMsg_t, ph) + CF_MAX_PDU_SIZE
-                                                                     + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES);
+            if (ring->num_queued >= CF_OUTPUT_RING_SIZE)
+            {
+                CF_CFDP_FlushOutput(chan);
+            }
+
+            if (ring->buf[ring->num_queued] == NULL)
+            {
+                ring->buf[ring->num_queued] = CFE_SB_AllocateMessageBuffer(
+                    offsetof(CF_PduTlmMsg_t, ph) + CF_MAX_PDU_SIZE + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES);
+
+                if (ring->buf[ring->num_queued] != NULL)
+                {
+                    ++ring->num_held;
+                    if (ring->num_held > CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.out_buf_hwm)
+                    {
+                        CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.out_buf_hwm = ring->num_held;
+                    }
+                }
+            }
+
+            CF_AppData.engine.out.msg = ring->buf[ring->num_queued];
         }
 
         if (!CF_AppData.engine.out.msg)
         {
-            if (!silent && (os_status == OS_SUCCESS))
+            if (!silent && (os_status == OS_SUCCESS) && CF_EvLim_Allow(CF_CFDP_NO_MSG_ERR_EID))
             {
                 CFE_EVS_SendEvent(CF_CFDP_NO_MSG_ERR_EID,
                                   CFE_EVS_EventType_ERROR,
@@ -154,10 +172,17 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
  *-----------------------------------------------------------------*/
 void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
 {
-    CFE_MSG_Size_t sb_msgsize;
+    CFE_MSG_Size_t   sb_msgsize;
+    CF_OutputRing_t *ring;
 
     CF_Assert(chan_num < CF_NUM_CHANNELS);
 
+    ring = &CF_AppData.engine.channels[chan_num].out_ring;
+
+    /* the buffer being sent is always the next entry of the ring, see CF_CFDP_MsgOutGet() */
+    CF_Assert(ring->num_queued < CF_OUTPUT_RING_SIZE);
+    CF_Assert(ring->buf[ring->num_queued] == CF_AppData.engine.out.msg);
+
     /* now handle the SB encapsulation - this should reflect the
      * length of the entire message, including encapsulation */
     sb_msgsize  = offsetof(CF_PduTlmMsg_t, ph);
@@ -166,14 +191,90 @@ void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
     sb_msgsize += CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
 
     CFE_MSG_SetSize(&CF_AppData.engine.out.msg->Msg, sb_msgsize);
-    CFE_MSG_SetMsgTime(&CF_AppData.engine.out.msg->Msg, CFE_TIME_GetTime());
-    CFE_SB_TransmitBuffer(CF_AppData.engine.out.msg, true);
 
-    ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.sent.pdu;
+    if (CF_AppData.capture.enabled)
+    {
+        CF_Capture_Pdu(chan_num,
+                       CF_CAPTURE_DIR_TX,
+                       ph->penc->base,
+                       ph->pdu_header.header_encoded_length + ph->pdu_header.data_encoded_length);
+    }
+
+    /* the time stamp and transmit are done for the whole batch by CF_CFDP_FlushOutput() */
+    ++ring->num_queued;
 
     CF_AppData.engine.out.msg = NULL;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_FlushOutput(CF_Channel_t *chan)
+{
+    CF_OutputRing_t   *ring     = &chan->out_ring;
+    const int          chan_num = (chan - CF_AppData.engine.channels);
+    CFE_TIME_SysTime_t now;
+    uint16             i;
+    uint16             j;
+
+    if (ring->num_queued > 0)
+    {
+        now = CFE_TIME_GetTime();
+
+        for (i = 0; i < ring->num_queued; ++i)
+        {
+            CFE_MSG_SetMsgTime(&ring->buf[i]->Msg, now);
+            CFE_SB_TransmitBuffer(ring->buf[i], true);
+            ring->buf[i] = NULL;
+        }
+
+        ring->num_held -= ring->num_queued;
+        ring->rate_pdus += ring->num_queued;
+        CF_AppData.hk.Payload.channel_hk[chan_num].counters.sent.pdu += ring->num_queued;
+
+        /* move any spare buffers down so they are used first next time */
+        j = 0;
+        for (i = ring->num_queued; i < CF_OUTPUT_RING_SIZE; ++i)
+        {
+            if (ring->buf[i] != NULL)
+            {
+                ring->buf[j] = ring->buf[i];
+                ring->buf[i] = NULL;
+                ++j;
+            }
+        }
+
+        ring->num_queued = 0;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_ReleaseOutput(CF_Channel_t *chan)
+{
+    CF_OutputRing_t *ring = &chan->out_ring;
+    uint16           i;
+
+    for (i = 0; i < CF_OUTPUT_RING_SIZE; ++i)
+    {
+        if (ring->buf[i] != NULL)
+        {
+            CFE_SB_ReleaseMessageBuffer(ring->buf[i]);
+            ring->buf[i] = NULL;
+        }
+    }
+
+    ring->num_queued = 0;
+    ring->num_held   = 0;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -222,6 +323,15 @@ void CF_CFDP_ReceiveMessage(CF_Channel_t *chan)
             CF_CFDP_DecodeStart(&CF_AppData.engine.in.decode, bufptr, ph, offsetof(CF_PduCmdMsg_t, ph), msg_size);
         }
 
+        /* the bytes the decoder sees, without the SB headers */
+        if (CF_AppData.capture.enabled && CF_CODEC_IS_OK(&CF_AppData.engine.in.decode))
+        {
+            CF_Capture_Pdu(chan_num,
+                           CF_CAPTURE_DIR_RX,
+                           CF_AppData.engine.in.decode.base,
+                           CF_CODEC_GET_SIZE(&CF_AppData.engine.in.decode));
+        }
+
         /* Identify and dispatch this PDU */
         CF_CFDP_ReceivePdu(chan, ph);
 
@@ -86,7 +86,10 @@ typedef struct CF_PduTlmMsg
 CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool silent);
 
 /************************************************************************/
-/** @brief Sends the current output buffer via the software bus.
+/** @brief Queues the current output buffer for transmit via the software bus.
+ *
+ * @par Description
+ *       The PDU is sent by the next CF_CFDP_FlushOutput() on the channel.
  *
  * @par Assumptions, External Events, and Notes:
  *       The PDU in the output buffer is ready to transmit.
@@ -97,6 +100,35 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
  */
 void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Transmits all PDUs queued in the channel output ring.
+ *
+ * @par Description
+ *       All queued PDUs get the same time stamp, taken once for the batch.
+ *       Spare buffers that were not used stay in the ring for the next wakeup.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must be a member of the array within the CF_AppData global object
+ *
+ * @param chan       Channel to flush
+ *
+ */
+void CF_CFDP_FlushOutput(CF_Channel_t *chan);
+
+/************************************************************************/
+/** @brief Releases every SB buffer held by the channel output ring.
+ *
+ * @par Description
+ *       Any PDUs still queued are dropped.  Used when the engine is disabled.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan       Channel whose buffers are released
+ *
+ */
+void CF_CFDP_ReleaseOutput(CF_Channel_t *chan);
+
 /************************************************************************/
 /** @brief Process received message on channel PDU input pipe.
  *
@@ -43,28 +43,16 @@
 #include "cf_codec.h"
 
 /**
- * @brief Maximum possible number of transactions that may exist on a single CF channel
+ * @brief Number of transactions a channel needs to run all of its playbacks and receives at once
+ *
+ * This is the default per-channel transaction count in the config table; the
+ * number actually allocated is the num_transactions value of each channel.
  */
 #define CF_NUM_TRANSACTIONS_PER_CHANNEL                                                \
     (CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN + CF_MAX_SIMULTANEOUS_RX                 \
      + ((CF_MAX_POLLING_DIR_PER_CHAN + CF_MAX_COMMANDED_PLAYBACK_DIRECTORIES_PER_CHAN) \
         * CF_NUM_TRANSACTIONS_PER_PLAYBACK))
 
-/**
- * @brief Maximum possible number of transactions that may exist in the CF application
- */
-#define CF_NUM_TRANSACTIONS (CF_NUM_CHANNELS * CF_NUM_TRANSACTIONS_PER_CHANNEL)
-
-/**
- * @brief Maximum possible number of history entries that may exist in the CF application
- */
-#define CF_NUM_HISTORIES (CF_NUM_CHANNELS * CF_NUM_HISTORIES_PER_CHANNEL)
-
-/**
- * @brief Maximum possible number of chunk entries that may exist in the CF application
- */
-#define CF_NUM_CHUNKS_ALL_CHANNELS (CF_TOTAL_CHUNKS * CF_NUM_TRANSACTIONS_PER_CHANNEL)
-
 /**
  * @brief High-level state of a transaction
  */
@@ -90,7 +78,8 @@ typedef enum
     CF_TxSubState_DATA_EOF    = 1, /**< Sent an EOF, waiting on EOF-ACK and FIN (or NAK) */
     CF_TxSubState_FILESTORE   = 2, /**< Performing file store ops */
     CF_TxSubState_COMPLETE    = 3, /**< Transaction is done */
-    CF_TxSubState_NUM_STATES  = 4
+    CF_TxSubState_PREPARE     = 4, /**< Compressing or hashing the file, before the MD directive is sent */
+    CF_TxSubState_NUM_STATES  = 5
 } CF_TxSubState_t;
 
 /**
@@ -101,10 +90,11 @@ typedef enum
     CF_RxSubState_DATA_NORMAL = 0, /**< waiting for more PDUs, no EOF received yet (normal recv) */
     CF_RxSubState_DATA_EOF    = 1, /**< Got an EOF, filling in remaining gaps (NAKs may be sent) */
     CF_RxSubState_VALIDATE    = 2, /**< Checking the CRC on the complete file */
-    CF_RxSubState_FILESTORE   = 3, /**< Performing file store ops */
-    CF_RxSubState_FINACK      = 4, /**< pending final fin/fin-ack exchange */
-    CF_RxSubState_COMPLETE    = 5, /**< Transaction is done */
-    CF_RxSubState_NUM_STATES  = 6
+    CF_RxSubState_EXPAND      = 3, /**< Decompressing the complete file */
+    CF_RxSubState_FILESTORE   = 4, /**< Performing file store ops */
+    CF_RxSubState_FINACK      = 5, /**< pending final fin/fin-ack exchange */
+    CF_RxSubState_COMPLETE    = 6, /**< Transaction is done */
+    CF_RxSubState_NUM_STATES  = 7
 } CF_RxSubState_t;
 
 /**
@@ -184,6 +174,7 @@ typedef struct CF_History
     CF_EntityId_t       src_eid;  /**< \brief the source eid of the transaction */
     CF_EntityId_t       peer_eid; /**< \brief peer_eid is always the "other guy", same src_eid for RX */
     CF_TransactionSeq_t seq_num;  /**< \brief transaction identifier, stays constant for entire transfer */
+    CF_TxnMetrics_t     metrics;  /**< \brief throughput and latency of the transaction */
 } CF_History_t;
 
 /**
@@ -197,6 +188,32 @@ typedef struct CF_ChunkWrapper
     CF_CListNode_t cl_node;
 } CF_ChunkWrapper_t;
 
+/**
+ * @brief Directory entry read ahead by a playback
+ */
+typedef struct CF_PlaybackFile
+{
+    char          name[OS_MAX_FILE_NAME];
+    uint32        mtime;    /**< \brief modification time in seconds (CF_PlaybackOrder_OLDEST only) */
+    CF_FileSize_t size;     /**< \brief file size (CF_PlaybackOrder_SMALLEST only) */
+    uint8         priority; /**< \brief priority of the transaction that will send the file */
+} CF_PlaybackFile_t;
+
+/**
+ * @brief Bundle being filled by a polling directory playback, see cf_bundle.h
+ */
+typedef struct CF_Bundle
+{
+    osal_id_t fd;        /**< \brief the open bundle file, while it is being filled */
+    uint32    bytes;     /**< \brief file data in the bundle so far */
+    uint32    oldest;    /**< \brief modification time (seconds) of the oldest file in the bundle */
+    uint16    num_files; /**< \brief number of files in the bundle so far (0 - no bundle) */
+    uint16    seq;       /**< \brief numbers the bundles of the playback, to name them */
+    uint8     chan_num;  /**< \brief channel of the polling directory */
+    uint8     poll_num;  /**< \brief index of the polling directory in the channel */
+    bool      ready;     /**< \brief the bundle is closed and waits for a transaction to send it */
+} CF_Bundle_t;
+
 /**
  * @brief CF Playback entry
  *
@@ -210,12 +227,17 @@ typedef struct CF_Playback
     uint16            num_ts; /**< \brief number of transactions */
     uint8             priority;
     CF_EntityId_t     dest_id;
-    char              pending_file[OS_MAX_FILE_NAME];
+    CF_PlaybackFile_t window[CF_PLAYBACK_WINDOW_SIZE]; /**< \brief files read ahead, in directory order */
+    uint8             num_window;                      /**< \brief number of valid entries in window */
+    CF_Bundle_t       bundle;                          /**< \brief polling only, bundle of small files */
+    uint8             compress;                        /**< \brief CF_Compress_t applied to the files sent */
 
     bool busy;
     bool diropen;
     bool keep;
     bool counted;
+    bool polled; /**< \brief playback is the scan of a polling directory */
+    bool rescan; /**< \brief polling only, a file was left behind so the directory must be scanned again */
 } CF_Playback_t;
 
 /**
@@ -228,6 +250,9 @@ typedef struct CF_Poll
     CF_Playback_t pb;
     CF_Timer_t    interval_timer;
     bool          timer_set;
+    bool          settled;    /**< \brief dir_mtime is valid, see cf_pollidx.h */
+    uint32        dir_mtime;  /**< \brief modification time (seconds) of the directory when it settled */
+    uint32        scan_start; /**< \brief local time (seconds) the last scan started */
 } CF_Poll_t;
 
 /**
@@ -245,6 +270,7 @@ typedef struct CF_Flags_Common
     bool crc_complete;     /**< Latches that the CRC computation is completed */
     bool inactivity_fired; /**< \brief set whenever the inactivity timeout expires */
     bool keep_history;     /**< \brief whether history should be preserved during recycle */
+    bool rtt_pending;      /**< \brief a round trip time is being measured since rtt_start */
 } CF_Flags_Common_t;
 
 /**
@@ -263,6 +289,11 @@ typedef struct CF_Flags_Rx
 
     bool send_nak; /**< Indicates need to send NAK to peer */
     bool send_fin; /**< Indicates need to send FIN to peer */
+
+    bool nak_timer_armed; /**< The pre-EOF NAK timer is running (immediate/async NAK modes) */
+    bool send_keep_alive; /**< Indicates need to send Keep Alive to peer (answering a prompt) */
+    bool delta;           /**< The temp file was filled from the existing file for a delta transfer, see cf_delta.h */
+    bool prefill;         /**< The existing file is still being copied into the temp file, see cf_delta.h */
 } CF_Flags_Rx_t;
 
 /**
@@ -282,6 +313,12 @@ typedef struct CF_Flags_Tx
     bool send_md;  /**< Indicates need to send MD to peer */
     bool send_eof; /**< Indicates need to send EOF to peer */
 
+    bool send_prompt_ka;     /**< Indicates need to send Prompt(Keep Alive) to peer */
+    bool send_prompt_nak;    /**< Indicates need to send Prompt(NAK) to peer */
+    bool keep_alive_pending; /**< A Prompt(Keep Alive) went out and no Keep Alive has come back yet */
+    bool bundle;             /**< The file sent is a bundle of a polling directory, see cf_bundle.h */
+    bool delta;              /**< Only the blocks in the chunk list are sent, see cf_delta.h */
+
 } CF_Flags_Tx_t;
 
 /**
@@ -307,8 +344,17 @@ typedef struct CF_StateData
     uint8 fin_fs;  /**< \brief the fs in FIN PDU */
 
     CF_FileSize_t cached_pos;
-    uint32        eof_crc;  /**< \brief remember the crc in the received EOF PDU  */
-    CF_FileSize_t eof_size; /**< \brief remember the size in the received EOF PDU  */
+    uint32        eof_crc;       /**< \brief remember the crc in the received EOF PDU  */
+    CF_FileSize_t eof_size;      /**< \brief remember the size in the received EOF PDU  */
+    CF_FileSize_t rx_progress;   /**< \brief end of the furthest file data received so far */
+    CF_FileSize_t prompt_pos;    /**< \brief tx only, file offset when prompts were last checked */
+    CF_FileSize_t peer_progress; /**< \brief tx only, progress reported by the last Keep Alive PDU */
+    CF_FileSize_t codec_pos;     /**< \brief bytes of the original file compressed or decompressed so far */
+    CF_FileSize_t codec_size;    /**< \brief size of the original file being compressed or decompressed */
+    CF_FileSize_t delta_pos;     /**< \brief bytes of the file hashed (tx) or copied (rx) so far for a delta transfer */
+    CF_FileSize_t delta_changed; /**< \brief tx only, bytes of the blocks hashed so far that changed */
+
+    CF_Timer_Ticks_t rtt_start; /**< \brief engine tick count when the timed EOF or NAK was sent */
 
 } CF_StateData_t;
 
@@ -325,6 +371,7 @@ typedef struct CF_Transaction
     CF_ChunkWrapper_t *chunks;           /**< \brief for gap tracking, only used on class 2 */
     CF_Timer_t         inactivity_timer; /**< \brief set to the overall inactivity timer of a remote */
     CF_Timer_t         ack_timer;        /**< \brief called ack_timer, but is also nak_timer */
+    CF_Timer_t         nak_timer;        /**< \brief rx only, times gaps seen before EOF (immediate/async NAK) */
 
     CF_FileSize_t fsize; /**< \brief lseek() should be 64-bit on 64-bit system, but osal limits to 32-bit */
     CF_FileSize_t foffs; /**< \brief offset into file for next read */
@@ -336,8 +383,10 @@ typedef struct CF_Transaction
     uint8 keep;
     uint8 chan_num; /**< \brief if ever more than one engine, this may need to change to pointer */
     uint8 priority;
+    uint8 compress; /**< \brief CF_Compress_t applied to the file: by this sender, or by the peer when receiving */
 
     CF_CListNode_t cl_node;
+    uint32         active_idx; /**< \brief position in the channel active set, valid only on the RX/TX queues */
 
     CF_Playback_t *pb; /**< \brief NULL if transaction does not belong to a playback */
 
@@ -369,6 +418,57 @@ typedef enum
     CF_TickState_NUM_TYPES
 } CF_TickState_t;
 
+/**
+ * @brief Dense index of the transactions on an active (RX or TX) queue
+ *
+ * This mirrors the membership of the corresponding CList queue as a packed
+ * array, so tick processing can visit every active transaction with a simple
+ * indexed loop and resume from a saved position.  Removal is O(1) by moving
+ * the last entry into the vacated slot, so the order here is not the queue order.
+ */
+typedef struct CF_ActiveSet
+{
+    CF_Transaction_t **txn;      /**< \brief packed transaction pointers, carved from the engine arena */
+    uint32             count;    /**< \brief number of entries in use */
+    uint32             capacity; /**< \brief number of entries in txn (channel transaction count) */
+} CF_ActiveSet_t;
+
+/**
+ * @brief Number of distinct transaction priority values (priority is a uint8)
+ */
+#define CF_NUM_PRIORITIES 256
+
+/**
+ * @brief Priority bucket index over a priority-sorted queue
+ *
+ * The queue itself remains a CList sorted by priority (lower value first), FIFO
+ * within equal priority.  This keeps a pointer to the newest entry of each priority
+ * and a bitmap of non-empty priorities, so the insertion point for a new entry is
+ * found by a bit scan instead of a walk of the queue.
+ */
+typedef struct CF_PrioQueue
+{
+    uint32            bitmap[CF_NUM_PRIORITIES / 32]; /**< \brief bit set for each non-empty priority */
+    CF_Transaction_t *tail[CF_NUM_PRIORITIES];        /**< \brief newest txn at each priority */
+} CF_PrioQueue_t;
+
+/**
+ * @brief Output buffer ring of a channel
+ *
+ * PDUs are encoded into SB buffers held here and transmitted in a batch by
+ * CF_CFDP_FlushOutput().  Entries [0, num_queued) hold PDUs waiting to be sent,
+ * entries from num_queued on hold spare buffers (or NULL) that are reused by
+ * the next CF_CFDP_MsgOutGet() instead of being released to the SB pool.
+ */
+typedef struct CF_OutputRing
+{
+    CFE_SB_Buffer_t *buf[CF_OUTPUT_RING_SIZE]; /**< \brief SB buffers held by the channel */
+    uint16           num_queued;               /**< \brief number of encoded PDUs waiting to be sent */
+    uint16           num_held;                 /**< \brief number of non-NULL entries in buf */
+    uint32           rate_pdus;                /**< \brief PDUs sent so far in the current one second window */
+    uint32           rate_ticks;               /**< \brief wakeups so far in the current one second window */
+} CF_OutputRing_t;
+
 /**
  * @brief Channel state object
  *
@@ -378,10 +478,30 @@ typedef enum
  * and poll state, as well as separate addresses on the underlying message
  * transport (e.g. SB).
  */
+/**
+ * @brief A transaction that was spilled to disk to free its slot
+ *
+ * Only the key and the expiry timer stay in memory, everything else
+ * is in the spill file (see cf_spill.h).
+ */
+typedef struct CF_SpillEntry
+{
+    CF_EntityId_t       src_eid; /**< \brief the source eid of the transaction */
+    CF_TransactionSeq_t seq_num; /**< \brief transaction sequence number */
+    CF_Timer_t          expiry;  /**< \brief abandon the transaction when this expires */
+} CF_SpillEntry_t;
+
 typedef struct CF_Channel
 {
     CF_CListNode_t *qs[CF_QueueIdx_NUM];
     CF_CListNode_t *cs[CF_Direction_NUM];
+    CF_ChunkSlab_t  chunk_slab; /**< \brief chunk blocks shared by the chunk lists of this channel */
+
+    CF_ActiveSet_t active[CF_Direction_NUM]; /**< \brief dense view of the RX and TX queues for ticking */
+    CF_PrioQueue_t pend_prio;                /**< \brief priority index of the PEND queue */
+    CF_PrioQueue_t tx_prio;                  /**< \brief priority index of the TX queue */
+
+    CF_OutputRing_t out_ring; /**< \brief outgoing PDUs waiting for the end of the wakeup */
 
     CFE_SB_PipeId_t pipe;
 
@@ -392,6 +512,10 @@ typedef struct CF_Channel
     /* For polling directories, the configuration data is in a table. */
     CF_Poll_t poll[CF_MAX_POLLING_DIR_PER_CHAN];
 
+    CF_SpillEntry_t spill[CF_MAX_SPILLED_PER_CHAN]; /**< \brief index of the transactions spilled to disk */
+    uint32          num_spilled;                    /**< \brief number of valid entries in spill */
+    uint32          spill_writes;                   /**< \brief spill files written, seen by the journal digest */
+
     osal_id_t sem_id; /**< \brief semaphore id for output pipe */
 
     uint32 outgoing_counter;
@@ -400,11 +524,18 @@ typedef struct CF_Channel
      * tick processing) then this captures where the tick processing left off.
      * This is because it is important to tick every txn and not let traffic from the
      * first item(s) in the queue to consume all the bandwidth and never let the later
-     * items get ticked. */
-    const CF_Transaction_t *tick_resume;
+     * items get ticked.  The state is CF_TickState_INIT when there is nothing to resume,
+     * otherwise the index refers to the active set used by that tick state. */
+    uint8  tick_resume_state;
+    uint32 tick_resume_idx;
 
     bool tx_blocked; /**< Set true if PDU transmission was blocked due to limits */
 
+    /* When a wakeup runs out of its time budget, the next one starts with the
+     * playback or polling directory that was not reached, so none are starved. */
+    uint8 playback_resume; /**< \brief playback directory processed first */
+    uint8 poll_resume;     /**< \brief polling directory processed first */
+
 } CF_Channel_t;
 
 /**
@@ -431,6 +562,67 @@ typedef struct CF_Input
     CF_Logical_PduBuffer_t rx_pdudata; /**< \brief Rx PDU logical values */
 } CF_Input_t;
 
+/**
+ * @brief Alignment of every block handed out by the engine arena, in bytes
+ */
+#define CF_ARENA_ALIGN 8
+
+/**
+ * @brief Rounds a byte count up to the engine arena alignment
+ */
+#define CF_ARENA_ROUNDUP(x) ((((x) + CF_ARENA_ALIGN - 1) / CF_ARENA_ALIGN) * CF_ARENA_ALIGN)
+
+/**
+ * @brief Simple bump allocator over a fixed block of memory
+ *
+ * Used at engine initialization to divide a single block of memory into the
+ * per-channel pools.  Nothing is freed individually; the whole arena is reset
+ * when the engine is reinitialized.
+ */
+typedef struct CF_Arena
+{
+    uint8 *base; /**< \brief start of the memory block */
+    size_t size; /**< \brief size of the memory block in bytes */
+    size_t used; /**< \brief number of bytes handed out so far (including alignment padding) */
+} CF_Arena_t;
+
+/**
+ * @brief Backing storage for the engine arena
+ *
+ * The union members other than bytes only force an alignment that is
+ * suitable for any of the pool object types.
+ */
+typedef union CF_ArenaMem
+{
+    uint8  bytes[CF_ENGINE_ARENA_SIZE];
+    uint64 align_u64;
+    void  *align_ptr;
+    double align_dbl;
+} CF_ArenaMem_t;
+
+/**
+ * @brief A transaction journal checkpoint being written, see cf_journal.h
+ *
+ * A checkpoint is written a few records per wakeup.  Each channel contributes
+ * the eligible transactions of its RX queue and then its spill index; pos
+ * counts the entries of the current channel already handled.
+ */
+typedef struct CF_Checkpoint
+{
+    osal_id_t fd;          /**< \brief journal file being written */
+    CF_Crc_t  crc;         /**< \brief running checksum of the journal body */
+    CF_Crc_t  ids;         /**< \brief checksum of the identities of the transactions handled so far */
+    uint32    num_records; /**< \brief number of records written so far */
+    uint32    digest;      /**< \brief CF_Journal_Digest() when the checkpoint was started */
+    uint32    pos;         /**< \brief entries of the current channel handled in earlier traversals */
+    uint32    idx;         /**< \brief eligible transactions seen by the RX queue traversal under way */
+    uint32    count;       /**< \brief entries handled in the current wakeup */
+    uint8     chan_num;    /**< \brief channel being written */
+    bool      busy;        /**< \brief a checkpoint is being written */
+    bool      yield;       /**< \brief the current wakeup has no room for more entries */
+    bool      error;       /**< \brief Will be set to true if any write failed */
+} CF_Checkpoint_t;
+
 /**
  * @brief An engine represents a pairing to a local EID
  *
@@ -443,13 +635,22 @@ typedef struct CF_Engine
     CF_Output_t out;
     CF_Input_t  in;
 
-    /* NOTE: could have separate array of transactions as part of channel? */
-    CF_Transaction_t transactions[CF_NUM_TRANSACTIONS];
-    CF_History_t     histories[CF_NUM_HISTORIES];
-    CF_Channel_t     channels[CF_NUM_CHANNELS];
+    CF_Channel_t channels[CF_NUM_CHANNELS];
+
+    /* the transaction, history and chunk pools of all channels are carved from here */
+    CF_Arena_t    arena;
+    CF_ArenaMem_t arena_mem;
+
+    CF_Checkpoint_t checkpoint;        /**< \brief the checkpoint being written, if busy */
+    CF_Timer_t      checkpoint_timer;  /**< \brief time until the next transaction journal checkpoint */
+    uint32          checkpoint_digest; /**< \brief CF_Journal_Digest() of the last checkpoint written */
+    bool            checkpoint_saved;  /**< \brief a checkpoint was written since the engine was initialized */
+
+    CF_Timer_Ticks_t tick_count; /**< \brief wakeups of the enabled engine, the clock of round trip times */
 
-    CF_ChunkWrapper_t chunks[CF_NUM_TRANSACTIONS * CF_Direction_NUM];
-    CF_Chunk_t        chunk_mem[CF_NUM_CHUNKS_ALL_CHANNELS];
+    OS_time_t wakeup_start; /**< \brief start of the current wakeup, its time budget counts from here */
+    bool      budget_spent; /**< \brief set once the current wakeup used up its time budget */
+    uint8     first_chan;   /**< \brief channel served first, moves on when a wakeup runs out of time */
 
     bool enabled;
 } CF_Engine_t;
@@ -31,7 +31,6 @@
  *  This is intended to be mostly a generic purpose class used by CF.
  */
 
-#include <string.h>
 #include "cf_verify.h"
 #include "cf_assert.h"
 #include "cf_chunk.h"
@@ -49,8 +48,12 @@ void CF_Chunks_EraseRange(CF_ChunkList_t *chunks, CF_ChunkIdx_t start, CF_ChunkI
 
     if (start < end)
     {
-        memmove(&chunks->chunks[start], &chunks->chunks[end], sizeof(*chunks->chunks) * (chunks->count - end));
-        chunks->count -= (end - start);
+        /* storage is not contiguous across blocks, so shift entry by entry */
+        for (; end < chunks->count; ++start, ++end)
+        {
+            *CF_ChunkList_At(chunks, start) = *CF_ChunkList_At(chunks, end);
+        }
+        chunks->count = start;
     }
 }
 
@@ -65,11 +68,7 @@ void CF_Chunks_EraseChunk(CF_ChunkList_t *chunks, CF_ChunkIdx_t erase_index)
     CF_Assert(chunks->count > 0);
     CF_Assert(erase_index < chunks->count);
 
-    /* to erase, move memory over the old one */
-    memmove(&chunks->chunks[erase_index],
-            &chunks->chunks[erase_index + 1],
-            sizeof(*chunks->chunks) * (chunks->count - 1 - erase_index));
-    --chunks->count;
+    CF_Chunks_EraseRange(chunks, erase_index, erase_index + 1);
 }
 
 /*----------------------------------------------------------------
@@ -80,16 +79,16 @@ void CF_Chunks_EraseChunk(CF_ChunkList_t *chunks, CF_ChunkIdx_t erase_index)
  *-----------------------------------------------------------------*/
 void CF_Chunks_InsertChunk(CF_ChunkList_t *chunks, CF_ChunkIdx_t index_before, const CF_Chunk_t *chunk)
 {
-    CF_Assert(chunks->count < chunks->max_chunks);
+    CF_ChunkIdx_t i;
+
+    CF_Assert(chunks->count < CF_Chunks_Capacity(chunks));
     CF_Assert(index_before <= chunks->count);
 
-    if (chunks->count && (index_before != chunks->count))
+    for (i = chunks->count; i > index_before; --i)
     {
-        memmove(&chunks->chunks[index_before + 1],
-                &chunks->chunks[index_before],
-                sizeof(*chunk) * (chunks->count - index_before));
+        *CF_ChunkList_At(chunks, i) = *CF_ChunkList_At(chunks, i - 1);
     }
-    memcpy(&chunks->chunks[index_before], chunk, sizeof(*chunk));
+    *CF_ChunkList_At(chunks, index_before) = *chunk;
 
     ++chunks->count;
 }
@@ -112,7 +111,7 @@ CF_ChunkIdx_t CF_Chunks_FindInsertPosition(CF_ChunkList_t *chunks, const CF_Chun
         i     = first;
         step  = count / 2;
         i    += step;
-        if (chunks->chunks[i].offset < chunk->offset)
+        if (CF_ChunkList_At(chunks, i)->offset < chunk->offset)
         {
             first  = i + 1;
             count -= step + 1;
@@ -145,7 +144,7 @@ int CF_Chunks_CombinePrevious(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, const CF_
     if (i > 0)
     {
         chunk_end = chunk->offset + chunk->size;
-        prev      = &chunks->chunks[i - 1];
+        prev      = CF_ChunkList_At(chunks, i - 1);
         prev_end  = prev->offset + prev->size;
 
         /* Check if start of new chunk is less than end of previous (overlaps) */
@@ -174,6 +173,8 @@ CFE_Status_t CF_Chunks_CombineNext(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, cons
     CF_ChunkIdx_t    combined_i = i;
     CFE_Status_t     ret        = 0;
     CF_ChunkOffset_t chunk_end  = chunk->offset + chunk->size;
+    CF_Chunk_t      *last;
+    CF_Chunk_t      *entry;
 
     /* Assert no rollover, only possible as a bug */
     CF_Assert(chunk_end > chunk->offset);
@@ -182,7 +183,7 @@ CFE_Status_t CF_Chunks_CombineNext(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, cons
     for (; combined_i < chunks->count; ++combined_i)
     {
         /* Advance combine index until there is a gap between end and the next offset */
-        if (chunk_end < chunks->chunks[combined_i].offset)
+        if (chunk_end < CF_ChunkList_At(chunks, combined_i)->offset)
         {
             break;
         }
@@ -192,12 +193,13 @@ CFE_Status_t CF_Chunks_CombineNext(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, cons
     if (i != combined_i)
     {
         /* End is the max of last combined chunk end or new chunk end */
-        chunk_end =
-            CF_Chunk_MAX(chunks->chunks[combined_i - 1].offset + chunks->chunks[combined_i - 1].size, chunk_end);
+        last      = CF_ChunkList_At(chunks, combined_i - 1);
+        chunk_end = CF_Chunk_MAX(last->offset + last->size, chunk_end);
 
         /* Use current slot as combined entry */
-        chunks->chunks[i].size   = chunk_end - chunk->offset;
-        chunks->chunks[i].offset = chunk->offset;
+        entry         = CF_ChunkList_At(chunks, i);
+        entry->size   = chunk_end - chunk->offset;
+        entry->offset = chunk->offset;
 
         /* Erase the rest of the combined chunks (if any) */
         CF_Chunks_EraseRange(chunks, i + 1, combined_i);
@@ -220,7 +222,7 @@ CF_ChunkIdx_t CF_Chunks_FindSmallestSize(const CF_ChunkList_t *chunks)
 
     for (i = 1; i < chunks->count; ++i)
     {
-        if (chunks->chunks[i].size < chunks->chunks[smallest].size)
+        if (CF_ChunkList_At(chunks, i)->size < CF_ChunkList_At(chunks, smallest)->size)
         {
             smallest = i;
         }
@@ -244,7 +246,7 @@ void CF_Chunks_Insert(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, const CF_Chunk_t
 
     if (n)
     {
-        combined = CF_Chunks_CombinePrevious(chunks, i, &chunks->chunks[i]);
+        combined = CF_Chunks_CombinePrevious(chunks, i, CF_ChunkList_At(chunks, i));
         if (combined)
         {
             CF_Chunks_EraseChunk(chunks, i);
@@ -255,14 +257,15 @@ void CF_Chunks_Insert(CF_ChunkList_t *chunks, CF_ChunkIdx_t i, const CF_Chunk_t
         combined = CF_Chunks_CombinePrevious(chunks, i, chunk);
         if (!combined)
         {
-            if (chunks->count < chunks->max_chunks)
+            if (CF_Chunks_Grow(chunks))
             {
                 CF_Chunks_InsertChunk(chunks, i, chunk);
             }
-            else
+            else if (chunks->count > 0)
             {
+                /* no more room for this transaction, keep the larger chunks */
                 smallest_i = CF_Chunks_FindSmallestSize(chunks);
-                smallest_c = &chunks->chunks[smallest_i];
+                smallest_c = CF_ChunkList_At(chunks, smallest_i);
                 if (smallest_c->size < chunk->size)
                 {
                     CF_Chunks_EraseChunk(chunks, smallest_i);
@@ -300,7 +303,7 @@ void CF_ChunkListAdd(CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSi
  *-----------------------------------------------------------------*/
 void CF_ChunkList_RemoveFromFirst(CF_ChunkList_t *chunks, CF_ChunkSize_t size)
 {
-    CF_Chunk_t *chunk = &chunks->chunks[0]; /* front is always 0 */
+    CF_Chunk_t *chunk = CF_ChunkList_At(chunks, 0); /* front is always 0 */
 
     if (size > chunk->size)
     {
@@ -326,7 +329,7 @@ void CF_ChunkList_RemoveFromFirst(CF_ChunkList_t *chunks, CF_ChunkSize_t size)
  *-----------------------------------------------------------------*/
 const CF_Chunk_t *CF_ChunkList_GetFirstChunk(const CF_ChunkList_t *chunks)
 {
-    return chunks->count ? &chunks->chunks[0] : NULL;
+    return chunks->count ? CF_ChunkList_At(chunks, 0) : NULL;
 }
 
 /*----------------------------------------------------------------
@@ -335,12 +338,14 @@ const CF_Chunk_t *CF_ChunkList_GetFirstChunk(const CF_ChunkList_t *chunks)
  * See description in cf_chunk.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t *chunks_mem)
+void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t **blocks, CF_ChunkSlab_t *slab)
 {
     CF_Assert(max_chunks > 0);
     chunks->max_chunks = max_chunks;
-    chunks->chunks     = chunks_mem;
-    CF_ChunkListReset(chunks);
+    chunks->blocks     = blocks;
+    chunks->slab       = slab;
+    chunks->num_blocks = 0;
+    chunks->count      = 0;
 }
 
 /*----------------------------------------------------------------
@@ -351,8 +356,114 @@ void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk
  *-----------------------------------------------------------------*/
 void CF_ChunkListReset(CF_ChunkList_t *chunks)
 {
+    CF_ChunkSlab_t *slab = chunks->slab;
+
+    if (chunks->num_blocks > 0)
+    {
+        CF_Assert(slab->num_lists > 0);
+        --slab->num_lists;
+    }
+
+    /* hand every block back to the slab for use by other transactions */
+    while (chunks->num_blocks > 0)
+    {
+        --chunks->num_blocks;
+        CF_Assert(slab->num_free < slab->num_blocks);
+        slab->free_blocks[slab->num_free] = chunks->blocks[chunks->num_blocks];
+        ++slab->num_free;
+    }
+
     chunks->count = 0;
-    memset(chunks->chunks, 0, sizeof(*chunks->chunks) * chunks->max_chunks);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_chunk.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_ChunkSlab_Init(CF_ChunkSlab_t *slab, CF_ChunkIdx_t num_blocks, CF_ChunkIdx_t num_reserved,
+                       CF_Chunk_t *block_mem, CF_Chunk_t **free_blocks)
+{
+    CF_ChunkIdx_t i;
+
+    CF_Assert(num_reserved <= num_blocks);
+
+    slab->free_blocks  = free_blocks;
+    slab->num_blocks   = num_blocks;
+    slab->num_free     = num_blocks;
+    slab->num_reserved = num_reserved;
+    slab->num_lists    = 0;
+    slab->grow_fails   = 0;
+
+    for (i = 0; i < num_blocks; ++i)
+    {
+        free_blocks[i] = &block_mem[i * CF_CHUNK_BLOCK_SIZE];
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_chunk.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_ChunkIdx_t CF_Chunks_Capacity(const CF_ChunkList_t *chunks)
+{
+    CF_ChunkIdx_t capacity = chunks->num_blocks * CF_CHUNK_BLOCK_SIZE;
+
+    if (capacity > chunks->max_chunks)
+    {
+        capacity = chunks->max_chunks;
+    }
+
+    return capacity;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_chunk.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Chunks_Grow(CF_ChunkList_t *chunks)
+{
+    CF_ChunkSlab_t *slab   = chunks->slab;
+    bool            status = true;
+    CF_ChunkIdx_t   held_back;
+
+    if (chunks->count >= CF_Chunks_Capacity(chunks))
+    {
+        /* the blocks still reserved for the lists that hold none are only for a first block */
+        held_back = 0;
+        if (chunks->num_blocks > 0 && slab->num_reserved > slab->num_lists)
+        {
+            held_back = slab->num_reserved - slab->num_lists;
+        }
+
+        if (chunks->count >= chunks->max_chunks)
+        {
+            status = false;
+        }
+        else if (slab->num_free > held_back)
+        {
+            if (chunks->num_blocks == 0)
+            {
+                ++slab->num_lists;
+            }
+
+            --slab->num_free;
+            chunks->blocks[chunks->num_blocks] = slab->free_blocks[slab->num_free];
+            ++chunks->num_blocks;
+        }
+        else
+        {
+            ++slab->grow_fails;
+            status = false;
+        }
+    }
+
+    return status;
 }
 
 /*----------------------------------------------------------------
@@ -395,10 +506,10 @@ uint32 CF_ChunkList_ComputeGaps(const CF_ChunkList_t       *chunks,
     else
     {
         /* Handle initial gap if needed */
-        if (start < chunks->chunks[0].offset)
+        if (start < CF_ChunkList_At(chunks, 0)->offset)
         {
             chunk.offset = start;
-            chunk.size   = chunks->chunks[0].offset - start;
+            chunk.size   = CF_ChunkList_At(chunks, 0)->offset - start;
             if (compute_gap_fn)
             {
                 compute_gap_fn(chunks, &chunk, opaque);
@@ -408,8 +519,8 @@ uint32 CF_ChunkList_ComputeGaps(const CF_ChunkList_t       *chunks,
 
         while ((ret < max_gaps) && (i < chunks->count))
         {
-            next_off  = (i == (chunks->count - 1)) ? total : chunks->chunks[i + 1].offset;
-            gap_start = (chunks->chunks[i].offset + chunks->chunks[i].size);
+            next_off  = (i == (chunks->count - 1)) ? total : CF_ChunkList_At(chunks, i + 1)->offset;
+            gap_start = (CF_ChunkList_At(chunks, i)->offset + CF_ChunkList_At(chunks, i)->size);
 
             chunk.offset = (gap_start > start) ? gap_start : start;
             chunk.size   = (next_off - chunk.offset);
@@ -27,6 +27,7 @@
 #define CF_CHUNK_H
 
 #include "cfe.h"
+#include "cf_platform_cfg.h"
 
 typedef uint32 CF_ChunkIdx_t;
 typedef uint32 CF_ChunkOffset_t;
@@ -41,18 +42,59 @@ typedef struct CF_Chunk
     CF_ChunkSize_t   size;   /**< \brief The size of the chunk */
 } CF_Chunk_t;
 
+/**
+ * @brief Number of slab blocks needed to hold the given number of chunks
+ */
+#define CF_CHUNK_BLOCKS_FOR(n) (((n) + CF_CHUNK_BLOCK_SIZE - 1) / CF_CHUNK_BLOCK_SIZE)
+
+/**
+ * @brief A shared pool of fixed-size chunk blocks
+ *
+ * Chunk lists take blocks of CF_CHUNK_BLOCK_SIZE chunks from the slab as they
+ * grow and give them all back when they are reset.  Free blocks are kept on
+ * a simple stack.
+ *
+ * num_reserved blocks are held back for the first block of the lists that
+ * hold none, one per list that may be in use at once, so that a list can
+ * always record its first chunk however much the others have grown.
+ */
+typedef struct CF_ChunkSlab
+{
+    CF_Chunk_t  **free_blocks;  /**< \brief stack of free blocks */
+    CF_ChunkIdx_t num_free;     /**< \brief number of blocks currently on the free stack */
+    CF_ChunkIdx_t num_blocks;   /**< \brief total number of blocks owned by the slab */
+    CF_ChunkIdx_t num_reserved; /**< \brief blocks held back, one for each list that may be in use */
+    CF_ChunkIdx_t num_lists;    /**< \brief lists currently holding at least one block */
+    uint32        grow_fails;   /**< \brief times a list below its cap could not take a block */
+} CF_ChunkSlab_t;
+
 /**
  * @brief A list of CF_Chunk_t pairs
  *
- * This list is ordered by chunk offset, from lowest to highest
+ * This list is ordered by chunk offset, from lowest to highest.  Storage is held
+ * in blocks taken from a CF_ChunkSlab_t; use CF_ChunkList_At() to reach an entry.
  */
 typedef struct CF_ChunkList
 {
-    CF_ChunkIdx_t count;      /**< \brief number of chunks currently in the array */
-    CF_ChunkIdx_t max_chunks; /**< \brief maximum number of chunks allowed in the list (allocation size) */
-    CF_Chunk_t   *chunks;     /**< \brief chunk list array */
+    CF_ChunkIdx_t   count;      /**< \brief number of chunks currently in the list */
+    CF_ChunkIdx_t   max_chunks; /**< \brief maximum number of chunks allowed in the list (growth cap) */
+    CF_ChunkIdx_t   num_blocks; /**< \brief number of slab blocks currently held by the list */
+    CF_Chunk_t    **blocks;     /**< \brief held blocks, array of CF_CHUNK_BLOCKS_FOR(max_chunks) entries */
+    CF_ChunkSlab_t *slab;       /**< \brief slab the blocks are taken from and returned to */
 } CF_ChunkList_t;
 
+/**
+ * @brief Gets a chunk list entry by index
+ *
+ * @param chunks Pointer to the CF_ChunkList_t object
+ * @param i      Index of the entry, must be within the blocks held by the list
+ * @return Pointer to the entry
+ */
+static inline CF_Chunk_t *CF_ChunkList_At(const CF_ChunkList_t *chunks, CF_ChunkIdx_t i)
+{
+    return &chunks->blocks[i / CF_CHUNK_BLOCK_SIZE][i % CF_CHUNK_BLOCK_SIZE];
+}
+
 /**
  * @brief Function for use with CF_ChunkList_ComputeGaps()
  *
@@ -81,17 +123,37 @@ static inline CF_ChunkOffset_t CF_Chunk_MAX(CF_ChunkOffset_t a, CF_ChunkOffset_t
     }
 }
 
+/************************************************************************/
+/** @brief Initialize a CF_ChunkSlab_t structure.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       slab must not be NULL. block_mem and free_blocks must not be NULL if num_blocks is nonzero.
+ *       num_reserved must not be more than num_blocks.
+ *
+ * @param slab         Pointer to CF_ChunkSlab_t object to initialize
+ * @param num_blocks   Number of blocks in the slab
+ * @param num_reserved Number of lists that may be in use at once, each is sure of one block
+ * @param block_mem    Array of CF_Chunk_t objects with length of (num_blocks * CF_CHUNK_BLOCK_SIZE)
+ * @param free_blocks  Array of block pointers with length of num_blocks, used as the free stack
+ */
+void CF_ChunkSlab_Init(CF_ChunkSlab_t *slab, CF_ChunkIdx_t num_blocks, CF_ChunkIdx_t num_reserved,
+                       CF_Chunk_t *block_mem, CF_Chunk_t **free_blocks);
+
 /************************************************************************/
 /** @brief Initialize a CF_ChunkList_t structure.
+ *
+ * The list starts out empty and holding no blocks.  It grows one block at a time
+ * from the slab as chunks are added, up to max_chunks.
  *
  * @par Assumptions, External Events, and Notes:
- *       chunks must not be NULL. chunks_mem must not be NULL.
+ *       chunks must not be NULL. blocks must not be NULL. slab must not be NULL.
  *
  * @param chunks      Pointer to CF_ChunkList_t object to initialize
- * @param max_chunks  Maximum number of entries in the chunks_mem array
- * @param chunks_mem  Array of CF_Chunk_t objects with length of max_chunks
+ * @param max_chunks  Maximum number of chunks the list may grow to
+ * @param blocks      Array of block pointers with length of CF_CHUNK_BLOCKS_FOR(max_chunks)
+ * @param slab        Slab to take chunk blocks from
  */
-void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t *chunks_mem);
+void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t **blocks, CF_ChunkSlab_t *slab);
 
 /************************************************************************/
 /** @brief Public function to add a chunk.
@@ -108,9 +170,10 @@ void CF_ChunkListAdd(CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSi
 /************************************************************************/
 /** @brief Resets a chunks structure.
  *
- * All chunks are removed from the list, but the max_chunks and chunk memory
- * pointers are retained.  This returns the chunk list to the same state as
- * it was after the initial call to CF_ChunkListInit().
+ * All chunks are removed from the list and the blocks it held are returned to
+ * the slab, but the max_chunks, block array and slab pointers are retained.
+ * This returns the chunk list to the same state as it was after the initial
+ * call to CF_ChunkListInit().
  *
  * @par Assumptions, External Events, and Notes:
  *       chunks must not be NULL.
@@ -218,6 +281,34 @@ void CF_Chunks_EraseRange(CF_ChunkList_t *chunks, CF_ChunkIdx_t start, CF_ChunkI
  */
 void CF_Chunks_EraseChunk(CF_ChunkList_t *chunks, CF_ChunkIdx_t erase_index);
 
+/************************************************************************/
+/** @brief Number of chunks the list can hold without growing.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chunks must not be NULL.
+ *
+ * @param chunks   Pointer to CF_ChunkList_t object
+ *
+ * @returns The number of chunks that fit in the blocks held, limited to max_chunks.
+ */
+CF_ChunkIdx_t CF_Chunks_Capacity(const CF_ChunkList_t *chunks);
+
+/************************************************************************/
+/** @brief Takes another block from the slab if the list is full.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chunks must not be NULL.  The first block of a list may come from
+ *       the blocks reserved for the lists holding none, further blocks only
+ *       from the rest.  A list below its cap that cannot grow is counted in
+ *       grow_fails of the slab.
+ *
+ * @param chunks   Pointer to CF_ChunkList_t object
+ *
+ * @returns true if there is room for another chunk on return, false if the
+ *          list is at its cap or the slab has no free blocks.
+ */
+bool CF_Chunks_Grow(CF_ChunkList_t *chunks);
+
 /************************************************************************/
 /** @brief Insert a chunk before index_before.
  *
@@ -226,6 +317,7 @@ void CF_Chunks_EraseChunk(CF_ChunkList_t *chunks, CF_ChunkIdx_t erase_index);
  *
  * @par Assumptions, External Events, and Notes:
  *       chunks must not be NULL, chunk must not be NULL.
+ *       The list must have room for another chunk, see CF_Chunks_Grow().
  *
  * @param chunks       Pointer to CF_ChunkList_t object
  * @param index_before position to insert at - this becomes the ID of the inserted chunk
@@ -303,7 +395,9 @@ CF_ChunkIdx_t CF_Chunks_FindSmallestSize(const CF_ChunkList_t *chunks);
  *
  * @par Description
  *       Inserts the chunk at the specified location. May combine with
- *       an existing chunk if contiguous.
+ *       an existing chunk if contiguous.  The list grows from the slab if
+ *       needed; once it cannot grow, the smallest chunk is replaced if the
+ *       new one is larger.
  *
  * @par Assumptions, External Events, and Notes:
  *       chunks must not be NULL, chunk must not be NULL.
@@ -36,6 +36,13 @@
 
 #include "cf_cfdp.h"
 #include "cf_cmd.h"
+#include "cf_spill.h"
+#include "cf_diag.h"
+#include "cf_capture.h"
+#include "cf_dump.h"
+#include "cf_evlim.h"
+#include "cf_peer.h"
+#include "cf_shm.h"
 
 #include <string.h>
 
@@ -69,13 +76,13 @@ CFE_Status_t CF_NoopCmd(const CF_NoopCmd_t *msg)
 CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg)
 {
     const CF_UnionArgs_Payload_t *data     = &msg->Payload;
-    static const char            *names[5] = { "all", "cmd", "fault", "up", "down" };
-    /* 0=all, 1=cmd, 2=fault 3=up 4=down */
+    static const char            *names[7] = { "all", "cmd", "fault", "up", "down", "diag", "peer" };
+    /* 0=all, 1=cmd, 2=fault 3=up 4=down 5=diag 6=peer */
     uint8                         param    = data->byte[0];
     int                           i;
     bool                          acc = true;
 
-    if (param > 4)
+    if (param > CF_Reset_peer)
     {
         CFE_EVS_SendEvent(CF_CMD_RESET_INVALID_ERR_EID,
                           CFE_EVS_EventType_ERROR,
@@ -128,6 +135,20 @@ CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg)
                        sizeof(CF_AppData.hk.Payload.channel_hk[i].counters.sent));
         }
 
+        /* if the param is CF_Reset_diag, or all counters */
+        if ((param == CF_Reset_all) || (param == CF_Reset_diag))
+        {
+            /* wakeup time histograms */
+            CF_Diag_Reset();
+        }
+
+        /* if the param is CF_Reset_peer, or all counters */
+        if ((param == CF_Reset_all) || (param == CF_Reset_peer))
+        {
+            /* peer statistics */
+            CF_Peer_Reset();
+        }
+
         if (acc)
         {
             ++CF_AppData.hk.Payload.counters.cmd;
@@ -150,17 +171,19 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
     /*
      * This needs to validate all its inputs.
      * "keep" should only be 0 or 1 (logical true/false).
+     * "compress" must be a known CF_Compress_t.
      * For priority and dest_id params, anything is acceptable.
      */
     if ((tx->cfdp_class != CF_CFDP_CLASS_1 && tx->cfdp_class != CF_CFDP_CLASS_2) || tx->chan_num >= CF_NUM_CHANNELS
-        || (int)tx->keep > 1)
+        || (int)tx->keep > 1 || tx->compress >= CF_Compress_NUM)
     {
         CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID,
                           CFE_EVS_EventType_ERROR,
-                          "CF: bad parameter in CF_TxFileCmd(): chan=%u, class=%u keep=%u",
+                          "CF: bad parameter in CF_TxFileCmd(): chan=%u, class=%u keep=%u compress=%u",
                           (unsigned int)tx->chan_num,
                           (unsigned int)tx->cfdp_class,
-                          (unsigned int)tx->keep);
+                          (unsigned int)tx->keep,
+                          (unsigned int)tx->compress);
         ++CF_AppData.hk.Payload.counters.err;
 
         /* This must return CFE_SUCCESS because the command is done (error counter was incremented, no more events) */
@@ -173,7 +196,8 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
                        tx->keep,
                        tx->chan_num,
                        tx->priority,
-                       tx->dest_id)
+                       tx->dest_id,
+                       tx->compress)
         == CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(CF_CMD_TX_FILE_INF_EID,
@@ -203,17 +227,19 @@ CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
     /*
      * This needs to validate all its inputs.
      * "keep" should only be 0 or 1 (logical true/false).
+     * "compress" must be a known CF_Compress_t.
      * For priority and dest_id params, anything is acceptable.
      */
     if ((tx->cfdp_class != CF_CFDP_CLASS_1 && tx->cfdp_class != CF_CFDP_CLASS_2) || tx->chan_num >= CF_NUM_CHANNELS
-        || (int)tx->keep > 1)
+        || (int)tx->keep > 1 || tx->compress >= CF_Compress_NUM)
     {
         CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID,
                           CFE_EVS_EventType_ERROR,
-                          "CF: bad parameter in CF_PlaybackDirCmd(): chan=%u, class=%u keep=%u",
+                          "CF: bad parameter in CF_PlaybackDirCmd(): chan=%u, class=%u keep=%u compress=%u",
                           (unsigned int)tx->chan_num,
                           (unsigned int)tx->cfdp_class,
-                          (unsigned int)tx->keep);
+                          (unsigned int)tx->keep,
+                          (unsigned int)tx->compress);
         ++CF_AppData.hk.Payload.counters.err;
 
         /* This must return CFE_SUCCESS because the command is done (error counter was incremented, no more events) */
@@ -226,7 +252,8 @@ CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
                             tx->keep,
                             tx->chan_num,
                             tx->priority,
-                            tx->dest_id)
+                            tx->dest_id,
+                            tx->compress)
         == CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(CF_CMD_PLAYBACK_DIR_INF_EID,
@@ -386,13 +413,26 @@ int32 CF_TsnChanAction(const CF_Transaction_Payload_t *data,
                        void                           *context)
 {
     CF_Transaction_t *txn;
+    CF_SpillEntry_t  *spilled;
     int32             ret = -1;
+    int               i;
 
     if (data->chan == CF_COMPOUND_KEY)
     {
         /* special value 254 means to use the compound key (data->eid, data->ts) to find the transaction
          * to act upon */
         txn = CF_FindTransactionBySequenceNumberAllChannels(data->ts, data->eid);
+        for (i = 0; txn == NULL && i < CF_NUM_CHANNELS; ++i)
+        {
+            /* a transaction spilled to disk is brought back to act on it */
+            spilled = CF_Spill_Find(CF_AppData.engine.channels + i, data->eid, data->ts);
+            if (spilled != NULL)
+            {
+                txn = CF_Spill_Reload(CF_AppData.engine.channels + i, spilled);
+                break;
+            }
+        }
+
         if (txn)
         {
             fn(txn, context);
@@ -410,12 +450,17 @@ int32 CF_TsnChanAction(const CF_Transaction_Payload_t *data,
     }
     else if (data->chan == CF_ALL_CHANNELS)
     {
-        /* perform action on all channels, all transactions */
+        /* perform action on all channels, all transactions (including those spilled, as far as they fit) */
+        for (i = 0; i < CF_NUM_CHANNELS; ++i)
+        {
+            CF_Spill_ReloadAll(CF_AppData.engine.channels + i);
+        }
         ret = CF_TraverseAllTransactions_All_Channels(fn, context);
     }
     else if (data->chan < CF_NUM_CHANNELS)
     {
         /* perform action on a specific channel, all transactions */
+        CF_Spill_ReloadAll(CF_AppData.engine.channels + data->chan);
         ret = CF_TraverseAllTransactions(CF_AppData.engine.channels + data->chan, fn, context);
     }
     else
@@ -876,8 +921,8 @@ CFE_Status_t CF_WriteQueueCmd(const CF_WriteQueueCmd_t *msg)
         ++CF_AppData.hk.Payload.counters.err;
         success = false;
     }
-    /* only invalid combination is up direction, pending queue */
-    else if ((wq->type == CF_Type_up) && (wq->queue == CF_Queue_pend))
+    /* only invalid combination is up direction, pending queue, beside an unknown format */
+    else if (((wq->type == CF_Type_up) && (wq->queue == CF_Queue_pend)) || (wq->format > CF_Format_binary))
     {
         CFE_EVS_SendEvent(CF_CMD_WQ_ARGS_ERR_EID,
                           CFE_EVS_EventType_ERROR,
@@ -885,10 +930,15 @@ CFE_Status_t CF_WriteQueueCmd(const CF_WriteQueueCmd_t *msg)
         ++CF_AppData.hk.Payload.counters.err;
         success = false;
     }
+    else if (wq->format == CF_Format_binary)
+    {
+        /* written over the next wakeups, the dump reports its own outcome */
+        CF_Dump_Start(wq);
+        success = false;
+    }
     else
     {
-        /* PTFO: queues can be large. may want to split this work up across the state machine and take several wakeups
-         * to complete */
+        /* the text format is written at once, the binary one does not hold up the engine with large queues */
         ret = CF_WrappedOpenCreate(&fd, wq->filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
         if (ret < 0)
         {
@@ -1294,6 +1344,10 @@ CFE_Status_t CF_SendHkCmd(const CF_SendHkCmd_t *msg)
     CFE_SB_TimeStampMsg(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader));
     /* return value ignored */ CFE_SB_TransmitMsg(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader), true);
 
+    /* the wakeup time histograms and peer statistics go along with housekeeping */
+    CF_Diag_Send();
+    CF_Peer_Send();
+
     /* This is also used to check tables */
     CF_CheckTables();
 
@@ -1312,5 +1366,17 @@ CFE_Status_t CF_WakeupCmd(const CF_WakeupCmd_t *msg)
     CF_CFDP_CycleEngine();
     CFE_ES_PerfLogExit(CF_PERF_ID_CYCLE_ENG);
 
+    /* a binary queue dump goes on in the background */
+    CF_Dump_Run();
+
+    /* refills the event buckets, and reports the events suppressed */
+    CF_EvLim_Tick();
+
+    /* the PDUs captured reach the file at least once a second */
+    CF_Capture_Tick();
+
+    /* monitors see the statistics of every wakeup */
+    CF_Shm_Publish();
+
     return CFE_SUCCESS;
 }
@@ -506,7 +506,8 @@ CFE_Status_t CF_PurgeQueueCmd(const CF_PurgeQueueCmd_t *msg);
 /** @brief Ground command to write a file with queue information.
  *
  * @par Assumptions, External Events, and Notes:
- *       msg must not be NULL.
+ *       msg must not be NULL.  A binary file is written over the following
+ *       wakeups, see cf_dump.h.
  *
  * @param msg   Pointer to command message
  */
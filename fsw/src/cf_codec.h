@@ -497,7 +497,7 @@ void CF_CFDP_EncodeAllSegments(CF_EncoderState_t *state, CF_Logical_SegmentList_
  * encoder is not changed.
  *
  * @note this encode includes the LV pairs for source and destination file names, which are
- * logically part of the overall MD block.
+ * logically part of the overall MD block, and any TLV options indicated in the logical data.
  *
  * @param state  Encoder state object
  * @param plmd   Pointer to logical PDU metadata header data
@@ -584,6 +584,34 @@ void CF_CFDP_EncodeAck(CF_EncoderState_t *state, CF_Logical_PduAck_t *plack);
  */
 void CF_CFDP_EncodeNak(CF_EncoderState_t *state, CF_Logical_PduNak_t *plnak);
 
+/************************************************************************/
+/**
+ * @brief Encodes a CFDP Prompt header block
+ *
+ * The data in the logical header will be appended to the encoded PDU at the current position
+ *
+ * If the encoder is in an error state, nothing is encoded, and the state of the
+ * encoder is not changed.
+ *
+ * @param state     Encoder state object
+ * @param plprompt  Pointer to logical PDU Prompt header data
+ */
+void CF_CFDP_EncodePrompt(CF_EncoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+
+/************************************************************************/
+/**
+ * @brief Encodes a CFDP Keep Alive header block
+ *
+ * The data in the logical header will be appended to the encoded PDU at the current position
+ *
+ * If the encoder is in an error state, nothing is encoded, and the state of the
+ * encoder is not changed.
+ *
+ * @param state  Encoder state object
+ * @param plka   Pointer to logical PDU Keep Alive header data
+ */
+void CF_CFDP_EncodeKeepAlive(CF_EncoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+
 /************************************************************************/
 /**
  * @brief Encodes a CFDP CRC/Checksum
@@ -726,6 +754,8 @@ void CF_CFDP_DecodeAllSegments(CF_DecoderState_t *state, CF_Logical_SegmentList_
  * If the encoder is in an error state, nothing is decoded, and the state of the
  * decoder is not changed.
  *
+ * @note Any TLV options following the file names are decoded into the tlv_list.
+ *
  * @param state  Decoder state object
  * @param plmd   Pointer to logical PDU metadata header data
  */
@@ -807,6 +837,36 @@ void CF_CFDP_DecodeAck(CF_DecoderState_t *state, CF_Logical_PduAck_t *plack);
  */
 void CF_CFDP_DecodeNak(CF_DecoderState_t *state, CF_Logical_PduNak_t *plnak);
 
+/************************************************************************/
+/**
+ * @brief Decodes a CFDP Prompt header block
+ *
+ * The data will be decoded from the encoded PDU at the current position and
+ * the logical fields will be saved to the given data structure
+ *
+ * If the encoder is in an error state, nothing is decoded, and the state of the
+ * decoder is not changed.
+ *
+ * @param state     Decoder state object
+ * @param plprompt  Pointer to logical PDU Prompt header data
+ */
+void CF_CFDP_DecodePrompt(CF_DecoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+
+/************************************************************************/
+/**
+ * @brief Decodes a CFDP Keep Alive header block
+ *
+ * The data will be decoded from the encoded PDU at the current position and
+ * the logical fields will be saved to the given data structure
+ *
+ * If the encoder is in an error state, nothing is decoded, and the state of the
+ * decoder is not changed.
+ *
+ * @param state  Decoder state object
+ * @param plka   Pointer to logical PDU Keep Alive header data
+ */
+void CF_CFDP_DecodeKeepAlive(CF_DecoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+
 /************************************************************************/
 /**
  * @brief Decodes a CFDP CRC/Checksum
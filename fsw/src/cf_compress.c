@@ -0,0 +1,734 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application file compression
+ *
+ * Files are compressed before they are sent, and decompressed by the
+ * receiver when it retains them.  See cf_compress.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_utils.h"
+#include "cf_cfdp.h"
+#include "cf_compress.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+/* LZ4 block format limits: a match is at least 4 bytes, the last 5 bytes of a block are
+ * always literals, and the last match starts at least 12 bytes before the end */
+#define CF_COMPRESS_MIN_MATCH     4
+#define CF_COMPRESS_LAST_LITERALS 5
+#define CF_COMPRESS_MFLIMIT       12
+
+/* announces the method in the MD PDU, indexed by CF_Compress_t */
+static const uint8 CF_Compress_MdMsg[CF_Compress_NUM][CF_COMPRESS_MSG_LEN] = {{0}, {'C', 'F', 'Z', CF_Compress_LZ4}};
+
+/* files are compressed one at a time, by the CF task, so the work area does not need to be on the stack */
+static struct
+{
+    uint8  raw[CF_COMPRESS_BLOCK_SIZE];
+    uint8  packed[CF_COMPRESS_BLOCK_SIZE];
+    uint16 table[1 << CF_COMPRESS_HASH_BITS]; /* position + 1 of the last 4 bytes with each hash, 0 - none */
+} CF_Compress_Work;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Compress_Store16(CF_CFDP_uint16_t *pdst, uint16 val)
+{
+    pdst->octets[0] = (val >> 8) & 0xFF;
+    pdst->octets[1] = val & 0xFF;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Compress_Store32(CF_CFDP_uint32_t *pdst, uint32 val)
+{
+    pdst->octets[0] = (val >> 24) & 0xFF;
+    pdst->octets[1] = (val >> 16) & 0xFF;
+    pdst->octets[2] = (val >> 8) & 0xFF;
+    pdst->octets[3] = val & 0xFF;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_Load32(const CF_CFDP_uint32_t *psrc)
+{
+    return ((uint32)psrc->octets[0] << 24) | ((uint32)psrc->octets[1] << 16) | ((uint32)psrc->octets[2] << 8) |
+           (uint32)psrc->octets[3];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads 4 bytes of a block for the match finder, which only compares them for equality.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_Read32(const uint8 *p)
+{
+    return (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_Hash(uint32 seq)
+{
+    return (seq * 2654435761U) >> (32 - CF_COMPRESS_HASH_BITS);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Appends the extra bytes of a literal or match length that did not fit in its 4 bits.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_PutLength(uint8 *dst, uint32 op, uint32 len)
+{
+    for (len -= 15; len >= 255; len -= 255)
+    {
+        dst[op++] = 255;
+    }
+    dst[op++] = len;
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Reads the extra bytes of a literal or match length, adding them to *val.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Compress_GetLength(const uint8 *src, uint32 len, uint32 *ip, uint32 *val)
+{
+    uint8 byte;
+
+    do
+    {
+        if (*ip >= len)
+        {
+            return false;
+        }
+        byte = src[(*ip)++];
+        *val += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Compresses a block into CF_Compress_Work.packed, returns the compressed size or 0 if it
+ * does not fit in the buffer.  This is a greedy LZ4 match finder:
+ * the only candidate for a match is the last position with the same hash.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_Block(const uint8 *src, uint32 len)
+{
+    uint8 *dst    = CF_Compress_Work.packed;
+    uint32 ip     = 0;
+    uint32 anchor = 0;
+    uint32 op     = 0;
+    uint32 ref;
+    uint32 mlen;
+    uint32 lit;
+    uint32 seq;
+    uint32 hash;
+    uint32 token;
+
+    memset(CF_Compress_Work.table, 0, sizeof(CF_Compress_Work.table));
+
+    while (ip + CF_COMPRESS_MFLIMIT < len)
+    {
+        seq                          = CF_Compress_Read32(&src[ip]);
+        hash                         = CF_Compress_Hash(seq);
+        ref                          = CF_Compress_Work.table[hash];
+        CF_Compress_Work.table[hash] = ip + 1;
+
+        if (ref == 0 || CF_Compress_Read32(&src[ref - 1]) != seq)
+        {
+            ++ip;
+            continue;
+        }
+        --ref;
+
+        for (mlen = CF_COMPRESS_MIN_MATCH; (ip + mlen) < (len - CF_COMPRESS_LAST_LITERALS); ++mlen)
+        {
+            if (src[ref + mlen] != src[ip + mlen])
+            {
+                break;
+            }
+        }
+
+        /* token, literal length, literals, offset and match length at their largest */
+        lit = ip - anchor;
+        if ((op + 1 + (lit / 255) + 1 + lit + 2 + (mlen / 255) + 1) > CF_COMPRESS_BLOCK_SIZE)
+        {
+            return 0;
+        }
+
+        token = op++;
+        if (lit >= 15)
+        {
+            dst[token] = 15 << 4;
+            op         = CF_Compress_PutLength(dst, op, lit);
+        }
+        else
+        {
+            dst[token] = lit << 4;
+        }
+        memcpy(&dst[op], &src[anchor], lit);
+        op += lit;
+
+        dst[op++] = (ip - ref) & 0xFF;
+        dst[op++] = (ip - ref) >> 8;
+
+        mlen -= CF_COMPRESS_MIN_MATCH;
+        if (mlen >= 15)
+        {
+            dst[token] |= 15;
+            op = CF_Compress_PutLength(dst, op, mlen);
+        }
+        else
+        {
+            dst[token] |= mlen;
+        }
+
+        ip += mlen + CF_COMPRESS_MIN_MATCH;
+        anchor = ip;
+    }
+
+    /* the rest of the block is literals, in a sequence without a match */
+    lit = len - anchor;
+    if ((op + 1 + (lit / 255) + 1 + lit) > CF_COMPRESS_BLOCK_SIZE)
+    {
+        return 0;
+    }
+
+    token = op++;
+    if (lit >= 15)
+    {
+        dst[token] = 15 << 4;
+        op         = CF_Compress_PutLength(dst, op, lit);
+    }
+    else
+    {
+        dst[token] = lit << 4;
+    }
+    memcpy(&dst[op], &src[anchor], lit);
+    op += lit;
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Decompresses a block from CF_Compress_Work.packed into CF_Compress_Work.raw, returns
+ * the decompressed size or -1 if the block is not valid.
+ *
+ *-----------------------------------------------------------------*/
+static int32 CF_Compress_ExpandBlock(uint32 len)
+{
+    const uint8 *src = CF_Compress_Work.packed;
+    uint8       *dst = CF_Compress_Work.raw;
+    uint32       ip  = 0;
+    uint32       op  = 0;
+    uint32       lit;
+    uint32       mlen;
+    uint32       offs;
+    uint8        token;
+
+    while (ip < len)
+    {
+        token = src[ip++];
+
+        lit = token >> 4;
+        if (lit == 15 && !CF_Compress_GetLength(src, len, &ip, &lit))
+        {
+            return -1;
+        }
+        if (lit > (len - ip) || lit > (CF_COMPRESS_BLOCK_SIZE - op))
+        {
+            return -1;
+        }
+        memcpy(&dst[op], &src[ip], lit);
+        ip += lit;
+        op += lit;
+
+        if (ip == len)
+        {
+            /* the last sequence has no match */
+            break;
+        }
+
+        if ((len - ip) < 2)
+        {
+            return -1;
+        }
+        offs = src[ip] | ((uint32)src[ip + 1] << 8);
+        ip += 2;
+        if (offs == 0 || offs > op)
+        {
+            return -1;
+        }
+
+        mlen = token & 0x0F;
+        if (mlen == 15 && !CF_Compress_GetLength(src, len, &ip, &mlen))
+        {
+            return -1;
+        }
+        mlen += CF_COMPRESS_MIN_MATCH;
+        if (mlen > (CF_COMPRESS_BLOCK_SIZE - op))
+        {
+            return -1;
+        }
+
+        /* byte by byte, a match may overlap the bytes it produces */
+        for (; mlen > 0; --mlen)
+        {
+            dst[op] = dst[op - offs];
+            ++op;
+        }
+    }
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Compress_SetMd(CF_Logical_PduMd_t *md, uint8 method)
+{
+    CF_Logical_Tlv_t *tlv;
+
+    if (method != CF_Compress_NONE && method < CF_Compress_NUM && md->tlv_list.num_tlv < CF_PDU_MAX_TLV)
+    {
+        tlv                = &md->tlv_list.tlv[md->tlv_list.num_tlv];
+        tlv->type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+        tlv->length        = CF_COMPRESS_MSG_LEN;
+        tlv->data.data_ptr = CF_Compress_MdMsg[method];
+        ++md->tlv_list.num_tlv;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint8 CF_Compress_GetMd(const CF_Logical_PduMd_t *md)
+{
+    const CF_Logical_Tlv_t *tlv;
+    const uint8            *msg;
+    uint8                   method = CF_Compress_NONE;
+    uint8                   i;
+
+    for (i = 0; i < md->tlv_list.num_tlv; ++i)
+    {
+        tlv = &md->tlv_list.tlv[i];
+        msg = tlv->data.data_ptr;
+
+        /* other messages to user are not for CF */
+        if (tlv->type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER && tlv->length == CF_COMPRESS_MSG_LEN && msg != NULL &&
+            memcmp(msg, CF_Compress_MdMsg[CF_Compress_LZ4], CF_COMPRESS_MSG_LEN - 1) == 0)
+        {
+            method = msg[CF_COMPRESS_MSG_LEN - 1];
+        }
+    }
+
+    return method;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Compress_GetTempName(const CF_History_t *hist, const char *suffix, char *buf, size_t buf_size)
+{
+    snprintf(buf,
+             buf_size,
+             "%.*s/%lu_%lu%s",
+             CF_FILENAME_MAX_PATH - 1,
+             CF_AppData.config_table->tmp_dir,
+             (unsigned long)hist->src_eid,
+             (unsigned long)hist->seq_num,
+             suffix);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Compress_FileStart(CF_Transaction_t *txn)
+{
+    CF_CompressHeader_t hdr;
+    char                ZipName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t           src;
+    int32               size;
+
+    if (txn->compress != CF_Compress_LZ4 ||
+        CF_WrappedOpenCreate(&src, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        CFE_EVS_SendEvent(CF_COMPRESS_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: cannot compress %s with method %u",
+                          txn->history->fnames.src_filename,
+                          (unsigned int)txn->compress);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+
+    /* the blocks are read at their offsets on each wakeup, the size is only taken once */
+    size = CF_WrappedLseek(src, 0, OS_SEEK_END);
+    CF_WrappedClose(src);
+    if (size < 0)
+    {
+        CFE_EVS_SendEvent(CF_COMPRESS_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: cannot get the size of %s, error=%ld",
+                          txn->history->fnames.src_filename,
+                          (long)size);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+
+    CF_Compress_GetTempName(txn->history, CF_COMPRESS_TX_SUFFIX, ZipName, sizeof(ZipName));
+    if (CF_WrappedOpenCreate(&txn->fd, ZipName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE) < 0)
+    {
+        CFE_EVS_SendEvent(CF_COMPRESS_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot create %s", ZipName);
+        txn->fd = OS_OBJECT_ID_UNDEFINED;
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+
+    /* the header is rewritten at the end, once all blocks are there */
+    memset(&hdr, 0, sizeof(hdr));
+    if (CF_WrappedWrite(txn->fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    {
+        CFE_EVS_SendEvent(CF_COMPRESS_ERR_EID, CFE_EVS_EventType_ERROR, "CF: failed to write %s", ZipName);
+        CF_WrappedClose(txn->fd);
+        txn->fd = OS_OBJECT_ID_UNDEFINED;
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+
+    txn->state_data.codec_pos  = 0;
+    txn->state_data.codec_size = size;
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Compress_FileStep(CF_Transaction_t *txn)
+{
+    CF_CompressHeader_t hdr;
+    CF_CFDP_uint16_t    blk;
+    osal_id_t           src;
+    const uint8        *data;
+    uint32              data_len;
+    uint32              packed;
+    uint32              want;
+    uint32              count;
+    int32               got;
+    bool                read_ok;
+    bool                write_ok = true;
+
+    read_ok = (CF_WrappedOpenCreate(&src, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0);
+    if (read_ok)
+    {
+        read_ok = (CF_WrappedLseek(src, txn->state_data.codec_pos, OS_SEEK_SET) == txn->state_data.codec_pos);
+
+        for (count = 0; read_ok && write_ok && txn->state_data.codec_pos < txn->state_data.codec_size &&
+                        count < CF_COMPRESS_BLOCKS_PER_WAKEUP;
+             ++count)
+        {
+            /* one block always goes, so the file is done even if every wakeup runs out of time */
+            if (count != 0 && CF_CFDP_BudgetSpent())
+            {
+                break;
+            }
+
+            want = txn->state_data.codec_size - txn->state_data.codec_pos;
+            if (want > sizeof(CF_Compress_Work.raw))
+            {
+                want = sizeof(CF_Compress_Work.raw);
+            }
+
+            got = CF_WrappedRead(src, CF_Compress_Work.raw, want);
+            if (got != want)
+            {
+                /* the file got shorter since the send started */
+                read_ok = false;
+                break;
+            }
+
+            packed = CF_Compress_Block(CF_Compress_Work.raw, got);
+            if (packed == 0 || packed >= (uint32)got)
+            {
+                data     = CF_Compress_Work.raw;
+                data_len = got;
+                CF_Compress_Store16(&blk, data_len | CF_COMPRESS_BLOCK_STORED);
+            }
+            else
+            {
+                data     = CF_Compress_Work.packed;
+                data_len = packed;
+                CF_Compress_Store16(&blk, data_len);
+            }
+
+            write_ok = (CF_WrappedWrite(txn->fd, &blk, sizeof(blk)) == sizeof(blk) &&
+                        CF_WrappedWrite(txn->fd, data, data_len) == data_len);
+
+            txn->state_data.codec_pos += got;
+        }
+
+        CF_WrappedClose(src);
+    }
+
+    if (read_ok && write_ok && txn->state_data.codec_pos == txn->state_data.codec_size)
+    {
+        memset(&hdr, 0, sizeof(hdr));
+        CF_Compress_Store32(&hdr.magic, CF_COMPRESS_MAGIC);
+        CF_Compress_Store32(&hdr.size, txn->state_data.codec_size);
+        hdr.method.octets[0] = txn->compress;
+
+        write_ok = (CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET) == 0 &&
+                    CF_WrappedWrite(txn->fd, &hdr, sizeof(hdr)) == sizeof(hdr));
+    }
+
+    if (!read_ok || !write_ok)
+    {
+        CFE_EVS_SendEvent(CF_COMPRESS_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): failed to compress %s",
+                          CF_CFDP_GetPrintClass(txn),
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.src_filename);
+        if (!read_ok)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+        }
+        else
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+        }
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+    }
+    else if (txn->state_data.codec_pos != txn->state_data.codec_size)
+    {
+        /* more blocks on the next wakeup */
+        return false;
+    }
+
+    /* the file is sent from a fresh handle, like one that was not compressed */
+    CF_WrappedClose(txn->fd);
+    txn->fd = OS_OBJECT_ID_UNDEFINED;
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Compress_ExpandStart(CF_Transaction_t *txn)
+{
+    CF_CompressHeader_t hdr;
+    char                RawName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t           dst;
+
+    if (CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET) != 0 || CF_WrappedRead(txn->fd, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+        CF_Compress_Load32(&hdr.magic) != CF_COMPRESS_MAGIC || hdr.method.octets[0] != CF_Compress_LZ4)
+    {
+        CFE_EVS_SendEvent(CF_DECOMPRESS_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): received file is not a compressed file",
+                          CF_CFDP_GetPrintClass(txn),
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num);
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+
+    CF_Compress_GetTempName(txn->history, CF_COMPRESS_RX_SUFFIX, RawName, sizeof(RawName));
+    if (CF_WrappedOpenCreate(&dst, RawName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) < 0)
+    {
+        CFE_EVS_SendEvent(CF_DECOMPRESS_ERR_EID, CFE_EVS_EventType_ERROR, "CF: cannot create %s", RawName);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return CF_ERROR;
+    }
+    CF_WrappedClose(dst);
+
+    txn->state_data.codec_pos  = 0;
+    txn->state_data.codec_size = CF_Compress_Load32(&hdr.size);
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Compress_ExpandStep(CF_Transaction_t *txn)
+{
+    CF_CFDP_uint16_t blk;
+    char             RawName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t        dst;
+    const uint8     *data;
+    uint32           blk_val;
+    uint32           blk_len;
+    uint32           count;
+    int32            data_len;
+    int32            got;
+    bool             valid  = true;
+    bool             at_end = false;
+    bool             write_ok;
+
+    CF_Compress_GetTempName(txn->history, CF_COMPRESS_RX_SUFFIX, RawName, sizeof(RawName));
+    write_ok = (CF_WrappedOpenCreate(&dst, RawName, OS_FILE_FLAG_NONE, OS_WRITE_ONLY) >= 0);
+    if (write_ok)
+    {
+        write_ok = (CF_WrappedLseek(dst, txn->state_data.codec_pos, OS_SEEK_SET) == txn->state_data.codec_pos);
+
+        /* the received file stays open, and its position is where the last wakeup left off */
+        for (count = 0; valid && write_ok && count < CF_COMPRESS_BLOCKS_PER_WAKEUP; ++count)
+        {
+            /* one block always goes, so the file is done even if every wakeup runs out of time */
+            if (count != 0 && CF_CFDP_BudgetSpent())
+            {
+                break;
+            }
+
+            got = CF_WrappedRead(txn->fd, &blk, sizeof(blk));
+            if (got == 0)
+            {
+                /* the end of the file, all of it must be there */
+                valid  = (txn->state_data.codec_pos == txn->state_data.codec_size);
+                at_end = true;
+                break;
+            }
+
+            if (got != sizeof(blk))
+            {
+                valid = false;
+                break;
+            }
+
+            blk_val = ((uint32)blk.octets[0] << 8) | blk.octets[1];
+            blk_len = blk_val & ~CF_COMPRESS_BLOCK_STORED;
+            if (blk_len == 0 || blk_len > CF_COMPRESS_BLOCK_SIZE ||
+                CF_WrappedRead(txn->fd, CF_Compress_Work.packed, blk_len) != blk_len)
+            {
+                valid = false;
+                break;
+            }
+
+            if ((blk_val & CF_COMPRESS_BLOCK_STORED) != 0)
+            {
+                data     = CF_Compress_Work.packed;
+                data_len = blk_len;
+            }
+            else
+            {
+                data     = CF_Compress_Work.raw;
+                data_len = CF_Compress_ExpandBlock(blk_len);
+            }
+
+            if (data_len < 0 || (uint32)data_len > (txn->state_data.codec_size - txn->state_data.codec_pos))
+            {
+                valid = false;
+                break;
+            }
+
+            write_ok = (CF_WrappedWrite(dst, data, data_len) == data_len);
+            txn->state_data.codec_pos += data_len;
+        }
+
+        CF_WrappedClose(dst);
+    }
+
+    if (!valid || !write_ok)
+    {
+        CFE_EVS_SendEvent(CF_DECOMPRESS_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to decompress into %s",
+                          CF_CFDP_GetPrintClass(txn),
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num,
+                          RawName);
+        if (!write_ok)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+        }
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        return true;
+    }
+
+    /* done once the end of the received file is reached, not before */
+    return at_end;
+}
@@ -0,0 +1,198 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Per-file compression of sent files
+ *
+ * A transaction started with a compression method other than
+ * CF_Compress_NONE does not send its source file directly.  The file is
+ * compressed into the temp directory before the MD PDU is sent, a few blocks
+ * per wakeup, and the compressed copy is what the PDUs carry: the MD file
+ * size, the file data offsets, the EOF checksum and any retransmission all
+ * refer to it.  The method is announced to the receiver with a message to
+ * user TLV in the MD PDU, and the receiver decompresses the file the same
+ * way once its checksum is verified, before storing it under its
+ * destination name.
+ *
+ * The compressed file is made of a CF_CompressHeader_t followed by blocks
+ * of at most CF_COMPRESS_BLOCK_SIZE bytes of the original file.  Each block
+ * has a 2 byte big endian header holding the length of the data that follows,
+ * with CF_COMPRESS_BLOCK_STORED set if the data is the original bytes (the
+ * block did not compress).  Otherwise the data is an LZ4 block (sequences of
+ * literals and matches, as defined by the LZ4 block format).  Each block is
+ * compressed on its own, so both ends only need one block of memory.
+ */
+
+#ifndef CF_COMPRESS_H
+#define CF_COMPRESS_H
+
+#include "cf_cfdp_types.h"
+#include "cf_cfdp_pdu.h"
+#include "cf_logical_pdu.h"
+
+/**
+ * @brief Value of the magic field of a compressed file header ("CFZ1")
+ */
+#define CF_COMPRESS_MAGIC 0x43465A31
+
+/**
+ * @brief Largest number of bytes of the original file in one block
+ */
+#define CF_COMPRESS_BLOCK_SIZE 4096
+
+/**
+ * @brief Flag in the block header, the block holds the original bytes
+ */
+#define CF_COMPRESS_BLOCK_STORED 0x8000
+
+/**
+ * @brief Number of bits of the hash of the match finder, its table uses 2 bytes per entry
+ */
+#define CF_COMPRESS_HASH_BITS 12
+
+/**
+ * @brief Suffix of the temp file holding the compressed copy of a file being sent
+ */
+#define CF_COMPRESS_TX_SUFFIX ".z"
+
+/**
+ * @brief Suffix of the temp file holding the decompressed copy of a file received
+ */
+#define CF_COMPRESS_RX_SUFFIX ".raw"
+
+/**
+ * @brief Length of the message to user TLV that announces the compression method in the MD PDU
+ */
+#define CF_COMPRESS_MSG_LEN 4
+
+/**
+ * @brief Compressed file header
+ */
+typedef struct CF_CompressHeader
+{
+    CF_CFDP_uint32_t magic;    /**< \brief always CF_COMPRESS_MAGIC */
+    CF_CFDP_uint8_t  method;   /**< \brief CF_Compress_t used for the blocks */
+    CF_CFDP_uint8_t  spare[3]; /**< \brief always 0 */
+    CF_CFDP_uint32_t size;     /**< \brief size of the original file */
+} CF_CompressHeader_t;
+
+/************************************************************************/
+/** @brief Announces the compression of the file in an outgoing MD PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       md must not be NULL.  Nothing is added for CF_Compress_NONE, or if the
+ *       TLV list is full.
+ *
+ * @param md      Logical MD PDU being built
+ * @param method  CF_Compress_t applied to the file
+ */
+void CF_Compress_SetMd(CF_Logical_PduMd_t *md, uint8 method);
+
+/************************************************************************/
+/** @brief Gets the compression of the file announced in an incoming MD PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       md must not be NULL.  The value is returned as sent, an unknown method
+ *       is rejected when the file is decompressed.
+ *
+ * @param md  Logical MD PDU received
+ *
+ * @returns CF_Compress_t applied to the file by the sender
+ */
+uint8 CF_Compress_GetMd(const CF_Logical_PduMd_t *md);
+
+/************************************************************************/
+/** @brief Gets the name of the compressed or decompressed copy of the file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       hist, suffix and buf must not be NULL.  The file is in the temp directory.
+ *
+ * @param hist      History of the transaction
+ * @param suffix    CF_COMPRESS_TX_SUFFIX or CF_COMPRESS_RX_SUFFIX
+ * @param buf       Output buffer for the full path of the file
+ * @param buf_size  Size of buf
+ */
+void CF_Compress_GetTempName(const CF_History_t *hist, const char *suffix, char *buf, size_t buf_size);
+
+/************************************************************************/
+/** @brief Starts writing the compressed copy of the file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  The compressed file is created in the temp
+ *       directory and left open in txn->fd, the blocks are written by
+ *       CF_Compress_FileStep().  On failure an event is sent, the fault
+ *       counter is incremented and the transaction status is set.
+ *
+ * @param txn  Transaction sending the file, with the method in txn->compress
+ *
+ * @retval CFE_SUCCESS if the compressed file was started
+ * @retval CF_ERROR on failure
+ */
+CFE_Status_t CF_Compress_FileStart(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Writes the next blocks of the compressed copy of the file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and CF_Compress_FileStart() must have succeeded.
+ *       At most CF_COMPRESS_BLOCKS_PER_WAKEUP blocks are written, fewer once the
+ *       wakeup budget is spent.  When the file is done, or on failure, txn->fd
+ *       is closed.  On failure an event is sent, the fault counter is
+ *       incremented and the transaction status is set.
+ *
+ * @param txn  Transaction sending the file
+ *
+ * @returns true if the compressed file is done or failed, false if more blocks are left
+ */
+bool CF_Compress_FileStep(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Starts writing the decompressed copy of the file received by a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and txn->fd must be the open received file.
+ *       Checks its header and creates the decompressed file in the temp
+ *       directory, the blocks are written by CF_Compress_ExpandStep().  On
+ *       failure an event is sent and the transaction status is set.
+ *
+ * @param txn  Transaction receiving the file
+ *
+ * @retval CFE_SUCCESS if the decompressed file was started
+ * @retval CF_ERROR if the file is not valid or could not be created
+ */
+CFE_Status_t CF_Compress_ExpandStart(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Writes the next blocks of the decompressed copy of the file received by a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and CF_Compress_ExpandStart() must have succeeded.
+ *       At most CF_COMPRESS_BLOCKS_PER_WAKEUP blocks are written, fewer once the
+ *       wakeup budget is spent.  On failure an event is sent and the transaction
+ *       status is set, the decompressed file is removed when the file is retained.
+ *
+ * @param txn  Transaction receiving the file
+ *
+ * @returns true if the decompressed file is done or failed, false if more blocks are left
+ */
+bool CF_Compress_ExpandStep(CF_Transaction_t *txn);
+
+#endif /* !CF_COMPRESS_H */
@@ -0,0 +1,656 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application delta transfer
+ *
+ * Only the blocks of a re-sent file that changed since the previous send are
+ * transferred.  See cf_delta.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_utils.h"
+#include "cf_cfdp.h"
+#include "cf_delta.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+#define CF_DELTA_FNV_OFFSET 2166136261U
+#define CF_DELTA_FNV_PRIME  16777619U
+
+/* announces a delta transfer in the MD PDU */
+static const uint8 CF_Delta_MdMsg[CF_DELTA_MSG_LEN] = {'C', 'F', 'D', 1};
+
+/* files are hashed and copied by the CF task only, so the buffer does not need to be on the stack */
+static uint8 CF_Delta_Buf[CF_DELTA_MAX_BLOCK_SIZE];
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Delta_IsEnabled(const CF_Transaction_t *txn)
+{
+    return CF_AppData.config_table->chan[txn->chan_num].delta_block_size != 0 && txn->reliable_mode &&
+           txn->compress == CF_Compress_NONE && !txn->flags.tx.bundle;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the name of the signature file being written by a transaction.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_GetPendingName(const CF_History_t *hist, char *buf, size_t buf_size)
+{
+    snprintf(buf,
+             buf_size,
+             "%.*s/%lu_%lu%s",
+             CF_FILENAME_MAX_PATH - 1,
+             CF_AppData.config_table->tmp_dir,
+             (unsigned long)hist->src_eid,
+             (unsigned long)hist->seq_num,
+             CF_DELTA_SIG_SUFFIX);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Fills in the signature file header of the file of a send transaction.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_InitHeader(const CF_Transaction_t *txn, CF_DeltaSigHeader_t *hdr)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic      = CF_DELTA_MAGIC;
+    hdr->block_size = CF_AppData.config_table->chan[txn->chan_num].delta_block_size;
+    hdr->name_hash  = CF_Delta_Hash(txn->history->fnames.dst_filename, strlen(txn->history->fnames.dst_filename));
+    hdr->fsize      = txn->fsize;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Removes a signature file that could not be written, later steps of the scan then skip it.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_DropPending(const char *name)
+{
+    CFE_EVS_SendEvent(CF_DELTA_ERR_EID, CFE_EVS_EventType_ERROR, "CF: failed to write signature file %s", name);
+    OS_remove(name);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Opens the signature file of the previous send at the hash of block first, returns the number of blocks
+ * it has (0 if there is none).
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Delta_OpenPrevious(const CF_Transaction_t *txn, const CF_DeltaSigHeader_t *hdr, uint32 first,
+                                    osal_id_t *fd, CF_FileSize_t *prev_size)
+{
+    CF_DeltaSigHeader_t prev;
+    char                name[CFE_MISSION_MAX_PATH_LEN];
+    CF_FileSize_t       pos;
+    uint32              num_blocks = 0;
+
+    CF_Delta_GetSigName(txn->history->peer_eid, txn->history->fnames.dst_filename, name, sizeof(name));
+    if (CF_WrappedOpenCreate(fd, name, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        *fd = OS_OBJECT_ID_UNDEFINED;
+    }
+    else if (CF_WrappedRead(*fd, &prev, sizeof(prev)) == sizeof(prev) && prev.magic == hdr->magic &&
+             prev.block_size == hdr->block_size && prev.name_hash == hdr->name_hash)
+    {
+        num_blocks = (prev.fsize + prev.block_size - 1) / prev.block_size;
+        *prev_size = prev.fsize;
+
+        pos = sizeof(prev) + first * sizeof(uint32);
+        if (first != 0 && first < num_blocks && CF_WrappedLseek(*fd, pos, OS_SEEK_SET) != pos)
+        {
+            num_blocks = 0;
+        }
+    }
+
+    return num_blocks;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Selects the blocks to send once the whole file of a send transaction is hashed.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_ScanDone(CF_Transaction_t *txn, bool read_ok)
+{
+    CF_ChunkList_t *chunks  = &txn->chunks->chunks;
+    CF_FileSize_t   changed = txn->state_data.delta_changed;
+    CF_FileSize_t   covered;
+    CF_ChunkIdx_t   i;
+
+    /* the chunk list drops the smallest ranges when it is full, and then it does not hold all the changes */
+    covered = 0;
+    for (i = 0; i < chunks->count; ++i)
+    {
+        covered += CF_ChunkList_At(chunks, i)->size;
+    }
+
+    /* this is not where a whole send starts, so the first file data PDU seeks back */
+    txn->state_data.cached_pos = txn->fsize;
+
+    if (read_ok && changed < txn->fsize && covered == changed)
+    {
+        CFE_EVS_SendEvent(CF_DELTA_SEND_INF_EID,
+                          CFE_EVS_EventType_INFORMATION,
+                          "CF S%d(%lu:%lu): delta transfer of %s, %lu of %lu bytes changed",
+                          CF_CFDP_GetPrintClass(txn),
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.src_filename,
+                          (unsigned long)changed,
+                          (unsigned long)txn->fsize);
+
+        /* the changed blocks are sent the same way as data requested by a NAK */
+        txn->flags.tx.delta          = true;
+        txn->flags.tx.fd_nak_pending = (changed != 0);
+        txn->foffs                   = txn->fsize;
+    }
+    else
+    {
+        /* send the whole file, computing the checksum again as it goes */
+        CF_ChunkListReset(chunks);
+        CF_CRC_Start(&txn->crc);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the part of CF_Delta_Buf that goes at offset and is not in the chunk list of a receive
+ * transaction.  File data that arrived from the sender while the copy goes on is not overwritten.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Delta_WriteMissing(CF_Transaction_t *txn, CF_FileSize_t offset, CF_FileSize_t len)
+{
+    const CF_ChunkList_t *chunks = &txn->chunks->chunks;
+    const CF_Chunk_t     *chunk;
+    CF_ChunkIdx_t         i   = 0;
+    CF_FileSize_t         pos = offset;
+    CF_FileSize_t         end = offset + len;
+    CF_FileSize_t         stop;
+    bool                  ok = true;
+
+    while (ok && pos < end)
+    {
+        /* the chunks are in offset order, the ones that end before pos do not matter */
+        chunk = NULL;
+        while (i < chunks->count && chunk == NULL)
+        {
+            chunk = CF_ChunkList_At(chunks, i);
+            if ((chunk->offset + chunk->size) <= pos)
+            {
+                chunk = NULL;
+                ++i;
+            }
+        }
+
+        if (chunk != NULL && chunk->offset <= pos)
+        {
+            /* already received */
+            pos = chunk->offset + chunk->size;
+        }
+        else
+        {
+            stop = (chunk != NULL && chunk->offset < end) ? chunk->offset : end;
+
+            if (txn->state_data.cached_pos != pos)
+            {
+                ok = (CF_WrappedLseek(txn->fd, pos, OS_SEEK_SET) == pos);
+            }
+            if (ok)
+            {
+                ok = (CF_WrappedWrite(txn->fd, &CF_Delta_Buf[pos - offset], stop - pos) == (stop - pos));
+            }
+
+            txn->state_data.cached_pos = stop;
+            pos                        = stop;
+        }
+    }
+
+    return ok;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Delta_Hash(const void *data, size_t len)
+{
+    const uint8 *p    = data;
+    uint32       hash = CF_DELTA_FNV_OFFSET;
+
+    while (len > 0)
+    {
+        hash = (hash ^ *p) * CF_DELTA_FNV_PRIME;
+        ++p;
+        --len;
+    }
+
+    return hash;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_GetSigName(CF_EntityId_t peer_eid, const char *dst_filename, char *buf, size_t buf_size)
+{
+    snprintf(buf,
+             buf_size,
+             "%.*s/d%lu_%08lx%s",
+             CF_FILENAME_MAX_PATH - 1,
+             CF_AppData.config_table->tmp_dir,
+             (unsigned long)peer_eid,
+             (unsigned long)CF_Delta_Hash(dst_filename, strlen(dst_filename)),
+             CF_DELTA_SIG_SUFFIX);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_ScanStart(CF_Transaction_t *txn)
+{
+    CF_DeltaSigHeader_t hdr;
+    char                name[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t           sig_fd;
+    bool                sig_ok;
+
+    if (!CF_Delta_IsEnabled(txn))
+    {
+        return false;
+    }
+
+    CF_Delta_InitHeader(txn, &hdr);
+
+    /* the signatures of this send replace the previous ones only once the peer has the file */
+    CF_Delta_GetPendingName(txn->history, name, sizeof(name));
+    sig_ok = CF_WrappedOpenCreate(&sig_fd, name, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE) >= 0;
+    if (sig_ok)
+    {
+        sig_ok = (CF_WrappedWrite(sig_fd, &hdr, sizeof(hdr)) == sizeof(hdr));
+        CF_WrappedClose(sig_fd);
+    }
+    if (!sig_ok)
+    {
+        CF_Delta_DropPending(name);
+    }
+
+    txn->state_data.delta_pos     = 0;
+    txn->state_data.delta_changed = 0;
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_ScanStep(CF_Transaction_t *txn)
+{
+    CF_DeltaSigHeader_t hdr;
+    char                name[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t           prev_fd;
+    osal_id_t           sig_fd;
+    uint32              first;
+    uint32              prev_blocks;
+    uint32              prev_hash;
+    uint32              hash;
+    uint32              count;
+    CF_FileSize_t       prev_size = 0;
+    CF_FileSize_t       prev_len;
+    CF_FileSize_t       offset;
+    CF_FileSize_t       sig_pos;
+    size_t              want;
+    int32               got;
+    bool                sig_open;
+    bool                sig_ok;
+    bool                read_ok = true;
+    bool                same;
+
+    CF_Delta_InitHeader(txn, &hdr);
+
+    /* every step but the last hashes whole blocks */
+    first       = txn->state_data.delta_pos / hdr.block_size;
+    prev_blocks = CF_Delta_OpenPrevious(txn, &hdr, first, &prev_fd, &prev_size);
+
+    /* the pending file is gone if it could not be written, this send then leaves no signatures */
+    CF_Delta_GetPendingName(txn->history, name, sizeof(name));
+    sig_open = (CF_WrappedOpenCreate(&sig_fd, name, OS_FILE_FLAG_NONE, OS_READ_WRITE) >= 0);
+    sig_ok   = sig_open;
+    if (sig_ok)
+    {
+        sig_pos = sizeof(hdr) + first * sizeof(hash);
+        sig_ok  = (CF_WrappedLseek(sig_fd, sig_pos, OS_SEEK_SET) == sig_pos);
+    }
+
+    for (count = 0; txn->state_data.delta_pos < txn->fsize && count < CF_DELTA_BLOCKS_PER_WAKEUP; ++count)
+    {
+        /* one block always goes, so the scan is done even if every wakeup runs out of time */
+        if (count != 0 && CF_CFDP_BudgetSpent())
+        {
+            break;
+        }
+
+        offset = txn->state_data.delta_pos;
+        want   = txn->fsize - offset;
+        if (want > hdr.block_size)
+        {
+            want = hdr.block_size;
+        }
+
+        /* nothing else moves the file while the transaction is in PREPARE, it is read in order */
+        got = CF_WrappedRead(txn->fd, CF_Delta_Buf, want);
+        if (got != want)
+        {
+            read_ok = false;
+            break;
+        }
+
+        CF_CRC_Digest(&txn->crc, CF_Delta_Buf, got);
+        hash = CF_Delta_Hash(CF_Delta_Buf, got);
+
+        if (sig_ok && CF_WrappedWrite(sig_fd, &hash, sizeof(hash)) != sizeof(hash))
+        {
+            sig_ok = false;
+        }
+
+        /* a block is the same if it has the same hash and length as the block at the same offset */
+        same = false;
+        if ((offset / hdr.block_size) < prev_blocks)
+        {
+            if (CF_WrappedRead(prev_fd, &prev_hash, sizeof(prev_hash)) != sizeof(prev_hash))
+            {
+                prev_blocks = 0;
+            }
+            else
+            {
+                prev_len = prev_size - offset;
+                if (prev_len > hdr.block_size)
+                {
+                    prev_len = hdr.block_size;
+                }
+                same = (prev_hash == hash && prev_len == got);
+            }
+        }
+
+        if (!same)
+        {
+            CF_ChunkListAdd(&txn->chunks->chunks, offset, got);
+            txn->state_data.delta_changed += got;
+        }
+
+        txn->state_data.delta_pos += got;
+    }
+
+    if (OS_ObjectIdDefined(prev_fd))
+    {
+        CF_WrappedClose(prev_fd);
+    }
+    if (sig_open)
+    {
+        CF_WrappedClose(sig_fd);
+        if (!sig_ok)
+        {
+            CF_Delta_DropPending(name);
+        }
+    }
+
+    if (read_ok && txn->state_data.delta_pos < txn->fsize)
+    {
+        /* more blocks on the next wakeup */
+        return false;
+    }
+
+    CF_Delta_ScanDone(txn, read_ok);
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_Finish(CF_Transaction_t *txn)
+{
+    char pending[CFE_MISSION_MAX_PATH_LEN];
+    char name[CFE_MISSION_MAX_PATH_LEN];
+
+    if (CF_Delta_IsEnabled(txn))
+    {
+        CF_Delta_GetPendingName(txn->history, pending, sizeof(pending));
+
+        if (CF_CFDP_TxnIsOK(txn) && txn->flags.com.is_complete &&
+            txn->state_data.fin_fs == CF_CFDP_FinFileStatus_RETAINED &&
+            txn->state_data.fin_dc == CF_CFDP_FinDeliveryCode_COMPLETE)
+        {
+            CF_Delta_GetSigName(txn->history->peer_eid, txn->history->fnames.dst_filename, name, sizeof(name));
+            OS_mv(pending, name);
+        }
+        else
+        {
+            OS_remove(pending);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_SetMd(const CF_Transaction_t *txn, CF_Logical_PduMd_t *md)
+{
+    CF_Logical_Tlv_t *tlv;
+
+    if (txn->flags.tx.delta && md->tlv_list.num_tlv < CF_PDU_MAX_TLV)
+    {
+        tlv                = &md->tlv_list.tlv[md->tlv_list.num_tlv];
+        tlv->type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+        tlv->length        = CF_DELTA_MSG_LEN;
+        tlv->data.data_ptr = CF_Delta_MdMsg;
+        ++md->tlv_list.num_tlv;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_GetMd(const CF_Logical_PduMd_t *md)
+{
+    const CF_Logical_Tlv_t *tlv;
+    bool                    delta = false;
+    uint8                   i;
+
+    for (i = 0; i < md->tlv_list.num_tlv; ++i)
+    {
+        tlv = &md->tlv_list.tlv[i];
+
+        /* other messages to user are not for CF */
+        if (tlv->type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER && tlv->length == CF_DELTA_MSG_LEN &&
+            tlv->data.data_ptr != NULL && memcmp(tlv->data.data_ptr, CF_Delta_MdMsg, CF_DELTA_MSG_LEN) == 0)
+        {
+            delta = true;
+        }
+    }
+
+    return delta;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_PrefillStart(CF_Transaction_t *txn)
+{
+    /* data that already arrived must not be overwritten, those blocks are NAKed as usual */
+    if (txn->chunks->chunks.count == 0 && OS_ObjectIdDefined(txn->fd))
+    {
+        txn->flags.rx.prefill     = true;
+        txn->state_data.delta_pos = 0;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_PrefillStep(CF_Transaction_t *txn)
+{
+    osal_id_t src;
+    uint32    count;
+    size_t    want;
+    int32     got;
+    bool      more;
+    bool      write_ok = true;
+
+    if (CF_WrappedOpenCreate(&src, txn->history->fnames.dst_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        /* there is no existing file, everything the sender did not send is NAKed */
+        txn->flags.rx.prefill = false;
+        return;
+    }
+
+    more = (txn->state_data.delta_pos < txn->fsize &&
+            CF_WrappedLseek(src, txn->state_data.delta_pos, OS_SEEK_SET) == txn->state_data.delta_pos);
+
+    for (count = 0; more && write_ok && count < CF_DELTA_BLOCKS_PER_WAKEUP; ++count)
+    {
+        /* one block always goes, so the copy is done even if every wakeup runs out of time */
+        if (count != 0 && CF_CFDP_BudgetSpent())
+        {
+            break;
+        }
+
+        want = txn->fsize - txn->state_data.delta_pos;
+        if (want > sizeof(CF_Delta_Buf))
+        {
+            want = sizeof(CF_Delta_Buf);
+        }
+
+        got = CF_WrappedRead(src, CF_Delta_Buf, want);
+        if (got <= 0)
+        {
+            /* the existing file is shorter, the rest is NAKed if the sender did not send it */
+            more = false;
+        }
+        else
+        {
+            write_ok = CF_Delta_WriteMissing(txn, txn->state_data.delta_pos, got);
+            if (write_ok)
+            {
+                CF_ChunkListAdd(&txn->chunks->chunks, txn->state_data.delta_pos, got);
+                txn->state_data.delta_pos += got;
+                if (txn->state_data.delta_pos > txn->state_data.rx_progress)
+                {
+                    txn->state_data.rx_progress = txn->state_data.delta_pos;
+                }
+                txn->flags.rx.delta = true;
+
+                more = (txn->state_data.delta_pos < txn->fsize);
+            }
+        }
+    }
+
+    CF_WrappedClose(src);
+
+    if (!write_ok)
+    {
+        /* what was copied so far stays, the rest is NAKed */
+        CFE_EVS_SendEvent(CF_DELTA_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to copy %s into the temp file",
+                          CF_CFDP_GetPrintClass(txn),
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.dst_filename);
+        CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET);
+        txn->state_data.cached_pos = 0;
+        txn->flags.rx.prefill      = false;
+    }
+    else if (!more)
+    {
+        txn->flags.rx.prefill = false;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_Restart(CF_Transaction_t *txn)
+{
+    CFE_EVS_SendEvent(CF_DELTA_RETRY_INF_EID,
+                      CFE_EVS_EventType_INFORMATION,
+                      "CF R%d(%lu:%lu): local copy of %s does not match, requesting the whole file",
+                      CF_CFDP_GetPrintClass(txn),
+                      (unsigned long)txn->history->src_eid,
+                      (unsigned long)txn->history->seq_num,
+                      txn->history->fnames.dst_filename);
+
+    CF_ChunkListReset(&txn->chunks->chunks);
+
+    txn->flags.rx.delta         = false;
+    txn->flags.com.is_complete  = false;
+    txn->flags.com.crc_complete = false;
+}
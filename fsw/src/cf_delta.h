@@ -0,0 +1,231 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Delta transfer of re-sent files
+ *
+ * On a channel with a nonzero delta_block_size, a class 2 sender keeps a
+ * signature file for each destination file (and peer) it delivered: the hash
+ * of each block of delta_block_size bytes of the file as it was sent.  When
+ * the same destination is sent again, the blocks of the new file are hashed
+ * and compared to the stored ones, a few blocks per wakeup, before the MD PDU
+ * is sent.  Only the blocks that changed are put in the chunk list of the
+ * transaction, and sent the same way as data requested by a NAK, before the
+ * EOF.
+ *
+ * The MD PDU announces such a transfer with a message to user TLV.  The
+ * receiver then copies its existing destination file into the temp file, a
+ * few blocks per wakeup, and marks it as received, so the file data PDUs only
+ * fill in the blocks that changed.  It holds the EOF processing and the NAKs
+ * until the copy is done.  The EOF checksum still covers the whole file: if the local copy
+ * was not what the sender expected, the checksum does not match and the
+ * receiver discards the copy and NAKs the whole file instead.
+ *
+ * The blocks are compared at the same offsets, data moved within the file is
+ * sent again.  The signature file is only replaced once the peer reports the
+ * new file as complete and retained.
+ */
+
+#ifndef CF_DELTA_H
+#define CF_DELTA_H
+
+#include "cf_cfdp_types.h"
+#include "cf_logical_pdu.h"
+
+/**
+ * @brief Value of the magic field of a signature file header ("CFD1")
+ */
+#define CF_DELTA_MAGIC 0x43464431
+
+/**
+ * @brief Largest block size that can be configured for delta transfers
+ */
+#define CF_DELTA_MAX_BLOCK_SIZE 4096
+
+/**
+ * @brief Length of the message to user TLV that announces a delta transfer in the MD PDU
+ */
+#define CF_DELTA_MSG_LEN 4
+
+/**
+ * @brief Suffix of the signature file written while a transaction is running
+ */
+#define CF_DELTA_SIG_SUFFIX ".sig"
+
+/**
+ * @brief Signature file header
+ *
+ * This is followed by one uint32 hash for each block of the file.  The file
+ * is native-format binary, only read back by the CF build that wrote it.
+ */
+typedef struct CF_DeltaSigHeader
+{
+    uint32        magic;      /**< \brief always CF_DELTA_MAGIC */
+    uint32        block_size; /**< \brief size of the blocks that were hashed */
+    uint32        name_hash;  /**< \brief hash of the destination file name */
+    CF_FileSize_t fsize;      /**< \brief size of the file that was sent */
+} CF_DeltaSigHeader_t;
+
+/************************************************************************/
+/** @brief Computes the hash of a block of data, or of a file name.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       data must not be NULL if len is nonzero.  This is the 32 bit FNV-1a hash.
+ *
+ * @param data  Data to hash
+ * @param len   Number of bytes of data
+ *
+ * @returns Hash of the data
+ */
+uint32 CF_Delta_Hash(const void *data, size_t len);
+
+/************************************************************************/
+/** @brief Gets the name of the signature file of a destination file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       dst_filename and buf must not be NULL.  The file is in the temp directory.
+ *
+ * @param peer_eid      Entity the file is sent to
+ * @param dst_filename  Name of the file at the peer
+ * @param buf           Output buffer for the full path of the file
+ * @param buf_size      Size of buf
+ */
+void CF_Delta_GetSigName(CF_EntityId_t peer_eid, const char *dst_filename, char *buf, size_t buf_size);
+
+/************************************************************************/
+/** @brief Starts hashing the file of a send transaction, to select the blocks to send.
+ *
+ * Does nothing unless delta transfers are enabled on the channel, the
+ * transaction is class 2 and its file is neither compressed nor a bundle.
+ * Otherwise the signature file of this send is created, and the file is then
+ * hashed by CF_Delta_ScanStep().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  txn->fd is open at the start of the file,
+ *       txn->fsize is set and the checksum was started.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval true if the file is to be hashed before the MD PDU is sent
+ * @retval false if this is not a delta transfer
+ */
+bool CF_Delta_ScanStart(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Hashes the next blocks of the file of a send transaction.
+ *
+ * The signatures of the file are written for the next send.  Once the whole
+ * file is hashed, if the previous signature file shows that some blocks did
+ * not change, the changed blocks are put in the chunk list of the
+ * transaction and flags.tx.delta is set.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  CF_Delta_ScanStart() returned true.  At most
+ *       CF_DELTA_BLOCKS_PER_WAKEUP blocks are hashed, fewer once the wakeup
+ *       budget is spent.  The checksum of the whole file is computed here; if
+ *       the transaction is not a delta transfer it is started again.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval true if the whole file is hashed, or it could not be read
+ * @retval false if there is more to hash on the next wakeup
+ */
+bool CF_Delta_ScanStep(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Keeps or discards the signatures written by CF_Delta_ScanStep().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  The signatures replace those of the previous
+ *       send only if the peer reported the file as complete and retained.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Delta_Finish(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Announces a delta transfer in an outgoing MD PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn and md must not be NULL.  Nothing is added unless flags.tx.delta
+ *       is set, or if the TLV list is full.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param md   Logical MD PDU being built
+ */
+void CF_Delta_SetMd(const CF_Transaction_t *txn, CF_Logical_PduMd_t *md);
+
+/************************************************************************/
+/** @brief Checks whether an incoming MD PDU announces a delta transfer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       md must not be NULL.
+ *
+ * @param md  Logical MD PDU received
+ *
+ * @retval true if the sender only sends the blocks that changed
+ * @retval false otherwise
+ */
+bool CF_Delta_GetMd(const CF_Logical_PduMd_t *md);
+
+/************************************************************************/
+/** @brief Starts copying the existing destination file into the temp file of a receive transaction.
+ *
+ * Sets flags.rx.prefill, the copy is then done by CF_Delta_PrefillStep().
+ * Nothing is done if file data was already received.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  The MD PDU was received and the temp file is open.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Delta_PrefillStart(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Copies the next blocks of the existing destination file into the temp file.
+ *
+ * The bytes copied are marked as received in the chunk list and
+ * flags.rx.delta is set.  Bytes already received from the sender are not
+ * overwritten.  flags.rx.prefill is cleared once the copy is done, or if
+ * the destination file does not exist, is shorter, or cannot be copied.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  flags.rx.prefill is set.  At most
+ *       CF_DELTA_BLOCKS_PER_WAKEUP blocks of CF_DELTA_MAX_BLOCK_SIZE bytes are
+ *       copied, fewer once the wakeup budget is spent.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Delta_PrefillStep(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Discards the copied data of a receive transaction whose checksum did not match.
+ *
+ * The chunk list is emptied, so the whole file is NAKed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Delta_Restart(CF_Transaction_t *txn);
+
+#endif /* !CF_DELTA_H */
@@ -0,0 +1,277 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application wakeup timing diagnostics
+ *
+ * Histograms of the time taken by the phases of each wakeup.
+ * See cf_diag.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_diag.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the microseconds since a mark, and sets the mark to now.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Diag_Elapsed(OS_time_t *mark)
+{
+    OS_time_t now;
+    int64     us;
+
+    OS_GetLocalTime(&now);
+    us    = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, *mark));
+    *mark = now;
+
+    /* the local clock may be set back */
+    if (us < 0)
+    {
+        us = 0;
+    }
+    else if (us > UINT32_MAX)
+    {
+        us = UINT32_MAX;
+    }
+
+    return (uint32)us;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Adds a sample to a histogram.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Diag_Record(CF_DiagHistogram_t *hist, uint64 *sum_us, uint32 us)
+{
+    uint32 idx = 0;
+    uint32 val = us;
+
+    /* bucket i holds 2^(i-1) to 2^i - 1 microseconds, the last one everything longer */
+    while (val != 0 && idx < (CF_DIAG_HIST_BUCKETS - 1))
+    {
+        val >>= 1;
+        ++idx;
+    }
+
+    if (hist->count == 0 || us < hist->min_us)
+    {
+        hist->min_us = us;
+    }
+    if (us > hist->max_us)
+    {
+        hist->max_us = us;
+    }
+
+    ++hist->buckets[idx];
+    ++hist->count;
+    *sum_us += us;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Sets the average and the 99th percentile of a histogram.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Diag_Summarize(CF_DiagHistogram_t *hist, uint64 sum_us)
+{
+    uint32 rank;
+    uint32 seen = 0;
+    uint32 idx;
+
+    if (hist->count == 0)
+    {
+        hist->avg_us = 0;
+        hist->p99_us = 0;
+        return;
+    }
+
+    hist->avg_us = (uint32)(sum_us / hist->count);
+
+    /* the percentile is the top of its bucket, the samples are not kept */
+    rank = hist->count - (hist->count / 100);
+    for (idx = 0; idx < (CF_DIAG_HIST_BUCKETS - 1); ++idx)
+    {
+        seen += hist->buckets[idx];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    if (idx == (CF_DIAG_HIST_BUCKETS - 1) || ((1UL << idx) - 1) > hist->max_us)
+    {
+        hist->p99_us = hist->max_us;
+    }
+    else
+    {
+        hist->p99_us = (uint32)((1UL << idx) - 1);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Init(void)
+{
+    CFE_MSG_Init(CFE_MSG_PTR(CF_AppData.diag.pkt.TelemetryHeader),
+                 CFE_SB_ValueToMsgId(CF_DIAG_TLM_MID),
+                 sizeof(CF_AppData.diag.pkt));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Mark(OS_time_t *mark)
+{
+    OS_GetLocalTime(mark);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Lap(uint8 chan_num, CF_DiagPhase_t phase, OS_time_t *mark)
+{
+    uint32 us = CF_Diag_Elapsed(mark);
+
+    CF_AppData.diag.wakeup_us[chan_num][phase] += us;
+    CF_AppData.diag.wakeup_ran[chan_num] |= (1UL << phase);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_EndChannel(uint8 chan_num)
+{
+    CF_Diag_t *diag = &CF_AppData.diag;
+    int        i;
+
+    for (i = 0; i < CF_DiagPhase_NUM; ++i)
+    {
+        if (diag->wakeup_ran[chan_num] & (1UL << i))
+        {
+            CF_Diag_Record(&diag->pkt.Payload.channel[chan_num].phase[i],
+                           &diag->phase_sum_us[chan_num][i],
+                           diag->wakeup_us[chan_num][i]);
+        }
+
+        diag->wakeup_us[chan_num][i] = 0;
+    }
+
+    diag->wakeup_ran[chan_num] = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_EndCycle(const OS_time_t *start)
+{
+    CF_Diag_t *diag = &CF_AppData.diag;
+    OS_time_t  mark = *start;
+    uint32     us   = CF_Diag_Elapsed(&mark);
+
+    CF_Diag_Record(&diag->pkt.Payload.cycle, &diag->cycle_sum_us, us);
+
+    diag->pkt.Payload.slot_us = 1000000 / CF_AppData.config_table->ticks_per_second;
+    if (us > diag->pkt.Payload.slot_us)
+    {
+        ++diag->pkt.Payload.overruns;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Reset(void)
+{
+    CF_Diag_t *diag = &CF_AppData.diag;
+
+    memset(&diag->pkt.Payload, 0, sizeof(diag->pkt.Payload));
+    memset(diag->phase_sum_us, 0, sizeof(diag->phase_sum_us));
+    diag->cycle_sum_us = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Update(void)
+{
+    CF_Diag_t *diag = &CF_AppData.diag;
+    int        i;
+    int        j;
+
+    CF_Diag_Summarize(&diag->pkt.Payload.cycle, diag->cycle_sum_us);
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        for (j = 0; j < CF_DiagPhase_NUM; ++j)
+        {
+            CF_Diag_Summarize(&diag->pkt.Payload.channel[i].phase[j], diag->phase_sum_us[i][j]);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_diag.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Diag_Send(void)
+{
+    CF_Diag_t *diag = &CF_AppData.diag;
+
+    CF_Diag_Update();
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(diag->pkt.TelemetryHeader));
+    /* return value ignored */ CFE_SB_TransmitMsg(CFE_MSG_PTR(diag->pkt.TelemetryHeader), true);
+}
@@ -0,0 +1,119 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Time taken by the phases of each engine wakeup
+ *
+ * Every wakeup times, on each channel, the receipt of the PDUs, the ticks of
+ * the receive and send transactions, the NAK answers, the new file data, the
+ * playback directories and the polling directories, with the local clock of
+ * OSAL.  The time of a phase during one wakeup is a sample of its histogram,
+ * as is the time of the whole wakeup.  The histograms have one bucket per
+ * power of two microseconds, and are sent in the diagnostics packet with
+ * each housekeeping packet, until the reset counters command clears them.
+ * The flush of the output PDUs and the journal checkpoints count in the
+ * time of the whole wakeup only.
+ */
+
+#ifndef CF_DIAG_H
+#define CF_DIAG_H
+
+#include "cfe.h"
+#include "cf_msg.h"
+
+/**
+ * @brief Diagnostics state of the application
+ */
+typedef struct CF_Diag
+{
+    CF_DiagPacket_t pkt; /**< \brief histograms, see CF_Diag_Send() */
+
+    uint64 cycle_sum_us;                                    /**< \brief total of the wakeup times */
+    uint64 phase_sum_us[CF_NUM_CHANNELS][CF_DiagPhase_NUM]; /**< \brief total of the phase times */
+
+    uint32 wakeup_us[CF_NUM_CHANNELS][CF_DiagPhase_NUM]; /**< \brief time of the phases in the current wakeup */
+    uint32 wakeup_ran[CF_NUM_CHANNELS];                  /**< \brief phases run in the current wakeup, a bit each */
+} CF_Diag_t;
+
+/************************************************************************/
+/** @brief Initializes the diagnostics packet.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The application data must be zeroed.
+ */
+void CF_Diag_Init(void);
+
+/************************************************************************/
+/** @brief Gets the time a phase or wakeup starts.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       mark must not be NULL.
+ *
+ * @param mark  Set to the current time
+ */
+void CF_Diag_Mark(OS_time_t *mark);
+
+/************************************************************************/
+/** @brief Adds the time since a mark to a phase of the current wakeup of a channel.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       mark must not be NULL.  A phase may be added to several times in a wakeup,
+ *       the sum is its sample.
+ *
+ * @param chan_num  Channel number
+ * @param phase     Phase that just finished
+ * @param mark      Start of the phase, set to the current time to start the next one
+ */
+void CF_Diag_Lap(uint8 chan_num, CF_DiagPhase_t phase, OS_time_t *mark);
+
+/************************************************************************/
+/** @brief Adds the phases of the current wakeup of a channel to their histograms.
+ *
+ * @param chan_num  Channel number
+ */
+void CF_Diag_EndChannel(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Adds the time of a wakeup to its histogram, and counts it if it overran its slot.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       start must not be NULL.  The slot is one wakeup period of the configuration table.
+ *
+ * @param start  Start of the wakeup, from CF_Diag_Mark()
+ */
+void CF_Diag_EndCycle(const OS_time_t *start);
+
+/************************************************************************/
+/** @brief Clears the histograms.
+ */
+void CF_Diag_Reset(void);
+
+/************************************************************************/
+/** @brief Updates the averages and percentiles of the histograms.
+ */
+void CF_Diag_Update(void);
+
+/************************************************************************/
+/** @brief Updates the averages and percentiles of the histograms, and sends the diagnostics packet.
+ */
+void CF_Diag_Send(void);
+
+#endif /* !CF_DIAG_H */
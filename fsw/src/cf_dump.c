@@ -0,0 +1,418 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application binary queue dump
+ *
+ * Writes the queues of a channel over several wakeups.
+ * See cf_dump.h for the details and the file format.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_dump.h"
+#include "cf_utils.h"
+
+#include <string.h>
+
+/**
+ * @brief A queue written by a dump
+ */
+typedef struct CF_DumpStage
+{
+    uint8 q_index; /**< \brief CF_QueueIdx_t of the queue */
+    uint8 dir;     /**< \brief CF_Direction_t of the history entries, CF_Direction_NUM for transactions */
+    uint8 type;    /**< \brief CF_Type_t that selects the queue */
+    uint8 queue;   /**< \brief CF_Queue_t that selects the queue */
+} CF_DumpStage_t;
+
+/**
+ * @brief The queues in the order they are written, the same as the text format
+ */
+static const CF_DumpStage_t CF_DUMP_STAGES[] = {
+    { CF_QueueIdx_RX, CF_Direction_NUM, CF_Type_up, CF_Queue_active },
+    { CF_QueueIdx_HIST, CF_Direction_RX, CF_Type_up, CF_Queue_history },
+    { CF_QueueIdx_TX, CF_Direction_NUM, CF_Type_down, CF_Queue_active },
+    { CF_QueueIdx_PEND, CF_Direction_NUM, CF_Type_down, CF_Queue_pend },
+    { CF_QueueIdx_HIST, CF_Direction_TX, CF_Type_down, CF_Queue_history },
+};
+
+#define CF_DUMP_NUM_STAGES (sizeof(CF_DUMP_STAGES) / sizeof(CF_DUMP_STAGES[0]))
+
+/**
+ * @brief Argument of the traversals of a queue being dumped
+ */
+typedef struct CF_DumpTraverseArg
+{
+    CF_Dump_t            *dump;  /**< \brief dump being written */
+    const CF_DumpStage_t *stage; /**< \brief queue being written */
+    uint32                skip;  /**< \brief entries at the start of the queue already written */
+    uint32                index; /**< \brief entries of the queue traversed */
+    bool                  full;  /**< \brief set when the buffer filled up */
+} CF_DumpTraverseArg_t;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Stores a big endian number of size octets.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Dump_Store(uint8 *octets, uint64 val, size_t size)
+{
+    while (size > 0)
+    {
+        --size;
+        octets[size] = val & 0xFF;
+        val >>= 8;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the history of a queue entry, NULL if the entry is not part of the dump.
+ *
+ *-----------------------------------------------------------------*/
+static const CF_History_t *CF_Dump_GetHistory(const CF_DumpStage_t *stage, CF_CListNode_t *node)
+{
+    const CF_History_t *history;
+
+    if (stage->q_index == CF_QueueIdx_HIST)
+    {
+        history = container_of(node, CF_History_t, cl_node);
+        if (history->dir != stage->dir)
+        {
+            history = NULL;
+        }
+    }
+    else
+    {
+        history = container_of(node, CF_Transaction_t, cl_node)->history;
+    }
+
+    return history;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Traversal callback that finds the last entry written, if it is still on the queue.
+ *
+ *-----------------------------------------------------------------*/
+static CF_CListTraverse_Status_t CF_Dump_FindLast(CF_CListNode_t *node, void *arg)
+{
+    CF_DumpTraverseArg_t     *context = arg;
+    const CF_History_t       *history = CF_Dump_GetHistory(context->stage, node);
+    CF_CListTraverse_Status_t ret     = CF_CLIST_CONT;
+
+    if (history != NULL)
+    {
+        ++context->index;
+
+        /* the entry may have been recycled for another transaction since */
+        if (node == context->dump->last && history->src_eid == context->dump->last_eid &&
+            history->seq_num == context->dump->last_seq)
+        {
+            context->skip = context->index;
+            ret           = CF_CLIST_EXIT;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Traversal callback that adds the entries not written yet to the buffer.
+ *
+ *-----------------------------------------------------------------*/
+static CF_CListTraverse_Status_t CF_Dump_AddRecord(CF_CListNode_t *node, void *arg)
+{
+    CF_DumpTraverseArg_t     *context = arg;
+    CF_Dump_t                *dump    = context->dump;
+    const CF_History_t       *history = CF_Dump_GetHistory(context->stage, node);
+    CF_CListTraverse_Status_t ret     = CF_CLIST_CONT;
+    CF_DumpRecord_t          *rec;
+
+    if (history != NULL)
+    {
+        if (context->index < context->skip)
+        {
+            ++context->index;
+        }
+        else
+        {
+            rec = &dump->buf[dump->fill];
+            memset(rec, 0, sizeof(*rec));
+
+            rec->queue.octets[0]    = context->stage->q_index;
+            rec->dir.octets[0]      = history->dir;
+            rec->txn_stat.octets[0] = (uint8)history->txn_stat;
+            CF_Dump_Store(rec->src_eid.octets, history->src_eid, sizeof(rec->src_eid));
+            CF_Dump_Store(rec->peer_eid.octets, history->peer_eid, sizeof(rec->peer_eid));
+            CF_Dump_Store(rec->seq_num.octets, history->seq_num, sizeof(rec->seq_num));
+            CF_Dump_Store(rec->start_secs.octets, history->metrics.start_secs, sizeof(rec->start_secs));
+            CF_Dump_Store(rec->start_subsecs.octets, history->metrics.start_subsecs, sizeof(rec->start_subsecs));
+            CF_Dump_Store(rec->first_pdu_ms.octets, history->metrics.first_pdu_ms, sizeof(rec->first_pdu_ms));
+            CF_Dump_Store(rec->eof_ms.octets, history->metrics.eof_ms, sizeof(rec->eof_ms));
+            CF_Dump_Store(rec->end_ms.octets, history->metrics.end_ms, sizeof(rec->end_ms));
+            CF_Dump_Store(rec->fd_bytes.octets, history->metrics.fd_bytes, sizeof(rec->fd_bytes));
+            CF_Dump_Store(rec->nak_rounds.octets, history->metrics.nak_rounds, sizeof(rec->nak_rounds));
+            CF_Dump_Store(rec->nak_segments.octets, history->metrics.nak_segments, sizeof(rec->nak_segments));
+            CF_Dump_Store(rec->peak_chunks.octets, history->metrics.peak_chunks, sizeof(rec->peak_chunks));
+            strncpy(rec->src_filename, history->fnames.src_filename, sizeof(rec->src_filename));
+            strncpy(rec->dst_filename, history->fnames.dst_filename, sizeof(rec->dst_filename));
+
+            dump->last     = node;
+            dump->last_eid = history->src_eid;
+            dump->last_seq = history->seq_num;
+            ++dump->pos;
+
+            ++dump->fill;
+            if (dump->fill >= CF_DUMP_RECORDS_PER_WRITE)
+            {
+                context->full = true;
+                ret           = CF_CLIST_EXIT;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Adds the entries of a queue not written yet to the buffer, returns true once
+ * the whole queue was added.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Dump_Stage(CF_Dump_t *dump, const CF_DumpStage_t *stage)
+{
+    CF_CListNode_t      *head = CF_AppData.engine.channels[dump->chan].qs[stage->q_index];
+    CF_DumpTraverseArg_t arg;
+
+    arg.dump  = dump;
+    arg.stage = stage;
+    arg.skip  = dump->pos;
+    arg.index = 0;
+    arg.full  = false;
+
+    /* the queue may have changed since the last wakeup, carry on after the last entry written */
+    if (dump->last != NULL)
+    {
+        /* histories are recycled from the front, so if that entry is gone, everything before it is too */
+        if (stage->q_index == CF_QueueIdx_HIST)
+        {
+            arg.skip = 0;
+        }
+
+        CF_CList_Traverse(head, CF_Dump_FindLast, &arg);
+        arg.index = 0;
+    }
+
+    CF_CList_Traverse(head, CF_Dump_AddRecord, &arg);
+
+    return !arg.full;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the records of the buffer to the file, returns false on failure.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Dump_Flush(CF_Dump_t *dump)
+{
+    size_t size = dump->fill * sizeof(CF_DumpRecord_t);
+    bool   ok   = true;
+
+    if (dump->fill > 0)
+    {
+        ok = (CF_WrappedWrite(dump->fd, dump->buf, size) == size);
+
+        dump->count += dump->fill;
+        dump->fill = 0;
+    }
+
+    return ok;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Writes the header again with the number of records, returns false on failure.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Dump_Complete(CF_Dump_t *dump)
+{
+    CF_Dump_Store(dump->hdr.count.octets, dump->count, sizeof(dump->hdr.count));
+    dump->hdr.flags.octets[0] = CF_DUMP_FLAG_COMPLETE;
+
+    return (CF_WrappedLseek(dump->fd, 0, OS_SEEK_SET) == 0 &&
+            CF_WrappedWrite(dump->fd, &dump->hdr, sizeof(dump->hdr)) == sizeof(dump->hdr));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_dump.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Dump_Start(const CF_WriteQueue_Payload_t *wq)
+{
+    CF_Dump_t         *dump = &CF_AppData.dump;
+    CFE_TIME_SysTime_t now;
+    int32              ret;
+
+    if (dump->busy)
+    {
+        CFE_EVS_SendEvent(CF_DUMP_BUSY_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: write queue to %s not started, %s still being written",
+                          wq->filename,
+                          dump->filename);
+        ++CF_AppData.hk.Payload.counters.err;
+    }
+    else
+    {
+        ret = CF_WrappedOpenCreate(&dump->fd, wq->filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+        if (ret < 0)
+        {
+            CFE_EVS_SendEvent(CF_CMD_WQ_OPEN_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: write queue failed to open file %s",
+                              wq->filename);
+            ++CF_AppData.hk.Payload.counters.err;
+        }
+        else
+        {
+            dump->chan  = wq->chan;
+            dump->type  = wq->type;
+            dump->queue = wq->queue;
+            dump->stage = 0;
+            dump->last  = NULL;
+            dump->pos   = 0;
+            dump->count = 0;
+            dump->fill  = 0;
+            strncpy(dump->filename, wq->filename, sizeof(dump->filename) - 1);
+            dump->filename[sizeof(dump->filename) - 1] = 0;
+
+            now = CFE_TIME_GetTime();
+            memset(&dump->hdr, 0, sizeof(dump->hdr));
+            CF_Dump_Store(dump->hdr.magic.octets, CF_DUMP_MAGIC, sizeof(dump->hdr.magic));
+            CF_Dump_Store(dump->hdr.version.octets, CF_DUMP_VERSION, sizeof(dump->hdr.version));
+            CF_Dump_Store(dump->hdr.header_size.octets, sizeof(CF_DumpHeader_t), sizeof(dump->hdr.header_size));
+            CF_Dump_Store(dump->hdr.record_size.octets, sizeof(CF_DumpRecord_t), sizeof(dump->hdr.record_size));
+            CF_Dump_Store(dump->hdr.filename_len.octets, CF_FILENAME_MAX_LEN, sizeof(dump->hdr.filename_len));
+            CF_Dump_Store(dump->hdr.time_secs.octets, now.Seconds, sizeof(dump->hdr.time_secs));
+            CF_Dump_Store(dump->hdr.time_subsecs.octets, now.Subseconds, sizeof(dump->hdr.time_subsecs));
+            dump->hdr.chan.octets[0]  = wq->chan;
+            dump->hdr.type.octets[0]  = wq->type;
+            dump->hdr.queue.octets[0] = wq->queue;
+
+            /* the header is written first, so a dump that never completes can be told apart */
+            if (CF_WrappedWrite(dump->fd, &dump->hdr, sizeof(dump->hdr)) != sizeof(dump->hdr))
+            {
+                CFE_EVS_SendEvent(CF_DUMP_WRITE_ERR_EID,
+                                  CFE_EVS_EventType_ERROR,
+                                  "CF: write queue failed to write %s",
+                                  dump->filename);
+                CF_WrappedClose(dump->fd);
+                ++CF_AppData.hk.Payload.counters.err;
+            }
+            else
+            {
+                dump->busy = true;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_dump.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Dump_Run(void)
+{
+    CF_Dump_t            *dump = &CF_AppData.dump;
+    const CF_DumpStage_t *stage;
+    bool                  ok;
+
+    if (dump->busy)
+    {
+        while (dump->stage < CF_DUMP_NUM_STAGES && dump->fill < CF_DUMP_RECORDS_PER_WRITE)
+        {
+            stage = &CF_DUMP_STAGES[dump->stage];
+
+            if (((dump->type != CF_Type_all) && (dump->type != stage->type)) ||
+                ((dump->queue != CF_Queue_all) && (dump->queue != stage->queue)) || CF_Dump_Stage(dump, stage))
+            {
+                /* on to the next queue */
+                ++dump->stage;
+                dump->last = NULL;
+                dump->pos  = 0;
+            }
+        }
+
+        ok = CF_Dump_Flush(dump);
+        if (ok && dump->stage >= CF_DUMP_NUM_STAGES)
+        {
+            ok = CF_Dump_Complete(dump);
+            if (ok)
+            {
+                CFE_EVS_SendEvent(CF_CMD_WQ_INF_EID,
+                                  CFE_EVS_EventType_INFORMATION,
+                                  "CF: write queue successful, %lu entries written to %s",
+                                  (unsigned long)dump->count,
+                                  dump->filename);
+                ++CF_AppData.hk.Payload.counters.cmd;
+
+                CF_WrappedClose(dump->fd);
+                dump->busy = false;
+            }
+        }
+
+        if (!ok)
+        {
+            CFE_EVS_SendEvent(CF_DUMP_WRITE_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: write queue failed to write %s",
+                              dump->filename);
+            ++CF_AppData.hk.Payload.counters.err;
+
+            CF_WrappedClose(dump->fd);
+            dump->busy = false;
+        }
+    }
+}
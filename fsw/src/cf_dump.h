@@ -0,0 +1,163 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Binary dump of the queues and history of a channel
+ *
+ * The write queue command with the binary format starts a dump, which is then
+ * written in the background: each wakeup adds up to CF_DUMP_RECORDS_PER_WRITE
+ * records to a buffer and writes it to the file at once, so a large history
+ * never holds up the engine.  Only one dump runs at a time.
+ *
+ * The file is a CF_DumpHeader_t followed by fixed size CF_DumpRecord_t records,
+ * all numbers big endian, in the order of the text format: RX active, RX
+ * history, TX active, TX pending and TX history.  The header is written again
+ * with the number of records and CF_DUMP_FLAG_COMPLETE once the dump is done.
+ *
+ * The dump is not a snapshot.  Each wakeup carries on after the last entry
+ * written, so entries added at the end of a queue during the dump are
+ * included.  If that entry has since left a history queue, the entries
+ * before it were recycled as well, and the dump carries on from the head of
+ * the queue.  On the other queues it carries on after as many entries as were
+ * written from that queue, so entries moving between queues may be missed
+ * or written twice.
+ */
+
+#ifndef CF_DUMP_H
+#define CF_DUMP_H
+
+#include "cf_cfdp_types.h"
+#include "cf_cfdp_pdu.h"
+#include "cf_msg.h"
+
+/**
+ * @brief Value of the magic field of a dump header, "CFQD"
+ */
+#define CF_DUMP_MAGIC 0x43465144
+
+/**
+ * @brief Version of the dump format, changed with any change of the header or record layout
+ */
+#define CF_DUMP_VERSION 1
+
+/**
+ * @brief Records buffered before each write, and written at most each wakeup
+ */
+#define CF_DUMP_RECORDS_PER_WRITE 16
+
+/**
+ * @brief Flag of the header, the dump completed and the count is valid
+ */
+#define CF_DUMP_FLAG_COMPLETE 0x01
+
+/**
+ * @brief Header at the start of a dump file
+ */
+typedef struct CF_DumpHeader
+{
+    CF_CFDP_uint32_t magic;        /**< \brief always CF_DUMP_MAGIC */
+    CF_CFDP_uint16_t version;      /**< \brief CF_DUMP_VERSION */
+    CF_CFDP_uint16_t header_size;  /**< \brief size of this header in bytes */
+    CF_CFDP_uint16_t record_size;  /**< \brief size of each record in bytes */
+    CF_CFDP_uint16_t filename_len; /**< \brief size of each file name field of a record */
+    CF_CFDP_uint32_t count;        /**< \brief number of records, 0 until the dump is complete */
+    CF_CFDP_uint32_t time_secs;    /**< \brief seconds part of the CFE time the dump started */
+    CF_CFDP_uint32_t time_subsecs; /**< \brief subseconds part of the CFE time the dump started */
+    CF_CFDP_uint8_t  chan;         /**< \brief channel dumped */
+    CF_CFDP_uint8_t  type;         /**< \brief CF_Type_t of the command */
+    CF_CFDP_uint8_t  queue;        /**< \brief CF_Queue_t of the command */
+    CF_CFDP_uint8_t  flags;        /**< \brief CF_DUMP_FLAG_COMPLETE once done */
+} CF_DumpHeader_t;
+
+/**
+ * @brief One transaction or history entry of a dump file
+ */
+typedef struct CF_DumpRecord
+{
+    CF_CFDP_uint8_t  queue;         /**< \brief CF_QueueIdx_t the entry was on */
+    CF_CFDP_uint8_t  dir;           /**< \brief CF_Direction_t of the transaction */
+    CF_CFDP_uint8_t  txn_stat;      /**< \brief CF_TxnStatus_t, 0xFF if not set yet */
+    CF_CFDP_uint8_t  spare;         /**< \brief always 0 */
+    CF_CFDP_uint64_t src_eid;       /**< \brief source entity of the transaction */
+    CF_CFDP_uint64_t peer_eid;      /**< \brief the other entity */
+    CF_CFDP_uint64_t seq_num;       /**< \brief transaction sequence number */
+    CF_CFDP_uint32_t start_secs;    /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t start_subsecs; /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t first_pdu_ms;  /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t eof_ms;        /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t end_ms;        /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t fd_bytes;      /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t nak_rounds;    /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t nak_segments;  /**< \brief see CF_TxnMetrics_t */
+    CF_CFDP_uint32_t peak_chunks;   /**< \brief see CF_TxnMetrics_t */
+
+    char src_filename[CF_FILENAME_MAX_LEN]; /**< \brief source file name, padded with NUL */
+    char dst_filename[CF_FILENAME_MAX_LEN]; /**< \brief destination file name, padded with NUL */
+} CF_DumpRecord_t;
+
+/**
+ * @brief State of the dump being written
+ */
+typedef struct CF_Dump
+{
+    bool      busy;  /**< \brief a dump is being written */
+    osal_id_t fd;    /**< \brief file being written */
+    uint8     chan;  /**< \brief channel dumped */
+    uint8     type;  /**< \brief CF_Type_t of the command */
+    uint8     queue; /**< \brief CF_Queue_t of the command */
+    uint8     stage; /**< \brief queue being written, index of the stages in the file order */
+
+    const CF_CListNode_t *last;     /**< \brief last entry written from the queue, only compared */
+    CF_EntityId_t         last_eid; /**< \brief source entity of that entry */
+    CF_TransactionSeq_t   last_seq; /**< \brief sequence number of that entry */
+    uint32                pos;      /**< \brief entries written from the queue */
+
+    uint32 count; /**< \brief records written to the file */
+    uint32 fill;  /**< \brief records in buf */
+
+    CF_DumpHeader_t hdr;                            /**< \brief header, written again when done */
+    CF_DumpRecord_t buf[CF_DUMP_RECORDS_PER_WRITE]; /**< \brief records not written yet */
+    char            filename[CF_FILENAME_MAX_LEN];  /**< \brief name of the file, for the events */
+} CF_Dump_t;
+
+/************************************************************************/
+/** @brief Starts a binary dump for the write queue command.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       wq must not be NULL, and its arguments must have been checked.
+ *       Failures, including a dump already being written, are reported with
+ *       an event and the error counter.  The command counter and the event of
+ *       a successful write queue command follow when the dump completes.
+ *
+ * @param wq  Payload of the write queue command
+ */
+void CF_Dump_Start(const CF_WriteQueue_Payload_t *wq);
+
+/************************************************************************/
+/** @brief Writes the next records of the dump, if one is being written.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once each wakeup.  Writes no more than one buffer, and
+ *       completes the dump once all of its queues were written.
+ */
+void CF_Dump_Run(void);
+
+#endif /* !CF_DUMP_H */
@@ -0,0 +1,129 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application event rate limits
+ *
+ * Token buckets of the events sent for each PDU, see cf_evlim.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_evlim.h"
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_evlim.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_EvLim_Init(void)
+{
+    int i;
+
+    /* the tokens are capped to the burst of the table on first use */
+    for (i = 0; i < CF_EVLIM_MAX_EID; ++i)
+    {
+        CF_AppData.evlim.bucket[i].tokens = UINT32_MAX;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_evlim.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_EvLim_Allow(uint16 event_id)
+{
+    const CF_ConfigTable_t *tbl   = CF_AppData.config_table;
+    CF_EvLim_t             *evlim = &CF_AppData.evlim;
+    CF_EvLimBucket_t       *b;
+    uint64                  tokens;
+    uint64                  cap;
+    bool                    allow = true;
+
+    if (tbl->event_burst && event_id < CF_EVLIM_MAX_EID)
+    {
+        b = &evlim->bucket[event_id];
+
+        /* one event is worth ticks_per_second tokens, and each wakeup adds event_rate */
+        cap    = (uint64)tbl->event_burst * tbl->ticks_per_second;
+        tokens = b->tokens + (uint64)(uint32)(evlim->tick - b->tick) * tbl->event_rate;
+        if (tokens > cap)
+        {
+            tokens = cap;
+        }
+        b->tick = evlim->tick;
+
+        if (tokens >= tbl->ticks_per_second)
+        {
+            tokens -= tbl->ticks_per_second;
+        }
+        else
+        {
+            ++b->suppressed;
+            allow = false;
+        }
+
+        b->tokens = (tokens > UINT32_MAX) ? UINT32_MAX : (uint32)tokens;
+    }
+
+    return allow;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_evlim.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_EvLim_Tick(void)
+{
+    const CF_ConfigTable_t *tbl   = CF_AppData.config_table;
+    CF_EvLim_t             *evlim = &CF_AppData.evlim;
+    uint32                  elapsed;
+    int                     i;
+
+    ++evlim->tick;
+
+    elapsed = evlim->tick - evlim->summary_tick;
+    if (tbl->event_summary_s && elapsed >= (uint64)tbl->event_summary_s * tbl->ticks_per_second)
+    {
+        evlim->summary_tick = evlim->tick;
+
+        for (i = 0; i < CF_EVLIM_MAX_EID; ++i)
+        {
+            if (evlim->bucket[i].suppressed)
+            {
+                CFE_EVS_SendEvent(CF_EVLIM_SUPPRESSED_INF_EID,
+                                  CFE_EVS_EventType_INFORMATION,
+                                  "CF: suppressed %lu events with ID %d in the last %lu s",
+                                  (unsigned long)evlim->bucket[i].suppressed,
+                                  i,
+                                  (unsigned long)tbl->event_summary_s);
+                evlim->bucket[i].suppressed = 0;
+            }
+        }
+    }
+}
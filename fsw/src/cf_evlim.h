@@ -0,0 +1,98 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Rate limits of the events sent for each received or sent PDU
+ *
+ * A flood of stray PDUs, an empty message pool or a failing file system can
+ * make the engine send the same error event for every PDU, which costs more
+ * than processing the PDUs and floods EVS.  Those events are sent only if
+ * CF_EvLim_Allow() says so, before the event text is formatted.
+ *
+ * Each event ID has a token bucket holding up to event_burst events of the
+ * configuration table, refilled at event_rate events per second as counted in
+ * wakeups.  An event finding the bucket empty is suppressed and counted, and
+ * every event_summary_s seconds one event reports how many events of each ID
+ * were suppressed since the previous report.
+ */
+
+#ifndef CF_EVLIM_H
+#define CF_EVLIM_H
+
+#include "cfe.h"
+
+/**
+ * @brief Number of event IDs with a bucket, higher IDs are never limited
+ */
+#define CF_EVLIM_MAX_EID 256
+
+/**
+ * @brief Token bucket of an event ID
+ */
+typedef struct CF_EvLimBucket
+{
+    uint32 tokens;     /**< \brief events allowed, in 1/ticks_per_second of an event, as of tick */
+    uint32 tick;       /**< \brief wakeup the tokens were last counted */
+    uint32 suppressed; /**< \brief events suppressed since the last summary */
+} CF_EvLimBucket_t;
+
+/**
+ * @brief Event rate limit state of the application
+ */
+typedef struct CF_EvLim
+{
+    uint32 tick;         /**< \brief wakeups counted */
+    uint32 summary_tick; /**< \brief wakeup of the last summary */
+
+    CF_EvLimBucket_t bucket[CF_EVLIM_MAX_EID]; /**< \brief bucket of each event ID */
+} CF_EvLim_t;
+
+/************************************************************************/
+/** @brief Fills the buckets of all event IDs.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The application data must be zeroed.
+ */
+void CF_EvLim_Init(void);
+
+/************************************************************************/
+/** @brief Checks whether an event may be sent, and counts it if not.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The configuration table must be loaded.  An allowed event takes one
+ *       event out of the bucket of its ID, so the event must then be sent.
+ *       Events are never limited if event_burst is 0.
+ *
+ * @param event_id  ID of the event
+ *
+ * @returns true if the event may be sent
+ */
+bool CF_EvLim_Allow(uint16 event_id);
+
+/************************************************************************/
+/** @brief Counts a wakeup, and reports the suppressed events when due.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once each wakeup.
+ */
+void CF_EvLim_Tick(void);
+
+#endif /* !CF_EVLIM_H */
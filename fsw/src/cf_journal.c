@@ -0,0 +1,829 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application transaction checkpoint journal
+ *
+ * This writes the state of class 2 receive transactions to a file at a
+ * configured interval, and rebuilds those transactions from the file when
+ * the engine is initialized.  See cf_journal.h for the file layout.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_cfdp.h"
+#include "cf_utils.h"
+#include "cf_journal.h"
+#include "cf_spill.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Journal_IsEligible(const CF_Transaction_t *txn)
+{
+    /* R1 cannot ask for missing data again, and past VALIDATE the file is already complete */
+    return (txn->state == CF_TxnState_R2 && txn->chunks != NULL && txn->flags.rx.tempfile_created &&
+            txn->state_data.sub_state <= CF_RxSubState_VALIDATE && CF_CFDP_TxnIsOK(txn));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Journal_FillRecord(CF_JournalRecord_t *rec, const CF_Transaction_t *txn)
+{
+    /* clear the padding too, it is part of the checksum */
+    memset(rec, 0, sizeof(*rec));
+    rec->fnames       = txn->history->fnames;
+    rec->src_eid      = txn->history->src_eid;
+    rec->peer_eid     = txn->history->peer_eid;
+    rec->seq_num      = txn->history->seq_num;
+    rec->fsize        = txn->fsize;
+    rec->eof_size     = txn->state_data.eof_size;
+    rec->rx_progress  = txn->state_data.rx_progress;
+    rec->eof_crc      = txn->state_data.eof_crc;
+    rec->metrics      = txn->history->metrics;
+    rec->num_chunks   = txn->chunks->chunks.count;
+    rec->chan_num     = txn->chan_num;
+    rec->sub_state    = txn->state_data.sub_state;
+    rec->acknak_count = txn->state_data.acknak_count;
+    rec->peer_cc      = txn->state_data.peer_cc;
+    rec->eof_count    = txn->flags.rx.eof_count;
+    rec->compress     = txn->compress;
+    rec->md_recv      = txn->flags.rx.md_recv;
+    rec->delta        = txn->flags.rx.delta;
+    rec->suspended    = txn->flags.com.suspended;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Checks whether the current wakeup has room for another journal entry.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Journal_Yield(CF_Checkpoint_t *cp)
+{
+    /* one entry always goes, so the checkpoint is done even if every wakeup runs out of time */
+    if (cp->count >= CF_JOURNAL_RECORDS_PER_WAKEUP || (cp->count != 0 && CF_CFDP_BudgetSpent()))
+    {
+        cp->yield = true;
+    }
+
+    return cp->yield;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Journal_DigestId(CF_Crc_t *crc, uint8 chan_num, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    CF_CRC_Digest(crc, &chan_num, sizeof(chan_num));
+    CF_CRC_Digest(crc, (const uint8 *)&src_eid, sizeof(src_eid));
+    CF_CRC_Digest(crc, (const uint8 *)&seq_num, sizeof(seq_num));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Journal_WriteRecord(osal_id_t fd, const CF_Transaction_t *txn, CF_Crc_t *crc)
+{
+    const CF_ChunkList_t *chunks = &txn->chunks->chunks;
+    CF_JournalRecord_t    rec;
+    CF_ChunkIdx_t         i;
+    CF_ChunkIdx_t         remaining;
+    size_t                len;
+
+    CF_Journal_FillRecord(&rec, txn);
+
+    if (CF_WrappedWrite(fd, &rec, sizeof(rec)) != sizeof(rec))
+    {
+        return CF_ERROR;
+    }
+    if (crc != NULL)
+    {
+        CF_CRC_Digest(crc, (const uint8 *)&rec, sizeof(rec));
+    }
+
+    /* the chunk entries are contiguous within each slab block, so write a block at a time */
+    for (i = 0; i < chunks->count; i += CF_CHUNK_BLOCK_SIZE)
+    {
+        remaining = chunks->count - i;
+        len       = sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE);
+        if (CF_WrappedWrite(fd, CF_ChunkList_At(chunks, i), len) != len)
+        {
+            return CF_ERROR;
+        }
+        if (crc != NULL)
+        {
+            CF_CRC_Digest(crc, (const uint8 *)CF_ChunkList_At(chunks, i), len);
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_CListTraverse_Status_t CF_Journal_WriteTxn(CF_CListNode_t *node, void *context)
+{
+    CF_Checkpoint_t  *cp  = context;
+    CF_Transaction_t *txn = container_of(node, CF_Transaction_t, cl_node);
+
+    if (!CF_Journal_IsEligible(txn))
+    {
+        return CF_CLIST_CONT;
+    }
+
+    /* already written in an earlier wakeup */
+    if (cp->idx < cp->pos)
+    {
+        ++cp->idx;
+        return CF_CLIST_CONT;
+    }
+
+    if (CF_Journal_Yield(cp))
+    {
+        return CF_CLIST_EXIT;
+    }
+
+    if (CF_Journal_WriteRecord(cp->fd, txn, &cp->crc) != CFE_SUCCESS)
+    {
+        cp->error = true;
+        return CF_CLIST_EXIT;
+    }
+
+    CF_Journal_DigestId(&cp->ids, txn->chan_num, txn->history->src_eid, txn->history->seq_num);
+
+    ++cp->num_records;
+    ++cp->idx;
+    ++cp->pos;
+    ++cp->count;
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Journal_WriteSpilled(CF_Checkpoint_t *cp, uint8 chan_num, const CF_SpillEntry_t *entry)
+{
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         buf[CF_CHUNK_BLOCK_SIZE];
+    CF_ChunkIdx_t      remaining;
+    size_t             len;
+    char               SpillName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t          fd;
+    bool               valid;
+
+    /* counted even when left out, CF_Journal_Ids() cannot tell which spill files are readable */
+    CF_Journal_DigestId(&cp->ids, chan_num, entry->src_eid, entry->seq_num);
+    ++cp->pos;
+    ++cp->count;
+
+    CF_Spill_GetName(entry->src_eid, entry->seq_num, SpillName, sizeof(SpillName));
+    if (CF_WrappedOpenCreate(&fd, SpillName, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
+    {
+        /* not worth losing the whole checkpoint over */
+        return;
+    }
+
+    valid = (CF_WrappedRead(fd, &rec, sizeof(rec)) == sizeof(rec) && rec.chan_num == chan_num &&
+             rec.num_chunks <= CF_AppData.config_table->chan[chan_num].rx_chunks_per_transaction);
+
+    if (valid)
+    {
+        if (CF_WrappedWrite(cp->fd, &rec, sizeof(rec)) != sizeof(rec))
+        {
+            cp->error = true;
+        }
+        CF_CRC_Digest(&cp->crc, (const uint8 *)&rec, sizeof(rec));
+
+        for (remaining = rec.num_chunks; remaining > 0 && !cp->error; remaining -= len / sizeof(CF_Chunk_t))
+        {
+            len = sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE);
+            if (CF_WrappedRead(fd, buf, len) != len || CF_WrappedWrite(cp->fd, buf, len) != len)
+            {
+                /* the record is already in the journal, so a short spill file fails the checkpoint */
+                cp->error = true;
+            }
+            CF_CRC_Digest(&cp->crc, (const uint8 *)buf, len);
+        }
+
+        ++cp->num_records;
+    }
+
+    CF_WrappedClose(fd);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * For use with CF_CList_Traverse(), digests the identity of an eligible transaction.
+ *
+ *-----------------------------------------------------------------*/
+static CF_CListTraverse_Status_t CF_Journal_IdTxn(CF_CListNode_t *node, void *context)
+{
+    CF_Crc_t         *crc = context;
+    CF_Transaction_t *txn = container_of(node, CF_Transaction_t, cl_node);
+
+    if (CF_Journal_IsEligible(txn))
+    {
+        CF_Journal_DigestId(crc, txn->chan_num, txn->history->src_eid, txn->history->seq_num);
+    }
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Checksum of the identities of everything a checkpoint would contain, in
+ * the order it is written.  Matches the ids of a checkpoint only if no
+ * transaction came or went while it was written.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Journal_Ids(void)
+{
+    CF_Crc_t      crc;
+    CF_Channel_t *chan;
+    int           i;
+    uint32        j;
+
+    CF_CRC_Start(&crc);
+
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        chan = &CF_AppData.engine.channels[i];
+        CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_Journal_IdTxn, &crc);
+
+        for (j = 0; j < chan->num_spilled; ++j)
+        {
+            CF_Journal_DigestId(&crc, i, chan->spill[j].src_eid, chan->spill[j].seq_num);
+        }
+    }
+
+    CF_CRC_Finalize(&crc);
+
+    return crc.result;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Journal_WriteStart(uint32 digest)
+{
+    CF_Checkpoint_t   *cp = &CF_AppData.engine.checkpoint;
+    CF_JournalHeader_t hdr;
+    char               TempName[CF_FILENAME_MAX_LEN + sizeof(CF_JOURNAL_TEMP_SUFFIX)];
+    int32              status;
+
+    snprintf(TempName, sizeof(TempName), "%s%s", CF_AppData.config_table->journal_file, CF_JOURNAL_TEMP_SUFFIX);
+
+    memset(cp, 0, sizeof(*cp));
+    memset(&hdr, 0, sizeof(hdr));
+    CF_CRC_Start(&cp->crc);
+    CF_CRC_Start(&cp->ids);
+
+    status = CF_WrappedOpenCreate(&cp->fd, TempName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (status < 0)
+    {
+        CFE_EVS_SendEvent(CF_JOURNAL_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to create checkpoint journal %s, error=%ld",
+                          TempName,
+                          (long)status);
+        return;
+    }
+
+    /* the header is written last, once the record count and checksum are known */
+    if (CF_WrappedWrite(cp->fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    {
+        cp->error = true;
+    }
+
+    cp->digest = digest;
+    cp->busy   = true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Journal_WriteStep(void)
+{
+    CF_Checkpoint_t *cp = &CF_AppData.engine.checkpoint;
+    CF_Channel_t    *chan;
+    uint32           j;
+
+    cp->count = 0;
+    cp->yield = false;
+
+    while (cp->chan_num < CF_NUM_CHANNELS && !cp->error)
+    {
+        chan = &CF_AppData.engine.channels[cp->chan_num];
+
+        /* the RX queue is walked from its head each time, skipping what is already written */
+        cp->idx = 0;
+        CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_Journal_WriteTxn, cp);
+
+        /* the spill index follows the RX queue, whose eligible transactions are all counted in idx by now */
+        for (j = cp->pos - cp->idx; j < chan->num_spilled && !cp->error && !cp->yield; ++j)
+        {
+            if (!CF_Journal_Yield(cp))
+            {
+                CF_Journal_WriteSpilled(cp, cp->chan_num, &chan->spill[j]);
+            }
+        }
+
+        if (cp->yield)
+        {
+            return false;
+        }
+
+        ++cp->chan_num;
+        cp->pos = 0;
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Journal_WriteFinish(void)
+{
+    CF_Checkpoint_t   *cp = &CF_AppData.engine.checkpoint;
+    CF_JournalHeader_t hdr;
+    char               TempName[CF_FILENAME_MAX_LEN + sizeof(CF_JOURNAL_TEMP_SUFFIX)];
+    int32              status;
+    bool               changed = false;
+
+    snprintf(TempName, sizeof(TempName), "%s%s", CF_AppData.config_table->journal_file, CF_JOURNAL_TEMP_SUFFIX);
+
+    cp->busy = false;
+
+    if (!cp->error)
+    {
+        /* a transaction that came or went between wakeups may be missing, or in the journal twice */
+        CF_CRC_Finalize(&cp->ids);
+        changed = (cp->ids.result != CF_Journal_Ids());
+    }
+
+    if (!cp->error && !changed)
+    {
+        CF_CRC_Finalize(&cp->crc);
+
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.magic       = CF_JOURNAL_MAGIC;
+        hdr.version     = CF_JOURNAL_VERSION;
+        hdr.num_records = cp->num_records;
+        hdr.body_crc    = cp->crc.result;
+        hdr.seq_num     = CF_AppData.engine.seq_num;
+
+        if (CF_WrappedLseek(cp->fd, 0, OS_SEEK_SET) != 0 || CF_WrappedWrite(cp->fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+        {
+            cp->error = true;
+        }
+    }
+
+    CF_WrappedClose(cp->fd);
+
+    /* the rename is what makes the new checkpoint visible, all at once */
+    if (!cp->error && !changed)
+    {
+        status = OS_rename(TempName, CF_AppData.config_table->journal_file);
+        if (status != OS_SUCCESS)
+        {
+            cp->error = true;
+        }
+    }
+
+    if (cp->error)
+    {
+        CFE_EVS_SendEvent(CF_JOURNAL_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to write checkpoint journal %s",
+                          CF_AppData.config_table->journal_file);
+    }
+
+    /* not an error if it changed, the next checkpoint is simply written from scratch */
+    if (cp->error || changed)
+    {
+        OS_remove(TempName);
+        return CF_ERROR;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_CListTraverse_Status_t CF_Journal_DigestTxn(CF_CListNode_t *node, void *context)
+{
+    CF_Crc_t             *crc = context;
+    CF_Transaction_t     *txn = container_of(node, CF_Transaction_t, cl_node);
+    const CF_ChunkList_t *chunks;
+    CF_JournalRecord_t    rec;
+    CF_ChunkIdx_t         i;
+    CF_ChunkIdx_t         remaining;
+
+    if (CF_Journal_IsEligible(txn))
+    {
+        chunks = &txn->chunks->chunks;
+
+        CF_Journal_FillRecord(&rec, txn);
+        CF_CRC_Digest(crc, (const uint8 *)&rec, sizeof(rec));
+
+        for (i = 0; i < chunks->count; i += CF_CHUNK_BLOCK_SIZE)
+        {
+            remaining = chunks->count - i;
+            CF_CRC_Digest(crc,
+                          (const uint8 *)CF_ChunkList_At(chunks, i),
+                          sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE));
+        }
+    }
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Journal_Digest(void)
+{
+    CF_Crc_t      crc;
+    CF_Channel_t *chan;
+    int           i;
+    uint32        j;
+
+    CF_CRC_Start(&crc);
+
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        chan = &CF_AppData.engine.channels[i];
+        CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_Journal_DigestTxn, &crc);
+
+        /* a spill file only changes when it is written, and each write is counted */
+        for (j = 0; j < chan->num_spilled; ++j)
+        {
+            CF_CRC_Digest(&crc, (const uint8 *)&chan->spill[j].src_eid, sizeof(chan->spill[j].src_eid));
+            CF_CRC_Digest(&crc, (const uint8 *)&chan->spill[j].seq_num, sizeof(chan->spill[j].seq_num));
+        }
+        CF_CRC_Digest(&crc, (const uint8 *)&chan->spill_writes, sizeof(chan->spill_writes));
+    }
+
+    CF_CRC_Digest(&crc, (const uint8 *)&CF_AppData.engine.seq_num, sizeof(CF_AppData.engine.seq_num));
+    CF_CRC_Finalize(&crc);
+
+    return crc.result;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Journal_Tick(void)
+{
+    CF_Checkpoint_t *cp    = &CF_AppData.engine.checkpoint;
+    CF_Timer_t      *timer = &CF_AppData.engine.checkpoint_timer;
+    uint32           digest;
+
+    if (CF_AppData.config_table->checkpoint_interval_s != 0 && CF_AppData.config_table->journal_file[0] != 0)
+    {
+        /* the timer starts out expired, so the first checkpoint follows engine init (and any restore) */
+        if (CF_Timer_Expired(timer))
+        {
+            /* a checkpoint still being written is not restarted, the next expiry catches up */
+            if (!cp->busy)
+            {
+                /* rewriting an identical journal only wears the file system */
+                digest = CF_Journal_Digest();
+                if (!CF_AppData.engine.checkpoint_saved || digest != CF_AppData.engine.checkpoint_digest)
+                {
+                    CF_Journal_WriteStart(digest);
+                }
+            }
+            CF_Timer_InitRelSec(timer, CF_AppData.config_table->checkpoint_interval_s);
+        }
+        else
+        {
+            CF_Timer_Tick(timer);
+        }
+    }
+
+    /* spread over as many wakeups as it takes, even if checkpointing was disabled meanwhile */
+    if (cp->busy && CF_Journal_WriteStep())
+    {
+        if (CF_Journal_WriteFinish() == CFE_SUCCESS)
+        {
+            CF_AppData.engine.checkpoint_saved  = true;
+            CF_AppData.engine.checkpoint_digest = cp->digest;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Journal_Verify(osal_id_t fd, const CF_JournalHeader_t *hdr)
+{
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         buf[CF_CHUNK_BLOCK_SIZE];
+    CF_Crc_t           crc;
+    CF_ChunkIdx_t      remaining;
+    size_t             len;
+    uint32             i;
+
+    if (hdr->magic != CF_JOURNAL_MAGIC || hdr->version != CF_JOURNAL_VERSION)
+    {
+        return CF_ERROR;
+    }
+
+    CF_CRC_Start(&crc);
+
+    for (i = 0; i < hdr->num_records; ++i)
+    {
+        if (CF_WrappedRead(fd, &rec, sizeof(rec)) != sizeof(rec))
+        {
+            return CF_ERROR;
+        }
+        CF_CRC_Digest(&crc, (const uint8 *)&rec, sizeof(rec));
+
+        /* the table may have changed since the journal was written */
+        if (rec.chan_num >= CF_NUM_CHANNELS || rec.sub_state > CF_RxSubState_VALIDATE ||
+            rec.num_chunks > CF_AppData.config_table->chan[rec.chan_num].rx_chunks_per_transaction)
+        {
+            return CF_ERROR;
+        }
+
+        for (remaining = rec.num_chunks; remaining > 0; remaining -= len / sizeof(CF_Chunk_t))
+        {
+            len = sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE);
+            if (CF_WrappedRead(fd, buf, len) != len)
+            {
+                return CF_ERROR;
+            }
+            CF_CRC_Digest(&crc, (const uint8 *)buf, len);
+        }
+    }
+
+    CF_CRC_Finalize(&crc);
+
+    return (crc.result == hdr->body_crc) ? CFE_SUCCESS : CF_ERROR;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Journal_ResumeTxn(CF_Transaction_t *txn, osal_id_t fd, const CF_JournalRecord_t *rec)
+{
+    CF_Chunk_t    buf[CF_CHUNK_BLOCK_SIZE];
+    CF_ChunkIdx_t remaining;
+    CF_ChunkIdx_t i;
+    size_t        len;
+    char          TempName[CFE_MISSION_MAX_PATH_LEN];
+    int32         status;
+    CFE_Status_t  ret = CFE_SUCCESS;
+
+    if (txn == NULL)
+    {
+        ret = CF_ERROR;
+    }
+    else
+    {
+        txn->history->fnames   = rec->fnames;
+        txn->history->src_eid  = rec->src_eid;
+        txn->history->peer_eid = rec->peer_eid;
+        txn->history->seq_num  = rec->seq_num;
+        txn->history->txn_stat = CF_TxnStatus_UNDEFINED;
+        txn->history->metrics  = rec->metrics;
+
+        CF_CFDP_AllocChunkList(txn);
+        if (!CF_CFDP_TxnIsOK(txn))
+        {
+            ret = CF_ERROR;
+        }
+        else
+        {
+            /* the data received before the restart is all in the temp file */
+            CF_CFDP_GetTempName(txn->history, TempName, sizeof(TempName));
+            status = CF_WrappedOpenCreate(&txn->fd, TempName, OS_FILE_FLAG_NONE, OS_READ_WRITE);
+            if (status < 0)
+            {
+                txn->fd = OS_OBJECT_ID_UNDEFINED;
+                ret     = CF_ERROR;
+            }
+        }
+    }
+
+    /* the chunk entries are always consumed, to stay in step with the next record */
+    for (remaining = rec->num_chunks; remaining > 0; remaining -= len / sizeof(CF_Chunk_t))
+    {
+        len = sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE);
+        if (CF_WrappedRead(fd, buf, len) != len)
+        {
+            ret = CF_ERROR;
+            break;
+        }
+
+        for (i = 0; ret == CFE_SUCCESS && i < (len / sizeof(CF_Chunk_t)); ++i)
+        {
+            CF_ChunkListAdd(&txn->chunks->chunks, buf[i].offset, buf[i].size);
+        }
+    }
+
+    if (ret == CFE_SUCCESS)
+    {
+        txn->state         = CF_TxnState_R2;
+        txn->reliable_mode = true;
+
+        txn->fsize                     = rec->fsize;
+        txn->compress                  = rec->compress;
+        txn->state_data.eof_size       = rec->eof_size;
+        txn->state_data.rx_progress    = rec->rx_progress;
+        txn->state_data.eof_crc        = rec->eof_crc;
+        txn->state_data.acknak_count   = rec->acknak_count;
+        txn->state_data.peer_cc        = rec->peer_cc;
+        txn->state_data.fin_dc         = CF_CFDP_FinDeliveryCode_INVALID;
+        txn->state_data.fin_fs         = CF_CFDP_FinFileStatus_INVALID;
+        txn->flags.rx.tempfile_created = true;
+        txn->flags.rx.md_recv          = rec->md_recv;
+        txn->flags.rx.eof_count        = rec->eof_count;
+        txn->flags.rx.delta            = rec->delta;
+        txn->flags.com.suspended       = rec->suspended;
+
+        /* a CRC pass in progress is started over from the file, via the gap check */
+        txn->state_data.sub_state =
+            (rec->sub_state == CF_RxSubState_DATA_NORMAL) ? CF_RxSubState_DATA_NORMAL : CF_RxSubState_DATA_EOF;
+
+        CF_CFDP_ArmInactTimer(txn);
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_JOURNAL_RESUME_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: cannot resume transaction %lu:%lu from disk",
+                          (unsigned long)rec->src_eid,
+                          (unsigned long)rec->seq_num);
+
+        if (txn != NULL)
+        {
+            /* nothing was exchanged with the peer yet, so no holdover is needed */
+            CF_CFDP_RecycleTransaction(txn);
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_journal.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Journal_Restore(void)
+{
+    CF_JournalHeader_t hdr;
+    CF_JournalRecord_t rec;
+    CF_Transaction_t  *txn;
+    char               SpillName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t          fd;
+    int32              status;
+    uint32             i;
+    uint32             num_resumed;
+    uint32             num_spilled;
+
+    if (CF_AppData.config_table->checkpoint_interval_s == 0 || CF_AppData.config_table->journal_file[0] == 0)
+    {
+        return;
+    }
+
+    status = CF_WrappedOpenCreate(&fd, CF_AppData.config_table->journal_file, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (status < 0)
+    {
+        /* no journal, so nothing to resume */
+        return;
+    }
+
+    /* nothing is restored unless the entire journal checks out */
+    if (CF_WrappedRead(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || CF_Journal_Verify(fd, &hdr) != CFE_SUCCESS ||
+        CF_WrappedLseek(fd, sizeof(hdr), OS_SEEK_SET) != sizeof(hdr))
+    {
+        CFE_EVS_SendEvent(CF_JOURNAL_READ_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: ignoring invalid checkpoint journal %s",
+                          CF_AppData.config_table->journal_file);
+    }
+    else
+    {
+        /* do not hand out sequence numbers that peers may still associate with older sends */
+        CF_AppData.engine.seq_num = hdr.seq_num;
+
+        num_resumed = 0;
+        num_spilled = 0;
+        for (i = 0; i < hdr.num_records; ++i)
+        {
+            if (CF_WrappedRead(fd, &rec, sizeof(rec)) != sizeof(rec))
+            {
+                break;
+            }
+
+            txn = CF_CFDP_StartRxTransaction(rec.chan_num);
+            if (txn == NULL)
+            {
+                /* more transactions were saved than there are RX slots, the rest wait on disk as before */
+                if (CF_Spill_Keep(&CF_AppData.engine.channels[rec.chan_num], fd, &rec) == CFE_SUCCESS)
+                {
+                    ++num_spilled;
+                }
+            }
+            else if (CF_Journal_ResumeTxn(txn, fd, &rec) == CFE_SUCCESS)
+            {
+                /* let the sender know right away what is still missing */
+                txn->flags.rx.send_nak = true;
+                ++num_resumed;
+
+                /* the spill index did not survive the restart, the journal copy of the record supersedes it */
+                CF_Spill_GetName(rec.src_eid, rec.seq_num, SpillName, sizeof(SpillName));
+                OS_remove(SpillName);
+            }
+        }
+
+        CFE_EVS_SendEvent(CF_JOURNAL_RESTORE_INF_EID,
+                          CFE_EVS_EventType_INFORMATION,
+                          "CF: resumed %lu and spilled %lu of %lu transactions from checkpoint journal %s",
+                          (unsigned long)num_resumed,
+                          (unsigned long)num_spilled,
+                          (unsigned long)hdr.num_records,
+                          CF_AppData.config_table->journal_file);
+    }
+
+    CF_WrappedClose(fd);
+}
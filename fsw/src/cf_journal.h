@@ -0,0 +1,295 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Transaction checkpoint journal
+ *
+ * The state of class 2 receive transactions is periodically written to a
+ * journal file, so that after a restart of CF the transactions can be rebuilt
+ * on top of their existing temp files and resume NAK-driven recovery, instead
+ * of the sender having to start the whole file over.
+ *
+ * The journal is written to a temporary name, a few records per wakeup, and
+ * renamed over the previous journal once complete, so a reset in the middle of
+ * a checkpoint leaves the previous journal intact.  The journal is a native-format binary file: it is
+ * only meant to be read back by the same CF build that wrote it.
+ *
+ * The same record format is used for the spill files of cf_spill.h.
+ */
+
+#ifndef CF_JOURNAL_H
+#define CF_JOURNAL_H
+
+#include "cf_cfdp_types.h"
+
+/**
+ * @brief Value of the magic field of a journal header ("CFJN")
+ */
+#define CF_JOURNAL_MAGIC 0x43464A4E
+
+/**
+ * @brief Version of the journal format, increment on any change to the structures below
+ */
+#define CF_JOURNAL_VERSION 4
+
+/**
+ * @brief Suffix appended to the journal file name while a checkpoint is being written
+ */
+#define CF_JOURNAL_TEMP_SUFFIX ".tmp"
+
+/**
+ * @brief Journal file header
+ *
+ * This is followed by num_records CF_JournalRecord_t entries, each of which
+ * is directly followed by its chunk list entries.
+ */
+typedef struct CF_JournalHeader
+{
+    uint32              magic;       /**< \brief always CF_JOURNAL_MAGIC */
+    uint32              version;     /**< \brief always CF_JOURNAL_VERSION */
+    uint32              num_records; /**< \brief number of transaction records following */
+    uint32              body_crc;    /**< \brief CFDP checksum over everything following the header */
+    CF_TransactionSeq_t seq_num;     /**< \brief engine sequence number for new sends */
+} CF_JournalHeader_t;
+
+/**
+ * @brief Checkpoint of a single receive transaction
+ */
+typedef struct CF_JournalRecord
+{
+    CF_TxnFilenames_t   fnames;       /**< \brief file names from the MD PDU (if md_recv) */
+    CF_EntityId_t       src_eid;      /**< \brief the source eid of the transaction */
+    CF_EntityId_t       peer_eid;     /**< \brief the sender */
+    CF_TransactionSeq_t seq_num;      /**< \brief transaction sequence number */
+    CF_FileSize_t       fsize;        /**< \brief file size, from MD or EOF */
+    CF_FileSize_t       eof_size;     /**< \brief size in the received EOF PDU */
+    CF_FileSize_t       rx_progress;  /**< \brief end of the furthest file data received */
+    uint32              eof_crc;      /**< \brief checksum in the received EOF PDU */
+    CF_TxnMetrics_t     metrics;      /**< \brief throughput and latency so far, carried across the restart */
+    CF_ChunkIdx_t       num_chunks;   /**< \brief number of CF_Chunk_t entries following this record */
+    uint8               chan_num;     /**< \brief channel the transaction runs on */
+    uint8               sub_state;    /**< \brief CF_RxSubState_t of the transaction */
+    uint8               acknak_count; /**< \brief NAKs sent so far without the gaps being filled */
+    uint8               peer_cc;      /**< \brief condition code in the received EOF PDU */
+    uint8               eof_count;    /**< \brief nonzero if EOF was received */
+    uint8               compress;     /**< \brief CF_Compress_t announced in the MD PDU */
+    bool                md_recv;      /**< \brief the MD PDU was received */
+    bool                delta;        /**< \brief the temp file was filled from the existing file */
+    bool                suspended;    /**< \brief the transaction was suspended by command */
+} CF_JournalRecord_t;
+
+/************************************************************************/
+/** @brief Checks whether a transaction is included in the checkpoint journal.
+ *
+ * Only class 2 receive transactions that are still collecting file data (or
+ * validating it) and whose temp file is open can be resumed after a restart.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval true if the transaction should be journaled
+ * @retval false otherwise
+ */
+bool CF_Journal_IsEligible(const CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Writes a checkpoint record of a transaction to the journal.
+ *
+ * For use with CF_CList_Traverse() over the RX queue of a channel.  Transactions
+ * not accepted by CF_Journal_IsEligible() are skipped, and so are the first pos
+ * eligible ones, which were written in an earlier wakeup.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       node must not be NULL. context must not be NULL.
+ *
+ * @param node    Node being currently traversed
+ * @param context Pointer to CF_Checkpoint_t
+ *
+ * @retval CF_CLIST_CONT to continue
+ * @retval CF_CLIST_EXIT if a write failed or the wakeup has no room for more records
+ */
+CF_CListTraverse_Status_t CF_Journal_WriteTxn(CF_CListNode_t *node, void *context);
+
+/************************************************************************/
+/** @brief Writes the record of a transaction, followed by its chunk list entries.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be accepted by CF_Journal_IsEligible().
+ *       crc may be NULL if no checksum is kept.
+ *
+ * @param fd   Open file to write to
+ * @param txn  Pointer to the transaction object
+ * @param crc  Checksum to digest the written bytes into
+ *
+ * @retval CFE_SUCCESS if everything was written
+ * @retval CF_ERROR if a write failed
+ */
+CFE_Status_t CF_Journal_WriteRecord(osal_id_t fd, const CF_Transaction_t *txn, CF_Crc_t *crc);
+
+/************************************************************************/
+/** @brief Copies the spill file of a transaction into the journal.
+ *
+ * Spilled transactions are not in any queue, but must survive a restart
+ * just the same.  A spill file that cannot be read is left out of the journal.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       cp must not be NULL. entry must not be NULL.
+ *
+ * @param cp       Checkpoint being written
+ * @param chan_num Channel the transaction was spilled from
+ * @param entry    Spill index entry of the transaction
+ */
+void CF_Journal_WriteSpilled(CF_Checkpoint_t *cp, uint8 chan_num, const CF_SpillEntry_t *entry);
+
+/************************************************************************/
+/** @brief Starts writing a checkpoint of all channels to the journal file.
+ *
+ * Only the temporary file and its placeholder header are written here, the
+ * records follow in CF_Journal_WriteStep().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       No checkpoint may be busy.  If the temporary file cannot be created
+ *       an event is sent and the checkpoint is not busy on return.
+ *
+ * @param digest  CF_Journal_Digest() of the engine state being written
+ */
+void CF_Journal_WriteStart(uint32 digest);
+
+/************************************************************************/
+/** @brief Writes the next records of the checkpoint being written.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The checkpoint must be busy.  At most CF_JOURNAL_RECORDS_PER_WAKEUP
+ *       records are written, fewer once the wakeup budget is spent.
+ *
+ * @returns true if all channels are written or a write failed, false if more records are left
+ */
+bool CF_Journal_WriteStep(void);
+
+/************************************************************************/
+/** @brief Completes the checkpoint being written and puts it in place of the previous journal.
+ *
+ * As the records were written over several wakeups, the checkpoint is only
+ * kept if the same transactions are still journaled, in the same order.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The checkpoint must be busy, and is not busy on return.  The temporary
+ *       file is removed unless it was renamed into place.
+ *
+ * @retval CFE_SUCCESS if the journal was written and replaced the previous one
+ * @retval CF_ERROR if any step failed or the transactions changed, the previous journal is left in place
+ */
+CFE_Status_t CF_Journal_WriteFinish(void);
+
+/************************************************************************/
+/** @brief Digests the checkpoint record of a transaction.
+ *
+ * For use with CF_CList_Traverse() over the RX queue of a channel.  Covers the
+ * same record and chunk list entries that CF_Journal_WriteTxn() would write.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       node must not be NULL. context must not be NULL.
+ *
+ * @param node    Node being currently traversed
+ * @param context Pointer to CF_Crc_t
+ *
+ * @retval CF_CLIST_CONT always
+ */
+CF_CListTraverse_Status_t CF_Journal_DigestTxn(CF_CListNode_t *node, void *context);
+
+/************************************************************************/
+/** @brief Computes a checksum of everything a checkpoint would contain.
+ *
+ * Nothing is written.  The spill files are not read; each spilled transaction
+ * counts by its identity, and the spill_writes count of each channel stands in
+ * for their content.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ *
+ * @returns the checksum, equal between two calls if the checkpoint would be the same
+ */
+uint32 CF_Journal_Digest(void);
+
+/************************************************************************/
+/** @brief Checkpoint timer processing, called once per engine cycle.
+ *
+ * When the timer expires the journal is only rewritten if CF_Journal_Digest()
+ * differs from that of the last checkpoint written.  A checkpoint being written
+ * gets a step every cycle until it is finished.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Does nothing if checkpointing is disabled in the configuration table.
+ */
+void CF_Journal_Tick(void);
+
+/************************************************************************/
+/** @brief Checks the structure and checksum of an open journal file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The file position must be just past the header.  On return the position
+ *       is undefined.
+ *
+ * @param fd   Open journal file
+ * @param hdr  Header already read from the file
+ *
+ * @retval CFE_SUCCESS if the journal is complete and consistent
+ * @retval CF_ERROR otherwise
+ */
+CFE_Status_t CF_Journal_Verify(osal_id_t fd, const CF_JournalHeader_t *hdr);
+
+/************************************************************************/
+/** @brief Rebuilds a receive transaction from a journal record.
+ *
+ * The chunk list entries following the record are read from fd (and consumed
+ * even if the transaction cannot be resumed).  The transaction reopens its temp
+ * file and picks up where it left off.  If it cannot be resumed it is recycled.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       rec must not be NULL, and must have been checked by CF_Journal_Verify()
+ *       or equivalent.  txn is NULL if no transaction was available, in which
+ *       case the chunk list entries are consumed and an error is returned.
+ *
+ * @param txn  Transaction from CF_CFDP_StartRxTransaction() on rec->chan_num
+ * @param fd   Open file, positioned at the chunk entries of this record
+ * @param rec  Record read from the file
+ *
+ * @retval CFE_SUCCESS if the transaction was resumed
+ * @retval CF_ERROR if the transaction could not be resumed
+ */
+CFE_Status_t CF_Journal_ResumeTxn(CF_Transaction_t *txn, osal_id_t fd, const CF_JournalRecord_t *rec);
+
+/************************************************************************/
+/** @brief Restores the transactions in the journal file, if there is one.
+ *
+ * Called during engine initialization, after the channel pools are set up.
+ * A missing journal is not an error; a journal that fails verification is
+ * ignored in full.  Transactions that find no free RX slot go back into the
+ * spill index, see CF_Spill_Keep().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ */
+void CF_Journal_Restore(void);
+
+#endif /* !CF_JOURNAL_H */
@@ -272,6 +272,11 @@ typedef struct CF_Logical_PduMd
 
     CF_Logical_Lv_t source_filename;
     CF_Logical_Lv_t dest_filename;
+
+    /**
+     * \brief Set of all TLV blobs in this PDU (options, such as messages to user).
+     */
+    CF_Logical_TlvList_t tlv_list;
 } CF_Logical_PduMd_t;
 
 /**
@@ -288,6 +293,26 @@ typedef struct CF_Logical_PduNak
     CF_Logical_SegmentList_t segment_list;
 } CF_Logical_PduNak_t;
 
+/**
+ * @brief Structure representing logical Prompt PDU
+ *
+ * @sa CF_CFDP_PduPrompt_t for encoded form
+ */
+typedef struct CF_Logical_PduPrompt
+{
+    CF_CFDP_PromptResponse_t response_required; /**< \brief whether the peer should answer with a NAK or Keep Alive */
+} CF_Logical_PduPrompt_t;
+
+/**
+ * @brief Structure representing logical Keep Alive PDU
+ *
+ * @sa CF_CFDP_PduKeepAlive_t for encoded form
+ */
+typedef struct CF_Logical_PduKeepAlive
+{
+    CF_FileSize_t progress; /**< \brief offset through which the receiver holds all file data */
+} CF_Logical_PduKeepAlive_t;
+
 typedef struct CF_Logical_PduFileDataHeader
 {
     uint8 continuation_state;
@@ -312,12 +337,14 @@ typedef struct CF_Logical_PduFileDataHeader
  */
 typedef union CF_Logical_IntHeader
 {
-    CF_Logical_PduEof_t            eof; /**< \brief valid when pdu_type=0 + directive_code=EOF (4) */
-    CF_Logical_PduFin_t            fin; /**< \brief valid when pdu_type=0 + directive_code=FIN (5) */
-    CF_Logical_PduAck_t            ack; /**< \brief valid when pdu_type=0 + directive_code=ACK (6) */
-    CF_Logical_PduMd_t             md;  /**< \brief valid when pdu_type=0 + directive_code=METADATA (7) */
-    CF_Logical_PduNak_t            nak; /**< \brief valid when pdu_type=0 + directive_code=NAK (8) */
-    CF_Logical_PduFileDataHeader_t fd;  /**< \brief valid when pdu_type=1 (directive_code is not applicable) */
+    CF_Logical_PduEof_t            eof;        /**< \brief valid when pdu_type=0 + directive_code=EOF (4) */
+    CF_Logical_PduFin_t            fin;        /**< \brief valid when pdu_type=0 + directive_code=FIN (5) */
+    CF_Logical_PduAck_t            ack;        /**< \brief valid when pdu_type=0 + directive_code=ACK (6) */
+    CF_Logical_PduMd_t             md;         /**< \brief valid when pdu_type=0 + directive_code=METADATA (7) */
+    CF_Logical_PduNak_t            nak;        /**< \brief valid when pdu_type=0 + directive_code=NAK (8) */
+    CF_Logical_PduPrompt_t         prompt;     /**< \brief valid when pdu_type=0 + directive_code=PROMPT (9) */
+    CF_Logical_PduKeepAlive_t      keep_alive; /**< \brief valid when pdu_type=0 + directive_code=KEEP_ALIVE (12) */
+    CF_Logical_PduFileDataHeader_t fd;         /**< \brief valid when pdu_type=1 (directive_code is not applicable) */
 } CF_Logical_IntHeader_t;
 
 /**
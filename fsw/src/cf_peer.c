@@ -0,0 +1,152 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application peer statistics
+ *
+ * Counters of each peer entity, in a table that gives the entry of the least
+ * recently seen peer to a new one once it is full.  See cf_peer.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_peer.h"
+#include "cf_rtt.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Finds the entry of a peer, taking an unused or the least recently seen one if it has none.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Peer_FindEntry(CF_EntityId_t peer_eid)
+{
+    CF_Peer_t               *peer = &CF_AppData.peer;
+    CF_PeerPacket_Payload_t *pl   = &peer->pkt.Payload;
+    uint32                   i;
+    uint32                   oldest;
+
+    /* PDUs come in runs for the same transaction, so the last entry is likely the one */
+    if (peer->last_idx < pl->num_peers && pl->peer[peer->last_idx].eid == peer_eid)
+    {
+        return peer->last_idx;
+    }
+
+    oldest = 0;
+    for (i = 0; i < pl->num_peers; ++i)
+    {
+        if (pl->peer[i].eid == peer_eid)
+        {
+            return i;
+        }
+
+        /* the difference stays right when seen_count wraps around */
+        if ((peer->seen_count - peer->last_seen[i]) > (peer->seen_count - peer->last_seen[oldest]))
+        {
+            oldest = i;
+        }
+    }
+
+    if (pl->num_peers < CF_MAX_PEER_STATS)
+    {
+        i = pl->num_peers;
+        ++pl->num_peers;
+    }
+    else
+    {
+        i = oldest;
+        ++pl->evictions;
+    }
+
+    memset(&pl->peer[i], 0, sizeof(pl->peer[i]));
+    pl->peer[i].eid = peer_eid;
+
+    return i;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_peer.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Peer_Init(void)
+{
+    CFE_MSG_Init(CFE_MSG_PTR(CF_AppData.peer.pkt.TelemetryHeader),
+                 CFE_SB_ValueToMsgId(CF_PEER_TLM_MID),
+                 sizeof(CF_AppData.peer.pkt));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_peer.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Peer_Count(CF_EntityId_t peer_eid, CF_PeerCounter_t counter, uint32 amount)
+{
+    CF_Peer_t *peer = &CF_AppData.peer;
+    uint32     i    = CF_Peer_FindEntry(peer_eid);
+
+    peer->pkt.Payload.peer[i].counters[counter] += amount;
+    peer->last_seen[i] = ++peer->seen_count;
+    peer->last_idx     = i;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_peer.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Peer_Reset(void)
+{
+    CF_Peer_t *peer = &CF_AppData.peer;
+
+    memset(&peer->pkt.Payload, 0, sizeof(peer->pkt.Payload));
+    memset(peer->last_seen, 0, sizeof(peer->last_seen));
+    peer->seen_count = 0;
+    peer->last_idx   = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_peer.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Peer_Send(void)
+{
+    CF_PeerPacket_Payload_t *pl = &CF_AppData.peer.pkt.Payload;
+    uint32                   i;
+
+    for (i = 0; i < pl->num_peers; ++i)
+    {
+        pl->peer[i].srtt_ms = CF_Rtt_GetSrtt(pl->peer[i].eid);
+    }
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(CF_AppData.peer.pkt.TelemetryHeader));
+    /* return value ignored */ CFE_SB_TransmitMsg(CFE_MSG_PTR(CF_AppData.peer.pkt.TelemetryHeader), true);
+}
@@ -0,0 +1,87 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Statistics of each peer entity
+ *
+ * The housekeeping counters are kept per channel, which does not show which
+ * of the peers sharing a channel causes NAK storms or timeouts.  The same
+ * events are also counted per peer entity ID in the peer statistics packet:
+ * the PDUs sent and received, the file data bytes each way, the segments
+ * requested in NAKs each way, the inactivity timeouts, the ACK and NAK
+ * limits reached and the checksum failures of received files.  The smoothed
+ * round trip time of the peer, see cf_rtt.h, is added when the packet is
+ * sent along with each housekeeping packet.
+ *
+ * The table holds CF_MAX_PEER_STATS peers.  Once it is full, the entry of the
+ * peer least recently seen is cleared and given to the new peer.
+ */
+
+#ifndef CF_PEER_H
+#define CF_PEER_H
+
+#include "cfe.h"
+#include "cf_msg.h"
+
+/**
+ * @brief Peer statistics state of the application
+ */
+typedef struct CF_Peer
+{
+    CF_PeerPacket_t pkt; /**< \brief statistics, see CF_Peer_Send() */
+
+    uint32 last_seen[CF_MAX_PEER_STATS]; /**< \brief value of seen_count when each entry was last counted */
+    uint32 seen_count;                   /**< \brief number of times any entry was counted */
+    uint32 last_idx;                     /**< \brief entry counted last, checked first */
+} CF_Peer_t;
+
+/************************************************************************/
+/** @brief Initializes the peer statistics packet.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The application data must be zeroed.
+ */
+void CF_Peer_Init(void);
+
+/************************************************************************/
+/** @brief Adds to a counter of a peer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       A peer not in the table takes an unused entry, or else the entry of
+ *       the peer least recently counted.
+ *
+ * @param peer_eid  Entity ID of the peer
+ * @param counter   Counter to add to
+ * @param amount    Amount to add
+ */
+void CF_Peer_Count(CF_EntityId_t peer_eid, CF_PeerCounter_t counter, uint32 amount);
+
+/************************************************************************/
+/** @brief Clears the peer statistics.
+ */
+void CF_Peer_Reset(void);
+
+/************************************************************************/
+/** @brief Updates the round trip times of the peers, and sends the peer statistics packet.
+ */
+void CF_Peer_Send(void);
+
+#endif /* !CF_PEER_H */
@@ -0,0 +1,307 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application polling directory snapshot index
+ *
+ * This lets polling skip the scan of directories that did not change since
+ * every file in them was sent, and keeps files that are still being written
+ * out of the scan.  See cf_pollidx.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_utils.h"
+#include "cf_pollidx.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_PollIdx_Now(void)
+{
+    OS_time_t now;
+
+    OS_GetLocalTime(&now);
+
+    return (uint32)OS_TimeGetTotalSeconds(now);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_PollIdx_Unchanged(const CF_Poll_t *poll, const CF_PollDir_t *pd)
+{
+    os_fstat_t st;
+    bool       unchanged = false;
+
+    if (poll->settled && OS_stat(pd->src_dir, &st) == OS_SUCCESS)
+    {
+        unchanged = ((uint32)OS_TimeGetTotalSeconds(st.FileTime) == poll->dir_mtime);
+    }
+
+    return unchanged;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_PollIdx_BeginScan(CF_Poll_t *poll)
+{
+    poll->pb.polled  = true;
+    poll->pb.rescan  = false;
+    poll->scan_start = CF_PollIdx_Now();
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_PollIdx_EndScan(CF_Poll_t *poll, const CF_PollDir_t *pd)
+{
+    os_fstat_t st;
+    uint32     mtime   = 0;
+    bool       settled = false;
+
+    if (!poll->pb.rescan && OS_stat(pd->src_dir, &st) == OS_SUCCESS)
+    {
+        mtime = (uint32)OS_TimeGetTotalSeconds(st.FileTime);
+
+        /* modification times only have a resolution of seconds, so a file added
+         * within the second the scan started may have been missed by it */
+        settled = (mtime < poll->scan_start);
+    }
+
+    if (settled != poll->settled || (settled && mtime != poll->dir_mtime))
+    {
+        poll->settled   = settled;
+        poll->dir_mtime = mtime;
+        CF_PollIdx_Save();
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_PollIdx_Invalidate(CF_Poll_t *poll)
+{
+    poll->settled   = false;
+    poll->dir_mtime = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_PollIdx_FileSettled(const char *path)
+{
+    os_fstat_t st;
+    bool       settled = true;
+
+    if (CF_AppData.config_table->poll_settle_s != 0 && OS_stat(path, &st) == OS_SUCCESS)
+    {
+        settled = ((CF_PollIdx_Now() - (uint32)OS_TimeGetTotalSeconds(st.FileTime)) >=
+                   CF_AppData.config_table->poll_settle_s);
+    }
+
+    return settled;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_PollIdx_Save(void)
+{
+    CF_PollIdxHeader_t hdr;
+    CF_PollIdxRecord_t rec;
+    CF_Poll_t         *poll;
+    osal_id_t          fd;
+    char               TempName[CF_FILENAME_MAX_LEN + sizeof(CF_POLLIDX_TEMP_SUFFIX)];
+    int32              status;
+    bool               error = false;
+    int                i;
+    int                j;
+
+    if (CF_AppData.config_table->poll_index_file[0] == 0)
+    {
+        return CFE_SUCCESS;
+    }
+
+    snprintf(TempName, sizeof(TempName), "%s%s", CF_AppData.config_table->poll_index_file, CF_POLLIDX_TEMP_SUFFIX);
+
+    memset(&hdr, 0, sizeof(hdr));
+
+    status = CF_WrappedOpenCreate(&fd, TempName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (status < 0)
+    {
+        CFE_EVS_SendEvent(CF_POLLIDX_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to create poll index %s, error=%ld",
+                          TempName,
+                          (long)status);
+        return CF_ERROR;
+    }
+
+    /* the header is written last, once the record count is known */
+    if (CF_WrappedWrite(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    {
+        error = true;
+    }
+
+    for (i = 0; i < CF_NUM_CHANNELS && !error; ++i)
+    {
+        for (j = 0; j < CF_MAX_POLLING_DIR_PER_CHAN && !error; ++j)
+        {
+            poll = &CF_AppData.engine.channels[i].poll[j];
+            if (poll->settled)
+            {
+                memset(&rec, 0, sizeof(rec));
+                strncpy(rec.src_dir, CF_AppData.config_table->chan[i].polldir[j].src_dir, sizeof(rec.src_dir) - 1);
+                rec.dir_mtime = poll->dir_mtime;
+                rec.chan_num  = i;
+                rec.poll_num  = j;
+
+                if (CF_WrappedWrite(fd, &rec, sizeof(rec)) != sizeof(rec))
+                {
+                    error = true;
+                }
+                ++hdr.num_records;
+            }
+        }
+    }
+
+    if (!error)
+    {
+        hdr.magic   = CF_POLLIDX_MAGIC;
+        hdr.version = CF_POLLIDX_VERSION;
+
+        if (CF_WrappedLseek(fd, 0, OS_SEEK_SET) != 0 || CF_WrappedWrite(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+        {
+            error = true;
+        }
+    }
+
+    CF_WrappedClose(fd);
+
+    if (!error && OS_rename(TempName, CF_AppData.config_table->poll_index_file) != OS_SUCCESS)
+    {
+        error = true;
+    }
+
+    if (error)
+    {
+        CFE_EVS_SendEvent(CF_POLLIDX_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to write poll index %s",
+                          CF_AppData.config_table->poll_index_file);
+        OS_remove(TempName);
+        return CF_ERROR;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_pollidx.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_PollIdx_Load(void)
+{
+    CF_PollIdxHeader_t  hdr;
+    CF_PollIdxRecord_t  rec;
+    const CF_PollDir_t *pd;
+    CF_Poll_t          *poll;
+    osal_id_t           fd;
+    int32               status;
+    uint32              i;
+
+    if (CF_AppData.config_table->poll_index_file[0] == 0)
+    {
+        return;
+    }
+
+    status = CF_WrappedOpenCreate(&fd, CF_AppData.config_table->poll_index_file, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (status < 0)
+    {
+        /* no index, so every polling directory gets scanned */
+        return;
+    }
+
+    if (CF_WrappedRead(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != CF_POLLIDX_MAGIC ||
+        hdr.version != CF_POLLIDX_VERSION)
+    {
+        CFE_EVS_SendEvent(CF_POLLIDX_READ_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: ignoring invalid poll index %s",
+                          CF_AppData.config_table->poll_index_file);
+    }
+    else
+    {
+        for (i = 0; i < hdr.num_records; ++i)
+        {
+            if (CF_WrappedRead(fd, &rec, sizeof(rec)) != sizeof(rec))
+            {
+                break;
+            }
+
+            if (rec.chan_num >= CF_NUM_CHANNELS || rec.poll_num >= CF_MAX_POLLING_DIR_PER_CHAN)
+            {
+                continue;
+            }
+
+            /* the snapshot only applies if the table still polls the same directory */
+            pd = &CF_AppData.config_table->chan[rec.chan_num].polldir[rec.poll_num];
+            if (pd->enabled && strncmp(rec.src_dir, pd->src_dir, sizeof(rec.src_dir)) == 0)
+            {
+                poll            = &CF_AppData.engine.channels[rec.chan_num].poll[rec.poll_num];
+                poll->settled   = true;
+                poll->dir_mtime = rec.dir_mtime;
+            }
+        }
+    }
+
+    CF_WrappedClose(fd);
+}
@@ -0,0 +1,171 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Polling directory snapshot index
+ *
+ * Once a scan of a polling directory has queued every file in it, the
+ * modification time of the directory itself is remembered.  As long as the
+ * directory keeps that time, no file was added, removed or renamed in it,
+ * and later polls skip the scan instead of reading every entry again.
+ *
+ * Files modified less than poll_settle_s ago are taken to be still open for
+ * writing by their producer.  They are left for a later poll, and the
+ * directory is not considered settled until they have been sent.
+ *
+ * The settled directories are saved to an index file, so a restart of CF
+ * does not need to scan them again either.  Like the checkpoint journal, the
+ * index is a native-format binary file that is written to a temporary name
+ * and renamed into place.
+ */
+
+#ifndef CF_POLLIDX_H
+#define CF_POLLIDX_H
+
+#include "cf_cfdp_types.h"
+#include "cf_tbldefs.h"
+
+/**
+ * @brief Value of the magic field of a poll index header ("CFPI")
+ */
+#define CF_POLLIDX_MAGIC 0x43465049
+
+/**
+ * @brief Version of the poll index format, increment on any change to the structures below
+ */
+#define CF_POLLIDX_VERSION 1
+
+/**
+ * @brief Suffix appended to the poll index file name while it is being written
+ */
+#define CF_POLLIDX_TEMP_SUFFIX ".tmp"
+
+/**
+ * @brief Poll index file header
+ *
+ * This is followed by num_records CF_PollIdxRecord_t entries.
+ */
+typedef struct CF_PollIdxHeader
+{
+    uint32 magic;       /**< \brief always CF_POLLIDX_MAGIC */
+    uint32 version;     /**< \brief always CF_POLLIDX_VERSION */
+    uint32 num_records; /**< \brief number of directory records following */
+} CF_PollIdxHeader_t;
+
+/**
+ * @brief Snapshot of a single settled polling directory
+ */
+typedef struct CF_PollIdxRecord
+{
+    char   src_dir[CF_FILENAME_MAX_PATH]; /**< \brief polled directory, from the configuration table */
+    uint32 dir_mtime;                     /**< \brief modification time of the directory, in seconds */
+    uint8  chan_num;                      /**< \brief channel of the polling directory */
+    uint8  poll_num;                      /**< \brief index of the polling directory in the channel */
+} CF_PollIdxRecord_t;
+
+/************************************************************************/
+/** @brief Checks whether a polling directory is unchanged since it settled.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       poll must not be NULL. pd must not be NULL.
+ *
+ * @param poll  Pointer to the polling directory state
+ * @param pd    Pointer to the polling directory configuration
+ *
+ * @retval true if the directory does not need to be scanned
+ * @retval false if it must be scanned
+ */
+bool CF_PollIdx_Unchanged(const CF_Poll_t *poll, const CF_PollDir_t *pd);
+
+/************************************************************************/
+/** @brief Notes the start of a scan of a polling directory.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       poll must not be NULL.  Called once the playback of the directory has
+ *       been initiated.
+ *
+ * @param poll  Pointer to the polling directory state
+ */
+void CF_PollIdx_BeginScan(CF_Poll_t *poll);
+
+/************************************************************************/
+/** @brief Takes the snapshot of a polling directory once its scan is done.
+ *
+ * The directory is settled if every file found was sent successfully, and the
+ * directory has not been modified since the scan started.  The index file is
+ * saved whenever the snapshot changes.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       poll must not be NULL. pd must not be NULL.  Called once the playback
+ *       of the directory is no longer busy.
+ *
+ * @param poll  Pointer to the polling directory state
+ * @param pd    Pointer to the polling directory configuration
+ */
+void CF_PollIdx_EndScan(CF_Poll_t *poll, const CF_PollDir_t *pd);
+
+/************************************************************************/
+/** @brief Drops the snapshot of a polling directory.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       poll must not be NULL.
+ *
+ * @param poll  Pointer to the polling directory state
+ */
+void CF_PollIdx_Invalidate(CF_Poll_t *poll);
+
+/************************************************************************/
+/** @brief Checks whether a file found by a polling scan is done being written.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       path must not be NULL.  A file that cannot be examined is treated as
+ *       settled, the transfer reports the actual error.
+ *
+ * @param path  Full path of the file
+ *
+ * @retval true if the file was not modified within poll_settle_s
+ * @retval false if it may still be written
+ */
+bool CF_PollIdx_FileSettled(const char *path);
+
+/************************************************************************/
+/** @brief Writes the snapshots of all settled polling directories to the index file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Does nothing if no index file is configured.
+ *
+ * @retval CFE_SUCCESS if the index was written or is not configured
+ * @retval CF_ERROR if it could not be written
+ */
+CFE_Status_t CF_PollIdx_Save(void);
+
+/************************************************************************/
+/** @brief Loads the snapshots of the polling directories from the index file.
+ *
+ * Records that do not match the current configuration table are ignored.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called at engine initialization.  Does nothing if no index file is
+ *       configured or present.
+ */
+void CF_PollIdx_Load(void);
+
+#endif /* !CF_POLLIDX_H */
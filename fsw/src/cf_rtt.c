@@ -0,0 +1,194 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application round trip time estimation
+ *
+ * The ACK and NAK timers follow the measured round trip time of each peer.
+ * See cf_rtt.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_rtt.h"
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Finds the entry of a peer in the housekeeping packet, or takes an unused one if add is set.
+ *
+ *-----------------------------------------------------------------*/
+static CF_HkPeerRtt_t *CF_Rtt_FindPeer(CF_EntityId_t peer_eid, bool add)
+{
+    CF_HkPeerRtt_t *peer;
+    CF_HkPeerRtt_t *unused = NULL;
+    int             i;
+
+    for (i = 0; i < CF_MAX_RTT_PEERS; ++i)
+    {
+        peer = &CF_AppData.hk.Payload.peer_rtt[i];
+        if (peer->samples == 0)
+        {
+            if (unused == NULL)
+            {
+                unused = peer;
+            }
+        }
+        else if (peer->eid == peer_eid)
+        {
+            return peer;
+        }
+    }
+
+    if (add && unused != NULL)
+    {
+        unused->eid = peer_eid;
+        return unused;
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_rtt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Rtt_Start(CF_Transaction_t *txn, bool retransmit)
+{
+    txn->flags.com.rtt_pending = !retransmit;
+    txn->state_data.rtt_start  = CF_AppData.engine.tick_count;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_rtt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Rtt_Stop(CF_Transaction_t *txn)
+{
+    uint64 ticks;
+
+    if (txn->flags.com.rtt_pending)
+    {
+        txn->flags.com.rtt_pending = false;
+
+        ticks = (CF_Timer_Ticks_t)(CF_AppData.engine.tick_count - txn->state_data.rtt_start);
+        CF_Rtt_Update(txn->history->peer_eid, (ticks * 1000) / CF_AppData.config_table->ticks_per_second);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_rtt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Rtt_Update(CF_EntityId_t peer_eid, uint32 sample_ms)
+{
+    CF_HkPeerRtt_t *peer = CF_Rtt_FindPeer(peer_eid, true);
+    uint32          err;
+
+    if (peer != NULL)
+    {
+        if (peer->samples == 0)
+        {
+            peer->srtt_ms   = sample_ms;
+            peer->rttvar_ms = sample_ms / 2;
+        }
+        else
+        {
+            err = (peer->srtt_ms > sample_ms) ? (peer->srtt_ms - sample_ms) : (sample_ms - peer->srtt_ms);
+
+            /* the variation is updated with the error of the previous estimate */
+            peer->rttvar_ms = (uint32)((((uint64)peer->rttvar_ms * 3) + err) / 4);
+            peer->srtt_ms   = (uint32)((((uint64)peer->srtt_ms * 7) + sample_ms) / 8);
+        }
+
+        if (peer->samples < UINT32_MAX)
+        {
+            ++peer->samples;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_rtt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_Timer_Ticks_t CF_Rtt_GetTimeout(const CF_Transaction_t *txn, CF_Timer_Seconds_t static_s)
+{
+    const CF_ChannelConfig_t *cc  = &CF_AppData.config_table->chan[txn->chan_num];
+    uint32                    tps = CF_AppData.config_table->ticks_per_second;
+    const CF_HkPeerRtt_t     *peer;
+    uint64                    var_ms;
+    uint64                    ticks;
+
+    peer = (cc->rtt_timer_max_s != 0) ? CF_Rtt_FindPeer(txn->history->peer_eid, false) : NULL;
+    if (peer == NULL)
+    {
+        return CF_Timer_Sec2Ticks(static_s);
+    }
+
+    /* a variation below one tick cannot be measured, so it is never counted as less */
+    var_ms = (uint64)peer->rttvar_ms * 4;
+    if (var_ms < (1000 / tps))
+    {
+        var_ms = 1000 / tps;
+    }
+
+    /* rounded up to whole ticks */
+    ticks = (((peer->srtt_ms + var_ms) * tps) + 999) / 1000;
+
+    if (ticks < CF_Timer_Sec2Ticks(cc->rtt_timer_min_s))
+    {
+        ticks = CF_Timer_Sec2Ticks(cc->rtt_timer_min_s);
+    }
+    if (ticks > CF_Timer_Sec2Ticks(cc->rtt_timer_max_s))
+    {
+        ticks = CF_Timer_Sec2Ticks(cc->rtt_timer_max_s);
+    }
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+
+    return ticks;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_rtt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Rtt_GetSrtt(CF_EntityId_t peer_eid)
+{
+    const CF_HkPeerRtt_t *peer = CF_Rtt_FindPeer(peer_eid, false);
+
+    return (peer != NULL) ? peer->srtt_ms : 0;
+}
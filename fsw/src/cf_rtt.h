@@ -0,0 +1,104 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Round trip time of the peers, and the ACK/NAK timers derived from it
+ *
+ * Class 2 transactions time two exchanges with their peer: a sender from its
+ * EOF to the EOF-ACK, and a receiver from a NAK sent after the EOF to the
+ * first file data that answers it.  Only a request that was sent once is
+ * timed, since the answer to a request sent again could be for any of its
+ * copies.  The times are counted in engine wakeups.
+ *
+ * Each peer keeps a smoothed round trip time and its variation, updated with
+ * the gains of the TCP retransmission timer (1/8 and 1/4).  On a channel
+ * with a nonzero rtt_timer_max_s, the ACK and NAK timers of the transactions
+ * with a measured peer are the smoothed round trip time plus four times its
+ * variation, within rtt_timer_min_s and rtt_timer_max_s.  Other peers use
+ * the static timers of the channel.
+ *
+ * The estimates are kept in the housekeeping packet.  A peer beyond the
+ * CF_MAX_RTT_PEERS first ones measured is not tracked.
+ */
+
+#ifndef CF_RTT_H
+#define CF_RTT_H
+
+#include "cf_cfdp_types.h"
+
+/************************************************************************/
+/** @brief Starts timing the answer to an EOF or NAK that was just sent.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  A retransmitted request is not timed, and
+ *       cancels the timing of the earlier copy.
+ *
+ * @param txn         Pointer to the transaction object
+ * @param retransmit  Whether the request was sent before
+ */
+void CF_Rtt_Start(CF_Transaction_t *txn, bool retransmit);
+
+/************************************************************************/
+/** @brief Stops timing when the answer arrives, and updates the round trip time of the peer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  Does nothing unless CF_Rtt_Start() started timing.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_Rtt_Stop(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Updates the round trip time estimates of a peer with a new sample.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The first sample of a peer sets the smoothed round trip time, and half
+ *       of it as the variation.  Nothing is done if the peer is not tracked
+ *       and the table is full.
+ *
+ * @param peer_eid   Entity ID of the peer
+ * @param sample_ms  Round trip time measured, in milliseconds
+ */
+void CF_Rtt_Update(CF_EntityId_t peer_eid, uint32 sample_ms);
+
+/************************************************************************/
+/** @brief Gets the ACK or NAK timer of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param static_s  Timer of the channel, used when the round trip time does not apply
+ *
+ * @returns Number of ticks of the timer
+ */
+CF_Timer_Ticks_t CF_Rtt_GetTimeout(const CF_Transaction_t *txn, CF_Timer_Seconds_t static_s);
+
+/************************************************************************/
+/** @brief Gets the smoothed round trip time of a peer.
+ *
+ * @param peer_eid  Entity ID of the peer
+ *
+ * @returns Smoothed round trip time in milliseconds, 0 if the peer is not measured
+ */
+uint32 CF_Rtt_GetSrtt(CF_EntityId_t peer_eid);
+
+#endif /* !CF_RTT_H */
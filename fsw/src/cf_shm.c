@@ -0,0 +1,190 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application shared memory statistics
+ *
+ * A sequence locked copy of the statistics, updated every wakeup.
+ * See cf_shm.h for the details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_shm.h"
+
+#include <string.h>
+
+#ifdef CF_SHM_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+CF_ShmStats_t CF_ShmStats;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the memory of the statistics block, NULL on failure.
+ *
+ *-----------------------------------------------------------------*/
+static CF_ShmStats_t *CF_Shm_Map(const char *name)
+{
+#ifdef CF_SHM_POSIX
+    CF_ShmStats_t *stats = NULL;
+    void          *mem;
+    int            fd;
+
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd >= 0)
+    {
+        if (ftruncate(fd, sizeof(CF_ShmStats_t)) == 0)
+        {
+            mem = mmap(NULL, sizeof(CF_ShmStats_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mem != MAP_FAILED)
+            {
+                stats = mem;
+            }
+        }
+        close(fd);
+    }
+
+    return stats;
+#else
+    return &CF_ShmStats;
+#endif
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets the bytes per second since the last measurement of a counter, and
+ * keeps the counter for the next one.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Shm_Rate(uint64 bytes, uint64 *last, int64 us)
+{
+    uint64 delta;
+    uint64 rate = 0;
+
+    /* the counters may have been reset since */
+    delta = (bytes >= *last) ? (bytes - *last) : bytes;
+    *last = bytes;
+
+    if (us > 0)
+    {
+        rate = (delta * 1000000) / (uint64)us;
+    }
+
+    return (rate > UINT32_MAX) ? UINT32_MAX : (uint32)rate;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_shm.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Shm_Init(void)
+{
+    CF_Shm_t      *shm  = &CF_AppData.shm;
+    const char    *name = CF_AppData.config_table->stats_shm_name;
+    CF_ShmStats_t *stats;
+
+    shm->stats = NULL;
+
+    if (name[0] != 0)
+    {
+        stats = CF_Shm_Map(name);
+        if (stats == NULL)
+        {
+            CFE_EVS_SendEvent(CF_INIT_SHM_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: cannot set up statistics shared memory %s, not published",
+                              name);
+        }
+        else
+        {
+            memset(stats, 0, sizeof(*stats));
+            stats->version = CF_SHM_VERSION;
+            stats->size    = sizeof(*stats);
+
+            /* readers only trust the block once the rest is set */
+            CF_SHM_BARRIER();
+            stats->magic = CF_SHM_MAGIC;
+
+            OS_GetLocalTime(&shm->rate_mark);
+            shm->stats = stats;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_shm.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Shm_Publish(void)
+{
+    CF_Shm_t                  *shm   = &CF_AppData.shm;
+    CF_ShmStats_t             *stats = shm->stats;
+    const CF_HkChannel_Data_t *chk;
+    OS_time_t                  now;
+    int64                      us;
+    int                        i;
+
+    if (stats != NULL)
+    {
+        /* the throughput is measured over a second or more, so it does not jump with each wakeup */
+        OS_GetLocalTime(&now);
+        us = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, shm->rate_mark));
+        if (us >= 1000000 || us < 0)
+        {
+            for (i = 0; i < CF_NUM_CHANNELS; ++i)
+            {
+                chk = &CF_AppData.hk.Payload.channel_hk[i];
+
+                shm->rate[i].tx_bytes_per_s = CF_Shm_Rate(chk->counters.sent.file_data_bytes, &shm->tx_bytes[i], us);
+                shm->rate[i].rx_bytes_per_s = CF_Shm_Rate(chk->counters.recv.file_data_bytes, &shm->rx_bytes[i], us);
+            }
+            shm->rate_mark = now;
+        }
+
+        CF_Diag_Update();
+
+        *(volatile uint32 *)&stats->seq = stats->seq + 1;
+        CF_SHM_BARRIER();
+
+        ++stats->updates;
+        stats->time = CFE_TIME_GetTime();
+        stats->hk   = CF_AppData.hk.Payload;
+        memcpy(stats->rate, shm->rate, sizeof(stats->rate));
+        stats->diag = CF_AppData.diag.pkt.Payload;
+
+        CF_SHM_BARRIER();
+        *(volatile uint32 *)&stats->seq = stats->seq + 1;
+    }
+}
@@ -0,0 +1,160 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Statistics published in shared memory for local monitors
+ *
+ * At the end of every wakeup the housekeeping counters and queue depths, the
+ * file data throughput of each channel and the wakeup phase timings of the
+ * diagnostics packet are copied into a statistics block, so that monitors
+ * can sample them as often as they like, without waiting for housekeeping
+ * or sending anything on the software bus.
+ *
+ * The block is guarded by a sequence lock: the sequence number is odd while
+ * CF writes the block, and goes up by two with every update.  A reader copies
+ * the block between two reads of the sequence number, and keeps the copy if
+ * both reads gave the same even number, see CF_Shm_Read().  The writer never
+ * waits for the readers.
+ *
+ * The block is published only if stats_shm_name of the configuration table is
+ * not empty.  It is the CF_ShmStats global, which the tasks of the same address
+ * space can find with OS_SymbolLookup().  When built with CF_SHM_POSIX on a
+ * POSIX host, the block is instead a shared memory object of that name, which
+ * other processes can map read only.
+ */
+
+#ifndef CF_SHM_H
+#define CF_SHM_H
+
+#include "cfe.h"
+#include "cf_msg.h"
+
+#include <string.h>
+
+/**
+ * @brief Value of the magic field of a published block, "CFSS"
+ */
+#define CF_SHM_MAGIC 0x43465353
+
+/**
+ * @brief Version of the layout of the block, changed with any change of CF_ShmStats_t
+ */
+#define CF_SHM_VERSION 1
+
+/**
+ * @brief Memory barrier between the sequence number and the data it guards
+ */
+#ifdef __GNUC__
+#define CF_SHM_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define CF_SHM_BARRIER()
+#endif
+
+/**
+ * @brief Throughput of a channel
+ */
+typedef struct CF_ShmChannel
+{
+    uint32 tx_bytes_per_s; /**< \brief file data bytes sent per second, over the last second or more */
+    uint32 rx_bytes_per_s; /**< \brief file data bytes received per second, over the last second or more */
+} CF_ShmChannel_t;
+
+/**
+ * @brief Layout of the statistics block
+ */
+typedef struct CF_ShmStats
+{
+    uint32 magic;   /**< \brief CF_SHM_MAGIC once the block is set up */
+    uint32 version; /**< \brief CF_SHM_VERSION */
+    uint32 size;    /**< \brief size of the block in bytes */
+    uint32 seq;     /**< \brief sequence lock, odd while the block is being written */
+    uint32 updates; /**< \brief number of updates */
+    uint32 spare;   /**< \brief alignment spare */
+
+    CFE_TIME_SysTime_t time; /**< \brief time of the last update */
+
+    CF_HkPacket_Payload_t   hk;                    /**< \brief housekeeping counters and queue depths */
+    CF_ShmChannel_t         rate[CF_NUM_CHANNELS]; /**< \brief throughput of each channel */
+    CF_DiagPacket_Payload_t diag;                  /**< \brief wakeup phase timing histograms */
+} CF_ShmStats_t;
+
+/**
+ * @brief Shared memory statistics state of the application
+ */
+typedef struct CF_Shm
+{
+    CF_ShmStats_t *stats; /**< \brief block published, NULL if not published */
+
+    OS_time_t       rate_mark;                 /**< \brief time the throughput was last measured */
+    uint64          tx_bytes[CF_NUM_CHANNELS]; /**< \brief bytes sent when the throughput was last measured */
+    uint64          rx_bytes[CF_NUM_CHANNELS]; /**< \brief bytes received when the throughput was last measured */
+    CF_ShmChannel_t rate[CF_NUM_CHANNELS];     /**< \brief throughput last measured */
+} CF_Shm_t;
+
+/**
+ * @brief The statistics block, when it is not a POSIX shared memory object
+ */
+extern CF_ShmStats_t CF_ShmStats;
+
+/************************************************************************/
+/** @brief Sets up the statistics block named in the configuration table.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       The configuration table must be loaded.  A block that cannot be set up
+ *       is reported with an event, and is not published.
+ */
+void CF_Shm_Init(void);
+
+/************************************************************************/
+/** @brief Updates the statistics block, if it is published.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called at the end of each wakeup.  Only the CF task may call it.
+ */
+void CF_Shm_Publish(void);
+
+/************************************************************************/
+/** @brief Takes a consistent copy of a statistics block.
+ *
+ * @par Description
+ *       For monitors.  The copy is not consistent if CF was updating the
+ *       block at the same time, in which case it may be retried at once.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       shm and copy must not be NULL.
+ *
+ * @param shm   Statistics block published by CF
+ * @param copy  Set to a copy of the block
+ *
+ * @returns true if the copy is consistent
+ */
+static inline bool CF_Shm_Read(const CF_ShmStats_t *shm, CF_ShmStats_t *copy)
+{
+    uint32 seq = *(const volatile uint32 *)&shm->seq;
+
+    CF_SHM_BARRIER();
+    memcpy(copy, shm, sizeof(*copy));
+    CF_SHM_BARRIER();
+
+    return ((seq & 1) == 0 && seq == *(const volatile uint32 *)&shm->seq && copy->magic == CF_SHM_MAGIC);
+}
+
+#endif /* !CF_SHM_H */
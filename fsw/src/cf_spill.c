@@ -0,0 +1,488 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * The CF Application spilling of idle transactions to disk
+ *
+ * This moves class 2 receive transactions that are idle or suspended out of
+ * memory and back in again.  See cf_spill.h for details.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+#include "cf_cfdp.h"
+#include "cf_utils.h"
+#include "cf_journal.h"
+#include "cf_spill.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "cf_assert.h"
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Spill_GetName(CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num, char *FileNameBuf, size_t FileNameSize)
+{
+    /* next to the temp file, see CF_CFDP_GetTempName() */
+    snprintf(FileNameBuf,
+             FileNameSize,
+             "%.*s/%lu_%lu.spl",
+             CF_FILENAME_MAX_PATH - 1,
+             CF_AppData.config_table->tmp_dir,
+             (unsigned long)src_eid,
+             (unsigned long)seq_num);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Spill_Txn(CF_Transaction_t *txn)
+{
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[txn->chan_num];
+    CF_SpillEntry_t *entry;
+    char             SpillName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t        fd;
+    int32            status;
+    CFE_Status_t     ret;
+
+    if (chan->num_spilled >= CF_MAX_SPILLED_PER_CHAN)
+    {
+        return CF_ERROR;
+    }
+
+    CF_Spill_GetName(txn->history->src_eid, txn->history->seq_num, SpillName, sizeof(SpillName));
+
+    status = CF_WrappedOpenCreate(&fd, SpillName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (status < 0)
+    {
+        ret = CF_ERROR;
+    }
+    else
+    {
+        ret = CF_Journal_WriteRecord(fd, txn, NULL);
+        CF_WrappedClose(fd);
+
+        if (ret != CFE_SUCCESS)
+        {
+            OS_remove(SpillName);
+        }
+    }
+
+    if (ret != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_SPILL_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to spill transaction %lu:%lu to %s",
+                          (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num,
+                          SpillName);
+        return ret;
+    }
+
+    entry          = &chan->spill[chan->num_spilled];
+    entry->src_eid = txn->history->src_eid;
+    entry->seq_num = txn->history->seq_num;
+    CF_Timer_InitRelSec(&entry->expiry, CF_AppData.config_table->spill_max_s);
+    ++chan->num_spilled;
+    ++chan->spill_writes;
+
+    /* the temp file keeps the data, only the handle is given up */
+    if (OS_ObjectIdDefined(txn->fd))
+    {
+        CF_WrappedClose(txn->fd);
+        txn->fd = OS_OBJECT_ID_UNDEFINED;
+    }
+
+    /* the transaction is not finished, it must not show up in the history */
+    txn->flags.com.keep_history = false;
+    CF_CFDP_RecycleTransaction(txn);
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Spill_Keep(CF_Channel_t *chan, osal_id_t fd, const CF_JournalRecord_t *rec)
+{
+    CF_SpillEntry_t *entry;
+    CF_Chunk_t       buf[CF_CHUNK_BLOCK_SIZE];
+    CF_ChunkIdx_t    remaining;
+    size_t           len;
+    char             SpillName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t        spill_fd = OS_OBJECT_ID_UNDEFINED;
+    bool             write_ok;
+    CFE_Status_t     ret = CFE_SUCCESS;
+
+    CF_Spill_GetName(rec->src_eid, rec->seq_num, SpillName, sizeof(SpillName));
+
+    write_ok = (chan->num_spilled < CF_MAX_SPILLED_PER_CHAN &&
+                CF_WrappedOpenCreate(&spill_fd, SpillName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE,
+                                     OS_WRITE_ONLY) >= 0);
+    if (write_ok)
+    {
+        write_ok = (CF_WrappedWrite(spill_fd, rec, sizeof(*rec)) == sizeof(*rec));
+    }
+    else
+    {
+        spill_fd = OS_OBJECT_ID_UNDEFINED;
+    }
+
+    /* the chunk entries are read even if there is nowhere to put them, so fd stays at the next record */
+    for (remaining = rec->num_chunks; remaining > 0; remaining -= len / sizeof(CF_Chunk_t))
+    {
+        len = sizeof(CF_Chunk_t) * ((remaining < CF_CHUNK_BLOCK_SIZE) ? remaining : CF_CHUNK_BLOCK_SIZE);
+        if (CF_WrappedRead(fd, buf, len) != len)
+        {
+            ret = CF_ERROR;
+            break;
+        }
+        if (write_ok && CF_WrappedWrite(spill_fd, buf, len) != len)
+        {
+            write_ok = false;
+        }
+    }
+
+    if (OS_ObjectIdDefined(spill_fd))
+    {
+        CF_WrappedClose(spill_fd);
+    }
+
+    if (ret == CFE_SUCCESS && write_ok)
+    {
+        entry          = &chan->spill[chan->num_spilled];
+        entry->src_eid = rec->src_eid;
+        entry->seq_num = rec->seq_num;
+        CF_Timer_InitRelSec(&entry->expiry, CF_AppData.config_table->spill_max_s);
+        ++chan->num_spilled;
+        ++chan->spill_writes;
+    }
+    else if (ret == CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_SPILL_WRITE_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: failed to spill transaction %lu:%lu to %s",
+                          (unsigned long)rec->src_eid,
+                          (unsigned long)rec->seq_num,
+                          SpillName);
+        ret = CF_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_SpillEntry_t *CF_Spill_Find(CF_Channel_t *chan, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    uint32 i;
+
+    for (i = 0; i < chan->num_spilled; ++i)
+    {
+        if (chan->spill[i].src_eid == src_eid && chan->spill[i].seq_num == seq_num)
+        {
+            return &chan->spill[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Spill_Remove(CF_Channel_t *chan, CF_SpillEntry_t *entry, bool keep_temp)
+{
+    CF_History_t history;
+    char         FileName[CFE_MISSION_MAX_PATH_LEN];
+
+    CF_Spill_GetName(entry->src_eid, entry->seq_num, FileName, sizeof(FileName));
+    OS_remove(FileName);
+
+    if (!keep_temp)
+    {
+        memset(&history, 0, sizeof(history));
+        history.src_eid = entry->src_eid;
+        history.seq_num = entry->seq_num;
+        CF_CFDP_GetTempName(&history, FileName, sizeof(FileName));
+        OS_remove(FileName);
+    }
+
+    /* order of the index does not matter, fill the hole with the last entry */
+    CF_Assert(chan->num_spilled > 0);
+    --chan->num_spilled;
+    *entry = chan->spill[chan->num_spilled];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Spill_Load(CF_Transaction_t *txn, CF_Channel_t *chan, CF_SpillEntry_t *entry)
+{
+    CF_JournalRecord_t rec;
+    uint8              chan_num = (chan - CF_AppData.engine.channels);
+    char               SpillName[CFE_MISSION_MAX_PATH_LEN];
+    osal_id_t          fd;
+    int32              status;
+    CFE_Status_t       ret;
+
+    CF_Spill_GetName(entry->src_eid, entry->seq_num, SpillName, sizeof(SpillName));
+
+    status = CF_WrappedOpenCreate(&fd, SpillName, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (status < 0)
+    {
+        ret = CF_ERROR;
+    }
+    else
+    {
+        if (CF_WrappedRead(fd, &rec, sizeof(rec)) != sizeof(rec) || rec.src_eid != entry->src_eid ||
+            rec.seq_num != entry->seq_num || rec.chan_num != chan_num || rec.sub_state > CF_RxSubState_VALIDATE ||
+            rec.num_chunks > CF_AppData.config_table->chan[chan_num].rx_chunks_per_transaction)
+        {
+            ret = CF_ERROR;
+        }
+        else
+        {
+            /* this recycles txn itself on failure */
+            ret = CF_Journal_ResumeTxn(txn, fd, &rec);
+            txn = NULL;
+        }
+
+        CF_WrappedClose(fd);
+    }
+
+    if (txn != NULL)
+    {
+        CFE_EVS_SendEvent(CF_SPILL_RELOAD_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: cannot reload spilled transaction %lu:%lu from %s",
+                          (unsigned long)entry->src_eid,
+                          (unsigned long)entry->seq_num,
+                          SpillName);
+        CF_CFDP_RecycleTransaction(txn);
+    }
+
+    CF_Spill_Remove(chan, entry, ret == CFE_SUCCESS);
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_Transaction_t *CF_Spill_Reload(CF_Channel_t *chan, CF_SpillEntry_t *entry)
+{
+    CF_Transaction_t *txn;
+    uint8             chan_num = (chan - CF_AppData.engine.channels);
+
+    txn = CF_CFDP_StartRxTransaction(chan_num);
+    if (txn == NULL && CF_Spill_MakeRoom(chan))
+    {
+        /* making room only appends to the index, so entry is still valid */
+        txn = CF_CFDP_StartRxTransaction(chan_num);
+    }
+
+    if (txn == NULL)
+    {
+        CFE_EVS_SendEvent(CF_SPILL_RELOAD_ERR_EID,
+                          CFE_EVS_EventType_ERROR,
+                          "CF: no transaction available to reload spilled transaction %lu:%lu",
+                          (unsigned long)entry->src_eid,
+                          (unsigned long)entry->seq_num);
+    }
+    else if (CF_Spill_Load(txn, chan, entry) != CFE_SUCCESS)
+    {
+        txn = NULL;
+    }
+
+    return txn;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Spill_ReloadAll(CF_Channel_t *chan)
+{
+    CF_Transaction_t *txn;
+    uint8             chan_num = (chan - CF_AppData.engine.channels);
+
+    /* each load removes the entry, so always take the last one */
+    while (chan->num_spilled > 0)
+    {
+        txn = CF_CFDP_StartRxTransaction(chan_num);
+        if (txn == NULL)
+        {
+            break;
+        }
+
+        CF_Spill_Load(txn, chan, &chan->spill[chan->num_spilled - 1]);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_CListTraverse_Status_t CF_Spill_FindSuspended(CF_CListNode_t *node, void *context)
+{
+    CF_Transaction_t  *txn    = container_of(node, CF_Transaction_t, cl_node);
+    CF_Transaction_t **victim = context;
+
+    if (txn->flags.com.suspended && CF_Journal_IsEligible(txn))
+    {
+        *victim = txn;
+        return CF_CLIST_EXIT;
+    }
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Spill_MakeRoom(CF_Channel_t *chan)
+{
+    CF_Transaction_t *victim = NULL;
+
+    if (CF_AppData.config_table->spill_idle_s == 0 || chan->num_spilled >= CF_MAX_SPILLED_PER_CHAN)
+    {
+        return false;
+    }
+
+    /* the RX queue is in order of arrival, so this picks the longest suspended one first */
+    CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_Spill_FindSuspended, &victim);
+
+    return (victim != NULL && CF_Spill_Txn(victim) == CFE_SUCCESS);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_CListTraverse_Status_t CF_Spill_IdleTxn(CF_CListNode_t *node, void *context)
+{
+    CF_Spill_IdleArg_t *arg = context;
+    CF_Transaction_t   *txn = container_of(node, CF_Transaction_t, cl_node);
+
+    if (CF_AppData.engine.channels[txn->chan_num].num_spilled >= CF_MAX_SPILLED_PER_CHAN)
+    {
+        return CF_CLIST_EXIT;
+    }
+
+    /*
+     * Suspended transactions do not tick, so their idle time is unknown: those are
+     * only spilled when the slot is needed.  A transaction checking its CRC is busy
+     * even without traffic, and would have to start over.
+     */
+    if (!txn->flags.com.suspended && txn->state_data.sub_state != CF_RxSubState_VALIDATE &&
+        (txn->inactivity_timer.tick + arg->idle_ticks) <= arg->inact_ticks && CF_Journal_IsEligible(txn))
+    {
+        CF_Spill_Txn(txn);
+    }
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_spill.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Spill_Tick(CF_Channel_t *chan)
+{
+    CF_Spill_IdleArg_t arg;
+    CF_SpillEntry_t   *entry;
+    uint8              chan_num = (chan - CF_AppData.engine.channels);
+    uint32             i;
+
+    if (CF_AppData.config_table->spill_idle_s == 0)
+    {
+        return;
+    }
+
+    i = 0;
+    while (i < chan->num_spilled)
+    {
+        entry = &chan->spill[i];
+        if (CF_Timer_Expired(&entry->expiry))
+        {
+            CFE_EVS_SendEvent(CF_SPILL_EXPIRED_ERR_EID,
+                              CFE_EVS_EventType_ERROR,
+                              "CF: spilled transaction %lu:%lu expired, abandoning it",
+                              (unsigned long)entry->src_eid,
+                              (unsigned long)entry->seq_num);
+            ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.fault.inactivity_timer;
+            CF_Peer_Count(entry->src_eid, CF_PeerCounter_INACTIVITY, 1);
+
+            /* this moves another entry into slot i */
+            CF_Spill_Remove(chan, entry, false);
+        }
+        else
+        {
+            CF_Timer_Tick(&entry->expiry);
+            ++i;
+        }
+    }
+
+    arg.inact_ticks = CF_Timer_Sec2Ticks(CF_AppData.config_table->chan[chan_num].inactivity_timer_s);
+    arg.idle_ticks  = CF_Timer_Sec2Ticks(CF_AppData.config_table->spill_idle_s);
+
+    /* spilling past the inactivity timeout is pointless, the transaction fails before */
+    if (arg.idle_ticks < arg.inact_ticks)
+    {
+        CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_Spill_IdleTxn, &arg);
+    }
+}
@@ -0,0 +1,216 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Spilling idle transactions to disk
+ *
+ * A class 2 receive transaction that has not seen any traffic for a while
+ * (for instance while waiting for the next pass), or that is suspended while
+ * its slot is needed, is written to a spill file in the temp directory and
+ * its transaction, history and chunk list are given back to the channel.
+ * Only a small index entry stays in memory.  The transaction is reloaded
+ * from the spill file when the next PDU or command for it arrives.
+ *
+ * A spilled transaction does not run its inactivity timer.  It is abandoned
+ * once it has been spilled for spill_max_s instead, which is usually much
+ * longer than the inactivity timeout of the channel.
+ *
+ * Spill files use the record format of the checkpoint journal (cf_journal.h).
+ */
+
+#ifndef CF_SPILL_H
+#define CF_SPILL_H
+
+#include "cf_cfdp_types.h"
+#include "cf_journal.h"
+
+/**
+ * @brief Argument structure for use with CF_Spill_IdleTxn()
+ */
+typedef struct CF_Spill_IdleArg
+{
+    CF_Timer_Ticks_t inact_ticks; /**< \brief inactivity timeout of the channel */
+    CF_Timer_Ticks_t idle_ticks;  /**< \brief time without traffic before a transaction is spilled */
+} CF_Spill_IdleArg_t;
+
+/************************************************************************/
+/** @brief Gets the name of the spill file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       FileNameBuf must not be NULL.
+ *
+ * @param src_eid       Source entity ID of the transaction
+ * @param seq_num       Sequence number of the transaction
+ * @param FileNameBuf   Output buffer for the file name
+ * @param FileNameSize  Size of the output buffer
+ */
+void CF_Spill_GetName(CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num, char *FileNameBuf, size_t FileNameSize);
+
+/************************************************************************/
+/** @brief Writes a transaction to its spill file and frees it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be accepted by CF_Journal_IsEligible().
+ *       On success the transaction has been recycled and must not be used anymore.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval CFE_SUCCESS if the transaction was spilled
+ * @retval CF_ERROR if the spill index is full or the file could not be written
+ */
+CFE_Status_t CF_Spill_Txn(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Spills a transaction straight from a checkpoint journal record.
+ *
+ * Used on restore for the transactions that find no free RX slot: these go
+ * back into the spill index instead of being dropped.  The spill file is
+ * (re)written from the journal copy of the record.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan and rec must not be NULL.  fd must be positioned at the chunk
+ *       entries that follow rec, these are read either way so that fd ends
+ *       up at the next record.
+ *
+ * @param chan  Pointer to the channel of the transaction
+ * @param fd    Journal file descriptor
+ * @param rec   Journal record of the transaction
+ *
+ * @retval CFE_SUCCESS if the transaction was spilled
+ * @retval CF_ERROR if the spill index is full, the spill file could not be written,
+ *                  or the chunk entries could not be read
+ */
+CFE_Status_t CF_Spill_Keep(CF_Channel_t *chan, osal_id_t fd, const CF_JournalRecord_t *rec);
+
+/************************************************************************/
+/** @brief Looks up a transaction in the spill index of a channel.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan     Pointer to the channel
+ * @param src_eid  Source entity ID of the transaction
+ * @param seq_num  Sequence number of the transaction
+ *
+ * @returns Pointer to the index entry
+ * @retval NULL if the transaction is not spilled on this channel
+ */
+CF_SpillEntry_t *CF_Spill_Find(CF_Channel_t *chan, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+
+/************************************************************************/
+/** @brief Removes a spilled transaction for good, along with its files.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL. entry must be an entry of chan.  The last
+ *       entry of the index is moved into the place of the removed one.
+ *
+ * @param chan       Pointer to the channel
+ * @param entry      Index entry of the transaction
+ * @param keep_temp  true if the temp file belongs to a transaction that was reloaded
+ */
+void CF_Spill_Remove(CF_Channel_t *chan, CF_SpillEntry_t *entry, bool keep_temp);
+
+/************************************************************************/
+/** @brief Reloads a spilled transaction into a transaction object.
+ *
+ * The index entry is consumed either way: if the spill file cannot be used,
+ * the transaction is abandoned.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and freshly returned by CF_CFDP_StartRxTransaction()
+ *       on the same channel.  entry must be an entry of chan.
+ *
+ * @param txn    Transaction to load into
+ * @param chan   Pointer to the channel
+ * @param entry  Index entry of the transaction
+ *
+ * @retval CFE_SUCCESS if the transaction was reloaded
+ * @retval CF_ERROR if not, txn has been recycled
+ */
+CFE_Status_t CF_Spill_Load(CF_Transaction_t *txn, CF_Channel_t *chan, CF_SpillEntry_t *entry);
+
+/************************************************************************/
+/** @brief Reloads a spilled transaction, making room for it if needed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL. entry must be an entry of chan.
+ *
+ * @param chan   Pointer to the channel
+ * @param entry  Index entry of the transaction
+ *
+ * @returns Pointer to the reloaded transaction
+ * @retval NULL if it could not be reloaded
+ */
+CF_Transaction_t *CF_Spill_Reload(CF_Channel_t *chan, CF_SpillEntry_t *entry);
+
+/************************************************************************/
+/** @brief Reloads spilled transactions of a channel while there is room.
+ *
+ * Used before commands that act on all transactions of a channel.  Nothing
+ * is spilled to make room, so some transactions may stay on disk.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan   Pointer to the channel
+ */
+void CF_Spill_ReloadAll(CF_Channel_t *chan);
+
+/************************************************************************/
+/** @brief Spills a suspended transaction to free a slot on a channel.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan   Pointer to the channel
+ *
+ * @retval true if a transaction was spilled
+ * @retval false if spilling is disabled or there was nothing to spill
+ */
+bool CF_Spill_MakeRoom(CF_Channel_t *chan);
+
+/************************************************************************/
+/** @brief List traversal function that spills a transaction if it is idle.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       node must not be NULL. context must not be NULL.
+ *
+ * @param node    Node being currently traversed
+ * @param context Pointer to CF_Spill_IdleArg_t
+ *
+ * @retval CF_CLIST_CONT to continue, CF_CLIST_EXIT once the spill index is full
+ */
+CF_CListTraverse_Status_t CF_Spill_IdleTxn(CF_CListNode_t *node, void *context);
+
+/************************************************************************/
+/** @brief Spill processing for a channel, called once per engine cycle.
+ *
+ * Spills idle transactions and abandons the ones that stayed spilled too long.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.  Does nothing if spilling is disabled in the
+ *       configuration table.
+ *
+ * @param chan   Pointer to the channel
+ */
+void CF_Spill_Tick(CF_Channel_t *chan);
+
+#endif /* !CF_SPILL_H */
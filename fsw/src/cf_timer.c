@@ -56,6 +56,17 @@ void CF_Timer_InitRelSec(CF_Timer_t *txn, uint32 rel_sec)
     txn->tick = CF_Timer_Sec2Ticks(rel_sec);
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_timer.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Timer_InitRelTicks(CF_Timer_t *txn, CF_Timer_Ticks_t rel_ticks)
+{
+    txn->tick = rel_ticks;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -61,6 +61,17 @@ typedef struct CF_Timer
  */
 void CF_Timer_InitRelSec(CF_Timer_t *txn, CF_Timer_Seconds_t rel_sec);
 
+/************************************************************************/
+/** @brief Initialize a timer with a relative number of scheduler ticks.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn         Timer object to initialize
+ * @param rel_ticks   Relative number of ticks
+ */
+void CF_Timer_InitRelTicks(CF_Timer_t *txn, CF_Timer_Ticks_t rel_ticks);
+
 /************************************************************************/
 /** @brief Check if a timer has expired.
  *
@@ -159,6 +159,7 @@ CF_Transaction_t *CF_FindUnusedTransaction(CF_Channel_t *chan, CF_Direction_t di
         /* notably this state is distinguishable from items still on the free list */
         txn->state        = CF_TxnState_INIT;
         txn->history->dir = direction;
+        CF_TxnMetrics_Start(&txn->history->metrics);
     }
     else
     {
@@ -180,6 +181,115 @@ void CF_ResetHistory(CF_Channel_t *chan, CF_History_t *history)
     CF_CList_InsertBack_Ex(chan, CF_QueueIdx_HIST_FREE, &history->cl_node);
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Arena_Init(CF_Arena_t *arena, void *mem, size_t size)
+{
+    arena->base = mem;
+    arena->size = size;
+    arena->used = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void *CF_Arena_Alloc(CF_Arena_t *arena, size_t size)
+{
+    void *ptr;
+
+    size = CF_ARENA_ROUNDUP(size);
+    if (size <= (arena->size - arena->used))
+    {
+        ptr = &arena->base[arena->used];
+        arena->used += size;
+    }
+    else
+    {
+        ptr = NULL;
+    }
+
+    return ptr;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_ActiveSet_t *CF_ActiveSet_Get(CF_Transaction_t *txn)
+{
+    CF_ActiveSet_t *set;
+
+    if (txn->chan_num >= CF_NUM_CHANNELS)
+    {
+        set = NULL;
+    }
+    else if (txn->flags.com.q_index == CF_QueueIdx_RX)
+    {
+        set = &CF_AppData.engine.channels[txn->chan_num].active[CF_Direction_RX];
+    }
+    else if (txn->flags.com.q_index == CF_QueueIdx_TX)
+    {
+        set = &CF_AppData.engine.channels[txn->chan_num].active[CF_Direction_TX];
+    }
+    else
+    {
+        set = NULL;
+    }
+
+    return set;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_ActiveSet_Insert(CF_Transaction_t *txn)
+{
+    CF_ActiveSet_t *set = CF_ActiveSet_Get(txn);
+
+    if (set != NULL && set->count < set->capacity)
+    {
+        txn->active_idx      = set->count;
+        set->txn[set->count] = txn;
+        ++set->count;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_ActiveSet_Remove(CF_Transaction_t *txn)
+{
+    CF_ActiveSet_t *set = CF_ActiveSet_Get(txn);
+
+    /* ignore anything that is not actually at its recorded position */
+    if (set != NULL && txn->active_idx < set->count && set->txn[txn->active_idx] == txn)
+    {
+        --set->count;
+        if (txn->active_idx != set->count)
+        {
+            /* move the last entry into the hole */
+            set->txn[txn->active_idx]             = set->txn[set->count];
+            set->txn[txn->active_idx]->active_idx = txn->active_idx;
+        }
+        set->txn[set->count] = NULL;
+        txn->active_idx      = 0;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -261,7 +371,7 @@ CFE_Status_t CF_WriteHistoryEntryToFile(osal_id_t fd, const CF_History_t *histor
     size_t       len;
     char         linebuf[(CF_FILENAME_MAX_LEN * 2) + 128]; /* buffer for line data */
 
-    for (i = 0; i < 3; ++i)
+    for (i = 0; i < 4; ++i)
     {
         switch (i)
         {
@@ -279,9 +389,25 @@ CFE_Status_t CF_WriteHistoryEntryToFile(osal_id_t fd, const CF_History_t *histor
                 break;
             case 1:
                 /* SAD: No need to check snprintf return; buffer size is sufficient for the formatted output */
-                snprintf(linebuf, sizeof(linebuf), "SRC: %s\t", history->fnames.src_filename);
+                snprintf(linebuf,
+                         sizeof(linebuf),
+                         "START: %lu.%06lu\tPDU: %lums\tEOF: %lums\tEND: %lums\tBYTES: %lu\tNAKS: %lu\tSEGS: %lu\t"
+                         "PEAK: %lu\t",
+                         (unsigned long)history->metrics.start_secs,
+                         (unsigned long)CFE_TIME_Sub2MicroSecs(history->metrics.start_subsecs),
+                         (unsigned long)history->metrics.first_pdu_ms,
+                         (unsigned long)history->metrics.eof_ms,
+                         (unsigned long)history->metrics.end_ms,
+                         (unsigned long)history->metrics.fd_bytes,
+                         (unsigned long)history->metrics.nak_rounds,
+                         (unsigned long)history->metrics.nak_segments,
+                         (unsigned long)history->metrics.peak_chunks);
                 break;
             case 2:
+                /* SAD: No need to check snprintf return; buffer size is sufficient for the formatted output */
+                snprintf(linebuf, sizeof(linebuf), "SRC: %s\t", history->fnames.src_filename);
+                break;
+            case 3:
             default:
                 /* SAD: No need to check snprintf return; buffer size is sufficient for the formatted output */
                 snprintf(linebuf, sizeof(linebuf), "DST: %s\n", history->fnames.dst_filename);
@@ -390,28 +516,126 @@ CFE_Status_t CF_WriteHistoryQueueDataToFile(osal_id_t fd, CF_Channel_t *chan, CF
     return arg.error;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_PrioQueue_t *CF_PrioQueue_Get(CF_Channel_t *chan, CF_QueueIdx_t queue)
+{
+    CF_PrioQueue_t *pq;
+
+    if (queue == CF_QueueIdx_PEND)
+    {
+        pq = &chan->pend_prio;
+    }
+    else if (queue == CF_QueueIdx_TX)
+    {
+        pq = &chan->tx_prio;
+    }
+    else
+    {
+        pq = NULL;
+    }
+
+    return pq;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Finds the numerically highest non-empty priority that is less than or
+ * equal to prio, which is the bucket a new entry of prio goes behind.
+ * Returns -1 if all non-empty priorities are numerically greater.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_PrioQueue_FindLastSet(const CF_PrioQueue_t *pq, uint8 prio)
+{
+    int    word = prio / 32;
+    int    bit;
+    uint32 bits;
+
+    /* mask off the bits above prio in its own word */
+    bits = pq->bitmap[word] & (0xFFFFFFFFU >> (31 - (prio % 32)));
+    while (bits == 0)
+    {
+        if (word == 0)
+        {
+            return -1;
+        }
+        --word;
+        bits = pq->bitmap[word];
+    }
+
+    /* binary search for the highest set bit */
+    bit = 0;
+    if (bits & 0xFFFF0000U)
+    {
+        bits >>= 16;
+        bit += 16;
+    }
+    if (bits & 0xFF00U)
+    {
+        bits >>= 8;
+        bit += 8;
+    }
+    if (bits & 0xF0U)
+    {
+        bits >>= 4;
+        bit += 4;
+    }
+    if (bits & 0xCU)
+    {
+        bits >>= 2;
+        bit += 2;
+    }
+    if (bits & 0x2U)
+    {
+        bit += 1;
+    }
+
+    return (word * 32) + bit;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
  * See description in cf_utils.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-CF_CListTraverse_Status_t CF_PrioSearch(CF_CListNode_t *node, void *context)
+void CF_PrioQueue_Remove(CF_Transaction_t *txn)
 {
-    CF_Transaction_t          *txn = container_of(node, CF_Transaction_t, cl_node);
-    CF_Traverse_PriorityArg_t *arg = (CF_Traverse_PriorityArg_t *)context;
+    CF_Channel_t     *chan;
+    CF_PrioQueue_t   *pq;
+    CF_Transaction_t *prev;
 
-    if (txn->priority <= arg->priority)
+    if (txn->chan_num < CF_NUM_CHANNELS)
     {
-        /* found it!
-         *
-         * the current transaction's prio is less than desired (higher)
-         */
-        arg->txn = txn;
-        return CF_CLIST_EXIT;
+        chan = &CF_AppData.engine.channels[txn->chan_num];
+        pq   = CF_PrioQueue_Get(chan, txn->flags.com.q_index);
+    }
+    else
+    {
+        chan = NULL;
+        pq   = NULL;
     }
 
-    return CF_CLIST_CONT;
+    if (pq != NULL && pq->tail[txn->priority] == txn)
+    {
+        /* the queue is sorted, so if anything else is left at this priority
+         * it is immediately before this one (and this is not the queue head) */
+        prev = container_of(txn->cl_node.prev, CF_Transaction_t, cl_node);
+        if (chan->qs[txn->flags.com.q_index] != &txn->cl_node && prev->priority == txn->priority)
+        {
+            pq->tail[txn->priority] = prev;
+        }
+        else
+        {
+            pq->tail[txn->priority] = NULL;
+            pq->bitmap[txn->priority / 32] &= ~(1U << (txn->priority % 32));
+        }
+    }
 }
 
 /*----------------------------------------------------------------
@@ -422,38 +646,38 @@ CF_CListTraverse_Status_t CF_PrioSearch(CF_CListNode_t *node, void *context)
  *-----------------------------------------------------------------*/
 void CF_InsertSortPrio(CF_Transaction_t *txn, CF_QueueIdx_t queue)
 {
-    bool          insert_back = false;
-    CF_Channel_t *chan        = &CF_AppData.engine.channels[txn->chan_num];
+    CF_Channel_t   *chan = &CF_AppData.engine.channels[txn->chan_num];
+    CF_PrioQueue_t *pq;
+    int             prio;
 
     CF_Assert(txn->chan_num < CF_NUM_CHANNELS);
 
-    /* look for proper position on PEND queue for this transaction.
-     * This is a simple priority sort. */
-
-    if (!chan->qs[queue])
+    pq = CF_PrioQueue_Get(chan, queue);
+    if (pq == NULL)
     {
-        /* list is empty, so just insert */
-        insert_back = true;
+        /* no priority index for this queue, so just put it at the end */
+        CF_CList_InsertBack_Ex(chan, queue, &txn->cl_node);
     }
     else
     {
-        CF_Traverse_PriorityArg_t arg = { NULL, txn->priority };
-        CF_CList_Traverse_R(chan->qs[queue], CF_PrioSearch, &arg);
-        if (arg.txn)
+        prio = CF_PrioQueue_FindLastSet(pq, txn->priority);
+        if (prio >= 0)
         {
-            CF_CList_InsertAfter_Ex(chan, queue, &arg.txn->cl_node, &txn->cl_node);
+            /* goes right behind the newest entry of the same or next higher priority */
+            CF_CList_InsertAfter_Ex(chan, queue, &pq->tail[prio]->cl_node, &txn->cl_node);
         }
         else
         {
-            insert_back = true;
+            /* higher priority than everything else in the queue (or queue is empty) */
+            CF_CList_InsertFront_Ex(chan, queue, &txn->cl_node);
         }
-    }
 
-    if (insert_back)
-    {
-        CF_CList_InsertBack_Ex(chan, queue, &txn->cl_node);
+        pq->tail[txn->priority] = txn;
+        pq->bitmap[txn->priority / 32] |= (1U << (txn->priority % 32));
     }
+
     txn->flags.com.q_index = queue;
+    CF_ActiveSet_Insert(txn);
 }
 
 /*----------------------------------------------------------------
@@ -668,3 +892,46 @@ CF_TxnStatus_t CF_TxnStatus_From_ConditionCode(CF_CFDP_ConditionCode_t cc)
     /* All CFDP CC values directly correspond to a Transaction Status of the same numeric value */
     return (CF_TxnStatus_t)cc;
 }
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_TxnMetrics_Start(CF_TxnMetrics_t *metrics)
+{
+    CFE_TIME_SysTime_t now = CFE_TIME_GetTime();
+
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->start_secs    = now.Seconds;
+    metrics->start_subsecs = now.Subseconds;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_TxnMetrics_Mark(const CF_TxnMetrics_t *metrics, uint32 *event_ms)
+{
+    CFE_TIME_SysTime_t start;
+    CFE_TIME_SysTime_t elapsed;
+    uint32             ms;
+
+    if (*event_ms == 0)
+    {
+        start.Seconds    = metrics->start_secs;
+        start.Subseconds = metrics->start_subsecs;
+        elapsed          = CFE_TIME_Subtract(CFE_TIME_GetTime(), start);
+
+        ms = (elapsed.Seconds * 1000) + (CFE_TIME_Sub2MicroSecs(elapsed.Subseconds) / 1000);
+        if (ms == 0)
+        {
+            ms = 1;
+        }
+
+        *event_ms = ms;
+    }
+}
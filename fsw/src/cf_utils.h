@@ -99,16 +99,83 @@ typedef struct CF_TraverseAll_Arg
     int32                           counter; /**< \brief Running tally of all nodes traversed from all lists */
 } CF_TraverseAll_Arg_t;
 
-/**
- * @brief Argument structure for use with CF_CList_Traverse_R()
+/************************************************************************/
+/** @brief Sets up an arena over a block of memory.
  *
- * This is for searching for transactions of a specific priority
+ * @par Assumptions, External Events, and Notes:
+ *       arena and mem must not be NULL.  mem must be aligned to CF_ARENA_ALIGN.
+ *
+ * @param arena  Pointer to the arena object
+ * @param mem    Start of the memory block to hand out
+ * @param size   Size of the memory block in bytes
  */
-typedef struct CF_Traverse_PriorityArg
-{
-    CF_Transaction_t *txn; /**< \brief OUT: holds value of transaction with which to call CF_CList_InsertAfter on */
-    uint8             priority; /**< \brief seeking this priority */
-} CF_Traverse_PriorityArg_t;
+void CF_Arena_Init(CF_Arena_t *arena, void *mem, size_t size);
+
+/************************************************************************/
+/** @brief Carves a block from an arena.
+ *
+ * @par Description
+ *       The size is rounded up to CF_ARENA_ALIGN so that the next block is
+ *       aligned as well.  The block is not cleared.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       arena must not be NULL.  Blocks are never returned individually; the
+ *       arena is set up again with CF_Arena_Init() to reuse the memory.
+ *
+ * @param arena  Pointer to the arena object
+ * @param size   Number of bytes needed
+ *
+ * @returns Pointer to the block
+ * @retval NULL if the arena does not have enough space left
+ */
+void *CF_Arena_Alloc(CF_Arena_t *arena, size_t size);
+
+/************************************************************************/
+/** @brief Adds a transaction to the active set of its current queue.
+ *
+ * @par Description
+ *       If the transaction is on the RX or TX queue (per its q_index) it is
+ *       appended to the matching channel active set, and its position is
+ *       recorded in the transaction.  Transactions on other queues are ignored.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  q_index must already reflect the new queue.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_ActiveSet_Insert(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Removes a transaction from the active set of its current queue.
+ *
+ * @par Description
+ *       The last entry in the set is moved into the vacated slot, so this is
+ *       O(1) but does not preserve order.  Transactions that are not in an
+ *       active set are ignored.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  q_index must still reflect the old queue.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_ActiveSet_Remove(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Removes a transaction from the priority index of its current queue.
+ *
+ * @par Description
+ *       Only needed when the transaction is the newest entry at its priority;
+ *       the previous entry in the queue then takes its place if it has the same
+ *       priority, otherwise the priority is marked empty.  Transactions on
+ *       queues without a priority index are ignored.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.  Must be called before the transaction is removed
+ *       from its queue, as it uses the queue links.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_PrioQueue_Remove(CF_Transaction_t *txn);
 
 /* free a transaction from the queue it's on.
  * NOTE: this leaves the transaction in a bad state,
@@ -122,6 +189,8 @@ typedef struct CF_Traverse_PriorityArg
 static inline void CF_DequeueTransaction(CF_Transaction_t *txn)
 {
     CF_Assert(txn && (txn->chan_num < CF_NUM_CHANNELS));
+    CF_ActiveSet_Remove(txn);
+    CF_PrioQueue_Remove(txn);
     CF_CList_Remove(&CF_AppData.engine.channels[txn->chan_num].qs[txn->flags.com.q_index], &txn->cl_node);
     CF_Assert(CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index]); /* sanity check */
     --CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index];
@@ -130,12 +199,15 @@ static inline void CF_DequeueTransaction(CF_Transaction_t *txn)
 static inline void CF_MoveTransaction(CF_Transaction_t *txn, CF_QueueIdx_t queue)
 {
     CF_Assert(txn && (txn->chan_num < CF_NUM_CHANNELS));
+    CF_ActiveSet_Remove(txn);
+    CF_PrioQueue_Remove(txn);
     CF_CList_Remove(&CF_AppData.engine.channels[txn->chan_num].qs[txn->flags.com.q_index], &txn->cl_node);
     CF_Assert(CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index]); /* sanity check */
     --CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index];
     CF_CList_InsertBack(&CF_AppData.engine.channels[txn->chan_num].qs[queue], &txn->cl_node);
     txn->flags.com.q_index = queue;
     ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index];
+    CF_ActiveSet_Insert(txn);
 }
 
 static inline void CF_CList_Remove_Ex(CF_Channel_t *chan, CF_QueueIdx_t queueidx, CF_CListNode_t *node)
@@ -152,6 +224,12 @@ CF_CList_InsertAfter_Ex(CF_Channel_t *chan, CF_QueueIdx_t queueidx, CF_CListNode
     ++CF_AppData.hk.Payload.channel_hk[chan - CF_AppData.engine.channels].q_size[queueidx];
 }
 
+static inline void CF_CList_InsertFront_Ex(CF_Channel_t *chan, CF_QueueIdx_t queueidx, CF_CListNode_t *node)
+{
+    CF_CList_InsertFront(&chan->qs[queueidx], node);
+    ++CF_AppData.hk.Payload.channel_hk[chan - CF_AppData.engine.channels].q_size[queueidx];
+}
+
 static inline void CF_CList_InsertBack_Ex(CF_Channel_t *chan, CF_QueueIdx_t queueidx, CF_CListNode_t *node)
 {
     CF_CList_InsertBack(&chan->qs[queueidx], node);
@@ -289,13 +367,15 @@ CFE_Status_t CF_WriteHistoryQueueDataToFile(osal_id_t fd, CF_Channel_t *chan, CF
 /** @brief Insert a transaction into a priority sorted transaction queue.
  *
  * @par Description
- *       This function works by walking the queue in reverse to find a
- *       transaction with a higher priority than the given transaction.
- *       The given transaction is then inserted after that one, since it
- *       would be the next lower priority.
+ *       For the PEND and TX queues, the channel priority index is used to
+ *       find the newest transaction of the same or the next higher priority,
+ *       and the given transaction is inserted after it (or at the front of the
+ *       queue if there is none).  This keeps the queue sorted by priority and
+ *       FIFO within a priority, without walking the queue.
  *
  * @par Assumptions, External Events, and Notes:
- *       txn must not be NULL.
+ *       txn must not be NULL.  Other queues have no priority index, so the
+ *       transaction is simply appended to them.
  *
  * @param txn  Pointer to the transaction object
  * @param queue  Index of queue to insert into
@@ -383,20 +463,6 @@ CF_CListTraverse_Status_t CF_Traverse_WriteHistoryQueueEntryToFile(CF_CListNode_
  */
 CF_CListTraverse_Status_t CF_Traverse_WriteTxnQueueEntryToFile(CF_CListNode_t *node, void *arg);
 
-/************************************************************************/
-/** @brief Searches for the first transaction with a lower priority than given.
- *
- * @par Assumptions, External Events, and Notes:
- *       node must not be NULL. context must not be NULL.
- *
- * @param node    Node being currently traversed
- * @param context Pointer to CF_Traverse_PriorityArg_t object indicating the priority to search for
- *
- * @retval CF_CLIST_EXIT when it's found, which terminates list traversal
- * @retval CF_CLIST_CONT when it isn't found, which causes list traversal to continue
- *
- */
-CF_CListTraverse_Status_t CF_PrioSearch(CF_CListNode_t *node, void *context);
 
 /************************************************************************/
 /** @brief Wrap the filesystem open call with a perf counter.
@@ -565,4 +631,28 @@ CF_CListNode_t **CF_GetChunkListHead(CF_Channel_t *chan, uint8 direction);
  */
 CF_CFDP_AckTxnStatus_t CF_CFDP_GetAckTxnStatus(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Starts the metrics of a transaction
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       metrics must not be NULL. Clears all counts and stamps the start time,
+ *       since history entries are reused by later transactions.
+ *
+ * @param metrics  Metrics of the transaction
+ */
+void CF_TxnMetrics_Start(CF_TxnMetrics_t *metrics);
+
+/************************************************************************/
+/** @brief Records the time of a transaction event, the first time it happens
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       metrics and event_ms must not be NULL. event_ms must be one of the
+ *       time fields of metrics. An event at the start time is recorded as
+ *       1 ms, so 0 always means the event did not happen.
+ *
+ * @param metrics   Metrics of the transaction
+ * @param event_ms  Field to record milliseconds since the start in, if still 0
+ */
+void CF_TxnMetrics_Mark(const CF_TxnMetrics_t *metrics, uint32 *event_ms);
+
 #endif /* !CF_UTILS_H */
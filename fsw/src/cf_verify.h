@@ -39,8 +39,20 @@
 #error Must have at least one channel.
 #endif
 
-#if CF_NUM_HISTORIES > 65535
-#error refactor code for 32 bit CF_NUM_HISTORIES
+#if CF_NUM_HISTORIES_PER_CHANNEL > 65535
+#error refactor code for 32 bit CF_NUM_HISTORIES_PER_CHANNEL
+#endif
+
+#if CF_ENGINE_ARENA_SIZE == 0
+#error CF_ENGINE_ARENA_SIZE must be large enough to hold the engine pools
+#endif
+
+#if CF_CHUNK_BLOCK_SIZE == 0
+#error CF_CHUNK_BLOCK_SIZE must be greater than 0
+#endif
+
+#if CF_OUTPUT_RING_SIZE == 0 || CF_OUTPUT_RING_SIZE > 65535
+#error CF_OUTPUT_RING_SIZE must be between 1 and 65535
 #endif
 
 #if (CF_PERF_ID_PDURCVD(CF_NUM_CHANNELS - 1) >= CF_PERF_ID_PDUSENT(0))
@@ -52,14 +52,32 @@ CF_ConfigTable_t CF_config_table = {
                 23,              /* destination entity id */
                 "/cf/poll_dir",  /* source directory */
                 "./poll_dir",    /* destination directory */
-                0                /* polling directory enable flag (1 = enabled) */
+                0,               /* polling directory enable flag (1 = enabled) */
+                0,               /* bundle_file_max, 0 sends every file in its own transaction */
+                65536,           /* bundle_max_bytes */
+                100,             /* bundle_max_files */
+                60,              /* bundle_max_age_s */
+                CF_Compress_NONE /* compress */
             },
             {
                 0 /* zero fill unused polling directory slots */
             } },
           "",            /* throttle sem, empty string means no throttle */
           1,             /* dequeue enable flag (1 = enabled) */
-          .move_dir = "" /* If not empty, will attempt move instead of delete on TX file complete */
+          .move_dir                  = "",  /* If not empty, will attempt move instead of delete on TX file complete */
+          .num_transactions          = 50,  /* transaction objects allocated to this channel */
+          .num_histories             = 256, /* history entries allocated to this channel */
+          .rx_chunks_per_transaction = 512, /* max chunks for gap tracking per rx transaction */
+          .tx_chunks_per_transaction = 128, /* max chunks for NAK tracking per tx transaction */
+          .num_chunk_blocks          = 354, /* 1 per transaction + 8 rx and 8 tx at their caps: 50 + 8*31 + 8*7 */
+          .nak_reorder_ticks         = 5,   /* ticks a new gap may stay open before it is NAKed */
+          .nak_mode                  = CF_NakMode_DEFERRED, /* NAK only after EOF; IMMEDIATE or ASYNC are opt-in */
+          .prompt_keep_alive_bytes   = 0,   /* Prompt(Keep Alive) interval in bytes, 0 = never */
+          .prompt_nak_bytes          = 0,   /* Prompt(NAK) interval in bytes, 0 = never */
+          .playback_order            = CF_PlaybackOrder_DIR, /* start playback files in directory order */
+          .delta_block_size          = 0, /* block size of delta transfers, 0 = always send the whole file */
+          .rtt_timer_min_s           = 1, /* shortest ACK/NAK timer from the measured round trip time */
+          .rtt_timer_max_s           = 0  /* longest ACK/NAK timer from the round trip time, 0 = static timers */
       }, {                /* channel 1 */
         5,             /* max number of outgoing messages per wakeup */
         5,             /* max number of rx messages per wakeup */
@@ -77,9 +95,40 @@ CF_ConfigTable_t CF_config_table = {
           } },
         "", /* throttle sem, empty string means no throttle */
         1,  /* dequeue enable flag (1 = enabled) */
-        .move_dir = "" } },
+        .move_dir                  = "",  /* If not empty, will attempt move instead of delete on TX file complete */
+        .num_transactions          = 50,  /* transaction objects allocated to this channel */
+        .num_histories             = 256, /* history entries allocated to this channel */
+        .rx_chunks_per_transaction = 512, /* max chunks for gap tracking per rx transaction */
+        .tx_chunks_per_transaction = 128, /* max chunks for NAK tracking per tx transaction */
+        .num_chunk_blocks          = 354, /* 1 per transaction + 8 rx and 8 tx at their caps: 50 + 8*31 + 8*7 */
+        .nak_reorder_ticks         = 5,   /* ticks a new gap may stay open before it is NAKed */
+        .nak_mode                  = CF_NakMode_DEFERRED, /* NAK only after EOF; IMMEDIATE or ASYNC are opt-in */
+        .prompt_keep_alive_bytes   = 0,   /* Prompt(Keep Alive) interval in bytes, 0 = never */
+        .prompt_nak_bytes          = 0,   /* Prompt(NAK) interval in bytes, 0 = never */
+        .playback_order            = CF_PlaybackOrder_DIR, /* start playback files in directory order */
+        .delta_block_size          = 0, /* block size of delta transfers, 0 = always send the whole file */
+        .rtt_timer_min_s           = 1, /* shortest ACK/NAK timer from the measured round trip time */
+        .rtt_timer_max_s           = 0  /* longest ACK/NAK timer from the round trip time, 0 = static timers */
+      } },
     480, /* outgoing_file_chunk_size */
     "/cf/tmp", /* temporary file directory */
     "/cf/fail", /* Stores failed tx file for "polling directory" */
+    0, /* checkpoint_interval_s, 0 disables transaction checkpoint and resume */
+    "/cf/tmp/cf_journal.dat", /* transaction checkpoint journal */
+    0, /* spill_idle_s, 0 disables spilling transactions to disk */
+    3600, /* spill_max_s */
+    0, /* poll_settle_s, 0 sends polled files as soon as they are found */
+    "/cf/tmp/cf_pollidx.dat", /* polling directory snapshot index */
+    {                         /* playback priority map for CF_MAX_PLAYBACK_PRIO_RULES */
+      {
+          "" /* zero fill unused patterns */
+      } },
+    0, /* wakeup_budget_us, 0 lets each wakeup run until its work is done, 50000 suits the 10 Hz wakeup */
+    "", /* stats_shm_name, empty does not publish the statistics in shared memory */
+    8, /* event_burst, 0 does not rate limit the events sent for each PDU */
+    1, /* event_rate, events per second */
+    10, /* event_summary_s, 0 does not report the events suppressed */
+    "", /* capture_file, empty does not capture the PDUs */
+    16384, /* capture_max_kb */
 };
 CFE_TBL_FILEDEF(CF_config_table, CF.config_table, CF config table, cf_def_config.tbl)
@@ -0,0 +1,354 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host decoder of the binary queue dumps of CF
+ *
+ * Prints the records of files written by the write queue command with the
+ * binary format, see fsw/src/cf_dump.h for the layout, one line each like the
+ * text format, or as CSV:
+ *
+ *     cf_dump_decode [--csv] FILE...
+ *
+ * The layout is read from the header, so dumps of builds with another
+ * CF_FILENAME_MAX_LEN decode as well.  The tool only needs a C library, and
+ * knows nothing of the CF headers beside the format.
+ */
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CF_DUMP_DECODE_MAGIC         0x43465144
+#define CF_DUMP_DECODE_VERSION       1
+#define CF_DUMP_DECODE_HEADER_SIZE   28
+#define CF_DUMP_DECODE_FIXED_SIZE    64 /* record bytes before the file names */
+#define CF_DUMP_DECODE_FLAG_COMPLETE 0x01
+
+/**
+ * @brief Fields of the dump header
+ */
+typedef struct CF_DumpDecode_Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint32_t filename_len;
+    uint32_t count;
+    uint32_t time_secs;
+    uint32_t time_subsecs;
+    uint32_t chan;
+    uint32_t type;
+    uint32_t queue;
+    uint32_t flags;
+} CF_DumpDecode_Header_t;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Gets a big endian number of size octets.
+ *
+ *-----------------------------------------------------------------*/
+static uint64_t CF_DumpDecode_Load(const uint8_t *octets, size_t size)
+{
+    uint64_t val = 0;
+
+    while (size > 0)
+    {
+        val = (val << 8) | *octets;
+        ++octets;
+        --size;
+    }
+
+    return val;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Converts subseconds of a CFE time to microseconds.
+ *
+ *-----------------------------------------------------------------*/
+static unsigned long CF_DumpDecode_Micros(uint32_t subsecs)
+{
+    return (unsigned long)(((uint64_t)subsecs * 1000000) >> 32);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints a file name field, which may not be terminated.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_DumpDecode_PrintName(FILE *out, const uint8_t *name, size_t len)
+{
+    size_t n = 0;
+
+    while (n < len && name[n] != 0)
+    {
+        ++n;
+    }
+
+    fprintf(out, "%.*s", (int)n, (const char *)name);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints a record, as a line like the text format or as CSV.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_DumpDecode_PrintRecord(FILE *out, const CF_DumpDecode_Header_t *hdr, const uint8_t *rec, int csv)
+{
+    static const char *QUEUES[] = { "PEND", "TX", "RX", "HIST" };
+    static const char *DIRS[]   = { "RX", "TX" };
+
+    const char   *queue = (rec[0] < 4) ? QUEUES[rec[0]] : "?";
+    const char   *dir   = (rec[1] < 2) ? DIRS[rec[1]] : "?";
+    int           stat  = (int)(int8_t)rec[2];
+    unsigned long m[9];
+    int           i;
+
+    for (i = 0; i < 9; ++i)
+    {
+        m[i] = (unsigned long)CF_DumpDecode_Load(&rec[28 + (4 * i)], 4);
+    }
+
+    if (csv)
+    {
+        fprintf(out,
+                "%s,%s,%d,%llu,%llu,%llu,%lu.%06lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,",
+                queue,
+                dir,
+                stat,
+                (unsigned long long)CF_DumpDecode_Load(&rec[4], 8),
+                (unsigned long long)CF_DumpDecode_Load(&rec[20], 8),
+                (unsigned long long)CF_DumpDecode_Load(&rec[12], 8),
+                m[0],
+                CF_DumpDecode_Micros(m[1]),
+                m[2],
+                m[3],
+                m[4],
+                m[5],
+                m[6],
+                m[7],
+                m[8]);
+    }
+    else
+    {
+        fprintf(out,
+                "%-4s SEQ (%llu, %llu)\tDIR: %s\tPEER %llu\tSTAT: %d\t"
+                "START: %lu.%06lu\tPDU: %lums\tEOF: %lums\tEND: %lums\tBYTES: %lu\tNAKS: %lu\tSEGS: %lu\tPEAK: %lu\t"
+                "SRC: ",
+                queue,
+                (unsigned long long)CF_DumpDecode_Load(&rec[4], 8),
+                (unsigned long long)CF_DumpDecode_Load(&rec[20], 8),
+                dir,
+                (unsigned long long)CF_DumpDecode_Load(&rec[12], 8),
+                stat,
+                m[0],
+                CF_DumpDecode_Micros(m[1]),
+                m[2],
+                m[3],
+                m[4],
+                m[5],
+                m[6],
+                m[7],
+                m[8]);
+    }
+
+    CF_DumpDecode_PrintName(out, &rec[CF_DUMP_DECODE_FIXED_SIZE], hdr->filename_len);
+    fprintf(out, csv ? "," : "\tDST: ");
+    CF_DumpDecode_PrintName(out, &rec[CF_DUMP_DECODE_FIXED_SIZE + hdr->filename_len], hdr->filename_len);
+    fprintf(out, "\n");
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Decodes a dump file, returns 0 on success.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_DumpDecode_File(const char *name, FILE *out, int csv)
+{
+    CF_DumpDecode_Header_t hdr;
+    uint8_t                raw[CF_DUMP_DECODE_HEADER_SIZE];
+    uint8_t               *rec = NULL;
+    uint32_t               n   = 0;
+    FILE                  *in;
+    int                    ret = 0;
+
+    in = fopen(name, "rb");
+    if (in == NULL)
+    {
+        perror(name);
+        return 1;
+    }
+
+    if (fread(raw, sizeof(raw), 1, in) != 1)
+    {
+        fprintf(stderr, "%s: too short for a dump header\n", name);
+        fclose(in);
+        return 1;
+    }
+
+    hdr.magic        = (uint32_t)CF_DumpDecode_Load(&raw[0], 4);
+    hdr.version      = (uint32_t)CF_DumpDecode_Load(&raw[4], 2);
+    hdr.header_size  = (uint32_t)CF_DumpDecode_Load(&raw[6], 2);
+    hdr.record_size  = (uint32_t)CF_DumpDecode_Load(&raw[8], 2);
+    hdr.filename_len = (uint32_t)CF_DumpDecode_Load(&raw[10], 2);
+    hdr.count        = (uint32_t)CF_DumpDecode_Load(&raw[12], 4);
+    hdr.time_secs    = (uint32_t)CF_DumpDecode_Load(&raw[16], 4);
+    hdr.time_subsecs = (uint32_t)CF_DumpDecode_Load(&raw[20], 4);
+    hdr.chan         = raw[24];
+    hdr.type         = raw[25];
+    hdr.queue        = raw[26];
+    hdr.flags        = raw[27];
+
+    if (hdr.magic != CF_DUMP_DECODE_MAGIC || hdr.version != CF_DUMP_DECODE_VERSION ||
+        hdr.header_size < CF_DUMP_DECODE_HEADER_SIZE ||
+        hdr.record_size < CF_DUMP_DECODE_FIXED_SIZE + (2 * hdr.filename_len))
+    {
+        fprintf(stderr, "%s: not a version %d CF queue dump\n", name, CF_DUMP_DECODE_VERSION);
+        fclose(in);
+        return 1;
+    }
+
+    if (!csv)
+    {
+        fprintf(out,
+                "# %s: channel %lu, type %lu, queue %lu, started %lu.%06lu\n",
+                name,
+                (unsigned long)hdr.chan,
+                (unsigned long)hdr.type,
+                (unsigned long)hdr.queue,
+                (unsigned long)hdr.time_secs,
+                CF_DumpDecode_Micros(hdr.time_subsecs));
+    }
+
+    rec = malloc(hdr.record_size);
+    if (rec == NULL || fseek(in, (long)hdr.header_size, SEEK_SET) != 0)
+    {
+        perror(name);
+        ret = 1;
+    }
+    else
+    {
+        while (fread(rec, hdr.record_size, 1, in) == 1)
+        {
+            CF_DumpDecode_PrintRecord(out, &hdr, rec, csv);
+            ++n;
+        }
+
+        /* a dump abandoned or still being written has no count */
+        if ((hdr.flags & CF_DUMP_DECODE_FLAG_COMPLETE) == 0)
+        {
+            fprintf(stderr, "%s: dump not complete, %lu records found\n", name, (unsigned long)n);
+            ret = 1;
+        }
+        else if (n != hdr.count)
+        {
+            fprintf(stderr,
+                    "%s: %lu records found, %lu expected\n",
+                    name,
+                    (unsigned long)n,
+                    (unsigned long)hdr.count);
+            ret = 1;
+        }
+    }
+
+    free(rec);
+    fclose(in);
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ * Prints the usage of the command.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_DumpDecode_Usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options] FILE...\n"
+            "  --csv                   comma separated values, one header line\n"
+            "Decodes the binary dumps of the CF write queue command.\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option LONG_OPTS[] = {
+        { "csv", no_argument, NULL, 'c' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    int c;
+    int csv    = 0;
+    int status = EXIT_SUCCESS;
+
+    while ((c = getopt_long(argc, argv, "ch", LONG_OPTS, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'c':
+                csv = 1;
+                break;
+            default:
+                CF_DumpDecode_Usage(argv[0]);
+                return (c == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        CF_DumpDecode_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (csv)
+    {
+        printf("queue,dir,stat,src_eid,seq_num,peer_eid,start,first_pdu_ms,eof_ms,end_ms,fd_bytes,nak_rounds,"
+               "nak_segments,peak_chunks,src_filename,dst_filename\n");
+    }
+
+    for (; optind < argc; ++optind)
+    {
+        if (CF_DumpDecode_File(argv[optind], stdout, csv) != 0)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
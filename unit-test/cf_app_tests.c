@@ -23,6 +23,7 @@
 #include "cf_dispatch.h"
 #include "cf_app.h"
 #include "cf_cmd.h"
+#include "cf_delta.h"
 
 /*******************************************************************************
 **
@@ -177,6 +178,10 @@ void cf_config_table_tests_set_table_to_nominal(void)
     table.rx_crc_calc_bytes_per_wakeup = Any_uint32_Except(0) << 10;
     /* all values less than sizeof(CF_CFDP_PduFileDataContent_t) are nominal */
     table.outgoing_file_chunk_size     = Any_uint16_LessThan(sizeof(CF_CFDP_PduFileDataContent_t));
+    /* empty channel pools are nominal */
+    memset(table.chan, 0, sizeof(table.chan));
+    /* an empty playback priority map is nominal */
+    memset(table.playback_prio, 0, sizeof(table.playback_prio));
 }
 
 void Setup_cf_config_table_tests(void)
@@ -255,6 +260,263 @@ void Test_CF_ValidateConfigTable_FailBecauseOutgoingFileChunkSmallerThanDataArra
     UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
 }
 
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerHistoriesThanTransactions(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].num_transactions     = 10;
+    arg_table->chan[0].num_histories        = 9;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_POOL_SIZE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasTooManyHistories(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].num_histories        = 65536;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_POOL_SIZE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasZeroChunkCap(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second                  = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup      = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size          = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].num_transactions          = 1;
+    arg_table->chan[0].num_histories             = 1;
+    arg_table->chan[0].rx_chunks_per_transaction = 1;
+    arg_table->chan[0].tx_chunks_per_transaction = 0;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_POOL_SIZE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerChunkBlocksThanTransactions(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second                  = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup      = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size          = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].num_transactions          = 2;
+    arg_table->chan[0].num_histories             = 2;
+    arg_table->chan[0].rx_chunks_per_transaction = 1;
+    arg_table->chan[0].tx_chunks_per_transaction = 1;
+    arg_table->chan[0].num_chunk_blocks          = 1;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_POOL_SIZE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidNakMode(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].nak_mode             = CF_NakMode_NUM;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_NAK_MODE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidPlaybackOrder(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].playback_order       = CF_PlaybackOrder_NUM;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_PLAYBACK_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecausePollDirHasInvalidCompress(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].polldir[1].compress  = CF_Compress_NUM;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_PLAYBACK_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecausePlaybackPatternNotTerminated(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    memset(arg_table->playback_prio[0].pattern, 'x', sizeof(arg_table->playback_prio[0].pattern));
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_PLAYBACK_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseDeltaBlockSizeTooLarge(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].delta_block_size     = CF_DELTA_MAX_BLOCK_SIZE + 1;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_DELTA_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseRttTimerBoundsInverted(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    arg_table->chan[0].rtt_timer_min_s      = 10;
+    arg_table->chan[0].rtt_timer_max_s      = 5;
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_RTT_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseStatsShmNameNotTerminated(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    memset(arg_table->stats_shm_name, 'x', sizeof(arg_table->stats_shm_name));
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_SHM_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecauseCaptureFileNotTerminated(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    memset(arg_table->capture_file, 'x', sizeof(arg_table->capture_file));
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UT_CF_AssertEventID(CF_INIT_CAPTURE_ERR_EID);
+}
+
+void Test_CF_ValidateConfigTable_FailBecausePoolsDoNotFitInArena(void)
+{
+    /* Arrange */
+    CF_ConfigTable_t *arg_table = &table;
+    int32             result;
+
+    arg_table->ticks_per_second             = 1;
+    arg_table->rx_crc_calc_bytes_per_wakeup = 0x0400; /* 1024 aligned */
+    arg_table->outgoing_file_chunk_size     = sizeof(CF_CFDP_PduFileDataContent_t);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_ChannelArenaSize), sizeof(CF_AppData.engine.arena_mem) + 1);
+
+    /* Act */
+    result = CF_ValidateConfigTable(arg_table);
+
+    /* Assert */
+    UtAssert_INT32_EQ(result, CFE_STATUS_VALIDATION_FAILURE);
+    UtAssert_STUB_COUNT(CF_CFDP_ChannelArenaSize, CF_NUM_CHANNELS);
+    UT_CF_AssertEventID(CF_INIT_ARENA_SIZE_ERR_EID);
+}
+
 void Test_CF_ValidateConfigTable_Success(void)
 {
     /* Arrange */
@@ -460,6 +722,8 @@ void Test_CF_AppInit_CallTo_CF_CFDP_InitEngine_ReturnsNot_CFE_SUCCESS_ReturnErro
     UtAssert_STUB_COUNT(CFE_SB_CreatePipe, 1);
     UtAssert_STUB_COUNT(CFE_SB_Subscribe, 3);
     UtAssert_STUB_COUNT(CF_CFDP_InitEngine, 1);
+    UtAssert_STUB_COUNT(CF_Shm_Init, 0);
+    UtAssert_STUB_COUNT(CF_Capture_Init, 0);
 }
 
 void Test_CF_AppInit_Success(void)
@@ -473,6 +737,9 @@ void Test_CF_AppInit_Success(void)
 
     /* Assert */
     UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+    UtAssert_STUB_COUNT(CF_EvLim_Init, 1);
+    UtAssert_STUB_COUNT(CF_Shm_Init, 1);
+    UtAssert_STUB_COUNT(CF_Capture_Init, 1);
 }
 
 /*******************************************************************************
@@ -574,6 +841,7 @@ void Test_CF_AppMain_RunLoopCallTo_CFE_SB_ReceiveBuffer_Returns_CFE_SUCCESS_AndV
     UtAssert_STUB_COUNT(CFE_ES_PerfLogAdd, 4);
     UtAssert_STUB_COUNT(CFE_ES_RunLoop, 2);
     UtAssert_STUB_COUNT(CFE_ES_ExitApp, 1);
+    UtAssert_STUB_COUNT(CF_Capture_Flush, 1);
     /* Assert for CF_AppInit call */
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
 }
@@ -631,6 +899,58 @@ void add_CF_ValidateConfigTable_tests(void)
                Setup_cf_config_table_tests,
                CF_App_Tests_Teardown,
                "Test_CF_ValidateConfigTable_FailBecauseOutgoingFileChunkSmallerThanDataArray");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerHistoriesThanTransactions,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerHistoriesThanTransactions");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasTooManyHistories,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasTooManyHistories");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasZeroChunkCap,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasZeroChunkCap");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerChunkBlocksThanTransactions,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasFewerChunkBlocksThanTransactions");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidNakMode,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidNakMode");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidPlaybackOrder,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseChannelHasInvalidPlaybackOrder");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecausePollDirHasInvalidCompress,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecausePollDirHasInvalidCompress");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecausePlaybackPatternNotTerminated,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecausePlaybackPatternNotTerminated");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseDeltaBlockSizeTooLarge,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseDeltaBlockSizeTooLarge");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseRttTimerBoundsInverted,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseRttTimerBoundsInverted");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseStatsShmNameNotTerminated,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseStatsShmNameNotTerminated");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecauseCaptureFileNotTerminated,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecauseCaptureFileNotTerminated");
+    UtTest_Add(Test_CF_ValidateConfigTable_FailBecausePoolsDoNotFitInArena,
+               Setup_cf_config_table_tests,
+               CF_App_Tests_Teardown,
+               "Test_CF_ValidateConfigTable_FailBecausePoolsDoNotFitInArena");
     UtTest_Add(Test_CF_ValidateConfigTable_Success,
                Setup_cf_config_table_tests,
                CF_App_Tests_Teardown,
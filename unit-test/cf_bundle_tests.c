@@ -0,0 +1,457 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_test_files.h"
+#include "cf_bundle.h"
+#include "cf_cfdp_s.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+static CF_ConfigTable_t    UT_CF_Bundle_Config;
+static uint32              UT_CF_Bundle_Now; /* seconds returned by OS_GetLocalTime() */
+
+static void UT_CF_Bundle_GetLocalTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    OS_time_t *time_struct = UT_Hook_GetArgValueByName(Context, "time_struct", OS_time_t *);
+
+    *time_struct = OS_TimeFromTotalSeconds(UT_CF_Bundle_Now);
+}
+
+/* builds a bundle of the two files "a" (3 bytes) and "bb" (5 bytes) of polling directory /ut/poll */
+static UT_CF_File_t *UT_CF_Bundle_Build(CF_Playback_t *pb)
+{
+    UT_CF_File_Make("/ut/poll/a", "one");
+    UT_CF_File_Make("/ut/poll/bb", "three");
+
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_files = 2;
+
+    CF_Bundle_Add(pb, "/ut/poll/a", "a", 3, 800);
+    CF_Bundle_Add(pb, "/ut/poll/bb", "bb", 5, 700);
+
+    return UT_CF_File_Find("/ut/tmp/cf_c0p1_0.cfb");
+}
+
+/*******************************************************************************
+**
+**  cf_bundle_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_bundle_tests_Setup(void)
+{
+    CF_PollDir_t *pd;
+
+    cf_tests_Setup();
+
+    memset(&UT_CF_Bundle_Config, 0, sizeof(UT_CF_Bundle_Config));
+
+    UT_CF_Bundle_Now = 1000;
+
+    strcpy(UT_CF_Bundle_Config.tmp_dir, "/ut/tmp");
+    pd = &UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1];
+    strcpy(pd->src_dir, "/ut/poll");
+    pd->enabled             = 1;
+    pd->bundle_file_max     = 100;
+    pd->bundle_max_age_s    = 60;
+    CF_AppData.config_table = &UT_CF_Bundle_Config;
+
+    UT_CF_Files_Setup();
+    UT_SetHandlerFunction(UT_KEY(OS_GetLocalTime), UT_CF_Bundle_GetLocalTime, NULL);
+}
+
+void cf_bundle_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/* a playback scanning polling directory 1 of the test channel */
+static void UT_CF_Bundle_SetupPlayback(CF_Playback_t *pb)
+{
+    memset(pb, 0, sizeof(*pb));
+    pb->polled          = true;
+    pb->bundle.chan_num = UT_CFDP_CHANNEL;
+    pb->bundle.poll_num = 1;
+    strcpy(pb->fnames.src_filename, "/ut/poll");
+    strcpy(pb->fnames.dst_filename, "/gnd/poll");
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Bundle_FileMax(void)
+{
+    /* Test case for:
+     * CF_FileSize_t CF_Bundle_FileMax(const CF_Playback_t *pb);
+     */
+    CF_Playback_t pb;
+
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UtAssert_UINT32_EQ(CF_Bundle_FileMax(&pb), 100);
+
+    /* commanded playbacks never bundle */
+    pb.polled = false;
+    UtAssert_UINT32_EQ(CF_Bundle_FileMax(&pb), 0);
+
+    /* bundling not configured */
+    pb.polled                                                            = true;
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_file_max = 0;
+    UtAssert_UINT32_EQ(CF_Bundle_FileMax(&pb), 0);
+}
+
+void Test_CF_Bundle_Add(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Bundle_Add(CF_Playback_t *pb, const char *path, const char *name, CF_FileSize_t size,
+     *                            uint32 mtime);
+     */
+    CF_Playback_t     pb;
+    UT_CF_File_t     *bundle;
+    CF_BundleEntry_t *entry;
+
+    /* the file cannot be opened, so it is sent on its own */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/none", "none", 3, 800), CF_ERROR);
+    UtAssert_ZERO(pb.bundle.num_files);
+    UtAssert_NULL(UT_CF_File_Find("/ut/tmp/cf_c0p1_0.cfb"));
+
+    /* nominal, the bundle is closed once it holds bundle_max_files */
+    bundle = UT_CF_Bundle_Build(&pb);
+    UtAssert_NOT_NULL(bundle);
+    UtAssert_BOOL_TRUE(pb.bundle.ready);
+    UtAssert_UINT16_EQ(pb.bundle.num_files, 2);
+    UtAssert_UINT32_EQ(pb.bundle.bytes, 8);
+    UtAssert_UINT32_EQ(pb.bundle.oldest, 700);
+    UtAssert_UINT32_EQ(bundle->len, sizeof(CF_BundleHeader_t) + 2 * sizeof(CF_BundleEntry_t) + 8);
+    UtAssert_UINT8_EQ(bundle->data[0], 0x43);
+    UtAssert_UINT8_EQ(bundle->data[3], 0x4E);
+    UtAssert_UINT8_EQ(bundle->data[4], CF_BUNDLE_VERSION);
+    UtAssert_UINT8_EQ(bundle->data[7], 2);
+    entry = (CF_BundleEntry_t *)&bundle->data[sizeof(CF_BundleHeader_t)];
+    UtAssert_UINT8_EQ(entry->size.octets[3], 3);
+    UtAssert_STRINGBUF_EQ(entry->name, sizeof(entry->name), "a", -1);
+    UtAssert_MemCmp(entry + 1, "one", 3, "contents of a");
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+
+    /* the bundle is closed once it holds bundle_max_bytes */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_files = 0;
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_bytes = 3;
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CFE_SUCCESS);
+    UtAssert_BOOL_TRUE(pb.bundle.ready);
+
+    /* no limits, the bundle stays open */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_bytes = 0;
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CFE_SUCCESS);
+    UtAssert_BOOL_FALSE(pb.bundle.ready);
+    UtAssert_UINT16_EQ(pb.bundle.num_files, 1);
+
+    /* the bundle cannot be created */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 2, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CF_ERROR);
+    UT_CF_AssertEventID(CF_BUNDLE_WRITE_ERR_EID);
+    UtAssert_ZERO(pb.bundle.num_files);
+
+    /* the header cannot be written */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CF_ERROR);
+    UT_CF_AssertEventID(CF_BUNDLE_WRITE_ERR_EID);
+    UtAssert_BOOL_TRUE(pb.rescan);
+
+    /* the file is shorter than it was, the bundle is discarded with the files already in it */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/bb", "bb", 50, 800), CF_ERROR);
+    UT_CF_AssertEventID(CF_BUNDLE_WRITE_ERR_EID);
+    UtAssert_ZERO(pb.bundle.num_files);
+    UtAssert_BOOL_TRUE(pb.rescan);
+
+    /* the final header cannot be written, the bundle is discarded */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_files = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_BUNDLE_WRITE_ERR_EID);
+    UtAssert_BOOL_FALSE(pb.bundle.ready);
+    UtAssert_ZERO(pb.bundle.num_files);
+}
+
+void Test_CF_Bundle_EndScan(void)
+{
+    /* Test case for:
+     * void CF_Bundle_EndScan(CF_Playback_t *pb);
+     */
+    CF_Playback_t pb;
+
+    UT_CF_File_Make("/ut/poll/a", "one");
+
+    /* no bundle, nothing to do */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UtAssert_VOIDCALL(CF_Bundle_EndScan(&pb));
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_BOOL_FALSE(pb.rescan);
+
+    /* the oldest file is not old enough, wait for more */
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 950), CFE_SUCCESS);
+    UtAssert_VOIDCALL(CF_Bundle_EndScan(&pb));
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_BOOL_TRUE(pb.rescan);
+    UtAssert_BOOL_FALSE(pb.bundle.ready);
+    UtAssert_ZERO(pb.bundle.num_files);
+
+    /* old enough, the partial bundle is sent */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 940), CFE_SUCCESS);
+    UtAssert_VOIDCALL(CF_Bundle_EndScan(&pb));
+    UtAssert_BOOL_TRUE(pb.bundle.ready);
+    UtAssert_BOOL_FALSE(pb.rescan);
+}
+
+void Test_CF_Bundle_GetPath(void)
+{
+    /* Test case for:
+     * void CF_Bundle_GetPath(const CF_Playback_t *pb, const char *dir, char *buf, size_t buf_size);
+     */
+    CF_Playback_t pb;
+    char          path[CF_FILENAME_MAX_LEN];
+
+    UT_CF_Bundle_SetupPlayback(&pb);
+    pb.bundle.seq = 12;
+    UtAssert_VOIDCALL(CF_Bundle_GetPath(&pb, "/gnd", path, sizeof(path)));
+    UtAssert_STRINGBUF_EQ(path, sizeof(path), "/gnd/cf_c0p1_12.cfb", -1);
+    UtAssert_BOOL_TRUE(CF_Bundle_IsBundle(path));
+}
+
+void Test_CF_Bundle_Discard(void)
+{
+    /* Test case for:
+     * void CF_Bundle_Discard(CF_Playback_t *pb);
+     */
+    CF_Playback_t pb;
+
+    /* ready bundle */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Build(&pb);
+    UtAssert_VOIDCALL(CF_Bundle_Discard(&pb));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_BOOL_FALSE(pb.bundle.ready);
+    UtAssert_ZERO(pb.bundle.num_files);
+    UtAssert_BOOL_TRUE(pb.rescan);
+
+    /* bundle still open */
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Config.chan[UT_CFDP_CHANNEL].polldir[1].bundle_max_files = 0;
+    UtAssert_INT32_EQ(CF_Bundle_Add(&pb, "/ut/poll/a", "a", 3, 800), CFE_SUCCESS);
+    UtAssert_VOIDCALL(CF_Bundle_Discard(&pb));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 5);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(pb.bundle.fd));
+}
+
+void Test_CF_Bundle_Started(void)
+{
+    /* Test case for:
+     * void CF_Bundle_Started(CF_Playback_t *pb);
+     */
+    CF_Playback_t pb;
+
+    UT_CF_Bundle_SetupPlayback(&pb);
+    UT_CF_Bundle_Build(&pb);
+    UtAssert_VOIDCALL(CF_Bundle_Started(&pb));
+    UtAssert_BOOL_FALSE(pb.bundle.ready);
+    UtAssert_ZERO(pb.bundle.num_files);
+    UtAssert_ZERO(pb.bundle.bytes);
+    UtAssert_UINT16_EQ(pb.bundle.seq, 1);
+}
+
+void Test_CF_Bundle_Retain(void)
+{
+    /* Test case for:
+     * void CF_Bundle_Retain(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     txn_history;
+    CF_History_t     history;
+    CF_Playback_t    pb;
+    UT_CF_File_t    *bundle;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    memset(&txn, 0, sizeof(txn));
+    memset(&txn_history, 0, sizeof(txn_history));
+    memset(&history, 0, sizeof(history));
+    UT_CF_Bundle_SetupPlayback(&pb);
+    bundle               = UT_CF_Bundle_Build(&pb);
+    txn.pb               = &pb;
+    txn.history          = &txn_history;
+    txn.chan_num         = UT_CFDP_CHANNEL;
+    txn_history.dir      = CF_Direction_TX;
+    txn_history.seq_num  = 42;
+    txn_history.txn_stat = CF_TxnStatus_NO_ERROR;
+    strcpy(txn_history.fnames.src_filename, "/ut/tmp/cf_c0p1_0.cfb");
+
+    /* one free history, taken by each file in turn as the list calls are stubs */
+    chan->qs[CF_QueueIdx_HIST_FREE]                                                  = &history.cl_node;
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_HIST_FREE] = 2;
+
+    /* nominal, every file gets the retention policy and a history entry */
+    UtAssert_VOIDCALL(CF_Bundle_Retain(&txn));
+    UtAssert_STUB_COUNT(CF_CFDP_S_RetainFile, 2);
+    UtAssert_STUB_COUNT(CF_CList_InsertBack, 2);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STRINGBUF_EQ(history.fnames.src_filename, sizeof(history.fnames.src_filename), "/ut/poll/bb", -1);
+    UtAssert_STRINGBUF_EQ(history.fnames.dst_filename, sizeof(history.fnames.dst_filename), "/gnd/poll/bb", -1);
+    UtAssert_UINT32_EQ(history.seq_num, 42);
+    UtAssert_UINT8_EQ(history.dir, CF_Direction_TX);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* no history available */
+    chan->qs[CF_QueueIdx_HIST_FREE] = NULL;
+    UtAssert_VOIDCALL(CF_Bundle_Retain(&txn));
+    UtAssert_STUB_COUNT(CF_CFDP_S_RetainFile, 4);
+    UtAssert_STUB_COUNT(CF_CList_InsertBack, 2);
+
+    /* truncated in the second entry, the files not reached are left alone */
+    bundle->len = sizeof(CF_BundleHeader_t) + sizeof(CF_BundleEntry_t) + 3 + 4;
+    UtAssert_VOIDCALL(CF_Bundle_Retain(&txn));
+    UtAssert_STUB_COUNT(CF_CFDP_S_RetainFile, 5);
+    UT_CF_AssertEventID(CF_BUNDLE_READ_ERR_EID);
+
+    /* not a bundle */
+    bundle->data[0] = 0;
+    UtAssert_VOIDCALL(CF_Bundle_Retain(&txn));
+    UtAssert_STUB_COUNT(CF_CFDP_S_RetainFile, 5);
+    UtAssert_STUB_COUNT(OS_remove, 4);
+
+    /* the bundle cannot be opened */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_Bundle_Retain(&txn));
+    UtAssert_STUB_COUNT(OS_remove, 4);
+}
+
+void Test_CF_Bundle_IsBundle(void)
+{
+    /* Test case for:
+     * bool CF_Bundle_IsBundle(const char *filename);
+     */
+    UtAssert_BOOL_TRUE(CF_Bundle_IsBundle("/gnd/x.cfb"));
+    UtAssert_BOOL_FALSE(CF_Bundle_IsBundle("/gnd/x.cfb.dat"));
+    UtAssert_BOOL_FALSE(CF_Bundle_IsBundle(".cfb"));
+    UtAssert_BOOL_FALSE(CF_Bundle_IsBundle(""));
+}
+
+void Test_CF_Bundle_Unpack(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Bundle_Unpack(CF_Transaction_t *txn, const char *bundle_file, const char *dst_filename);
+     */
+    CF_Transaction_t  txn;
+    CF_History_t      txn_history;
+    CF_Playback_t     pb;
+    UT_CF_File_t     *bundle;
+    UT_CF_File_t     *part;
+    CF_BundleEntry_t *entry;
+
+    memset(&txn, 0, sizeof(txn));
+    memset(&txn_history, 0, sizeof(txn_history));
+    UT_CF_Bundle_SetupPlayback(&pb);
+    bundle       = UT_CF_Bundle_Build(&pb);
+    txn.history  = &txn_history;
+    txn.chan_num = UT_CFDP_CHANNEL;
+
+    /* nominal, every file is written under a temporary name then moved */
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CFE_SUCCESS);
+    part = UT_CF_File_Find("/gnd/poll/bb.part");
+    UtAssert_NOT_NULL(part);
+    UtAssert_UINT32_EQ(part->len, 5);
+    UtAssert_MemCmp(part->data, "three", 5, "contents of bb");
+    UtAssert_NOT_NULL(UT_CF_File_Find("/gnd/poll/a.part"));
+    UtAssert_STUB_COUNT(OS_mv, 2);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* no directory in the destination name */
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "x.cfb"), CFE_SUCCESS);
+    UtAssert_NOT_NULL(UT_CF_File_Find("./a.part"));
+
+    /* a file cannot be moved, the others still are */
+    UT_ResetState(UT_KEY(OS_mv));
+    UT_SetDeferredRetcode(UT_KEY(OS_mv), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_mv, 2);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UT_CF_AssertEventID(CF_BUNDLE_UNPACK_ERR_EID);
+
+    /* a file cannot be written, none is stored */
+    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(OS_remove));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, -1);
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+
+    /* a file cannot be created, the one written before is removed */
+    UT_ResetState(UT_KEY(OS_remove));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 3, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+
+    /* a name that would leave the directory */
+    entry = (CF_BundleEntry_t *)&bundle->data[sizeof(CF_BundleHeader_t)];
+    strcpy(entry->name, "../a");
+    UT_ResetState(UT_KEY(OS_remove));
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+    UT_CF_AssertEventID(CF_BUNDLE_READ_ERR_EID);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+
+    /* not a bundle */
+    bundle->data[4] = CF_BUNDLE_VERSION + 1;
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+
+    /* the bundle cannot be opened */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Bundle_Unpack(&txn, bundle->name, "/gnd/poll/cf_c0p1_0.cfb"), CF_ERROR);
+}
+
+/*******************************************************************************
+**
+**  cf_bundle_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Bundle_FileMax, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_FileMax");
+    UtTest_Add(Test_CF_Bundle_Add, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_Add");
+    UtTest_Add(Test_CF_Bundle_EndScan, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_EndScan");
+    UtTest_Add(Test_CF_Bundle_GetPath, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_GetPath");
+    UtTest_Add(Test_CF_Bundle_Discard, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_Discard");
+    UtTest_Add(Test_CF_Bundle_Started, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_Started");
+    UtTest_Add(Test_CF_Bundle_Retain, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_Retain");
+    UtTest_Add(Test_CF_Bundle_IsBundle, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_IsBundle");
+    UtTest_Add(Test_CF_Bundle_Unpack, cf_bundle_tests_Setup, cf_bundle_tests_Teardown, "CF_Bundle_Unpack");
+}
@@ -0,0 +1,274 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+#include "cf_test_utils.h"
+#include "cf_capture.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+static CF_ConfigTable_t UT_CF_Capture_Config;
+
+/* the last block written, and where */
+static uint8  UT_CF_Capture_Block[CF_CAPTURE_BLOCK_SIZE];
+static size_t UT_CF_Capture_BlockSize;
+static off_t  UT_CF_Capture_Offset;
+
+static void UT_CF_Capture_WrappedLseek(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    off_t        offset = UT_Hook_GetArgValueByName(Context, "offset", off_t);
+    CFE_Status_t ret    = offset;
+
+    UT_CF_Capture_Offset = offset;
+
+    UT_Stub_SetReturnValue(FuncKey, ret);
+}
+
+static void UT_CF_Capture_WrappedWrite(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const void  *buf        = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t       write_size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    CFE_Status_t ret        = write_size;
+
+    UtAssert_True(write_size <= sizeof(UT_CF_Capture_Block), "Write fits a block");
+    memcpy(UT_CF_Capture_Block, buf, write_size);
+    UT_CF_Capture_BlockSize = write_size;
+
+    UT_Stub_SetReturnValue(FuncKey, ret);
+}
+
+static uint32 UT_CF_Capture_Load(const uint8 *octets, size_t size)
+{
+    uint32 val = 0;
+    size_t i;
+
+    for (i = 0; i < size; ++i)
+    {
+        val = (val << 8) | octets[i];
+    }
+
+    return val;
+}
+
+/*******************************************************************************
+**
+**  cf_capture_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_capture_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Capture_Config, 0, sizeof(UT_CF_Capture_Config));
+    memset(UT_CF_Capture_Block, 0, sizeof(UT_CF_Capture_Block));
+    UT_CF_Capture_BlockSize = 0;
+    UT_CF_Capture_Offset    = -1;
+
+    strcpy(UT_CF_Capture_Config.capture_file, "/cf/pass.cap");
+    UT_CF_Capture_Config.capture_max_kb   = 64;
+    UT_CF_Capture_Config.ticks_per_second = 10;
+    UT_CF_Capture_Config.local_eid        = 25;
+    CF_AppData.config_table               = &UT_CF_Capture_Config;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedLseek), UT_CF_Capture_WrappedLseek, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Capture_WrappedWrite, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedOpenCreate), 1);
+}
+
+void cf_capture_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_capture_tests
+**
+*******************************************************************************/
+
+void Test_CF_Capture_Init(void)
+{
+    /* Act */
+    UtAssert_VOIDCALL(CF_Capture_Init());
+
+    /* Assert */
+    UtAssert_BOOL_TRUE(CF_AppData.capture.enabled);
+    UtAssert_UINT32_EQ(CF_AppData.capture.num_blocks, 2);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* no limit, and less than a block */
+    UT_CF_Capture_Config.capture_max_kb = 0;
+    UtAssert_VOIDCALL(CF_Capture_Init());
+    UtAssert_UINT32_EQ(CF_AppData.capture.num_blocks, CF_CAPTURE_MAX_BLOCKS);
+    UT_CF_Capture_Config.capture_max_kb = 8;
+    UtAssert_VOIDCALL(CF_Capture_Init());
+    UtAssert_UINT32_EQ(CF_AppData.capture.num_blocks, 1);
+
+    /* the file cannot be created */
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedOpenCreate), -1);
+    UtAssert_VOIDCALL(CF_Capture_Init());
+    UtAssert_BOOL_FALSE(CF_AppData.capture.enabled);
+    UT_CF_AssertEventID(CF_INIT_CAPTURE_ERR_EID);
+
+    /* not captured without a name */
+    UT_CF_Capture_Config.capture_file[0] = 0;
+    UtAssert_VOIDCALL(CF_Capture_Init());
+    UtAssert_BOOL_FALSE(CF_AppData.capture.enabled);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 4);
+}
+
+void Test_CF_Capture_Pdu(void)
+{
+    /* Arrange */
+    const CF_CaptureBlockHeader_t *hdr = (const CF_CaptureBlockHeader_t *)UT_CF_Capture_Block;
+    const CF_CaptureRecord_t      *rec = (const CF_CaptureRecord_t *)(hdr + 1);
+    uint8                          pdu[CF_MAX_PDU_SIZE + 8];
+    uint32                         i;
+
+    memset(pdu, 0xA5, sizeof(pdu));
+    CF_Capture_Init();
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Capture_Pdu(1, CF_CAPTURE_DIR_TX, pdu, 20));
+
+    /* Assert - kept until the block is written */
+    UtAssert_BOOL_TRUE(CF_AppData.capture.dirty);
+    UtAssert_UINT32_EQ(CF_AppData.capture.used, sizeof(CF_CaptureRecord_t) + 20);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+
+    CF_Capture_Flush();
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.capture.dirty);
+    UtAssert_ZERO(UT_CF_Capture_Offset);
+    UtAssert_UINT32_EQ(UT_CF_Capture_BlockSize, sizeof(*hdr) + sizeof(*rec) + 20);
+    UtAssert_UINT32_EQ(UT_CF_Capture_Load(hdr->magic.octets, sizeof(hdr->magic)), CF_CAPTURE_MAGIC);
+    UtAssert_UINT32_EQ(UT_CF_Capture_Load(hdr->used.octets, sizeof(hdr->used)), sizeof(*rec) + 20);
+    UtAssert_UINT32_EQ(UT_CF_Capture_Load(hdr->ticks_per_second.octets, sizeof(hdr->ticks_per_second)), 10);
+    UtAssert_UINT32_EQ(hdr->local_eid.octets[7], 25);
+    UtAssert_UINT32_EQ(UT_CF_Capture_Load(rec->len.octets, sizeof(rec->len)), 20);
+    UtAssert_UINT32_EQ(rec->chan.octets[0], 1);
+    UtAssert_UINT32_EQ(rec->dir.octets[0], CF_CAPTURE_DIR_TX);
+    UtAssert_MemCmp(rec + 1, pdu, 20, "PDU");
+
+    /* PDUs longer than the largest PDU are cut */
+    UtAssert_VOIDCALL(CF_Capture_Pdu(0, CF_CAPTURE_DIR_RX, pdu, sizeof(pdu)));
+    UtAssert_UINT32_EQ(CF_AppData.capture.used, (2 * sizeof(CF_CaptureRecord_t)) + 20 + CF_MAX_PDU_SIZE);
+
+    /* a full block is written, and the next one goes to the next place of the ring, then back to the start */
+    for (i = 0; CF_AppData.capture.seq < 2; ++i)
+    {
+        CF_Capture_Pdu(0, CF_CAPTURE_DIR_RX, pdu, CF_MAX_PDU_SIZE);
+        if (CF_AppData.capture.seq == 1 && UT_CF_Capture_Offset == 0)
+        {
+            UtAssert_UINT32_EQ(UT_CF_Capture_Load(hdr->seq.octets, sizeof(hdr->seq)), 0);
+            UtAssert_True(UT_CF_Capture_BlockSize <= CF_CAPTURE_BLOCK_SIZE, "Block fits");
+            CF_Capture_Tick();
+            CF_Capture_Flush();
+            UtAssert_UINT32_EQ(UT_CF_Capture_Offset, CF_CAPTURE_BLOCK_SIZE);
+        }
+    }
+    CF_Capture_Flush();
+    UtAssert_ZERO(UT_CF_Capture_Offset);
+    UtAssert_UINT32_EQ(UT_CF_Capture_Load(hdr->seq.octets, sizeof(hdr->seq)), 2);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+}
+
+void Test_CF_Capture_Pdu_WriteError(void)
+{
+    /* Arrange */
+    uint8 pdu[CF_MAX_PDU_SIZE];
+
+    memset(pdu, 0, sizeof(pdu));
+    CF_Capture_Init();
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), NULL, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), -1);
+
+    /* Act - until the block is full */
+    while (CF_AppData.capture.enabled)
+    {
+        CF_Capture_Pdu(0, CF_CAPTURE_DIR_RX, pdu, sizeof(pdu));
+    }
+
+    /* Assert */
+    UT_CF_AssertEventID(CF_CAPTURE_WRITE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_ZERO(CF_AppData.capture.used);
+
+    /* nothing more is written */
+    UtAssert_VOIDCALL(CF_Capture_Tick());
+    UtAssert_VOIDCALL(CF_Capture_Flush());
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+}
+
+void Test_CF_Capture_Tick(void)
+{
+    /* Arrange */
+    uint8  pdu[4] = { 1, 2, 3, 4 };
+    uint32 i;
+
+    CF_Capture_Init();
+
+    /* Act - nothing to write */
+    for (i = 0; i < 10; ++i)
+    {
+        CF_Capture_Tick();
+    }
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_UINT32_EQ(CF_AppData.capture.tick, 10);
+
+    /* written a second after the last write */
+    CF_Capture_Pdu(0, CF_CAPTURE_DIR_RX, pdu, sizeof(pdu));
+    CF_Capture_Tick();
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    CF_Capture_Pdu(0, CF_CAPTURE_DIR_RX, pdu, sizeof(pdu));
+    for (i = 0; i < 9; ++i)
+    {
+        CF_Capture_Tick();
+    }
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    CF_Capture_Tick();
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_UINT32_EQ(UT_CF_Capture_BlockSize,
+                       sizeof(CF_CaptureBlockHeader_t) + (2 * (sizeof(CF_CaptureRecord_t) + sizeof(pdu))));
+
+    /* nothing counted while not capturing */
+    CF_AppData.capture.enabled = false;
+    UtAssert_VOIDCALL(CF_Capture_Tick());
+    UtAssert_UINT32_EQ(CF_AppData.capture.tick, 21);
+}
+
+/*******************************************************************************
+**
+**  cf_capture_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Capture_Init, cf_capture_tests_Setup, cf_capture_tests_Teardown, "CF_Capture_Init");
+    UtTest_Add(Test_CF_Capture_Pdu, cf_capture_tests_Setup, cf_capture_tests_Teardown, "CF_Capture_Pdu");
+    UtTest_Add(Test_CF_Capture_Pdu_WriteError,
+               cf_capture_tests_Setup,
+               cf_capture_tests_Teardown,
+               "CF_Capture_Pdu_WriteError");
+    UtTest_Add(Test_CF_Capture_Tick, cf_capture_tests_Setup, cf_capture_tests_Teardown, "CF_Capture_Tick");
+}
@@ -26,6 +26,10 @@
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
+#include "cf_bundle.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_rtt.h"
 
 static void UT_CFDP_R_SetupBasicRxState(CF_Logical_PduBuffer_t *pdu_buffer)
 {
@@ -122,6 +126,20 @@ static void UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_t            setup,
     UT_SetHandlerFunction(UT_KEY(CF_CFDP_SetTxnStatus), UT_AltHandler_CaptureTransactionStatus, &ut_history.txn_stat);
 }
 
+static void UT_CFDP_R_CaptureGapTotal(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_ChunkSize_t *total = UserObj;
+
+    *total = UT_Hook_GetArgValueByName(Context, "total", CF_ChunkSize_t);
+}
+
+static void UT_CFDP_R_CaptureKeepAliveProgress(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_FileSize_t *progress = UserObj;
+
+    *progress = UT_Hook_GetArgValueByName(Context, "progress", CF_FileSize_t);
+}
+
 /*******************************************************************************
 **
 **  cf_cfdp_r_tests Setup and Teardown
@@ -216,6 +234,79 @@ void Test_CF_CFDP_R_AckTimerTick(void)
     UtAssert_BOOL_FALSE(txn->flags.com.ack_timer_armed);
 }
 
+void Test_CF_CFDP_R_NakTimerTick(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R_NakTimerTick(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+
+    /* no-op if not in R2 */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode            = false;
+    txn->flags.rx.nak_timer_armed = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+
+    /* no-op if not armed */
+    txn->reliable_mode            = true;
+    txn->flags.rx.nak_timer_armed = false;
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+
+    /* EOF already received, timer is dropped without ticking */
+    txn->flags.rx.nak_timer_armed = true;
+    txn->state_data.sub_state     = CF_RxSubState_DATA_EOF;
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+
+    /* armed but not expired */
+    txn->flags.rx.nak_timer_armed = true;
+    txn->state_data.sub_state     = CF_RxSubState_DATA_NORMAL;
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_BOOL_TRUE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+
+    /* expired in immediate mode, gap still open, so NAK and disarm */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_IMMEDIATE;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    txn->reliable_mode                     = true;
+    txn->flags.rx.nak_timer_armed          = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+
+    /* expired in immediate mode, gap filled in by reordered data, so no NAK */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_IMMEDIATE;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    txn->reliable_mode                     = true;
+    txn->flags.rx.nak_timer_armed          = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+
+    /* expired in async mode, timer re-armed for another period */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_ASYNC;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    txn->reliable_mode                     = true;
+    txn->flags.rx.nak_timer_armed          = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 2);
+    UtAssert_VOIDCALL(CF_CFDP_R_NakTimerTick(txn));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_TRUE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Rtt_GetTimeout, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelTicks, 1);
+}
+
 void Test_CF_CFDP_R_Tick(void)
 {
     /* Test case for:
@@ -291,6 +382,8 @@ void Test_CF_CFDP_R_Tick_Maintenance(void)
      * void CF_CFDP_R_Tick_Maintenance(CF_Transaction_t *txn);
      */
     CF_Transaction_t *txn;
+    CF_Chunk_t        chunk;
+    CF_FileSize_t     progress;
 
     /* in R1 state, nominal (does nothing, called for coverage) */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -346,6 +439,48 @@ void Test_CF_CFDP_R_Tick_Maintenance(void)
     UtAssert_VOIDCALL(CF_CFDP_R_Tick_Maintenance(txn));
     UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
 
+    /* in R2 state, send_nak set, held while the existing file is copied for a delta transfer */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode     = true;
+    txn->flags.rx.send_nak = true;
+    txn->flags.rx.prefill  = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick_Maintenance(txn));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 0);
+
+    /* in R2 state, send_keep_alive set, nothing received from the start of the file yet */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    progress = 1;
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_SendKeepAlive), UT_CFDP_R_CaptureKeepAliveProgress, &progress);
+    memset(&chunk, 0, sizeof(chunk));
+    chunk.offset = 100;
+    chunk.size   = 200;
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_GetFirstChunk), UT_AltHandler_GenericPointerReturn, &chunk);
+    txn->reliable_mode            = true;
+    txn->flags.rx.send_keep_alive = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick_Maintenance(txn));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 1);
+    UtAssert_ZERO(progress);
+
+    /* in R2 state, send_keep_alive set, reports the contiguous run from offset 0 */
+    chunk.offset                  = 0;
+    txn->flags.rx.send_keep_alive = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick_Maintenance(txn));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+    UtAssert_UINT32_EQ(progress, 200);
+
+    /* same as above, but CF_CFDP_SendKeepAlive fails */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendKeepAlive), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->reliable_mode            = true;
+    txn->flags.rx.send_keep_alive = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick_Maintenance(txn));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_keep_alive);
+
     /* in R2 state, send_fin set */
     UT_ResetState(0);
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -455,6 +590,7 @@ void Test_CF_CFDP_R_ProcessFd(void)
     UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
     UtAssert_UINT32_EQ(txn->state_data.cached_pos, 100);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes, 100);
+    UtAssert_UINT32_EQ(txn->history->metrics.fd_bytes, 100);
     UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
     UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
 
@@ -495,11 +631,94 @@ void Test_CF_CFDP_R_ProcessFd(void)
     UT_CF_AssertEventID(CF_CFDP_R_SEEK_FD_ERR_EID);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILE_SIZE_ERROR);
 
+    /* class 2 tracks the receive progress */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->reliable_mode         = true;
+    fd                         = &ph->int_header.fd;
+    fd->data_len               = 100;
+    fd->offset                 = 300;
+    txn->state_data.cached_pos = 300;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), fd->data_len);
+    UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 400);
+
     /* these stats should have been updated during the course of this test */
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.file_write, 1);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.file_seek, 1);
 }
 
+void Test_CF_CFDP_R2_UpdateNakTimer(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R2_UpdateNakTimer(CF_Transaction_t *txn, const CF_Logical_PduFileDataHeader_t *fd);
+     */
+    CF_Transaction_t               *txn;
+    CF_Logical_PduBuffer_t         *ph;
+    CF_Logical_PduFileDataHeader_t *fd;
+    CF_ConfigTable_t               *config;
+
+    /* deferred mode only tracks progress */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_DEFERRED;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    fd                                     = &ph->int_header.fd;
+    fd->offset                             = 200;
+    fd->data_len                           = 100;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 300);
+
+    /* immediate mode, in-order data does not open a gap */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_IMMEDIATE;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    txn->state_data.rx_progress            = 200;
+    fd                                     = &ph->int_header.fd;
+    fd->offset                             = 200;
+    fd->data_len                           = 100;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 300);
+
+    /* immediate mode, data skipping ahead arms the reorder timer */
+    fd->offset = 400;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_TRUE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelTicks, 1);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 500);
+
+    /* another gap while the timer is running does not restart it */
+    fd->offset = 600;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_STUB_COUNT(CF_Timer_InitRelTicks, 1);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 700);
+
+    /* retransmitted data behind the progress point does not move it back */
+    txn->flags.rx.nak_timer_armed = false;
+    fd->offset                    = 300;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+    UtAssert_UINT32_EQ(txn->state_data.rx_progress, 700);
+
+    /* past EOF nothing is armed */
+    txn->state_data.sub_state = CF_RxSubState_DATA_EOF;
+    fd->offset                = 800;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_FALSE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelTicks, 1);
+
+    /* async mode arms on the first data received */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].nak_mode = CF_NakMode_ASYNC;
+    txn->chan_num                          = UT_CFDP_CHANNEL;
+    fd                                     = &ph->int_header.fd;
+    fd->data_len                           = 100;
+    UtAssert_VOIDCALL(CF_CFDP_R2_UpdateNakTimer(txn, fd));
+    UtAssert_BOOL_TRUE(txn->flags.rx.nak_timer_armed);
+    UtAssert_STUB_COUNT(CF_Rtt_GetTimeout, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelTicks, 1);
+}
+
 void Test_CF_CFDP_R_SubstateRecvEof(void)
 {
     /* Test case for:
@@ -558,6 +777,7 @@ void Test_CF_CFDP_R_SubstateRecvFileData(void)
     UtAssert_VOIDCALL(CF_CFDP_R_SubstateRecvFileData(txn, ph));
     UtAssert_ZERO(txn->state_data.acknak_count); /* this resets the counter */
     UtAssert_STUB_COUNT(CF_ChunkListAdd, 1);     /* called */
+    UtAssert_STUB_COUNT(CF_Rtt_Stop, 1);
 
     /* failure in CF_CFDP_RecvFd (bad packet) */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -566,6 +786,7 @@ void Test_CF_CFDP_R_SubstateRecvFileData(void)
     UtAssert_VOIDCALL(CF_CFDP_R_SubstateRecvFileData(txn, ph));
     UtAssert_STUB_COUNT(CF_ChunkListAdd, 1);            /* NOT called */
     UtAssert_UINT8_EQ(txn->state_data.acknak_count, 1); /* NOT reset */
+    UtAssert_STUB_COUNT(CF_Rtt_Stop, 1);
 
     /* failure in CF_CFDP_R_ProcessFd (via failure of CF_WrappedWrite) */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -618,6 +839,7 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     CF_Transaction_t       *txn;
     CF_Logical_PduBuffer_t *ph;
     CF_ChunkWrapper_t       chunks;
+    CF_ChunkSize_t          total;
 
     memset(&chunks, 0, sizeof(chunks));
 
@@ -653,6 +875,32 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     chunks.chunks.max_chunks = 2;
     UtAssert_INT32_EQ(CF_CFDP_R_SendNak(txn), 0);
     UtAssert_STUB_COUNT(CF_CFDP_SendNak, 2);
+    UtAssert_STUB_COUNT(CF_Rtt_Start, 0);
+
+    /* after EOF, the round trip time to the retransmitted data is measured */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    txn->flags.rx.md_recv     = true;
+    txn->chunks               = &chunks;
+    txn->state_data.sub_state = CF_RxSubState_DATA_EOF;
+    UtAssert_INT32_EQ(CF_CFDP_R_SendNak(txn), 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 3);
+    UtAssert_STUB_COUNT(CF_Rtt_Start, 1);
+
+    /* before EOF, gaps are only computed up to the receive progress */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_ComputeGaps), UT_CFDP_R_CaptureGapTotal, &total);
+    txn->flags.rx.md_recv       = true;
+    txn->chunks                 = &chunks;
+    txn->fsize                  = 1000;
+    txn->state_data.rx_progress = 400;
+    UtAssert_INT32_EQ(CF_CFDP_R_SendNak(txn), 0);
+    UtAssert_UINT32_EQ(total, 400);
+
+    /* after EOF, the whole file is checked */
+    txn->state_data.sub_state = CF_RxSubState_DATA_EOF;
+    UtAssert_INT32_EQ(CF_CFDP_R_SendNak(txn), 0);
+    UtAssert_UINT32_EQ(total, 1000);
 }
 
 void Test_CF_CFDP_R_CalcCrcChunk(void)
@@ -735,6 +983,37 @@ void Test_CF_CFDP_R2_Recv_fin_ack(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 2);
 }
 
+void Test_CF_CFDP_R2_SubstateRecvPrompt(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R2_SubstateRecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* nominal, keep alive requested */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    ph->int_header.prompt.response_required = CF_CFDP_PromptResponse_KEEP_ALIVE;
+    UtAssert_VOIDCALL(CF_CFDP_R2_SubstateRecvPrompt(txn, ph));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_keep_alive);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+
+    /* nominal, NAK requested */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    ph->int_header.prompt.response_required = CF_CFDP_PromptResponse_NAK;
+    UtAssert_VOIDCALL(CF_CFDP_R2_SubstateRecvPrompt(txn, ph));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+
+    /* failure in CF_CFDP_RecvPrompt */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_RecvPrompt), 1, CF_SHORT_PDU_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R2_SubstateRecvPrompt(txn, ph));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
+}
+
 void Test_CF_CFDP_R_CheckComplete(void)
 {
     /*
@@ -845,6 +1124,15 @@ void Test_CF_CFDP_R_SubstateRecvMd(void)
     txn->flags.rx.md_recv = true;
     UtAssert_VOIDCALL(CF_CFDP_R_SubstateRecvMd(txn, ph));
     UtAssert_BOOL_TRUE(txn->flags.rx.md_recv);
+    UtAssert_STUB_COUNT(CF_Delta_PrefillStart, 0);
+
+    /* delta transfer, the existing file is copied first */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->reliable_mode = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_GetMd), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_R_SubstateRecvMd(txn, ph));
+    UtAssert_BOOL_TRUE(txn->flags.rx.md_recv);
+    UtAssert_STUB_COUNT(CF_Delta_PrefillStart, 1);
 
     /* Failure in CF_CFDP_RecvMd */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -924,6 +1212,60 @@ void Test_CF_CFDP_R_HandleFileRetention(void)
     UtAssert_UINT8_EQ(txn->state_data.fin_dc, CF_CFDP_FinDeliveryCode_COMPLETE);
     UT_CF_AssertEventID(CF_CFDP_R_NOT_RETAINED_EID);
 
+    /* Complete bundle, unpacked and then removed */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.rx.tempfile_created = true;
+    txn->flags.com.is_complete     = true;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Bundle_IsBundle), true);
+    UtAssert_VOIDCALL(CF_CFDP_R_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Bundle_Unpack, 1);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_UINT8_EQ(txn->state_data.fin_fs, CF_CFDP_FinFileStatus_RETAINED);
+    UT_CF_AssertEventID(CF_CFDP_R_FILE_RETAINED_EID);
+
+    /* Complete bundle, unpack fails so the bundle is discarded */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.rx.tempfile_created = true;
+    txn->flags.com.is_complete     = true;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Bundle_IsBundle), true);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Bundle_Unpack), CF_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_UINT8_EQ(txn->state_data.fin_fs, CF_CFDP_FinFileStatus_DISCARDED_FILESTORE);
+
+    /* Complete compressed file, the decompressed copy is moved and the received file removed */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.rx.tempfile_created = true;
+    txn->flags.com.is_complete     = true;
+    txn->compress                  = CF_Compress_LZ4;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UtAssert_VOIDCALL(CF_CFDP_R_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Compress_GetTempName, 1);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(OS_mv, 1);
+    UtAssert_UINT8_EQ(txn->state_data.fin_fs, CF_CFDP_FinFileStatus_RETAINED);
+    UT_CF_AssertEventID(CF_CFDP_R_FILE_RETAINED_EID);
+
+    /* Complete compressed file, decompression failed so both copies are discarded */
+    UT_ResetState(0);
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.rx.tempfile_created = true;
+    txn->flags.com.is_complete     = true;
+    txn->compress                  = CF_Compress_LZ4;
+    txn->history->txn_stat         = CF_TxnStatus_FILESTORE_REJECTION;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), false);
+    UtAssert_VOIDCALL(CF_CFDP_R_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Compress_GetTempName, 1);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+    UtAssert_UINT8_EQ(txn->state_data.fin_fs, CF_CFDP_FinFileStatus_DISCARDED_FILESTORE);
+
     /* transaction already in error state, not related to file storage (complete file but errored) */
     UT_ResetState(0);
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
@@ -981,6 +1323,34 @@ void Test_CF_CFDP_R_CheckState_NORMAL(void)
     UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
     UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_DATA_EOF);
     UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+
+    /* DATA_NORMAL state, EOF is held until the existing file is copied for a delta transfer */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode        = true;
+    txn->flags.rx.eof_count   = 1;
+    txn->flags.rx.prefill     = true;
+    txn->state_data.sub_state = CF_RxSubState_DATA_NORMAL;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_DATA_NORMAL);
+    UtAssert_STUB_COUNT(CF_Delta_PrefillStep, 1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+
+    /* copy done */
+    txn->flags.rx.prefill = false;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_DATA_EOF);
+    UtAssert_STUB_COUNT(CF_Delta_PrefillStep, 1);
+
+    /* canceled while copying */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), false);
+    txn->reliable_mode        = true;
+    txn->flags.rx.prefill     = true;
+    txn->state_data.sub_state = CF_RxSubState_DATA_NORMAL;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Delta_PrefillStep, 1);
 }
 
 void Test_CF_CFDP_R_CheckState_EOF(void)
@@ -1098,6 +1468,62 @@ void Test_CF_CFDP_R_CheckState_VALIDATE(void)
     UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
     UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
 
+    /* VALIDATE state, delta transfer, checksum matches */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode         = true;
+    txn->fsize                 = 100;
+    txn->state_data.cached_pos = 100;
+    txn->state_data.sub_state  = CF_RxSubState_VALIDATE;
+    txn->state_data.eof_crc    = 0x1234;
+    txn->crc.result            = 0x1234;
+    txn->flags.rx.delta        = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Delta_Restart, 0);
+
+    /* VALIDATE state, delta transfer, checksum mismatch, the whole file is requested */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode         = true;
+    txn->fsize                 = 100;
+    txn->state_data.cached_pos = 100;
+    txn->state_data.sub_state  = CF_RxSubState_VALIDATE;
+    txn->state_data.eof_crc    = 0x1234;
+    txn->crc.result            = 0x4321;
+    txn->flags.rx.delta        = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_DATA_EOF);
+    UtAssert_STUB_COUNT(CF_Delta_Restart, 1);
+
+    /* VALIDATE state, compressed file, checksum matches so it is decompressed */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode         = true;
+    txn->fsize                 = 100;
+    txn->state_data.cached_pos = 100;
+    txn->state_data.sub_state  = CF_RxSubState_VALIDATE;
+    txn->state_data.eof_crc    = 0x1234;
+    txn->crc.result            = 0x1234;
+    txn->compress              = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_EXPAND);
+    UtAssert_STUB_COUNT(CF_Compress_ExpandStart, 1);
+
+    /* VALIDATE state, compressed file, checksum mismatch so it is not decompressed */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode         = true;
+    txn->fsize                 = 100;
+    txn->state_data.cached_pos = 100;
+    txn->state_data.sub_state  = CF_RxSubState_VALIDATE;
+    txn->state_data.eof_crc    = 0x1234;
+    txn->crc.result            = 0x4321;
+    txn->compress              = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Compress_ExpandStart, 1);
+
     /* VALIDATE state, nominal, error */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
     txn->reliable_mode         = true;
@@ -1109,6 +1535,40 @@ void Test_CF_CFDP_R_CheckState_VALIDATE(void)
     UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
 }
 
+void Test_CF_CFDP_R_CheckState_EXPAND(void)
+{
+    /*
+     * Test Case for:
+     * void CF_CFDP_R_CheckState(CF_Transaction_t *txn)
+     */
+    CF_Transaction_t *txn;
+
+    /* EXPAND state, more blocks to decompress */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->state_data.sub_state = CF_RxSubState_EXPAND;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_EXPAND);
+    UtAssert_STUB_COUNT(CF_Compress_ExpandStep, 1);
+
+    /* EXPAND state, done (or failed, that is sorted out when the file is retained) */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_ExpandStep), 1, true);
+    txn->state_data.sub_state = CF_RxSubState_EXPAND;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Compress_ExpandStep, 2);
+
+    /* EXPAND state, canceled */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), false);
+    txn->state_data.sub_state = CF_RxSubState_EXPAND;
+    UtAssert_VOIDCALL(CF_CFDP_R_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_RxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Compress_ExpandStep, 2);
+}
+
 void Test_CF_CFDP_R_CheckState_FILESTORE(void)
 {
     /*
@@ -1267,6 +1727,8 @@ void Test_CF_CFDP_R_CheckState(void)
     UT_ResetState(0);
     Test_CF_CFDP_R_CheckState_VALIDATE();
     UT_ResetState(0);
+    Test_CF_CFDP_R_CheckState_EXPAND();
+    UT_ResetState(0);
     Test_CF_CFDP_R_CheckState_FILESTORE();
     UT_ResetState(0);
     Test_CF_CFDP_R_CheckState_FINACK();
@@ -1288,6 +1750,10 @@ void UtTest_Setup(void)
                cf_cfdp_r_tests_Setup,
                cf_cfdp_r_tests_Teardown,
                "Test_CF_CFDP_R_AckTimerTick");
+    UtTest_Add(Test_CF_CFDP_R_NakTimerTick,
+               cf_cfdp_r_tests_Setup,
+               cf_cfdp_r_tests_Teardown,
+               "Test_CF_CFDP_R_NakTimerTick");
     UtTest_Add(Test_CF_CFDP_R_Tick, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Tick");
     UtTest_Add(Test_CF_CFDP_R_Tick_Maintenance,
                cf_cfdp_r_tests_Setup,
@@ -1296,6 +1762,10 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_R_Init, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Init");
     UtTest_Add(Test_CF_CFDP_R_CheckCrc, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_CheckCrc");
     UtTest_Add(Test_CF_CFDP_R_ProcessFd, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_ProcessFd");
+    UtTest_Add(Test_CF_CFDP_R2_UpdateNakTimer,
+               cf_cfdp_r_tests_Setup,
+               cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_UpdateNakTimer");
     UtTest_Add(Test_CF_CFDP_R_SubstateRecvEof,
                cf_cfdp_r_tests_Setup,
                cf_cfdp_r_tests_Teardown,
@@ -1307,6 +1777,10 @@ void UtTest_Setup(void)
                cf_cfdp_r_tests_Setup,
                cf_cfdp_r_tests_Teardown,
                "CF_CFDP_R2_SubstateRecvFinAck");
+    UtTest_Add(Test_CF_CFDP_R2_SubstateRecvPrompt,
+               cf_cfdp_r_tests_Setup,
+               cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_SubstateRecvPrompt");
     UtTest_Add(Test_CF_CFDP_R_CheckComplete,
                cf_cfdp_r_tests_Setup,
                cf_cfdp_r_tests_Teardown,
@@ -26,6 +26,10 @@
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
+#include "cf_bundle.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_rtt.h"
 
 static void UT_CFDP_S_SetupBasicRxState(CF_Logical_PduBuffer_t *pdu_buffer)
 {
@@ -301,6 +305,27 @@ void Test_CF_CFDP_S_Tick(void)
     UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
     UtAssert_STUB_COUNT(CF_CFDP_CompleteTick, 1);
 
+    /* active transaction still compressing its file, nothing is expected from the peer yet */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode        = true;
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_GetAckTxnStatus), 1, CF_CFDP_AckTxnStatus_ACTIVE);
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+    UtAssert_STUB_COUNT(CF_Compress_FileStep, 1);
+
+    /* active transaction waiting on a keep alive, inactivity timer runs */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode               = true;
+    txn->state_data.sub_state        = CF_TxSubState_DATA_NORMAL;
+    txn->flags.tx.keep_alive_pending = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_GetAckTxnStatus), 1, CF_CFDP_AckTxnStatus_ACTIVE);
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_CompleteTick, 1);
+
     /* inactive transaction */
     UT_ResetState(0);
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
@@ -310,6 +335,71 @@ void Test_CF_CFDP_S_Tick(void)
     UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
 }
 
+void Test_CF_CFDP_S2_CheckPrompt(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S2_CheckPrompt(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+
+    /* S1 never prompts */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].prompt_keep_alive_bytes = 100;
+    config->chan[txn->chan_num].prompt_nak_bytes        = 100;
+    txn->reliable_mode                                  = false;
+    txn->state_data.sub_state                           = CF_TxSubState_DATA_NORMAL;
+    txn->foffs                                          = 500;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_nak);
+    UtAssert_ZERO(txn->state_data.prompt_pos);
+
+    /* S2 after EOF does not prompt */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].prompt_keep_alive_bytes = 100;
+    txn->reliable_mode                                  = true;
+    txn->state_data.sub_state                           = CF_TxSubState_DATA_EOF;
+    txn->foffs                                          = 500;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+
+    /* S2, both prompts disabled */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
+    txn->reliable_mode        = true;
+    txn->state_data.sub_state = CF_TxSubState_DATA_NORMAL;
+    txn->foffs                = 500;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_nak);
+    UtAssert_UINT32_EQ(txn->state_data.prompt_pos, 500);
+
+    /* S2, keep alive interval crossed but not the NAK interval */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].prompt_keep_alive_bytes = 100;
+    config->chan[txn->chan_num].prompt_nak_bytes        = 1000;
+    txn->reliable_mode                                  = true;
+    txn->state_data.sub_state                           = CF_TxSubState_DATA_NORMAL;
+    txn->state_data.prompt_pos                          = 450;
+    txn->foffs                                          = 550;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt_ka);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_nak);
+    UtAssert_UINT32_EQ(txn->state_data.prompt_pos, 550);
+
+    /* same position again does not re-trigger */
+    txn->flags.tx.send_prompt_ka = false;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+
+    /* S2, NAK interval crossed */
+    txn->foffs = 1000;
+    UtAssert_VOIDCALL(CF_CFDP_S2_CheckPrompt(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt_ka);
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt_nak);
+    UtAssert_UINT32_EQ(txn->state_data.prompt_pos, 1000);
+}
+
 void Test_CF_CFDP_S_Tick_Maintenance(void)
 {
     /* Test case for:
@@ -346,6 +436,7 @@ void Test_CF_CFDP_S_Tick_Maintenance(void)
     UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
     UtAssert_BOOL_FALSE(txn->flags.tx.send_eof);
     UtAssert_STUB_COUNT(CF_CFDP_ArmAckTimer, 0);
+    UtAssert_STUB_COUNT(CF_Rtt_Start, 0);
 
     /* In S2 it does arm the ack timer */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -354,6 +445,7 @@ void Test_CF_CFDP_S_Tick_Maintenance(void)
     UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
     UtAssert_BOOL_FALSE(txn->flags.tx.send_eof);
     UtAssert_STUB_COUNT(CF_CFDP_ArmAckTimer, 1);
+    UtAssert_STUB_COUNT(CF_Rtt_Start, 1);
 
     /* If fin_count is pending but failed to send */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -375,6 +467,41 @@ void Test_CF_CFDP_S_Tick_Maintenance(void)
     txn->flags.tx.fin_ack_count = 0;
     UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
     UtAssert_ZERO(txn->flags.tx.fin_ack_count); /* remains pending */
+
+    /* If a keep alive prompt is pending but failed to send */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode           = true;
+    txn->flags.tx.send_prompt_ka = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendPrompt), 1, -1);
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt_ka); /* remains pending */
+    UtAssert_BOOL_FALSE(txn->flags.tx.keep_alive_pending);
+
+    /* second time it does send, clears the flag and starts waiting on the receiver */
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+    UtAssert_BOOL_TRUE(txn->flags.tx.keep_alive_pending);
+    UtAssert_STUB_COUNT(CF_CFDP_ArmInactTimer, 1);
+
+    /* another keep alive prompt while still waiting does not restart the timer */
+    txn->flags.tx.send_prompt_ka = true;
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_ka);
+    UtAssert_STUB_COUNT(CF_CFDP_ArmInactTimer, 1);
+
+    /* If a NAK prompt is pending but failed to send */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->reliable_mode            = true;
+    txn->flags.tx.send_prompt_nak = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendPrompt), 1, -1);
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt_nak); /* remains pending */
+
+    /* second time it does send, clears the flag */
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick_Maintenance(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt_nak);
+    UtAssert_BOOL_FALSE(txn->flags.tx.keep_alive_pending);
 }
 
 void Test_CF_CFDP_S_SendFileData(void)
@@ -594,6 +721,8 @@ void Test_CF_CFDP_S2_SubstateNak(void)
     txn->fsize                     = 300;
     UtAssert_VOIDCALL(CF_CFDP_S2_SubstateNak(txn, ph));
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests, 3);
+    UtAssert_UINT32_EQ(txn->history->metrics.nak_rounds, 1);
+    UtAssert_UINT32_EQ(txn->history->metrics.nak_segments, 2);
 
     /* bad segments */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -617,6 +746,81 @@ void Test_CF_CFDP_S2_SubstateNak(void)
     UT_CF_AssertEventID(CF_CFDP_S_PDU_NAK_ERR_EID);
 }
 
+/* Hook function to consume the front of the chunk on RemoveFromFirst, like the real list does */
+static void UT_AltHandler_CF_ChunkList_RemoveFromFirst(void                   *UserObj,
+                                                       UT_EntryKey_t           FuncKey,
+                                                       const UT_StubContext_t *Context)
+{
+    CF_Chunk_t    *chunk = UserObj;
+    CF_ChunkSize_t size  = UT_Hook_GetArgValueByName(Context, "size", CF_ChunkSize_t);
+
+    chunk->offset += size;
+    chunk->size -= size;
+}
+
+void Test_CF_CFDP_S2_SubstateKeepAlive(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S2_SubstateKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+    CF_Chunk_t              chunk;
+
+    /* bad decode */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_RecvKeepAlive), 1, CF_ERROR);
+    txn->flags.tx.keep_alive_pending = true;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateKeepAlive(txn, ph));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
+    UtAssert_BOOL_TRUE(txn->flags.tx.keep_alive_pending);
+
+    /* progress beyond the end of the file */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                         = 100;
+    ph->int_header.keep_alive.progress = 200;
+    txn->flags.tx.keep_alive_pending   = true;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateKeepAlive(txn, ph));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 2);
+    UtAssert_BOOL_TRUE(txn->flags.tx.keep_alive_pending);
+    UtAssert_ZERO(txn->state_data.peer_progress);
+
+    /* nominal, no progress since last time, nothing trimmed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                         = 300;
+    txn->state_data.peer_progress      = 100;
+    ph->int_header.keep_alive.progress = 100;
+    txn->flags.tx.keep_alive_pending   = true;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateKeepAlive(txn, ph));
+    UtAssert_BOOL_FALSE(txn->flags.tx.keep_alive_pending);
+    UtAssert_UINT32_EQ(txn->state_data.peer_progress, 100);
+    UtAssert_STUB_COUNT(CF_ChunkList_GetFirstChunk, 0);
+
+    /* nominal, progress made, no retransmits queued */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                         = 300;
+    ph->int_header.keep_alive.progress = 200;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateKeepAlive(txn, ph));
+    UtAssert_UINT32_EQ(txn->state_data.peer_progress, 200);
+    UtAssert_STUB_COUNT(CF_ChunkList_GetFirstChunk, 1);
+    UtAssert_STUB_COUNT(CF_ChunkList_RemoveFromFirst, 0);
+
+    /* nominal, progress made, queued retransmit straddles the progress point and gets trimmed */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    memset(&chunk, 0, sizeof(chunk));
+    chunk.offset = 50;
+    chunk.size   = 200;
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_GetFirstChunk), UT_AltHandler_GenericPointerReturn, &chunk);
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_RemoveFromFirst), UT_AltHandler_CF_ChunkList_RemoveFromFirst, &chunk);
+    txn->fsize                         = 300;
+    ph->int_header.keep_alive.progress = 200;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateKeepAlive(txn, ph));
+    UtAssert_STUB_COUNT(CF_ChunkList_RemoveFromFirst, 1);
+    UtAssert_UINT32_EQ(chunk.offset, 200);
+    UtAssert_UINT32_EQ(chunk.size, 50);
+}
+
 void Test_CF_CFDP_S2_SubstateEofAck(void)
 {
     /* Test case for:
@@ -632,6 +836,7 @@ void Test_CF_CFDP_S2_SubstateEofAck(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_SubstateEofAck(txn, ph));
     UtAssert_BOOL_TRUE(txn->flags.tx.eof_ack_recv);
     UtAssert_BOOL_FALSE(txn->flags.com.ack_timer_armed);
+    UtAssert_STUB_COUNT(CF_Rtt_Stop, 1);
 
     /* failure of CF_CFDP_RecvAck */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -648,6 +853,7 @@ void Test_CF_CFDP_S2_SubstateEofAck(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_SubstateEofAck(txn, ph));
     UT_CF_AssertEventID(CF_CFDP_S_PDU_EOF_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 2);
+    UtAssert_STUB_COUNT(CF_Rtt_Stop, 1);
 }
 
 /* Hook function to set FD output on opencreate call */
@@ -681,8 +887,16 @@ void Test_CF_CFDP_S_Init(void)
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
     UtAssert_VOIDCALL(CF_CFDP_S_Init(txn));
     UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+    UtAssert_STUB_COUNT(CF_Delta_ScanStart, 1);
     UtAssert_BOOL_TRUE(txn->flags.tx.send_md);
 
+    /* a delta transfer, the MD is sent once the file is hashed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_ScanStart), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_S_Init(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_PREPARE);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_md);
+
     /* From here on is error checks */
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), false);
 
@@ -727,6 +941,34 @@ void Test_CF_CFDP_S_Init(void)
     UT_CF_AssertEventID(CF_CFDP_S_SEEK_BEG_ERR_EID);
 
     UtAssert_STUB_COUNT(CF_CRC_Start, 1); /* nothing but the first nominal case should have invoked this */
+
+    /* Compressed, the file is opened once the compressed copy is done */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->compress = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_Init(txn));
+    UtAssert_STUB_COUNT(CF_Compress_FileStart, 1);
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_PREPARE);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_md);
+
+    /* Compression cannot start, nothing is opened */
+    UT_ResetState(UT_KEY(CF_WrappedOpenCreate));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_FileStart), 1, CF_ERROR);
+    txn->compress = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_Init(txn));
+    UtAssert_STUB_COUNT(CF_Compress_FileStart, 2);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_NORMAL);
+
+    /* Compressed, but the file is already open */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), false);
+    txn->compress = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_Init(txn));
+    UtAssert_STUB_COUNT(CF_Compress_FileStart, 2);
 }
 
 void Test_CF_CFDP_S_HandleFileRetention(void)
@@ -743,6 +985,7 @@ void Test_CF_CFDP_S_HandleFileRetention(void)
     txn->keep                  = true;
     txn->flags.com.is_complete = true;
     UtAssert_VOIDCALL(CF_CFDP_S_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Delta_Finish, 1);
     UtAssert_STUB_COUNT(OS_mv, 0);
     UtAssert_STUB_COUNT(OS_remove, 0);
 
@@ -852,6 +1095,104 @@ void Test_CF_CFDP_S_HandleFileRetention(void)
     UtAssert_STUB_COUNT(OS_mv, 0);
     UtAssert_STUB_COUNT(OS_remove, 0);
     UtAssert_STUB_COUNT(CF_CFDP_GetMoveTarget, 0);
+
+    /* A bundle, the files packed in it are handled instead */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode         = true;
+    txn->keep                  = false;
+    txn->flags.com.is_complete = true;
+    txn->flags.tx.bundle       = true;
+    UtAssert_VOIDCALL(CF_CFDP_S_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Bundle_Retain, 1);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+
+    /* Compressed, the compressed copy is closed and removed, the file is kept */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->keep                  = true;
+    txn->flags.com.is_complete = true;
+    txn->compress              = CF_Compress_LZ4;
+    txn->fd                    = OS_ObjectIdFromInteger(1);
+    UtAssert_VOIDCALL(CF_CFDP_S_HandleFileRetention(txn));
+    UtAssert_STUB_COUNT(CF_Compress_GetTempName, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+}
+
+void Test_CF_CFDP_S_CheckState_PREPARE(void)
+{
+    /* Test Case For:
+     * void CF_CFDP_S_CheckState(CF_Transaction_t *txn)
+     */
+    CF_Transaction_t *txn;
+
+    /* more blocks to compress */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    txn->compress             = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_PREPARE);
+    UtAssert_STUB_COUNT(CF_Compress_FileStep, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* done, the compressed copy is opened and the MD goes out */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_FileStep), 1, true);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedOpenCreate), UT_AltHandler_CF_WrappedOpenCreate, NULL);
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    txn->compress             = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_NORMAL);
+    UtAssert_STUB_COUNT(CF_Compress_GetTempName, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_md);
+
+    /* compression failed */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_TxnIsOK), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_FileStep), 1, true);
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    txn->compress             = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_md);
+
+    /* canceled while compressing */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    txn->compress             = CF_Compress_LZ4;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_FILESTORE);
+    UtAssert_STUB_COUNT(CF_Compress_FileStep, 0);
+
+    /* more blocks to hash for a delta transfer */
+    UT_ResetState(0);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->state_data.sub_state = CF_TxSubState_PREPARE;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_PREPARE);
+    UtAssert_STUB_COUNT(CF_Delta_ScanStep, 1);
+    UtAssert_STUB_COUNT(CF_Compress_FileStep, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_md);
+
+    /* hashed, the MD goes out */
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_ScanStep), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_NORMAL);
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_md);
 }
 
 void Test_CF_CFDP_S_CheckState_NORMAL(void)
@@ -881,6 +1222,21 @@ void Test_CF_CFDP_S_CheckState_NORMAL(void)
     UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
     UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_EOF);
 
+    /* delta transfer, the changed blocks are sent before the EOF */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    txn->reliable_mode           = true;
+    txn->foffs                   = 20;
+    txn->fsize                   = 20;
+    txn->flags.tx.delta          = true;
+    txn->flags.tx.fd_nak_pending = true;
+    txn->state_data.sub_state    = CF_TxSubState_DATA_NORMAL;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_NORMAL);
+    txn->flags.tx.fd_nak_pending = false;
+    UtAssert_VOIDCALL(CF_CFDP_S_CheckState(txn));
+    UtAssert_UINT8_EQ(txn->state_data.sub_state, CF_TxSubState_DATA_EOF);
+
     /* incomplete file with error state */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
@@ -1094,6 +1450,8 @@ void Test_CF_CFDP_S_CheckState(void)
      * void CF_CFDP_S_CheckState(CF_Transaction_t *txn)
      */
 
+    UT_ResetState(0);
+    Test_CF_CFDP_S_CheckState_PREPARE();
     UT_ResetState(0);
     Test_CF_CFDP_S_CheckState_NORMAL();
     UT_ResetState(0);
@@ -1160,6 +1518,10 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_S2_Recv, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Recv");
     UtTest_Add(Test_CF_CFDP_S_AckTimerTick, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_AckTimerTick");
     UtTest_Add(Test_CF_CFDP_S_Tick, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Tick");
+    UtTest_Add(Test_CF_CFDP_S2_CheckPrompt,
+               cf_cfdp_s_tests_Setup,
+               cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S2_CheckPrompt");
     UtTest_Add(Test_CF_CFDP_S_Tick_Maintenance,
                cf_cfdp_s_tests_Setup,
                cf_cfdp_s_tests_Teardown,
@@ -1178,6 +1540,10 @@ void UtTest_Setup(void)
                cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S_SubstateRecvFin");
     UtTest_Add(Test_CF_CFDP_S2_SubstateNak, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_SubstateNak");
+    UtTest_Add(Test_CF_CFDP_S2_SubstateKeepAlive,
+               cf_cfdp_s_tests_Setup,
+               cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S2_SubstateKeepAlive");
     UtTest_Add(Test_CF_CFDP_S2_SubstateEofAck,
                cf_cfdp_s_tests_Setup,
                cf_cfdp_s_tests_Teardown,
@@ -259,13 +259,84 @@ void Test_CF_CFDP_Send(void)
      * void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
      */
     CF_Logical_PduBuffer_t *ph;
+    CF_Transaction_t       *txn;
+    CF_Channel_t           *chan;
 
-    /* nominal */
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, NULL, NULL);
+    /* nominal, PDU is queued but not transmitted until the flush */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, &chan, NULL, &txn, NULL);
+    UtAssert_ADDRESS_EQ(CF_CFDP_MsgOutGet(txn, false), ph);
     UtAssert_VOIDCALL(CF_CFDP_Send(UT_CFDP_CHANNEL, ph));
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu, 1);
+    UtAssert_UINT32_EQ(chan->out_ring.num_queued, 1);
+    UtAssert_NULL(CF_AppData.engine.out.msg);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu, 0);
     UtAssert_STUB_COUNT(CFE_MSG_SetSize, 1);
-    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+    UtAssert_STUB_COUNT(CFE_MSG_SetMsgTime, 0);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 0);
+    UtAssert_STUB_COUNT(CF_Capture_Pdu, 0);
+
+    /* captured */
+    CF_AppData.capture.enabled = true;
+    UtAssert_ADDRESS_EQ(CF_CFDP_MsgOutGet(txn, false), ph);
+    UtAssert_VOIDCALL(CF_CFDP_Send(UT_CFDP_CHANNEL, ph));
+    UtAssert_UINT32_EQ(chan->out_ring.num_queued, 2);
+    UtAssert_STUB_COUNT(CF_Capture_Pdu, 1);
+}
+
+void Test_CF_CFDP_FlushOutput(void)
+{
+    /* Test case for:
+     * void CF_CFDP_FlushOutput(CF_Channel_t *chan)
+     */
+    CF_Channel_t    *chan;
+    CFE_SB_Buffer_t  bufs[3];
+    CF_OutputRing_t *ring;
+
+    /* nothing queued */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
+    ring = &chan->out_ring;
+    UtAssert_VOIDCALL(CF_CFDP_FlushOutput(chan));
+    UtAssert_STUB_COUNT(CFE_TIME_GetTime, 0);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 0);
+
+    /* two queued and one spare, one time stamp for the batch and the spare is kept */
+    ring->buf[0]                                                        = &bufs[0];
+    ring->buf[1]                                                        = &bufs[1];
+    ring->buf[2]                                                        = &bufs[2];
+    ring->num_queued                                                    = 2;
+    ring->num_held                                                      = 3;
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu = 1;
+    UtAssert_VOIDCALL(CF_CFDP_FlushOutput(chan));
+    UtAssert_STUB_COUNT(CFE_TIME_GetTime, 1);
+    UtAssert_STUB_COUNT(CFE_MSG_SetMsgTime, 2);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 2);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu, 3);
+    UtAssert_UINT32_EQ(ring->rate_pdus, 2);
+    UtAssert_UINT32_EQ(ring->num_queued, 0);
+    UtAssert_UINT32_EQ(ring->num_held, 1);
+    UtAssert_ADDRESS_EQ(ring->buf[0], &bufs[2]);
+    UtAssert_NULL(ring->buf[1]);
+    UtAssert_NULL(ring->buf[2]);
+}
+
+void Test_CF_CFDP_ReleaseOutput(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ReleaseOutput(CF_Channel_t *chan)
+     */
+    CF_Channel_t   *chan;
+    CFE_SB_Buffer_t bufs[2];
+
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
+    chan->out_ring.buf[0]                       = &bufs[0];
+    chan->out_ring.buf[CF_OUTPUT_RING_SIZE - 1] = &bufs[1];
+    chan->out_ring.num_queued                   = 1;
+    chan->out_ring.num_held                     = 2;
+    UtAssert_VOIDCALL(CF_CFDP_ReleaseOutput(chan));
+    UtAssert_STUB_COUNT(CFE_SB_ReleaseMessageBuffer, 2);
+    UtAssert_NULL(chan->out_ring.buf[0]);
+    UtAssert_NULL(chan->out_ring.buf[CF_OUTPUT_RING_SIZE - 1]);
+    UtAssert_UINT32_EQ(chan->out_ring.num_queued, 0);
+    UtAssert_UINT32_EQ(chan->out_ring.num_held, 0);
 }
 
 void Test_CF_CFDP_MsgOutGet(void)
@@ -276,22 +347,45 @@ void Test_CF_CFDP_MsgOutGet(void)
     CF_Transaction_t *txn;
     CF_ConfigTable_t *config;
     CF_Channel_t     *chan;
+    CF_OutputRing_t  *ring;
+    CFE_SB_Buffer_t   bufs[CF_OUTPUT_RING_SIZE];
+    int               i;
 
     /* nominal */
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, &txn, NULL);
+    ring = &chan->out_ring;
     UtAssert_NOT_NULL(CF_CFDP_MsgOutGet(txn, false));
+    UtAssert_STUB_COUNT(CFE_SB_AllocateMessageBuffer, 1);
     UtAssert_STUB_COUNT(CFE_SB_ReleaseMessageBuffer, 0);
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_UINT32_EQ(ring->num_held, 1);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.out_buf_hwm, 1);
 
-    /* This should discard the old message, and get a new one */
+    /* This should drop the old message, and reuse its buffer without going back to the SB pool */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     UtAssert_NOT_NULL(CF_CFDP_MsgOutGet(txn, false));
-    UtAssert_STUB_COUNT(CFE_SB_ReleaseMessageBuffer, 1);
+    UtAssert_STUB_COUNT(CFE_SB_AllocateMessageBuffer, 1);
+    UtAssert_STUB_COUNT(CFE_SB_ReleaseMessageBuffer, 0);
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.out.msg, ring->buf[0]);
+
+    /* ring full of queued PDUs is flushed before the next one is built */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    for (i = 0; i < CF_OUTPUT_RING_SIZE; ++i)
+    {
+        ring->buf[i] = &bufs[i];
+    }
+    ring->num_queued = CF_OUTPUT_RING_SIZE;
+    ring->num_held   = CF_OUTPUT_RING_SIZE;
+    UtAssert_NOT_NULL(CF_CFDP_MsgOutGet(txn, false));
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, CF_OUTPUT_RING_SIZE);
+    UtAssert_UINT32_EQ(ring->num_queued, 0);
+    UtAssert_STUB_COUNT(CFE_SB_AllocateMessageBuffer, 2);
+    memset(ring, 0, sizeof(*ring));
 
     /* test the various throttling mechanisms */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
-    config->chan[UT_CFDP_CHANNEL].max_outgoing_messages_per_wakeup = 3;
+    config->chan[UT_CFDP_CHANNEL].max_outgoing_messages_per_wakeup = 4; /* 3 already taken above */
     UtAssert_NOT_NULL(CF_CFDP_MsgOutGet(txn, false));
     UtAssert_NULL(CF_CFDP_MsgOutGet(txn, false));
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
@@ -318,6 +412,7 @@ void Test_CF_CFDP_MsgOutGet(void)
 
     /* no msg available from SB */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    memset(ring, 0, sizeof(*ring));
     UtAssert_NULL(CF_CFDP_MsgOutGet(txn, false));
     UT_CF_AssertEventID(CF_CFDP_NO_MSG_ERR_EID);
 
@@ -339,4 +434,6 @@ void UtTest_Setup(void)
 
     UtTest_Add(Test_CF_CFDP_MsgOutGet, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_MsgOutGet");
     UtTest_Add(Test_CF_CFDP_Send, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_Send");
+    UtTest_Add(Test_CF_CFDP_FlushOutput, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_FlushOutput");
+    UtTest_Add(Test_CF_CFDP_ReleaseOutput, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ReleaseOutput");
 }
@@ -27,6 +27,10 @@
 #include "cf_cfdp_pdu.h"
 #include "cf_cfdp_sbintf.h"
 #include "cf_cfdp_dispatch.h"
+#include "cf_spill.h"
+#include "cf_pollidx.h"
+#include "cf_bundle.h"
+#include "cf_rtt.h"
 
 /*******************************************************************************
 **
@@ -79,6 +83,8 @@ static void UT_CFDP_SetupBasicTestState(UT_CF_Setup_t            setup,
     static CF_History_t           ut_history;
     static CF_Transaction_t       ut_transaction;
     static CF_ConfigTable_t       ut_config_table;
+    static CF_Transaction_t      *ut_active_txn[CF_Direction_NUM][4];
+    int                           i;
 
     /*
      * always clear all objects, regardless of what was asked for.
@@ -89,12 +95,20 @@ static void UT_CFDP_SetupBasicTestState(UT_CF_Setup_t            setup,
     memset(&ut_history, 0, sizeof(ut_history));
     memset(&ut_transaction, 0, sizeof(ut_transaction));
     memset(&ut_config_table, 0, sizeof(ut_config_table));
+    memset(ut_active_txn, 0, sizeof(ut_active_txn));
 
     /* certain pointers should be connected even if they were not asked for,
      * as internal code may assume these are set (test cases may un-set) */
     ut_transaction.history  = &ut_history;
     CF_AppData.config_table = &ut_config_table;
 
+    /* the active sets normally point into the engine arena */
+    for (i = 0; i < CF_Direction_NUM; ++i)
+    {
+        CF_AppData.engine.channels[UT_CFDP_CHANNEL].active[i].txn      = ut_active_txn[i];
+        CF_AppData.engine.channels[UT_CFDP_CHANNEL].active[i].capacity = 4;
+    }
+
     if (pdu_buffer_p)
     {
         if (setup == UT_CF_Setup_TX || setup == UT_CF_Setup_RX)
@@ -259,6 +273,16 @@ void Test_CF_CFDP_ArmAckTimer(void)
 
     /* nominal call */
     UtAssert_VOIDCALL(CF_CFDP_ArmAckTimer(txn));
+    UtAssert_STUB_COUNT(CF_Rtt_GetTimeout, 1);
+    UtAssert_BOOL_TRUE(txn->flags.com.ack_timer_armed);
+}
+
+/* peer of the last call to CF_Peer_Count() */
+static CF_EntityId_t UT_CFDP_PeerEid;
+
+static void UT_CFDP_PeerCount(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CFDP_PeerEid = UT_Hook_GetArgValueByName(Context, "peer_eid", CF_EntityId_t);
 }
 
 void Test_CF_CFDP_RecvPh(void)
@@ -268,14 +292,23 @@ void Test_CF_CFDP_RecvPh(void)
      */
     CF_Logical_PduBuffer_t *ph;
 
-    /* nominal, file directive */
+    /* nominal, file directive from the receiver, counted for the destination */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_Peer_Count), UT_CFDP_PeerCount, NULL);
+    ph->pdu_header.direction       = 1;
+    ph->pdu_header.source_eid      = 3;
+    ph->pdu_header.destination_eid = 4;
     UtAssert_INT32_EQ(CF_CFDP_RecvPh(UT_CFDP_CHANNEL, ph), 0);
+    UtAssert_STUB_COUNT(CF_Peer_Count, 1);
+    UtAssert_UINT32_EQ(UT_CFDP_PeerEid, 4);
 
-    /* nominal, file data */
+    /* nominal, file data from the sender, counted for the source */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
-    ph->pdu_header.pdu_type = 1;
+    ph->pdu_header.pdu_type        = 1;
+    ph->pdu_header.source_eid      = 3;
+    ph->pdu_header.destination_eid = 4;
     UtAssert_INT32_EQ(CF_CFDP_RecvPh(UT_CFDP_CHANNEL, ph), 0);
+    UtAssert_UINT32_EQ(UT_CFDP_PeerEid, 3);
 
     /* decode error, fixed part */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
@@ -466,6 +499,46 @@ void Test_CF_CFDP_RecvNak(void)
     UT_CF_AssertEventID(CF_PDU_NAK_SHORT_ERR_EID);
 }
 
+void Test_CF_CFDP_RecvPrompt(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+     */
+
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* nominal call */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_RecvPrompt(txn, ph), 0);
+
+    /* decode errors: fixed part */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    CF_CODEC_SET_DONE(ph->pdec);
+    UtAssert_INT32_EQ(CF_CFDP_RecvPrompt(txn, ph), CF_SHORT_PDU_ERROR);
+    UT_CF_AssertEventID(CF_PDU_PROMPT_SHORT_ERR_EID);
+}
+
+void Test_CF_CFDP_RecvKeepAlive(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+     */
+
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* nominal call */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_RecvKeepAlive(txn, ph), 0);
+
+    /* decode errors: fixed part */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    CF_CODEC_SET_DONE(ph->pdec);
+    UtAssert_INT32_EQ(CF_CFDP_RecvKeepAlive(txn, ph), CF_SHORT_PDU_ERROR);
+    UT_CF_AssertEventID(CF_PDU_KEEP_ALIVE_SHORT_ERR_EID);
+}
+
 void Test_CF_CFDP_RecvDrop(void)
 {
     /* Test case for:
@@ -559,6 +632,9 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
     CF_Logical_PduBuffer_t *ph;
     CF_Logical_PduHeader_t *hdr;
 
+    UT_SetHandlerFunction(UT_KEY(CF_Peer_Count), UT_CFDP_PeerCount, NULL);
+
+    /* no buffer, nothing is counted */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
     UtAssert_NULL(CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_ACK, 3, 2, true, 42, false));
 
@@ -579,6 +655,8 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
     UtAssert_UINT32_EQ(hdr->destination_eid, 2);
     UtAssert_UINT32_EQ(hdr->sequence_num, 42);
     UtAssert_UINT32_EQ(ph->fdirective.directive_code, CF_CFDP_FileDirective_ACK);
+    UtAssert_STUB_COUNT(CF_Peer_Count, 1);
+    UtAssert_UINT32_EQ(UT_CFDP_PeerEid, 3);
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_GetValueEncodedSize), 5);
@@ -594,6 +672,7 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
     UtAssert_UINT32_EQ(hdr->source_eid, 7);
     UtAssert_UINT32_EQ(hdr->destination_eid, 6);
     UtAssert_UINT32_EQ(hdr->sequence_num, 44);
+    UtAssert_UINT32_EQ(UT_CFDP_PeerEid, 6);
 }
 
 void Test_CF_CFDP_SendMd(void)
@@ -812,6 +891,48 @@ void Test_CF_CFDP_SendNak(void)
     UtAssert_VOIDCALL(CF_CFDP_SendNak(txn, ph));
 }
 
+void Test_CF_CFDP_SendPrompt(void)
+{
+    /* Test case for:
+        CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response);
+     */
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* setup without a tx message */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_KEEP_ALIVE), CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodePrompt, 0);
+
+    /* nominal */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_KEEP_ALIVE), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(ph->int_header.prompt.response_required, CF_CFDP_PromptResponse_KEEP_ALIVE);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodePrompt, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_Send, 1);
+}
+
+void Test_CF_CFDP_SendKeepAlive(void)
+{
+    /* Test case for:
+        CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress);
+     */
+    CF_Transaction_t       *txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* setup without a tx message */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendKeepAlive(txn, 1000), CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodeKeepAlive, 0);
+
+    /* nominal */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendKeepAlive(txn, 1000), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(ph->int_header.keep_alive.progress, 1000);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodeKeepAlive, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_Send, 1);
+}
+
 void Test_CF_CFDP_AppendTlv(void)
 {
     /* Test case for:
@@ -842,18 +963,75 @@ void Test_CF_CFDP_AppendTlv(void)
     UtAssert_UINT32_EQ(tlv_list->num_tlv, CF_PDU_MAX_TLV);
 }
 
+void Test_CF_CFDP_ChannelArenaSize(void)
+{
+    /* Test case for:
+     * uint64 CF_CFDP_ChannelArenaSize(const CF_ChannelConfig_t *cc)
+     */
+    CF_ChannelConfig_t cc;
+    uint64             expected;
+
+    memset(&cc, 0, sizeof(cc));
+    UtAssert_UINT32_EQ(CF_CFDP_ChannelArenaSize(&cc), 0);
+
+    cc.num_transactions          = 3;
+    cc.num_histories             = 7;
+    cc.rx_chunks_per_transaction = 5;
+    cc.tx_chunks_per_transaction = CF_CHUNK_BLOCK_SIZE + 1;
+    cc.num_chunk_blocks          = 4;
+
+    expected = CF_ARENA_ROUNDUP(3 * sizeof(CF_Transaction_t));
+    expected += CF_ARENA_ROUNDUP(7 * sizeof(CF_History_t));
+    expected += CF_ARENA_ROUNDUP(3 * CF_Direction_NUM * sizeof(CF_ChunkWrapper_t));
+    expected += CF_Direction_NUM * CF_ARENA_ROUNDUP(3 * sizeof(CF_Transaction_t *));
+    expected += CF_ARENA_ROUNDUP(3 * 1 * sizeof(CF_Chunk_t *));
+    expected += CF_ARENA_ROUNDUP(3 * 2 * sizeof(CF_Chunk_t *));
+    expected += CF_ARENA_ROUNDUP(4 * CF_CHUNK_BLOCK_SIZE * sizeof(CF_Chunk_t));
+    expected += CF_ARENA_ROUNDUP(4 * sizeof(CF_Chunk_t *));
+    UtAssert_UINT32_EQ(CF_CFDP_ChannelArenaSize(&cc), expected);
+
+    /* does not overflow for very large values */
+    cc.num_transactions          = 0xFFFFFFFF;
+    cc.rx_chunks_per_transaction = 0xFFFFFFFF;
+    UtAssert_True(CF_CFDP_ChannelArenaSize(&cc) > 0xFFFFFFFF, "Arena size computed in 64 bits");
+}
+
 void Test_CF_CFDP_InitEngine(void)
 {
     /* Test case for:
      * int32 CF_CFDP_InitEngine(void)
      */
     CF_ConfigTable_t *config;
+    int               i;
 
     /* nominal call, no sem */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    for (i = 0; i < CF_NUM_CHANNELS; ++i)
+    {
+        config->chan[i].num_transactions          = 2;
+        config->chan[i].num_histories             = 3;
+        config->chan[i].rx_chunks_per_transaction = 4;
+        config->chan[i].tx_chunks_per_transaction = 5;
+        config->chan[i].num_chunk_blocks          = 6;
+    }
     UtAssert_INT32_EQ(CF_CFDP_InitEngine(), 0);
     UtAssert_BOOL_TRUE(CF_AppData.engine.enabled);
-    UtAssert_STUB_COUNT(CF_FreeTransaction, CF_NUM_TRANSACTIONS_PER_CHANNEL * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_FreeTransaction, 2 * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_ChunkSlab_Init, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_ChunkListInit, 2 * CF_Direction_NUM * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_CList_InsertBack, (2 * CF_Direction_NUM + 3) * CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[0].q_size[CF_QueueIdx_HIST_FREE], 3);
+    UtAssert_NOT_NULL(CF_AppData.engine.channels[0].active[CF_Direction_RX].txn);
+    UtAssert_UINT32_EQ(CF_AppData.engine.channels[0].active[CF_Direction_TX].capacity, 2);
+    UtAssert_UINT32_EQ(CF_AppData.engine.arena.used, CF_CFDP_ChannelArenaSize(&config->chan[0]) * CF_NUM_CHANNELS);
+
+    /* channel pools do not fit in the arena */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    config->chan[0].num_transactions = 1;
+    config->chan[0].num_histories    = sizeof(CF_AppData.engine.arena_mem) / sizeof(CF_History_t);
+    UtAssert_INT32_EQ(CF_CFDP_InitEngine(), CF_ERROR);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
+    UT_CF_AssertEventID(CF_INIT_ARENA_SIZE_ERR_EID);
 
     /* nominal call, with sem */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
@@ -922,7 +1100,7 @@ void Test_CF_CFDP_TxFile(void)
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
     UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
     chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, history->fnames.dst_filename, sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 1);
@@ -933,7 +1111,7 @@ void Test_CF_CFDP_TxFile(void)
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
     UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
     chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, history->fnames.dst_filename, sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 2);
@@ -942,7 +1120,7 @@ void Test_CF_CFDP_TxFile(void)
     /* max TX */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
     chan->num_cmd_tx = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), -1);
     UT_CF_AssertEventID(CF_CFDP_MAX_CMD_TX_ERR_EID);
 }
 
@@ -985,7 +1163,7 @@ void Test_CF_CFDP_PlaybackDir(void)
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
     pb = &chan->playback[0];
     memset(pb, 0, sizeof(*pb));
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, pb->fnames.dst_filename, sizeof(pb->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, pb->fnames.src_filename, sizeof(pb->fnames.src_filename));
     UtAssert_BOOL_TRUE(pb->diropen);
@@ -994,7 +1172,7 @@ void Test_CF_CFDP_PlaybackDir(void)
     /* OS_DirectoryOpen fail */
     memset(pb, 0, sizeof(*pb));
     UT_SetDeferredRetcode(UT_KEY(OS_DirectoryOpen), 1, OS_ERROR);
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), -1);
     UT_CF_AssertEventID(CF_CFDP_OPENDIR_ERR_EID);
 
     /* no non-busy entries */
@@ -1004,7 +1182,7 @@ void Test_CF_CFDP_PlaybackDir(void)
         pb       = &chan->playback[i];
         pb->busy = true;
     }
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_Compress_NONE), -1);
     UT_CF_AssertEventID(CF_CFDP_DIR_SLOT_ERR_EID);
 }
 
@@ -1045,53 +1223,151 @@ void Test_CF_CFDP_S_Tick_NewData(void)
     UtAssert_VOIDCALL(CF_CFDP_S_Tick_NewData(txn));
 }
 
-static void DoTickFnSetBlocked(CF_Transaction_t *txn)
+static int32 Ut_Hook_TickActiveSet_SetBlocked(void                   *UserObj,
+                                              int32                   StubRetcode,
+                                              uint32                  CallCount,
+                                              const UT_StubContext_t *Context)
+{
+    CF_AppData.engine.channels[UT_CFDP_CHANNEL].tx_blocked = true;
+    return StubRetcode;
+}
+
+static int32 Ut_Hook_SpendBudget(void                   *UserObj,
+                                 int32                   StubRetcode,
+                                 uint32                  CallCount,
+                                 const UT_StubContext_t *Context)
+{
+    CF_AppData.engine.budget_spent = true;
+    return StubRetcode;
+}
+
+static int32 Ut_Hook_TickActiveSet_Remove(void                   *UserObj,
+                                          int32                   StubRetcode,
+                                          uint32                  CallCount,
+                                          const UT_StubContext_t *Context)
 {
-    CF_AppData.engine.channels[txn->chan_num].tx_blocked = true;
+    CF_ActiveSet_t *set = UserObj;
+
+    /* simulate the first txn finishing during its tick - last entry moves into slot 0 */
+    if (CallCount == 0)
+    {
+        set->txn[0] = set->txn[set->count - 1];
+        --set->count;
+    }
+    return StubRetcode;
 }
 
-static void DoTickNoop(CF_Transaction_t *txn)
+void Test_CF_CFDP_TickActiveSet(void)
 {
-    UT_DEFAULT_IMPL(DoTickNoop);
+    /* Test case for:
+     * void CF_CFDP_TickActiveSet(CF_Channel_t *chan, CF_TickState_t tick_state, uint32 start_idx);
+     */
+    CF_Channel_t    *chan;
+    CF_Transaction_t txn[3];
+
+    memset(txn, 0, sizeof(txn));
+
+    /* empty sets, nothing to do */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 0));
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_TX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 0);
+
+    /* nominal, each tick state calls the correct function, suspended txn is skipped */
+    chan->active[CF_Direction_RX].txn[0] = &txn[0];
+    chan->active[CF_Direction_RX].txn[1] = &txn[1];
+    chan->active[CF_Direction_RX].count  = 2;
+    chan->active[CF_Direction_TX].txn[0] = &txn[2];
+    chan->active[CF_Direction_TX].count  = 1;
+    txn[1].flags.com.suspended           = true;
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 1);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_TX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 1);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_TX_NAK, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 1);
+
+    /* resume partway through the set */
+    txn[1].flags.com.suspended = false;
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 1));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 2);
+
+    /* resume index beyond the end of the set (entries removed since) */
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 5));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 2);
+
+    /* txn removed itself during its tick, the moved entry must still be ticked */
+    UT_ResetState(UT_KEY(CF_CFDP_R_Tick));
+    UT_SetHookFunction(UT_KEY(CF_CFDP_R_Tick), Ut_Hook_TickActiveSet_Remove, &chan->active[CF_Direction_RX]);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 2);
+    UtAssert_UINT32_EQ(chan->active[CF_Direction_RX].count, 1);
+
+    /* blocked after the first tick, stops early */
+    UT_ResetState(UT_KEY(CF_CFDP_R_Tick));
+    chan->active[CF_Direction_RX].txn[1] = &txn[0];
+    chan->active[CF_Direction_RX].count  = 2;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_R_Tick), Ut_Hook_TickActiveSet_SetBlocked, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 1);
+
+    /* out of time after the first tick, the next wakeup resumes at the second */
+    UT_ResetState(UT_KEY(CF_CFDP_R_Tick));
+    chan->tx_blocked = false;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_R_Tick), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_RX_STATE, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 1);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_RX_STATE);
+    UtAssert_UINT32_EQ(chan->tick_resume_idx, 1);
+
+    /* NAKs are best effort, no resume point */
+    chan->tick_resume_state              = CF_TickState_INIT;
+    CF_AppData.engine.budget_spent       = false;
+    chan->active[CF_Direction_TX].txn[1] = &txn[1];
+    chan->active[CF_Direction_TX].count  = 2;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_S_Tick_Nak), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickActiveSet(chan, CF_TickState_TX_NAK, 0));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 2);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_INIT);
 }
 
-void Test_CF_CFDP_DoTick(void)
+void Test_CF_CFDP_TickNewData(void)
 {
     /* Test case for:
-     * int CF_CFDP_DoTick(CF_CListNode_t *node, void *context);
+     * void CF_CFDP_TickNewData(CF_Channel_t *chan);
      */
-    CF_Transaction_t   *txn;
-    CF_Transaction_t    txn2;
-    CF_CFDP_Tick_args_t args;
-
-    memset(&args, 0, sizeof(args));
-    memset(&txn2, 0, sizeof(txn2));
-    args.fn = DoTickNoop;
-
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
-    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_CONT);
-    UtAssert_STUB_COUNT(DoTickNoop, 1);
-
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
-    args.resume_point = &txn2;
-    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_CONT);
-    UtAssert_STUB_COUNT(DoTickNoop, 1);
-    UtAssert_ADDRESS_EQ(args.resume_point, &txn2);
-
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
-    args.resume_point = txn;
-    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_CONT);
-    UtAssert_STUB_COUNT(DoTickNoop, 2);
-    UtAssert_NULL(args.resume_point);
-
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
-    txn->flags.com.suspended = true;
-    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_CONT);
-    UtAssert_STUB_COUNT(DoTickNoop, 2);
+    CF_Channel_t    *chan;
+    CF_Transaction_t txn[2];
 
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
-    args.fn = DoTickFnSetBlocked;
-    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_EXIT);
+    memset(txn, 0, sizeof(txn));
+
+    /* empty queue */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickNewData(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_NewData, 0);
+
+    /* two entries, second is suspended */
+    txn[0].cl_node.next        = &txn[1].cl_node;
+    txn[0].cl_node.prev        = &txn[1].cl_node;
+    txn[1].cl_node.next        = &txn[0].cl_node;
+    txn[1].cl_node.prev        = &txn[0].cl_node;
+    txn[1].flags.com.suspended = true;
+    chan->qs[CF_QueueIdx_TX]   = &txn[0].cl_node;
+    UtAssert_VOIDCALL(CF_CFDP_TickNewData(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_NewData, 1);
+
+    /* blocked after the first, does not continue */
+    txn[1].flags.com.suspended = false;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_S_Tick_NewData), Ut_Hook_TickActiveSet_SetBlocked, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickNewData(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_NewData, 2);
+
+    /* out of time after the first, does not continue */
+    chan->tx_blocked = false;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_S_Tick_NewData), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickNewData(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_NewData, 3);
 }
 
 void Test_CF_CFDP_ProcessPollingDirectories(void)
@@ -1138,6 +1414,7 @@ void Test_CF_CFDP_ProcessPollingDirectories(void)
     UtAssert_BOOL_FALSE(poll->timer_set);
     UtAssert_BOOL_TRUE(poll->pb.busy);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].poll_counter, 1);
+    UtAssert_STUB_COUNT(CF_PollIdx_BeginScan, 1);
 
     /* make an error occur in CF_CFDP_PlaybackDir_Initiate() */
     poll->pb.busy   = false; /* above would have set it true */
@@ -1147,6 +1424,16 @@ void Test_CF_CFDP_ProcessPollingDirectories(void)
     UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
     UtAssert_BOOL_TRUE(poll->timer_set);
     UT_CF_AssertEventID(CF_CFDP_OPENDIR_ERR_EID);
+    UtAssert_STUB_COUNT(CF_PollIdx_BeginScan, 1);
+
+    /* timer expired, but nothing changed since the directory settled */
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_PollIdx_Unchanged), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
+    UtAssert_BOOL_TRUE(poll->timer_set);
+    UtAssert_BOOL_FALSE(poll->pb.busy);
+    UtAssert_STUB_COUNT(OS_DirectoryOpen, 2);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 3);
 
     /* Test case where the impl calls through to CF_CFDP_ProcessPlaybackDirectory()
      *
@@ -1163,11 +1450,41 @@ void Test_CF_CFDP_ProcessPollingDirectories(void)
     poll->pb.num_ts = 0;
     UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
     UtAssert_BOOL_FALSE(poll->pb.busy); /* because num_ts == 0 */
+    UtAssert_STUB_COUNT(CF_PollIdx_EndScan, 2);
 
     /* test that call to CF_CFDP_UpdatePollPbCounted will decrement back to 0 again */
     pdcfg->enabled = 0;
+    poll->settled  = true;
     UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].poll_counter, 0);
+    UtAssert_STUB_COUNT(CF_PollIdx_Invalidate, 1);
+
+    /* out of time during the first directory, the next wakeup starts with the second */
+    pdcfg->enabled  = 1;
+    poll->timer_set = true;
+    UT_ResetState(UT_KEY(CF_Timer_Tick));
+    UT_SetHookFunction(UT_KEY(CF_Timer_Tick), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_UINT8_EQ(chan->poll_resume, 1 % CF_MAX_POLLING_DIR_PER_CHAN);
+
+    /* still out of time, the first directory is not reached */
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+}
+
+static CF_FileSize_t UT_CFDP_PlaybackStatSize[2]; /* sizes returned by successive OS_stat() calls */
+static uint8         UT_CFDP_PlaybackStatNum;
+
+static void UT_CFDP_PlaybackStat(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    os_fstat_t *filestats = UT_Hook_GetArgValueByName(Context, "filestats", os_fstat_t *);
+    int32       status    = OS_SUCCESS;
+
+    memset(filestats, 0, sizeof(*filestats));
+    filestats->FileSize = UT_CFDP_PlaybackStatSize[UT_CFDP_PlaybackStatNum++ % 2];
+
+    UT_Stub_SetReturnValue(FuncKey, status);
 }
 
 void Test_CF_CFDP_ProcessPlaybackDirectory(void)
@@ -1228,9 +1545,10 @@ void Test_CF_CFDP_ProcessPlaybackDirectory(void)
     UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 4, OS_ERROR); /* end of dir */
     UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
     UtAssert_BOOL_TRUE(pb.busy);
-    UtAssert_BOOL_TRUE(pb.diropen);
+    UtAssert_BOOL_FALSE(pb.diropen);
     UtAssert_ZERO(pb.num_ts);
-    UtAssert_STRINGBUF_EQ(pb.pending_file, sizeof(pb.pending_file), "ut", -1);
+    UtAssert_UINT8_EQ(pb.num_window, 1);
+    UtAssert_STRINGBUF_EQ(pb.window[0].name, sizeof(pb.window[0].name), "ut", -1);
 
     /* Now enter again but this time FindUnusedTransaction gets non-NULL (resumes playback) */
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
@@ -1240,21 +1558,125 @@ void Test_CF_CFDP_ProcessPlaybackDirectory(void)
     UtAssert_UINT16_EQ(pb.num_ts, 1);
     UtAssert_STRINGBUF_EQ(history->fnames.src_filename, sizeof(history->fnames.src_filename), "/ut", -1);
     UtAssert_STRINGBUF_EQ(history->fnames.dst_filename, sizeof(history->fnames.dst_filename), "/ut", -1);
-    UtAssert_STRINGBUF_EQ(pb.pending_file, sizeof(pb.pending_file), "", -1);
+    UtAssert_ZERO(pb.num_window);
     UT_CF_AssertEventID(CF_CFDP_S_START_SEND_INF_EID);
+
+    /* polling scan, the file is still being written so it is left for the next scan */
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.num_ts  = 0;
+    pb.polled  = true;
+    strcpy(pb.fnames.src_filename, "/poll");
+    OS_DirectoryOpen(&pb.dir_id, "ut");
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), &dirent[2], sizeof(dirent[2]), false);
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 2, OS_ERROR); /* end of dir */
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_PollIdx_FileSettled, 1);
+    UtAssert_BOOL_TRUE(pb.rescan);
+    UtAssert_BOOL_FALSE(pb.busy);
+    UtAssert_ZERO(pb.num_ts);
+    UtAssert_ZERO(pb.num_window);
+
+    /* smallest first, only one transaction slot left so the larger file stays in the window */
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.num_ts  = CF_NUM_TRANSACTIONS_PER_PLAYBACK - 1;
+    pb.polled  = false;
+    strcpy(dirent[0].FileName, "big");
+    strcpy(dirent[1].FileName, "small");
+    config->chan[UT_CFDP_CHANNEL].playback_order = CF_PlaybackOrder_SMALLEST;
+    UT_CFDP_PlaybackStatNum                      = 0;
+    UT_CFDP_PlaybackStatSize[0]                  = 1000;
+    UT_CFDP_PlaybackStatSize[1]                  = 10;
+    UT_SetHandlerFunction(UT_KEY(OS_stat), UT_CFDP_PlaybackStat, NULL);
+    OS_DirectoryOpen(&pb.dir_id, "ut");
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), dirent, 2 * sizeof(dirent[0]), false);
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 3, OS_ERROR); /* end of dir */
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_UINT16_EQ(pb.num_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK);
+    UtAssert_STRINGBUF_EQ(history->fnames.src_filename, sizeof(history->fnames.src_filename), "/poll/small", -1);
+    UtAssert_UINT8_EQ(pb.num_window, 1);
+    UtAssert_STRINGBUF_EQ(pb.window[0].name, sizeof(pb.window[0].name), "big", -1);
+    UtAssert_UINT32_EQ(pb.window[0].size, 1000);
+
+    /* polling scan with bundles, small files go into the bundle instead of the window */
+    pb.busy       = true;
+    pb.diropen    = true;
+    pb.num_ts     = 0;
+    pb.num_window = 0;
+    pb.polled     = true;
+    pb.rescan     = false;
+    UT_SetDefaultReturnValue(UT_KEY(CF_PollIdx_FileSettled), true);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Bundle_FileMax), 100);
+    config->chan[UT_CFDP_CHANNEL].playback_order = CF_PlaybackOrder_DIR;
+    UT_CFDP_PlaybackStatSize[0]                  = 10;
+    OS_DirectoryOpen(&pb.dir_id, "ut");
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), dirent, 2 * sizeof(dirent[0]), false);
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 3, OS_ERROR); /* end of dir */
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_Add, 2);
+    UtAssert_STUB_COUNT(CF_Bundle_EndScan, 1);
+    UtAssert_ZERO(pb.num_window);
+    UtAssert_ZERO(pb.num_ts);
+    UtAssert_BOOL_FALSE(pb.busy);
+
+    /* a ready bundle is sent before anything else */
+    pb.busy         = true;
+    pb.num_ts       = CF_NUM_TRANSACTIONS_PER_PLAYBACK - 1;
+    pb.bundle.ready = true;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_GetPath, 2);
+    UtAssert_STUB_COUNT(CF_Bundle_Started, 1);
+    UtAssert_UINT16_EQ(pb.num_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK);
+    UtAssert_BOOL_TRUE(txn->flags.tx.bundle);
+    UtAssert_ADDRESS_EQ(txn->pb, &pb);
+    UtAssert_BOOL_TRUE(pb.busy);
+
+    /* out of time, nothing is started and the playback stays busy */
+    pb.num_ts                      = 0;
+    CF_AppData.engine.budget_spent = true;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_Started, 1);
+    UtAssert_ZERO(pb.num_ts);
+    UtAssert_BOOL_TRUE(pb.busy);
 }
 
-static int32
-Ut_Hook_TickTransactions_SetBlocked(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+void Test_CF_CFDP_GetPlaybackPriority(void)
 {
-    CF_CFDP_Tick_args_t *args = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_Tick_args_t *);
-
-    if (CallCount != 0)
-    {
-        args->chan->tx_blocked = true;
-    }
+    /* Test case for:
+     * uint8 CF_CFDP_GetPlaybackPriority(const CF_Playback_t *pb, const char *name)
+     */
+    CF_ConfigTable_t *config;
+    CF_Playback_t     pb;
 
-    return StubRetcode;
+    memset(&pb, 0, sizeof(pb));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    pb.priority = 100;
+
+    /* no rules, the priority of the playback applies */
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "hk_001.dat"), 100);
+
+    strcpy(config->playback_prio[1].pattern, "hk_*.dat");
+    config->playback_prio[1].priority = 10;
+    strcpy(config->playback_prio[2].pattern, "*");
+    config->playback_prio[2].priority = 200;
+    strcpy(config->playback_prio[3].pattern, "ev?.log");
+    config->playback_prio[3].priority = 5;
+
+    /* empty rules are skipped, the first matching rule wins */
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "hk_001.dat"), 10);
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "hk_.dat"), 10);
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "hk_001.dat.tmp"), 200);
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "ev1.log"), 200);
+
+    /* '?' matches exactly one character */
+    config->playback_prio[2].pattern[0] = 0;
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "ev1.log"), 5);
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "ev.log"), 100);
+    UtAssert_UINT8_EQ(CF_CFDP_GetPlaybackPriority(&pb, "ev12.log"), 100);
 }
 
 static int32 Ut_Hook_TickTransactions_UpdateCount(void                   *UserObj,
@@ -1275,23 +1697,75 @@ void Test_CF_CFDP_TickTransactions(void)
     /* Test case for:
         void CF_CFDP_TickTransactions(CF_Channel_t *chan);
      */
-    CF_Channel_t *chan;
+    CF_Channel_t    *chan;
+    CF_Transaction_t txn[2];
 
-    /* nominal */
+    memset(txn, 0, sizeof(txn));
+
+    /* nominal, all sets empty */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, NULL, NULL);
     UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
-    UtAssert_STUB_COUNT(CF_CList_Traverse, 4);
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_FlushOutput, 1);
+
+    /* one txn in each set */
+    chan->active[CF_Direction_RX].txn[0] = &txn[0];
+    chan->active[CF_Direction_RX].count  = 1;
+    chan->active[CF_Direction_TX].txn[0] = &txn[1];
+    chan->active[CF_Direction_TX].count  = 1;
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 1);
 
-    UT_ResetState(UT_KEY(CF_CList_Traverse));
-    UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_TickTransactions_SetBlocked, NULL);
+    /* blocked during RX ticks, TX is not reached */
+    UT_ResetState(UT_KEY(CF_CFDP_S_Tick));
+    UT_SetHookFunction(UT_KEY(CF_CFDP_R_Tick), Ut_Hook_TickActiveSet_SetBlocked, NULL);
     UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
-    UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_FlushOutput, 3); /* still flushed when blocked */
+    UT_ResetState(UT_KEY(CF_CFDP_R_Tick));
+
+    /* resume from TX state skips the RX set */
+    chan->tx_blocked        = false;
+    chan->tick_resume_state = CF_TickState_TX_STATE;
+    chan->tick_resume_idx   = 0;
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 1);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_INIT);
 
-    UT_ResetState(UT_KEY(CF_CList_Traverse));
-    UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_TickTransactions_UpdateCount, NULL);
-    chan->tx_blocked = false;
+    /* NAK is repeated as long as something was sent */
+    UT_ResetState(UT_KEY(CF_CFDP_S_Tick_Nak));
+    UT_SetHookFunction(UT_KEY(CF_CFDP_S_Tick_Nak), Ut_Hook_TickTransactions_UpdateCount, NULL);
     UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
-    UtAssert_STUB_COUNT(CF_CList_Traverse, 7); /* because NAK is repeated several times  */
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 6);
+
+    /* out of time after the RX set, the next wakeup starts with the TX set */
+    UT_ResetState(UT_KEY(CF_CFDP_S_Tick));
+    UT_ResetState(UT_KEY(CF_CFDP_S_Tick_Nak));
+    UT_SetHookFunction(UT_KEY(CF_CFDP_R_Tick), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_R_Tick, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 0);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_TX_STATE);
+    UtAssert_UINT32_EQ(chan->tick_resume_idx, 0);
+
+    /* still out of time, the resume point is kept and the output flushed */
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 0);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_TX_STATE);
+    UtAssert_STUB_COUNT(CF_CFDP_FlushOutput, 7);
+
+    /* out of time during the NAKs, the next wakeup starts over */
+    CF_AppData.engine.budget_spent = false;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_S_Tick_Nak), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Tick_Nak, 1);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_INIT);
 }
 
 void Test_CF_CFDP_CycleEngine(void)
@@ -1299,19 +1773,130 @@ void Test_CF_CFDP_CycleEngine(void)
     /* Test case for:
      * void CF_CFDP_CycleEngine(void)
      */
-    CF_Channel_t *chan;
+    CF_Channel_t     *chan;
+    CF_ConfigTable_t *config;
 
     /* nominal with engine disabled, noop */
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, &config);
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_ZERO(CF_AppData.engine.tick_count);
 
     /* enabled but frozen */
     CF_AppData.engine.enabled                                = true;
     CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].frozen = 1;
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Spill_Tick, CF_NUM_CHANNELS - 1);
 
     CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].frozen = 0;
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Spill_Tick, (2 * CF_NUM_CHANNELS) - 1);
+    UtAssert_UINT32_EQ(CF_AppData.engine.tick_count, 2);
+
+    /* every channel ends its wakeup, frozen or not, and so does each cycle */
+    UtAssert_STUB_COUNT(CF_Diag_EndChannel, 2 * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_Diag_EndCycle, 2);
+
+    /* PDU rate is published once every ticks_per_second wakeups */
+    config->ticks_per_second  = 2;
+    chan->out_ring.rate_ticks = 0;
+    chan->out_ring.rate_pdus  = 5;
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu_rate, 0);
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu_rate, 5);
+    UtAssert_UINT32_EQ(chan->out_ring.rate_pdus, 0);
+    UtAssert_UINT32_EQ(chan->out_ring.rate_ticks, 0);
+
+    /* out of time during the work of the first channel, the next one goes first on the next wakeup */
+    UT_ResetState(UT_KEY(CF_Spill_Tick));
+    UT_SetHookFunction(UT_KEY(CF_Spill_Tick), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Spill_Tick, 1);
+    UtAssert_UINT8_EQ(CF_AppData.engine.first_chan, 1 % CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(CF_AppData.diag.pkt.Payload.yields, 1);
+
+    /* the budget is renewed on each wakeup */
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Spill_Tick, 2);
+    UtAssert_UINT8_EQ(CF_AppData.engine.first_chan, 2 % CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(CF_AppData.diag.pkt.Payload.yields, 2);
+
+    /* out of time while receiving, the channel got none of its turn and goes first again */
+    UT_ResetState(UT_KEY(CF_Spill_Tick));
+    UT_ResetState(UT_KEY(CF_CFDP_ReceiveMessage));
+    UT_SetHookFunction(UT_KEY(CF_CFDP_ReceiveMessage), Ut_Hook_SpendBudget, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_Spill_Tick, 0);
+    UtAssert_UINT8_EQ(CF_AppData.engine.first_chan, 2 % CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(CF_AppData.diag.pkt.Payload.yields, 3);
+
+    /* within the budget, the order stays */
+    UT_ResetState(UT_KEY(CF_CFDP_ReceiveMessage));
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Spill_Tick, CF_NUM_CHANNELS);
+    UtAssert_UINT8_EQ(CF_AppData.engine.first_chan, 2 % CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(CF_AppData.diag.pkt.Payload.yields, 3);
+
+    /* chunk lists that could not grow from the slab are counted and reported */
+    UT_ResetState(UT_KEY(CFE_EVS_SendEvent));
+    chan->chunk_slab.grow_fails = 3;
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.chunk_slab_empty, 3);
+    UtAssert_ZERO(chan->chunk_slab.grow_fails);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_CFDP_CHUNK_SLAB_ERR_EID);
+
+    /* the event is rate limited, the counter is not */
+    UT_SetDefaultReturnValue(UT_KEY(CF_EvLim_Allow), false);
+    chan->chunk_slab.grow_fails = 2;
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.chunk_slab_empty, 5);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+}
+
+/* local clock seen by CF_CFDP_BudgetSpent(), in microseconds */
+static uint32 UT_CFDP_Now_us;
+
+static void UT_CFDP_GetLocalTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    OS_time_t *time_struct = UT_Hook_GetArgValueByName(Context, "time_struct", OS_time_t *);
+
+    *time_struct = OS_TimeAssembleFromNanoseconds(UT_CFDP_Now_us / 1000000, (UT_CFDP_Now_us % 1000000) * 1000);
+}
+
+void Test_CF_CFDP_BudgetSpent(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_BudgetSpent(void)
+     */
+    CF_ConfigTable_t *config;
+
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    UT_SetHandlerFunction(UT_KEY(OS_GetLocalTime), UT_CFDP_GetLocalTime, NULL);
+    UT_CFDP_Now_us                 = 2000000;
+    CF_AppData.engine.wakeup_start = OS_TimeAssembleFromNanoseconds(2, 0);
+
+    /* no budget, the clock is not read */
+    UtAssert_BOOL_FALSE(CF_CFDP_BudgetSpent());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 0);
+
+    /* within the budget */
+    config->wakeup_budget_us = 1000;
+    UT_CFDP_Now_us += 999;
+    UtAssert_BOOL_FALSE(CF_CFDP_BudgetSpent());
+    UtAssert_BOOL_FALSE(CF_AppData.engine.budget_spent);
+
+    /* used up */
+    UT_CFDP_Now_us += 1;
+    UtAssert_BOOL_TRUE(CF_CFDP_BudgetSpent());
+    UtAssert_BOOL_TRUE(CF_AppData.engine.budget_spent);
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 2);
+
+    /* stays used up for the rest of the wakeup, without reading the clock */
+    UT_CFDP_Now_us = 2000000;
+    UtAssert_BOOL_TRUE(CF_CFDP_BudgetSpent());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 2);
 }
 
 void Test_CF_CFDP_FinishTransaction(void)
@@ -1383,6 +1968,17 @@ void Test_CF_CFDP_FinishTransaction(void)
     UtAssert_VOIDCALL(CF_CFDP_FinishTransaction(txn, true));
     UtAssert_UINT32_EQ(pb.num_ts, 9);
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 7);
+    UtAssert_BOOL_FALSE(pb.rescan);
+
+    /* a playback transaction that failed leaves its file behind */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
+    txn->pb           = &pb;
+    history->dir      = CF_Direction_TX;
+    history->txn_stat = CF_TxnStatus_FILESTORE_REJECTION;
+    txn->state        = CF_TxnState_S1;
+    UtAssert_VOIDCALL(CF_CFDP_FinishTransaction(txn, true));
+    UtAssert_UINT32_EQ(pb.num_ts, 8);
+    UtAssert_BOOL_TRUE(pb.rescan);
 
     /* coverage completeness: history is NULL (should never happen in real use) */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, &history, &txn, NULL);
@@ -1423,6 +2019,7 @@ void Test_CF_CFDP_RecycleTransaction(void)
     txn->chunks            = &cl;
     UtAssert_VOIDCALL(CF_CFDP_RecycleTransaction(txn));
     UtAssert_NULL(txn->chunks);
+    UtAssert_STUB_COUNT(CF_ChunkListReset, 1);
 
     /* repeat but fail to get list head */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -1431,6 +2028,7 @@ void Test_CF_CFDP_RecycleTransaction(void)
     txn->chunks            = &cl;
     UtAssert_VOIDCALL(CF_CFDP_RecycleTransaction(txn));
     UtAssert_ADDRESS_EQ(txn->chunks, &cl); /* not cleaned */
+    UtAssert_STUB_COUNT(CF_ChunkListReset, 1); /* not reset again */
 
     /* Dupe call: history already freed */
     UtAssert_VOIDCALL(CF_CFDP_RecycleTransaction(txn));
@@ -1486,6 +2084,8 @@ void Test_CF_CFDP_SendEotPkt(void)
     PktBufPtr = &PktBuf;
     memset(PktBufPtr, 0, sizeof(*PktBufPtr));
     UT_SetDataBuffer(UT_KEY(CFE_SB_AllocateMessageBuffer), &PktBufPtr, sizeof(PktBufPtr), true);
+    txn->history->metrics.end_ms   = 1500;
+    txn->history->metrics.fd_bytes = 4096;
 
     /* Execute the function being tested */
     /* nominal call */
@@ -1495,6 +2095,8 @@ void Test_CF_CFDP_SendEotPkt(void)
     UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
     UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
     UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+    UtAssert_UINT32_EQ(PktBuf.Payload.metrics.end_ms, 1500);
+    UtAssert_UINT32_EQ(PktBuf.Payload.metrics.fd_bytes, 4096);
 }
 
 void Test_CF_CFDP_DisableEngine(void)
@@ -1507,6 +2109,7 @@ void Test_CF_CFDP_DisableEngine(void)
     CF_AppData.engine.enabled = true;
     UtAssert_VOIDCALL(CF_CFDP_DisableEngine());
     UtAssert_STUB_COUNT(CFE_SB_DeletePipe, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_CFDP_ReleaseOutput, CF_NUM_CHANNELS);
     UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
 
     /* nominal call with playbacks and polls active */
@@ -1516,6 +2119,13 @@ void Test_CF_CFDP_DisableEngine(void)
     OS_DirectoryOpen(&CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[0].pb.dir_id, "ut");
     UtAssert_VOIDCALL(CF_CFDP_DisableEngine());
     UtAssert_STUB_COUNT(OS_DirectoryClose, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* a checkpoint being written is dropped */
+    CF_AppData.engine.checkpoint.busy = true;
+    UtAssert_VOIDCALL(CF_CFDP_DisableEngine());
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.checkpoint.busy);
 }
 
 void Test_CF_CFDP_CloseFiles(void)
@@ -1757,8 +2367,10 @@ void Test_CF_CFDP_ReceivePdu(void)
     CF_Transaction_t       *txn;
     CF_ConfigTable_t       *config;
     CF_ChunkWrapper_t       chunk_wrap;
+    CF_SpillEntry_t         spilled;
 
     memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+    memset(&spilled, 0, sizeof(spilled));
 
     /*
      *  - CF_CFDP_RecvPh() succeeds
@@ -1779,6 +2391,14 @@ void Test_CF_CFDP_ReceivePdu(void)
     UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
     UT_CF_AssertEventID(CF_CFDP_INVALID_DST_ERR_EID);
 
+    /* same, with the event rate limited */
+    UT_ResetState(UT_KEY(CFE_EVS_SendEvent));
+    UT_ResetState(UT_KEY(CF_EvLim_Allow));
+    UT_SetDeferredRetcode(UT_KEY(CF_EvLim_Allow), 1, false);
+    UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
+    UtAssert_STUB_COUNT(CF_EvLim_Allow, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
     /* recv correct destination_eid  */
     UT_ResetState(UT_KEY(CF_CFDP_R_Init)), UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
@@ -1797,8 +2417,44 @@ void Test_CF_CFDP_ReceivePdu(void)
     ph->pdu_header.destination_eid = config->local_eid;
     UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
     UT_CF_AssertEventID(CF_CFDP_RX_DROPPED_ERR_EID);
+    UtAssert_STUB_COUNT(CF_Spill_MakeRoom, 1);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 1);
+
+    /* failure in CF_CFDP_StartRxTransaction, tried again after spilling a transaction */
+    UT_ResetState(UT_KEY(CF_Spill_MakeRoom));
+    UT_ResetState(UT_KEY(CF_FindUnusedTransaction));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
+    config->local_eid              = 123;
+    ph->pdu_header.destination_eid = config->local_eid;
+    UT_SetDeferredRetcode(UT_KEY(CF_Spill_MakeRoom), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
+    UtAssert_STUB_COUNT(CF_Spill_MakeRoom, 1);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 2);
+
+    /* transaction was spilled to disk, and is reloaded */
+    UT_ResetState(UT_KEY(CF_FindUnusedTransaction));
+    UT_ResetState(UT_KEY(CF_CFDP_RxStateDispatch));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
+    txn->state = CF_TxnState_R2;
+    UT_SetHandlerFunction(UT_KEY(CF_Spill_Find), UT_AltHandler_GenericPointerReturn, &spilled);
+    UT_SetHandlerFunction(UT_KEY(CF_Spill_Reload), UT_AltHandler_GenericPointerReturn, txn);
+    UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
+    UtAssert_STUB_COUNT(CF_Spill_Reload, 1);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RxStateDispatch, 1);
+
+    /* transaction was spilled to disk, but cannot be reloaded */
+    UT_ResetState(UT_KEY(CF_Spill_Reload));
+    UT_ResetState(UT_KEY(CF_CFDP_RxStateDispatch));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
+    UT_SetHandlerFunction(UT_KEY(CF_Spill_Find), UT_AltHandler_GenericPointerReturn, &spilled);
+    UtAssert_VOIDCALL(CF_CFDP_ReceivePdu(chan, ph));
+    UtAssert_STUB_COUNT(CF_Spill_Reload, 1);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RxStateDispatch, 0);
 
     /* failure in RecvPh */
+    UT_ResetState(UT_KEY(CF_Spill_Find));
     UT_ResetState(UT_KEY(CF_FindTransactionBySequenceNumber)),
         UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
     UT_SetDeferredRetcode(UT_KEY(CF_CFDP_DecodeHeader), 1, -1);
@@ -1834,36 +2490,46 @@ void Test_CF_CFDP_CompleteTick(void)
      * void CF_CFDP_CompleteTick(CF_Transaction_t *txn)
      */
     CF_Transaction_t *txn;
-    CF_Transaction_t  txn2;
     CF_Channel_t     *chan;
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
     UT_SetHandlerFunction(UT_KEY(CF_GetChannelFromTxn), UT_AltHandler_GenericPointerReturn, chan);
-    chan->tx_blocked  = true;
-    chan->tick_resume = NULL;
+    chan->tx_blocked        = true;
+    chan->tick_resume_state = CF_TickState_INIT;
+    txn->flags.com.q_index  = CF_QueueIdx_RX;
+    txn->active_idx         = 3;
     UtAssert_VOIDCALL(CF_CFDP_CompleteTick(txn));
-    UtAssert_ADDRESS_EQ(chan->tick_resume, txn);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_RX_STATE);
+    UtAssert_UINT32_EQ(chan->tick_resume_idx, 3);
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
     UT_SetHandlerFunction(UT_KEY(CF_GetChannelFromTxn), UT_AltHandler_GenericPointerReturn, chan);
-    chan->tx_blocked  = true;
-    chan->tick_resume = &txn2;
+    chan->tx_blocked        = true;
+    chan->tick_resume_state = CF_TickState_INIT;
+    txn->flags.com.q_index  = CF_QueueIdx_TX;
+    txn->active_idx         = 2;
+    UtAssert_VOIDCALL(CF_CFDP_CompleteTick(txn));
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_TX_STATE);
+    UtAssert_UINT32_EQ(chan->tick_resume_idx, 2);
+
+    /* already have a resume point, not overwritten */
+    txn->active_idx = 5;
     UtAssert_VOIDCALL(CF_CFDP_CompleteTick(txn));
-    UtAssert_ADDRESS_EQ(chan->tick_resume, &txn2);
+    UtAssert_UINT32_EQ(chan->tick_resume_idx, 2);
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
     UT_SetHandlerFunction(UT_KEY(CF_GetChannelFromTxn), UT_AltHandler_GenericPointerReturn, chan);
-    chan->tx_blocked  = false;
-    chan->tick_resume = NULL;
+    chan->tx_blocked        = false;
+    chan->tick_resume_state = CF_TickState_INIT;
     UtAssert_VOIDCALL(CF_CFDP_CompleteTick(txn));
-    UtAssert_NULL(chan->tick_resume);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_INIT);
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
     UT_ResetState(UT_KEY(CF_GetChannelFromTxn));
-    chan->tx_blocked  = false;
-    chan->tick_resume = NULL;
+    chan->tx_blocked        = false;
+    chan->tick_resume_state = CF_TickState_INIT;
     UtAssert_VOIDCALL(CF_CFDP_CompleteTick(txn));
-    UtAssert_NULL(chan->tick_resume);
+    UtAssert_UINT8_EQ(chan->tick_resume_state, CF_TickState_INIT);
 }
 
 void Test_CF_CFDP_GetTempName(void)
@@ -1924,18 +2590,25 @@ void Test_CF_CFDP_GetMoveTarget(void)
 void UtTest_Setup(void)
 {
     UtTest_Add(Test_CF_CFDP_TxnStatus, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TxnStatus");
+    UtTest_Add(Test_CF_CFDP_ChannelArenaSize, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ChannelArenaSize");
     UtTest_Add(Test_CF_CFDP_InitEngine, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_InitEngine");
     UtTest_Add(Test_CF_CFDP_CycleEngine, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_CycleEngine");
+    UtTest_Add(Test_CF_CFDP_BudgetSpent, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_BudgetSpent");
     UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory,
                cf_cfdp_tests_Setup,
                cf_cfdp_tests_Teardown,
                "Test_CF_CFDP_ProcessPlaybackDirectory");
+    UtTest_Add(Test_CF_CFDP_GetPlaybackPriority,
+               cf_cfdp_tests_Setup,
+               cf_cfdp_tests_Teardown,
+               "CF_CFDP_GetPlaybackPriority");
     UtTest_Add(Test_CF_CFDP_ProcessPollingDirectories,
                cf_cfdp_tests_Setup,
                cf_cfdp_tests_Teardown,
                "Test_CF_CFDP_ProcessPollingDirectories");
     UtTest_Add(Test_CF_CFDP_S_Tick_NewData, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "Test_CF_CFDP_S_Tick_NewData");
-    UtTest_Add(Test_CF_CFDP_DoTick, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_DoTick");
+    UtTest_Add(Test_CF_CFDP_TickActiveSet, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TickActiveSet");
+    UtTest_Add(Test_CF_CFDP_TickNewData, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TickNewData");
     UtTest_Add(Test_CF_CFDP_TickTransactions, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TickTransactions");
     UtTest_Add(Test_CF_CFDP_FinishTransaction,
                cf_cfdp_tests_Setup,
@@ -1984,6 +2657,8 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_RecvAck, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvAck");
     UtTest_Add(Test_CF_CFDP_RecvFin, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvFin");
     UtTest_Add(Test_CF_CFDP_RecvNak, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvNak");
+    UtTest_Add(Test_CF_CFDP_RecvPrompt, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvPrompt");
+    UtTest_Add(Test_CF_CFDP_RecvKeepAlive, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvKeepAlive");
     UtTest_Add(Test_CF_CFDP_CopyStringFromLV, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_CopyStringFromLV");
 
     UtTest_Add(Test_CF_CFDP_ConstructPduHeader,
@@ -1997,6 +2672,8 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_SendFin, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendFin");
     UtTest_Add(Test_CF_CFDP_AppendTlv, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_AppendTlv");
     UtTest_Add(Test_CF_CFDP_SendNak, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendNak");
+    UtTest_Add(Test_CF_CFDP_SendPrompt, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendPrompt");
+    UtTest_Add(Test_CF_CFDP_SendKeepAlive, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendKeepAlive");
 
     UtTest_Add(Test_CF_CFDP_ArmInactTimer, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ArmInactTimer");
     UtTest_Add(Test_CF_CFDP_CheckAckNakCount, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_CheckAckNakCount");
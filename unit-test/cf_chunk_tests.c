@@ -31,6 +31,20 @@ typedef struct
 
 Test_CF_compute_gap_context_t Test_CF_compute_gap_context;
 
+/* Slab backing the chunk lists under test */
+#define UT_CF_CHUNK_SLAB_BLOCKS 3
+CF_Chunk_t     UT_CF_Chunk_BlockMem[UT_CF_CHUNK_SLAB_BLOCKS * CF_CHUNK_BLOCK_SIZE];
+CF_Chunk_t    *UT_CF_Chunk_FreeBlocks[UT_CF_CHUNK_SLAB_BLOCKS];
+CF_ChunkSlab_t UT_CF_Chunk_Slab;
+
+/* Reset the test slab so every block is free, with a block reserved for each of num_lists lists */
+void UT_CF_Chunk_SetupSlab(CF_ChunkIdx_t num_lists)
+{
+    memset(UT_CF_Chunk_BlockMem, 0, sizeof(UT_CF_Chunk_BlockMem));
+    CF_ChunkSlab_Init(&UT_CF_Chunk_Slab, UT_CF_CHUNK_SLAB_BLOCKS, num_lists, UT_CF_Chunk_BlockMem,
+                      UT_CF_Chunk_FreeBlocks);
+}
+
 void Test_CF_compute_gap_fn(const CF_ChunkList_t *CList, const CF_Chunk_t *Chunk, void *Opaque)
 {
     UtAssert_ADDRESS_EQ(CList, Opaque);
@@ -56,19 +70,17 @@ void UT_CF_Chunk_SetupFull(CF_ChunkList_t *CList)
      *  1    2     3     4     5
      * 0-1 11-13 23-26 36-40 50-55
      */
-    CList->chunks[0].offset = 0;
+    CF_ChunkOffset_t offset = 0;
+
+    CF_ChunkListReset(CList);
     for (cidx = 0; cidx < CList->max_chunks; cidx++)
     {
-        CList->chunks[cidx].size = cidx + 1;
-
-        if (cidx > 0)
-        {
-            CList->chunks[cidx].offset = CList->chunks[cidx - 1].offset + CList->chunks[cidx - 1].size + 10;
-        }
+        CF_ChunkListAdd(CList, offset, cidx + 1);
+        offset += cidx + 1 + 10;
     }
 
-    /* Set count to max since list is now full */
-    CList->count = CList->max_chunks;
+    /* List is now full */
+    UtAssert_UINT32_EQ(CList->count, CList->max_chunks);
 }
 
 /* Print the chunk list to the UT log (test debug helper) */
@@ -81,8 +93,8 @@ void UT_CF_Chunk_Print(CF_ChunkList_t *CList)
     {
         UtPrintf("%u{%u, %u}",
                  (unsigned int)cidx,
-                 (unsigned int)CList->chunks[cidx].offset,
-                 (unsigned int)CList->chunks[cidx].size);
+                 (unsigned int)CF_ChunkList_At(CList, cidx)->offset,
+                 (unsigned int)CF_ChunkList_At(CList, cidx)->size);
     }
 
     UtPrintf("Chunk list: index{start-end}");
@@ -90,8 +102,8 @@ void UT_CF_Chunk_Print(CF_ChunkList_t *CList)
     {
         UtPrintf("%u{%u-%u}",
                  (unsigned int)cidx,
-                 (unsigned int)CList->chunks[cidx].offset,
-                 (unsigned int)(CList->chunks[cidx].offset + CList->chunks[cidx].size));
+                 (unsigned int)CF_ChunkList_At(CList, cidx)->offset,
+                 (unsigned int)(CF_ChunkList_At(CList, cidx)->offset + CF_ChunkList_At(CList, cidx)->size));
     }
 }
 
@@ -106,60 +118,61 @@ void UT_CF_Chunk_Print(CF_ChunkList_t *CList)
 void Test_CF_Chunk_CreateAddReset(void)
 {
     CF_ChunkList_t clist;
-    CF_Chunk_t     chunks[3];
+    CF_Chunk_t    *blocks[CF_CHUNK_BLOCKS_FOR(3)];
+
+    UT_CF_Chunk_SetupSlab(1);
 
     /* Set nonzero values and test CF_ChunkListInit */
     memset(&clist, 0xFF, sizeof(clist));
-    memset(chunks, 0xFF, sizeof(chunks));
-    UtAssert_VOIDCALL(CF_ChunkListInit(&clist, sizeof(chunks) / sizeof(chunks[0]), chunks));
+    UtAssert_VOIDCALL(CF_ChunkListInit(&clist, 3, blocks, &UT_CF_Chunk_Slab));
     UtAssert_UINT32_EQ(clist.count, 0);
-    UtAssert_UINT32_EQ(clist.max_chunks, sizeof(chunks) / sizeof(chunks[0]));
-    /* Spot check chunks clear */
-    UtAssert_UINT32_EQ(chunks[1].size, 0);
-    UtAssert_UINT32_EQ(chunks[1].offset, 0);
+    UtAssert_UINT32_EQ(clist.max_chunks, 3);
+    UtAssert_UINT32_EQ(clist.num_blocks, 0);
+    UtAssert_ADDRESS_EQ(clist.blocks, blocks);
+    UtAssert_ADDRESS_EQ(clist.slab, &UT_CF_Chunk_Slab);
 
     /* Add to empty list */
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 5, 1));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 5);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 1);
     UtAssert_UINT32_EQ(clist.count, 1);
 
     /* Add to end of list */
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 10, 1));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 5);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 10);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 1);
     UtAssert_UINT32_EQ(clist.count, 2);
 
     /* Add to front of list */
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 0, 2));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 5);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 10);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 1);
     UtAssert_UINT32_EQ(clist.count, 3);
 
     /* Force 1 to drop (first smallest), with new at the end */
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 20, 2));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 10);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 2);
     UtAssert_UINT32_EQ(clist.count, 3);
 
     /* Nominal combine previous (no overlap, at the end) */
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 22, 2));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 10);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 4);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 4);
     UtAssert_UINT32_EQ(clist.count, 3);
 }
 
@@ -167,10 +180,11 @@ void Test_CF_Chunk_CreateAddReset(void)
 void Test_CF_Chunk_Combine(void)
 {
     CF_ChunkList_t clist;
-    CF_Chunk_t     chunks[5];
+    CF_Chunk_t    *blocks[CF_CHUNK_BLOCKS_FOR(5)];
 
     /* Initialize list (note already tested) */
-    CF_ChunkListInit(&clist, sizeof(chunks) / sizeof(chunks[0]), chunks);
+    UT_CF_Chunk_SetupSlab(1);
+    CF_ChunkListInit(&clist, 5, blocks, &UT_CF_Chunk_Slab);
 
     UtPrintf("Initial chunk list state for reference");
     UT_CF_Chunk_SetupFull(&clist);
@@ -180,10 +194,10 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 2, 1)); /* 2-3 */
     UT_CF_Chunk_Print(&clist);
     /* Confirm 0 and 1 didn't change */
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 11);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 11);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 2);
     UtAssert_UINT32_EQ(clist.count, 5);
 
     UT_CF_Chunk_SetupFull(&clist);
@@ -191,10 +205,10 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 2, 2)); /* 2-4 */
     UT_CF_Chunk_Print(&clist);
     /* Confirm 0 replaced and 1 didn't change */
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 2);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 11);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 11);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 2);
     UtAssert_UINT32_EQ(clist.count, 5);
 
     UT_CF_Chunk_SetupFull(&clist);
@@ -202,12 +216,12 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 10, 1)); /* 10-11 */
     UT_CF_Chunk_Print(&clist);
     /* 0 and 2 unchanged, 1 combined */
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 10);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 3);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 23);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 3);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 3);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 23);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 3);
     UtAssert_UINT32_EQ(clist.count, 5);
 
     UT_CF_Chunk_SetupFull(&clist);
@@ -215,12 +229,12 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 20, 21)); /* 20-41 */
     UT_CF_Chunk_Print(&clist);
     /* 1 unchanged, 2 combined, 4 in slot 3 */
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 11);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 21);
-    UtAssert_UINT32_EQ(clist.chunks[3].offset, 50);
-    UtAssert_UINT32_EQ(clist.chunks[3].size, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 11);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 21);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 3)->offset, 50);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 3)->size, 5);
     UtAssert_UINT32_EQ(clist.count, 4);
 
     UT_CF_Chunk_SetupFull(&clist);
@@ -228,12 +242,12 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 12, 25)); /* 12-37 */
     UT_CF_Chunk_Print(&clist);
     /* 0 unchanged, 1 combined, 4 in slot 2 */
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 0);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 1);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 11);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 29);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 50);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 11);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 29);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 50);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 5);
     UtAssert_UINT32_EQ(clist.count, 3);
 
     UT_CF_Chunk_SetupFull(&clist);
@@ -241,22 +255,23 @@ void Test_CF_Chunk_Combine(void)
     UtAssert_VOIDCALL(CF_ChunkListAdd(&clist, 37, 2)); /* 37-39 */
     UT_CF_Chunk_Print(&clist);
     /* 1, 2, and 3 unchanged */
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 11);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 2);
-    UtAssert_UINT32_EQ(clist.chunks[2].offset, 23);
-    UtAssert_UINT32_EQ(clist.chunks[2].size, 3);
-    UtAssert_UINT32_EQ(clist.chunks[3].offset, 36);
-    UtAssert_UINT32_EQ(clist.chunks[3].size, 4);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 11);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->offset, 23);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 2)->size, 3);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 3)->offset, 36);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 3)->size, 4);
     UtAssert_UINT32_EQ(clist.count, 5);
 }
 
 void Test_CF_Chunk_GetRmFirst(void)
 {
     CF_ChunkList_t clist;
-    CF_Chunk_t     chunks[2];
+    CF_Chunk_t    *blocks[CF_CHUNK_BLOCKS_FOR(2)];
 
     /* Initialize list (note already tested) */
-    CF_ChunkListInit(&clist, sizeof(chunks) / sizeof(chunks[0]), chunks);
+    UT_CF_Chunk_SetupSlab(1);
+    CF_ChunkListInit(&clist, 2, blocks, &UT_CF_Chunk_Slab);
 
     /* Get first with empty list */
     UtAssert_ADDRESS_EQ(CF_ChunkList_GetFirstChunk(&clist), NULL);
@@ -268,38 +283,39 @@ void Test_CF_Chunk_GetRmFirst(void)
     CF_ChunkListAdd(&clist, 20, 10);
 
     /* Get first with non-empty list */
-    UtAssert_ADDRESS_EQ(CF_ChunkList_GetFirstChunk(&clist), chunks);
+    UtAssert_ADDRESS_EQ(CF_ChunkList_GetFirstChunk(&clist), CF_ChunkList_At(&clist, 0));
 
     /* Remove part from first non-empty list */
     UtAssert_VOIDCALL(CF_ChunkList_RemoveFromFirst(&clist, 5));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 5);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 5);
-    UtAssert_UINT32_EQ(clist.chunks[1].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[1].size, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 1)->size, 10);
     UtAssert_UINT32_EQ(clist.count, 2);
 
     /* Remove the rest of first from non-empty list */
     UtAssert_VOIDCALL(CF_ChunkList_RemoveFromFirst(&clist, 5));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 10);
     UtAssert_UINT32_EQ(clist.count, 1);
 
     /* Add back in, do large remove, confirm only first chunk removed */
     CF_ChunkListAdd(&clist, 0, 10);
     UtAssert_VOIDCALL(CF_ChunkList_RemoveFromFirst(&clist, 50));
-    UtAssert_UINT32_EQ(clist.chunks[0].offset, 20);
-    UtAssert_UINT32_EQ(clist.chunks[0].size, 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->offset, 20);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&clist, 0)->size, 10);
     UtAssert_UINT32_EQ(clist.count, 1);
 }
 
 void Test_CF_Chunk_ComputeGaps(void)
 {
     CF_ChunkList_t clist;
-    CF_Chunk_t     chunks[5];
+    CF_Chunk_t    *blocks[CF_CHUNK_BLOCKS_FOR(5)];
     CF_ChunkSize_t total;
 
     /* Initialize list (note already tested) */
-    CF_ChunkListInit(&clist, sizeof(chunks) / sizeof(chunks[0]), chunks);
+    UT_CF_Chunk_SetupSlab(1);
+    CF_ChunkListInit(&clist, 5, blocks, &UT_CF_Chunk_Slab);
 
     /* Zero byte file */
     UtAssert_UINT32_EQ(CF_ChunkList_ComputeGaps(&clist, TEST_CF_MAX_GAPS, 0, 0, NULL, NULL), 0);
@@ -355,6 +371,93 @@ void Test_CF_Chunk_ComputeGaps(void)
     UtAssert_UINT32_EQ(Test_CF_compute_gap_context.count, 3);
 }
 
+/* Cover growing from the slab, the per-list cap, the reserved blocks and returning blocks on reset */
+void Test_CF_Chunk_SlabGrowReset(void)
+{
+    CF_ChunkList_t big;
+    CF_ChunkList_t small;
+    CF_ChunkList_t extra;
+    CF_Chunk_t    *big_blocks[CF_CHUNK_BLOCKS_FOR(3 * CF_CHUNK_BLOCK_SIZE)];
+    CF_Chunk_t    *small_blocks[CF_CHUNK_BLOCKS_FOR(2)];
+    CF_Chunk_t    *extra_blocks[CF_CHUNK_BLOCKS_FOR(2)];
+    CF_ChunkIdx_t  i;
+
+    /* two lists may be in use, the third one below is one too many */
+    UT_CF_Chunk_SetupSlab(2);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_blocks, UT_CF_CHUNK_SLAB_BLOCKS);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_free, UT_CF_CHUNK_SLAB_BLOCKS);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_reserved, 2);
+    UtAssert_ADDRESS_EQ(UT_CF_Chunk_FreeBlocks[1], &UT_CF_Chunk_BlockMem[CF_CHUNK_BLOCK_SIZE]);
+
+    CF_ChunkListInit(&big, 3 * CF_CHUNK_BLOCK_SIZE, big_blocks, &UT_CF_Chunk_Slab);
+    CF_ChunkListInit(&small, 2, small_blocks, &UT_CF_Chunk_Slab);
+    CF_ChunkListInit(&extra, 2, extra_blocks, &UT_CF_Chunk_Slab);
+
+    /* Nothing is taken from the slab until the first chunk is added */
+    UtAssert_UINT32_EQ(CF_Chunks_Capacity(&big), 0);
+
+    /* Fill the first block, then one more chunk takes a second block */
+    for (i = 0; i <= CF_CHUNK_BLOCK_SIZE; ++i)
+    {
+        CF_ChunkListAdd(&big, i * 10, 1);
+    }
+    UtAssert_UINT32_EQ(big.count, CF_CHUNK_BLOCK_SIZE + 1);
+    UtAssert_UINT32_EQ(big.num_blocks, 2);
+    UtAssert_UINT32_EQ(CF_Chunks_Capacity(&big), 2 * CF_CHUNK_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_free, 1);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_lists, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&big, CF_CHUNK_BLOCK_SIZE)->offset, CF_CHUNK_BLOCK_SIZE * 10);
+
+    /* Insert at the front shifts entries across the block boundary */
+    CF_ChunkListAdd(&big, 5, 1);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&big, 1)->offset, 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&big, CF_CHUNK_BLOCK_SIZE + 1)->offset, CF_CHUNK_BLOCK_SIZE * 10);
+
+    /* The last free block is reserved for the small list, so the big one stops below its cap */
+    for (i = CF_CHUNK_BLOCK_SIZE + 2; i < 2 * CF_CHUNK_BLOCK_SIZE; ++i)
+    {
+        CF_ChunkListAdd(&big, i * 10, 1);
+    }
+    UtAssert_UINT32_EQ(big.count, 2 * CF_CHUNK_BLOCK_SIZE);
+    UtAssert_ZERO(UT_CF_Chunk_Slab.grow_fails);
+    UtAssert_BOOL_FALSE(CF_Chunks_Grow(&big));
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.grow_fails, 1);
+    UtAssert_UINT32_EQ(big.num_blocks, 2);
+
+    /* and the small list still records its first chunk */
+    CF_ChunkListAdd(&small, 0, 10);
+    UtAssert_UINT32_EQ(small.count, 1);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_free, 0);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_lists, 2);
+
+    /* A list beyond the reserve holding no blocks drops the chunk */
+    UtAssert_VOIDCALL(CF_ChunkListAdd(&extra, 0, 10));
+    UtAssert_UINT32_EQ(extra.count, 0);
+    UtAssert_ADDRESS_EQ(CF_ChunkList_GetFirstChunk(&extra), NULL);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.grow_fails, 2);
+
+    /* Reset returns the blocks, and the small list can now grow up to its cap */
+    UtAssert_VOIDCALL(CF_ChunkListReset(&big));
+    UtAssert_UINT32_EQ(big.count, 0);
+    UtAssert_UINT32_EQ(big.num_blocks, 0);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_free, 2);
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_lists, 1);
+
+    CF_ChunkListAdd(&small, 20, 1);
+    CF_ChunkListAdd(&small, 30, 2);
+    UtAssert_UINT32_EQ(small.count, 2);
+    UtAssert_UINT32_EQ(small.num_blocks, 1);
+    UtAssert_UINT32_EQ(CF_Chunks_Capacity(&small), 2);
+    UtAssert_UINT32_EQ(CF_ChunkList_At(&small, 1)->offset, 30);
+
+    /* a list at its cap is not counted as a failure to grow */
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.grow_fails, 2);
+
+    UtAssert_VOIDCALL(CF_ChunkListReset(&small));
+    UtAssert_UINT32_EQ(UT_CF_Chunk_Slab.num_free, UT_CF_CHUNK_SLAB_BLOCKS);
+    UtAssert_ZERO(UT_CF_Chunk_Slab.num_lists);
+}
+
 /* Add tests */
 void UtTest_Setup(void)
 {
@@ -363,4 +466,5 @@ void UtTest_Setup(void)
     TEST_CF_ADD(Test_CF_Chunk_Combine);
     TEST_CF_ADD(Test_CF_Chunk_GetRmFirst);
     TEST_CF_ADD(Test_CF_Chunk_ComputeGaps);
+    TEST_CF_ADD(Test_CF_Chunk_SlabGrowReset);
 }
@@ -20,6 +20,7 @@
 /* cf testing includes */
 #include "cf_test_utils.h"
 #include "cf_cmd.h"
+#include "cf_spill.h"
 #include "cf_eventids.h"
 #include "cf_test_alt_handler.h"
 
@@ -148,7 +149,7 @@ void Test_CF_NoopCmd_SendNoopEventAndAcceptCommand(void)
 **
 *******************************************************************************/
 
-void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand(void)
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_7_SendEventAndRejectCommand(void)
 {
     /* Arrange */
     CF_ResetCountersCmd_t   utbuf;
@@ -157,7 +158,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCo
 
     memset(&utbuf, 0, sizeof(utbuf));
 
-    data->byte[0] = 5; /* 5 is size of 'names' */
+    data->byte[0] = 7; /* 7 is size of 'names' */
 
     CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
 
@@ -171,7 +172,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCo
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, (initial_hk_err_counter + 1) & 0xFFFF);
 }
 
-void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand(void)
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_7_SendEventAndRejectCommand(void)
 {
     /* Arrange */
     CF_ResetCountersCmd_t   utbuf;
@@ -180,7 +181,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndR
 
     memset(&utbuf, 0, sizeof(utbuf));
 
-    data->byte[0] = Any_uint8_GreaterThan(5); /* 5 is size of 'names' */
+    data->byte[0] = Any_uint8_GreaterThan(7); /* 7 is size of 'names' */
 
     CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
 
@@ -367,6 +368,56 @@ void Test_CF_ResetCountersCmd_tests_SWhenCommandByteIs_down_AndResetAllHkSentCou
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
 }
 
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetDiagHistogramsSendEventAndAcceptCommand(void)
+{
+    /* Arrange */
+    CF_ResetCountersCmd_t   utbuf;
+    CF_UnionArgs_Payload_t *data                   = &utbuf.Payload;
+    uint16                  initial_hk_cmd_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+
+    data->byte[0] = CF_Reset_diag;
+
+    CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
+
+    /* Act */
+    CF_ResetCountersCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_RESET_INF_EID);
+    UtAssert_STUB_COUNT(CF_Diag_Reset, 1);
+    UtAssert_STUB_COUNT(CF_Peer_Reset, 0);
+    /* Assert to show counter incremented */
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
+}
+
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_peer_ResetPeerStatsSendEventAndAcceptCommand(void)
+{
+    /* Arrange */
+    CF_ResetCountersCmd_t   utbuf;
+    CF_UnionArgs_Payload_t *data                   = &utbuf.Payload;
+    uint16                  initial_hk_cmd_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+
+    data->byte[0] = CF_Reset_peer;
+
+    CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
+
+    /* Act */
+    CF_ResetCountersCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_RESET_INF_EID);
+    UtAssert_STUB_COUNT(CF_Peer_Reset, 1);
+    UtAssert_STUB_COUNT(CF_Diag_Reset, 0);
+    /* Assert to show counter incremented */
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
+}
+
 void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSendEvent(void)
 {
     /* Arrange */
@@ -419,6 +470,8 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSe
     /* Assert */
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
     UT_CF_AssertEventID(CF_RESET_INF_EID);
+    UtAssert_STUB_COUNT(CF_Diag_Reset, 1);
+    UtAssert_STUB_COUNT(CF_Peer_Reset, 1);
 
     UtAssert_ZERO(CF_AppData.hk.Payload.counters.cmd);
     UtAssert_ZERO(CF_AppData.hk.Payload.counters.err);
@@ -511,13 +564,21 @@ void Test_CF_TxFileCmd(void)
     UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
 
+    /* out of range arguments: bad compress */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->compress = CF_Compress_NUM;
+    UtAssert_VOIDCALL(CF_TxFileCmd(&utbuf));
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+
     /* CF_CFDP_TxFile fails*/
     UT_CF_ResetEventCapture();
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxFile), -1);
     memset(msg, 0, sizeof(*msg));
     UtAssert_VOIDCALL(CF_TxFileCmd(&utbuf));
     UT_CF_AssertEventID(CF_CMD_TX_FILE_ERR_EID);
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 6);
 }
 
 /*******************************************************************************
@@ -577,13 +638,21 @@ void Test_CF_PlaybackDirCmd(void)
     UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
 
+    /* out of range arguments: bad compress */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->compress = CF_Compress_NUM;
+    UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+
     /* CF_CFDP_PlaybackDir fails*/
     UT_CF_ResetEventCapture();
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_PlaybackDir), -1);
     memset(msg, 0, sizeof(*msg));
     UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
     UT_CF_AssertEventID(CF_CMD_PLAYBACK_DIR_ERR_EID);
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 6);
 }
 
 /*******************************************************************************
@@ -1143,6 +1212,49 @@ void Test_CF_TsnChanAction_cmd_chan_Eq_CF_COMPOUND_KEY_TransactionFoundRun_fn_An
     UtAssert_ADDRESS_EQ(context_CF_TsnChanAction_fn_t.context, arg_context);
 }
 
+void Test_CF_TsnChanAction_cmd_chan_Eq_CF_COMPOUND_KEY_TransactionSpilledReloadRun_fn(void)
+{
+    /* Arrange */
+    CF_Transaction_Payload_t        utbuf;
+    CF_Transaction_Payload_t       *arg_cmd = &utbuf;
+    CF_TsnChanAction_fn_t           arg_fn  = &Dummy_CF_TsnChanAction_fn_t;
+    int                             context;
+    void                           *arg_context = &context;
+    CF_Transaction_t                txn;
+    CF_SpillEntry_t                 spilled;
+    CF_TsnChanAction_fn_t_context_t context_CF_TsnChanAction_fn_t;
+
+    memset(&utbuf, 0, sizeof(utbuf));
+    memset(&spilled, 0, sizeof(spilled));
+
+    arg_cmd->chan = CF_COMPOUND_KEY;
+
+    UT_SetDataBuffer(UT_KEY(Dummy_CF_TsnChanAction_fn_t),
+                     &context_CF_TsnChanAction_fn_t,
+                     sizeof(context_CF_TsnChanAction_fn_t),
+                     false);
+
+    /* not in memory, but found in the spill index of the first channel */
+    UT_SetHandlerFunction(UT_KEY(CF_Spill_Find), UT_AltHandler_GenericPointerReturn, &spilled);
+    UT_SetHandlerFunction(UT_KEY(CF_Spill_Reload), UT_AltHandler_GenericPointerReturn, &txn);
+
+    /* Act */
+    UtAssert_INT32_EQ(CF_TsnChanAction(arg_cmd, "", arg_fn, arg_context), 1);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_STUB_COUNT(CF_Spill_Find, 1);
+    UtAssert_STUB_COUNT(CF_Spill_Reload, 1);
+    UtAssert_STUB_COUNT(Dummy_CF_TsnChanAction_fn_t, 1);
+    UtAssert_ADDRESS_EQ(context_CF_TsnChanAction_fn_t.txn, &txn);
+
+    /* spilled, but cannot be reloaded */
+    UT_ResetState(UT_KEY(CF_Spill_Reload));
+    UtAssert_INT32_EQ(CF_TsnChanAction(arg_cmd, "", arg_fn, arg_context), -1);
+    UT_CF_AssertEventID(CF_CMD_TRANS_NOT_FOUND_ERR_EID);
+    UtAssert_STUB_COUNT(Dummy_CF_TsnChanAction_fn_t, 1);
+}
+
 void Test_CF_TsnChanAction_cmd_chan_Eq_CF_ALL_CHANNELS_Return_CF_TraverseAllTransactions_All_Channels(void)
 {
     /* Arrange */
@@ -1174,6 +1286,7 @@ void Test_CF_TsnChanAction_cmd_chan_Eq_CF_ALL_CHANNELS_Return_CF_TraverseAllTran
 
     /* Assert */
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_STUB_COUNT(CF_Spill_ReloadAll, CF_NUM_CHANNELS);
 }
 
 void Test_CF_TsnChanAction_cmd_chan_IsASingleChannel(void)
@@ -1192,6 +1305,7 @@ void Test_CF_TsnChanAction_cmd_chan_IsASingleChannel(void)
     /* Assert */
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
     UtAssert_STUB_COUNT(CF_TraverseAllTransactions, 1);
+    UtAssert_STUB_COUNT(CF_Spill_ReloadAll, 1);
 }
 
 void Test_CF_TsnChanAction_cmd_FailBecause_cmd_chan_IsInvalid(void)
@@ -2394,6 +2508,62 @@ void Test_CF_WriteQueueCmd_WhenUpAndPendingQueueSendEventAndRejectCommand(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, (initial_hk_err_counter + 1) & 0xFFFF);
 }
 
+void Test_CF_WriteQueueCmd_WhenUnknownFormatSendEventAndRejectCommand(void)
+{
+    /* Arrange */
+    CF_WriteQueueCmd_t       utbuf;
+    CF_WriteQueue_Payload_t *wq                     = &utbuf.Payload;
+    uint16                   initial_hk_err_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+
+    wq->chan   = Any_uint8_LessThan(CF_NUM_CHANNELS);
+    wq->type   = CF_Type_all;
+    wq->queue  = CF_Queue_all;
+    wq->format = CF_Format_binary + 1;
+
+    CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
+
+    /* Act */
+    CF_WriteQueueCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_CMD_WQ_ARGS_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_Dump_Start, 0);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, (initial_hk_err_counter + 1) & 0xFFFF);
+}
+
+void Test_CF_WriteQueueCmd_BinaryStartsDump(void)
+{
+    /* Arrange */
+    CF_WriteQueueCmd_t       utbuf;
+    CF_WriteQueue_Payload_t *wq                     = &utbuf.Payload;
+    uint16                   initial_hk_cmd_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+
+    wq->chan   = Any_uint8_LessThan(CF_NUM_CHANNELS);
+    wq->type   = CF_Type_all;
+    wq->queue  = CF_Queue_all;
+    wq->format = CF_Format_binary;
+
+    CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
+
+    /* Act */
+    CF_WriteQueueCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_Dump_Start, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_WriteTxnQueueDataToFile, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* the command counter follows when the dump completes */
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, initial_hk_cmd_counter);
+}
+
 void Test_CF_WriteQueueCmd_When_CF_WrappedCreat_Fails_type_Is_type_up_And_queue_IsNot_q_pend_SendEventAndRejectCommand(
     void)
 {
@@ -3800,6 +3970,8 @@ void Test_CF_SendHkCmd(void)
     /* Assert */
     UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
     UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+    UtAssert_STUB_COUNT(CF_Diag_Send, 1);
+    UtAssert_STUB_COUNT(CF_Peer_Send, 1);
 }
 
 /*******************************************************************************
@@ -3818,6 +3990,10 @@ void Test_CF_WakeupCmd(void)
 
     /* Assert */
     UtAssert_STUB_COUNT(CF_CFDP_CycleEngine, 1);
+    UtAssert_STUB_COUNT(CF_Dump_Run, 1);
+    UtAssert_STUB_COUNT(CF_EvLim_Tick, 1);
+    UtAssert_STUB_COUNT(CF_Capture_Tick, 1);
+    UtAssert_STUB_COUNT(CF_Shm_Publish, 1);
 }
 
 /*******************************************************************************
@@ -3836,14 +4012,14 @@ void add_CF_NoopCmd_tests(void)
 
 void add_CF_ResetCountersCmd_tests(void)
 {
-    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand,
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_7_SendEventAndRejectCommand,
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
-               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand");
-    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand,
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_7_SendEventAndRejectCommand");
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_7_SendEventAndRejectCommand,
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
-               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand");
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_7_SendEventAndRejectCommand");
     UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_command_AndResetHkCmdAndErrCountSendEvent,
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
@@ -3860,6 +4036,14 @@ void add_CF_ResetCountersCmd_tests(void)
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
                "Test_CF_ResetCountersCmd_tests_SWhenCommandByteIs_down_AndResetAllHkSentCountendEventAcceptCommand");
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetDiagHistogramsSendEventAndAcceptCommand,
+               cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown,
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetDiagHistogramsSendEventAndAcceptCommand");
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_peer_ResetPeerStatsSendEventAndAcceptCommand,
+               cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown,
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_peer_ResetPeerStatsSendEventAndAcceptCommand");
     UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSendEvent,
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
@@ -3962,6 +4146,10 @@ void add_CF_TsnChanAction_tests(void)
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
                "Test_CF_TsnChanAction_cmd_chan_Eq_CF_COMPOUND_KEY_TransactionFoundRun_fn_AndReturn_CFE_SUCCESS");
+    UtTest_Add(Test_CF_TsnChanAction_cmd_chan_Eq_CF_COMPOUND_KEY_TransactionSpilledReloadRun_fn,
+               cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown,
+               "Test_CF_TsnChanAction_cmd_chan_Eq_CF_COMPOUND_KEY_TransactionSpilledReloadRun_fn");
     UtTest_Add(Test_CF_TsnChanAction_cmd_chan_Eq_CF_ALL_CHANNELS_Return_CF_TraverseAllTransactions_All_Channels,
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
@@ -4177,6 +4365,14 @@ void add_CF_WriteQueueCmd_tests(void)
                cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
                "Test_CF_WriteQueueCmd_WhenUpAndPendingQueueSendEventAndRejectCommand");
+    UtTest_Add(Test_CF_WriteQueueCmd_WhenUnknownFormatSendEventAndRejectCommand,
+               cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown,
+               "Test_CF_WriteQueueCmd_WhenUnknownFormatSendEventAndRejectCommand");
+    UtTest_Add(Test_CF_WriteQueueCmd_BinaryStartsDump,
+               cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown,
+               "Test_CF_WriteQueueCmd_BinaryStartsDump");
     UtTest_Add(
         Test_CF_WriteQueueCmd_When_CF_WrappedCreat_Fails_type_Is_type_up_And_queue_IsNot_q_pend_SendEventAndRejectCommand,
         cf_cmd_tests_Setup,
@@ -0,0 +1,479 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_test_files.h"
+#include "cf_compress.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+/* a text block, a block that does not compress and a short last block */
+#define UT_CF_COMPRESS_SRC_LEN (2 * CF_COMPRESS_BLOCK_SIZE + 808)
+
+static CF_ConfigTable_t      UT_CF_Compress_Config;
+static CF_History_t          UT_CF_Compress_Hist;
+static CF_Transaction_t      UT_CF_Compress_Txn;
+
+/* creates the file to compress */
+static UT_CF_File_t *UT_CF_Compress_MakeSource(void)
+{
+    UT_CF_File_t *file = UT_CF_File_Make("/ut/src", "");
+    uint32        seed = 12345;
+    size_t        i;
+
+    for (i = 0; i < CF_COMPRESS_BLOCK_SIZE; i += 32)
+    {
+        snprintf((char *)&file->data[i], 33, "housekeeping record %011lu\n", (unsigned long)i);
+    }
+    for (; i < 2 * CF_COMPRESS_BLOCK_SIZE; ++i)
+    {
+        seed          = (seed * 1103515245) + 12345;
+        file->data[i] = seed >> 16;
+    }
+    memset(&file->data[i], 0, UT_CF_COMPRESS_SRC_LEN - i);
+    file->len = UT_CF_COMPRESS_SRC_LEN;
+
+    return file;
+}
+
+/*******************************************************************************
+**
+**  cf_compress_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_compress_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Compress_Config, 0, sizeof(UT_CF_Compress_Config));
+
+    strcpy(UT_CF_Compress_Config.tmp_dir, "/ut/tmp");
+    CF_AppData.config_table = &UT_CF_Compress_Config;
+
+    /* the compressed copy is "/ut/tmp/12_34.z", the decompressed one "/ut/tmp/12_34.raw" */
+    memset(&UT_CF_Compress_Hist, 0, sizeof(UT_CF_Compress_Hist));
+    memset(&UT_CF_Compress_Txn, 0, sizeof(UT_CF_Compress_Txn));
+    strcpy(UT_CF_Compress_Hist.fnames.src_filename, "/ut/src");
+    UT_CF_Compress_Hist.src_eid  = 12;
+    UT_CF_Compress_Hist.seq_num  = 34;
+    UT_CF_Compress_Txn.history   = &UT_CF_Compress_Hist;
+    UT_CF_Compress_Txn.compress  = CF_Compress_LZ4;
+    UT_CF_Compress_Txn.fd        = OS_OBJECT_ID_UNDEFINED;
+
+    UT_CF_Files_Setup();
+}
+
+void cf_compress_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Compress_SetMd(void)
+{
+    /* Test case for:
+     * void CF_Compress_SetMd(CF_Logical_PduMd_t *md, uint8 method);
+     */
+    CF_Logical_PduMd_t md;
+    const uint8       *msg;
+
+    /* nothing to announce */
+    memset(&md, 0, sizeof(md));
+    UtAssert_VOIDCALL(CF_Compress_SetMd(&md, CF_Compress_NONE));
+    UtAssert_ZERO(md.tlv_list.num_tlv);
+    UtAssert_VOIDCALL(CF_Compress_SetMd(&md, CF_Compress_NUM));
+    UtAssert_ZERO(md.tlv_list.num_tlv);
+
+    /* nominal */
+    UtAssert_VOIDCALL(CF_Compress_SetMd(&md, CF_Compress_LZ4));
+    UtAssert_UINT32_EQ(md.tlv_list.num_tlv, 1);
+    UtAssert_UINT32_EQ(md.tlv_list.tlv[0].type, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+    UtAssert_UINT32_EQ(md.tlv_list.tlv[0].length, CF_COMPRESS_MSG_LEN);
+    msg = md.tlv_list.tlv[0].data.data_ptr;
+    UtAssert_MemCmp(msg, "CFZ", 3, "message prefix");
+    UtAssert_UINT8_EQ(msg[3], CF_Compress_LZ4);
+
+    /* the TLV list is full */
+    md.tlv_list.num_tlv = CF_PDU_MAX_TLV;
+    UtAssert_VOIDCALL(CF_Compress_SetMd(&md, CF_Compress_LZ4));
+    UtAssert_UINT32_EQ(md.tlv_list.num_tlv, CF_PDU_MAX_TLV);
+}
+
+void Test_CF_Compress_GetMd(void)
+{
+    /* Test case for:
+     * uint8 CF_Compress_GetMd(const CF_Logical_PduMd_t *md);
+     */
+    CF_Logical_PduMd_t md;
+    static const uint8 other[CF_COMPRESS_MSG_LEN] = {'A', 'B', 'C', 1};
+
+    /* no TLV */
+    memset(&md, 0, sizeof(md));
+    UtAssert_UINT8_EQ(CF_Compress_GetMd(&md), CF_Compress_NONE);
+
+    /* messages to user that are not for CF, and another TLV type */
+    md.tlv_list.num_tlv              = 2;
+    md.tlv_list.tlv[0].type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+    md.tlv_list.tlv[0].length        = CF_COMPRESS_MSG_LEN;
+    md.tlv_list.tlv[0].data.data_ptr = other;
+    md.tlv_list.tlv[1].type          = CF_CFDP_TLV_TYPE_ENTITY_ID;
+    md.tlv_list.tlv[1].length        = CF_COMPRESS_MSG_LEN;
+    md.tlv_list.tlv[1].data.data_ptr = other;
+    UtAssert_UINT8_EQ(CF_Compress_GetMd(&md), CF_Compress_NONE);
+
+    /* nominal, as added by CF_Compress_SetMd() */
+    CF_Compress_SetMd(&md, CF_Compress_LZ4);
+    UtAssert_UINT8_EQ(CF_Compress_GetMd(&md), CF_Compress_LZ4);
+}
+
+void Test_CF_Compress_GetTempName(void)
+{
+    /* Test case for:
+     * void CF_Compress_GetTempName(const CF_History_t *hist, const char *suffix, char *buf, size_t buf_size);
+     */
+    CF_History_t hist;
+    char         buf[CF_FILENAME_MAX_LEN];
+
+    memset(&hist, 0, sizeof(hist));
+    hist.src_eid = 12;
+    hist.seq_num = 34;
+
+    UtAssert_VOIDCALL(CF_Compress_GetTempName(&hist, CF_COMPRESS_TX_SUFFIX, buf, sizeof(buf)));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/ut/tmp/12_34.z", -1);
+    UtAssert_VOIDCALL(CF_Compress_GetTempName(&hist, CF_COMPRESS_RX_SUFFIX, buf, sizeof(buf)));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/ut/tmp/12_34.raw", -1);
+}
+
+/* compresses the source file, returns the number of wakeups it took or 0 on failure */
+static uint32 UT_CF_Compress_RunFile(void)
+{
+    uint32 wakeups = 1;
+
+    if (CF_Compress_FileStart(&UT_CF_Compress_Txn) != CFE_SUCCESS)
+    {
+        return 0;
+    }
+
+    while (!CF_Compress_FileStep(&UT_CF_Compress_Txn))
+    {
+        ++wakeups;
+    }
+
+    return wakeups;
+}
+
+/* decompresses the compressed copy, returns the number of wakeups it took or 0 on failure */
+static uint32 UT_CF_Compress_RunExpand(void)
+{
+    uint32 wakeups = 1;
+
+    /* the received file is open from the start of the transaction */
+    CF_WrappedOpenCreate(&UT_CF_Compress_Txn.fd, "/ut/tmp/12_34.z", OS_FILE_FLAG_NONE, OS_READ_WRITE);
+    if (CF_Compress_ExpandStart(&UT_CF_Compress_Txn) != CFE_SUCCESS)
+    {
+        return 0;
+    }
+
+    while (!CF_Compress_ExpandStep(&UT_CF_Compress_Txn))
+    {
+        ++wakeups;
+    }
+
+    return wakeups;
+}
+
+void Test_CF_Compress_FileStart(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Compress_FileStart(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = &UT_CF_Compress_Txn;
+    UT_CF_File_t     *zip;
+
+    /* nominal, the header is a placeholder until the file is done */
+    UT_CF_Compress_MakeSource();
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CFE_SUCCESS);
+    zip = UT_CF_File_Find("/ut/tmp/12_34.z");
+    UtAssert_NOT_NULL(zip);
+    UtAssert_UINT32_EQ(zip->len, sizeof(CF_CompressHeader_t));
+    UtAssert_ZERO(zip->data[0]);
+    UtAssert_BOOL_TRUE(OS_ObjectIdDefined(txn->fd));
+    UtAssert_ZERO(txn->state_data.codec_pos);
+    UtAssert_UINT32_EQ(txn->state_data.codec_size, UT_CF_COMPRESS_SRC_LEN);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 0);
+
+    /* unknown method */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    txn->compress = CF_Compress_NONE;
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_COMPRESS_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the file does not exist */
+    cf_compress_tests_Setup();
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_COMPRESS_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the size cannot be found */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the compressed file cannot be created */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 2, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_COMPRESS_ERR_EID);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the header cannot be written */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_Compress_FileStart(txn), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+}
+
+void Test_CF_Compress_FileStep(void)
+{
+    /* Test case for:
+     * bool CF_Compress_FileStep(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = &UT_CF_Compress_Txn;
+    UT_CF_File_t     *src;
+    UT_CF_File_t     *zip;
+    UT_CF_File_t     *raw;
+
+    /* nominal, all 3 blocks fit in one wakeup, then back again */
+    src = UT_CF_Compress_MakeSource();
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunFile(), 1);
+    zip = UT_CF_File_Find("/ut/tmp/12_34.z");
+    UtAssert_MemCmp(zip->data, "CFZ1", 4, "magic");
+    UtAssert_UINT8_EQ(zip->data[4], CF_Compress_LZ4);
+    UtAssert_UINT8_EQ(zip->data[10], UT_CF_COMPRESS_SRC_LEN >> 8);
+    UtAssert_UINT8_EQ(zip->data[11], UT_CF_COMPRESS_SRC_LEN & 0xFF);
+    UtAssert_UINT32_LT(zip->len, UT_CF_COMPRESS_SRC_LEN - (CF_COMPRESS_BLOCK_SIZE / 2));
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 0);
+
+    /* the random block is stored as it is */
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    raw = UT_CF_File_Find("/ut/tmp/12_34.raw");
+    UtAssert_NOT_NULL(raw);
+    UtAssert_UINT32_EQ(raw->len, UT_CF_COMPRESS_SRC_LEN);
+    UtAssert_MemCmp(raw->data, src->data, UT_CF_COMPRESS_SRC_LEN, "round trip");
+
+    /* once the budget is spent, one block per wakeup */
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_BudgetSpent), true);
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunFile(), 3);
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 4);
+    UtAssert_MemCmp(raw->data, src->data, UT_CF_COMPRESS_SRC_LEN, "round trip, a block per wakeup");
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 0);
+    UT_ResetState(UT_KEY(CF_CFDP_BudgetSpent));
+
+    /* an empty file is only a header */
+    src->len = 0;
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunFile(), 1);
+    UtAssert_UINT32_EQ(zip->len, sizeof(CF_CompressHeader_t));
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    UtAssert_ZERO(raw->len);
+
+    /* the file got shorter since it was started */
+    cf_compress_tests_Setup();
+    src = UT_CF_Compress_MakeSource();
+    CF_Compress_FileStart(txn);
+    src->len = CF_COMPRESS_BLOCK_SIZE;
+    UtAssert_BOOL_TRUE(CF_Compress_FileStep(txn));
+    UT_CF_AssertEventID(CF_COMPRESS_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+
+    /* the file cannot be opened again */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    CF_Compress_FileStart(txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_BOOL_TRUE(CF_Compress_FileStep(txn));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+
+    /* write error */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    CF_Compress_FileStart(txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_BOOL_TRUE(CF_Compress_FileStep(txn));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the header cannot be rewritten */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    CF_Compress_FileStart(txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, -1);
+    UtAssert_BOOL_TRUE(CF_Compress_FileStep(txn));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+}
+
+void Test_CF_Compress_ExpandStart(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Compress_ExpandStart(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = &UT_CF_Compress_Txn;
+
+    /* nominal */
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    CF_WrappedOpenCreate(&txn->fd, "/ut/tmp/12_34.z", OS_FILE_FLAG_NONE, OS_READ_WRITE);
+    UtAssert_INT32_EQ(CF_Compress_ExpandStart(txn), CFE_SUCCESS);
+    UtAssert_NOT_NULL(UT_CF_File_Find("/ut/tmp/12_34.raw"));
+    UtAssert_ZERO(txn->state_data.codec_pos);
+    UtAssert_UINT32_EQ(txn->state_data.codec_size, UT_CF_COMPRESS_SRC_LEN);
+
+    /* the decompressed file cannot be created */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Compress_ExpandStart(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_DECOMPRESS_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* not a compressed file */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    CF_WrappedOpenCreate(&txn->fd, "/ut/src", OS_FILE_FLAG_NONE, OS_READ_WRITE);
+    UtAssert_INT32_EQ(CF_Compress_ExpandStart(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_DECOMPRESS_ERR_EID);
+    UtAssert_NULL(UT_CF_File_Find("/ut/tmp/12_34.raw"));
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+}
+
+void Test_CF_Compress_ExpandStep(void)
+{
+    /* Test case for:
+     * bool CF_Compress_ExpandStep(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = &UT_CF_Compress_Txn;
+    UT_CF_File_t     *zip;
+
+    /* the file is truncated */
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    zip = UT_CF_File_Find("/ut/tmp/12_34.z");
+    --zip->len;
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    UT_CF_AssertEventID(CF_DECOMPRESS_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* a whole block is missing */
+    zip->len = sizeof(CF_CompressHeader_t);
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 2);
+
+    /* a match before the start of the block */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    zip = UT_CF_File_Find("/ut/tmp/12_34.z");
+    zip->data[sizeof(CF_CompressHeader_t) + 2] = 0x0F;
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    UT_CF_AssertEventID(CF_DECOMPRESS_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* more data than the header says */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    zip = UT_CF_File_Find("/ut/tmp/12_34.z");
+    zip->data[10] = 0;
+    UtAssert_UINT32_EQ(UT_CF_Compress_RunExpand(), 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* the decompressed file cannot be opened again */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    CF_WrappedOpenCreate(&txn->fd, "/ut/tmp/12_34.z", OS_FILE_FLAG_NONE, OS_READ_WRITE);
+    CF_Compress_ExpandStart(txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_BOOL_TRUE(CF_Compress_ExpandStep(txn));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+
+    /* write error */
+    cf_compress_tests_Setup();
+    UT_CF_Compress_MakeSource();
+    UT_CF_Compress_RunFile();
+    CF_WrappedOpenCreate(&txn->fd, "/ut/tmp/12_34.z", OS_FILE_FLAG_NONE, OS_READ_WRITE);
+    CF_Compress_ExpandStart(txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_BOOL_TRUE(CF_Compress_ExpandStep(txn));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SetTxnStatus, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_compress_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Compress_SetMd, cf_compress_tests_Setup, cf_compress_tests_Teardown, "CF_Compress_SetMd");
+    UtTest_Add(Test_CF_Compress_GetMd, cf_compress_tests_Setup, cf_compress_tests_Teardown, "CF_Compress_GetMd");
+    UtTest_Add(Test_CF_Compress_GetTempName,
+               cf_compress_tests_Setup,
+               cf_compress_tests_Teardown,
+               "CF_Compress_GetTempName");
+    UtTest_Add(Test_CF_Compress_FileStart,
+               cf_compress_tests_Setup,
+               cf_compress_tests_Teardown,
+               "CF_Compress_FileStart");
+    UtTest_Add(Test_CF_Compress_FileStep, cf_compress_tests_Setup, cf_compress_tests_Teardown, "CF_Compress_FileStep");
+    UtTest_Add(Test_CF_Compress_ExpandStart,
+               cf_compress_tests_Setup,
+               cf_compress_tests_Teardown,
+               "CF_Compress_ExpandStart");
+    UtTest_Add(Test_CF_Compress_ExpandStep,
+               cf_compress_tests_Setup,
+               cf_compress_tests_Teardown,
+               "CF_Compress_ExpandStep");
+}
@@ -0,0 +1,655 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_test_files.h"
+#include "cf_delta.h"
+#include "cf_cfdp.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+#define UT_CF_DELTA_BLOCK_SIZE 1024
+
+/* two whole blocks and a short last block */
+#define UT_CF_DELTA_SRC_LEN (2 * UT_CF_DELTA_BLOCK_SIZE + 452)
+
+static CF_ConfigTable_t   UT_CF_Delta_Config;
+static CF_Transaction_t   UT_CF_Delta_Txn;
+static CF_History_t       UT_CF_Delta_Hist;
+static CF_ChunkWrapper_t  UT_CF_Delta_Chunks;
+static CF_Chunk_t         UT_CF_Delta_ChunkMem[CF_CHUNK_BLOCK_SIZE];
+static CF_Chunk_t        *UT_CF_Delta_ChunkBlocks[1];
+static CF_ChunkIdx_t      UT_CF_Delta_MaxChunks;
+
+/* creates a file of len bytes of text */
+static UT_CF_File_t *UT_CF_Delta_MakeText(const char *name, size_t len)
+{
+    UT_CF_File_t *file = UT_CF_File_Make(name, "");
+    size_t        i;
+
+    for (i = 0; i < len; ++i)
+    {
+        file->data[i] = 'a' + (i % 26);
+    }
+    file->len = len;
+
+    return file;
+}
+
+/* keeps the chunks in the order they are added, up to UT_CF_Delta_MaxChunks */
+static void UT_CF_Delta_ChunkListAdd(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_ChunkList_t *chunks = UT_Hook_GetArgValueByName(Context, "chunks", CF_ChunkList_t *);
+    CF_Chunk_t     *chunk;
+
+    if (chunks->count < UT_CF_Delta_MaxChunks)
+    {
+        chunk         = CF_ChunkList_At(chunks, chunks->count);
+        chunk->offset = UT_Hook_GetArgValueByName(Context, "offset", CF_ChunkOffset_t);
+        chunk->size   = UT_Hook_GetArgValueByName(Context, "size", CF_ChunkSize_t);
+        ++chunks->count;
+    }
+}
+
+static void UT_CF_Delta_ChunkListReset(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_Hook_GetArgValueByName(Context, "chunks", CF_ChunkList_t *)->count = 0;
+}
+
+/* hashes the file of the transaction, returns the number of wakeups it took or 0 if it is not a delta transfer */
+static uint32 UT_CF_Delta_Scan(void)
+{
+    uint32 wakeups = 1;
+
+    if (!CF_Delta_ScanStart(&UT_CF_Delta_Txn))
+    {
+        return 0;
+    }
+
+    while (!CF_Delta_ScanStep(&UT_CF_Delta_Txn))
+    {
+        ++wakeups;
+    }
+
+    return wakeups;
+}
+
+/* copies the existing file into the temp file, returns the number of wakeups it took */
+static uint32 UT_CF_Delta_Prefill(void)
+{
+    uint32 wakeups = 0;
+
+    UT_CF_Delta_Txn.flags.rx.prefill = true;
+    while (UT_CF_Delta_Txn.flags.rx.prefill)
+    {
+        CF_Delta_PrefillStep(&UT_CF_Delta_Txn);
+        ++wakeups;
+    }
+
+    return wakeups;
+}
+
+/* sends the file of the transaction once, and keeps its signatures */
+static void UT_CF_Delta_SendOnce(void)
+{
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(UT_CF_File_Find("/ut/src"));
+    UT_CF_File_Find("/ut/src")->pos = 0;
+
+    UT_CF_Delta_Scan();
+
+    UT_CF_Delta_Txn.flags.com.is_complete = true;
+    UT_CF_Delta_Txn.state_data.fin_fs     = CF_CFDP_FinFileStatus_RETAINED;
+    UT_CF_Delta_Txn.state_data.fin_dc     = CF_CFDP_FinDeliveryCode_COMPLETE;
+    CF_Delta_Finish(&UT_CF_Delta_Txn);
+
+    UT_CF_Delta_Txn.flags.tx.delta          = false;
+    UT_CF_Delta_Txn.flags.tx.fd_nak_pending = false;
+    UT_CF_Delta_Txn.foffs                   = 0;
+    UT_CF_Delta_Chunks.chunks.count         = 0;
+}
+
+/*******************************************************************************
+**
+**  cf_delta_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_delta_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Delta_Config, 0, sizeof(UT_CF_Delta_Config));
+    memset(&UT_CF_Delta_Txn, 0, sizeof(UT_CF_Delta_Txn));
+    memset(&UT_CF_Delta_Hist, 0, sizeof(UT_CF_Delta_Hist));
+    memset(&UT_CF_Delta_Chunks, 0, sizeof(UT_CF_Delta_Chunks));
+
+    strcpy(UT_CF_Delta_Config.tmp_dir, "/ut/tmp");
+    UT_CF_Delta_Config.chan[0].delta_block_size = UT_CF_DELTA_BLOCK_SIZE;
+    CF_AppData.config_table                     = &UT_CF_Delta_Config;
+
+    UT_CF_Delta_Hist.src_eid = 1;
+    UT_CF_Delta_Hist.seq_num = 2;
+    UT_CF_Delta_Hist.peer_eid = 23;
+    strcpy(UT_CF_Delta_Hist.fnames.src_filename, "/ut/src");
+    strcpy(UT_CF_Delta_Hist.fnames.dst_filename, "/ut/dst");
+
+    UT_CF_Delta_ChunkBlocks[0]           = UT_CF_Delta_ChunkMem;
+    UT_CF_Delta_Chunks.chunks.blocks     = UT_CF_Delta_ChunkBlocks;
+    UT_CF_Delta_Chunks.chunks.num_blocks = 1;
+    UT_CF_Delta_Chunks.chunks.max_chunks = CF_CHUNK_BLOCK_SIZE;
+    UT_CF_Delta_MaxChunks                = CF_CHUNK_BLOCK_SIZE;
+
+    UT_CF_Delta_Txn.history       = &UT_CF_Delta_Hist;
+    UT_CF_Delta_Txn.chunks        = &UT_CF_Delta_Chunks;
+    UT_CF_Delta_Txn.reliable_mode = true;
+    UT_CF_Delta_Txn.fsize         = UT_CF_DELTA_SRC_LEN;
+
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+    UT_CF_Files_Setup();
+    UT_SetHandlerFunction(UT_KEY(OS_mv), UT_CF_File_Mv, NULL);
+    UT_SetHandlerFunction(UT_KEY(OS_remove), UT_CF_File_Remove, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkListAdd), UT_CF_Delta_ChunkListAdd, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkListReset), UT_CF_Delta_ChunkListReset, NULL);
+}
+
+void cf_delta_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Delta_Hash(void)
+{
+    /* Test case for:
+     * uint32 CF_Delta_Hash(const void *data, size_t len);
+     */
+
+    /* FNV-1a reference values */
+    UtAssert_UINT32_EQ(CF_Delta_Hash("", 0), 0x811C9DC5);
+    UtAssert_UINT32_EQ(CF_Delta_Hash("a", 1), 0xE40C292C);
+    UtAssert_UINT32_EQ(CF_Delta_Hash("foobar", 6), 0xBF9CF968);
+}
+
+void Test_CF_Delta_GetSigName(void)
+{
+    /* Test case for:
+     * void CF_Delta_GetSigName(CF_EntityId_t peer_eid, const char *dst_filename, char *buf, size_t buf_size);
+     */
+    char buf[CF_FILENAME_MAX_LEN];
+    char expected[CF_FILENAME_MAX_LEN];
+
+    UtAssert_VOIDCALL(CF_Delta_GetSigName(23, "foobar", buf, sizeof(buf)));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/ut/tmp/d23_bf9cf968.sig", -1);
+
+    /* another peer gets another file */
+    UtAssert_VOIDCALL(CF_Delta_GetSigName(24, "foobar", expected, sizeof(expected)));
+    UtAssert_True(strcmp(buf, expected) != 0, "different peers, different names");
+}
+
+void Test_CF_Delta_SetMd(void)
+{
+    /* Test case for:
+     * void CF_Delta_SetMd(const CF_Transaction_t *txn, CF_Logical_PduMd_t *md);
+     */
+    CF_Logical_PduMd_t md;
+
+    /* not a delta transfer */
+    memset(&md, 0, sizeof(md));
+    UtAssert_VOIDCALL(CF_Delta_SetMd(&UT_CF_Delta_Txn, &md));
+    UtAssert_ZERO(md.tlv_list.num_tlv);
+
+    /* nominal */
+    UT_CF_Delta_Txn.flags.tx.delta = true;
+    UtAssert_VOIDCALL(CF_Delta_SetMd(&UT_CF_Delta_Txn, &md));
+    UtAssert_UINT32_EQ(md.tlv_list.num_tlv, 1);
+    UtAssert_UINT32_EQ(md.tlv_list.tlv[0].type, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+    UtAssert_UINT32_EQ(md.tlv_list.tlv[0].length, CF_DELTA_MSG_LEN);
+    UtAssert_MemCmp(md.tlv_list.tlv[0].data.data_ptr, "CFD\001", CF_DELTA_MSG_LEN, "message");
+
+    /* the TLV list is full */
+    md.tlv_list.num_tlv = CF_PDU_MAX_TLV;
+    UtAssert_VOIDCALL(CF_Delta_SetMd(&UT_CF_Delta_Txn, &md));
+    UtAssert_UINT32_EQ(md.tlv_list.num_tlv, CF_PDU_MAX_TLV);
+}
+
+void Test_CF_Delta_GetMd(void)
+{
+    /* Test case for:
+     * bool CF_Delta_GetMd(const CF_Logical_PduMd_t *md);
+     */
+    CF_Logical_PduMd_t md;
+    static const uint8 other[CF_DELTA_MSG_LEN] = {'C', 'F', 'Z', 1};
+
+    /* no TLV */
+    memset(&md, 0, sizeof(md));
+    UtAssert_BOOL_FALSE(CF_Delta_GetMd(&md));
+
+    /* a message to user that is not a delta transfer, and another TLV type */
+    md.tlv_list.num_tlv              = 2;
+    md.tlv_list.tlv[0].type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+    md.tlv_list.tlv[0].length        = CF_DELTA_MSG_LEN;
+    md.tlv_list.tlv[0].data.data_ptr = other;
+    md.tlv_list.tlv[1].type          = CF_CFDP_TLV_TYPE_ENTITY_ID;
+    md.tlv_list.tlv[1].length        = CF_DELTA_MSG_LEN;
+    md.tlv_list.tlv[1].data.data_ptr = "CFD\001";
+    UtAssert_BOOL_FALSE(CF_Delta_GetMd(&md));
+
+    /* nominal, as added by CF_Delta_SetMd() */
+    UT_CF_Delta_Txn.flags.tx.delta = true;
+    CF_Delta_SetMd(&UT_CF_Delta_Txn, &md);
+    UtAssert_BOOL_TRUE(CF_Delta_GetMd(&md));
+}
+
+void Test_CF_Delta_ScanStart(void)
+{
+    /* Test case for:
+     * bool CF_Delta_ScanStart(CF_Transaction_t *txn);
+     */
+    UT_CF_File_t *sig;
+
+    /* not enabled on the channel, or not a transfer it applies to */
+    UT_CF_Delta_Config.chan[0].delta_block_size = 0;
+    UtAssert_BOOL_FALSE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    UT_CF_Delta_Config.chan[0].delta_block_size = UT_CF_DELTA_BLOCK_SIZE;
+    UT_CF_Delta_Txn.compress                    = CF_Compress_LZ4;
+    UtAssert_BOOL_FALSE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    UT_CF_Delta_Txn.compress      = CF_Compress_NONE;
+    UT_CF_Delta_Txn.reliable_mode = false;
+    UtAssert_BOOL_FALSE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    UT_CF_Delta_Txn.reliable_mode   = true;
+    UT_CF_Delta_Txn.flags.tx.bundle = true;
+    UtAssert_BOOL_FALSE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    UT_CF_Delta_Txn.flags.tx.bundle = false;
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* nominal, the signature file starts with its header */
+    UT_CF_Delta_Txn.state_data.delta_pos     = 1;
+    UT_CF_Delta_Txn.state_data.delta_changed = 1;
+    UtAssert_BOOL_TRUE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    sig = UT_CF_File_Find("/ut/tmp/1_2.sig");
+    UtAssert_NOT_NULL(sig);
+    UtAssert_UINT32_EQ(sig->len, sizeof(CF_DeltaSigHeader_t));
+    UtAssert_UINT32_EQ(((CF_DeltaSigHeader_t *)sig->data)->magic, CF_DELTA_MAGIC);
+    UtAssert_ZERO(UT_CF_Delta_Txn.state_data.delta_pos);
+    UtAssert_ZERO(UT_CF_Delta_Txn.state_data.delta_changed);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* the header cannot be written, the file is removed and the scan goes on */
+    cf_delta_tests_Setup();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_BOOL_TRUE(CF_Delta_ScanStart(&UT_CF_Delta_Txn));
+    UT_CF_AssertEventID(CF_DELTA_ERR_EID);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_NULL(UT_CF_File_Find("/ut/tmp/1_2.sig"));
+}
+
+void Test_CF_Delta_ScanStep(void)
+{
+    /* Test case for:
+     * bool CF_Delta_ScanStep(CF_Transaction_t *txn);
+     */
+    UT_CF_File_t *src;
+    UT_CF_File_t *sig;
+    char          name[CF_FILENAME_MAX_LEN];
+
+    /* first send, there are no signatures to compare to so the whole file is sent */
+    src                = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(src);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_ZERO(UT_CF_Delta_Txn.foffs);
+    UtAssert_ZERO(UT_CF_Delta_Chunks.chunks.count);
+    UtAssert_STUB_COUNT(CF_ChunkListReset, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 3);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Txn.state_data.cached_pos, UT_CF_DELTA_SRC_LEN);
+    sig = UT_CF_File_Find("/ut/tmp/1_2.sig");
+    UtAssert_NOT_NULL(sig);
+    UtAssert_UINT32_EQ(sig->len, sizeof(CF_DeltaSigHeader_t) + 3 * sizeof(uint32));
+    UtAssert_UINT32_EQ(((CF_DeltaSigHeader_t *)sig->data)->magic, CF_DELTA_MAGIC);
+    UtAssert_UINT32_EQ(((CF_DeltaSigHeader_t *)sig->data)->fsize, UT_CF_DELTA_SRC_LEN);
+
+    /* the signatures are kept once the peer has the file */
+    cf_delta_tests_Setup();
+    UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    CF_Delta_GetSigName(23, "/ut/dst", name, sizeof(name));
+    UtAssert_NOT_NULL(UT_CF_File_Find(name));
+    UtAssert_NULL(UT_CF_File_Find("/ut/tmp/1_2.sig"));
+
+    /* send again with the middle block changed */
+    src = UT_CF_File_Find("/ut/src");
+    src->data[UT_CF_DELTA_BLOCK_SIZE + 10] ^= 0xFF;
+    src->pos = 0;
+    UT_ResetState(UT_KEY(CF_CRC_Start));
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UT_CF_AssertEventID(CF_DELTA_SEND_INF_EID);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.fd_nak_pending);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Txn.foffs, UT_CF_DELTA_SRC_LEN);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].offset, UT_CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].size, UT_CF_DELTA_BLOCK_SIZE);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 0);
+
+    /* nothing changed, only the MD and EOF are needed */
+    cf_delta_tests_Setup();
+    UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    UT_CF_File_Find("/ut/src")->pos = 0;
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.tx.fd_nak_pending);
+    UtAssert_ZERO(UT_CF_Delta_Chunks.chunks.count);
+
+    /* the file grew, the last block is not the same length any more */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    src->len              = UT_CF_DELTA_SRC_LEN + 100;
+    src->pos              = 0;
+    UT_CF_Delta_Txn.fsize = src->len;
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].offset, 2 * UT_CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].size, 552);
+
+    /* the changes do not fit in the chunk list, the whole file is sent */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    src->data[0] ^= 0xFF;
+    src->data[2 * UT_CF_DELTA_BLOCK_SIZE] ^= 0xFF;
+    src->pos              = 0;
+    UT_CF_Delta_MaxChunks = 1;
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_ZERO(UT_CF_Delta_Chunks.chunks.count);
+
+    /* the signatures are for another block size */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    src->pos                                    = 0;
+    UT_CF_Delta_Config.chan[0].delta_block_size = UT_CF_DELTA_BLOCK_SIZE / 2;
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.tx.delta);
+
+    /* the signature file is cut short */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    CF_Delta_GetSigName(23, "/ut/dst", name, sizeof(name));
+    UT_CF_File_Find(name)->len = sizeof(CF_DeltaSigHeader_t) + sizeof(uint32);
+    src->pos                    = 0;
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 2);
+
+    /* read error, the send carries on as usual and fails there */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    src->pos = 0;
+    UT_ResetState(UT_KEY(CF_CRC_Start));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 4, -1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+
+    /* the signatures cannot be written */
+    cf_delta_tests_Setup();
+    src                = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(src);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, -1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UT_CF_AssertEventID(CF_DELTA_ERR_EID);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 3);
+    UtAssert_NULL(UT_CF_File_Find("/ut/tmp/1_2.sig"));
+
+    /* the signature file cannot be created */
+    cf_delta_tests_Setup();
+    src                = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(src);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, OS_ERROR);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 1);
+    UT_CF_AssertEventID(CF_DELTA_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* a block per wakeup once the budget is spent, with the middle block changed */
+    cf_delta_tests_Setup();
+    src = UT_CF_Delta_MakeText("/ut/src", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_SendOnce();
+    src->data[UT_CF_DELTA_BLOCK_SIZE + 10] ^= 0xFF;
+    src->pos = 0;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_BudgetSpent), true);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Scan(), 3);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.tx.delta);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].offset, UT_CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].size, UT_CF_DELTA_BLOCK_SIZE);
+    sig = UT_CF_File_Find("/ut/tmp/1_2.sig");
+    UtAssert_NOT_NULL(sig);
+    UtAssert_UINT32_EQ(sig->len, sizeof(CF_DeltaSigHeader_t) + 3 * sizeof(uint32));
+}
+
+void Test_CF_Delta_Finish(void)
+{
+    /* Test case for:
+     * void CF_Delta_Finish(CF_Transaction_t *txn);
+     */
+
+    /* not enabled */
+    UT_CF_Delta_Config.chan[0].delta_block_size = 0;
+    UtAssert_VOIDCALL(CF_Delta_Finish(&UT_CF_Delta_Txn));
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+
+    /* the peer did not report the file as retained */
+    UT_CF_Delta_Config.chan[0].delta_block_size = UT_CF_DELTA_BLOCK_SIZE;
+    UT_CF_Delta_Txn.flags.com.is_complete       = true;
+    UT_CF_Delta_Txn.state_data.fin_dc           = CF_CFDP_FinDeliveryCode_COMPLETE;
+    UT_CF_Delta_Txn.state_data.fin_fs           = CF_CFDP_FinFileStatus_DISCARDED;
+    UtAssert_VOIDCALL(CF_Delta_Finish(&UT_CF_Delta_Txn));
+    UtAssert_STUB_COUNT(OS_remove, 1);
+
+    /* incomplete */
+    UT_CF_Delta_Txn.state_data.fin_fs     = CF_CFDP_FinFileStatus_RETAINED;
+    UT_CF_Delta_Txn.flags.com.is_complete = false;
+    UtAssert_VOIDCALL(CF_Delta_Finish(&UT_CF_Delta_Txn));
+    UtAssert_STUB_COUNT(OS_remove, 2);
+
+    /* failed */
+    UT_CF_Delta_Txn.flags.com.is_complete = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_TxnIsOK), 1, false);
+    UtAssert_VOIDCALL(CF_Delta_Finish(&UT_CF_Delta_Txn));
+    UtAssert_STUB_COUNT(OS_remove, 3);
+    UtAssert_STUB_COUNT(OS_mv, 0);
+
+    /* nominal */
+    UT_CF_File_Make("/ut/tmp/1_2.sig", "");
+    UtAssert_VOIDCALL(CF_Delta_Finish(&UT_CF_Delta_Txn));
+    UtAssert_STUB_COUNT(OS_mv, 1);
+    UtAssert_STUB_COUNT(OS_remove, 3);
+}
+
+void Test_CF_Delta_PrefillStart(void)
+{
+    /* Test case for:
+     * void CF_Delta_PrefillStart(CF_Transaction_t *txn);
+     */
+
+    /* the temp file is not open */
+    UT_CF_Delta_Txn.fd = OS_OBJECT_ID_UNDEFINED;
+    UtAssert_VOIDCALL(CF_Delta_PrefillStart(&UT_CF_Delta_Txn));
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.prefill);
+
+    /* file data was already received */
+    UT_CF_Delta_Txn.fd              = UT_CF_File_Fd(UT_CF_File_Make("/ut/tmp/1_2.tmp", ""));
+    UT_CF_Delta_Chunks.chunks.count = 1;
+    UtAssert_VOIDCALL(CF_Delta_PrefillStart(&UT_CF_Delta_Txn));
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.prefill);
+
+    /* nominal */
+    UT_CF_Delta_Chunks.chunks.count      = 0;
+    UT_CF_Delta_Txn.state_data.delta_pos = 1;
+    UtAssert_VOIDCALL(CF_Delta_PrefillStart(&UT_CF_Delta_Txn));
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.rx.prefill);
+    UtAssert_ZERO(UT_CF_Delta_Txn.state_data.delta_pos);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+}
+
+void Test_CF_Delta_PrefillStep(void)
+{
+    /* Test case for:
+     * void CF_Delta_PrefillStep(CF_Transaction_t *txn);
+     */
+    UT_CF_File_t *dst;
+    UT_CF_File_t *tmp;
+
+    /* there is no destination file */
+    tmp                = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(tmp);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+
+    /* nominal, the existing file is longer than the new one */
+    dst = UT_CF_Delta_MakeText("/ut/dst", UT_CF_DELTA_SRC_LEN + 100);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_UINT32_EQ(tmp->len, UT_CF_DELTA_SRC_LEN);
+    UtAssert_MemCmp(tmp->data, dst->data, UT_CF_DELTA_SRC_LEN, "copy");
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].offset, 0);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].size, UT_CF_DELTA_SRC_LEN);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Txn.state_data.cached_pos, UT_CF_DELTA_SRC_LEN);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Txn.state_data.rx_progress, UT_CF_DELTA_SRC_LEN);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* the existing file is shorter, the rest is left as a gap */
+    cf_delta_tests_Setup();
+    tmp                = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(tmp);
+    UT_CF_Delta_MakeText("/ut/dst", 100);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UtAssert_BOOL_TRUE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_UINT32_EQ(UT_CF_Delta_ChunkMem[0].size, 100);
+
+    /* the existing file is empty */
+    cf_delta_tests_Setup();
+    tmp                = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(tmp);
+    UT_CF_File_Make("/ut/dst", "");
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+
+    /* a block per wakeup once the budget is spent, the data received meanwhile is kept */
+    cf_delta_tests_Setup();
+    UT_CF_Delta_Txn.fsize = 2 * CF_DELTA_MAX_BLOCK_SIZE + 100;
+    tmp                   = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd    = UT_CF_File_Fd(tmp);
+    memset(&tmp->data[5000], 'X', 100);
+    tmp->len                        = 5100;
+    UT_CF_Delta_ChunkMem[0].offset  = 5000;
+    UT_CF_Delta_ChunkMem[0].size    = 100;
+    UT_CF_Delta_Chunks.chunks.count = 1;
+    dst                             = UT_CF_Delta_MakeText("/ut/dst", UT_CF_Delta_Txn.fsize);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_BudgetSpent), true);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 3);
+    UtAssert_UINT32_EQ(tmp->len, UT_CF_Delta_Txn.fsize);
+    UtAssert_MemCmp(tmp->data, dst->data, 5000, "copy before the received data");
+    UtAssert_MemCmp(&tmp->data[5000], "XXXX", 4, "received data");
+    UtAssert_MemCmp(&tmp->data[5100], &dst->data[5100], UT_CF_Delta_Txn.fsize - 5100, "copy after it");
+    UtAssert_UINT32_EQ(UT_CF_Delta_Chunks.chunks.count, 4);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Txn.state_data.rx_progress, UT_CF_Delta_Txn.fsize);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+
+    /* write error, the copy stops and the rest is NAKed */
+    cf_delta_tests_Setup();
+    tmp                = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(tmp);
+    UT_CF_Delta_MakeText("/ut/dst", UT_CF_DELTA_SRC_LEN);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UT_CF_AssertEventID(CF_DELTA_ERR_EID);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_ZERO(UT_CF_Delta_Txn.state_data.cached_pos);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 2);
+
+    /* the temp file cannot be positioned */
+    cf_delta_tests_Setup();
+    tmp                = UT_CF_File_Make("/ut/tmp/1_2.tmp", "");
+    UT_CF_Delta_Txn.fd = UT_CF_File_Fd(tmp);
+    UT_CF_Delta_MakeText("/ut/dst", UT_CF_DELTA_SRC_LEN);
+    UT_CF_Delta_Txn.state_data.cached_pos = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, -1);
+    UtAssert_UINT32_EQ(UT_CF_Delta_Prefill(), 1);
+    UT_CF_AssertEventID(CF_DELTA_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+}
+
+void Test_CF_Delta_Restart(void)
+{
+    /* Test case for:
+     * void CF_Delta_Restart(CF_Transaction_t *txn);
+     */
+    UT_CF_Delta_Txn.flags.rx.delta         = true;
+    UT_CF_Delta_Txn.flags.com.is_complete  = true;
+    UT_CF_Delta_Txn.flags.com.crc_complete = true;
+    UT_CF_Delta_Chunks.chunks.count        = 1;
+
+    UtAssert_VOIDCALL(CF_Delta_Restart(&UT_CF_Delta_Txn));
+    UT_CF_AssertEventID(CF_DELTA_RETRY_INF_EID);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.rx.delta);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.com.is_complete);
+    UtAssert_BOOL_FALSE(UT_CF_Delta_Txn.flags.com.crc_complete);
+    UtAssert_ZERO(UT_CF_Delta_Chunks.chunks.count);
+}
+
+/*******************************************************************************
+**
+**  cf_delta_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Delta_Hash, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_Hash");
+    UtTest_Add(Test_CF_Delta_GetSigName, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_GetSigName");
+    UtTest_Add(Test_CF_Delta_SetMd, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_SetMd");
+    UtTest_Add(Test_CF_Delta_GetMd, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_GetMd");
+    UtTest_Add(Test_CF_Delta_ScanStart, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_ScanStart");
+    UtTest_Add(Test_CF_Delta_ScanStep, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_ScanStep");
+    UtTest_Add(Test_CF_Delta_Finish, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_Finish");
+    UtTest_Add(Test_CF_Delta_PrefillStart, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_PrefillStart");
+    UtTest_Add(Test_CF_Delta_PrefillStep, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_PrefillStep");
+    UtTest_Add(Test_CF_Delta_Restart, cf_delta_tests_Setup, cf_delta_tests_Teardown, "CF_Delta_Restart");
+}
@@ -0,0 +1,277 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_diag.h"
+#include "cf_app.h"
+
+static CF_ConfigTable_t UT_CF_Diag_Config;
+
+/* local clock seen by the code under test, in microseconds */
+static uint32 UT_CF_Diag_Now_us;
+
+static void UT_CF_Diag_GetLocalTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    OS_time_t *time_struct = UT_Hook_GetArgValueByName(Context, "time_struct", OS_time_t *);
+
+    *time_struct = OS_TimeAssembleFromNanoseconds(UT_CF_Diag_Now_us / 1000000, (UT_CF_Diag_Now_us % 1000000) * 1000);
+}
+
+/* records one sample of the given length in the histogram of a phase */
+static void UT_CF_Diag_Sample(uint8 chan_num, CF_DiagPhase_t phase, uint32 us)
+{
+    OS_time_t mark;
+
+    CF_Diag_Mark(&mark);
+    UT_CF_Diag_Now_us += us;
+    CF_Diag_Lap(chan_num, phase, &mark);
+    CF_Diag_EndChannel(chan_num);
+}
+
+/*******************************************************************************
+**
+**  cf_diag_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_diag_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Diag_Config, 0, sizeof(UT_CF_Diag_Config));
+    memset(&CF_AppData.diag, 0, sizeof(CF_AppData.diag));
+
+    UT_CF_Diag_Config.ticks_per_second = 10;
+    CF_AppData.config_table            = &UT_CF_Diag_Config;
+
+    UT_CF_Diag_Now_us = 5000000;
+    UT_SetHandlerFunction(UT_KEY(OS_GetLocalTime), UT_CF_Diag_GetLocalTime, NULL);
+}
+
+void cf_diag_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_diag_tests
+**
+*******************************************************************************/
+
+void Test_CF_Diag_Init(void)
+{
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_Init());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+}
+
+void Test_CF_Diag_Mark(void)
+{
+    /* Arrange */
+    OS_time_t mark;
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_Mark(&mark));
+
+    /* Assert */
+    UtAssert_INT32_EQ(OS_TimeGetTotalMicroseconds(mark), 5000000);
+}
+
+void Test_CF_Diag_Lap(void)
+{
+    /* Arrange */
+    OS_time_t mark;
+
+    CF_Diag_Mark(&mark);
+    UT_CF_Diag_Now_us += 250;
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_Lap(1, CF_DiagPhase_NAK, &mark));
+
+    /* Assert - the time is added to the wakeup, and the mark moved */
+    UtAssert_UINT32_EQ(CF_AppData.diag.wakeup_us[1][CF_DiagPhase_NAK], 250);
+    UtAssert_UINT32_EQ(CF_AppData.diag.wakeup_ran[1], 1UL << CF_DiagPhase_NAK);
+    UtAssert_INT32_EQ(OS_TimeGetTotalMicroseconds(mark), 5000250);
+
+    /* laps of the same phase in one wakeup add up */
+    UT_CF_Diag_Now_us += 50;
+    UtAssert_VOIDCALL(CF_Diag_Lap(1, CF_DiagPhase_NAK, &mark));
+    UtAssert_UINT32_EQ(CF_AppData.diag.wakeup_us[1][CF_DiagPhase_NAK], 300);
+
+    /* a clock set back counts as no time */
+    UT_CF_Diag_Now_us -= 1000;
+    UtAssert_VOIDCALL(CF_Diag_Lap(1, CF_DiagPhase_NAK, &mark));
+    UtAssert_UINT32_EQ(CF_AppData.diag.wakeup_us[1][CF_DiagPhase_NAK], 300);
+}
+
+void Test_CF_Diag_EndChannel(void)
+{
+    /* Arrange */
+    CF_DiagHistogram_t *hist = &CF_AppData.diag.pkt.Payload.channel[0].phase[CF_DiagPhase_RECEIVE];
+    OS_time_t           mark;
+
+    CF_Diag_Mark(&mark);
+    UT_CF_Diag_Now_us += 5;
+    CF_Diag_Lap(0, CF_DiagPhase_RECEIVE, &mark);
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_EndChannel(0));
+
+    /* Assert - 5 us is in the bucket of 4 to 7 us, phases that did not run get no sample */
+    UtAssert_UINT32_EQ(hist->count, 1);
+    UtAssert_UINT32_EQ(hist->buckets[3], 1);
+    UtAssert_UINT32_EQ(hist->min_us, 5);
+    UtAssert_UINT32_EQ(hist->max_us, 5);
+    UtAssert_ZERO(CF_AppData.diag.pkt.Payload.channel[0].phase[CF_DiagPhase_POLLING].count);
+    UtAssert_ZERO(CF_AppData.diag.wakeup_us[0][CF_DiagPhase_RECEIVE]);
+    UtAssert_ZERO(CF_AppData.diag.wakeup_ran[0]);
+
+    /* a phase that ran in no time is still a sample, in the first bucket */
+    UT_CF_Diag_Sample(0, CF_DiagPhase_RECEIVE, 0);
+    UtAssert_UINT32_EQ(hist->count, 2);
+    UtAssert_UINT32_EQ(hist->buckets[0], 1);
+    UtAssert_UINT32_EQ(hist->min_us, 0);
+    UtAssert_UINT32_EQ(hist->max_us, 5);
+
+    /* anything too long for the other buckets is in the last one */
+    UT_CF_Diag_Sample(0, CF_DiagPhase_RECEIVE, 4000000);
+    UtAssert_UINT32_EQ(hist->buckets[CF_DIAG_HIST_BUCKETS - 1], 1);
+    UtAssert_UINT32_EQ(hist->max_us, 4000000);
+}
+
+void Test_CF_Diag_EndCycle(void)
+{
+    /* Arrange */
+    CF_DiagPacket_Payload_t *pl = &CF_AppData.diag.pkt.Payload;
+    OS_time_t                start;
+
+    CF_Diag_Mark(&start);
+    UT_CF_Diag_Now_us += 100000;
+
+    /* Act - exactly the slot of 10 ticks per second */
+    UtAssert_VOIDCALL(CF_Diag_EndCycle(&start));
+
+    /* Assert */
+    UtAssert_UINT32_EQ(pl->slot_us, 100000);
+    UtAssert_UINT32_EQ(pl->cycle.count, 1);
+    UtAssert_UINT32_EQ(pl->cycle.max_us, 100000);
+    UtAssert_ZERO(pl->overruns);
+
+    /* longer than the slot */
+    CF_Diag_Mark(&start);
+    UT_CF_Diag_Now_us += 100001;
+    UtAssert_VOIDCALL(CF_Diag_EndCycle(&start));
+    UtAssert_UINT32_EQ(pl->cycle.count, 2);
+    UtAssert_UINT32_EQ(pl->overruns, 1);
+}
+
+void Test_CF_Diag_Reset(void)
+{
+    /* Arrange */
+    UT_CF_Diag_Sample(0, CF_DiagPhase_TX_TICK, 100);
+    CF_AppData.diag.pkt.Payload.overruns = 3;
+    CF_AppData.diag.cycle_sum_us         = 1000;
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_Reset());
+
+    /* Assert */
+    UtAssert_MemCmpValue(&CF_AppData.diag.pkt.Payload, 0, sizeof(CF_AppData.diag.pkt.Payload), "payload cleared");
+    UtAssert_MemCmpValue(CF_AppData.diag.phase_sum_us, 0, sizeof(CF_AppData.diag.phase_sum_us), "sums cleared");
+    UtAssert_ZERO(CF_AppData.diag.cycle_sum_us);
+}
+
+void Test_CF_Diag_Send(void)
+{
+    /* Arrange */
+    CF_DiagHistogram_t *hist = &CF_AppData.diag.pkt.Payload.channel[0].phase[CF_DiagPhase_NEW_DATA];
+    int                 i;
+
+    /* Act - nothing recorded */
+    UtAssert_VOIDCALL(CF_Diag_Send());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+    UtAssert_ZERO(hist->avg_us);
+    UtAssert_ZERO(hist->p99_us);
+
+    /* 99 samples of 10 us and one of 1000 us, the 99th percentile is the top of the 8 to 15 us bucket */
+    for (i = 0; i < 99; ++i)
+    {
+        UT_CF_Diag_Sample(0, CF_DiagPhase_NEW_DATA, 10);
+    }
+    UT_CF_Diag_Sample(0, CF_DiagPhase_NEW_DATA, 1000);
+    UtAssert_VOIDCALL(CF_Diag_Send());
+    UtAssert_UINT32_EQ(hist->avg_us, 19);
+    UtAssert_UINT32_EQ(hist->p99_us, 15);
+    UtAssert_UINT32_EQ(hist->max_us, 1000);
+
+    /* never above the longest sample */
+    CF_Diag_Reset();
+    UT_CF_Diag_Sample(0, CF_DiagPhase_NEW_DATA, 9);
+    UtAssert_VOIDCALL(CF_Diag_Send());
+    UtAssert_UINT32_EQ(hist->p99_us, 9);
+
+    /* the last bucket has no top, the longest sample is used */
+    CF_Diag_Reset();
+    UT_CF_Diag_Sample(0, CF_DiagPhase_NEW_DATA, 4000000);
+    UtAssert_VOIDCALL(CF_Diag_Send());
+    UtAssert_UINT32_EQ(hist->p99_us, 4000000);
+}
+
+void Test_CF_Diag_Update(void)
+{
+    /* Arrange */
+    CF_DiagHistogram_t *hist = &CF_AppData.diag.pkt.Payload.cycle;
+    OS_time_t           start;
+
+    CF_Diag_Mark(&start);
+    UT_CF_Diag_Now_us += 300;
+    CF_Diag_EndCycle(&start);
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Diag_Update());
+
+    /* Assert - summarized, nothing sent */
+    UtAssert_UINT32_EQ(hist->avg_us, 300);
+    UtAssert_UINT32_EQ(hist->p99_us, 300);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+}
+
+/*******************************************************************************
+**
+**  cf_diag_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Diag_Init, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Init");
+    UtTest_Add(Test_CF_Diag_Mark, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Mark");
+    UtTest_Add(Test_CF_Diag_Lap, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Lap");
+    UtTest_Add(Test_CF_Diag_EndChannel, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_EndChannel");
+    UtTest_Add(Test_CF_Diag_EndCycle, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_EndCycle");
+    UtTest_Add(Test_CF_Diag_Reset, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Reset");
+    UtTest_Add(Test_CF_Diag_Update, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Update");
+    UtTest_Add(Test_CF_Diag_Send, cf_diag_tests_Setup, cf_diag_tests_Teardown, "CF_Diag_Send");
+}
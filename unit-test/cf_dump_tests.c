@@ -0,0 +1,427 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_dump.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+#define UT_CF_DUMP_NUM_HIST 24
+
+static CF_History_t     UT_CF_Dump_Hist[UT_CF_DUMP_NUM_HIST];
+static CF_Transaction_t UT_CF_Dump_Txn[18];
+
+/* everything written to the dump file, and the last write */
+static uint8  UT_CF_Dump_File[sizeof(CF_DumpHeader_t) + (2 * UT_CF_DUMP_NUM_HIST * sizeof(CF_DumpRecord_t))];
+static size_t UT_CF_Dump_FileSize;
+static size_t UT_CF_Dump_LastWrite;
+
+static void UT_CF_Dump_WrappedWrite(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const void  *buf        = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t       write_size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    CFE_Status_t ret        = write_size;
+
+    UtAssert_True(UT_CF_Dump_FileSize + write_size <= sizeof(UT_CF_Dump_File), "Write fits the file");
+    memcpy(&UT_CF_Dump_File[UT_CF_Dump_FileSize], buf, write_size);
+    UT_CF_Dump_FileSize += write_size;
+    UT_CF_Dump_LastWrite = UT_CF_Dump_FileSize - write_size;
+
+    UT_Stub_SetReturnValue(FuncKey, ret);
+}
+
+/* walks a real list, as the dump depends on where the traversal stops */
+static void UT_CF_Dump_Traverse(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_CListNode_t *start   = UT_Hook_GetArgValueByName(Context, "start", CF_CListNode_t *);
+    CF_CListFn_t    fn      = UT_Hook_GetArgValueByName(Context, "fn", CF_CListFn_t);
+    void           *context = UT_Hook_GetArgValueByName(Context, "context", void *);
+    CF_CListNode_t *node    = start;
+    CF_CListNode_t *next;
+
+    if (node != NULL)
+    {
+        do
+        {
+            next = node->next;
+            if (fn(node, context) == CF_CLIST_EXIT)
+            {
+                break;
+            }
+            node = next;
+        }
+        while (node != start);
+    }
+}
+
+static void UT_CF_Dump_Link(CF_CListNode_t **head, CF_CListNode_t *node)
+{
+    if (*head == NULL)
+    {
+        node->next = node;
+        node->prev = node;
+        *head      = node;
+    }
+    else
+    {
+        node->next          = *head;
+        node->prev          = (*head)->prev;
+        (*head)->prev->next = node;
+        (*head)->prev       = node;
+    }
+}
+
+static void UT_CF_Dump_Unlink(CF_CListNode_t **head, CF_CListNode_t *node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    if (*head == node)
+    {
+        *head = (node->next == node) ? NULL : node->next;
+    }
+}
+
+static uint64 UT_CF_Dump_Load(const uint8 *octets, size_t size)
+{
+    uint64 val = 0;
+
+    while (size > 0)
+    {
+        val = (val << 8) | *octets;
+        ++octets;
+        --size;
+    }
+
+    return val;
+}
+
+static const CF_DumpRecord_t *UT_CF_Dump_Record(uint32 idx)
+{
+    return (const CF_DumpRecord_t *)&UT_CF_Dump_File[sizeof(CF_DumpHeader_t) + (idx * sizeof(CF_DumpRecord_t))];
+}
+
+static void UT_CF_Dump_Start(uint8 type, uint8 queue)
+{
+    CF_WriteQueue_Payload_t wq;
+
+    memset(&wq, 0, sizeof(wq));
+    wq.chan   = 0;
+    wq.type   = type;
+    wq.queue  = queue;
+    wq.format = CF_Format_binary;
+    strcpy(wq.filename, "/cf/dump.bin");
+
+    CF_Dump_Start(&wq);
+    UtAssert_BOOL_TRUE(CF_AppData.dump.busy);
+
+    UT_ResetState(UT_KEY(CFE_EVS_SendEvent));
+}
+
+/*******************************************************************************
+**
+**  cf_dump_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_dump_tests_Setup(void)
+{
+    CF_Channel_t *chan;
+    int           i;
+
+    cf_tests_Setup();
+
+    memset(UT_CF_Dump_Hist, 0, sizeof(UT_CF_Dump_Hist));
+    memset(UT_CF_Dump_Txn, 0, sizeof(UT_CF_Dump_Txn));
+    UT_CF_Dump_FileSize  = 0;
+    UT_CF_Dump_LastWrite = 0;
+
+    /* RX history, one in four from TX */
+    chan = &CF_AppData.engine.channels[0];
+    for (i = 0; i < UT_CF_DUMP_NUM_HIST; ++i)
+    {
+        UT_CF_Dump_Hist[i].src_eid  = 10;
+        UT_CF_Dump_Hist[i].seq_num  = i;
+        UT_CF_Dump_Hist[i].peer_eid = 20;
+        UT_CF_Dump_Hist[i].dir      = ((i % 4) == 3) ? CF_Direction_TX : CF_Direction_RX;
+        UT_CF_Dump_Hist[i].txn_stat = CF_TxnStatus_NO_ERROR;
+        snprintf(UT_CF_Dump_Hist[i].fnames.src_filename, CF_FILENAME_MAX_LEN, "/src/%d", i);
+        snprintf(UT_CF_Dump_Hist[i].fnames.dst_filename, CF_FILENAME_MAX_LEN, "/dst/%d", i);
+        UT_CF_Dump_Link(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[i].cl_node);
+    }
+
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_CF_Dump_Traverse, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Dump_WrappedWrite, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedOpenCreate), 1);
+}
+
+void cf_dump_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_dump_tests
+**
+*******************************************************************************/
+
+void Test_CF_Dump_Start(void)
+{
+    const CF_DumpHeader_t *hdr = (const CF_DumpHeader_t *)UT_CF_Dump_File;
+    CF_WriteQueue_Payload_t wq;
+
+    memset(&wq, 0, sizeof(wq));
+    wq.chan  = 1;
+    wq.type  = CF_Type_down;
+    wq.queue = CF_Queue_pend;
+    strcpy(wq.filename, "/cf/dump.bin");
+
+    /* the host decoder knows these */
+    UtAssert_UINT32_EQ(sizeof(CF_DumpHeader_t), 28);
+    UtAssert_UINT32_EQ(offsetof(CF_DumpRecord_t, src_filename), 64);
+    UtAssert_UINT32_EQ(sizeof(CF_DumpRecord_t), 64 + (2 * CF_FILENAME_MAX_LEN));
+
+    /* Test case for:
+     * The header is written at once, not complete yet */
+    UtAssert_VOIDCALL(CF_Dump_Start(&wq));
+    UtAssert_BOOL_TRUE(CF_AppData.dump.busy);
+    UtAssert_UINT32_EQ(UT_CF_Dump_FileSize, sizeof(CF_DumpHeader_t));
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(hdr->magic.octets, 4), CF_DUMP_MAGIC);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(hdr->version.octets, 2), CF_DUMP_VERSION);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(hdr->record_size.octets, 2), sizeof(CF_DumpRecord_t));
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(hdr->filename_len.octets, 2), CF_FILENAME_MAX_LEN);
+    UtAssert_UINT32_EQ(hdr->chan.octets[0], 1);
+    UtAssert_UINT32_EQ(hdr->queue.octets[0], CF_Queue_pend);
+    UtAssert_ZERO(hdr->flags.octets[0]);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* Test case for:
+     * Only one dump at a time */
+    UtAssert_VOIDCALL(CF_Dump_Start(&wq));
+    UT_CF_AssertEventID(CF_DUMP_BUSY_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+
+    /* Test case for:
+     * The file cannot be opened */
+    CF_AppData.dump.busy = false;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedOpenCreate), -1);
+    UtAssert_VOIDCALL(CF_Dump_Start(&wq));
+    UT_CF_AssertEventID(CF_CMD_WQ_OPEN_ERR_EID);
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+
+    /* Test case for:
+     * The header cannot be written */
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedOpenCreate), 1);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), NULL, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), -1);
+    UtAssert_VOIDCALL(CF_Dump_Start(&wq));
+    UT_CF_AssertEventID(CF_DUMP_WRITE_ERR_EID);
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+}
+
+void Test_CF_Dump_Run(void)
+{
+    const CF_DumpHeader_t *hdr;
+    const CF_DumpRecord_t *rec;
+    CF_Channel_t          *chan = &CF_AppData.engine.channels[0];
+    uint32                 i;
+
+    /* Test case for:
+     * Nothing to do without a dump */
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+
+    /* Test case for:
+     * The 18 RX history entries take two wakeups, one buffer each */
+    UT_CF_Dump_Start(CF_Type_up, CF_Queue_history);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_TRUE(CF_AppData.dump.busy);
+    UtAssert_UINT32_EQ(UT_CF_Dump_FileSize, sizeof(CF_DumpHeader_t) + (16 * sizeof(CF_DumpRecord_t)));
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* the oldest entries are recycled in the meantime, the dump carries on after the last one written */
+    UT_CF_Dump_Unlink(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[0].cl_node);
+    UT_CF_Dump_Unlink(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[1].cl_node);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UT_CF_AssertEventID(CF_CMD_WQ_INF_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, 1);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* the header is written again at the end */
+    UtAssert_UINT32_EQ(CF_AppData.dump.count, 18);
+    UtAssert_UINT32_EQ(UT_CF_Dump_LastWrite, sizeof(CF_DumpHeader_t) + (18 * sizeof(CF_DumpRecord_t)));
+    hdr = (const CF_DumpHeader_t *)&UT_CF_Dump_File[UT_CF_Dump_LastWrite];
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(hdr->count.octets, 4), 18);
+    UtAssert_UINT32_EQ(hdr->flags.octets[0], CF_DUMP_FLAG_COMPLETE);
+
+    for (i = 0; i < 18; ++i)
+    {
+        rec = UT_CF_Dump_Record(i);
+        UtAssert_UINT32_EQ(UT_CF_Dump_Load(rec->seq_num.octets, 8), i + (i / 3));
+        UtAssert_UINT32_EQ(rec->queue.octets[0], CF_QueueIdx_HIST);
+        UtAssert_UINT32_EQ(rec->dir.octets[0], CF_Direction_RX);
+        UtAssert_UINT32_EQ(UT_CF_Dump_Load(rec->src_eid.octets, 8), 10);
+        UtAssert_UINT32_EQ(UT_CF_Dump_Load(rec->peer_eid.octets, 8), 20);
+    }
+    UtAssert_STRINGBUF_EQ(UT_CF_Dump_Record(17)->src_filename, CF_FILENAME_MAX_LEN, "/src/22", -1);
+    UtAssert_STRINGBUF_EQ(UT_CF_Dump_Record(17)->dst_filename, CF_FILENAME_MAX_LEN, "/dst/22", -1);
+}
+
+void Test_CF_Dump_Run_Resume(void)
+{
+    CF_Channel_t *chan = &CF_AppData.engine.channels[0];
+    int           i;
+
+    for (i = 0; i < 18; ++i)
+    {
+        UT_CF_Dump_Txn[i].history = &UT_CF_Dump_Hist[i];
+        UT_CF_Dump_Link(&chan->qs[CF_QueueIdx_PEND], &UT_CF_Dump_Txn[i].cl_node);
+    }
+
+    /* Test case for:
+     * The last entry written left a transaction queue, carry on after as many entries */
+    UT_CF_Dump_Start(CF_Type_down, CF_Queue_pend);
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_ADDRESS_EQ(CF_AppData.dump.last, &UT_CF_Dump_Txn[15].cl_node);
+
+    UT_CF_Dump_Unlink(&chan->qs[CF_QueueIdx_PEND], &UT_CF_Dump_Txn[15].cl_node);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UtAssert_UINT32_EQ(CF_AppData.dump.count, 17);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(16)->seq_num.octets, 8), 17);
+}
+
+void Test_CF_Dump_Run_Recycled(void)
+{
+    CF_Channel_t *chan = &CF_AppData.engine.channels[0];
+    int           i;
+
+    /* Test case for:
+     * The last entry written was recycled along with the ones before it, carry on from the head */
+    UT_CF_Dump_Start(CF_Type_up, CF_Queue_history);
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_ADDRESS_EQ(CF_AppData.dump.last, &UT_CF_Dump_Hist[20].cl_node);
+
+    for (i = 0; i <= 20; ++i)
+    {
+        UT_CF_Dump_Unlink(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[i].cl_node);
+    }
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UtAssert_UINT32_EQ(CF_AppData.dump.count, 18);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(16)->seq_num.octets, 8), 21);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(17)->seq_num.octets, 8), 22);
+
+    /* Test case for:
+     * The node of the last entry written is back at the end of the queue for another transaction */
+    cf_dump_tests_Setup();
+    UT_CF_Dump_Start(CF_Type_up, CF_Queue_history);
+    UtAssert_VOIDCALL(CF_Dump_Run());
+
+    for (i = 0; i <= 20; ++i)
+    {
+        UT_CF_Dump_Unlink(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[i].cl_node);
+    }
+    UT_CF_Dump_Hist[20].seq_num = 100;
+    UT_CF_Dump_Link(&chan->qs[CF_QueueIdx_HIST], &UT_CF_Dump_Hist[20].cl_node);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_UINT32_EQ(CF_AppData.dump.count, 19);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(16)->seq_num.octets, 8), 21);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(18)->seq_num.octets, 8), 100);
+}
+
+void Test_CF_Dump_Run_AllQueues(void)
+{
+    CF_Channel_t *chan = &CF_AppData.engine.channels[0];
+
+    /* an RX and a pending transaction, beside 18 RX and 6 TX history entries */
+    UT_CF_Dump_Txn[0].history = &UT_CF_Dump_Hist[0];
+    UT_CF_Dump_Txn[1].history = &UT_CF_Dump_Hist[3];
+    UT_CF_Dump_Link(&chan->qs[CF_QueueIdx_RX], &UT_CF_Dump_Txn[0].cl_node);
+    UT_CF_Dump_Link(&chan->qs[CF_QueueIdx_PEND], &UT_CF_Dump_Txn[1].cl_node);
+
+    /* Test case for:
+     * All the queues in the order of the text format */
+    UT_CF_Dump_Start(CF_Type_all, CF_Queue_all);
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_TRUE(CF_AppData.dump.busy);
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UtAssert_UINT32_EQ(CF_AppData.dump.count, 26);
+
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(0)->queue.octets[0], CF_QueueIdx_RX);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(1)->queue.octets[0], CF_QueueIdx_HIST);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(18)->dir.octets[0], CF_Direction_RX);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(19)->queue.octets[0], CF_QueueIdx_PEND);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(20)->queue.octets[0], CF_QueueIdx_HIST);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Record(20)->dir.octets[0], CF_Direction_TX);
+    UtAssert_UINT32_EQ(UT_CF_Dump_Load(UT_CF_Dump_Record(25)->seq_num.octets, 8), 23);
+}
+
+void Test_CF_Dump_Run_WriteError(void)
+{
+    /* Test case for:
+     * A failed write abandons the dump */
+    UT_CF_Dump_Start(CF_Type_all, CF_Queue_all);
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), NULL, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), -1);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UT_CF_AssertEventID(CF_DUMP_WRITE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* Test case for:
+     * A failed header at the end as well */
+    UT_ResetState(UT_KEY(CFE_EVS_SendEvent));
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Dump_WrappedWrite, NULL);
+    UT_CF_Dump_Start(CF_Type_up, CF_Queue_active);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedLseek), -1);
+
+    UtAssert_VOIDCALL(CF_Dump_Run());
+    UtAssert_BOOL_FALSE(CF_AppData.dump.busy);
+    UT_CF_AssertEventID(CF_DUMP_WRITE_ERR_EID);
+}
+
+/*******************************************************************************
+**
+**  cf_dump_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Dump_Start, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Start");
+    UtTest_Add(Test_CF_Dump_Run, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Run");
+    UtTest_Add(Test_CF_Dump_Run_Resume, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Run_Resume");
+    UtTest_Add(Test_CF_Dump_Run_Recycled, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Run_Recycled");
+    UtTest_Add(Test_CF_Dump_Run_AllQueues, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Run_AllQueues");
+    UtTest_Add(Test_CF_Dump_Run_WriteError, cf_dump_tests_Setup, cf_dump_tests_Teardown, "CF_Dump_Run_WriteError");
+}
@@ -0,0 +1,169 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_evlim.h"
+#include "cf_eventids.h"
+#include "cf_app.h"
+
+static CF_ConfigTable_t UT_CF_EvLim_Config;
+
+/*******************************************************************************
+**
+**  cf_evlim_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_evlim_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_EvLim_Config, 0, sizeof(UT_CF_EvLim_Config));
+    UT_CF_EvLim_Config.ticks_per_second = 10;
+    UT_CF_EvLim_Config.event_burst      = 3;
+    UT_CF_EvLim_Config.event_rate       = 1;
+    UT_CF_EvLim_Config.event_summary_s  = 2;
+    CF_AppData.config_table             = &UT_CF_EvLim_Config;
+
+    CF_EvLim_Init();
+}
+
+void cf_evlim_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_evlim_tests
+**
+*******************************************************************************/
+
+void Test_CF_EvLim_Init(void)
+{
+    /* Arrange */
+    memset(&CF_AppData.evlim, 0, sizeof(CF_AppData.evlim));
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_EvLim_Init());
+
+    /* Assert */
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[0].tokens, UINT32_MAX);
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[CF_EVLIM_MAX_EID - 1].tokens, UINT32_MAX);
+    UtAssert_ZERO(CF_AppData.evlim.bucket[0].suppressed);
+}
+
+void Test_CF_EvLim_Allow(void)
+{
+    int i;
+
+    /* a full bucket sends the burst, then suppresses */
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_FALSE(CF_EvLim_Allow(5));
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[5].suppressed, 1);
+
+    /* other event IDs have their own bucket */
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(6));
+
+    /* one event per second comes back, counted in wakeups */
+    for (i = 0; i < 9; ++i)
+    {
+        ++CF_AppData.evlim.tick;
+    }
+    UtAssert_BOOL_FALSE(CF_EvLim_Allow(5));
+    ++CF_AppData.evlim.tick;
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_FALSE(CF_EvLim_Allow(5));
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[5].suppressed, 3);
+
+    /* the bucket does not fill past the burst, however long the wait */
+    CF_AppData.evlim.tick += 1000;
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_BOOL_FALSE(CF_EvLim_Allow(5));
+
+    /* event IDs without a bucket are never limited */
+    for (i = 0; i < 10; ++i)
+    {
+        UtAssert_BOOL_TRUE(CF_EvLim_Allow(CF_EVLIM_MAX_EID));
+    }
+
+    /* neither are any events with a burst of 0 */
+    UT_CF_EvLim_Config.event_burst = 0;
+    UtAssert_BOOL_TRUE(CF_EvLim_Allow(5));
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[5].suppressed, 4);
+}
+
+void Test_CF_EvLim_Tick(void)
+{
+    int i;
+
+    /* Arrange */
+    CF_AppData.evlim.bucket[5].suppressed  = 7;
+    CF_AppData.evlim.bucket[12].suppressed = 1;
+
+    /* Act - nothing is reported before event_summary_s */
+    for (i = 0; i < 19; ++i)
+    {
+        UtAssert_VOIDCALL(CF_EvLim_Tick());
+    }
+
+    /* Assert */
+    UtAssert_UINT32_EQ(CF_AppData.evlim.tick, 19);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* Act - one report for each event ID with events suppressed */
+    UtAssert_VOIDCALL(CF_EvLim_Tick());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 2);
+    UT_CF_AssertEventID(CF_EVLIM_SUPPRESSED_INF_EID);
+    UtAssert_ZERO(CF_AppData.evlim.bucket[5].suppressed);
+    UtAssert_ZERO(CF_AppData.evlim.bucket[12].suppressed);
+
+    /* Act - with the reports disabled, the counts are kept */
+    UT_ResetState(UT_KEY(CFE_EVS_SendEvent));
+    UT_CF_EvLim_Config.event_summary_s    = 0;
+    CF_AppData.evlim.bucket[5].suppressed = 2;
+    for (i = 0; i < 40; ++i)
+    {
+        UtAssert_VOIDCALL(CF_EvLim_Tick());
+    }
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_UINT32_EQ(CF_AppData.evlim.bucket[5].suppressed, 2);
+}
+
+/*******************************************************************************
+**
+**  cf_evlim_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_EvLim_Init, cf_evlim_tests_Setup, cf_evlim_tests_Teardown, "CF_EvLim_Init");
+    UtTest_Add(Test_CF_EvLim_Allow, cf_evlim_tests_Setup, cf_evlim_tests_Teardown, "CF_EvLim_Allow");
+    UtTest_Add(Test_CF_EvLim_Tick, cf_evlim_tests_Setup, cf_evlim_tests_Teardown, "CF_EvLim_Tick");
+}
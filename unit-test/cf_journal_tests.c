@@ -0,0 +1,1022 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_test_alt_handler.h"
+#include "cf_journal.h"
+#include "cf_spill.h"
+#include "cf_cfdp.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+/* checksum value produced by the CF_CRC_Finalize() handler below, unless it is given another */
+#define UT_CF_JOURNAL_CRC 0x5A5AA5A5
+
+/* stands in for the journal file, the wrapped I/O calls read and write this */
+typedef struct
+{
+    uint8  data[8192];
+    size_t pos;
+    size_t len;
+} UT_CF_Journal_File_t;
+
+static UT_CF_Journal_File_t UT_CF_Journal_File;
+static UT_CF_Journal_File_t UT_CF_Journal_SpillFile;
+static CF_ConfigTable_t     UT_CF_Journal_Config;
+
+/* stands in for the RX queue of UT_CFDP_CHANNEL, see UT_CF_Journal_Setup_Rx() */
+static CF_Transaction_t  UT_CF_Journal_Rx[2];
+static CF_History_t      UT_CF_Journal_RxHistory[2];
+static CF_ChunkWrapper_t UT_CF_Journal_RxChunks;
+
+static void UT_CF_Journal_Write(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Journal_File_t *file = UserObj;
+    const void           *buf  = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t                size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32                 status;
+
+    /* a forced status code simulates an I/O error */
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        memcpy(&file->data[file->pos], buf, size);
+        file->pos += size;
+        if (file->pos > file->len)
+        {
+            file->len = file->pos;
+        }
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_Journal_Read(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Journal_File_t *file = UserObj;
+    void                 *buf  = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    size_t                size = UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32                 status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        if (size > (file->len - file->pos))
+        {
+            size = file->len - file->pos;
+        }
+        memcpy(buf, &file->data[file->pos], size);
+        file->pos += size;
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_Journal_Lseek(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Journal_File_t *file = UserObj;
+    int32                 status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        file->pos = UT_Hook_GetArgValueByName(Context, "offset", off_t);
+        status    = file->pos;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_Journal_CrcFinalize(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Crc_t     *crc    = UT_Hook_GetArgValueByName(Context, "crc", CF_Crc_t *);
+    const uint32 *result = UserObj;
+
+    crc->result = (result != NULL) ? *result : UT_CF_JOURNAL_CRC;
+}
+
+static void UT_CF_Journal_CrcFinalizeCount(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Crc_t *crc = UT_Hook_GetArgValueByName(Context, "crc", CF_Crc_t *);
+
+    /* no two checksums are the same */
+    crc->result = UT_GetStubCount(FuncKey);
+}
+
+/* visits the transactions of UT_CF_Journal_Rx for any queue that is not empty */
+static void UT_CF_Journal_Traverse(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_CListNode_t *start   = UT_Hook_GetArgValueByName(Context, "start", CF_CListNode_t *);
+    CF_CListFn_t    fn      = UT_Hook_GetArgValueByName(Context, "fn", CF_CListFn_t);
+    void           *context = UT_Hook_GetArgValueByName(Context, "context", void *);
+    int             i;
+
+    for (i = 0; start != NULL && i < 2; ++i)
+    {
+        if (fn(&UT_CF_Journal_Rx[i].cl_node, context) == CF_CLIST_EXIT)
+        {
+            break;
+        }
+    }
+}
+
+/* puts two eligible transactions without chunks in the RX queue of UT_CFDP_CHANNEL */
+static void UT_CF_Journal_Setup_Rx(void)
+{
+    int i;
+
+    memset(UT_CF_Journal_Rx, 0, sizeof(UT_CF_Journal_Rx));
+    memset(UT_CF_Journal_RxHistory, 0, sizeof(UT_CF_Journal_RxHistory));
+    memset(&UT_CF_Journal_RxChunks, 0, sizeof(UT_CF_Journal_RxChunks));
+
+    for (i = 0; i < 2; ++i)
+    {
+        UT_CF_Journal_RxHistory[i].src_eid            = 12;
+        UT_CF_Journal_RxHistory[i].seq_num            = 34 + i;
+        UT_CF_Journal_Rx[i].history                   = &UT_CF_Journal_RxHistory[i];
+        UT_CF_Journal_Rx[i].chunks                    = &UT_CF_Journal_RxChunks;
+        UT_CF_Journal_Rx[i].chan_num                  = UT_CFDP_CHANNEL;
+        UT_CF_Journal_Rx[i].state                     = CF_TxnState_R2;
+        UT_CF_Journal_Rx[i].state_data.sub_state      = CF_RxSubState_DATA_NORMAL;
+        UT_CF_Journal_Rx[i].flags.rx.tempfile_created = true;
+    }
+
+    CF_AppData.engine.channels[UT_CFDP_CHANNEL].qs[CF_QueueIdx_RX] = &UT_CF_Journal_Rx[0].cl_node;
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_CF_Journal_Traverse, NULL);
+}
+
+/* puts a header and one record with the given chunks into the journal file */
+static void UT_CF_Journal_Setup_File(const CF_JournalRecord_t *rec, const CF_Chunk_t *chunks)
+{
+    CF_JournalHeader_t hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic       = CF_JOURNAL_MAGIC;
+    hdr.version     = CF_JOURNAL_VERSION;
+    hdr.num_records = (rec != NULL) ? 1 : 0;
+    hdr.body_crc    = UT_CF_JOURNAL_CRC;
+    hdr.seq_num     = 1000;
+
+    memset(&UT_CF_Journal_File, 0, sizeof(UT_CF_Journal_File));
+    memcpy(&UT_CF_Journal_File.data[UT_CF_Journal_File.len], &hdr, sizeof(hdr));
+    UT_CF_Journal_File.len += sizeof(hdr);
+
+    if (rec != NULL)
+    {
+        memcpy(&UT_CF_Journal_File.data[UT_CF_Journal_File.len], rec, sizeof(*rec));
+        UT_CF_Journal_File.len += sizeof(*rec);
+        memcpy(&UT_CF_Journal_File.data[UT_CF_Journal_File.len], chunks, rec->num_chunks * sizeof(CF_Chunk_t));
+        UT_CF_Journal_File.len += rec->num_chunks * sizeof(CF_Chunk_t);
+    }
+}
+
+static void UT_CF_Journal_Setup_Record(CF_JournalRecord_t *rec, CF_ChunkIdx_t num_chunks)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->src_eid     = 12;
+    rec->peer_eid    = 12;
+    rec->seq_num     = 34;
+    rec->fsize       = 1000;
+    rec->eof_size    = 1000;
+    rec->rx_progress = 800;
+    rec->num_chunks  = num_chunks;
+    rec->chan_num    = UT_CFDP_CHANNEL;
+    rec->sub_state   = CF_RxSubState_DATA_EOF;
+    rec->eof_count   = 1;
+    rec->md_recv     = true;
+    rec->delta       = true;
+    rec->compress    = CF_Compress_LZ4;
+}
+
+/*******************************************************************************
+**
+**  cf_journal_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_journal_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    /* make sure global data is wiped between tests */
+    memset(&CF_AppData, 0, sizeof(CF_AppData));
+    memset(&UT_CF_Journal_File, 0, sizeof(UT_CF_Journal_File));
+    memset(&UT_CF_Journal_SpillFile, 0, sizeof(UT_CF_Journal_SpillFile));
+    memset(&UT_CF_Journal_Config, 0, sizeof(UT_CF_Journal_Config));
+
+    UT_CF_Journal_Config.checkpoint_interval_s                           = 10;
+    UT_CF_Journal_Config.chan[UT_CFDP_CHANNEL].rx_chunks_per_transaction = 32;
+    strcpy(UT_CF_Journal_Config.journal_file, "/ut/journal.dat");
+    CF_AppData.config_table = &UT_CF_Journal_Config;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Journal_Write, &UT_CF_Journal_File);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_CF_Journal_Read, &UT_CF_Journal_File);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedLseek), UT_CF_Journal_Lseek, &UT_CF_Journal_File);
+    UT_SetHandlerFunction(UT_KEY(CF_CRC_Finalize), UT_CF_Journal_CrcFinalize, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxnIsOK), true);
+}
+
+void cf_journal_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Journal_IsEligible(void)
+{
+    /* Test case for:
+     * bool CF_Journal_IsEligible(const CF_Transaction_t *txn);
+     */
+    CF_Transaction_t  txn;
+    CF_ChunkWrapper_t chunks;
+
+    /* nominal, R2 collecting data */
+    memset(&txn, 0, sizeof(txn));
+    txn.state                     = CF_TxnState_R2;
+    txn.chunks                    = &chunks;
+    txn.flags.rx.tempfile_created = true;
+    txn.state_data.sub_state      = CF_RxSubState_DATA_NORMAL;
+    UtAssert_BOOL_TRUE(CF_Journal_IsEligible(&txn));
+
+    /* still eligible while the CRC is checked */
+    txn.state_data.sub_state = CF_RxSubState_VALIDATE;
+    UtAssert_BOOL_TRUE(CF_Journal_IsEligible(&txn));
+
+    /* file already complete */
+    txn.state_data.sub_state = CF_RxSubState_FILESTORE;
+    UtAssert_BOOL_FALSE(CF_Journal_IsEligible(&txn));
+    txn.state_data.sub_state = CF_RxSubState_DATA_EOF;
+
+    /* R1 */
+    txn.state = CF_TxnState_R1;
+    UtAssert_BOOL_FALSE(CF_Journal_IsEligible(&txn));
+    txn.state = CF_TxnState_R2;
+
+    /* no temp file */
+    txn.flags.rx.tempfile_created = false;
+    UtAssert_BOOL_FALSE(CF_Journal_IsEligible(&txn));
+    txn.flags.rx.tempfile_created = true;
+
+    /* no chunk list */
+    txn.chunks = NULL;
+    UtAssert_BOOL_FALSE(CF_Journal_IsEligible(&txn));
+    txn.chunks = &chunks;
+
+    /* already failed */
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_TxnIsOK), 1, false);
+    UtAssert_BOOL_FALSE(CF_Journal_IsEligible(&txn));
+}
+
+void Test_CF_Journal_WriteTxn(void)
+{
+    /* Test case for:
+     * CF_CListTraverse_Status_t CF_Journal_WriteTxn(CF_CListNode_t *node, void *context);
+     */
+    CF_Transaction_t      txn;
+    CF_History_t          history;
+    CF_ChunkWrapper_t     chunks;
+    CF_Chunk_t            block0[CF_CHUNK_BLOCK_SIZE];
+    CF_Chunk_t            block1[CF_CHUNK_BLOCK_SIZE];
+    CF_Chunk_t           *blocks[2] = { block0, block1 };
+    CF_Checkpoint_t       cp;
+    CF_JournalRecord_t    rec;
+    CF_Chunk_t            last;
+
+    memset(&txn, 0, sizeof(txn));
+    memset(&history, 0, sizeof(history));
+    memset(&chunks, 0, sizeof(chunks));
+    memset(block0, 0, sizeof(block0));
+    memset(block1, 0, sizeof(block1));
+    memset(&cp, 0, sizeof(cp));
+
+    history.src_eid               = 12;
+    history.seq_num               = 34;
+    txn.history                   = &history;
+    txn.chunks                    = &chunks;
+    txn.chan_num                  = UT_CFDP_CHANNEL;
+    txn.fsize                     = 1000;
+    txn.state_data.rx_progress    = 900;
+    txn.state_data.sub_state      = CF_RxSubState_DATA_NORMAL;
+    txn.flags.rx.tempfile_created = true;
+    txn.flags.rx.md_recv          = true;
+    txn.flags.rx.delta            = true;
+    txn.flags.com.suspended       = true;
+    txn.compress                  = CF_Compress_LZ4;
+    chunks.chunks.blocks          = blocks;
+    chunks.chunks.count           = CF_CHUNK_BLOCK_SIZE + 1;
+    block1[0].offset              = 700;
+    block1[0].size                = 200;
+
+    /* not eligible, nothing written */
+    txn.state = CF_TxnState_R1;
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_ZERO(cp.num_records);
+
+    /* nominal, record followed by the chunks of both blocks */
+    txn.state = CF_TxnState_R2;
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    UtAssert_UINT32_EQ(cp.num_records, 1);
+    UtAssert_BOOL_FALSE(cp.error);
+    UtAssert_UINT32_EQ(UT_CF_Journal_File.len, sizeof(rec) + ((CF_CHUNK_BLOCK_SIZE + 1) * sizeof(CF_Chunk_t)));
+    memcpy(&rec, UT_CF_Journal_File.data, sizeof(rec));
+    UtAssert_UINT32_EQ(rec.src_eid, 12);
+    UtAssert_UINT32_EQ(rec.seq_num, 34);
+    UtAssert_UINT32_EQ(rec.fsize, 1000);
+    UtAssert_UINT32_EQ(rec.rx_progress, 900);
+    UtAssert_UINT32_EQ(rec.num_chunks, CF_CHUNK_BLOCK_SIZE + 1);
+    UtAssert_BOOL_TRUE(rec.md_recv);
+    UtAssert_BOOL_TRUE(rec.delta);
+    UtAssert_BOOL_TRUE(rec.suspended);
+    UtAssert_UINT32_EQ(rec.compress, CF_Compress_LZ4);
+    memcpy(&last, &UT_CF_Journal_File.data[UT_CF_Journal_File.len - sizeof(last)], sizeof(last));
+    UtAssert_UINT32_EQ(last.offset, 700);
+    UtAssert_UINT32_EQ(last.size, 200);
+    UtAssert_UINT32_EQ(cp.idx, 1);
+    UtAssert_UINT32_EQ(cp.pos, 1);
+    UtAssert_UINT32_EQ(cp.count, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 6);
+
+    /* written in an earlier wakeup, skipped */
+    cp.idx = 0;
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    UtAssert_UINT32_EQ(cp.idx, 1);
+    UtAssert_UINT32_EQ(cp.pos, 1);
+
+    /* no room left in this wakeup */
+    cp.count = CF_JOURNAL_RECORDS_PER_WAKEUP;
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_EXIT);
+    UtAssert_BOOL_TRUE(cp.yield);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    UtAssert_BOOL_FALSE(cp.error);
+
+    /* out of time */
+    cp.count = 1;
+    cp.yield = false;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_BudgetSpent), 1, true);
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_EXIT);
+    UtAssert_BOOL_TRUE(cp.yield);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    cp.yield = false;
+
+    /* failure writing the record */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_EXIT);
+    UtAssert_BOOL_TRUE(cp.error);
+    UtAssert_UINT32_EQ(cp.num_records, 1);
+
+    /* failure writing the chunks */
+    cp.error = false;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, -1);
+    UtAssert_INT32_EQ(CF_Journal_WriteTxn(&txn.cl_node, &cp), CF_CLIST_EXIT);
+    UtAssert_BOOL_TRUE(cp.error);
+    UtAssert_UINT32_EQ(cp.num_records, 1);
+}
+
+void Test_CF_Journal_WriteStart(void)
+{
+    /* Test case for:
+     * void CF_Journal_WriteStart(uint32 digest);
+     */
+    CF_Checkpoint_t *cp = &CF_AppData.engine.checkpoint;
+
+    /* failure to create the file */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_Journal_WriteStart(1));
+    UT_CF_AssertEventID(CF_JOURNAL_WRITE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_BOOL_FALSE(cp->busy);
+
+    /* nominal, only the placeholder header is written */
+    cf_journal_tests_Setup();
+    cp->chan_num = CF_NUM_CHANNELS;
+    UtAssert_VOIDCALL(CF_Journal_WriteStart(1));
+    UtAssert_BOOL_TRUE(cp->busy);
+    UtAssert_BOOL_FALSE(cp->error);
+    UtAssert_UINT32_EQ(cp->digest, 1);
+    UtAssert_ZERO(cp->chan_num);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 2);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 0);
+    UtAssert_UINT32_EQ(UT_CF_Journal_File.len, sizeof(CF_JournalHeader_t));
+
+    /* failure writing the placeholder header, left for CF_Journal_WriteFinish() to report */
+    cf_journal_tests_Setup();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_VOIDCALL(CF_Journal_WriteStart(1));
+    UtAssert_BOOL_TRUE(cp->busy);
+    UtAssert_BOOL_TRUE(cp->error);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+}
+
+void Test_CF_Journal_WriteStep(void)
+{
+    /* Test case for:
+     * bool CF_Journal_WriteStep(void);
+     */
+    CF_Checkpoint_t *cp = &CF_AppData.engine.checkpoint;
+
+    /* nothing to write */
+    cp->busy = true;
+    UtAssert_BOOL_TRUE(CF_Journal_WriteStep());
+    UtAssert_STUB_COUNT(CF_CList_Traverse, CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(cp->chan_num, CF_NUM_CHANNELS);
+    UtAssert_ZERO(cp->num_records);
+
+    /* one entry per wakeup once out of time, RX queue first and then the spill index */
+    cf_journal_tests_Setup();
+    UT_CF_Journal_Setup_Rx();
+    CF_AppData.engine.channels[UT_CFDP_CHANNEL].num_spilled = 1;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_BudgetSpent), true);
+    cp->busy = true;
+    UtAssert_BOOL_FALSE(CF_Journal_WriteStep());
+    UtAssert_UINT32_EQ(cp->chan_num, UT_CFDP_CHANNEL);
+    UtAssert_UINT32_EQ(cp->pos, 1);
+    UtAssert_UINT32_EQ(cp->num_records, 1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_BOOL_FALSE(CF_Journal_WriteStep());
+    UtAssert_UINT32_EQ(cp->pos, 2);
+    UtAssert_UINT32_EQ(cp->num_records, 2);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_STUB_COUNT(CF_Spill_GetName, 0);
+
+    /* the spill entry is counted even though its file does not open */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_TRUE(CF_Journal_WriteStep());
+    UtAssert_STUB_COUNT(CF_Spill_GetName, 1);
+    UtAssert_UINT32_EQ(cp->chan_num, CF_NUM_CHANNELS);
+    UtAssert_UINT32_EQ(cp->num_records, 2);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+
+    /* a failed write ends the checkpoint */
+    cf_journal_tests_Setup();
+    cp->busy  = true;
+    cp->error = true;
+    UtAssert_BOOL_TRUE(CF_Journal_WriteStep());
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 0);
+}
+
+void Test_CF_Journal_WriteFinish(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Journal_WriteFinish(void);
+     */
+    CF_Checkpoint_t   *cp = &CF_AppData.engine.checkpoint;
+    CF_JournalHeader_t hdr;
+
+    /* nominal, header is rewritten with the totals and the file is renamed into place */
+    cp->busy                  = true;
+    cp->num_records           = 3;
+    CF_AppData.engine.seq_num = 55;
+    UT_CF_Journal_File.pos    = sizeof(hdr) + 100;
+    UT_CF_Journal_File.len    = sizeof(hdr) + 100;
+    UtAssert_INT32_EQ(CF_Journal_WriteFinish(), CFE_SUCCESS);
+    UtAssert_BOOL_FALSE(cp->busy);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(OS_rename, 1);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    memcpy(&hdr, UT_CF_Journal_File.data, sizeof(hdr));
+    UtAssert_UINT32_EQ(hdr.magic, CF_JOURNAL_MAGIC);
+    UtAssert_UINT32_EQ(hdr.version, CF_JOURNAL_VERSION);
+    UtAssert_UINT32_EQ(hdr.num_records, 3);
+    UtAssert_UINT32_EQ(hdr.body_crc, UT_CF_JOURNAL_CRC);
+    UtAssert_UINT32_EQ(hdr.seq_num, 55);
+
+    /* transactions came or went while it was written, dropped without an event */
+    cf_journal_tests_Setup();
+    UT_SetHandlerFunction(UT_KEY(CF_CRC_Finalize), UT_CF_Journal_CrcFinalizeCount, NULL);
+    cp->busy = true;
+    UtAssert_INT32_EQ(CF_Journal_WriteFinish(), CF_ERROR);
+    UtAssert_BOOL_FALSE(cp->busy);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(OS_rename, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* an earlier write failed */
+    cf_journal_tests_Setup();
+    cp->busy  = true;
+    cp->error = true;
+    UtAssert_INT32_EQ(CF_Journal_WriteFinish(), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(OS_rename, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UT_CF_AssertEventID(CF_JOURNAL_WRITE_ERR_EID);
+
+    /* failure seeking back to the header */
+    cf_journal_tests_Setup();
+    cp->busy = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_Journal_WriteFinish(), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_STUB_COUNT(OS_rename, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UT_CF_AssertEventID(CF_JOURNAL_WRITE_ERR_EID);
+
+    /* failure renaming the new journal into place */
+    cf_journal_tests_Setup();
+    cp->busy = true;
+    UT_SetDeferredRetcode(UT_KEY(OS_rename), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Journal_WriteFinish(), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UT_CF_AssertEventID(CF_JOURNAL_WRITE_ERR_EID);
+}
+
+void Test_CF_Journal_WriteSpilled(void)
+{
+    /* Test case for:
+     * void CF_Journal_WriteSpilled(CF_Checkpoint_t *cp, uint8 chan_num, const CF_SpillEntry_t *entry);
+     */
+    CF_Checkpoint_t    cp;
+    CF_SpillEntry_t    entry;
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         rec_chunks[CF_CHUNK_BLOCK_SIZE + 1];
+
+    memset(&cp, 0, sizeof(cp));
+    memset(&entry, 0, sizeof(entry));
+    memset(rec_chunks, 0, sizeof(rec_chunks));
+    UT_CF_Journal_Setup_Record(&rec, CF_CHUNK_BLOCK_SIZE + 1);
+    rec_chunks[CF_CHUNK_BLOCK_SIZE].offset = 300;
+
+    /* the spill file is read from a file of its own */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_CF_Journal_Read, &UT_CF_Journal_SpillFile);
+
+    /* spill file does not open */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_Journal_WriteSpilled(&cp, UT_CFDP_CHANNEL, &entry));
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_ZERO(cp.num_records);
+    UtAssert_UINT32_EQ(cp.pos, 1);
+    UtAssert_UINT32_EQ(cp.count, 1);
+
+    /* spill file belongs to a different channel */
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_SpillFile     = UT_CF_Journal_File;
+    UT_CF_Journal_SpillFile.pos = sizeof(CF_JournalHeader_t);
+    memset(&UT_CF_Journal_File, 0, sizeof(UT_CF_Journal_File));
+    UtAssert_VOIDCALL(CF_Journal_WriteSpilled(&cp, UT_CFDP_CHANNEL + 1, &entry));
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_ZERO(cp.num_records);
+
+    /* nominal, the record and its chunks are copied over */
+    UT_CF_Journal_SpillFile.pos = sizeof(CF_JournalHeader_t);
+    UtAssert_VOIDCALL(CF_Journal_WriteSpilled(&cp, UT_CFDP_CHANNEL, &entry));
+    UtAssert_BOOL_FALSE(cp.error);
+    UtAssert_UINT32_EQ(cp.num_records, 1);
+    UtAssert_UINT32_EQ(UT_CF_Journal_File.len, sizeof(rec) + sizeof(rec_chunks));
+    UtAssert_MemCmp(UT_CF_Journal_File.data, &rec, sizeof(rec), "Record copied");
+    UtAssert_MemCmp(&UT_CF_Journal_File.data[sizeof(rec)], rec_chunks, sizeof(rec_chunks), "Chunks copied");
+
+    /* spill file is short */
+    UT_CF_Journal_SpillFile.pos = sizeof(CF_JournalHeader_t);
+    UT_CF_Journal_SpillFile.len -= 1;
+    UtAssert_VOIDCALL(CF_Journal_WriteSpilled(&cp, UT_CFDP_CHANNEL, &entry));
+    UtAssert_BOOL_TRUE(cp.error);
+
+    /* failure writing the journal */
+    cp.error                    = false;
+    UT_CF_Journal_SpillFile.pos = sizeof(CF_JournalHeader_t);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_VOIDCALL(CF_Journal_WriteSpilled(&cp, UT_CFDP_CHANNEL, &entry));
+    UtAssert_BOOL_TRUE(cp.error);
+}
+
+void Test_CF_Journal_Tick(void)
+{
+    /* Test case for:
+     * void CF_Journal_Tick(void);
+     */
+    uint32 digest;
+
+    /* disabled by interval */
+    UT_CF_Journal_Config.checkpoint_interval_s = 0;
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_Expired, 0);
+
+    /* disabled by file name */
+    UT_CF_Journal_Config.checkpoint_interval_s = 10;
+    UT_CF_Journal_Config.journal_file[0]       = 0;
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_Expired, 0);
+    strcpy(UT_CF_Journal_Config.journal_file, "/ut/journal.dat");
+
+    /* timer running */
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* timer expired, first checkpoint written and timer rearmed */
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(OS_rename, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_BOOL_TRUE(CF_AppData.engine.checkpoint_saved);
+    UtAssert_UINT32_EQ(CF_AppData.engine.checkpoint_digest, UT_CF_JOURNAL_CRC);
+
+    /* nothing changed since, not rewritten but the timer is still rearmed */
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 2);
+
+    /* changed, written again */
+    digest = ~UT_CF_JOURNAL_CRC;
+    UT_SetHandlerFunction(UT_KEY(CF_CRC_Finalize), UT_CF_Journal_CrcFinalize, &digest);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 2);
+    UtAssert_STUB_COUNT(OS_rename, 2);
+    UtAssert_UINT32_EQ(CF_AppData.engine.checkpoint_digest, ~UT_CF_JOURNAL_CRC);
+
+    /* a failed write is tried again at the next expiry */
+    digest = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 3);
+    UtAssert_UINT32_EQ(CF_AppData.engine.checkpoint_digest, ~UT_CF_JOURNAL_CRC);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 4);
+    UtAssert_UINT32_EQ(CF_AppData.engine.checkpoint_digest, 1);
+
+    /* written over two wakeups, a timer expiry in between does not start it over */
+    cf_journal_tests_Setup();
+    UT_CF_Journal_Setup_Rx();
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_BudgetSpent), true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_BOOL_TRUE(CF_AppData.engine.checkpoint.busy);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.checkpoint_saved);
+    UtAssert_STUB_COUNT(OS_rename, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
+    UtAssert_VOIDCALL(CF_Journal_Tick());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 2);
+    UtAssert_STUB_COUNT(OS_rename, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.checkpoint.busy);
+    UtAssert_BOOL_TRUE(CF_AppData.engine.checkpoint_saved);
+    UtAssert_UINT32_EQ(CF_AppData.engine.checkpoint.num_records, 2);
+}
+
+void Test_CF_Journal_DigestTxn(void)
+{
+    /* Test case for:
+     * CF_CListTraverse_Status_t CF_Journal_DigestTxn(CF_CListNode_t *node, void *context);
+     */
+    CF_Transaction_t  txn;
+    CF_History_t      history;
+    CF_ChunkWrapper_t chunks;
+    CF_Chunk_t        block0[CF_CHUNK_BLOCK_SIZE];
+    CF_Chunk_t        block1[CF_CHUNK_BLOCK_SIZE];
+    CF_Chunk_t       *blocks[2] = { block0, block1 };
+    CF_Crc_t          crc;
+
+    memset(&txn, 0, sizeof(txn));
+    memset(&history, 0, sizeof(history));
+    memset(&chunks, 0, sizeof(chunks));
+    memset(&crc, 0, sizeof(crc));
+
+    txn.history                   = &history;
+    txn.chunks                    = &chunks;
+    txn.state_data.sub_state      = CF_RxSubState_DATA_NORMAL;
+    txn.flags.rx.tempfile_created = true;
+    chunks.chunks.blocks          = blocks;
+    chunks.chunks.count           = CF_CHUNK_BLOCK_SIZE + 1;
+
+    /* not eligible, nothing digested */
+    txn.state = CF_TxnState_R1;
+    UtAssert_INT32_EQ(CF_Journal_DigestTxn(&txn.cl_node, &crc), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 0);
+
+    /* nominal, the record and both blocks of chunks, nothing written */
+    txn.state = CF_TxnState_R2;
+    UtAssert_INT32_EQ(CF_Journal_DigestTxn(&txn.cl_node, &crc), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 3);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+}
+
+void Test_CF_Journal_Digest(void)
+{
+    /* Test case for:
+     * uint32 CF_Journal_Digest(void);
+     */
+
+    /* each channel is traversed, the spill entries and the sequence number are digested, nothing is read */
+    CF_AppData.engine.channels[UT_CFDP_CHANNEL].num_spilled = 2;
+    UtAssert_UINT32_EQ(CF_Journal_Digest(), UT_CF_JOURNAL_CRC);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, (2 * 2) + CF_NUM_CHANNELS + 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+}
+
+void Test_CF_Journal_Verify(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Journal_Verify(osal_id_t fd, const CF_JournalHeader_t *hdr);
+     */
+    CF_JournalHeader_t hdr;
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         chunks[CF_CHUNK_BLOCK_SIZE + 1];
+    osal_id_t          fd = OS_ObjectIdFromInteger(1);
+
+    memset(chunks, 0, sizeof(chunks));
+    UT_CF_Journal_Setup_Record(&rec, CF_CHUNK_BLOCK_SIZE + 1);
+
+    /* nominal, empty journal */
+    UT_CF_Journal_Setup_File(NULL, NULL);
+    memcpy(&hdr, UT_CF_Journal_File.data, sizeof(hdr));
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CFE_SUCCESS);
+
+    /* nominal, one record with chunks spanning two blocks */
+    UT_CF_Journal_Setup_File(&rec, chunks);
+    memcpy(&hdr, UT_CF_Journal_File.data, sizeof(hdr));
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(UT_CF_Journal_File.pos, UT_CF_Journal_File.len);
+
+    /* checksum mismatch */
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    hdr.body_crc           = ~UT_CF_JOURNAL_CRC;
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+    hdr.body_crc = UT_CF_JOURNAL_CRC;
+
+    /* bad magic or version */
+    hdr.magic = 0;
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+    hdr.magic   = CF_JOURNAL_MAGIC;
+    hdr.version = CF_JOURNAL_VERSION + 1;
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+    hdr.version = CF_JOURNAL_VERSION;
+
+    /* truncated in the chunks */
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UT_CF_Journal_File.len -= sizeof(CF_Chunk_t);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+
+    /* truncated in the record */
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UT_CF_Journal_File.len = sizeof(hdr) + sizeof(rec) - 1;
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+
+    /* record for a channel that does not exist */
+    rec.chan_num = CF_NUM_CHANNELS;
+    UT_CF_Journal_Setup_File(&rec, chunks);
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+    rec.chan_num = UT_CFDP_CHANNEL;
+
+    /* record in a state that cannot be resumed */
+    rec.sub_state = CF_RxSubState_FILESTORE;
+    UT_CF_Journal_Setup_File(&rec, chunks);
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+    rec.sub_state = CF_RxSubState_DATA_EOF;
+
+    /* more chunks than the channel now allows */
+    UT_CF_Journal_Config.chan[UT_CFDP_CHANNEL].rx_chunks_per_transaction = CF_CHUNK_BLOCK_SIZE;
+    UT_CF_Journal_Setup_File(&rec, chunks);
+    UT_CF_Journal_File.pos = sizeof(hdr);
+    UtAssert_INT32_EQ(CF_Journal_Verify(fd, &hdr), CF_ERROR);
+}
+
+void Test_CF_Journal_ResumeTxn(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Journal_ResumeTxn(CF_Transaction_t *txn, osal_id_t fd, const CF_JournalRecord_t *rec);
+     */
+    CF_Transaction_t   txn;
+    CF_History_t       history;
+    CF_ChunkWrapper_t  chunks;
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         rec_chunks[3];
+    osal_id_t          fd = OS_ObjectIdFromInteger(1);
+
+    memset(rec_chunks, 0, sizeof(rec_chunks));
+    UT_CF_Journal_Setup_Record(&rec, 3);
+    rec.sub_state = CF_RxSubState_VALIDATE;
+
+    /* no transaction available, the chunks are still consumed */
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks);
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(NULL, fd, &rec), CF_ERROR);
+    UtAssert_UINT32_EQ(UT_CF_Journal_File.pos, UT_CF_Journal_File.len);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UT_CF_AssertEventID(CF_JOURNAL_RESUME_ERR_EID);
+
+    /* nominal */
+    cf_journal_tests_Setup();
+    memset(&txn, 0, sizeof(txn));
+    memset(&history, 0, sizeof(history));
+    txn.history = &history;
+    txn.chunks  = &chunks;
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks);
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(&txn, fd, &rec), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_ArmInactTimer, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UtAssert_INT32_EQ(txn.state, CF_TxnState_R2);
+    UtAssert_BOOL_TRUE(txn.reliable_mode);
+    UtAssert_UINT32_EQ(txn.state_data.sub_state, CF_RxSubState_DATA_EOF);
+    UtAssert_UINT32_EQ(txn.fsize, 1000);
+    UtAssert_UINT32_EQ(txn.state_data.rx_progress, 800);
+    UtAssert_UINT32_EQ(history.src_eid, 12);
+    UtAssert_UINT32_EQ(history.seq_num, 34);
+    UtAssert_BOOL_TRUE(txn.flags.rx.tempfile_created);
+    UtAssert_BOOL_TRUE(txn.flags.rx.md_recv);
+    UtAssert_BOOL_TRUE(txn.flags.rx.delta);
+    UtAssert_BOOL_FALSE(txn.flags.com.suspended);
+    UtAssert_UINT32_EQ(txn.compress, CF_Compress_LZ4);
+
+    /* nominal, before EOF stays in DATA_NORMAL, suspended stays suspended */
+    cf_journal_tests_Setup();
+    memset(&txn, 0, sizeof(txn));
+    txn.history   = &history;
+    txn.chunks    = &chunks;
+    rec.sub_state = CF_RxSubState_DATA_NORMAL;
+    rec.eof_count = 0;
+    rec.suspended = true;
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks);
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(&txn, fd, &rec), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(txn.state_data.sub_state, CF_RxSubState_DATA_NORMAL);
+    UtAssert_ZERO(txn.flags.rx.eof_count);
+    UtAssert_BOOL_TRUE(txn.flags.com.suspended);
+
+    /* no chunk list available */
+    cf_journal_tests_Setup();
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_TxnIsOK), 1, false);
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks);
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(&txn, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+
+    /* temp file is gone */
+    cf_journal_tests_Setup();
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks);
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(&txn, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+    UT_CF_AssertEventID(CF_JOURNAL_RESUME_ERR_EID);
+
+    /* journal truncated in the chunks */
+    cf_journal_tests_Setup();
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.pos = UT_CF_Journal_File.len - sizeof(rec_chunks) + 1;
+    UtAssert_INT32_EQ(CF_Journal_ResumeTxn(&txn, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+}
+
+void Test_CF_Journal_Restore(void)
+{
+    /* Test case for:
+     * void CF_Journal_Restore(void);
+     */
+    CF_Transaction_t   txn;
+    CF_History_t       history;
+    CF_ChunkWrapper_t  chunks;
+    CF_JournalRecord_t rec;
+    CF_Chunk_t         rec_chunks[2];
+
+    memset(rec_chunks, 0, sizeof(rec_chunks));
+    UT_CF_Journal_Setup_Record(&rec, 2);
+
+    /* checkpointing disabled */
+    UT_CF_Journal_Config.checkpoint_interval_s = 0;
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UT_CF_Journal_Config.checkpoint_interval_s = 10;
+
+    /* no journal */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* journal too short for a header */
+    UT_CF_Journal_Setup_File(NULL, NULL);
+    UT_CF_Journal_File.len = sizeof(CF_JournalHeader_t) - 1;
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UT_CF_AssertEventID(CF_JOURNAL_READ_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* journal truncated, fails verification and nothing is resumed */
+    cf_journal_tests_Setup();
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UT_CF_Journal_File.len -= 1;
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UT_CF_AssertEventID(CF_JOURNAL_READ_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 0);
+    UtAssert_ZERO(CF_AppData.engine.seq_num);
+
+    /* nominal, one transaction resumed */
+    cf_journal_tests_Setup();
+    memset(&txn, 0, sizeof(txn));
+    memset(&history, 0, sizeof(history));
+    txn.history = &history;
+    txn.chunks  = &chunks;
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_AltHandler_GenericPointerReturn, &txn);
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UT_CF_AssertEventID(CF_JOURNAL_RESTORE_INF_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 1);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 2);
+    UtAssert_INT32_EQ(txn.state, CF_TxnState_R2);
+    UtAssert_BOOL_TRUE(txn.flags.rx.send_nak);
+    UtAssert_UINT32_EQ(CF_AppData.engine.seq_num, 1000);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_Spill_Keep, 0);
+
+    /* temp file is gone, the spill file is left alone */
+    cf_journal_tests_Setup();
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_AltHandler_GenericPointerReturn, &txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 2, -1);
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UT_CF_AssertEventID(CF_JOURNAL_RESUME_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 1);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(CF_Spill_Keep, 0);
+
+    /* no free RX slot, the transaction goes back into the spill index */
+    cf_journal_tests_Setup();
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 1);
+    UtAssert_STUB_COUNT(CF_Spill_Keep, 1);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UT_CF_AssertEventID(CF_JOURNAL_RESTORE_INF_EID);
+    UtAssert_UINT32_EQ(CF_AppData.engine.seq_num, 1000);
+
+    /* no free RX slot, and no room in the spill index either */
+    cf_journal_tests_Setup();
+    UT_SetDeferredRetcode(UT_KEY(CF_Spill_Keep), 1, CF_ERROR);
+    UT_CF_Journal_Setup_File(&rec, rec_chunks);
+    UtAssert_VOIDCALL(CF_Journal_Restore());
+    UtAssert_STUB_COUNT(CF_Spill_Keep, 1);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UT_CF_AssertEventID(CF_JOURNAL_RESTORE_INF_EID);
+}
+
+/*******************************************************************************
+**
+**  cf_journal_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Journal_IsEligible, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_IsEligible");
+    UtTest_Add(Test_CF_Journal_WriteTxn, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_WriteTxn");
+    UtTest_Add(Test_CF_Journal_WriteStart, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_WriteStart");
+    UtTest_Add(Test_CF_Journal_WriteStep, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_WriteStep");
+    UtTest_Add(
+        Test_CF_Journal_WriteFinish, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_WriteFinish");
+    UtTest_Add(
+        Test_CF_Journal_WriteSpilled, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_WriteSpilled");
+    UtTest_Add(Test_CF_Journal_Tick, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_Tick");
+    UtTest_Add(Test_CF_Journal_DigestTxn, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_DigestTxn");
+    UtTest_Add(Test_CF_Journal_Digest, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_Digest");
+    UtTest_Add(Test_CF_Journal_Verify, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_Verify");
+    UtTest_Add(Test_CF_Journal_ResumeTxn, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_ResumeTxn");
+    UtTest_Add(Test_CF_Journal_Restore, cf_journal_tests_Setup, cf_journal_tests_Teardown, "CF_Journal_Restore");
+}
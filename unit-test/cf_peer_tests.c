@@ -0,0 +1,165 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_peer.h"
+#include "cf_rtt.h"
+#include "cf_app.h"
+
+/*******************************************************************************
+**
+**  cf_peer_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_peer_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&CF_AppData.peer, 0, sizeof(CF_AppData.peer));
+}
+
+void cf_peer_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_peer_tests
+**
+*******************************************************************************/
+
+void Test_CF_Peer_Init(void)
+{
+    /* Act */
+    UtAssert_VOIDCALL(CF_Peer_Init());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+}
+
+void Test_CF_Peer_Count(void)
+{
+    /* Arrange */
+    CF_PeerPacket_Payload_t *pl = &CF_AppData.peer.pkt.Payload;
+
+    /* Act - a new peer takes the first entry */
+    UtAssert_VOIDCALL(CF_Peer_Count(10, CF_PeerCounter_PDU_RECV, 1));
+
+    /* Assert */
+    UtAssert_UINT32_EQ(pl->num_peers, 1);
+    UtAssert_UINT32_EQ(pl->peer[0].eid, 10);
+    UtAssert_UINT32_EQ(pl->peer[0].counters[CF_PeerCounter_PDU_RECV], 1);
+
+    /* the same peer again, and a second one */
+    UtAssert_VOIDCALL(CF_Peer_Count(10, CF_PeerCounter_BYTES_RECV, 500));
+    UtAssert_VOIDCALL(CF_Peer_Count(20, CF_PeerCounter_NAK_SEGS_SENT, 3));
+    UtAssert_VOIDCALL(CF_Peer_Count(10, CF_PeerCounter_BYTES_RECV, 500));
+    UtAssert_UINT32_EQ(pl->num_peers, 2);
+    UtAssert_UINT32_EQ(pl->peer[0].counters[CF_PeerCounter_BYTES_RECV], 1000);
+    UtAssert_UINT32_EQ(pl->peer[1].eid, 20);
+    UtAssert_UINT32_EQ(pl->peer[1].counters[CF_PeerCounter_NAK_SEGS_SENT], 3);
+    UtAssert_ZERO(pl->evictions);
+}
+
+void Test_CF_Peer_Count_Evict(void)
+{
+    /* Arrange */
+    CF_PeerPacket_Payload_t *pl       = &CF_AppData.peer.pkt.Payload;
+    static const uint32      starts[] = { 0, UINT32_MAX - 5 };
+    uint32                   i;
+    uint32                   j;
+
+    /* the second time, the count of times seen wraps around while the table fills */
+    for (j = 0; j < 2; ++j)
+    {
+        CF_Peer_Reset();
+        CF_AppData.peer.seen_count = starts[j];
+
+        /* fill the table with peers 100 and up, then see peer 100 again */
+        for (i = 0; i < CF_MAX_PEER_STATS; ++i)
+        {
+            CF_Peer_Count(100 + i, CF_PeerCounter_PDU_SENT, 1);
+        }
+        CF_Peer_Count(100, CF_PeerCounter_PDU_SENT, 1);
+
+        /* Act - peer 101 is now the least recently seen */
+        UtAssert_VOIDCALL(CF_Peer_Count(200, CF_PeerCounter_INACTIVITY, 1));
+
+        /* Assert */
+        UtAssert_UINT32_EQ(pl->num_peers, CF_MAX_PEER_STATS);
+        UtAssert_UINT32_EQ(pl->evictions, 1);
+        UtAssert_UINT32_EQ(pl->peer[0].eid, 100);
+        UtAssert_UINT32_EQ(pl->peer[0].counters[CF_PeerCounter_PDU_SENT], 2);
+        UtAssert_UINT32_EQ(pl->peer[1].eid, 200);
+        UtAssert_ZERO(pl->peer[1].counters[CF_PeerCounter_PDU_SENT]);
+        UtAssert_UINT32_EQ(pl->peer[1].counters[CF_PeerCounter_INACTIVITY], 1);
+    }
+}
+
+void Test_CF_Peer_Reset(void)
+{
+    /* Arrange */
+    CF_Peer_Count(10, CF_PeerCounter_CRC_MISMATCH, 1);
+    CF_AppData.peer.pkt.Payload.evictions = 3;
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Peer_Reset());
+
+    /* Assert */
+    UtAssert_MemCmpValue(&CF_AppData.peer.pkt.Payload, 0, sizeof(CF_AppData.peer.pkt.Payload), "payload cleared");
+    UtAssert_MemCmpValue(CF_AppData.peer.last_seen, 0, sizeof(CF_AppData.peer.last_seen), "ages cleared");
+    UtAssert_ZERO(CF_AppData.peer.seen_count);
+}
+
+void Test_CF_Peer_Send(void)
+{
+    /* Arrange */
+    CF_PeerPacket_Payload_t *pl = &CF_AppData.peer.pkt.Payload;
+
+    CF_Peer_Count(10, CF_PeerCounter_PDU_SENT, 1);
+    CF_Peer_Count(20, CF_PeerCounter_PDU_SENT, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_Rtt_GetSrtt), 2, 250);
+
+    /* Act */
+    UtAssert_VOIDCALL(CF_Peer_Send());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_Rtt_GetSrtt, 2);
+    UtAssert_ZERO(pl->peer[0].srtt_ms);
+    UtAssert_UINT32_EQ(pl->peer[1].srtt_ms, 250);
+    UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_peer_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Peer_Init, cf_peer_tests_Setup, cf_peer_tests_Teardown, "CF_Peer_Init");
+    UtTest_Add(Test_CF_Peer_Count, cf_peer_tests_Setup, cf_peer_tests_Teardown, "CF_Peer_Count");
+    UtTest_Add(Test_CF_Peer_Count_Evict, cf_peer_tests_Setup, cf_peer_tests_Teardown, "CF_Peer_Count_Evict");
+    UtTest_Add(Test_CF_Peer_Reset, cf_peer_tests_Setup, cf_peer_tests_Teardown, "CF_Peer_Reset");
+    UtTest_Add(Test_CF_Peer_Send, cf_peer_tests_Setup, cf_peer_tests_Teardown, "CF_Peer_Send");
+}
@@ -0,0 +1,415 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_pollidx.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+/* stands in for the index file, the wrapped I/O calls read and write this */
+typedef struct
+{
+    uint8  data[1024];
+    size_t pos;
+    size_t len;
+} UT_CF_PollIdx_File_t;
+
+static UT_CF_PollIdx_File_t UT_CF_PollIdx_File;
+static CF_ConfigTable_t     UT_CF_PollIdx_Config;
+static uint32               UT_CF_PollIdx_Now;   /* seconds returned by OS_GetLocalTime() */
+static uint32               UT_CF_PollIdx_MTime; /* modification time returned by OS_stat() */
+
+static void UT_CF_PollIdx_Write(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const void *buf  = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t      size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32       status;
+
+    /* a forced status code simulates an I/O error */
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        memcpy(&UT_CF_PollIdx_File.data[UT_CF_PollIdx_File.pos], buf, size);
+        UT_CF_PollIdx_File.pos += size;
+        if (UT_CF_PollIdx_File.pos > UT_CF_PollIdx_File.len)
+        {
+            UT_CF_PollIdx_File.len = UT_CF_PollIdx_File.pos;
+        }
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_PollIdx_Read(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void  *buf  = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    size_t size = UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32  status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        if (size > (UT_CF_PollIdx_File.len - UT_CF_PollIdx_File.pos))
+        {
+            size = UT_CF_PollIdx_File.len - UT_CF_PollIdx_File.pos;
+        }
+        memcpy(buf, &UT_CF_PollIdx_File.data[UT_CF_PollIdx_File.pos], size);
+        UT_CF_PollIdx_File.pos += size;
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_PollIdx_Lseek(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    int32 status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        UT_CF_PollIdx_File.pos = UT_Hook_GetArgValueByName(Context, "offset", off_t);
+        status                 = UT_CF_PollIdx_File.pos;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_PollIdx_Stat(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    os_fstat_t *filestats = UT_Hook_GetArgValueByName(Context, "filestats", os_fstat_t *);
+    int32       status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        memset(filestats, 0, sizeof(*filestats));
+        filestats->FileTime = OS_TimeFromTotalSeconds(UT_CF_PollIdx_MTime);
+        status              = OS_SUCCESS;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_PollIdx_GetLocalTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    OS_time_t *time_struct = UT_Hook_GetArgValueByName(Context, "time_struct", OS_time_t *);
+
+    *time_struct = OS_TimeFromTotalSeconds(UT_CF_PollIdx_Now);
+}
+
+/* rewinds the index file, so what was saved can be loaded */
+static void UT_CF_PollIdx_Rewind(void)
+{
+    UT_CF_PollIdx_File.pos = 0;
+}
+
+/*******************************************************************************
+**
+**  cf_pollidx_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_pollidx_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_PollIdx_File, 0, sizeof(UT_CF_PollIdx_File));
+    memset(&UT_CF_PollIdx_Config, 0, sizeof(UT_CF_PollIdx_Config));
+
+    UT_CF_PollIdx_Now   = 1000;
+    UT_CF_PollIdx_MTime = 900;
+
+    UT_CF_PollIdx_Config.poll_settle_s = 5;
+    strcpy(UT_CF_PollIdx_Config.poll_index_file, "/ut/pollidx.dat");
+    strcpy(UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].src_dir, "/ut/poll");
+    UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].enabled = 1;
+    CF_AppData.config_table                                       = &UT_CF_PollIdx_Config;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_PollIdx_Write, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_CF_PollIdx_Read, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedLseek), UT_CF_PollIdx_Lseek, NULL);
+    UT_SetHandlerFunction(UT_KEY(OS_stat), UT_CF_PollIdx_Stat, NULL);
+    UT_SetHandlerFunction(UT_KEY(OS_GetLocalTime), UT_CF_PollIdx_GetLocalTime, NULL);
+}
+
+void cf_pollidx_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_PollIdx_Unchanged(void)
+{
+    /* Test case for:
+     * bool CF_PollIdx_Unchanged(const CF_Poll_t *poll, const CF_PollDir_t *pd);
+     */
+    CF_Poll_t          *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+    const CF_PollDir_t *pd   = &UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1];
+
+    /* never settled */
+    UtAssert_BOOL_FALSE(CF_PollIdx_Unchanged(poll, pd));
+    UtAssert_STUB_COUNT(OS_stat, 0);
+
+    /* settled and unchanged */
+    poll->settled   = true;
+    poll->dir_mtime = 900;
+    UtAssert_BOOL_TRUE(CF_PollIdx_Unchanged(poll, pd));
+
+    /* settled, but modified since */
+    UT_CF_PollIdx_MTime = 901;
+    UtAssert_BOOL_FALSE(CF_PollIdx_Unchanged(poll, pd));
+
+    /* directory cannot be examined */
+    UT_CF_PollIdx_MTime = 900;
+    UT_SetDeferredRetcode(UT_KEY(OS_stat), 1, OS_ERROR);
+    UtAssert_BOOL_FALSE(CF_PollIdx_Unchanged(poll, pd));
+}
+
+void Test_CF_PollIdx_BeginScan(void)
+{
+    /* Test case for:
+     * void CF_PollIdx_BeginScan(CF_Poll_t *poll);
+     */
+    CF_Poll_t *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+
+    poll->pb.rescan = true;
+    UtAssert_VOIDCALL(CF_PollIdx_BeginScan(poll));
+    UtAssert_BOOL_TRUE(poll->pb.polled);
+    UtAssert_BOOL_FALSE(poll->pb.rescan);
+    UtAssert_UINT32_EQ(poll->scan_start, 1000);
+}
+
+void Test_CF_PollIdx_EndScan(void)
+{
+    /* Test case for:
+     * void CF_PollIdx_EndScan(CF_Poll_t *poll, const CF_PollDir_t *pd);
+     */
+    CF_Poll_t          *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+    const CF_PollDir_t *pd   = &UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1];
+
+    /* directory modified during the scan (by sending files), not settled yet */
+    poll->scan_start    = 950;
+    UT_CF_PollIdx_MTime = 950;
+    UtAssert_VOIDCALL(CF_PollIdx_EndScan(poll, pd));
+    UtAssert_BOOL_FALSE(poll->settled);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* directory not modified since the scan started, settled and saved */
+    UT_CF_PollIdx_MTime = 949;
+    UtAssert_VOIDCALL(CF_PollIdx_EndScan(poll, pd));
+    UtAssert_BOOL_TRUE(poll->settled);
+    UtAssert_UINT32_EQ(poll->dir_mtime, 949);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+
+    /* still settled the same way, nothing to save */
+    UtAssert_VOIDCALL(CF_PollIdx_EndScan(poll, pd));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+
+    /* a file was left behind */
+    poll->pb.rescan = true;
+    UtAssert_VOIDCALL(CF_PollIdx_EndScan(poll, pd));
+    UtAssert_BOOL_FALSE(poll->settled);
+    UtAssert_STUB_COUNT(OS_stat, 3);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 2);
+
+    /* directory cannot be examined */
+    poll->pb.rescan = false;
+    poll->settled   = true;
+    UT_SetDeferredRetcode(UT_KEY(OS_stat), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_PollIdx_EndScan(poll, pd));
+    UtAssert_BOOL_FALSE(poll->settled);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 3);
+}
+
+void Test_CF_PollIdx_Invalidate(void)
+{
+    /* Test case for:
+     * void CF_PollIdx_Invalidate(CF_Poll_t *poll);
+     */
+    CF_Poll_t *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+
+    poll->settled   = true;
+    poll->dir_mtime = 900;
+    UtAssert_VOIDCALL(CF_PollIdx_Invalidate(poll));
+    UtAssert_BOOL_FALSE(poll->settled);
+    UtAssert_ZERO(poll->dir_mtime);
+}
+
+void Test_CF_PollIdx_FileSettled(void)
+{
+    /* Test case for:
+     * bool CF_PollIdx_FileSettled(const char *path);
+     */
+
+    /* modified long ago */
+    UtAssert_BOOL_TRUE(CF_PollIdx_FileSettled("/ut/poll/file"));
+
+    /* modified just now */
+    UT_CF_PollIdx_MTime = 996;
+    UtAssert_BOOL_FALSE(CF_PollIdx_FileSettled("/ut/poll/file"));
+
+    /* modified exactly poll_settle_s ago */
+    UT_CF_PollIdx_MTime = 995;
+    UtAssert_BOOL_TRUE(CF_PollIdx_FileSettled("/ut/poll/file"));
+
+    /* file cannot be examined */
+    UT_CF_PollIdx_MTime = 996;
+    UT_SetDeferredRetcode(UT_KEY(OS_stat), 1, OS_ERROR);
+    UtAssert_BOOL_TRUE(CF_PollIdx_FileSettled("/ut/poll/file"));
+
+    /* check disabled */
+    UT_CF_PollIdx_Config.poll_settle_s = 0;
+    UtAssert_BOOL_TRUE(CF_PollIdx_FileSettled("/ut/poll/file"));
+    UtAssert_STUB_COUNT(OS_stat, 4);
+}
+
+void Test_CF_PollIdx_Save(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_PollIdx_Save(void);
+     */
+    CF_Poll_t          *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+    CF_PollIdxHeader_t *hdr  = (CF_PollIdxHeader_t *)UT_CF_PollIdx_File.data;
+    CF_PollIdxRecord_t *rec  = (CF_PollIdxRecord_t *)&UT_CF_PollIdx_File.data[sizeof(*hdr)];
+
+    poll->settled   = true;
+    poll->dir_mtime = 900;
+
+    /* nominal */
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(OS_rename, 1);
+    UtAssert_UINT32_EQ(UT_CF_PollIdx_File.len, sizeof(*hdr) + sizeof(*rec));
+    UtAssert_UINT32_EQ(hdr->magic, CF_POLLIDX_MAGIC);
+    UtAssert_UINT32_EQ(hdr->version, CF_POLLIDX_VERSION);
+    UtAssert_UINT32_EQ(hdr->num_records, 1);
+    UtAssert_STRINGBUF_EQ(rec->src_dir, sizeof(rec->src_dir), "/ut/poll", -1);
+    UtAssert_UINT32_EQ(rec->dir_mtime, 900);
+    UtAssert_UINT32_EQ(rec->chan_num, UT_CFDP_CHANNEL);
+    UtAssert_UINT32_EQ(rec->poll_num, 1);
+
+    /* index file cannot be created */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CF_ERROR);
+    UT_CF_AssertEventID(CF_POLLIDX_WRITE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* write fails */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, -1);
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_rename, 1);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+
+    /* rename fails */
+    UT_SetDeferredRetcode(UT_KEY(OS_rename), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CF_ERROR);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+
+    /* no index file configured */
+    UT_CF_PollIdx_Config.poll_index_file[0] = 0;
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 4);
+}
+
+void Test_CF_PollIdx_Load(void)
+{
+    /* Test case for:
+     * void CF_PollIdx_Load(void);
+     */
+    CF_Poll_t          *poll = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].poll[1];
+    CF_PollIdxHeader_t *hdr  = (CF_PollIdxHeader_t *)UT_CF_PollIdx_File.data;
+
+    /* no index file */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* nominal, round trip through CF_PollIdx_Save() */
+    poll->settled   = true;
+    poll->dir_mtime = 900;
+    UtAssert_INT32_EQ(CF_PollIdx_Save(), CFE_SUCCESS);
+    CF_PollIdx_Invalidate(poll);
+    UT_CF_PollIdx_Rewind();
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_BOOL_TRUE(poll->settled);
+    UtAssert_UINT32_EQ(poll->dir_mtime, 900);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+
+    /* the table polls a different directory now */
+    CF_PollIdx_Invalidate(poll);
+    UT_CF_PollIdx_Rewind();
+    strcpy(UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].src_dir, "/ut/other");
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_BOOL_FALSE(poll->settled);
+
+    /* the polling directory is disabled */
+    UT_CF_PollIdx_Rewind();
+    strcpy(UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].src_dir, "/ut/poll");
+    UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].enabled = 0;
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_BOOL_FALSE(poll->settled);
+    UT_CF_PollIdx_Config.chan[UT_CFDP_CHANNEL].polldir[1].enabled = 1;
+
+    /* record for a polling directory that does not exist */
+    UT_CF_PollIdx_Rewind();
+    ((CF_PollIdxRecord_t *)&UT_CF_PollIdx_File.data[sizeof(*hdr)])->poll_num = CF_MAX_POLLING_DIR_PER_CHAN;
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_BOOL_FALSE(poll->settled);
+
+    /* truncated index */
+    UT_CF_PollIdx_Rewind();
+    hdr->num_records = 2;
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* written by a different version */
+    UT_CF_PollIdx_Rewind();
+    hdr->version = CF_POLLIDX_VERSION + 1;
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UT_CF_AssertEventID(CF_POLLIDX_READ_ERR_EID);
+    UtAssert_BOOL_FALSE(poll->settled);
+
+    /* no index file configured */
+    UT_CF_PollIdx_Config.poll_index_file[0] = 0;
+    UtAssert_VOIDCALL(CF_PollIdx_Load());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 8);
+}
+
+/*******************************************************************************
+**
+**  cf_pollidx_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_PollIdx_Unchanged, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown, "CF_PollIdx_Unchanged");
+    UtTest_Add(Test_CF_PollIdx_BeginScan, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown, "CF_PollIdx_BeginScan");
+    UtTest_Add(Test_CF_PollIdx_EndScan, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown, "CF_PollIdx_EndScan");
+    UtTest_Add(Test_CF_PollIdx_Invalidate, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown,
+               "CF_PollIdx_Invalidate");
+    UtTest_Add(Test_CF_PollIdx_FileSettled, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown,
+               "CF_PollIdx_FileSettled");
+    UtTest_Add(Test_CF_PollIdx_Save, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown, "CF_PollIdx_Save");
+    UtTest_Add(Test_CF_PollIdx_Load, cf_pollidx_tests_Setup, cf_pollidx_tests_Teardown, "CF_PollIdx_Load");
+}
@@ -0,0 +1,255 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_rtt.h"
+#include "cf_app.h"
+
+#define UT_CF_RTT_PEER 23
+
+static CF_ConfigTable_t UT_CF_Rtt_Config;
+static CF_Transaction_t UT_CF_Rtt_Txn;
+static CF_History_t     UT_CF_Rtt_Hist;
+
+/* converts like the real CF_Timer_Sec2Ticks() */
+static void UT_CF_Rtt_Sec2Ticks(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Timer_Seconds_t sec   = UT_Hook_GetArgValueByName(Context, "sec", CF_Timer_Seconds_t);
+    uint32             ticks = sec * UT_CF_Rtt_Config.ticks_per_second;
+
+    UT_Stub_SetReturnValue(FuncKey, ticks);
+}
+
+/* makes the peer of the transaction known with the given estimates */
+static void UT_CF_Rtt_SetPeer(uint32 srtt_ms, uint32 rttvar_ms)
+{
+    CF_HkPeerRtt_t *peer = &CF_AppData.hk.Payload.peer_rtt[0];
+
+    peer->eid       = UT_CF_RTT_PEER;
+    peer->srtt_ms   = srtt_ms;
+    peer->rttvar_ms = rttvar_ms;
+    peer->samples   = 1;
+}
+
+/*******************************************************************************
+**
+**  cf_rtt_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_rtt_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Rtt_Config, 0, sizeof(UT_CF_Rtt_Config));
+    memset(&UT_CF_Rtt_Txn, 0, sizeof(UT_CF_Rtt_Txn));
+    memset(&UT_CF_Rtt_Hist, 0, sizeof(UT_CF_Rtt_Hist));
+
+    UT_CF_Rtt_Config.ticks_per_second       = 10;
+    UT_CF_Rtt_Config.chan[0].rtt_timer_max_s = 60;
+    CF_AppData.config_table                 = &UT_CF_Rtt_Config;
+
+    UT_CF_Rtt_Hist.peer_eid = UT_CF_RTT_PEER;
+    UT_CF_Rtt_Txn.history   = &UT_CF_Rtt_Hist;
+
+    UT_SetHandlerFunction(UT_KEY(CF_Timer_Sec2Ticks), UT_CF_Rtt_Sec2Ticks, NULL);
+}
+
+void cf_rtt_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Rtt_Start(void)
+{
+    /* Test case for:
+     * void CF_Rtt_Start(CF_Transaction_t *txn, bool retransmit);
+     */
+
+    /* first send of the request */
+    CF_AppData.engine.tick_count = 42;
+    UtAssert_VOIDCALL(CF_Rtt_Start(&UT_CF_Rtt_Txn, false));
+    UtAssert_BOOL_TRUE(UT_CF_Rtt_Txn.flags.com.rtt_pending);
+    UtAssert_UINT32_EQ(UT_CF_Rtt_Txn.state_data.rtt_start, 42);
+
+    /* sent again, the answer cannot be timed any more */
+    UtAssert_VOIDCALL(CF_Rtt_Start(&UT_CF_Rtt_Txn, true));
+    UtAssert_BOOL_FALSE(UT_CF_Rtt_Txn.flags.com.rtt_pending);
+}
+
+void Test_CF_Rtt_Stop(void)
+{
+    /* Test case for:
+     * void CF_Rtt_Stop(CF_Transaction_t *txn);
+     */
+    const CF_HkPeerRtt_t *peer = &CF_AppData.hk.Payload.peer_rtt[0];
+
+    /* nothing is being timed */
+    UtAssert_VOIDCALL(CF_Rtt_Stop(&UT_CF_Rtt_Txn));
+    UtAssert_ZERO(peer->samples);
+
+    /* nominal, 3 ticks of 100 ms */
+    CF_AppData.engine.tick_count = 2;
+    CF_Rtt_Start(&UT_CF_Rtt_Txn, false);
+    CF_AppData.engine.tick_count = 5;
+    UtAssert_VOIDCALL(CF_Rtt_Stop(&UT_CF_Rtt_Txn));
+    UtAssert_BOOL_FALSE(UT_CF_Rtt_Txn.flags.com.rtt_pending);
+    UtAssert_UINT32_EQ(peer->eid, UT_CF_RTT_PEER);
+    UtAssert_UINT32_EQ(peer->srtt_ms, 300);
+    UtAssert_UINT32_EQ(peer->samples, 1);
+
+    /* only one sample per request */
+    UtAssert_VOIDCALL(CF_Rtt_Stop(&UT_CF_Rtt_Txn));
+    UtAssert_UINT32_EQ(peer->samples, 1);
+
+    /* the tick count wrapped around */
+    CF_AppData.engine.tick_count = UINT32_MAX;
+    CF_Rtt_Start(&UT_CF_Rtt_Txn, false);
+    CF_AppData.engine.tick_count = 2;
+    UtAssert_VOIDCALL(CF_Rtt_Stop(&UT_CF_Rtt_Txn));
+    UtAssert_UINT32_EQ(peer->samples, 2);
+    UtAssert_UINT32_EQ(peer->srtt_ms, 300);
+}
+
+void Test_CF_Rtt_Update(void)
+{
+    /* Test case for:
+     * void CF_Rtt_Update(CF_EntityId_t peer_eid, uint32 sample_ms);
+     */
+    const CF_HkPeerRtt_t *peer = &CF_AppData.hk.Payload.peer_rtt[0];
+    int                   i;
+
+    /* first sample */
+    UtAssert_VOIDCALL(CF_Rtt_Update(UT_CF_RTT_PEER, 300));
+    UtAssert_UINT32_EQ(peer->eid, UT_CF_RTT_PEER);
+    UtAssert_UINT32_EQ(peer->srtt_ms, 300);
+    UtAssert_UINT32_EQ(peer->rttvar_ms, 150);
+    UtAssert_UINT32_EQ(peer->samples, 1);
+
+    /* longer, the variation follows the error of the estimate */
+    UtAssert_VOIDCALL(CF_Rtt_Update(UT_CF_RTT_PEER, 500));
+    UtAssert_UINT32_EQ(peer->srtt_ms, 325);
+    UtAssert_UINT32_EQ(peer->rttvar_ms, 162);
+    UtAssert_UINT32_EQ(peer->samples, 2);
+
+    /* shorter */
+    UtAssert_VOIDCALL(CF_Rtt_Update(UT_CF_RTT_PEER, 5));
+    UtAssert_UINT32_EQ(peer->srtt_ms, 285);
+    UtAssert_UINT32_EQ(peer->rttvar_ms, 201);
+
+    /* another peer gets its own entry */
+    UtAssert_VOIDCALL(CF_Rtt_Update(UT_CF_RTT_PEER + 1, 1000));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.peer_rtt[1].eid, UT_CF_RTT_PEER + 1);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.peer_rtt[1].srtt_ms, 1000);
+    UtAssert_UINT32_EQ(peer->srtt_ms, 285);
+
+    /* the table is full, a new peer is not tracked */
+    for (i = 2; i < CF_MAX_RTT_PEERS; ++i)
+    {
+        CF_Rtt_Update(UT_CF_RTT_PEER + i, 1000);
+    }
+    UtAssert_VOIDCALL(CF_Rtt_Update(1, 1000));
+    for (i = 0; i < CF_MAX_RTT_PEERS; ++i)
+    {
+        UtAssert_True(CF_AppData.hk.Payload.peer_rtt[i].eid != 1, "peer_rtt[%d] is not the new peer", i);
+    }
+
+    /* the count of samples saturates */
+    CF_AppData.hk.Payload.peer_rtt[0].samples = UINT32_MAX;
+    UtAssert_VOIDCALL(CF_Rtt_Update(UT_CF_RTT_PEER, 285));
+    UtAssert_UINT32_EQ(peer->samples, UINT32_MAX);
+}
+
+void Test_CF_Rtt_GetTimeout(void)
+{
+    /* Test case for:
+     * CF_Timer_Ticks_t CF_Rtt_GetTimeout(const CF_Transaction_t *txn, CF_Timer_Seconds_t static_s);
+     */
+
+    /* no round trip time for the peer, the static timer of the channel */
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 30);
+
+    /* disabled on the channel */
+    UT_CF_Rtt_SetPeer(300, 150);
+    UT_CF_Rtt_Config.chan[0].rtt_timer_max_s = 0;
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 30);
+    UT_CF_Rtt_Config.chan[0].rtt_timer_max_s = 60;
+
+    /* nominal, 300 ms + 4 * 150 ms */
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 9);
+
+    /* rounded up to whole ticks */
+    UT_CF_Rtt_SetPeer(301, 150);
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 10);
+
+    /* no variation, still at least one tick more than the round trip time */
+    UT_CF_Rtt_SetPeer(1000, 0);
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 11);
+
+    /* never shorter than rtt_timer_min_s */
+    UT_CF_Rtt_Config.chan[0].rtt_timer_min_s = 2;
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 20);
+    UT_CF_Rtt_Config.chan[0].rtt_timer_min_s = 0;
+
+    /* never longer than rtt_timer_max_s */
+    UT_CF_Rtt_SetPeer(100000, 50000);
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 600);
+
+    /* at least one tick */
+    UT_CF_Rtt_Config.ticks_per_second = 2000;
+    UT_CF_Rtt_SetPeer(0, 0);
+    UtAssert_UINT32_EQ(CF_Rtt_GetTimeout(&UT_CF_Rtt_Txn, 3), 1);
+}
+
+void Test_CF_Rtt_GetSrtt(void)
+{
+    /* Test case for:
+     * uint32 CF_Rtt_GetSrtt(CF_EntityId_t peer_eid);
+     */
+
+    /* not measured */
+    UtAssert_ZERO(CF_Rtt_GetSrtt(UT_CF_RTT_PEER));
+
+    /* nominal */
+    UT_CF_Rtt_SetPeer(300, 150);
+    UtAssert_UINT32_EQ(CF_Rtt_GetSrtt(UT_CF_RTT_PEER), 300);
+    UtAssert_ZERO(CF_Rtt_GetSrtt(UT_CF_RTT_PEER + 1));
+}
+
+/*******************************************************************************
+**
+**  cf_rtt_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Rtt_Start, cf_rtt_tests_Setup, cf_rtt_tests_Teardown, "CF_Rtt_Start");
+    UtTest_Add(Test_CF_Rtt_Stop, cf_rtt_tests_Setup, cf_rtt_tests_Teardown, "CF_Rtt_Stop");
+    UtTest_Add(Test_CF_Rtt_Update, cf_rtt_tests_Setup, cf_rtt_tests_Teardown, "CF_Rtt_Update");
+    UtTest_Add(Test_CF_Rtt_GetTimeout, cf_rtt_tests_Setup, cf_rtt_tests_Teardown, "CF_Rtt_GetTimeout");
+    UtTest_Add(Test_CF_Rtt_GetSrtt, cf_rtt_tests_Setup, cf_rtt_tests_Teardown, "CF_Rtt_GetSrtt");
+}
@@ -0,0 +1,175 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_shm.h"
+#include "cf_diag.h"
+#include "cf_app.h"
+
+static CF_ConfigTable_t UT_CF_Shm_Config;
+
+/* local clock seen by the code under test, in microseconds */
+static uint32 UT_CF_Shm_Now_us;
+
+static void UT_CF_Shm_GetLocalTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    OS_time_t *time_struct = UT_Hook_GetArgValueByName(Context, "time_struct", OS_time_t *);
+
+    *time_struct = OS_TimeAssembleFromNanoseconds(UT_CF_Shm_Now_us / 1000000, (UT_CF_Shm_Now_us % 1000000) * 1000);
+}
+
+/*******************************************************************************
+**
+**  cf_shm_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_shm_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Shm_Config, 0, sizeof(UT_CF_Shm_Config));
+    memset(&CF_ShmStats, 0, sizeof(CF_ShmStats));
+
+    strcpy(UT_CF_Shm_Config.stats_shm_name, "/cf_stats");
+    CF_AppData.config_table = &UT_CF_Shm_Config;
+
+    UT_CF_Shm_Now_us = 5000000;
+    UT_SetHandlerFunction(UT_KEY(OS_GetLocalTime), UT_CF_Shm_GetLocalTime, NULL);
+}
+
+void cf_shm_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  cf_shm_tests
+**
+*******************************************************************************/
+
+void Test_CF_Shm_Init(void)
+{
+    /* Act */
+    UtAssert_VOIDCALL(CF_Shm_Init());
+
+    /* Assert */
+    UtAssert_ADDRESS_EQ(CF_AppData.shm.stats, &CF_ShmStats);
+    UtAssert_UINT32_EQ(CF_ShmStats.magic, CF_SHM_MAGIC);
+    UtAssert_UINT32_EQ(CF_ShmStats.version, CF_SHM_VERSION);
+    UtAssert_UINT32_EQ(CF_ShmStats.size, sizeof(CF_ShmStats_t));
+    UtAssert_ZERO(CF_ShmStats.seq);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* not published without a name */
+    UT_CF_Shm_Config.stats_shm_name[0] = 0;
+    CF_ShmStats.magic                  = 0;
+    UtAssert_VOIDCALL(CF_Shm_Init());
+    UtAssert_NULL(CF_AppData.shm.stats);
+    UtAssert_ZERO(CF_ShmStats.magic);
+}
+
+void Test_CF_Shm_Publish(void)
+{
+    /* Arrange */
+    CF_HkChannel_Data_t *chk = &CF_AppData.hk.Payload.channel_hk[0];
+
+    /* Act - not published */
+    UtAssert_VOIDCALL(CF_Shm_Publish());
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_Diag_Update, 0);
+    UtAssert_ZERO(CF_ShmStats.seq);
+
+    /* published, within a second of the start */
+    CF_Shm_Init();
+    chk->counters.sent.file_data_bytes = 4000;
+    chk->q_size[CF_QueueIdx_PEND]      = 7;
+    CF_AppData.diag.pkt.Payload.yields = 3;
+    UT_CF_Shm_Now_us += 500000;
+    UtAssert_VOIDCALL(CF_Shm_Publish());
+    UtAssert_STUB_COUNT(CF_Diag_Update, 1);
+    UtAssert_UINT32_EQ(CF_ShmStats.seq, 2);
+    UtAssert_UINT32_EQ(CF_ShmStats.updates, 1);
+    UtAssert_UINT32_EQ(CF_ShmStats.hk.channel_hk[0].q_size[CF_QueueIdx_PEND], 7);
+    UtAssert_UINT32_EQ(CF_ShmStats.diag.yields, 3);
+    UtAssert_ZERO(CF_ShmStats.rate[0].tx_bytes_per_s);
+
+    /* two seconds after the start */
+    chk->counters.recv.file_data_bytes = 1000;
+    UT_CF_Shm_Now_us += 1500000;
+    UtAssert_VOIDCALL(CF_Shm_Publish());
+    UtAssert_UINT32_EQ(CF_ShmStats.seq, 4);
+    UtAssert_UINT32_EQ(CF_ShmStats.rate[0].tx_bytes_per_s, 2000);
+    UtAssert_UINT32_EQ(CF_ShmStats.rate[0].rx_bytes_per_s, 500);
+
+    /* the counters were reset since */
+    chk->counters.sent.file_data_bytes = 3000;
+    UT_CF_Shm_Now_us += 1000000;
+    UtAssert_VOIDCALL(CF_Shm_Publish());
+    UtAssert_UINT32_EQ(CF_ShmStats.rate[0].tx_bytes_per_s, 3000);
+    UtAssert_ZERO(CF_ShmStats.rate[0].rx_bytes_per_s);
+
+    /* the local clock was set back */
+    chk->counters.sent.file_data_bytes = 5000;
+    UT_CF_Shm_Now_us -= 2000000;
+    UtAssert_VOIDCALL(CF_Shm_Publish());
+    UtAssert_ZERO(CF_ShmStats.rate[0].tx_bytes_per_s);
+    UtAssert_UINT32_EQ(CF_ShmStats.updates, 4);
+}
+
+void Test_CF_Shm_Read(void)
+{
+    /* Arrange */
+    CF_ShmStats_t copy;
+
+    CF_Shm_Init();
+    CF_AppData.hk.Payload.counters.cmd = 9;
+    CF_Shm_Publish();
+
+    /* Act - consistent */
+    UtAssert_BOOL_TRUE(CF_Shm_Read(&CF_ShmStats, &copy));
+
+    /* Assert */
+    UtAssert_UINT32_EQ(copy.hk.counters.cmd, 9);
+    UtAssert_UINT32_EQ(copy.seq, 2);
+
+    /* being written */
+    CF_ShmStats.seq = 3;
+    UtAssert_BOOL_FALSE(CF_Shm_Read(&CF_ShmStats, &copy));
+
+    /* not set up */
+    CF_ShmStats.seq   = 4;
+    CF_ShmStats.magic = 0;
+    UtAssert_BOOL_FALSE(CF_Shm_Read(&CF_ShmStats, &copy));
+}
+
+/*******************************************************************************
+**
+**  cf_shm_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Shm_Init, cf_shm_tests_Setup, cf_shm_tests_Teardown, "CF_Shm_Init");
+    UtTest_Add(Test_CF_Shm_Publish, cf_shm_tests_Setup, cf_shm_tests_Teardown, "CF_Shm_Publish");
+    UtTest_Add(Test_CF_Shm_Read, cf_shm_tests_Setup, cf_shm_tests_Teardown, "CF_Shm_Read");
+}
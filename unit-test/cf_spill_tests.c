@@ -0,0 +1,639 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_spill.h"
+#include "cf_journal.h"
+#include "cf_cfdp.h"
+#include "cf_app.h"
+#include "cf_eventids.h"
+
+static CF_ConfigTable_t   UT_CF_Spill_Config;
+static CF_JournalRecord_t UT_CF_Spill_Record;
+
+/* hands out UT_CF_Spill_Record as the content of a spill file */
+static void UT_CF_Spill_Read(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void  *buf  = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    size_t size = UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32  status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        memcpy(buf, &UT_CF_Spill_Record, size);
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/* takes anything written to a spill file */
+static void UT_CF_Spill_Write(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    size_t size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32  status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/* returns UserObj, or NULL when a status code is set (no transaction available) */
+static void UT_CF_Spill_StartRx(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Transaction_t *txn = UserObj;
+    int32             status;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        txn = NULL;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, txn);
+}
+
+/* visits only the first node of the list */
+static void UT_CF_Spill_Traverse(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_CListNode_t *start   = UT_Hook_GetArgValueByName(Context, "start", CF_CListNode_t *);
+    CF_CListFn_t    fn      = UT_Hook_GetArgValueByName(Context, "fn", CF_CListFn_t);
+    void           *context = UT_Hook_GetArgValueByName(Context, "context", void *);
+
+    if (start != NULL)
+    {
+        fn(start, context);
+    }
+}
+
+static void UT_CF_Spill_Setup_Txn(CF_Transaction_t *txn, CF_History_t *history)
+{
+    memset(txn, 0, sizeof(*txn));
+    memset(history, 0, sizeof(*history));
+    history->src_eid = 12;
+    history->seq_num = 34;
+    txn->history     = history;
+    txn->chan_num    = UT_CFDP_CHANNEL;
+    txn->fd          = OS_ObjectIdFromInteger(5);
+}
+
+static CF_SpillEntry_t *UT_CF_Spill_Setup_Entry(CF_Channel_t *chan, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    CF_SpillEntry_t *entry = &chan->spill[chan->num_spilled];
+
+    entry->src_eid = src_eid;
+    entry->seq_num = seq_num;
+    ++chan->num_spilled;
+
+    return entry;
+}
+
+/*******************************************************************************
+**
+**  cf_spill_tests Setup and Teardown
+**
+*******************************************************************************/
+
+void cf_spill_tests_Setup(void)
+{
+    cf_tests_Setup();
+
+    memset(&UT_CF_Spill_Config, 0, sizeof(UT_CF_Spill_Config));
+    memset(&UT_CF_Spill_Record, 0, sizeof(UT_CF_Spill_Record));
+
+    UT_CF_Spill_Config.spill_idle_s                                   = 10;
+    UT_CF_Spill_Config.spill_max_s                                    = 100;
+    UT_CF_Spill_Config.chan[UT_CFDP_CHANNEL].rx_chunks_per_transaction = 32;
+    strcpy(UT_CF_Spill_Config.tmp_dir, "/ut/tmp");
+    CF_AppData.config_table = &UT_CF_Spill_Config;
+
+    UT_CF_Spill_Record.src_eid    = 12;
+    UT_CF_Spill_Record.seq_num    = 34;
+    UT_CF_Spill_Record.chan_num   = UT_CFDP_CHANNEL;
+    UT_CF_Spill_Record.num_chunks = 2;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_CF_Spill_Read, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_CF_Spill_Traverse, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Journal_IsEligible), true);
+}
+
+void cf_spill_tests_Teardown(void)
+{
+    cf_tests_Teardown();
+}
+
+/*******************************************************************************
+**
+**  Unit-specific test implementation
+**
+*******************************************************************************/
+
+void Test_CF_Spill_GetName(void)
+{
+    /* Test case for:
+     * void CF_Spill_GetName(CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num, char *FileNameBuf,
+     *                       size_t FileNameSize);
+     */
+    char name[64];
+
+    UtAssert_VOIDCALL(CF_Spill_GetName(12, 34, name, sizeof(name)));
+    UtAssert_STRINGBUF_EQ(name, sizeof(name), "/ut/tmp/12_34.spl", -1);
+}
+
+void Test_CF_Spill_Txn(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Spill_Txn(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     history;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    /* index is full */
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+    chan->num_spilled = CF_MAX_SPILLED_PER_CHAN;
+    UtAssert_INT32_EQ(CF_Spill_Txn(&txn), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    chan->num_spilled = 0;
+
+    /* spill file cannot be created */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Spill_Txn(&txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_SPILL_WRITE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* spill file cannot be written */
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_WriteRecord), 1, CF_ERROR);
+    UtAssert_INT32_EQ(CF_Spill_Txn(&txn), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UtAssert_ZERO(chan->num_spilled);
+    UtAssert_ZERO(chan->spill_writes);
+
+    /* nominal */
+    cf_spill_tests_Setup();
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+    txn.flags.com.keep_history = true;
+    UtAssert_INT32_EQ(CF_Spill_Txn(&txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn.fd));
+    UtAssert_BOOL_FALSE(txn.flags.com.keep_history);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill_writes, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].src_eid, 12);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 34);
+
+    /* nominal, no open temp file */
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+    txn.fd = OS_OBJECT_ID_UNDEFINED;
+    UtAssert_INT32_EQ(CF_Spill_Txn(&txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+    UtAssert_UINT32_EQ(chan->num_spilled, 2);
+}
+
+void Test_CF_Spill_Keep(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Spill_Keep(CF_Channel_t *chan, osal_id_t fd, const CF_JournalRecord_t *rec);
+     */
+    CF_Channel_t      *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_JournalRecord_t rec  = UT_CF_Spill_Record;
+    osal_id_t          fd   = OS_ObjectIdFromInteger(7);
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Spill_Write, NULL);
+
+    /* index is full, the chunk entries are still consumed */
+    chan->num_spilled = CF_MAX_SPILLED_PER_CHAN;
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CF_ERROR);
+    UT_CF_AssertEventID(CF_SPILL_WRITE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    chan->num_spilled = 0;
+
+    /* spill file cannot be created */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* chunk entries cannot be written */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, -1);
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* journal is short, nothing more to report than the read failure */
+    cf_spill_tests_Setup();
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Spill_Write, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 0);
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CF_ERROR);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* nominal */
+    cf_spill_tests_Setup();
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_Spill_Write, NULL);
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill_writes, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].src_eid, 12);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 34);
+
+    /* nominal, no chunk entries */
+    rec.num_chunks = 0;
+    UtAssert_INT32_EQ(CF_Spill_Keep(chan, fd, &rec), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 1);
+    UtAssert_UINT32_EQ(chan->num_spilled, 2);
+}
+
+void Test_CF_Spill_Find(void)
+{
+    /* Test case for:
+     * CF_SpillEntry_t *CF_Spill_Find(CF_Channel_t *chan, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+     */
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_SpillEntry_t *entry;
+
+    UtAssert_NULL(CF_Spill_Find(chan, 12, 34));
+
+    UT_CF_Spill_Setup_Entry(chan, 12, 33);
+    UT_CF_Spill_Setup_Entry(chan, 11, 34);
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UtAssert_ADDRESS_EQ(CF_Spill_Find(chan, 12, 34), entry);
+    UtAssert_NULL(CF_Spill_Find(chan, 12, 35));
+}
+
+void Test_CF_Spill_Remove(void)
+{
+    /* Test case for:
+     * void CF_Spill_Remove(CF_Channel_t *chan, CF_SpillEntry_t *entry, bool keep_temp);
+     */
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_SpillEntry_t *entry;
+
+    /* the last entry fills the hole */
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 33);
+    UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UtAssert_VOIDCALL(CF_Spill_Remove(chan, entry, true));
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_GetTempName, 0);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 34);
+
+    /* the temp file goes too */
+    UtAssert_VOIDCALL(CF_Spill_Remove(chan, entry, false));
+    UtAssert_STUB_COUNT(OS_remove, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_GetTempName, 1);
+    UtAssert_ZERO(chan->num_spilled);
+}
+
+void Test_CF_Spill_Load(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Spill_Load(CF_Transaction_t *txn, CF_Channel_t *chan, CF_SpillEntry_t *entry);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     history;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_SpillEntry_t *entry;
+
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+
+    /* nominal, only the spill file is removed */
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* resume fails, the transaction is abandoned */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_ResumeTxn), 1, CF_ERROR);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 0);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* spill file does not open */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UT_CF_AssertEventID(CF_SPILL_RELOAD_ERR_EID);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* spill file is short */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 0);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+
+    /* spill file belongs to another transaction */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 35);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 11, 34);
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+
+    /* spill file does not fit the channel configuration */
+    cf_spill_tests_Setup();
+    entry                         = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_CF_Spill_Record.num_chunks = 33;
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+
+    cf_spill_tests_Setup();
+    entry                        = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_CF_Spill_Record.sub_state = CF_RxSubState_FILESTORE;
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+
+    cf_spill_tests_Setup();
+    entry                       = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_CF_Spill_Record.chan_num = UT_CFDP_CHANNEL + 1;
+    UtAssert_INT32_EQ(CF_Spill_Load(&txn, chan, entry), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 0);
+}
+
+void Test_CF_Spill_Reload(void)
+{
+    /* Test case for:
+     * CF_Transaction_t *CF_Spill_Reload(CF_Channel_t *chan, CF_SpillEntry_t *entry);
+     */
+    CF_Transaction_t txn;
+    CF_Transaction_t victim;
+    CF_History_t     history;
+    CF_History_t     victim_history;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_SpillEntry_t *entry;
+
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+
+    /* no room, nothing to spill */
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UtAssert_NULL(CF_Spill_Reload(chan, entry));
+    UT_CF_AssertEventID(CF_SPILL_RELOAD_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+
+    /* nominal */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_CF_Spill_StartRx, &txn);
+    UtAssert_ADDRESS_EQ(CF_Spill_Reload(chan, entry), &txn);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 1);
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* reload fails */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_CF_Spill_StartRx, &txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_ResumeTxn), 1, CF_ERROR);
+    UtAssert_NULL(CF_Spill_Reload(chan, entry));
+    UtAssert_ZERO(chan->num_spilled);
+
+    /* a suspended transaction is spilled to make room */
+    cf_spill_tests_Setup();
+    entry = UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_CF_Spill_Setup_Txn(&victim, &victim_history);
+    victim_history.seq_num     = 56;
+    victim.flags.com.suspended = true;
+    chan->qs[CF_QueueIdx_RX]   = &victim.cl_node;
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_StartRxTransaction), 1, 0);
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_CF_Spill_StartRx, &txn);
+    UtAssert_ADDRESS_EQ(CF_Spill_Reload(chan, entry), &txn);
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 2);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 1);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 1);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 56);
+}
+
+void Test_CF_Spill_ReloadAll(void)
+{
+    /* Test case for:
+     * void CF_Spill_ReloadAll(CF_Channel_t *chan);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     history;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    /* nothing spilled */
+    UtAssert_VOIDCALL(CF_Spill_ReloadAll(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 0);
+
+    /* room for one of two, nothing is spilled to make room */
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+    UT_CF_Spill_Setup_Entry(chan, 12, 33);
+    UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    chan->qs[CF_QueueIdx_RX] = &txn.cl_node;
+    txn.flags.com.suspended  = true;
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_StartRxTransaction), UT_CF_Spill_StartRx, &txn);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_StartRxTransaction), 2, 0);
+    UtAssert_VOIDCALL(CF_Spill_ReloadAll(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_StartRxTransaction, 2);
+    UtAssert_STUB_COUNT(CF_Journal_ResumeTxn, 1);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 33);
+}
+
+void Test_CF_Spill_MakeRoom(void)
+{
+    /* Test case for:
+     * bool CF_Spill_MakeRoom(CF_Channel_t *chan);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     history;
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+    chan->qs[CF_QueueIdx_RX] = &txn.cl_node;
+
+    /* nothing suspended */
+    UtAssert_BOOL_FALSE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 1);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+
+    /* suspended, but cannot be spilled */
+    txn.flags.com.suspended = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_IsEligible), 1, false);
+    UtAssert_BOOL_FALSE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+
+    /* spill fails */
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_WriteRecord), 1, CF_ERROR);
+    UtAssert_BOOL_FALSE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 1);
+
+    /* nominal */
+    UtAssert_BOOL_TRUE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_RecycleTransaction, 1);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+
+    /* index full */
+    chan->num_spilled = CF_MAX_SPILLED_PER_CHAN;
+    UtAssert_BOOL_FALSE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 4);
+
+    /* spilling disabled */
+    chan->num_spilled               = 0;
+    UT_CF_Spill_Config.spill_idle_s = 0;
+    UtAssert_BOOL_FALSE(CF_Spill_MakeRoom(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 4);
+}
+
+void Test_CF_Spill_IdleTxn(void)
+{
+    /* Test case for:
+     * CF_CListTraverse_Status_t CF_Spill_IdleTxn(CF_CListNode_t *node, void *context);
+     */
+    CF_Transaction_t   txn;
+    CF_History_t       history;
+    CF_Spill_IdleArg_t arg;
+    CF_Channel_t      *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    arg.inact_ticks = 300;
+    arg.idle_ticks  = 100;
+    UT_CF_Spill_Setup_Txn(&txn, &history);
+
+    /* heard from recently */
+    txn.inactivity_timer.tick = 201;
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+
+    /* idle, but suspended */
+    txn.inactivity_timer.tick = 200;
+    txn.flags.com.suspended   = true;
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+    txn.flags.com.suspended = false;
+
+    /* idle, but busy with the CRC */
+    txn.state_data.sub_state = CF_RxSubState_VALIDATE;
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+    txn.state_data.sub_state = CF_RxSubState_DATA_EOF;
+
+    /* idle, but cannot be spilled */
+    UT_SetDeferredRetcode(UT_KEY(CF_Journal_IsEligible), 1, false);
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 0);
+
+    /* nominal */
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 1);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+
+    /* index full */
+    chan->num_spilled = CF_MAX_SPILLED_PER_CHAN;
+    UtAssert_INT32_EQ(CF_Spill_IdleTxn(&txn.cl_node, &arg), CF_CLIST_EXIT);
+    UtAssert_STUB_COUNT(CF_Journal_WriteRecord, 1);
+}
+
+void Test_CF_Spill_Tick(void)
+{
+    /* Test case for:
+     * void CF_Spill_Tick(CF_Channel_t *chan);
+     */
+    CF_Channel_t *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+
+    /* disabled */
+    UT_CF_Spill_Config.spill_idle_s = 0;
+    UT_CF_Spill_Setup_Entry(chan, 12, 33);
+    UtAssert_VOIDCALL(CF_Spill_Tick(chan));
+    UtAssert_STUB_COUNT(CF_Timer_Expired, 0);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 0);
+    UT_CF_Spill_Config.spill_idle_s = 10;
+
+    /* second of two entries expires, first one ticks */
+    UT_CF_Spill_Setup_Entry(chan, 12, 34);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 2, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Sec2Ticks), 1, 300);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Sec2Ticks), 1, 100);
+    UtAssert_VOIDCALL(CF_Spill_Tick(chan));
+    UT_CF_AssertEventID(CF_SPILL_EXPIRED_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.inactivity_timer, 1);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_STUB_COUNT(OS_remove, 2);
+    UtAssert_UINT32_EQ(chan->num_spilled, 1);
+    UtAssert_UINT32_EQ(chan->spill[0].seq_num, 33);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 1);
+
+    /* idle threshold not below the inactivity timeout, nothing to spill */
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Sec2Ticks), 1, 300);
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Sec2Ticks), 1, 300);
+    UtAssert_VOIDCALL(CF_Spill_Tick(chan));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 2);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_spill_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    UtTest_Add(Test_CF_Spill_GetName, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_GetName");
+    UtTest_Add(Test_CF_Spill_Txn, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Txn");
+    UtTest_Add(Test_CF_Spill_Keep, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Keep");
+    UtTest_Add(Test_CF_Spill_Find, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Find");
+    UtTest_Add(Test_CF_Spill_Remove, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Remove");
+    UtTest_Add(Test_CF_Spill_Load, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Load");
+    UtTest_Add(Test_CF_Spill_Reload, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Reload");
+    UtTest_Add(Test_CF_Spill_ReloadAll, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_ReloadAll");
+    UtTest_Add(Test_CF_Spill_MakeRoom, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_MakeRoom");
+    UtTest_Add(Test_CF_Spill_IdleTxn, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_IdleTxn");
+    UtTest_Add(Test_CF_Spill_Tick, cf_spill_tests_Setup, cf_spill_tests_Teardown, "CF_Spill_Tick");
+}
@@ -86,6 +86,21 @@ void Test_CF_Timer_InitRelSec_ReceiveExpectedValue(void)
     UtAssert_UINT32_EQ(arg_t->tick, arg_rel_sec * ticks_per_second);
 }
 
+void Test_CF_Timer_InitRelTicks_ReceiveExpectedValue(void)
+{
+    /* Arrange */
+    uint32     arg_rel_ticks = Any_uint32();
+    CF_Timer_t timer;
+
+    timer.tick = 0;
+
+    /* Act */
+    CF_Timer_InitRelTicks(&timer, arg_rel_ticks);
+
+    /* Assert */
+    UtAssert_UINT32_EQ(timer.tick, arg_rel_ticks);
+}
+
 /*******************************************************************************
 **
 **  CF_Timer_Expired tests
@@ -170,6 +185,10 @@ void add_CF_Timer_InitRelSec_tests(void)
                cf_timer_tests_Setup,
                cf_timer_tests_Teardown,
                "Test_CF_Timer_InitRelSec_ReceiveExpectedValue");
+    UtTest_Add(Test_CF_Timer_InitRelTicks_ReceiveExpectedValue,
+               cf_timer_tests_Setup,
+               cf_timer_tests_Teardown,
+               "Test_CF_Timer_InitRelTicks_ReceiveExpectedValue");
 }
 
 void add_CF_Timer_Expired_tests(void)
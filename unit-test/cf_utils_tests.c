@@ -159,11 +159,14 @@ void Test_CF_FindUnusedTransaction(void)
     UtAssert_ADDRESS_EQ(CF_FindUnusedTransaction(chan, 0), &txn);
     UtAssert_ADDRESS_EQ(txn.history, &hist);
 
+    /* the metrics of the transaction that last held the history are cleared */
+    hist.metrics.nak_rounds         = 5;
     chan->qs[CF_QueueIdx_FREE]      = &txn.cl_node;
     chan->qs[CF_QueueIdx_HIST_FREE] = NULL;
     chan->qs[CF_QueueIdx_HIST]      = &hist.cl_node;
     UtAssert_ADDRESS_EQ(CF_FindUnusedTransaction(chan, 0), &txn);
     UtAssert_ADDRESS_EQ(txn.history, &hist);
+    UtAssert_ZERO(hist.metrics.nak_rounds);
 }
 
 void Test_CF_FreeTransaction(void)
@@ -171,16 +174,16 @@ void Test_CF_FreeTransaction(void)
     /* Test case for:
      * void CF_FreeTransaction(CF_Transaction_t *txn, uint8 chan)
      */
-    CF_Transaction_t *txn;
+    CF_Transaction_t txn;
 
     memset(&CF_AppData, 0, sizeof(CF_AppData));
-    txn                    = &CF_AppData.engine.transactions[UT_CFDP_CHANNEL];
-    txn->flags.com.q_index = CF_QueueIdx_RX;
+    memset(&txn, 0, sizeof(txn));
+    txn.flags.com.q_index = CF_QueueIdx_RX;
 
-    UtAssert_VOIDCALL(CF_FreeTransaction(txn, UT_CFDP_CHANNEL));
+    UtAssert_VOIDCALL(CF_FreeTransaction(&txn, UT_CFDP_CHANNEL));
 
-    UtAssert_UINT32_EQ(txn->state, CF_TxnState_UNDEF);
-    UtAssert_UINT8_EQ(txn->chan_num, UT_CFDP_CHANNEL);
+    UtAssert_UINT32_EQ(txn.state, CF_TxnState_UNDEF);
+    UtAssert_UINT8_EQ(txn.chan_num, UT_CFDP_CHANNEL);
     UtAssert_STUB_COUNT(CF_CList_InsertBack, 1);
 }
 
@@ -239,8 +242,8 @@ void Test_CF_FindTransactionBySequenceNumber(void)
      * transaction_sequence_number, CF_EntityId_t src_eid)
      */
 
-    CF_Transaction_t *txn;
-    CF_Channel_t     *chan;
+    CF_Transaction_t txn;
+    CF_Channel_t    *chan;
 
     memset(&CF_AppData, 0, sizeof(CF_AppData));
     chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
@@ -248,9 +251,8 @@ void Test_CF_FindTransactionBySequenceNumber(void)
     UtAssert_NULL(CF_FindTransactionBySequenceNumber(chan, 12, 34));
     UtAssert_STUB_COUNT(CF_CList_Traverse, 3); /* this checks 3 different queues: RX, TX, PEND */
 
-    txn = &CF_AppData.engine.transactions[UT_CFDP_CHANNEL];
-    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_AltHandler_CF_CList_Traverse_SeqArg_SetTxn, txn);
-    UtAssert_ADDRESS_EQ(CF_FindTransactionBySequenceNumber(chan, 12, 34), txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_AltHandler_CF_CList_Traverse_SeqArg_SetTxn, &txn);
+    UtAssert_ADDRESS_EQ(CF_FindTransactionBySequenceNumber(chan, 12, 34), &txn);
 }
 
 void Test_CF_GetChannelFromTxn(void)
@@ -310,6 +312,152 @@ void Test_CF_CFDP_GetTxnStatus(void)
     UtAssert_UINT32_EQ(CF_CFDP_GetAckTxnStatus(&txn), CF_CFDP_AckTxnStatus_TERMINATED);
 }
 
+void Test_CF_Arena_Init(void)
+{
+    /* Test case for:
+     * void CF_Arena_Init(CF_Arena_t *arena, void *mem, size_t size)
+     */
+    CF_Arena_t arena;
+    uint64     mem[4];
+
+    memset(&arena, 0xFF, sizeof(arena));
+
+    UtAssert_VOIDCALL(CF_Arena_Init(&arena, mem, sizeof(mem)));
+    UtAssert_ADDRESS_EQ(arena.base, mem);
+    UtAssert_UINT32_EQ(arena.size, sizeof(mem));
+    UtAssert_ZERO(arena.used);
+}
+
+void Test_CF_Arena_Alloc(void)
+{
+    /* Test case for:
+     * void *CF_Arena_Alloc(CF_Arena_t *arena, size_t size)
+     */
+    CF_Arena_t arena;
+    uint64     mem[4];
+    uint8     *base = (uint8 *)mem;
+
+    CF_Arena_Init(&arena, mem, sizeof(mem));
+
+    /* sizes are rounded up, so the next block stays aligned */
+    UtAssert_ADDRESS_EQ(CF_Arena_Alloc(&arena, 1), base);
+    UtAssert_UINT32_EQ(arena.used, CF_ARENA_ALIGN);
+    UtAssert_ADDRESS_EQ(CF_Arena_Alloc(&arena, CF_ARENA_ALIGN + 1), base + CF_ARENA_ALIGN);
+    UtAssert_UINT32_EQ(arena.used, 3 * CF_ARENA_ALIGN);
+
+    /* a zero size block takes no space */
+    UtAssert_ADDRESS_EQ(CF_Arena_Alloc(&arena, 0), base + (3 * CF_ARENA_ALIGN));
+    UtAssert_UINT32_EQ(arena.used, 3 * CF_ARENA_ALIGN);
+
+    /* does not fit, nothing is taken */
+    UtAssert_NULL(CF_Arena_Alloc(&arena, sizeof(mem)));
+    UtAssert_UINT32_EQ(arena.used, 3 * CF_ARENA_ALIGN);
+
+    /* exactly fills the arena */
+    UtAssert_ADDRESS_EQ(CF_Arena_Alloc(&arena, sizeof(mem) - (3 * CF_ARENA_ALIGN)), base + (3 * CF_ARENA_ALIGN));
+    UtAssert_UINT32_EQ(arena.used, sizeof(mem));
+    UtAssert_NULL(CF_Arena_Alloc(&arena, 1));
+}
+
+void Test_CF_ActiveSet_Insert(void)
+{
+    /* Test case for:
+     * void CF_ActiveSet_Insert(CF_Transaction_t *txn)
+     */
+    CF_Transaction_t  txn[2];
+    CF_Transaction_t *tx_slots[2];
+    CF_Transaction_t *rx_slots[2];
+    CF_ActiveSet_t   *set    = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].active[CF_Direction_TX];
+    CF_ActiveSet_t   *rx_set = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].active[CF_Direction_RX];
+
+    memset(txn, 0, sizeof(txn));
+    set->txn         = tx_slots;
+    set->capacity    = 2;
+    rx_set->txn      = rx_slots;
+    rx_set->capacity = 2;
+
+    /* not an active queue, ignored */
+    txn[0].chan_num          = UT_CFDP_CHANNEL;
+    txn[0].flags.com.q_index = CF_QueueIdx_PEND;
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[0]));
+    UtAssert_ZERO(set->count);
+
+    /* bad channel, ignored */
+    txn[0].chan_num          = CF_NUM_CHANNELS;
+    txn[0].flags.com.q_index = CF_QueueIdx_TX;
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[0]));
+    UtAssert_ZERO(set->count);
+
+    /* nominal, appended in order */
+    txn[0].chan_num          = UT_CFDP_CHANNEL;
+    txn[1].chan_num          = UT_CFDP_CHANNEL;
+    txn[1].flags.com.q_index = CF_QueueIdx_TX;
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[0]));
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[1]));
+    UtAssert_UINT32_EQ(set->count, 2);
+    UtAssert_ADDRESS_EQ(set->txn[0], &txn[0]);
+    UtAssert_ADDRESS_EQ(set->txn[1], &txn[1]);
+    UtAssert_UINT32_EQ(txn[1].active_idx, 1);
+
+    /* RX goes to the other set */
+    txn[0].flags.com.q_index = CF_QueueIdx_RX;
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[0]));
+    UtAssert_UINT32_EQ(rx_set->count, 1);
+
+    /* full, ignored */
+    UtAssert_VOIDCALL(CF_ActiveSet_Insert(&txn[1]));
+    UtAssert_UINT32_EQ(set->count, 2);
+}
+
+void Test_CF_ActiveSet_Remove(void)
+{
+    /* Test case for:
+     * void CF_ActiveSet_Remove(CF_Transaction_t *txn)
+     */
+    CF_Transaction_t  txn[3];
+    CF_Transaction_t *slots[3];
+    CF_ActiveSet_t   *set = &CF_AppData.engine.channels[UT_CFDP_CHANNEL].active[CF_Direction_RX];
+    int               i;
+
+    memset(txn, 0, sizeof(txn));
+    set->txn      = slots;
+    set->capacity = 3;
+    for (i = 0; i < 3; ++i)
+    {
+        txn[i].chan_num          = UT_CFDP_CHANNEL;
+        txn[i].flags.com.q_index = CF_QueueIdx_RX;
+        txn[i].active_idx        = i;
+        set->txn[i]              = &txn[i];
+    }
+    set->count = 3;
+
+    /* removing the first moves the last into its place */
+    UtAssert_VOIDCALL(CF_ActiveSet_Remove(&txn[0]));
+    UtAssert_UINT32_EQ(set->count, 2);
+    UtAssert_ADDRESS_EQ(set->txn[0], &txn[2]);
+    UtAssert_UINT32_EQ(txn[2].active_idx, 0);
+    UtAssert_NULL(set->txn[2]);
+
+    /* already removed, ignored */
+    UtAssert_VOIDCALL(CF_ActiveSet_Remove(&txn[0]));
+    UtAssert_UINT32_EQ(set->count, 2);
+
+    /* removing the last entry */
+    UtAssert_VOIDCALL(CF_ActiveSet_Remove(&txn[1]));
+    UtAssert_UINT32_EQ(set->count, 1);
+    UtAssert_ADDRESS_EQ(set->txn[0], &txn[2]);
+
+    /* index out of range, ignored */
+    txn[1].active_idx = 5;
+    UtAssert_VOIDCALL(CF_ActiveSet_Remove(&txn[1]));
+    UtAssert_UINT32_EQ(set->count, 1);
+
+    /* not an active queue, ignored */
+    txn[2].flags.com.q_index = CF_QueueIdx_HIST;
+    UtAssert_VOIDCALL(CF_ActiveSet_Remove(&txn[2]));
+    UtAssert_UINT32_EQ(set->count, 1);
+}
+
 /* CF_DequeueTransaction tests */
 
 void Test_cf_dequeue_transaction_Call_CF_CList_Remove_AndDecrement_q_size(void)
@@ -609,8 +757,9 @@ void Test_CF_WriteHistoryEntryToFile(void)
     strcpy(history.fnames.src_filename, "sf");
     strcpy(history.fnames.dst_filename, "df");
 
-    /* Successful write - need to set up for 3 successful calls to OS_write() */
+    /* Successful write - need to set up for 4 successful calls to OS_write() */
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 44);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 76);
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, strlen(history.fnames.src_filename) + 6);
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, strlen(history.fnames.dst_filename) + 6);
     UtAssert_INT32_EQ(CF_WriteHistoryEntryToFile(arg_fd, &history), 0);
@@ -675,73 +824,68 @@ void Test_CF_WriteHistoryQueueDataToFile(void)
 
 /*******************************************************************************
 **
-**  CF_PrioSearch tests
+**  CF_PrioQueue_Remove tests
 **
 *******************************************************************************/
 
-void Test_CF_PrioSearch_When_t_PrioIsGreaterThanContextPrioReturn_CLIST_CONT(void)
-{
-    /* Arrange */
-    CF_Transaction_t          txn;
-    CF_CListNode_t           *arg_node = &txn.cl_node;
-    CF_Traverse_PriorityArg_t arg;
-    void                     *arg_context = (void *)&arg;
-    int32                     result;
-
-    txn.priority = Any_uint8_Except(0);
-    arg.priority = Any_uint8_LessThan(txn.priority);
-
-    /* Act */
-    result = CF_PrioSearch(arg_node, arg_context);
-
-    /* Assert */
-    UtAssert_INT32_EQ(result, CF_CLIST_CONT);
-}
-
-void Test_CF_PrioSearch_When_t_PrioIsEqToContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT(void)
+void Test_CF_PrioQueue_Remove(void)
 {
-    /* Arrange */
-    CF_Transaction_t          txn;
-    CF_CListNode_t           *arg_node = &txn.cl_node;
-    CF_Traverse_PriorityArg_t arg;
-    void                     *arg_context = (void *)&arg;
-    int32                     result;
-
-    memset(&arg, 0, sizeof(arg));
-
-    /* NOTE: these are inverted from previous test! */
-    txn.priority = Any_uint8_Except(0);
-    arg.priority = txn.priority;
-
-    /* Act */
-    result = CF_PrioSearch(arg_node, arg_context);
-
-    /* Assert */
-    UtAssert_INT32_EQ(result, CF_CLIST_EXIT);
-    UtAssert_ADDRESS_EQ(arg.txn, &txn);
-}
-
-void Test_CF_PrioSearch_When_t_PrioIsLessThanContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT(void)
-{
-    /* Arrange */
-    CF_Transaction_t          txn;
-    CF_CListNode_t           *arg_node = &txn.cl_node;
-    CF_Traverse_PriorityArg_t arg;
-    void                     *arg_context = (void *)&arg;
-    int32                     result;
-
-    memset(&arg, 0, sizeof(arg));
-
-    /* NOTE: these are inverted from previous test! */
-    arg.priority = Any_uint8_Except(0);
-    txn.priority = Any_uint8_LessThan(arg.priority);
-
-    /* Act */
-    result = CF_PrioSearch(arg_node, arg_context);
-
-    /* Assert */
-    UtAssert_INT32_EQ(result, CF_CLIST_EXIT);
-    UtAssert_ADDRESS_EQ(arg.txn, &txn);
+    /* Test case for:
+     * void CF_PrioQueue_Remove(CF_Transaction_t *txn)
+     */
+    CF_Transaction_t txn[3];
+    CF_Channel_t    *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_PrioQueue_t  *pq   = &chan->pend_prio;
+    int              i;
+
+    /* queue order is txn[0] (prio 3), txn[1] (prio 5), txn[2] (prio 5) */
+    memset(txn, 0, sizeof(txn));
+    for (i = 0; i < 3; ++i)
+    {
+        txn[i].chan_num          = UT_CFDP_CHANNEL;
+        txn[i].flags.com.q_index = CF_QueueIdx_PEND;
+        txn[i].priority          = 5;
+    }
+    txn[0].priority            = 3;
+    txn[1].cl_node.prev        = &txn[0].cl_node;
+    txn[2].cl_node.prev        = &txn[1].cl_node;
+    chan->qs[CF_QueueIdx_PEND] = &txn[0].cl_node;
+    pq->tail[3]                = &txn[0];
+    pq->tail[5]                = &txn[2];
+    pq->bitmap[0]              = (1U << 3) | (1U << 5);
+
+    /* not the tail of its bucket, nothing changes */
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[1]));
+    UtAssert_ADDRESS_EQ(pq->tail[5], &txn[2]);
+
+    /* tail with a same-priority entry before it, that entry becomes the tail */
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[2]));
+    UtAssert_ADDRESS_EQ(pq->tail[5], &txn[1]);
+    UtAssert_UINT32_EQ(pq->bitmap[0], (1U << 3) | (1U << 5));
+
+    /* tail with a different priority before it, the bucket is emptied */
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[1]));
+    UtAssert_NULL(pq->tail[5]);
+    UtAssert_UINT32_EQ(pq->bitmap[0], (1U << 3));
+
+    /* tail at the queue head, the bucket is emptied */
+    txn[0].cl_node.prev = &txn[2].cl_node;
+    txn[2].priority     = 3;
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[0]));
+    UtAssert_NULL(pq->tail[3]);
+    UtAssert_ZERO(pq->bitmap[0]);
+
+    /* queue without a priority index, ignored */
+    pq->tail[3]              = &txn[0];
+    txn[0].flags.com.q_index = CF_QueueIdx_RX;
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[0]));
+    UtAssert_ADDRESS_EQ(pq->tail[3], &txn[0]);
+
+    /* bad channel number, ignored */
+    txn[0].chan_num          = CF_NUM_CHANNELS;
+    txn[0].flags.com.q_index = CF_QueueIdx_PEND;
+    UtAssert_VOIDCALL(CF_PrioQueue_Remove(&txn[0]));
+    UtAssert_ADDRESS_EQ(pq->tail[3], &txn[0]);
 }
 
 /*******************************************************************************
@@ -750,166 +894,89 @@ void Test_CF_PrioSearch_When_t_PrioIsLessThanContextPrio_Set_context_t_To_t_AndR
 **
 *******************************************************************************/
 
-void Test_CF_InsertSortPrio_Call_CF_CList_InsertBack_Ex_ListIsEmpty_AndSet_q_index_To_q(void)
+void Test_CF_InsertSortPrio(void)
 {
-    /* Arrange */
-    CF_Transaction_t  txn;
-    CF_Transaction_t *arg_t = &txn;
-    CF_QueueIdx_t     arg_q = Any_cf_queue_index_t();
-    CF_Channel_t     *chan;
-    CF_CListNode_t  **expected_insert_back_head;
-    CF_CListNode_t   *expected_insert_back_node;
-
-    CF_CList_InsertBack_context_t context_clist_insert_back;
-
-    /* txn settings to bypass CF_Assert */
-    txn.chan_num = Any_uint8_LessThan(CF_NUM_CHANNELS);
-    txn.state    = Any_uint8_Except(CF_TxnState_INIT);
-
-    UT_SetDataBuffer(UT_KEY(CF_CList_InsertBack), &context_clist_insert_back, sizeof(context_clist_insert_back), false);
-
-    /* setting (&CF_AppData.engine.channels[arg_t->chan_num])->qs[arg_q] to NULL
-     * makes the list empty */
-    chan            = &CF_AppData.engine.channels[arg_t->chan_num];
-    chan->qs[arg_q] = NULL;
-
-    expected_insert_back_head = &chan->qs[arg_q];
-    expected_insert_back_node = &arg_t->cl_node;
-
-    /* Act */
-    CF_InsertSortPrio(arg_t, arg_q);
-
-    /* Assert */
-    UtAssert_STUB_COUNT(CF_CList_InsertBack, 1);
-    UtAssert_ADDRESS_EQ(context_clist_insert_back.head, expected_insert_back_head);
-    UtAssert_ADDRESS_EQ(context_clist_insert_back.node, expected_insert_back_node);
-    UtAssert_True(arg_t->flags.com.q_index == arg_q,
-                  "arg_t->flags.com.q_index set to %d and should be %d (CF_QueueIdx_t queue)",
-                  arg_t->flags.com.q_index,
-                  arg_q);
-}
-
-void Test_CF_InsertSortPrio_Call_CF_CList_InsertAfter_Ex_AndSet_q_index_To_q(void)
-{
-    /* Arrange */
-    CF_Transaction_t  p_t;
-    CF_Transaction_t  txn;
-    CF_Transaction_t *arg_t = &txn;
-    CF_QueueIdx_t     arg_q = Any_cf_queue_index_t();
-    CF_CListNode_t   *qs;
-    CF_Channel_t     *chan;
-    CF_CListNode_t   *expected_end;
-    CF_CListFn_t      expected_fn;
-    CF_CListNode_t  **expected_insert_after_head;
-    CF_CListNode_t  **expected_insert_after_start;
-    CF_CListNode_t  **expected_insert_after_after;
-
-    CF_CList_Traverse_R_context_t  context_cf_clist_traverse_r;
-    CF_CList_InsertAfter_context_t context_CF_CList_InsertAfter;
-
-    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse_R),
-                          UT_AltHandler_CF_CList_Traverse_R_PRIO,
-                          &context_cf_clist_traverse_r);
-
-    /* txn settings to bypass CF_Assert */
-    txn.chan_num = Any_uint8_LessThan(CF_NUM_CHANNELS);
-    txn.state    = Any_uint8_Except(CF_TxnState_INIT);
-
-    /* setting (&CF_AppData.engine.channels[arg_t->chan_num])->qs[arg_q] to
-     * &qs makes the list NOT empty */
-    chan            = &CF_AppData.engine.channels[arg_t->chan_num];
-    chan->qs[arg_q] = (CF_CListNode_t *)&qs;
-
-    /* setup CF_Traverse_PriorityArg_t altered value */
-    context_cf_clist_traverse_r.context_t = &p_t;
+    /* Test case for:
+     * void CF_InsertSortPrio(CF_Transaction_t *txn, CF_QueueIdx_t queue)
+     */
+    CF_Transaction_t  txn[4];
+    CF_Transaction_t *tx_slots[1];
+    CF_Channel_t     *chan = &CF_AppData.engine.channels[UT_CFDP_CHANNEL];
+    CF_PrioQueue_t   *pq   = &chan->pend_prio;
+    int               i;
+
+    CF_CList_InsertBack_context_t  context_clist_insert_back;
+    CF_CList_InsertAfter_context_t context_clist_insert_after;
+
+    memset(txn, 0, sizeof(txn));
+    chan->active[CF_Direction_TX].txn      = tx_slots;
+    chan->active[CF_Direction_TX].capacity = 1;
+    for (i = 0; i < 4; ++i)
+    {
+        txn[i].chan_num = UT_CFDP_CHANNEL;
+        txn[i].state    = CF_TxnState_S1;
+    }
+    txn[0].priority = 10;
+    txn[1].priority = 10;
+    txn[2].priority = 200;
+    txn[3].priority = 0;
+
+    /* empty queue, goes on the front */
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[0], CF_QueueIdx_PEND));
+    UtAssert_STUB_COUNT(CF_CList_InsertFront, 1);
+    UtAssert_STUB_COUNT(CF_CList_InsertAfter, 0);
+    UtAssert_UINT32_EQ(txn[0].flags.com.q_index, CF_QueueIdx_PEND);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_PEND], 1);
+    UtAssert_ADDRESS_EQ(pq->tail[10], &txn[0]);
+    UtAssert_UINT32_EQ(pq->bitmap[0], (1U << 10));
 
-    /* Arrange for CF_CList_InsertAfter_Ex */
+    /* same priority, goes behind the existing entry (FIFO) */
     UT_SetDataBuffer(UT_KEY(CF_CList_InsertAfter),
-                     &context_CF_CList_InsertAfter,
-                     sizeof(context_CF_CList_InsertAfter),
+                     &context_clist_insert_after,
+                     sizeof(context_clist_insert_after),
                      false);
-
-    /* set expected values */
-    expected_end                = chan->qs[arg_q];
-    expected_fn                 = CF_PrioSearch;
-    expected_insert_after_head  = (CF_CListNode_t **)&chan->qs[arg_q];
-    expected_insert_after_start = (CF_CListNode_t **)&p_t.cl_node;
-    expected_insert_after_after = (CF_CListNode_t **)&arg_t->cl_node;
-
-    /* Act */
-    CF_InsertSortPrio(arg_t, arg_q);
-
-    /* Assert */
-    UtAssert_STUB_COUNT(CF_CList_Traverse_R, 1);
-    UtAssert_ADDRESS_EQ(context_cf_clist_traverse_r.end, expected_end);
-    UtAssert_True(context_cf_clist_traverse_r.fn == expected_fn, "context_cf_clist_traverse_r.fn ==  expected_fn");
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[1], CF_QueueIdx_PEND));
     UtAssert_STUB_COUNT(CF_CList_InsertAfter, 1);
-    UtAssert_ADDRESS_EQ(context_CF_CList_InsertAfter.head, (CF_CListNode_t **)expected_insert_after_head);
-    UtAssert_ADDRESS_EQ(context_CF_CList_InsertAfter.start, (CF_CListNode_t *)expected_insert_after_start);
-    UtAssert_ADDRESS_EQ(context_CF_CList_InsertAfter.after, (CF_CListNode_t *)expected_insert_after_after);
-    UtAssert_True(arg_t->flags.com.q_index == arg_q,
-                  "txn->flags.com.q_index is %u and should be %u (q)",
-                  arg_t->flags.com.q_index,
-                  arg_q);
-}
-
-void Test_CF_InsertSortPrio_When_p_t_Is_NULL_Call_CF_CList_InsertBack_Ex(void)
-{
-    /* Arrange */
-    CF_Transaction_t  txn;
-    CF_Transaction_t *arg_t = &txn;
-    CF_QueueIdx_t     arg_q = Any_cf_queue_index_t();
-    CF_CListNode_t   *qs;
-    CF_Channel_t     *chan;
-    CF_CListNode_t   *expected_end;
-    CF_CListFn_t      expected_fn;
-    CF_CListNode_t  **expected_insert_back_head;
-    CF_CListNode_t   *expected_insert_back_node;
-
-    CF_CList_Traverse_R_context_t context_cf_clist_traverse_r;
-    CF_CList_InsertBack_context_t context_clist_insert_back;
-
-    UT_SetDataBuffer(UT_KEY(CF_CList_Traverse_R),
-                     &context_cf_clist_traverse_r,
-                     sizeof(context_cf_clist_traverse_r),
-                     false);
-
-    /* txn settings to bypass CF_Assert */
-    txn.chan_num = Any_uint8_LessThan(CF_NUM_CHANNELS);
-    txn.state    = Any_uint8_Except(CF_TxnState_INIT);
-
-    /* setting (&CF_AppData.engine.channels[arg_t->chan_num])->qs[arg_q] to
-     * &qs makes the list NOT empty */
-    chan            = &CF_AppData.engine.channels[arg_t->chan_num];
-    chan->qs[arg_q] = (CF_CListNode_t *)&qs;
-
-    /* setup CF_Traverse_PriorityArg_t altered value */
-    context_cf_clist_traverse_r.context_t = NULL;
-
-    /* set expected values */
-    expected_end              = chan->qs[arg_q];
-    expected_fn               = CF_PrioSearch;
-    expected_insert_back_head = &chan->qs[arg_q];
-    expected_insert_back_node = &arg_t->cl_node;
-
-    /* Arrange for CF_CList_InsertBack_Ex */
+    UtAssert_ADDRESS_EQ(context_clist_insert_after.head, &chan->qs[CF_QueueIdx_PEND]);
+    UtAssert_ADDRESS_EQ(context_clist_insert_after.start, &txn[0].cl_node);
+    UtAssert_ADDRESS_EQ(context_clist_insert_after.after, &txn[1].cl_node);
+    UtAssert_ADDRESS_EQ(pq->tail[10], &txn[1]);
+
+    /* numerically greater (lower) priority, goes behind the newest higher priority entry */
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[2], CF_QueueIdx_PEND));
+    UtAssert_STUB_COUNT(CF_CList_InsertAfter, 2);
+    UtAssert_ADDRESS_EQ(context_clist_insert_after.start, &txn[1].cl_node);
+    UtAssert_ADDRESS_EQ(pq->tail[200], &txn[2]);
+    UtAssert_UINT32_EQ(pq->bitmap[200 / 32], (1U << (200 % 32)));
+
+    /* higher priority than everything, goes on the front */
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[3], CF_QueueIdx_PEND));
+    UtAssert_STUB_COUNT(CF_CList_InsertFront, 2);
+    UtAssert_STUB_COUNT(CF_CList_InsertAfter, 2);
+    UtAssert_ADDRESS_EQ(pq->tail[0], &txn[3]);
+    UtAssert_UINT32_EQ(pq->bitmap[0], (1U << 10) | 1U);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_PEND], 4);
+
+    /* the TX queue has its own index */
+    memset(&txn[0], 0, sizeof(txn[0]));
+    txn[0].chan_num = UT_CFDP_CHANNEL;
+    txn[0].state    = CF_TxnState_S1;
+    txn[0].priority = 10;
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[0], CF_QueueIdx_TX));
+    UtAssert_STUB_COUNT(CF_CList_InsertFront, 3);
+    UtAssert_ADDRESS_EQ(chan->tx_prio.tail[10], &txn[0]);
+    UtAssert_ADDRESS_EQ(chan->active[CF_Direction_TX].txn[0], &txn[0]);
+
+    /* a queue without a priority index just goes on the back */
     UT_SetDataBuffer(UT_KEY(CF_CList_InsertBack), &context_clist_insert_back, sizeof(context_clist_insert_back), false);
-
-    /* Act */
-    CF_InsertSortPrio(arg_t, arg_q);
-
-    /* Assert */
-    UtAssert_STUB_COUNT(CF_CList_Traverse_R, 1);
-    UtAssert_ADDRESS_EQ(context_cf_clist_traverse_r.end, expected_end);
-    UtAssert_True(context_cf_clist_traverse_r.fn == expected_fn, "context_cf_clist_traverse_r.fn ==  expected_fn");
-    UtAssert_STUB_COUNT(CF_CList_InsertAfter, 0);
+    memset(&txn[1], 0, sizeof(txn[1]));
+    txn[1].chan_num = UT_CFDP_CHANNEL;
+    txn[1].state    = CF_TxnState_R1;
+    UtAssert_VOIDCALL(CF_InsertSortPrio(&txn[1], CF_QueueIdx_RX));
     UtAssert_STUB_COUNT(CF_CList_InsertBack, 1);
-    UtAssert_ADDRESS_EQ(context_clist_insert_back.head, expected_insert_back_head);
-    UtAssert_ADDRESS_EQ(context_clist_insert_back.node, expected_insert_back_node);
-    UtAssert_True(arg_t->flags.com.q_index == arg_q,
-                  "txn->flags.com.q_index is %u and should be %u (q)",
-                  arg_t->flags.com.q_index,
-                  arg_q);
+    UtAssert_ADDRESS_EQ(context_clist_insert_back.head, &chan->qs[CF_QueueIdx_RX]);
+    UtAssert_ADDRESS_EQ(context_clist_insert_back.node, &txn[1].cl_node);
+    UtAssert_UINT32_EQ(txn[1].flags.com.q_index, CF_QueueIdx_RX);
 }
 
 /*******************************************************************************
@@ -1227,6 +1294,82 @@ void Test_CF_TxnStatus_From_ConditionCode(void)
     }
 }
 
+/* time returned by the CFE_TIME_GetTime handler below */
+static CFE_TIME_SysTime_t UT_CF_Utils_Now;
+
+static void UT_CF_Utils_GetTime_Handler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_Stub_SetReturnValue(FuncKey, UT_CF_Utils_Now);
+}
+
+static void UT_CF_Utils_Subtract_Handler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_TIME_SysTime_t time1 = UT_Hook_GetArgValueByName(Context, "Time1", CFE_TIME_SysTime_t);
+    CFE_TIME_SysTime_t time2 = UT_Hook_GetArgValueByName(Context, "Time2", CFE_TIME_SysTime_t);
+    CFE_TIME_SysTime_t diff;
+
+    /* subseconds are left out, the tests only step whole seconds */
+    diff.Seconds    = time1.Seconds - time2.Seconds;
+    diff.Subseconds = 0;
+
+    UT_Stub_SetReturnValue(FuncKey, diff);
+}
+
+void Test_CF_TxnMetrics_Start(void)
+{
+    /* Test case for:
+     * void CF_TxnMetrics_Start(CF_TxnMetrics_t *metrics);
+     */
+    CF_TxnMetrics_t metrics;
+
+    UT_CF_Utils_Now.Seconds    = 100;
+    UT_CF_Utils_Now.Subseconds = 0x80000000;
+    UT_SetHandlerFunction(UT_KEY(CFE_TIME_GetTime), UT_CF_Utils_GetTime_Handler, NULL);
+
+    /* a reused history starts over */
+    memset(&metrics, 0xA5, sizeof(metrics));
+    UtAssert_VOIDCALL(CF_TxnMetrics_Start(&metrics));
+    UtAssert_UINT32_EQ(metrics.start_secs, 100);
+    UtAssert_UINT32_EQ(metrics.start_subsecs, 0x80000000);
+    UtAssert_ZERO(metrics.first_pdu_ms);
+    UtAssert_ZERO(metrics.eof_ms);
+    UtAssert_ZERO(metrics.end_ms);
+    UtAssert_ZERO(metrics.fd_bytes);
+    UtAssert_ZERO(metrics.nak_rounds);
+    UtAssert_ZERO(metrics.nak_segments);
+    UtAssert_ZERO(metrics.peak_chunks);
+}
+
+void Test_CF_TxnMetrics_Mark(void)
+{
+    /* Test case for:
+     * void CF_TxnMetrics_Mark(const CF_TxnMetrics_t *metrics, uint32 *event_ms);
+     */
+    CF_TxnMetrics_t metrics;
+
+    memset(&metrics, 0, sizeof(metrics));
+    metrics.start_secs = 100;
+    UT_SetHandlerFunction(UT_KEY(CFE_TIME_GetTime), UT_CF_Utils_GetTime_Handler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_TIME_Subtract), UT_CF_Utils_Subtract_Handler, NULL);
+
+    /* an event at the start time still reads as having happened */
+    UT_CF_Utils_Now.Seconds = 100;
+    UtAssert_VOIDCALL(CF_TxnMetrics_Mark(&metrics, &metrics.first_pdu_ms));
+    UtAssert_UINT32_EQ(metrics.first_pdu_ms, 1);
+
+    /* seconds and the subsecond part both count */
+    UT_CF_Utils_Now.Seconds = 102;
+    UT_SetDefaultReturnValue(UT_KEY(CFE_TIME_Sub2MicroSecs), 250000);
+    UtAssert_VOIDCALL(CF_TxnMetrics_Mark(&metrics, &metrics.eof_ms));
+    UtAssert_UINT32_EQ(metrics.eof_ms, 2250);
+
+    /* only the first time is kept */
+    UT_CF_Utils_Now.Seconds = 105;
+    UtAssert_VOIDCALL(CF_TxnMetrics_Mark(&metrics, &metrics.eof_ms));
+    UtAssert_UINT32_EQ(metrics.eof_ms, 2250);
+    UtAssert_STUB_COUNT(CFE_TIME_GetTime, 2);
+}
+
 /*******************************************************************************
 **
 **  cf_utils_tests UtTest_Add groups
@@ -1252,6 +1395,10 @@ void add_cf_utils_h_tests(void)
     UtTest_Add(Test_CF_GetChannelFromTxn, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_GetChannelFromTxn");
     UtTest_Add(Test_CF_GetChunkListHead, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_GetChunkListHead");
     UtTest_Add(Test_CF_CFDP_GetTxnStatus, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_CFDP_GetAckTxnStatus");
+    UtTest_Add(Test_CF_Arena_Init, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_Arena_Init");
+    UtTest_Add(Test_CF_Arena_Alloc, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_Arena_Alloc");
+    UtTest_Add(Test_CF_ActiveSet_Insert, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_ActiveSet_Insert");
+    UtTest_Add(Test_CF_ActiveSet_Remove, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_ActiveSet_Remove");
 
     /* CF_DequeueTransaction tests */
     UtTest_Add(Test_cf_dequeue_transaction_Call_CF_CList_Remove_AndDecrement_q_size,
@@ -1297,6 +1444,8 @@ void add_cf_utils_h_tests(void)
                cf_utils_tests_Setup,
                cf_utils_tests_Teardown,
                "CF_TxnStatus_From_ConditionCode");
+    UtTest_Add(Test_CF_TxnMetrics_Start, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_TxnMetrics_Start");
+    UtTest_Add(Test_CF_TxnMetrics_Mark, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_TxnMetrics_Mark");
 }
 
 void add_CF_Traverse_WriteHistoryToFile_tests(void)
@@ -1331,36 +1480,14 @@ void add_CF_WriteHistoryQueueDataToFile_tests(void)
                "Test_CF_WriteHistoryQueueDataToFile");
 }
 
-void add_CF_PrioSearch_tests(void)
+void add_CF_PrioQueue_Remove_tests(void)
 {
-    UtTest_Add(Test_CF_PrioSearch_When_t_PrioIsGreaterThanContextPrioReturn_CLIST_CONT,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_PrioSearch_When_t_PrioIsGreaterThanContextPrioReturn_CLIST_CONT");
-    UtTest_Add(Test_CF_PrioSearch_When_t_PrioIsEqToContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_PrioSearch_When_t_PrioIsEqToContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT");
-    UtTest_Add(Test_CF_PrioSearch_When_t_PrioIsLessThanContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_PrioSearch_When_t_PrioIsLessThanContextPrio_Set_context_t_To_t_AndReturn_CLIST_EXIT");
+    UtTest_Add(Test_CF_PrioQueue_Remove, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_PrioQueue_Remove");
 }
 
 void add_CF_InsertSortPrio_tests(void)
 {
-    UtTest_Add(Test_CF_InsertSortPrio_Call_CF_CList_InsertBack_Ex_ListIsEmpty_AndSet_q_index_To_q,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_InsertSortPrio_Call_CF_CList_InsertBack_Ex_ListIsEmpty_AndSet_q_index_To_q");
-    UtTest_Add(Test_CF_InsertSortPrio_Call_CF_CList_InsertAfter_Ex_AndSet_q_index_To_q,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_InsertSortPrio_Call_CF_CList_InsertAfter_Ex_AndSet_q_index_To_q");
-    UtTest_Add(Test_CF_InsertSortPrio_When_p_t_Is_NULL_Call_CF_CList_InsertBack_Ex,
-               cf_utils_tests_Setup,
-               cf_utils_tests_Teardown,
-               "Test_CF_InsertSortPrio_When_p_t_Is_NULL_Call_CF_CList_InsertBack_Ex");
+    UtTest_Add(Test_CF_InsertSortPrio, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_InsertSortPrio");
 }
 
 void add_CF_TraverseAllTransactions_Impl_tests(void)
@@ -1451,7 +1578,7 @@ void UtTest_Setup(void)
 
     add_CF_WriteHistoryQueueDataToFile_tests();
 
-    add_CF_PrioSearch_tests();
+    add_CF_PrioQueue_Remove_tests();
 
     add_CF_InsertSortPrio_tests();
 
@@ -0,0 +1,160 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_bundle header
+ */
+
+#include "cf_bundle.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Add()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Bundle_Add(CF_Playback_t *pb, const char *path, const char *name, CF_FileSize_t size, uint32 mtime)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_Add, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Bundle_Add, CF_Playback_t *, pb);
+    UT_GenStub_AddParam(CF_Bundle_Add, const char *, path);
+    UT_GenStub_AddParam(CF_Bundle_Add, const char *, name);
+    UT_GenStub_AddParam(CF_Bundle_Add, CF_FileSize_t, size);
+    UT_GenStub_AddParam(CF_Bundle_Add, uint32, mtime);
+
+    UT_GenStub_Execute(CF_Bundle_Add, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_Add, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Discard()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_Discard(CF_Playback_t *pb)
+{
+    UT_GenStub_AddParam(CF_Bundle_Discard, CF_Playback_t *, pb);
+
+    UT_GenStub_Execute(CF_Bundle_Discard, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_EndScan()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_EndScan(CF_Playback_t *pb)
+{
+    UT_GenStub_AddParam(CF_Bundle_EndScan, CF_Playback_t *, pb);
+
+    UT_GenStub_Execute(CF_Bundle_EndScan, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_FileMax()
+ * ----------------------------------------------------
+ */
+CF_FileSize_t CF_Bundle_FileMax(const CF_Playback_t *pb)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_FileMax, CF_FileSize_t);
+
+    UT_GenStub_AddParam(CF_Bundle_FileMax, const CF_Playback_t *, pb);
+
+    UT_GenStub_Execute(CF_Bundle_FileMax, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_FileMax, CF_FileSize_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_GetPath()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_GetPath(const CF_Playback_t *pb, const char *dir, char *buf, size_t buf_size)
+{
+    UT_GenStub_AddParam(CF_Bundle_GetPath, const CF_Playback_t *, pb);
+    UT_GenStub_AddParam(CF_Bundle_GetPath, const char *, dir);
+    UT_GenStub_AddParam(CF_Bundle_GetPath, char *, buf);
+    UT_GenStub_AddParam(CF_Bundle_GetPath, size_t, buf_size);
+
+    UT_GenStub_Execute(CF_Bundle_GetPath, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_IsBundle()
+ * ----------------------------------------------------
+ */
+bool CF_Bundle_IsBundle(const char *filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_IsBundle, bool);
+
+    UT_GenStub_AddParam(CF_Bundle_IsBundle, const char *, filename);
+
+    UT_GenStub_Execute(CF_Bundle_IsBundle, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_IsBundle, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Retain()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_Retain(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Bundle_Retain, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Bundle_Retain, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Started()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_Started(CF_Playback_t *pb)
+{
+    UT_GenStub_AddParam(CF_Bundle_Started, CF_Playback_t *, pb);
+
+    UT_GenStub_Execute(CF_Bundle_Started, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Unpack()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Bundle_Unpack(CF_Transaction_t *txn, const char *bundle_file, const char *dst_filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_Unpack, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Bundle_Unpack, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Bundle_Unpack, const char *, bundle_file);
+    UT_GenStub_AddParam(CF_Bundle_Unpack, const char *, dst_filename);
+
+    UT_GenStub_Execute(CF_Bundle_Unpack, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_Unpack, CFE_Status_t);
+}
@@ -79,6 +79,32 @@ void CF_CFDP_R2_SubstateRecvFinAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t
     UT_GenStub_Execute(CF_CFDP_R2_SubstateRecvFinAck, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_SubstateRecvPrompt()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R2_SubstateRecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_AddParam(CF_CFDP_R2_SubstateRecvPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R2_SubstateRecvPrompt, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_R2_SubstateRecvPrompt, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_UpdateNakTimer()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R2_UpdateNakTimer(CF_Transaction_t *txn, const CF_Logical_PduFileDataHeader_t *fd)
+{
+    UT_GenStub_AddParam(CF_CFDP_R2_UpdateNakTimer, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R2_UpdateNakTimer, const CF_Logical_PduFileDataHeader_t *, fd);
+
+    UT_GenStub_Execute(CF_CFDP_R2_UpdateNakTimer, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R_AckTimerTick()
@@ -183,6 +209,18 @@ void CF_CFDP_R_Init(CF_Transaction_t *txn)
     UT_GenStub_Execute(CF_CFDP_R_Init, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_NakTimerTick()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R_NakTimerTick(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_R_NakTimerTick, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R_NakTimerTick, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R_ProcessFd()
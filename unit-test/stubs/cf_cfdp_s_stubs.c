@@ -39,6 +39,18 @@ void CF_CFDP_S1_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_S1_Recv, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S2_CheckPrompt()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S2_CheckPrompt(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S2_CheckPrompt, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S2_CheckPrompt, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S2_SubstateEofAck()
@@ -52,6 +64,19 @@ void CF_CFDP_S2_SubstateEofAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph
     UT_GenStub_Execute(CF_CFDP_S2_SubstateEofAck, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S2_SubstateKeepAlive()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S2_SubstateKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_AddParam(CF_CFDP_S2_SubstateKeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_S2_SubstateKeepAlive, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_S2_SubstateKeepAlive, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S2_SubstateNak()
@@ -102,6 +127,19 @@ void CF_CFDP_S_CheckState(CF_Transaction_t *txn)
     UT_GenStub_Execute(CF_CFDP_S_CheckState, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_RetainFile()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_RetainFile(CF_Transaction_t *txn, const char *SubjectFile)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_RetainFile, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_S_RetainFile, const char *, SubjectFile);
+
+    UT_GenStub_Execute(CF_CFDP_S_RetainFile, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S_SubstateEarlyFin()
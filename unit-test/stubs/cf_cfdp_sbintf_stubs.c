@@ -28,6 +28,18 @@
 
 void UT_DefaultHandler_CF_CFDP_MsgOutGet(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_FlushOutput()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_FlushOutput(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_CFDP_FlushOutput, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_CFDP_FlushOutput, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_MsgOutGet()
@@ -57,6 +69,18 @@ void CF_CFDP_ReceiveMessage(CF_Channel_t *chan)
     UT_GenStub_Execute(CF_CFDP_ReceiveMessage, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_ReleaseOutput()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_ReleaseOutput(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_CFDP_ReleaseOutput, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_CFDP_ReleaseOutput, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_Send()
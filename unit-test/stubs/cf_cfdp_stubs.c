@@ -80,6 +80,20 @@ void CF_CFDP_ArmInactTimer(CF_Transaction_t *txn)
     UT_GenStub_Execute(CF_CFDP_ArmInactTimer, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_BudgetSpent()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_BudgetSpent(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_BudgetSpent, bool);
+
+    UT_GenStub_Execute(CF_CFDP_BudgetSpent, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_BudgetSpent, bool);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_CancelTransaction()
@@ -92,6 +106,22 @@ void CF_CFDP_CancelTransaction(CF_Transaction_t *txn)
     UT_GenStub_Execute(CF_CFDP_CancelTransaction, Basic, UT_DefaultHandler_CF_CFDP_CancelTransaction);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_ChannelArenaSize()
+ * ----------------------------------------------------
+ */
+uint64 CF_CFDP_ChannelArenaSize(const CF_ChannelConfig_t *cc)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_ChannelArenaSize, uint64);
+
+    UT_GenStub_AddParam(CF_CFDP_ChannelArenaSize, const CF_ChannelConfig_t *, cc);
+
+    UT_GenStub_Execute(CF_CFDP_ChannelArenaSize, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_ChannelArenaSize, uint64);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_CheckAckNakCount()
@@ -237,23 +267,6 @@ void CF_CFDP_DispatchRecv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_DispatchRecv, Basic, NULL);
 }
 
-/*
- * ----------------------------------------------------
- * Generated stub function for CF_CFDP_DoTick()
- * ----------------------------------------------------
- */
-CF_CListTraverse_Status_t CF_CFDP_DoTick(CF_CListNode_t *node, void *context)
-{
-    UT_GenStub_SetupReturnBuffer(CF_CFDP_DoTick, CF_CListTraverse_Status_t);
-
-    UT_GenStub_AddParam(CF_CFDP_DoTick, CF_CListNode_t *, node);
-    UT_GenStub_AddParam(CF_CFDP_DoTick, void *, context);
-
-    UT_GenStub_Execute(CF_CFDP_DoTick, Basic, NULL);
-
-    return UT_GenStub_GetReturnValue(CF_CFDP_DoTick, CF_CListTraverse_Status_t);
-}
-
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_EncodeStart()
@@ -306,6 +319,23 @@ const char *CF_CFDP_GetMoveTarget(const char *dest_dir, const char *subject_file
     return UT_GenStub_GetReturnValue(CF_CFDP_GetMoveTarget, const char *);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_GetPlaybackPriority()
+ * ----------------------------------------------------
+ */
+uint8 CF_CFDP_GetPlaybackPriority(const CF_Playback_t *pb, const char *name)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_GetPlaybackPriority, uint8);
+
+    UT_GenStub_AddParam(CF_CFDP_GetPlaybackPriority, const CF_Playback_t *, pb);
+    UT_GenStub_AddParam(CF_CFDP_GetPlaybackPriority, const char *, name);
+
+    UT_GenStub_Execute(CF_CFDP_GetPlaybackPriority, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_GetPlaybackPriority, uint8);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_GetTempName()
@@ -377,7 +407,8 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
                                  uint8           keep,
                                  uint8           chan,
                                  uint8           priority,
-                                 uint16          dest_id)
+                                 uint16          dest_id,
+                                 uint8           compress)
 {
     UT_GenStub_SetupReturnBuffer(CF_CFDP_PlaybackDir, CFE_Status_t);
 
@@ -388,6 +419,7 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char     *src_filename,
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, chan);
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, priority);
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint16, dest_id);
+    UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, compress);
 
     UT_GenStub_Execute(CF_CFDP_PlaybackDir, Basic, UT_DefaultHandler_CF_CFDP_PlaybackDir);
 
@@ -539,6 +571,23 @@ void CF_CFDP_RecvInit(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_RecvInit, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_RecvKeepAlive()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_RecvKeepAlive, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_RecvKeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_RecvKeepAlive, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_RecvKeepAlive, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_RecvKeepAlive, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_RecvMd()
@@ -590,6 +639,23 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
     return UT_GenStub_GetReturnValue(CF_CFDP_RecvPh, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_RecvPrompt()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_RecvPrompt, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_RecvPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_RecvPrompt, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_RecvPrompt, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_RecvPrompt, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_RecycleTransaction()
@@ -692,6 +758,23 @@ CFE_Status_t CF_CFDP_SendFin(CF_Transaction_t *txn)
     return UT_GenStub_GetReturnValue(CF_CFDP_SendFin, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SendKeepAlive()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SendKeepAlive, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_SendKeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_SendKeepAlive, CF_FileSize_t, progress);
+
+    UT_GenStub_Execute(CF_CFDP_SendKeepAlive, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SendKeepAlive, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_SendMd()
@@ -721,6 +804,23 @@ void CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_SendNak, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SendPrompt()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SendPrompt, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_SendPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_SendPrompt, CF_CFDP_PromptResponse_t, response);
+
+    UT_GenStub_Execute(CF_CFDP_SendPrompt, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SendPrompt, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_SetTxnStatus()
@@ -791,6 +891,32 @@ CF_Transaction_t *CF_CFDP_StartRxTransaction(uint8 chan_num)
     return UT_GenStub_GetReturnValue(CF_CFDP_StartRxTransaction, CF_Transaction_t *);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_TickActiveSet()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_TickActiveSet(CF_Channel_t *chan, CF_TickState_t tick_state, uint32 start_idx)
+{
+    UT_GenStub_AddParam(CF_CFDP_TickActiveSet, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_CFDP_TickActiveSet, CF_TickState_t, tick_state);
+    UT_GenStub_AddParam(CF_CFDP_TickActiveSet, uint32, start_idx);
+
+    UT_GenStub_Execute(CF_CFDP_TickActiveSet, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_TickNewData()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_TickNewData(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_CFDP_TickNewData, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_CFDP_TickNewData, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_TickTransactions()
@@ -814,7 +940,8 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
                             uint8           keep,
                             uint8           chan,
                             uint8           priority,
-                            CF_EntityId_t   dest_id)
+                            CF_EntityId_t   dest_id,
+                            uint8           compress)
 {
     UT_GenStub_SetupReturnBuffer(CF_CFDP_TxFile, CFE_Status_t);
 
@@ -825,6 +952,7 @@ CFE_Status_t CF_CFDP_TxFile(const char     *src_filename,
     UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, chan);
     UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, priority);
     UT_GenStub_AddParam(CF_CFDP_TxFile, CF_EntityId_t, dest_id);
+    UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, compress);
 
     UT_GenStub_Execute(CF_CFDP_TxFile, Basic, UT_DefaultHandler_CF_CFDP_TxFile);
 
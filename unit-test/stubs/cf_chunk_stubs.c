@@ -47,11 +47,12 @@ void CF_ChunkListAdd(CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSi
  * Generated stub function for CF_ChunkListInit()
  * ----------------------------------------------------
  */
-void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t *chunks_mem)
+void CF_ChunkListInit(CF_ChunkList_t *chunks, CF_ChunkIdx_t max_chunks, CF_Chunk_t **blocks, CF_ChunkSlab_t *slab)
 {
     UT_GenStub_AddParam(CF_ChunkListInit, CF_ChunkList_t *, chunks);
     UT_GenStub_AddParam(CF_ChunkListInit, CF_ChunkIdx_t, max_chunks);
-    UT_GenStub_AddParam(CF_ChunkListInit, CF_Chunk_t *, chunks_mem);
+    UT_GenStub_AddParam(CF_ChunkListInit, CF_Chunk_t **, blocks);
+    UT_GenStub_AddParam(CF_ChunkListInit, CF_ChunkSlab_t *, slab);
 
     UT_GenStub_Execute(CF_ChunkListInit, Basic, NULL);
 }
@@ -123,6 +124,39 @@ void CF_ChunkList_RemoveFromFirst(CF_ChunkList_t *chunks, CF_ChunkSize_t size)
     UT_GenStub_Execute(CF_ChunkList_RemoveFromFirst, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_ChunkSlab_Init()
+ * ----------------------------------------------------
+ */
+void CF_ChunkSlab_Init(CF_ChunkSlab_t *slab, CF_ChunkIdx_t num_blocks, CF_ChunkIdx_t num_reserved,
+                       CF_Chunk_t *block_mem, CF_Chunk_t **free_blocks)
+{
+    UT_GenStub_AddParam(CF_ChunkSlab_Init, CF_ChunkSlab_t *, slab);
+    UT_GenStub_AddParam(CF_ChunkSlab_Init, CF_ChunkIdx_t, num_blocks);
+    UT_GenStub_AddParam(CF_ChunkSlab_Init, CF_ChunkIdx_t, num_reserved);
+    UT_GenStub_AddParam(CF_ChunkSlab_Init, CF_Chunk_t *, block_mem);
+    UT_GenStub_AddParam(CF_ChunkSlab_Init, CF_Chunk_t **, free_blocks);
+
+    UT_GenStub_Execute(CF_ChunkSlab_Init, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Chunks_Capacity()
+ * ----------------------------------------------------
+ */
+CF_ChunkIdx_t CF_Chunks_Capacity(const CF_ChunkList_t *chunks)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Chunks_Capacity, CF_ChunkIdx_t);
+
+    UT_GenStub_AddParam(CF_Chunks_Capacity, const CF_ChunkList_t *, chunks);
+
+    UT_GenStub_Execute(CF_Chunks_Capacity, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Chunks_Capacity, CF_ChunkIdx_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_Chunks_CombineNext()
@@ -219,6 +253,22 @@ CF_ChunkIdx_t CF_Chunks_FindSmallestSize(const CF_ChunkList_t *chunks)
     return UT_GenStub_GetReturnValue(CF_Chunks_FindSmallestSize, CF_ChunkIdx_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Chunks_Grow()
+ * ----------------------------------------------------
+ */
+bool CF_Chunks_Grow(CF_ChunkList_t *chunks)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Chunks_Grow, bool);
+
+    UT_GenStub_AddParam(CF_Chunks_Grow, CF_ChunkList_t *, chunks);
+
+    UT_GenStub_Execute(CF_Chunks_Grow, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Chunks_Grow, bool);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_Chunks_Insert()
@@ -0,0 +1,135 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_compress header
+ */
+
+#include "cf_compress.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_ExpandStart()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Compress_ExpandStart(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_ExpandStart, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Compress_ExpandStart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Compress_ExpandStart, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_ExpandStart, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_ExpandStep()
+ * ----------------------------------------------------
+ */
+bool CF_Compress_ExpandStep(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_ExpandStep, bool);
+
+    UT_GenStub_AddParam(CF_Compress_ExpandStep, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Compress_ExpandStep, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_ExpandStep, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_FileStart()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Compress_FileStart(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_FileStart, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Compress_FileStart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Compress_FileStart, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_FileStart, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_FileStep()
+ * ----------------------------------------------------
+ */
+bool CF_Compress_FileStep(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_FileStep, bool);
+
+    UT_GenStub_AddParam(CF_Compress_FileStep, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Compress_FileStep, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_FileStep, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_GetMd()
+ * ----------------------------------------------------
+ */
+uint8 CF_Compress_GetMd(const CF_Logical_PduMd_t *md)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_GetMd, uint8);
+
+    UT_GenStub_AddParam(CF_Compress_GetMd, const CF_Logical_PduMd_t *, md);
+
+    UT_GenStub_Execute(CF_Compress_GetMd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_GetMd, uint8);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_GetTempName()
+ * ----------------------------------------------------
+ */
+void CF_Compress_GetTempName(const CF_History_t *hist, const char *suffix, char *buf, size_t buf_size)
+{
+    UT_GenStub_AddParam(CF_Compress_GetTempName, const CF_History_t *, hist);
+    UT_GenStub_AddParam(CF_Compress_GetTempName, const char *, suffix);
+    UT_GenStub_AddParam(CF_Compress_GetTempName, char *, buf);
+    UT_GenStub_AddParam(CF_Compress_GetTempName, size_t, buf_size);
+
+    UT_GenStub_Execute(CF_Compress_GetTempName, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_SetMd()
+ * ----------------------------------------------------
+ */
+void CF_Compress_SetMd(CF_Logical_PduMd_t *md, uint8 method)
+{
+    UT_GenStub_AddParam(CF_Compress_SetMd, CF_Logical_PduMd_t *, md);
+    UT_GenStub_AddParam(CF_Compress_SetMd, uint8, method);
+
+    UT_GenStub_Execute(CF_Compress_SetMd, Basic, NULL);
+}
@@ -0,0 +1,168 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_delta header
+ */
+
+#include "cf_delta.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Finish()
+ * ----------------------------------------------------
+ */
+void CF_Delta_Finish(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Delta_Finish, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_Finish, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_GetMd()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_GetMd(const CF_Logical_PduMd_t *md)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_GetMd, bool);
+
+    UT_GenStub_AddParam(CF_Delta_GetMd, const CF_Logical_PduMd_t *, md);
+
+    UT_GenStub_Execute(CF_Delta_GetMd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_GetMd, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_GetSigName()
+ * ----------------------------------------------------
+ */
+void CF_Delta_GetSigName(CF_EntityId_t peer_eid, const char *dst_filename, char *buf, size_t buf_size)
+{
+    UT_GenStub_AddParam(CF_Delta_GetSigName, CF_EntityId_t, peer_eid);
+    UT_GenStub_AddParam(CF_Delta_GetSigName, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_Delta_GetSigName, char *, buf);
+    UT_GenStub_AddParam(CF_Delta_GetSigName, size_t, buf_size);
+
+    UT_GenStub_Execute(CF_Delta_GetSigName, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Hash()
+ * ----------------------------------------------------
+ */
+uint32 CF_Delta_Hash(const void *data, size_t len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Hash, uint32);
+
+    UT_GenStub_AddParam(CF_Delta_Hash, const void *, data);
+    UT_GenStub_AddParam(CF_Delta_Hash, size_t, len);
+
+    UT_GenStub_Execute(CF_Delta_Hash, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Hash, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_PrefillStart()
+ * ----------------------------------------------------
+ */
+void CF_Delta_PrefillStart(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Delta_PrefillStart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_PrefillStart, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_PrefillStep()
+ * ----------------------------------------------------
+ */
+void CF_Delta_PrefillStep(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Delta_PrefillStep, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_PrefillStep, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Restart()
+ * ----------------------------------------------------
+ */
+void CF_Delta_Restart(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Delta_Restart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_Restart, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_ScanStart()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_ScanStart(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_ScanStart, bool);
+
+    UT_GenStub_AddParam(CF_Delta_ScanStart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_ScanStart, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_ScanStart, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_ScanStep()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_ScanStep(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_ScanStep, bool);
+
+    UT_GenStub_AddParam(CF_Delta_ScanStep, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Delta_ScanStep, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_ScanStep, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_SetMd()
+ * ----------------------------------------------------
+ */
+void CF_Delta_SetMd(const CF_Transaction_t *txn, CF_Logical_PduMd_t *md)
+{
+    UT_GenStub_AddParam(CF_Delta_SetMd, const CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Delta_SetMd, CF_Logical_PduMd_t *, md);
+
+    UT_GenStub_Execute(CF_Delta_SetMd, Basic, NULL);
+}
@@ -0,0 +1,117 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_diag header
+ */
+
+#include "cf_diag.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_EndChannel()
+ * ----------------------------------------------------
+ */
+void CF_Diag_EndChannel(uint8 chan_num)
+{
+    UT_GenStub_AddParam(CF_Diag_EndChannel, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_Diag_EndChannel, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_EndCycle()
+ * ----------------------------------------------------
+ */
+void CF_Diag_EndCycle(const OS_time_t *start)
+{
+    UT_GenStub_AddParam(CF_Diag_EndCycle, const OS_time_t *, start);
+
+    UT_GenStub_Execute(CF_Diag_EndCycle, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Init()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Init(void)
+{
+    UT_GenStub_Execute(CF_Diag_Init, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Lap()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Lap(uint8 chan_num, CF_DiagPhase_t phase, OS_time_t *mark)
+{
+    UT_GenStub_AddParam(CF_Diag_Lap, uint8, chan_num);
+    UT_GenStub_AddParam(CF_Diag_Lap, CF_DiagPhase_t, phase);
+    UT_GenStub_AddParam(CF_Diag_Lap, OS_time_t *, mark);
+
+    UT_GenStub_Execute(CF_Diag_Lap, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Mark()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Mark(OS_time_t *mark)
+{
+    UT_GenStub_AddParam(CF_Diag_Mark, OS_time_t *, mark);
+
+    UT_GenStub_Execute(CF_Diag_Mark, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Reset()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Reset(void)
+{
+    UT_GenStub_Execute(CF_Diag_Reset, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Send()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Send(void)
+{
+    UT_GenStub_Execute(CF_Diag_Send, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Diag_Update()
+ * ----------------------------------------------------
+ */
+void CF_Diag_Update(void)
+{
+    UT_GenStub_Execute(CF_Diag_Update, Basic, NULL);
+}
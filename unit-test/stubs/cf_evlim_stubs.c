@@ -0,0 +1,65 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_evlim header
+ */
+
+#include "cf_evlim.h"
+#include "utgenstub.h"
+
+void UT_DefaultHandler_CF_EvLim_Allow(void *, UT_EntryKey_t, const UT_StubContext_t *);
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_EvLim_Allow()
+ * ----------------------------------------------------
+ */
+bool CF_EvLim_Allow(uint16 event_id)
+{
+    UT_GenStub_SetupReturnBuffer(CF_EvLim_Allow, bool);
+
+    UT_GenStub_AddParam(CF_EvLim_Allow, uint16, event_id);
+
+    UT_GenStub_Execute(CF_EvLim_Allow, Basic, UT_DefaultHandler_CF_EvLim_Allow);
+
+    return UT_GenStub_GetReturnValue(CF_EvLim_Allow, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_EvLim_Init()
+ * ----------------------------------------------------
+ */
+void CF_EvLim_Init(void)
+{
+    UT_GenStub_Execute(CF_EvLim_Init, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_EvLim_Tick()
+ * ----------------------------------------------------
+ */
+void CF_EvLim_Tick(void)
+{
+    UT_GenStub_Execute(CF_EvLim_Tick, Basic, NULL);
+}
@@ -0,0 +1,218 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_journal header
+ */
+
+#include "cf_journal.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_Digest()
+ * ----------------------------------------------------
+ */
+uint32 CF_Journal_Digest(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_Digest, uint32);
+
+    UT_GenStub_Execute(CF_Journal_Digest, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_Digest, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_DigestTxn()
+ * ----------------------------------------------------
+ */
+CF_CListTraverse_Status_t CF_Journal_DigestTxn(CF_CListNode_t *node, void *context)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_DigestTxn, CF_CListTraverse_Status_t);
+
+    UT_GenStub_AddParam(CF_Journal_DigestTxn, CF_CListNode_t *, node);
+    UT_GenStub_AddParam(CF_Journal_DigestTxn, void *, context);
+
+    UT_GenStub_Execute(CF_Journal_DigestTxn, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_DigestTxn, CF_CListTraverse_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_IsEligible()
+ * ----------------------------------------------------
+ */
+bool CF_Journal_IsEligible(const CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_IsEligible, bool);
+
+    UT_GenStub_AddParam(CF_Journal_IsEligible, const CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Journal_IsEligible, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_IsEligible, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_Restore()
+ * ----------------------------------------------------
+ */
+void CF_Journal_Restore(void)
+{
+    UT_GenStub_Execute(CF_Journal_Restore, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_ResumeTxn()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Journal_ResumeTxn(CF_Transaction_t *txn, osal_id_t fd, const CF_JournalRecord_t *rec)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_ResumeTxn, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Journal_ResumeTxn, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Journal_ResumeTxn, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Journal_ResumeTxn, const CF_JournalRecord_t *, rec);
+
+    UT_GenStub_Execute(CF_Journal_ResumeTxn, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_ResumeTxn, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_Tick()
+ * ----------------------------------------------------
+ */
+void CF_Journal_Tick(void)
+{
+    UT_GenStub_Execute(CF_Journal_Tick, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_Verify()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Journal_Verify(osal_id_t fd, const CF_JournalHeader_t *hdr)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_Verify, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Journal_Verify, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Journal_Verify, const CF_JournalHeader_t *, hdr);
+
+    UT_GenStub_Execute(CF_Journal_Verify, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_Verify, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteFinish()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Journal_WriteFinish(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_WriteFinish, CFE_Status_t);
+
+    UT_GenStub_Execute(CF_Journal_WriteFinish, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_WriteFinish, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteRecord()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Journal_WriteRecord(osal_id_t fd, const CF_Transaction_t *txn, CF_Crc_t *crc)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_WriteRecord, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Journal_WriteRecord, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Journal_WriteRecord, const CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Journal_WriteRecord, CF_Crc_t *, crc);
+
+    UT_GenStub_Execute(CF_Journal_WriteRecord, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_WriteRecord, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteSpilled()
+ * ----------------------------------------------------
+ */
+void CF_Journal_WriteSpilled(CF_Checkpoint_t *cp, uint8 chan_num, const CF_SpillEntry_t *entry)
+{
+    UT_GenStub_AddParam(CF_Journal_WriteSpilled, CF_Checkpoint_t *, cp);
+    UT_GenStub_AddParam(CF_Journal_WriteSpilled, uint8, chan_num);
+    UT_GenStub_AddParam(CF_Journal_WriteSpilled, const CF_SpillEntry_t *, entry);
+
+    UT_GenStub_Execute(CF_Journal_WriteSpilled, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteStart()
+ * ----------------------------------------------------
+ */
+void CF_Journal_WriteStart(uint32 digest)
+{
+    UT_GenStub_AddParam(CF_Journal_WriteStart, uint32, digest);
+
+    UT_GenStub_Execute(CF_Journal_WriteStart, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteStep()
+ * ----------------------------------------------------
+ */
+bool CF_Journal_WriteStep(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_WriteStep, bool);
+
+    UT_GenStub_Execute(CF_Journal_WriteStep, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_WriteStep, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Journal_WriteTxn()
+ * ----------------------------------------------------
+ */
+CF_CListTraverse_Status_t CF_Journal_WriteTxn(CF_CListNode_t *node, void *context)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Journal_WriteTxn, CF_CListTraverse_Status_t);
+
+    UT_GenStub_AddParam(CF_Journal_WriteTxn, CF_CListNode_t *, node);
+    UT_GenStub_AddParam(CF_Journal_WriteTxn, void *, context);
+
+    UT_GenStub_Execute(CF_Journal_WriteTxn, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Journal_WriteTxn, CF_CListTraverse_Status_t);
+}
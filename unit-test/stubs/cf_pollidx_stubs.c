@@ -0,0 +1,121 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_pollidx header
+ */
+
+#include "cf_pollidx.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_BeginScan()
+ * ----------------------------------------------------
+ */
+void CF_PollIdx_BeginScan(CF_Poll_t *poll)
+{
+    UT_GenStub_AddParam(CF_PollIdx_BeginScan, CF_Poll_t *, poll);
+
+    UT_GenStub_Execute(CF_PollIdx_BeginScan, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_EndScan()
+ * ----------------------------------------------------
+ */
+void CF_PollIdx_EndScan(CF_Poll_t *poll, const CF_PollDir_t *pd)
+{
+    UT_GenStub_AddParam(CF_PollIdx_EndScan, CF_Poll_t *, poll);
+    UT_GenStub_AddParam(CF_PollIdx_EndScan, const CF_PollDir_t *, pd);
+
+    UT_GenStub_Execute(CF_PollIdx_EndScan, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_FileSettled()
+ * ----------------------------------------------------
+ */
+bool CF_PollIdx_FileSettled(const char *path)
+{
+    UT_GenStub_SetupReturnBuffer(CF_PollIdx_FileSettled, bool);
+
+    UT_GenStub_AddParam(CF_PollIdx_FileSettled, const char *, path);
+
+    UT_GenStub_Execute(CF_PollIdx_FileSettled, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_PollIdx_FileSettled, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_Invalidate()
+ * ----------------------------------------------------
+ */
+void CF_PollIdx_Invalidate(CF_Poll_t *poll)
+{
+    UT_GenStub_AddParam(CF_PollIdx_Invalidate, CF_Poll_t *, poll);
+
+    UT_GenStub_Execute(CF_PollIdx_Invalidate, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_Load()
+ * ----------------------------------------------------
+ */
+void CF_PollIdx_Load(void)
+{
+    UT_GenStub_Execute(CF_PollIdx_Load, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_Save()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_PollIdx_Save(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_PollIdx_Save, CFE_Status_t);
+
+    UT_GenStub_Execute(CF_PollIdx_Save, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_PollIdx_Save, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_PollIdx_Unchanged()
+ * ----------------------------------------------------
+ */
+bool CF_PollIdx_Unchanged(const CF_Poll_t *poll, const CF_PollDir_t *pd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_PollIdx_Unchanged, bool);
+
+    UT_GenStub_AddParam(CF_PollIdx_Unchanged, const CF_Poll_t *, poll);
+    UT_GenStub_AddParam(CF_PollIdx_Unchanged, const CF_PollDir_t *, pd);
+
+    UT_GenStub_Execute(CF_PollIdx_Unchanged, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_PollIdx_Unchanged, bool);
+}
@@ -0,0 +1,98 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_rtt header
+ */
+
+#include "cf_rtt.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Rtt_GetSrtt()
+ * ----------------------------------------------------
+ */
+uint32 CF_Rtt_GetSrtt(CF_EntityId_t peer_eid)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Rtt_GetSrtt, uint32);
+
+    UT_GenStub_AddParam(CF_Rtt_GetSrtt, CF_EntityId_t, peer_eid);
+
+    UT_GenStub_Execute(CF_Rtt_GetSrtt, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Rtt_GetSrtt, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Rtt_GetTimeout()
+ * ----------------------------------------------------
+ */
+CF_Timer_Ticks_t CF_Rtt_GetTimeout(const CF_Transaction_t *txn, CF_Timer_Seconds_t static_s)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Rtt_GetTimeout, CF_Timer_Ticks_t);
+
+    UT_GenStub_AddParam(CF_Rtt_GetTimeout, const CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Rtt_GetTimeout, CF_Timer_Seconds_t, static_s);
+
+    UT_GenStub_Execute(CF_Rtt_GetTimeout, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Rtt_GetTimeout, CF_Timer_Ticks_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Rtt_Start()
+ * ----------------------------------------------------
+ */
+void CF_Rtt_Start(CF_Transaction_t *txn, bool retransmit)
+{
+    UT_GenStub_AddParam(CF_Rtt_Start, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Rtt_Start, bool, retransmit);
+
+    UT_GenStub_Execute(CF_Rtt_Start, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Rtt_Stop()
+ * ----------------------------------------------------
+ */
+void CF_Rtt_Stop(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Rtt_Stop, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Rtt_Stop, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Rtt_Update()
+ * ----------------------------------------------------
+ */
+void CF_Rtt_Update(CF_EntityId_t peer_eid, uint32 sample_ms)
+{
+    UT_GenStub_AddParam(CF_Rtt_Update, CF_EntityId_t, peer_eid);
+    UT_GenStub_AddParam(CF_Rtt_Update, uint32, sample_ms);
+
+    UT_GenStub_Execute(CF_Rtt_Update, Basic, NULL);
+}
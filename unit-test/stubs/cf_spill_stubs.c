@@ -0,0 +1,200 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_spill header
+ */
+
+#include "cf_spill.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Find()
+ * ----------------------------------------------------
+ */
+CF_SpillEntry_t *CF_Spill_Find(CF_Channel_t *chan, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_Find, CF_SpillEntry_t *);
+
+    UT_GenStub_AddParam(CF_Spill_Find, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_Spill_Find, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Spill_Find, CF_TransactionSeq_t, seq_num);
+
+    UT_GenStub_Execute(CF_Spill_Find, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_Find, CF_SpillEntry_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_GetName()
+ * ----------------------------------------------------
+ */
+void CF_Spill_GetName(CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num, char *FileNameBuf, size_t FileNameSize)
+{
+    UT_GenStub_AddParam(CF_Spill_GetName, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Spill_GetName, CF_TransactionSeq_t, seq_num);
+    UT_GenStub_AddParam(CF_Spill_GetName, char *, FileNameBuf);
+    UT_GenStub_AddParam(CF_Spill_GetName, size_t, FileNameSize);
+
+    UT_GenStub_Execute(CF_Spill_GetName, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_IdleTxn()
+ * ----------------------------------------------------
+ */
+CF_CListTraverse_Status_t CF_Spill_IdleTxn(CF_CListNode_t *node, void *context)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_IdleTxn, CF_CListTraverse_Status_t);
+
+    UT_GenStub_AddParam(CF_Spill_IdleTxn, CF_CListNode_t *, node);
+    UT_GenStub_AddParam(CF_Spill_IdleTxn, void *, context);
+
+    UT_GenStub_Execute(CF_Spill_IdleTxn, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_IdleTxn, CF_CListTraverse_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Keep()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Spill_Keep(CF_Channel_t *chan, osal_id_t fd, const CF_JournalRecord_t *rec)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_Keep, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Spill_Keep, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_Spill_Keep, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Spill_Keep, const CF_JournalRecord_t *, rec);
+
+    UT_GenStub_Execute(CF_Spill_Keep, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_Keep, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Load()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Spill_Load(CF_Transaction_t *txn, CF_Channel_t *chan, CF_SpillEntry_t *entry)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_Load, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Spill_Load, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Spill_Load, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_Spill_Load, CF_SpillEntry_t *, entry);
+
+    UT_GenStub_Execute(CF_Spill_Load, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_Load, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_MakeRoom()
+ * ----------------------------------------------------
+ */
+bool CF_Spill_MakeRoom(CF_Channel_t *chan)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_MakeRoom, bool);
+
+    UT_GenStub_AddParam(CF_Spill_MakeRoom, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_Spill_MakeRoom, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_MakeRoom, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Reload()
+ * ----------------------------------------------------
+ */
+CF_Transaction_t *CF_Spill_Reload(CF_Channel_t *chan, CF_SpillEntry_t *entry)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_Reload, CF_Transaction_t *);
+
+    UT_GenStub_AddParam(CF_Spill_Reload, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_Spill_Reload, CF_SpillEntry_t *, entry);
+
+    UT_GenStub_Execute(CF_Spill_Reload, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_Reload, CF_Transaction_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_ReloadAll()
+ * ----------------------------------------------------
+ */
+void CF_Spill_ReloadAll(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_Spill_ReloadAll, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_Spill_ReloadAll, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Remove()
+ * ----------------------------------------------------
+ */
+void CF_Spill_Remove(CF_Channel_t *chan, CF_SpillEntry_t *entry, bool keep_temp)
+{
+    UT_GenStub_AddParam(CF_Spill_Remove, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_Spill_Remove, CF_SpillEntry_t *, entry);
+    UT_GenStub_AddParam(CF_Spill_Remove, bool, keep_temp);
+
+    UT_GenStub_Execute(CF_Spill_Remove, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Tick()
+ * ----------------------------------------------------
+ */
+void CF_Spill_Tick(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_Spill_Tick, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_Spill_Tick, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Spill_Txn()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Spill_Txn(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Spill_Txn, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Spill_Txn, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Spill_Txn, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Spill_Txn, CFE_Status_t);
+}
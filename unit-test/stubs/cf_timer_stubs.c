@@ -55,6 +55,19 @@ void CF_Timer_InitRelSec(CF_Timer_t *txn, CF_Timer_Seconds_t rel_sec)
     UT_GenStub_Execute(CF_Timer_InitRelSec, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Timer_InitRelTicks()
+ * ----------------------------------------------------
+ */
+void CF_Timer_InitRelTicks(CF_Timer_t *txn, CF_Timer_Ticks_t rel_ticks)
+{
+    UT_GenStub_AddParam(CF_Timer_InitRelTicks, CF_Timer_t *, txn);
+    UT_GenStub_AddParam(CF_Timer_InitRelTicks, CF_Timer_Ticks_t, rel_ticks);
+
+    UT_GenStub_Execute(CF_Timer_InitRelTicks, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_Timer_Sec2Ticks()
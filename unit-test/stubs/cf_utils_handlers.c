@@ -40,6 +40,45 @@
 
 #include "cf_test_utils.h"
 
+/*----------------------------------------------------------------
+ *
+ * Sets up the arena like the real function, so that callers can carve
+ * usable memory from it with the CF_Arena_Alloc() default handler.
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_Arena_Init(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Arena_t *arena = UT_Hook_GetArgValueByName(Context, "arena", CF_Arena_t *);
+
+    arena->base = UT_Hook_GetArgValueByName(Context, "mem", void *);
+    arena->size = UT_Hook_GetArgValueByName(Context, "size", size_t);
+    arena->used = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Carves from the arena like the real function
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_Arena_Alloc(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Arena_t *arena = UT_Hook_GetArgValueByName(Context, "arena", CF_Arena_t *);
+    size_t      size  = CF_ARENA_ROUNDUP(UT_Hook_GetArgValueByName(Context, "size", size_t));
+    void       *forced_return;
+
+    if (size <= (arena->size - arena->used))
+    {
+        forced_return = &arena->base[arena->used];
+        arena->used += size;
+    }
+    else
+    {
+        forced_return = NULL;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, forced_return);
+}
+
 /*----------------------------------------------------------------
  *
  * For compatibility with other tests, this has a mechanism to save its
@@ -26,6 +26,8 @@
 #include "cf_utils.h"
 #include "utgenstub.h"
 
+void UT_DefaultHandler_CF_Arena_Alloc(void *, UT_EntryKey_t, const UT_StubContext_t *);
+void UT_DefaultHandler_CF_Arena_Init(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_FindTransactionBySequenceNumber(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_FindUnusedTransaction(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_ResetHistory(void *, UT_EntryKey_t, const UT_StubContext_t *);
@@ -36,6 +38,61 @@ void UT_DefaultHandler_CF_WrappedOpenCreate(void *, UT_EntryKey_t, const UT_Stub
 void UT_DefaultHandler_CF_WriteHistoryQueueDataToFile(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_WriteTxnQueueDataToFile(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_ActiveSet_Insert()
+ * ----------------------------------------------------
+ */
+void CF_ActiveSet_Insert(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_ActiveSet_Insert, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_ActiveSet_Insert, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_ActiveSet_Remove()
+ * ----------------------------------------------------
+ */
+void CF_ActiveSet_Remove(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_ActiveSet_Remove, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_ActiveSet_Remove, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Arena_Alloc()
+ * ----------------------------------------------------
+ */
+void *CF_Arena_Alloc(CF_Arena_t *arena, size_t size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Arena_Alloc, void *);
+
+    UT_GenStub_AddParam(CF_Arena_Alloc, CF_Arena_t *, arena);
+    UT_GenStub_AddParam(CF_Arena_Alloc, size_t, size);
+
+    UT_GenStub_Execute(CF_Arena_Alloc, Basic, UT_DefaultHandler_CF_Arena_Alloc);
+
+    return UT_GenStub_GetReturnValue(CF_Arena_Alloc, void *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Arena_Init()
+ * ----------------------------------------------------
+ */
+void CF_Arena_Init(CF_Arena_t *arena, void *mem, size_t size)
+{
+    UT_GenStub_AddParam(CF_Arena_Init, CF_Arena_t *, arena);
+    UT_GenStub_AddParam(CF_Arena_Init, void *, mem);
+    UT_GenStub_AddParam(CF_Arena_Init, size_t, size);
+
+    UT_GenStub_Execute(CF_Arena_Init, Basic, UT_DefaultHandler_CF_Arena_Init);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_GetAckTxnStatus()
@@ -167,19 +224,14 @@ void CF_InsertSortPrio(CF_Transaction_t *txn, CF_QueueIdx_t queue)
 
 /*
  * ----------------------------------------------------
- * Generated stub function for CF_PrioSearch()
+ * Generated stub function for CF_PrioQueue_Remove()
  * ----------------------------------------------------
  */
-CF_CListTraverse_Status_t CF_PrioSearch(CF_CListNode_t *node, void *context)
+void CF_PrioQueue_Remove(CF_Transaction_t *txn)
 {
-    UT_GenStub_SetupReturnBuffer(CF_PrioSearch, CF_CListTraverse_Status_t);
-
-    UT_GenStub_AddParam(CF_PrioSearch, CF_CListNode_t *, node);
-    UT_GenStub_AddParam(CF_PrioSearch, void *, context);
-
-    UT_GenStub_Execute(CF_PrioSearch, Basic, NULL);
+    UT_GenStub_AddParam(CF_PrioQueue_Remove, CF_Transaction_t *, txn);
 
-    return UT_GenStub_GetReturnValue(CF_PrioSearch, CF_CListTraverse_Status_t);
+    UT_GenStub_Execute(CF_PrioQueue_Remove, Basic, NULL);
 }
 
 /*
@@ -283,6 +335,31 @@ CF_CListTraverse_Status_t CF_Traverse_WriteTxnQueueEntryToFile(CF_CListNode_t *n
     return UT_GenStub_GetReturnValue(CF_Traverse_WriteTxnQueueEntryToFile, CF_CListTraverse_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_TxnMetrics_Mark()
+ * ----------------------------------------------------
+ */
+void CF_TxnMetrics_Mark(const CF_TxnMetrics_t *metrics, uint32 *event_ms)
+{
+    UT_GenStub_AddParam(CF_TxnMetrics_Mark, const CF_TxnMetrics_t *, metrics);
+    UT_GenStub_AddParam(CF_TxnMetrics_Mark, uint32 *, event_ms);
+
+    UT_GenStub_Execute(CF_TxnMetrics_Mark, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_TxnMetrics_Start()
+ * ----------------------------------------------------
+ */
+void CF_TxnMetrics_Start(CF_TxnMetrics_t *metrics)
+{
+    UT_GenStub_AddParam(CF_TxnMetrics_Start, CF_TxnMetrics_t *, metrics);
+
+    UT_GenStub_Execute(CF_TxnMetrics_Start, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_TxnStatus_From_ConditionCode()
@@ -0,0 +1,243 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+#include <string.h>
+
+#include "cf_test_utils.h"
+#include "cf_test_files.h"
+
+static UT_CF_File_t UT_CF_Files[UT_CF_MAX_FILES];
+
+/*----------------------------------------------------------------
+ *
+ * Removes every file and installs the file I/O handlers.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_Files_Setup(void)
+{
+    memset(UT_CF_Files, 0, sizeof(UT_CF_Files));
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedOpenCreate), UT_CF_File_OpenCreate, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_CF_File_Write, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_CF_File_Read, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedLseek), UT_CF_File_Lseek, NULL);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Looks up a file by name, an empty name finds a free slot.
+ *
+ *-----------------------------------------------------------------*/
+UT_CF_File_t *UT_CF_File_Find(const char *name)
+{
+    int i;
+
+    for (i = 0; i < UT_CF_MAX_FILES; ++i)
+    {
+        if (strcmp(UT_CF_Files[i].name, name) == 0)
+        {
+            return &UT_CF_Files[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Creates a file with the given contents.
+ *
+ *-----------------------------------------------------------------*/
+UT_CF_File_t *UT_CF_File_Make(const char *name, const char *contents)
+{
+    UT_CF_File_t *file = UT_CF_File_Find("");
+
+    UtAssert_NOT_NULL(file);
+
+    strcpy(file->name, name);
+    file->len = strlen(contents);
+    memcpy(file->data, contents, file->len);
+
+    return file;
+}
+
+osal_id_t UT_CF_File_Fd(const UT_CF_File_t *file)
+{
+    return OS_ObjectIdFromInteger((file - UT_CF_Files) + 1);
+}
+
+UT_CF_File_t *UT_CF_File_FromFd(osal_id_t fd)
+{
+    return &UT_CF_Files[OS_ObjectIdToInteger(fd) - 1];
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for CF_WrappedOpenCreate, opens a file of the table.
+ * OS_FILE_FLAG_CREATE and OS_FILE_FLAG_TRUNCATE are honored.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_OpenCreate(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    osal_id_t    *fd    = UT_Hook_GetArgValueByName(Context, "fd", osal_id_t *);
+    const char   *fname = UT_Hook_GetArgValueByName(Context, "fname", const char *);
+    int32         flags = UT_Hook_GetArgValueByName(Context, "flags", int32);
+    UT_CF_File_t *file;
+    int32         status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        file = UT_CF_File_Find(fname);
+        if (file == NULL && (flags & OS_FILE_FLAG_CREATE) != 0)
+        {
+            file = UT_CF_File_Make(fname, "");
+        }
+
+        if (file == NULL)
+        {
+            status = OS_FS_ERR_PATH_INVALID;
+        }
+        else
+        {
+            if ((flags & OS_FILE_FLAG_TRUNCATE) != 0)
+            {
+                file->len = 0;
+            }
+            file->pos = 0;
+            *fd       = UT_CF_File_Fd(file);
+            status    = OS_SUCCESS;
+        }
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for CF_WrappedWrite.  A forced status code simulates an I/O error.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_Write(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_File_t *file = UT_CF_File_FromFd(UT_Hook_GetArgValueByName(Context, "fd", osal_id_t));
+    const void   *buf  = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t        size = UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32         status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        UtAssert_True(file->pos + size <= sizeof(file->data), "Write fits the file");
+        memcpy(&file->data[file->pos], buf, size);
+        file->pos += size;
+        if (file->pos > file->len)
+        {
+            file->len = file->pos;
+        }
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for CF_WrappedRead, returns short reads at the end of the file.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_Read(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_File_t *file = UT_CF_File_FromFd(UT_Hook_GetArgValueByName(Context, "fd", osal_id_t));
+    void         *buf  = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    size_t        size = UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32         status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        if (size > (file->len - file->pos))
+        {
+            size = file->len - file->pos;
+        }
+        memcpy(buf, &file->data[file->pos], size);
+        file->pos += size;
+        status = size;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for CF_WrappedLseek, with OS_SEEK_SET, OS_SEEK_CUR and OS_SEEK_END.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_Lseek(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_File_t *file   = UT_CF_File_FromFd(UT_Hook_GetArgValueByName(Context, "fd", osal_id_t));
+    off_t         offset = UT_Hook_GetArgValueByName(Context, "offset", off_t);
+    int           mode   = UT_Hook_GetArgValueByName(Context, "mode", int);
+    int32         status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        if (mode == OS_SEEK_CUR)
+        {
+            offset += file->pos;
+        }
+        else if (mode == OS_SEEK_END)
+        {
+            offset += file->len;
+        }
+        file->pos = offset;
+        status    = file->pos;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for OS_mv, renames a file and replaces the destination if it exists.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_Mv(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_File_t *file = UT_CF_File_Find(UT_Hook_GetArgValueByName(Context, "src", const char *));
+    UT_CF_File_t *old  = UT_CF_File_Find(UT_Hook_GetArgValueByName(Context, "dest", const char *));
+
+    if (old != NULL)
+    {
+        memset(old, 0, sizeof(*old));
+    }
+    strcpy(file->name, UT_Hook_GetArgValueByName(Context, "dest", const char *));
+}
+
+/*----------------------------------------------------------------
+ *
+ * A handler for OS_remove.
+ *
+ *-----------------------------------------------------------------*/
+void UT_CF_File_Remove(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_File_t *file = UT_CF_File_Find(UT_Hook_GetArgValueByName(Context, "path", const char *));
+
+    if (file != NULL)
+    {
+        memset(file, 0, sizeof(*file));
+    }
+}
@@ -0,0 +1,72 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * In-memory files for the unit tests of the CF file handling code
+ *
+ * UT_CF_Files_Setup() installs handlers on the wrapped file I/O calls that
+ * open, read, write and seek in a small table of named files instead.  The
+ * file descriptor of a file is its index in the table plus one.
+ */
+
+#ifndef CF_TEST_FILES_H
+#define CF_TEST_FILES_H
+
+#include "cf_test_utils.h"
+#include "cf_delta.h"
+
+#define UT_CF_MAX_FILES 8
+
+/* enough for four blocks of the largest delta block size */
+#define UT_CF_FILE_SIZE (4 * CF_DELTA_MAX_BLOCK_SIZE)
+
+/* stands in for a file, the wrapped I/O calls read and write these */
+typedef struct
+{
+    char   name[CFE_MISSION_MAX_PATH_LEN];
+    uint8  data[UT_CF_FILE_SIZE];
+    size_t pos;
+    size_t len;
+} UT_CF_File_t;
+
+/* removes every file and installs the handlers of CF_WrappedOpenCreate/Write/Read/Lseek */
+void UT_CF_Files_Setup(void);
+
+/* returns the file of that name, or NULL if there is none */
+UT_CF_File_t *UT_CF_File_Find(const char *name);
+
+/* creates a file with the given contents */
+UT_CF_File_t *UT_CF_File_Make(const char *name, const char *contents);
+
+osal_id_t     UT_CF_File_Fd(const UT_CF_File_t *file);
+UT_CF_File_t *UT_CF_File_FromFd(osal_id_t fd);
+
+/* handlers of the wrapped file I/O calls, installed by UT_CF_Files_Setup() */
+void UT_CF_File_OpenCreate(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+void UT_CF_File_Write(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+void UT_CF_File_Read(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+void UT_CF_File_Lseek(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+
+/* handlers of OS_mv() and OS_remove(), for tests that move or remove files */
+void UT_CF_File_Mv(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+void UT_CF_File_Remove(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context);
+
+#endif /* CF_TEST_FILES_H */